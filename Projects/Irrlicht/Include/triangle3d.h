@@ -90,22 +90,22 @@ namespace core
 		\return True if the point is inside the triangle, otherwise false. */
 		bool isPointInside(const vector3d<T>& p) const
 		{
-			static vector3d<f64> af64;
+			vector3d<f64> af64;
 			af64.X = (f64)pointA.X;
 			af64.Y = (f64)pointA.Y;
 			af64.Z = (f64)pointA.Z;
 			
-			static vector3d<f64> bf64;
+			vector3d<f64> bf64;
 			bf64.X = (f64)pointB.X;
 			bf64.Y = (f64)pointB.Y;
 			bf64.Z = (f64)pointB.Z;
 			
-			static vector3d<f64> cf64;
+			vector3d<f64> cf64;
 			cf64.X = (f64)pointC.X;
 			cf64.Y = (f64)pointC.Y;
 			cf64.Z = (f64)pointC.Z;
 			
-			static vector3d<f64> pf64;
+			vector3d<f64> pf64;
 			pf64.X = (f64)p.X;
 			pf64.Y = (f64)p.Y;
 			pf64.Z = (f64)p.Z;
@@ -188,21 +188,21 @@ namespace core
 			const vector3d<T>& lineVect, vector3d<T>& outIntersection) const
 		{
 			// Work with f64 to get more precise results (makes enough difference to be worth the casts).
-			static vector3d<f64> linePointf64;
+			vector3d<f64> linePointf64;
 			linePointf64.X = linePoint.X;
 			linePointf64.Y = linePoint.Y;
 			linePointf64.Z = linePoint.Z;
 
 			// Fix error build
 			// Setting: C++/All Options/Conformance Mode: OFF
-			static vector3d<f64> lineVectf64;
+			vector3d<f64> lineVectf64;
 			lineVectf64.X = lineVect.X;
 			lineVectf64.Y = lineVect.Y;
 			lineVectf64.Z = lineVect.Z;
 
-			static vector3d<f64> outIntersectionf64;
+			vector3d<f64> outIntersectionf64;
 
-			static core::triangle3d<irr::f64> trianglef64;
+			core::triangle3d<irr::f64> trianglef64;
 
 			trianglef64.pointA.X = (f64)pointA.X;
 			trianglef64.pointA.Y = (f64)pointA.Y;
@@ -288,25 +288,25 @@ namespace core
 		bool isOnSameSide(const vector3d<f64>& p1, const vector3d<f64>& p2,
 			const vector3d<f64>& a, const vector3d<f64>& b) const
 		{
-			static vector3d<f64> bminusa;
+			vector3d<f64> bminusa;
 			bminusa.X = b.X - a.X;
 			bminusa.Y = b.Y - a.Y;
 			bminusa.Z = b.Z - a.Z;
 
-			static vector3d<f64> p1minusa;
+			vector3d<f64> p1minusa;
 			p1minusa.X = p1.X - a.X;
 			p1minusa.Y = p1.Y - a.Y;
 			p1minusa.Z = p1.Z - a.Z;
 
-			static vector3d<f64> p2minusa;
+			vector3d<f64> p2minusa;
 			p2minusa.X = p2.X - a.X;
 			p2minusa.Y = p2.Y - a.Y;
 			p2minusa.Z = p2.Z - a.Z;
 
-			static vector3d<f64> cp1;
+			vector3d<f64> cp1;
 			INLINE_CROSSPRODUCT(cp1, bminusa, p1minusa);
 
-			static vector3d<f64> cp2;
+			vector3d<f64> cp2;
 			INLINE_CROSSPRODUCT(cp2, bminusa, p2minusa);
 
 			f64 res = cp1.dotProduct(cp2);
@@ -23,6 +23,9 @@ CLimitReadFile::CLimitReadFile(IReadFile* alreadyOpenedFile, long pos,
 
 	if (File)
 	{
+		// the archive file is shared by the entries that are opened on the other threads
+		// and the reference counter is not atomic
+		std::lock_guard<std::mutex> lock(getArchiveReadMutex());
 		File->grab();
 		AreaStart = pos;
 		AreaEnd = AreaStart + areaSize;
@@ -33,7 +36,10 @@ CLimitReadFile::CLimitReadFile(IReadFile* alreadyOpenedFile, long pos,
 CLimitReadFile::~CLimitReadFile()
 {
 	if (File)
+	{
+		std::lock_guard<std::mutex> lock(getArchiveReadMutex());
 		File->drop();
+	}
 }
 
 
@@ -48,8 +54,7 @@ s32 CLimitReadFile::read(void* buffer, u32 sizeToRead)
 	s32 toRead = core::s32_min(AreaEnd, r + sizeToRead) - core::s32_max(AreaStart, r);
 	if (toRead < 0)
 		return 0;
-	File->seek(r);
-	r = File->read(buffer, toRead);
+	r = readArchiveArea(File, r, buffer, toRead);
 	Pos += r;
 	return r;
 #else
@@ -117,6 +122,21 @@ const io::path& CLimitReadFile::getFileName() const
 }
 
 
+std::mutex& getArchiveReadMutex()
+{
+	static std::mutex archiveMutex;
+	return archiveMutex;
+}
+
+
+s32 readArchiveArea(IReadFile* file, long pos, void* buffer, u32 sizeToRead)
+{
+	std::lock_guard<std::mutex> lock(getArchiveReadMutex());
+	file->seek(pos);
+	return file->read(buffer, sizeToRead);
+}
+
+
 IReadFile* createLimitReadFile(const io::path& fileName, IReadFile* alreadyOpenedFile, long pos, long areaSize)
 {
 	return new CLimitReadFile(alreadyOpenedFile, pos, areaSize, fileName);
@@ -8,6 +8,8 @@
 #include "IReadFile.h"
 #include "irrString.h"
 
+#include <mutex>
+
 namespace irr
 {
 	class CUnicodeConverter;
@@ -55,6 +57,13 @@ namespace io
 		IReadFile* File;
 	};
 
+	//! The archives (zip, tar, pak...) share one opened file for all their entries,
+	//! a seek and read on it must not be interrupted by another thread.
+	std::mutex& getArchiveReadMutex();
+
+	//! seek and read on a file that is shared by an archive, returns how much was read
+	s32 readArchiveArea(IReadFile* file, long pos, void* buffer, u32 sizeToRead);
+
 } // end namespace io
 } // end namespace irr
 
@@ -17,6 +17,7 @@ extern "C" void bz_internal_error(int errorCode)
 
 #include "CFileList.h"
 #include "CReadFile.h"
+#include "CLimitReadFile.h"
 #include "coreutil.h"
 
 #include "IrrCompileConfig.h"
@@ -162,7 +163,11 @@ CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool i
 CZipReader::~CZipReader()
 {
 	if (File)
+	{
+		// an opened entry can still drop this file on the other thread (see CLimitReadFile)
+		std::lock_guard<std::mutex> lock(getArchiveReadMutex());
 		File->drop();
+	}
 }
 
 
@@ -533,6 +538,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 		os::Printer::log("Reading encrypted file.");
 		u8 salt[16]={0};
 		const u16 saltSize = (((e.header.Sig & 0x00ff0000) >>16)+1)*4;
+		std::unique_lock<std::mutex> archiveLock(getArchiveReadMutex());
 		File->seek(e.Offset);
 		File->read(salt, saltSize);
 		char pwVerification[2];
@@ -581,6 +587,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 			return 0;
 		}
 		File->read(fileMAC, 10);
+		archiveLock.unlock();
 		if (strncmp(fileMAC, resMAC, 10))
 		{
 			os::Printer::log("Error on encryption check");
@@ -641,8 +648,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				}
 
 				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
+				readArchiveArea(File, e.Offset, pcData, decryptedSize);
 			}
 
 			// Setup the inflate stream.
@@ -715,8 +721,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				}
 
 				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
+				readArchiveArea(File, e.Offset, pcData, decryptedSize);
 			}
 
 			bz_stream bz_ctx={0};
@@ -787,8 +792,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				}
 
 				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
+				readArchiveArea(File, e.Offset, pcData, decryptedSize);
 			}
 
 			ELzmaStatus status;
@@ -0,0 +1,79 @@
+#include "stdafx.h"
+#include "CAudioDecoderPCM.h"
+
+namespace SkylichtAudio
+{
+	CAudioDecoderPCM::CAudioDecoderPCM(IStream* stream)
+		:IAudioDecoder(stream)
+	{
+		m_streamCursor = stream->createCursor();
+		m_frameSize = stream->getChannels() * sizeof(short);
+	}
+
+	CAudioDecoderPCM::~CAudioDecoderPCM()
+	{
+		delete m_streamCursor;
+	}
+
+	EStatus CAudioDecoderPCM::initDecode()
+	{
+		if (m_frameSize <= 0 || m_stream->getSampleRate() <= 0)
+			return Failed;
+
+		return Success;
+	}
+
+	EStatus CAudioDecoderPCM::decode(void* outputBuffer, int bufferSize)
+	{
+		unsigned char* out = (unsigned char*)outputBuffer;
+
+		int readSize = m_streamCursor->read(out, bufferSize);
+		int totalSize = readSize;
+
+		// loop to the begin of the clip
+		while (m_loop && totalSize < bufferSize && m_streamCursor->size() > 0)
+		{
+			m_streamCursor->seek(0, IStreamCursor::OriginStart);
+
+			readSize = m_streamCursor->read(out + totalSize, bufferSize - totalSize);
+			totalSize += readSize;
+		}
+
+		if (totalSize < bufferSize)
+			memset(out + totalSize, 0, bufferSize - totalSize);
+
+		if (totalSize == 0)
+			return EndStream;
+
+		return Success;
+	}
+
+	int CAudioDecoderPCM::seek(int bufferSize)
+	{
+		int size = m_streamCursor->size();
+
+		int pos = bufferSize - bufferSize % m_frameSize;
+		if (pos > size)
+			pos = size;
+		if (pos < 0)
+			pos = 0;
+
+		return m_streamCursor->seek(pos, IStreamCursor::OriginStart);
+	}
+
+	void CAudioDecoderPCM::getTrackParam(STrackParams* track)
+	{
+		track->NumChannels = m_stream->getChannels();
+		track->SamplingRate = m_stream->getSampleRate();
+		track->BitsPerSample = 16;
+		track->NumSamples = m_frameSize > 0 ? m_streamCursor->size() / m_frameSize : 0;
+	}
+
+	float CAudioDecoderPCM::getCurrentTime()
+	{
+		if (m_frameSize <= 0 || m_stream->getSampleRate() <= 0)
+			return 0.0f;
+
+		return m_streamCursor->tell() / (float)m_frameSize / m_stream->getSampleRate();
+	}
+}
@@ -0,0 +1,37 @@
+#ifndef _SKYLICHTAUDIO_IAUDIODECODER_PCM_H_
+#define _SKYLICHTAUDIO_IAUDIODECODER_PCM_H_
+
+#include "Stream/IStream.h"
+#include "Driver/ISoundSource.h"
+#include "IAudioDecoder.h"
+
+namespace SkylichtAudio
+{
+	// Read the 16bit pcm that is decoded by CPCMCache
+	// The sampling rate & channels are stored in the stream (IStream::setStreamAudio)
+	class CAudioDecoderPCM : public IAudioDecoder
+	{
+	protected:
+		IStreamCursor* m_streamCursor;
+
+		int m_frameSize;
+
+	public:
+		CAudioDecoderPCM(IStream* stream);
+
+		virtual ~CAudioDecoderPCM();
+
+		virtual EStatus initDecode();
+
+		virtual EStatus decode(void* outputBuffer, int bufferSize);
+
+		virtual int seek(int bufferSize);
+
+		virtual void getTrackParam(STrackParams* track);
+
+		virtual float getCurrentTime();
+	};
+
+}
+
+#endif
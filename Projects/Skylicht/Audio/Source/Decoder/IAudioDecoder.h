@@ -48,6 +48,7 @@ namespace SkylichtAudio
 			Wav,
 			Mp3,
 			RawWav,	// use for micro, video audio
+			PCM,	// decoded pcm from CPCMCache
 			Num
 		};
 
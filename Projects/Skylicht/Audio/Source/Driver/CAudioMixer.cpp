@@ -0,0 +1,325 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2012 - 2019 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CAudioMixer.h"
+
+#define SKYLICHTAUDIO_PI 3.14159265358979f
+
+namespace SkylichtAudio
+{
+	struct SSincTable
+	{
+		float Coefs[CAudioMixer::SincPhases * CAudioMixer::SincTaps];
+
+		SSincTable()
+		{
+			const int halfTaps = CAudioMixer::SincTaps / 2;
+
+			// a bit lower than nyquist, it also helps a little on pitch up
+			const float cutoff = 0.9f;
+
+			for (int p = 0; p < CAudioMixer::SincPhases; p++)
+			{
+				float fract = p / (float)CAudioMixer::SincPhases;
+				float* coef = &Coefs[p * CAudioMixer::SincTaps];
+				float sum = 0.0f;
+
+				for (int k = 0; k < CAudioMixer::SincTaps; k++)
+				{
+					// distance from the interpolate point to the tap
+					float x = (halfTaps - 1) + fract - k;
+
+					float sinc = 1.0f;
+					if (x != 0.0f)
+						sinc = sinf(SKYLICHTAUDIO_PI * x * cutoff) / (SKYLICHTAUDIO_PI * x * cutoff);
+
+					// blackman window
+					float w = x / halfTaps;
+					float window = 0.42f + 0.5f * cosf(SKYLICHTAUDIO_PI * w) + 0.08f * cosf(2.0f * SKYLICHTAUDIO_PI * w);
+
+					coef[k] = sinc * window;
+					sum += coef[k];
+				}
+
+				// unity gain
+				for (int k = 0; k < CAudioMixer::SincTaps; k++)
+					coef[k] /= sum;
+			}
+		}
+	};
+
+	const float* CAudioMixer::getSincTable()
+	{
+		static SSincTable s_table;
+		return s_table.Coefs;
+	}
+
+	void CAudioMixer::deinterleave(const short* src, int numChannels, int numFrames, float* left, float* right)
+	{
+		int i = 0;
+
+		if (numChannels == 2)
+		{
+#if defined(SKYLICHTAUDIO_SSE)
+			for (; i + 4 <= numFrames; i += 4)
+			{
+				// 4 frames: L R L R L R L R
+				__m128i lr = _mm_loadu_si128((const __m128i*)(src + i * 2));
+				__m128i l = _mm_srai_epi32(_mm_slli_epi32(lr, 16), 16);
+				__m128i r = _mm_srai_epi32(lr, 16);
+				_mm_storeu_ps(left + i, _mm_cvtepi32_ps(l));
+				_mm_storeu_ps(right + i, _mm_cvtepi32_ps(r));
+			}
+#elif defined(SKYLICHTAUDIO_NEON)
+			for (; i + 4 <= numFrames; i += 4)
+			{
+				int16x4x2_t lr = vld2_s16(src + i * 2);
+				vst1q_f32(left + i, vcvtq_f32_s32(vmovl_s16(lr.val[0])));
+				vst1q_f32(right + i, vcvtq_f32_s32(vmovl_s16(lr.val[1])));
+			}
+#endif
+			for (; i < numFrames; i++)
+			{
+				left[i] = (float)src[i * 2];
+				right[i] = (float)src[i * 2 + 1];
+			}
+		}
+		else
+		{
+#if defined(SKYLICHTAUDIO_SSE)
+			for (; i + 8 <= numFrames; i += 8)
+			{
+				__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+				__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+				__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+				_mm_storeu_ps(left + i, _mm_cvtepi32_ps(lo));
+				_mm_storeu_ps(left + i + 4, _mm_cvtepi32_ps(hi));
+			}
+#elif defined(SKYLICHTAUDIO_NEON)
+			for (; i + 4 <= numFrames; i += 4)
+				vst1q_f32(left + i, vcvtq_f32_s32(vmovl_s16(vld1_s16(src + i))));
+#endif
+			for (; i < numFrames; i++)
+				left[i] = (float)src[i];
+		}
+	}
+
+	void resampleLinearChannel(const float* in, float* out, int numOutput, float pos, float step)
+	{
+		int i = 0;
+
+#if defined(SKYLICHTAUDIO_SSE)
+		__m128 t4 = _mm_add_ps(_mm_set1_ps(pos), _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(step)));
+		__m128 step4 = _mm_set1_ps(step * 4.0f);
+
+		alignas(16) int id[4];
+
+		for (; i + 4 <= numOutput; i += 4)
+		{
+			__m128i s4 = _mm_cvttps_epi32(t4);
+			__m128 f4 = _mm_sub_ps(t4, _mm_cvtepi32_ps(s4));
+			_mm_store_si128((__m128i*)id, s4);
+
+			__m128 a = _mm_set_ps(in[id[3] - 1], in[id[2] - 1], in[id[1] - 1], in[id[0] - 1]);
+			__m128 b = _mm_set_ps(in[id[3]], in[id[2]], in[id[1]], in[id[0]]);
+
+			_mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), f4)));
+
+			t4 = _mm_add_ps(t4, step4);
+		}
+#endif
+
+		int sample = 0;
+		float t = 0.0f;
+		float fract = 0.0f;
+
+		for (; i < numOutput; i++)
+		{
+			t = pos + i * step;
+			sample = (int)t;
+			fract = t - sample;
+
+			out[i] = in[sample - 1] + (in[sample] - in[sample - 1]) * fract;
+		}
+	}
+
+	void CAudioMixer::resampleLinear(const float* left, const float* right, float* outLeft, float* outRight, int numOutput, float pos, float step)
+	{
+		resampleLinearChannel(left, outLeft, numOutput, pos, step);
+		if (right)
+			resampleLinearChannel(right, outRight, numOutput, pos, step);
+	}
+
+	void CAudioMixer::resampleSinc(const float* left, const float* right, float* outLeft, float* outRight, int numOutput, float pos, float step)
+	{
+		const float* table = getSincTable();
+
+		int sample = 0;
+		int phase = 0;
+		float t = 0.0f;
+
+		for (int i = 0; i < numOutput; i++)
+		{
+			t = pos + i * step;
+			sample = (int)t;
+			phase = (int)((t - sample) * SincPhases);
+
+			const float* coef = table + phase * SincTaps;
+
+			// the taps [sample - SincTaps + 1, sample]
+			int first = sample - SincTaps + 1;
+
+#if defined(SKYLICHTAUDIO_SSE)
+			__m128 c0 = _mm_loadu_ps(coef);
+			__m128 c1 = _mm_loadu_ps(coef + 4);
+
+			__m128 s = _mm_add_ps(
+				_mm_mul_ps(_mm_loadu_ps(left + first), c0),
+				_mm_mul_ps(_mm_loadu_ps(left + first + 4), c1));
+
+			if (right)
+			{
+				__m128 r = _mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(right + first), c0),
+					_mm_mul_ps(_mm_loadu_ps(right + first + 4), c1));
+
+				// horizontal add both channels: [l0 + l1, r0 + r1, l2 + l3, r2 + r3]
+				__m128 lr = _mm_add_ps(_mm_unpacklo_ps(s, r), _mm_unpackhi_ps(s, r));
+				lr = _mm_add_ps(lr, _mm_movehl_ps(lr, lr));
+				outLeft[i] = _mm_cvtss_f32(lr);
+				outRight[i] = _mm_cvtss_f32(_mm_shuffle_ps(lr, lr, _MM_SHUFFLE(1, 1, 1, 1)));
+			}
+			else
+			{
+				s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+				s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+				outLeft[i] = _mm_cvtss_f32(s);
+			}
+#elif defined(SKYLICHTAUDIO_NEON)
+			float32x4_t c0 = vld1q_f32(coef);
+			float32x4_t c1 = vld1q_f32(coef + 4);
+
+			float32x4_t s = vmlaq_f32(vmulq_f32(vld1q_f32(left + first), c0), vld1q_f32(left + first + 4), c1);
+			float32x2_t s2 = vadd_f32(vget_low_f32(s), vget_high_f32(s));
+			outLeft[i] = vget_lane_f32(vpadd_f32(s2, s2), 0);
+
+			if (right)
+			{
+				float32x4_t r = vmlaq_f32(vmulq_f32(vld1q_f32(right + first), c0), vld1q_f32(right + first + 4), c1);
+				float32x2_t r2 = vadd_f32(vget_low_f32(r), vget_high_f32(r));
+				outRight[i] = vget_lane_f32(vpadd_f32(r2, r2), 0);
+			}
+#else
+			float l = 0.0f;
+			float r = 0.0f;
+			for (int k = 0; k < SincTaps; k++)
+			{
+				l += left[first + k] * coef[k];
+				if (right)
+					r += right[first + k] * coef[k];
+			}
+
+			outLeft[i] = l;
+			if (right)
+				outRight[i] = r;
+#endif
+		}
+	}
+
+	void CAudioMixer::mixStereo(float* bus, const float* left, const float* right, int numFrames, float leftGain, float rightGain)
+	{
+		int i = 0;
+
+#if defined(SKYLICHTAUDIO_SSE)
+		__m128 lg = _mm_set1_ps(leftGain);
+		__m128 rg = _mm_set1_ps(rightGain);
+
+		for (; i + 4 <= numFrames; i += 4)
+		{
+			__m128 l = _mm_mul_ps(_mm_loadu_ps(left + i), lg);
+			__m128 r = _mm_mul_ps(_mm_loadu_ps(right + i), rg);
+
+			float* b = bus + i * 2;
+			_mm_storeu_ps(b, _mm_add_ps(_mm_loadu_ps(b), _mm_unpacklo_ps(l, r)));
+			_mm_storeu_ps(b + 4, _mm_add_ps(_mm_loadu_ps(b + 4), _mm_unpackhi_ps(l, r)));
+		}
+#elif defined(SKYLICHTAUDIO_NEON)
+		float32x4_t lg = vdupq_n_f32(leftGain);
+		float32x4_t rg = vdupq_n_f32(rightGain);
+
+		for (; i + 4 <= numFrames; i += 4)
+		{
+			float32x4x2_t b = vld2q_f32(bus + i * 2);
+			b.val[0] = vmlaq_f32(b.val[0], vld1q_f32(left + i), lg);
+			b.val[1] = vmlaq_f32(b.val[1], vld1q_f32(right + i), rg);
+			vst2q_f32(bus + i * 2, b);
+		}
+#endif
+
+		for (; i < numFrames; i++)
+		{
+			bus[i * 2] += left[i] * leftGain;
+			bus[i * 2 + 1] += right[i] * rightGain;
+		}
+	}
+
+	void CAudioMixer::convertToShort(const float* bus, short* out, int numSamples)
+	{
+		int i = 0;
+
+#if defined(SKYLICHTAUDIO_SSE)
+		__m128 minValue = _mm_set1_ps(-32768.0f);
+		__m128 maxValue = _mm_set1_ps(32767.0f);
+
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			__m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(bus + i), minValue), maxValue);
+			__m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(bus + i + 4), minValue), maxValue);
+			__m128i s = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+			_mm_storeu_si128((__m128i*)(out + i), s);
+		}
+#elif defined(SKYLICHTAUDIO_NEON)
+		float32x4_t minValue = vdupq_n_f32(-32768.0f);
+		float32x4_t maxValue = vdupq_n_f32(32767.0f);
+
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(bus + i), minValue), maxValue);
+			vst1_s16(out + i, vqmovn_s32(vcvtq_s32_f32(a)));
+		}
+#endif
+
+		float v = 0.0f;
+		for (; i < numSamples; i++)
+		{
+			v = bus[i];
+			if (v < -32768.0f)
+				v = -32768.0f;
+			else if (v > 32767.0f)
+				v = 32767.0f;
+			out[i] = (short)v;
+		}
+	}
+}
@@ -0,0 +1,71 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2012 - 2019 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#ifndef _AUDIO_MIXER_H_
+#define _AUDIO_MIXER_H_
+
+#include "stdafx.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKYLICHTAUDIO_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKYLICHTAUDIO_NEON
+#include <arm_neon.h>
+#endif
+
+namespace SkylichtAudio
+{
+	// Mixing kernels of the float mix bus
+	// All buffers keep the 16bit sample range (-32768.0f, 32767.0f)
+	class CAudioMixer
+	{
+	public:
+		// taps & phases of the polyphase sinc filter
+		static const int SincTaps = 8;
+		static const int SincPhases = 256;
+
+		// number of history frames a resampler reads before the current block
+		static const int HistoryFrames = SincTaps;
+
+		// 16bit interleaved pcm to planar float (right is unused on mono)
+		static void deinterleave(const short* src, int numChannels, int numFrames, float* left, float* right);
+
+		// out[i] = in(pos + i * step), the input is delayed 1 frame: in[-1] must be valid
+		static void resampleLinear(const float* left, const float* right, float* outLeft, float* outRight, int numOutput, float pos, float step);
+
+		// windowed sinc interpolation, the input is delayed SincTaps/2 frames: in[-SincTaps + 1] must be valid
+		static void resampleSinc(const float* left, const float* right, float* outLeft, float* outRight, int numOutput, float pos, float step);
+
+		// bus[2i] += left[i] * leftGain, bus[2i + 1] += right[i] * rightGain
+		static void mixStereo(float* bus, const float* left, const float* right, int numFrames, float leftGain, float rightGain);
+
+		// clamp and convert the mix bus to 16bit
+		static void convertToShort(const float* bus, short* out, int numSamples);
+
+		static const float* getSincTable();
+	};
+}
+
+#endif
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "stdafx.h"
 #include "CDriverNull.h"
+#include "CAudioMixer.h"
 #include "Engine/CAudioEmitter.h"
 
 namespace SkylichtAudio
@@ -38,6 +39,8 @@ namespace SkylichtAudio
 
 		m_masterGain = 1.0f;
 
+		m_resampler = ResampleLinear;
+
 		m_mutex = IMutex::createMutex();
 	}
 
@@ -46,7 +49,7 @@ namespace SkylichtAudio
 		delete m_mutex;
 
 		if (m_mixBuffer)
-			delete m_mixBuffer;
+			delete[] m_mixBuffer;
 
 		shutdown();
 	}
@@ -94,6 +97,20 @@ namespace SkylichtAudio
 		}
 	}
 
+	void CDriverNull::setResampler(EResampler resampler)
+	{
+		SScopeMutex lockScope(m_mutex);
+
+		m_resampler = resampler;
+
+		std::vector<CSoundSource*>::iterator i = m_sources.begin(), end = m_sources.end();
+		while (i != end)
+		{
+			(*i)->setResampler(resampler);
+			++i;
+		}
+	}
+
 	void CDriverNull::fillBuffer(unsigned short* outBuffer, int numSample)
 	{
 		SScopeMutex lockScope(m_mutex);
@@ -108,14 +125,14 @@ namespace SkylichtAudio
 
 			// free current mix buffer
 			if (m_mixBuffer != NULL)
-				delete m_mixBuffer;
+				delete[] m_mixBuffer;
 
-			m_mixBuffer = new int[safeBufferSize];
+			m_mixBuffer = new float[safeBufferSize];
 			m_numMixSampler = numSample;
 		}
 
 		// silent audio
-		memset(m_mixBuffer, 0, sizeof(int)*safeBufferSize);
+		memset(m_mixBuffer, 0, sizeof(float) * safeBufferSize);
 
 		// mix audio
 		std::vector<CSoundSource*>::iterator iSource = m_sources.begin(), sourceEnd = m_sources.end();
@@ -132,20 +149,8 @@ namespace SkylichtAudio
 			++iSource;
 		}
 
-		// clamp audio (convert fixed to short)
-		int *mixingBufferCursor = m_mixBuffer;
-		short *outBufferCursor = (short*)outBuffer;
-
-		for (int i = 0; i < totalSamples; i++)
-		{
-			if ((unsigned int)(*mixingBufferCursor + 32768) > 65535)
-				*outBufferCursor = (short)(*mixingBufferCursor < 0 ? -32768 : 32767);
-			else
-				*outBufferCursor = (short)(*mixingBufferCursor);
-
-			outBufferCursor++;
-			mixingBufferCursor++;
-		}
+		// clamp audio (convert float to short)
+		CAudioMixer::convertToShort(m_mixBuffer, (short*)outBuffer, totalSamples);
 	}
 
 	ISoundSource* CDriverNull::createSource()
@@ -153,6 +158,7 @@ namespace SkylichtAudio
 		SScopeMutex lockScope(m_mutex);
 
 		CSoundSource *source = new CSoundSource(m_bufferLength);
+		source->setResampler(m_resampler);
 		m_sources.push_back(source);
 		return source;
 	}
@@ -40,7 +40,7 @@ namespace SkylichtAudio
 	protected:
 		std::vector<CSoundSource*> m_sources;
 
-		int* m_mixBuffer;
+		float* m_mixBuffer;
 		int m_numMixSampler;
 
 		unsigned char* m_buffer;
@@ -51,6 +51,8 @@ namespace SkylichtAudio
 
 		float m_masterGain;
 
+		EResampler m_resampler;
+
 	public:
 		CDriverNull();
 
@@ -93,6 +95,13 @@ namespace SkylichtAudio
 		virtual int getBufferSize();
 
 		virtual void changeDuration(float duration);
+
+		virtual void setResampler(EResampler resampler);
+
+		virtual EResampler getResampler()
+		{
+			return m_resampler;
+		}
 	};
 }
 
@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CSoundSource.h"
 
 #include "SkylichtAudio.h"
+#include "CAudioMixer.h"
 
 namespace SkylichtAudio
 {
@@ -44,6 +45,7 @@ namespace SkylichtAudio
 		m_pitch = 1.0f;
 		m_rollOff = 10.0f;		// 10m
 		m_is3DSound = false;
+		m_resampler = ResampleLinear;
 	}
 
 	CSoundSource::~CSoundSource()
@@ -52,7 +54,7 @@ namespace SkylichtAudio
 		{
 			if (m_buffers[i].Data != NULL)
 			{
-				delete m_buffers[i].Data;
+				delete[] m_buffers[i].Data;
 				m_buffers[i].Data = NULL;
 			}
 		}
@@ -124,6 +126,7 @@ namespace SkylichtAudio
 		if (m_state == ISoundSource::StateInitial)
 			return;
 		m_state = ISoundSource::StateStopped;
+		clearHistory();
 	}
 
 	void CSoundSource::pause()
@@ -140,6 +143,21 @@ namespace SkylichtAudio
 		if (m_state == ISoundSource::StateInitial)
 			return;
 		m_state = ISoundSource::StateStopped;
+		clearHistory();
+	}
+
+	void CSoundSource::flush()
+	{
+		SScopeMutex scopeLock(m_mutex);
+
+		for (int i = 0, n = (int)m_buffers.size(); i < n; i++)
+		{
+			m_buffers[i].Free = true;
+			m_buffers[i].UsedSize = 0;
+		}
+
+		m_driverBuffer = 0;
+		clearHistory();
 	}
 
 	ISoundSource::ESourceState CSoundSource::getState()
@@ -165,30 +183,23 @@ namespace SkylichtAudio
 	{
 		SScopeMutex scopeLock(m_mutex);
 
-		if (m_buffers[m_driverBuffer].Data == NULL)
-		{
-			// alloc new
-			m_buffers[m_driverBuffer].Data = new unsigned char[bufferSize];
-			memset(m_buffers[m_driverBuffer].Data, 0, bufferSize);
-		}
-		else
+		SDriverBuffer& buffer = m_buffers[m_driverBuffer];
+
+		// the emitter upload more data when pitch up
+		if (buffer.Data == NULL || buffer.TotalSize < bufferSize)
 		{
-			if (m_buffers[m_driverBuffer].TotalSize < bufferSize)
-			{
-				delete m_buffers[m_driverBuffer].Data;
+			if (buffer.Data != NULL)
+				delete[] buffer.Data;
 
-				// re-alloc new size
-				m_buffers[m_driverBuffer].Data = new unsigned char[bufferSize];
-				memset(m_buffers[m_driverBuffer].Data, 0, bufferSize);
-			}
+			buffer.Data = new unsigned char[bufferSize];
+			buffer.TotalSize = bufferSize;
 		}
 
 		// copy data
-		memcpy(m_buffers[m_driverBuffer].Data, soundData, bufferSize);
+		memcpy(buffer.Data, soundData, bufferSize);
 
-		m_buffers[m_driverBuffer].UsedSize = bufferSize;
-		m_buffers[m_driverBuffer].TotalSize = bufferSize;
-		m_buffers[m_driverBuffer].Free = false;
+		buffer.UsedSize = bufferSize;
+		buffer.Free = false;
 	}
 
 	void CSoundSource::lockThread()
@@ -201,11 +212,21 @@ namespace SkylichtAudio
 		m_mutex->unlock();
 	}
 
-	void CSoundSource::fillBuffer(int* buffer, int nbSample, float gain)
+	void CSoundSource::clearHistory()
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			if (m_input[i].size() > 0)
+				memset(m_input[i].data(), 0, sizeof(float) * CAudioMixer::HistoryFrames);
+		}
+	}
+
+	void CSoundSource::fillBuffer(float* buffer, int nbSample, float gain)
 	{
 		SScopeMutex scopeLock(m_mutex);
 
-		short* sourceBuffer = (short*)m_buffers[m_driverBuffer].Data;
+		SDriverBuffer& driverBuffer = m_buffers[m_driverBuffer];
+		short* sourceBuffer = (short*)driverBuffer.Data;
 
 		if (sourceBuffer == NULL || m_trackParams.BitsPerSample != 16)
 			return;
@@ -220,68 +241,59 @@ namespace SkylichtAudio
 			update3D();
 		}
 
-		float rateRatio = m_trackParams.SamplingRate / (float)m_driverSamplingRate;
+		bool stereo = m_trackParams.NumChannels == 2;
+		int numChannels = stereo ? 2 : 1;
+		int history = CAudioMixer::HistoryFrames;
+
+		// the uploaded buffer already contains the pitch (see CAudioEmitter::update)
+		// so it is stretched to the driver buffer: it also converts the sampling rate
+		int srcFrames = driverBuffer.UsedSize / (2 * numChannels);
+
+		if ((int)m_input[0].size() < history + srcFrames)
+		{
+			for (int i = 0; i < numChannels; i++)
+				m_input[i].resize(history + srcFrames, 0.0f);
+		}
+
+		if ((int)m_output[0].size() < nbSample)
+		{
+			m_output[0].resize(nbSample);
+			m_output[1].resize(nbSample);
+		}
 
-		float pitch = rateRatio;
-		float currentSample = 0;
+		float* left = m_input[0].data() + history;
+		float* right = stereo ? m_input[1].data() + history : NULL;
 
-		int sample = 0;
+		CAudioMixer::deinterleave(sourceBuffer, numChannels, srcFrames, left, right);
 
 		float leftGain = m_leftGain * m_gain * m_distanceGain * gain;
 		float rightGain = m_rightGain * m_gain * m_distanceGain * gain;
 
-		int sampleValue = 0;
-		float fract = 0.0f;
-
 		// do not need mix
-		if (m_gain > 0.0f && m_distanceGain > 0.0f && m_pitch >= SKYLICHTAUDIO_MIN_PITCH && m_pitch <= SKYLICHTAUDIO_MAX_PITCH)
+		if (srcFrames > 0 && m_gain > 0.0f && m_distanceGain > 0.0f && m_pitch >= SKYLICHTAUDIO_MIN_PITCH && m_pitch <= SKYLICHTAUDIO_MAX_PITCH)
 		{
-			if (m_trackParams.NumChannels == 2)
-			{
-				// Mix STEREO
-				for (int i = 0; i < nbSample; ++i)
-				{
-					sample = (int)currentSample;
-					fract = currentSample - sample;
-
-					// left
-					sampleValue = (int)(sourceBuffer[sample * 2] * (1.0f - fract) + sourceBuffer[sample * 2 + 2] * fract);
-					*buffer += (int)(sampleValue * leftGain);
-					++buffer;
-
-					// right
-					sampleValue = (int)(sourceBuffer[sample * 2 + 1] * (1.0f - fract) + sourceBuffer[sample * 2 + 3] * fract);
-					*buffer += (int)(sampleValue * rightGain);
-					++buffer;
-
-					currentSample = i * pitch;
-				}
-			}
-			else
-			{
-				// Mix MONO
-				for (int i = 0; i < nbSample; i++)
-				{
-					sample = (int)currentSample;
-					fract = currentSample - sample;
+			float* outLeft = m_output[0].data();
+			float* outRight = stereo ? m_output[1].data() : NULL;
 
-					sampleValue = (int)(sourceBuffer[sample] * (1.0f - fract) + sourceBuffer[sample + 1] * fract);
+			float step = srcFrames / (float)nbSample;
 
-					// left
-					*buffer += (int)(sampleValue * leftGain);
-					++buffer;
+			if (m_resampler == ResampleSinc)
+				CAudioMixer::resampleSinc(left, right, outLeft, outRight, nbSample, 0.0f, step);
+			else
+				CAudioMixer::resampleLinear(left, right, outLeft, outRight, nbSample, 0.0f, step);
 
-					// right
-					*buffer += (int)(sampleValue * rightGain);
-					++buffer;
+			CAudioMixer::mixStereo(buffer, outLeft, stereo ? outRight : outLeft, nbSample, leftGain, rightGain);
+		}
 
-					currentSample = i * pitch;
-				}
-			}
+		// keep the last frames for the next buffer
+		if (srcFrames > 0)
+		{
+			for (int i = 0; i < numChannels; i++)
+				memmove(m_input[i].data(), m_input[i].data() + srcFrames, sizeof(float) * history);
 		}
 
 		// begin to upload data
-		m_buffers[m_driverBuffer].Free = true;
+		driverBuffer.Free = true;
 
 		// swap buffer
 		m_driverBuffer++;
@@ -347,20 +359,28 @@ namespace SkylichtAudio
 	}
 
 	float CSoundSource::calcDistanceGain(const SListener& listener)
+	{
+		if (m_rollOff == 0.0f)
+			m_rollOff = 0.1f;
+
+		return getDistanceGain(m_position, m_rollOff, listener);
+	}
+
+	float CSoundSource::getDistanceGain(const SVector3& position, float rollOff, const SListener& listener)
 	{
 		SVector3 dis;
-		dis.X = m_position.X - listener.Position.X;
-		dis.Y = m_position.Y - listener.Position.Y;
-		dis.Z = m_position.Z - listener.Position.Z;
+		dis.X = position.X - listener.Position.X;
+		dis.Y = position.Y - listener.Position.Y;
+		dis.Z = position.Z - listener.Position.Z;
 
 		float distance = sqrtf(dis.X * dis.X + dis.Y * dis.Y + dis.Z * dis.Z);
 
 		if (distance == 0.0f)
 			distance = 0.1f;
-		if (m_rollOff == 0.0f)
-			m_rollOff = 0.1f;
+		if (rollOff == 0.0f)
+			rollOff = 0.1f;
 
-		float gain = 1.0f - distance / m_rollOff;
+		float gain = 1.0f - distance / rollOff;
 
 		if (gain < 0.0f)
 			gain = 0.0f;
@@ -48,6 +48,7 @@ namespace SkylichtAudio
 		virtual void stop();
 		virtual void pause();
 		virtual void reset();
+		virtual void flush();
 
 		virtual ESourceState getState();
 		virtual void setState(ESourceState state);
@@ -62,7 +63,17 @@ namespace SkylichtAudio
 		virtual void lockThread();
 		virtual void unlockThread();
 
-		virtual void fillBuffer(int* buffer, int nbSample, float gain = 1.0f);
+		virtual void fillBuffer(float* buffer, int nbSample, float gain = 1.0f);
+
+		void setResampler(EResampler resampler)
+		{
+			m_resampler = resampler;
+		}
+
+		EResampler getResampler()
+		{
+			return m_resampler;
+		}
 
 		virtual void setGain(float gain);
 		virtual void setPitch(float pitch);
@@ -78,10 +89,13 @@ namespace SkylichtAudio
 		virtual float getBufferLength();
 		virtual int getSampleRate();
 
+		static float getDistanceGain(const SVector3& position, float rollOff, const SListener& listener);
+
 	protected:
 		void update3D();
 		float calcDistanceGain(const SListener& listener);
 		void calcLeftRightGain(const SListener& listener, float& left, float& right);
+		void clearHistory();
 	protected:
 		STrackParams m_trackParams;
 		int m_numDriverBuffer;
@@ -97,6 +111,12 @@ namespace SkylichtAudio
 		std::vector<SDriverBuffer> m_buffers;
 		IMutex* m_mutex;
 
+		EResampler m_resampler;
+
+		// planar float input (history frames + current buffer) & resampled output
+		std::vector<float> m_input[2];
+		std::vector<float> m_output[2];
+
 		float m_distanceGain;
 		float m_leftGain;
 		float m_rightGain;
@@ -58,6 +58,10 @@ namespace SkylichtAudio
 
 		virtual void changeDuration(float duration) = 0;
 
+		// resampler of the sources: linear (fast) or polyphase sinc (quality)
+		virtual void setResampler(EResampler resampler) = 0;
+		virtual EResampler getResampler() = 0;
+
 		static ISoundDriver* createDriver();
 	};
 }
@@ -58,6 +58,12 @@ namespace SkylichtAudio
 	};
 
 
+	enum EResampler
+	{
+		ResampleLinear = 0,
+		ResampleSinc,
+	};
+
 	struct SDriverBuffer
 	{
 		unsigned char* Data;
@@ -114,6 +120,9 @@ namespace SkylichtAudio
 		virtual void pause() = 0;
 		virtual void reset() = 0;
 
+		// drop the uploaded data that is not played yet (ex: before seek)
+		virtual void flush() = 0;
+
 		virtual ESourceState getState() = 0;
 		virtual void setState(ESourceState state) = 0;
 
@@ -28,7 +28,9 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Decoder/CAudioDecoderWav.h"
 #include "Decoder/CAudioDecoderMp3.h"
 #include "Decoder/CAudioDecoderRawWav.h"
+#include "Decoder/CAudioDecoderPCM.h"
 #include "Engine/CAudioEngine.h"
+#include "Driver/CSoundSource.h"
 
 // todo event
 /*
@@ -92,6 +94,9 @@ namespace SkylichtAudio
 		m_is3DSound = false;
 		m_currentTime = 0.0f;
 
+		m_priority = 1.0f;
+		m_virtual = false;
+
 		m_loop = false;
 		m_cache = false;
 		m_forcePlay = false;
@@ -156,7 +161,15 @@ namespace SkylichtAudio
 			if (m_stream == NULL && m_fileName.empty() == false)
 			{
 				printf("[SkylichtAudio] init emitter: %s\n", m_fileName.c_str());
-				m_stream = CAudioEngine::getSoundEngine()->createStreamFromFileAndCache(m_fileName.c_str(), m_cache);
+
+				// the short clip share the decoded pcm
+				if (m_cache)
+					m_stream = CAudioEngine::getSoundEngine()->getPCMCache()->getStream(m_fileName.c_str());
+
+				if (m_stream != NULL)
+					m_decodeType = IAudioDecoder::PCM;
+				else
+					m_stream = CAudioEngine::getSoundEngine()->createStreamFromFileAndCache(m_fileName.c_str(), m_cache);
 			}
 
 			if (m_stream == NULL)
@@ -175,6 +188,9 @@ namespace SkylichtAudio
 			case IAudioDecoder::RawWav:
 				m_decoder = new CAudioDecoderRawWav(m_stream);
 				break;
+			case IAudioDecoder::PCM:
+				m_decoder = new CAudioDecoderPCM(m_stream);
+				break;
 			default:
 				m_decoder = NULL;
 				break;
@@ -303,7 +319,8 @@ namespace SkylichtAudio
 		// sync state
 		if (m_source)
 		{
-			m_source->setState(m_state);
+			// the virtual voice is not mixed
+			m_source->setState(m_virtual ? ISoundSource::StateStopped : m_state);
 			m_source->set3DSound(m_is3DSound);
 
 			if (m_is3DSound)
@@ -318,7 +335,8 @@ namespace SkylichtAudio
 		if (m_forcePlay == true)
 		{
 			m_state = ISoundSource::StatePlaying;
-			m_source->play();
+			if (!m_virtual)
+				m_source->play();
 			m_forcePlay = false;
 		}
 
@@ -368,6 +386,10 @@ namespace SkylichtAudio
 			}
 		}
 
+		// the virtual voice only track the time (see skipTime)
+		if (m_virtual)
+			return;
+
 		EStatus decodeResult;
 
 		// todo update emitter
@@ -375,6 +397,9 @@ namespace SkylichtAudio
 		{
 			if (m_source->needData() == true && m_decoder != NULL)
 			{
+				unsigned char* uploadBuffer = m_buffer[m_currentBuffer];
+				int uploadSize = m_bufferSize;
+
 				if (m_pitch == 1.0f)
 				{
                     // printf("m_decoder::decode %d\n", m_bufferSize);
@@ -382,68 +407,23 @@ namespace SkylichtAudio
 				}
 				else
 				{
-					int pitchSize = (int)(m_bufferSize * m_pitch);
-
-					memset(m_buffer[m_currentBuffer], 0, m_bufferSize);
-
-					decodeResult = m_decoder->decode(m_decodeBuffer, pitchSize);
-
 					STrackParams trackParam;
 					m_decoder->getTrackParam(&trackParam);
 
-					int nbSample = (m_bufferSize / (trackParam.BitsPerSample / 8)) / trackParam.NumChannels;
-
-					short* src = (short*)m_decodeBuffer;
-					short* dest = (short*)m_buffer[m_currentBuffer];
-
-					float currentSample = 0;
-
-					int sample = 0;
-
-					// in mono
-					float pitch = pitchSize / (float)m_bufferSize;
+					// decode more (or less) frames, the source stretch them to the driver buffer
+					int frameSize = (trackParam.BitsPerSample / 8) * trackParam.NumChannels;
+					int pitchSize = (int)(m_bufferSize * m_pitch);
+					pitchSize = pitchSize - pitchSize % frameSize;
 
-					float fract = 0.0f;
-
-					if (trackParam.NumChannels == 2)
-					{
-						// STEREO
-						for (int i = 0; i < nbSample; i++)
-						{
-							sample = (int)currentSample;
-							fract = currentSample - sample;
-
-							// left
-							*dest = (short)(src[sample * 2] * (1.0f - fract) + src[sample * 2 + 2] * fract);
-							++dest;
-
-							// right
-							*dest = (short)(src[sample * 2 + 1] * (1.0f - fract) + src[sample * 2 + 3] * fract);
-							++dest;
-
-							currentSample = i * pitch;
-						}
-					}
-					else
-					{
-						// MONO
-						for (int i = 0; i < nbSample; i++)
-						{
-							sample = (int)currentSample;
-							fract = currentSample - sample;
-
-							// mix
-							*dest = (short)(src[sample] * (1.0f - fract) + src[sample + 1] * fract);
-							++dest;
-
-							currentSample = i * pitch;
-						}
-					}
+					memset(m_decodeBuffer, 0, pitchSize);
 
+					decodeResult = m_decoder->decode(m_decodeBuffer, pitchSize);
+					uploadBuffer = m_decodeBuffer;
+					uploadSize = pitchSize;
 				}
 
 				// update data to source
-				m_source->uploadData(m_buffer[m_currentBuffer], m_bufferSize);
+				m_source->uploadData(uploadBuffer, uploadSize);
 
 				// update gain
 				m_source->setGain(m_gain);
@@ -565,10 +545,14 @@ namespace SkylichtAudio
 		SScopeMutex scopelock(m_mutex);
 		m_state = ISoundSource::StatePlaying;
 
-		if (fromBegin && m_decoder)
-			m_decoder->seek(0);
+		if (fromBegin)
+		{
+			if (m_decoder)
+				m_decoder->seek(0);
+			m_currentTime = 0.0f;
+		}
 
-		if (m_source)
+		if (m_source && !m_virtual)
 			m_source->play();
 		else
 			m_forcePlay = true;
@@ -701,4 +685,85 @@ namespace SkylichtAudio
 		// SScopeMutex scopelock(m_mutex);
 		m_rollOff = rollOff;
 	}
+
+	void CAudioEmitter::setVirtual(bool b)
+	{
+		if (m_virtual == b)
+			return;
+
+		SScopeMutex scopelock(m_mutex);
+		m_virtual = b;
+
+		if (m_source == NULL || m_decoder == NULL)
+			return;
+
+		if (m_virtual)
+		{
+			// release the voice and the queued buffers
+			m_source->stop();
+			m_source->flush();
+		}
+		else
+		{
+			// promote: continue at the virtual time
+			// the queued buffers are decoded before the virtual time, they must not be played
+			m_source->flush();
+
+			STrackParams trackParam;
+			m_decoder->getTrackParam(&trackParam);
+
+			int seekBufferSize = (int)(trackParam.SamplingRate * (m_currentTime / 1000.0f)) * 2 * trackParam.NumChannels;
+			m_decoder->seek(seekBufferSize);
+
+			if (m_state == ISoundSource::StatePlaying)
+				m_source->play();
+		}
+	}
+
+	float CAudioEmitter::getAudibility(const SListener& listener)
+	{
+		float audibility = m_gain;
+
+		if (m_is3DSound)
+			audibility = audibility * CSoundSource::getDistanceGain(m_position, m_rollOff, listener);
+
+		return audibility;
+	}
+
+	void CAudioEmitter::skipTime(float time)
+	{
+		SScopeMutex scopelock(m_mutex);
+
+		if (!m_virtual || m_state != ISoundSource::StatePlaying)
+			return;
+
+		m_currentTime = m_currentTime + m_pitch * time;
+
+		if (m_decoder == NULL)
+			return;
+
+		STrackParams trackParam;
+		m_decoder->getTrackParam(&trackParam);
+
+		// the length of stream is unknown
+		if (trackParam.NumSamples <= 0 || trackParam.SamplingRate <= 0)
+			return;
+
+		float duration = trackParam.NumSamples * 1000.0f / trackParam.SamplingRate;
+		if (m_currentTime < duration)
+			return;
+
+		if (m_loop)
+		{
+			m_currentTime = fmodf(m_currentTime, duration);
+		}
+		else
+		{
+			// end track
+			m_decoder->seek(0);
+			m_currentTime = 0.0f;
+			m_state = ISoundSource::StateStopped;
+			m_virtual = false;
+		}
+	}
 }
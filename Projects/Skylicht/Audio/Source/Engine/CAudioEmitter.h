@@ -85,6 +85,9 @@ namespace SkylichtAudio
 		float m_playWithFade;
 
 		float m_currentTime;
+
+		float m_priority;
+		bool m_virtual;
 	public:
 
 		static IAudioDecoder::EDecoderType getDecode(const char* fileName);
@@ -174,6 +177,30 @@ namespace SkylichtAudio
 		{
 			return m_currentTime;
 		}
+
+		void setPriority(float priority)
+		{
+			m_priority = priority;
+		}
+
+		float getPriority()
+		{
+			return m_priority;
+		}
+
+		// virtual voice: playing but it does not decode & mix (see CVoiceManager)
+		void setVirtual(bool b);
+
+		bool isVirtual()
+		{
+			return m_virtual;
+		}
+
+		// gain * distance gain
+		float getAudibility(const SListener& listener);
+
+		// advance the play time of the virtual voice (milliseconds)
+		void skipTime(float time);
 	};
 }
 
@@ -68,6 +68,10 @@ namespace SkylichtAudio
 	CAudioEngine::CAudioEngine()
 	{
 		m_mutex = IMutex::createMutex();
+		m_driver = NULL;
+		m_thread = NULL;
+		m_defaultStreamFactory = NULL;
+		m_firstUpdate = true;
 	}
 
 	CAudioEngine::~CAudioEngine()
@@ -111,6 +115,9 @@ namespace SkylichtAudio
 		// release stream
 		releaseAllStream();
 
+		// release decoded pcm
+		m_pcmCache.clear();
+
 		// release stream factory
 		unRegisterStreamFactory(m_defaultStreamFactory);
 		delete m_defaultStreamFactory;
@@ -171,6 +178,17 @@ namespace SkylichtAudio
 	{
 		m_mutex->lock();
 
+		// milliseconds from the last update
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		float dt = 0.0f;
+		if (!m_firstUpdate)
+			dt = std::chrono::duration<float, std::milli>(now - m_lastUpdate).count();
+		m_lastUpdate = now;
+		m_firstUpdate = false;
+
+		// limit the real voices & virtualize the inaudible emitters
+		m_voiceManager.update(m_emitters, m_listener, dt);
+
 		// todo update sound engine
 		std::vector<CAudioEmitter*>::iterator i = m_emitters.begin(), end = m_emitters.end();
 
@@ -292,6 +310,7 @@ namespace SkylichtAudio
 		{
 			// get from cache
 			stream = it->second;
+			stream->grab();
 		}
 
 		return stream;
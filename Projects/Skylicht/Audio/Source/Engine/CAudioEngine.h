@@ -37,6 +37,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CAudioEmitter.h"
 #include "CAudioReader.h"
+#include "CVoiceManager.h"
+#include "CPCMCache.h"
+
+#include <chrono>
 
 using namespace SkylichtSystem;
 
@@ -69,6 +73,14 @@ namespace SkylichtAudio
 
 		SListener m_listener;
 
+		CVoiceManager m_voiceManager;
+
+		CPCMCache m_pcmCache;
+
+		std::chrono::steady_clock::time_point m_lastUpdate;
+
+		bool m_firstUpdate;
+
 	public:
 		static CAudioEngine* getSoundEngine();
 
@@ -153,6 +165,28 @@ namespace SkylichtAudio
 		{
 			return m_listener;
 		}
+
+		CPCMCache* getPCMCache()
+		{
+			return &m_pcmCache;
+		}
+
+		CVoiceManager* getVoiceManager()
+		{
+			return &m_voiceManager;
+		}
+
+		// the number of emitters that decode & mix at the same time
+		void setMaxVoices(int max)
+		{
+			SScopeMutex lockScope(m_mutex);
+			m_voiceManager.setMaxVoices(max);
+		}
+
+		int getMaxVoices()
+		{
+			return m_voiceManager.getMaxVoices();
+		}
 	};
 };
 
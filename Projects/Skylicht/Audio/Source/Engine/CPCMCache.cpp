@@ -0,0 +1,224 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2012 - 2019 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CPCMCache.h"
+#include "CAudioEngine.h"
+#include "SkylichtAudioConfig.h"
+
+#include "Decoder/CAudioDecoderWav.h"
+#include "Decoder/CAudioDecoderMp3.h"
+#include "Stream/CMemoryStream.h"
+
+namespace SkylichtAudio
+{
+	CPCMCache::CPCMCache() :
+		m_memoryBudget(SKYLICHTAUDIO_PCM_CACHE_BUDGET),
+		m_maxClipSize(SKYLICHTAUDIO_PCM_CACHE_MAX_CLIP),
+		m_memoryUsed(0),
+		m_hits(0),
+		m_misses(0)
+	{
+		m_mutex = IMutex::createMutex();
+	}
+
+	CPCMCache::~CPCMCache()
+	{
+		clear();
+		delete m_mutex;
+	}
+
+	IStream* CPCMCache::getStream(const char* fileName)
+	{
+		SScopeMutex lockScope(m_mutex);
+
+		std::map<std::string, std::list<SClip>::iterator>::iterator it = m_nameToClip.find(fileName);
+		if (it != m_nameToClip.end())
+		{
+			// move to the front
+			m_clips.splice(m_clips.begin(), m_clips, it->second);
+			m_hits++;
+
+			IStream* stream = it->second->Stream;
+			stream->grab();
+			return stream;
+		}
+
+		if (m_skipFiles.find(fileName) != m_skipFiles.end())
+			return NULL;
+
+		m_misses++;
+
+		int size = 0;
+
+		IStream* stream = decodeFile(fileName, size);
+		if (stream == NULL)
+		{
+			m_skipFiles.insert(fileName);
+			return NULL;
+		}
+
+		// the emitter still use the stream if it is over the budget
+		if (size <= m_memoryBudget)
+		{
+			evict(m_memoryBudget - size);
+
+			SClip clip;
+			clip.Name = fileName;
+			clip.Stream = stream;
+			clip.Size = size;
+
+			m_clips.push_front(clip);
+			m_nameToClip[fileName] = m_clips.begin();
+			m_memoryUsed += size;
+
+			stream->grab();
+		}
+
+		return stream;
+	}
+
+	void CPCMCache::clear()
+	{
+		SScopeMutex lockScope(m_mutex);
+
+		evict(0);
+		m_skipFiles.clear();
+	}
+
+	void CPCMCache::setMemoryBudget(int bytes)
+	{
+		SScopeMutex lockScope(m_mutex);
+
+		m_memoryBudget = bytes;
+		evict(m_memoryBudget);
+	}
+
+	void CPCMCache::evict(int budget)
+	{
+		// drop the least recently used clips, the playing emitters keep their grab
+		while (m_memoryUsed > budget && m_clips.size() > 0)
+		{
+			SClip& clip = m_clips.back();
+
+			m_memoryUsed -= clip.Size;
+			m_nameToClip.erase(clip.Name);
+			clip.Stream->drop();
+
+			m_clips.pop_back();
+		}
+	}
+
+	IStream* CPCMCache::decodeFile(const char* fileName, int& size)
+	{
+		IStream* fileStream = CAudioEngine::getSoundEngine()->createStreamFromFile(fileName);
+		if (fileStream == NULL)
+			return NULL;
+
+		size = 0;
+
+		IAudioDecoder* decoder = NULL;
+		if (CAudioEmitter::getDecode(fileName) == IAudioDecoder::Mp3)
+			decoder = new CAudioDecoderMp3(fileStream);
+		else
+			decoder = new CAudioDecoderWav(fileStream);
+
+		IStream* result = NULL;
+
+		STrackParams track;
+
+		if (decoder->initDecode() == Success)
+		{
+			decoder->getTrackParam(&track);
+
+			int frameSize = track.NumChannels * sizeof(short);
+
+			if (frameSize > 0 && track.SamplingRate > 0)
+			{
+				// decode 100ms per chunk
+				int chunkSize = (track.SamplingRate / 10) * frameSize;
+
+				std::vector<unsigned char> pcm;
+				int lastChunk = 0;
+				EStatus status = Success;
+
+				while (status == Success)
+				{
+					if (size + chunkSize > m_maxClipSize)
+					{
+						status = Failed;
+						break;
+					}
+
+					pcm.resize(size + chunkSize);
+					status = decoder->decode(pcm.data() + size, chunkSize);
+
+					lastChunk = size;
+					size += chunkSize;
+				}
+
+				if (status == EndStream)
+				{
+					// the last chunk is padded by silent
+					if (track.NumSamples > 0)
+					{
+						// the decoder know the length, keep the silent tail of the clip
+						if (track.NumSamples * frameSize < size)
+							size = track.NumSamples * frameSize;
+					}
+					else
+					{
+						// unknown length: strip the padding of the last chunk
+						short* samples = (short*)pcm.data();
+						int numChannels = track.NumChannels;
+						while (size > lastChunk)
+						{
+							short* frame = samples + size / sizeof(short) - numChannels;
+
+							bool silent = true;
+							for (int i = 0; i < numChannels && silent; i++)
+								silent = frame[i] == 0;
+
+							if (!silent)
+								break;
+
+							size -= frameSize;
+						}
+					}
+
+					if (size > 0)
+					{
+						result = new CMemoryStream(pcm.data(), size, false);
+						result->setStreamAudio(track.SamplingRate, track.NumChannels);
+					}
+				}
+			}
+		}
+
+		delete decoder;
+		fileStream->drop();
+
+		return result;
+	}
+}
@@ -0,0 +1,129 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2012 - 2019 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#ifndef _SKYLICHTAUDIO_PCMCACHE_
+#define _SKYLICHTAUDIO_PCMCACHE_
+
+#include "Stream/IStream.h"
+#include "Thread/IMutex.h"
+
+#include <list>
+#include <set>
+
+using namespace SkylichtSystem;
+
+namespace SkylichtAudio
+{
+	// LRU cache of the fully decoded 16bit pcm of the short clips
+	// The emitters that play the same file share the decoded stream (see CAudioDecoderPCM)
+	class CPCMCache
+	{
+	protected:
+		struct SClip
+		{
+			std::string Name;
+			IStream* Stream;
+			int Size;
+		};
+
+		// the front is the most recent clip
+		std::list<SClip> m_clips;
+
+		std::map<std::string, std::list<SClip>::iterator> m_nameToClip;
+
+		// the files that can not be cached (too long or decode failed)
+		std::set<std::string> m_skipFiles;
+
+		int m_memoryBudget;
+		int m_maxClipSize;
+		int m_memoryUsed;
+
+		int m_hits;
+		int m_misses;
+
+		IMutex* m_mutex;
+
+	public:
+		CPCMCache();
+
+		virtual ~CPCMCache();
+
+		// return the grabbed pcm stream, NULL if the file is not cacheable
+		IStream* getStream(const char* fileName);
+
+		void clear();
+
+		void setMemoryBudget(int bytes);
+
+		int getMemoryBudget()
+		{
+			return m_memoryBudget;
+		}
+
+		// the clip decoded larger than this size is not cached
+		void setMaxClipSize(int bytes)
+		{
+			m_maxClipSize = bytes;
+		}
+
+		int getMaxClipSize()
+		{
+			return m_maxClipSize;
+		}
+
+		int getMemoryUsed()
+		{
+			return m_memoryUsed;
+		}
+
+		int getNumClips()
+		{
+			return (int)m_clips.size();
+		}
+
+		int getNumHits()
+		{
+			return m_hits;
+		}
+
+		int getNumMisses()
+		{
+			return m_misses;
+		}
+
+		void resetStatistics()
+		{
+			m_hits = 0;
+			m_misses = 0;
+		}
+
+	protected:
+
+		IStream* decodeFile(const char* fileName, int& size);
+
+		void evict(int budget);
+	};
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2012 - 2019 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CVoiceManager.h"
+#include "SkylichtAudioConfig.h"
+
+#include <algorithm>
+
+// a real voice keeps its slot until a new voice is clearly louder
+#define VOICE_REAL_BONUS 1.1f
+
+namespace SkylichtAudio
+{
+	CVoiceManager::CVoiceManager() :
+		m_maxVoices(SKYLICHTAUDIO_MAX_VOICES),
+		m_minAudibility(0.001f),
+		m_numRealVoices(0),
+		m_numVirtualVoices(0)
+	{
+	}
+
+	CVoiceManager::~CVoiceManager()
+	{
+	}
+
+	void CVoiceManager::update(std::vector<CAudioEmitter*>& emitters, const SListener& listener, float dt)
+	{
+		m_voices.clear();
+
+		for (int i = 0, n = (int)emitters.size(); i < n; i++)
+		{
+			CAudioEmitter* emitter = emitters[i];
+
+			if (!emitter->isPlaying())
+			{
+				// the stopped voice will start as a real voice
+				if (emitter->isVirtual())
+					emitter->setVirtual(false);
+				continue;
+			}
+
+			float audibility = emitter->getAudibility(listener);
+			if (audibility < m_minAudibility)
+			{
+				m_voices.push_back({ emitter, -1.0f });
+				continue;
+			}
+
+			float score = emitter->getPriority() * audibility;
+			if (!emitter->isVirtual())
+				score = score * VOICE_REAL_BONUS;
+
+			m_voices.push_back({ emitter, score });
+		}
+
+		std::stable_sort(m_voices.begin(), m_voices.end(), [](const SVoice& a, const SVoice& b)
+			{
+				return a.Score > b.Score;
+			});
+
+		m_numRealVoices = 0;
+		m_numVirtualVoices = 0;
+
+		for (int i = 0, n = (int)m_voices.size(); i < n; i++)
+		{
+			SVoice& voice = m_voices[i];
+
+			bool isVirtual = voice.Score < 0.0f || m_numRealVoices >= m_maxVoices;
+
+			voice.Emitter->setVirtual(isVirtual);
+
+			if (isVirtual)
+			{
+				voice.Emitter->skipTime(dt);
+				m_numVirtualVoices++;
+			}
+			else
+			{
+				m_numRealVoices++;
+			}
+		}
+	}
+}
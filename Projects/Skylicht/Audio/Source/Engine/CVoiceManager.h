@@ -0,0 +1,94 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2012 - 2019 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#ifndef _SKYLICHTAUDIO_VOICEMANAGER_
+#define _SKYLICHTAUDIO_VOICEMANAGER_
+
+#include "CAudioEmitter.h"
+
+namespace SkylichtAudio
+{
+	// Limit the number of real voices (decode & mix)
+	// The emitters are ranked by priority * audibility, the others are virtual:
+	// they only track the play time and will be promoted back when they are audible again
+	class CVoiceManager
+	{
+	protected:
+		int m_maxVoices;
+
+		float m_minAudibility;
+
+		int m_numRealVoices;
+		int m_numVirtualVoices;
+
+		struct SVoice
+		{
+			CAudioEmitter* Emitter;
+			float Score;
+		};
+
+		std::vector<SVoice> m_voices;
+
+	public:
+		CVoiceManager();
+
+		virtual ~CVoiceManager();
+
+		void setMaxVoices(int max)
+		{
+			m_maxVoices = max;
+		}
+
+		int getMaxVoices()
+		{
+			return m_maxVoices;
+		}
+
+		// the emitter quieter than this value is always virtual
+		void setMinAudibility(float a)
+		{
+			m_minAudibility = a;
+		}
+
+		float getMinAudibility()
+		{
+			return m_minAudibility;
+		}
+
+		int getNumRealVoices()
+		{
+			return m_numRealVoices;
+		}
+
+		int getNumVirtualVoices()
+		{
+			return m_numVirtualVoices;
+		}
+
+		// dt: milliseconds from the last update
+		void update(std::vector<CAudioEmitter*>& emitters, const SListener& listener, float dt);
+	};
+}
+
+#endif
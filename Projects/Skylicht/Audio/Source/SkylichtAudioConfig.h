@@ -50,3 +50,9 @@ https://github.com/skylicht-lab/skylicht-engine
 #endif
 #endif
 
+// number of real voices (decode & mix), see CVoiceManager
+#define SKYLICHTAUDIO_MAX_VOICES 32
+
+// decoded pcm cache of the short clips, see CPCMCache
+#define SKYLICHTAUDIO_PCM_CACHE_BUDGET (16 * 1024 * 1024)
+#define SKYLICHTAUDIO_PCM_CACHE_MAX_CLIP (1024 * 1024)
@@ -0,0 +1,739 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the Rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CBVHBuilder.h"
+
+#include "Debug/CSceneDebug.h"
+#include "Utils/CSIMD.h"
+
+// binned sah
+#define BVH_NUM_BINS 16
+
+// the deeper node is forced to a leaf, it also bound the traversal stack
+#define BVH_MAX_DEPTH 64
+#define BVH_STACK_SIZE (BVH_MAX_DEPTH * 4 + 4)
+
+// edge tolerance of the barycentric test, a ray on the shared edge must hit
+#define BVH_TRIANGLE_EPSILON 0.00001f
+
+namespace Skylicht
+{
+	static inline f32 getAxis(const core::vector3df& v, int axis)
+	{
+		return (&v.X)[axis];
+	}
+
+	static inline f32 getHalfArea(const core::aabbox3df& box)
+	{
+		core::vector3df e = box.getExtent();
+		return e.X * e.Y + e.Y * e.Z + e.Z * e.X;
+	}
+
+	CBVHBuilder::CBVHBuilder() :
+		m_maxLeafTriangles(4)
+	{
+
+	}
+
+	CBVHBuilder::~CBVHBuilder()
+	{
+		clear();
+	}
+
+	void CBVHBuilder::clear()
+	{
+		m_bvhNodes.clear();
+		m_packets.clear();
+		m_triangleRefs.clear();
+
+		CCollisionBuilder::clear();
+	}
+
+	void CBVHBuilder::build()
+	{
+		m_bvhNodes.set_used(0);
+		m_packets.set_used(0);
+		m_triangleRefs.set_used(0);
+
+		const u32 start = os::Timer::getRealTime();
+		u32 numPoly = 0;
+
+		// step 1: update transform and triangles
+		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		{
+			m_nodes[i]->updateTransform();
+			numPoly += m_nodes[i]->Triangles.size();
+		}
+
+		if (numPoly == 0)
+			return;
+
+		// step 2: triangle reference, bbox & center
+		SBuildContext context;
+		context.Boxes.resize(numPoly);
+		context.Centers.resize(numPoly);
+		context.Triangles.resize(numPoly);
+
+		m_triangleRefs.set_used(numPoly);
+
+		u32 idx = 0;
+		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		{
+			CCollisionNode* node = m_nodes[i];
+
+			u32 numTris = node->Triangles.size();
+			core::triangle3df* tris = node->Triangles.pointer();
+
+			for (u32 j = 0; j < numTris; j++)
+			{
+				m_triangleRefs[idx].Node = node;
+				m_triangleRefs[idx].TriangleID = (s32)j;
+
+				core::aabbox3df& box = context.Boxes[idx];
+				box.reset(tris[j].pointA);
+				box.addInternalPoint(tris[j].pointB);
+				box.addInternalPoint(tris[j].pointC);
+
+				context.Centers[idx] = box.getCenter();
+				context.Triangles[idx] = idx;
+				idx++;
+			}
+		}
+
+		// step 3: binary sah tree
+		context.Nodes.reserve(numPoly * 2 / m_maxLeafTriangles + 1);
+		buildNode(context, 0, numPoly, 0);
+
+		// step 4: collapse to 4 wide nodes & the triangle packets
+		m_bvhNodes.reallocate(context.Nodes.size() / 2 + 1);
+		m_packets.reallocate(numPoly / 2 + 1);
+		collapseNode(context, 0);
+
+		c8 tmp[256];
+		sprintf(tmp, "Needed %ums to CBVHBuilder::build (%u polys, %u nodes)", os::Timer::getRealTime() - start, numPoly, m_bvhNodes.size());
+		os::Printer::log(tmp, ELL_INFORMATION);
+	}
+
+	s32 CBVHBuilder::buildNode(SBuildContext& context, u32 first, u32 count, int depth)
+	{
+		s32 nodeId = (s32)context.Nodes.size();
+		context.Nodes.push_back(SBuildNode());
+
+		u32* tris = context.Triangles.data() + first;
+
+		core::aabbox3df box = context.Boxes[tris[0]];
+		core::aabbox3df centerBox(context.Centers[tris[0]]);
+		for (u32 i = 1; i < count; i++)
+		{
+			box.addInternalBox(context.Boxes[tris[i]]);
+			centerBox.addInternalPoint(context.Centers[tris[i]]);
+		}
+
+		SBuildNode& node = context.Nodes[nodeId];
+		node.Box = box;
+		node.Left = -1;
+		node.Right = -1;
+		node.First = first;
+		node.Count = count;
+
+		if (count <= m_maxLeafTriangles || depth >= BVH_MAX_DEPTH)
+			return nodeId;
+
+		// find the best split on the center bins
+		int bestAxis = -1;
+		int bestSplit = 0;
+		f32 bestCost = FLT_MAX;
+
+		u32 binCount[BVH_NUM_BINS];
+		core::aabbox3df binBox[BVH_NUM_BINS];
+		f32 rightCost[BVH_NUM_BINS];
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			f32 minCenter = getAxis(centerBox.MinEdge, axis);
+			f32 extent = getAxis(centerBox.MaxEdge, axis) - minCenter;
+			if (extent <= 0.0f)
+				continue;
+
+			f32 scale = BVH_NUM_BINS * 0.9999f / extent;
+
+			for (int b = 0; b < BVH_NUM_BINS; b++)
+				binCount[b] = 0;
+
+			for (u32 i = 0; i < count; i++)
+			{
+				int b = (int)((getAxis(context.Centers[tris[i]], axis) - minCenter) * scale);
+
+				if (binCount[b] == 0)
+					binBox[b] = context.Boxes[tris[i]];
+				else
+					binBox[b].addInternalBox(context.Boxes[tris[i]]);
+
+				binCount[b]++;
+			}
+
+			// sweep from the right: cost of the bins [b, BVH_NUM_BINS)
+			core::aabbox3df sweepBox;
+			u32 sweepCount = 0;
+			for (int b = BVH_NUM_BINS - 1; b > 0; b--)
+			{
+				if (binCount[b] > 0)
+				{
+					if (sweepCount == 0)
+						sweepBox = binBox[b];
+					else
+						sweepBox.addInternalBox(binBox[b]);
+					sweepCount += binCount[b];
+				}
+				rightCost[b] = sweepCount > 0 ? getHalfArea(sweepBox) * sweepCount : 0.0f;
+			}
+
+			// sweep from the left: split between the bin (b - 1) and b
+			sweepCount = 0;
+			for (int b = 1; b < BVH_NUM_BINS; b++)
+			{
+				if (binCount[b - 1] > 0)
+				{
+					if (sweepCount == 0)
+						sweepBox = binBox[b - 1];
+					else
+						sweepBox.addInternalBox(binBox[b - 1]);
+					sweepCount += binCount[b - 1];
+				}
+
+				if (sweepCount == 0 || sweepCount == count)
+					continue;
+
+				f32 cost = getHalfArea(sweepBox) * sweepCount + rightCost[b];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b;
+				}
+			}
+		}
+
+		u32 mid = 0;
+
+		if (bestAxis >= 0)
+		{
+			// the leaf is cheaper than the traversal & 2 childs
+			f32 leafCost = getHalfArea(box) * count;
+			if (bestCost + getHalfArea(box) >= leafCost && count <= m_maxLeafTriangles * 4)
+				return nodeId;
+
+			f32 minCenter = getAxis(centerBox.MinEdge, bestAxis);
+			f32 scale = BVH_NUM_BINS * 0.9999f / (getAxis(centerBox.MaxEdge, bestAxis) - minCenter);
+
+			u32* it = std::partition(tris, tris + count,
+				[&](u32 t)
+				{
+					return (int)((getAxis(context.Centers[t], bestAxis) - minCenter) * scale) < bestSplit;
+				});
+
+			mid = (u32)(it - tris);
+		}
+
+		if (mid == 0 || mid == count)
+		{
+			// all centers are at the same position
+			mid = count / 2;
+		}
+
+		// recursion invalidate the node reference
+		s32 left = buildNode(context, first, mid, depth + 1);
+		s32 right = buildNode(context, first + mid, count - mid, depth + 1);
+
+		context.Nodes[nodeId].Left = left;
+		context.Nodes[nodeId].Right = right;
+		return nodeId;
+	}
+
+	s32 CBVHBuilder::collapseNode(SBuildContext& context, s32 buildNodeId)
+	{
+		s32 nodeId = (s32)m_bvhNodes.size();
+		m_bvhNodes.push_back(SBVHNode4());
+
+		// pull the grandchilds of the largest inner child up to 4 childs
+		s32 childs[4];
+		int numChild = 0;
+
+		const SBuildNode& parent = context.Nodes[buildNodeId];
+		if (parent.Left < 0)
+		{
+			// the root is a leaf
+			childs[numChild++] = buildNodeId;
+		}
+		else
+		{
+			childs[numChild++] = parent.Left;
+			childs[numChild++] = parent.Right;
+
+			while (numChild < 4)
+			{
+				int best = -1;
+				f32 bestArea = -1.0f;
+
+				for (int i = 0; i < numChild; i++)
+				{
+					const SBuildNode& child = context.Nodes[childs[i]];
+					if (child.Left >= 0)
+					{
+						f32 area = getHalfArea(child.Box);
+						if (area > bestArea)
+						{
+							bestArea = area;
+							best = i;
+						}
+					}
+				}
+
+				if (best < 0)
+					break;
+
+				const SBuildNode& child = context.Nodes[childs[best]];
+				childs[best] = child.Left;
+				childs[numChild++] = child.Right;
+			}
+		}
+
+		SBVHNode4 node;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i < numChild)
+			{
+				const SBuildNode& child = context.Nodes[childs[i]];
+				node.MinX[i] = child.Box.MinEdge.X;
+				node.MinY[i] = child.Box.MinEdge.Y;
+				node.MinZ[i] = child.Box.MinEdge.Z;
+				node.MaxX[i] = child.Box.MaxEdge.X;
+				node.MaxY[i] = child.Box.MaxEdge.Y;
+				node.MaxZ[i] = child.Box.MaxEdge.Z;
+
+				if (child.Left < 0)
+				{
+					addLeafPackets(context, child, node.Child[i], node.Count[i]);
+				}
+				else
+				{
+					node.Child[i] = collapseNode(context, childs[i]);
+					node.Count[i] = 0;
+				}
+			}
+			else
+			{
+				// empty slot: a far point box that the ray segment never reach
+				node.MinX[i] = node.MinY[i] = node.MinZ[i] = FLT_MAX;
+				node.MaxX[i] = node.MaxY[i] = node.MaxZ[i] = FLT_MAX;
+				node.Child[i] = -1;
+				node.Count[i] = 0;
+			}
+		}
+
+		m_bvhNodes[nodeId] = node;
+		return nodeId;
+	}
+
+	void CBVHBuilder::addLeafPackets(SBuildContext& context, const SBuildNode& leaf, s32& outChild, s32& outCount)
+	{
+		s32 firstPacket = (s32)m_packets.size();
+
+		for (u32 i = 0; i < leaf.Count; i += 4)
+		{
+			SBVHTrianglePacket packet;
+
+			for (u32 lane = 0; lane < 4; lane++)
+			{
+				if (i + lane < leaf.Count)
+				{
+					u32 refId = context.Triangles[leaf.First + i + lane];
+					const SBVHTriangleRef& ref = m_triangleRefs[refId];
+					const core::triangle3df& tri = ref.Node->Triangles[ref.TriangleID];
+
+					core::vector3df e1 = tri.pointB - tri.pointA;
+					core::vector3df e2 = tri.pointC - tri.pointA;
+
+					packet.AX[lane] = tri.pointA.X;
+					packet.AY[lane] = tri.pointA.Y;
+					packet.AZ[lane] = tri.pointA.Z;
+					packet.E1X[lane] = e1.X;
+					packet.E1Y[lane] = e1.Y;
+					packet.E1Z[lane] = e1.Z;
+					packet.E2X[lane] = e2.X;
+					packet.E2Y[lane] = e2.Y;
+					packet.E2Z[lane] = e2.Z;
+					packet.Triangle[lane] = (s32)refId;
+				}
+				else
+				{
+					// degenerate triangle, the determinant is 0
+					packet.AX[lane] = packet.AY[lane] = packet.AZ[lane] = 0.0f;
+					packet.E1X[lane] = packet.E1Y[lane] = packet.E1Z[lane] = 0.0f;
+					packet.E2X[lane] = packet.E2Y[lane] = packet.E2Z[lane] = 0.0f;
+					packet.Triangle[lane] = -1;
+				}
+			}
+
+			m_packets.push_back(packet);
+		}
+
+		outChild = -firstPacket - 1;
+		outCount = (s32)m_packets.size() - firstPacket;
+	}
+
+	void CBVHBuilder::onRemoveCollision(CCollisionNode* node)
+	{
+		// clear the lanes of the node, the bbox are not refitted until build()
+		for (u32 i = 0, n = m_packets.size(); i < n; i++)
+		{
+			SBVHTrianglePacket& packet = m_packets[i];
+
+			for (int lane = 0; lane < 4; lane++)
+			{
+				s32 refId = packet.Triangle[lane];
+				if (refId < 0 || m_triangleRefs[refId].Node != node)
+					continue;
+
+				packet.AX[lane] = packet.AY[lane] = packet.AZ[lane] = 0.0f;
+				packet.E1X[lane] = packet.E1Y[lane] = packet.E1Z[lane] = 0.0f;
+				packet.E2X[lane] = packet.E2Y[lane] = packet.E2Z[lane] = 0.0f;
+				packet.Triangle[lane] = -1;
+
+				m_triangleRefs[refId].Node = NULL;
+			}
+		}
+	}
+
+	void CBVHBuilder::drawDebug()
+	{
+		CSceneDebug* debug = CSceneDebug::getInstance();
+
+		for (u32 i = 0, n = m_bvhNodes.size(); i < n; i++)
+		{
+			const SBVHNode4& node = m_bvhNodes[i];
+			for (int j = 0; j < 4; j++)
+			{
+				if (node.Child[j] < 0 && node.Count[j] == 0)
+					continue;
+
+				core::aabbox3df box(
+					core::vector3df(node.MinX[j], node.MinY[j], node.MinZ[j]),
+					core::vector3df(node.MaxX[j], node.MaxY[j], node.MaxZ[j]));
+
+				debug->addBoudingBox(box, SColor(255, 255, 0, 0));
+			}
+		}
+	}
+
+	bool CBVHBuilder::initRay(const core::line3d<f32>& line, f32 maxDistanceSquared, SRay& ray)
+	{
+		ray.Start = line.start;
+		ray.Vector = line.end - line.start;
+
+		f32 lengthSQ = ray.Vector.getLengthSQ();
+		if (lengthSQ == 0.0f || maxDistanceSquared <= 0.0f)
+			return false;
+
+		ray.TMax = maxDistanceSquared >= lengthSQ ? 1.0f : sqrtf(maxDistanceSquared / lengthSQ);
+
+		// no inf/nan on the slab test when the ray start on the box plane
+		for (int i = 0; i < 3; i++)
+		{
+			f32 d = getAxis(ray.Vector, i);
+			f32 inv = fabsf(d) > 1e-20f ? 1.0f / d : (d < 0.0f ? -1e30f : 1e30f);
+			(&ray.InvVector.X)[i] = inv;
+		}
+
+		return true;
+	}
+
+	s32 CBVHBuilder::intersectPacket(const SBVHTrianglePacket& packet, SRay& ray)
+	{
+		// Moller-Trumbore on 4 triangles
+		f32x4 dx = CSIMD::splat4(ray.Vector.X);
+		f32x4 dy = CSIMD::splat4(ray.Vector.Y);
+		f32x4 dz = CSIMD::splat4(ray.Vector.Z);
+
+		f32x4 e1x = CSIMD::load4(packet.E1X);
+		f32x4 e1y = CSIMD::load4(packet.E1Y);
+		f32x4 e1z = CSIMD::load4(packet.E1Z);
+		f32x4 e2x = CSIMD::load4(packet.E2X);
+		f32x4 e2y = CSIMD::load4(packet.E2Y);
+		f32x4 e2z = CSIMD::load4(packet.E2Z);
+
+		// p = d x e2
+		f32x4 px = CSIMD::sub4(CSIMD::mul4(dy, e2z), CSIMD::mul4(dz, e2y));
+		f32x4 py = CSIMD::sub4(CSIMD::mul4(dz, e2x), CSIMD::mul4(dx, e2z));
+		f32x4 pz = CSIMD::sub4(CSIMD::mul4(dx, e2y), CSIMD::mul4(dy, e2x));
+
+		f32x4 det = CSIMD::madd4(e1x, px, CSIMD::madd4(e1y, py, CSIMD::mul4(e1z, pz)));
+
+		f32x4 zero = CSIMD::splat4(0.0f);
+		f32x4 one = CSIMD::splat4(1.0f);
+		f32x4 invDet = CSIMD::div4(one, det);
+
+		// s = o - a
+		f32x4 sx = CSIMD::sub4(CSIMD::splat4(ray.Start.X), CSIMD::load4(packet.AX));
+		f32x4 sy = CSIMD::sub4(CSIMD::splat4(ray.Start.Y), CSIMD::load4(packet.AY));
+		f32x4 sz = CSIMD::sub4(CSIMD::splat4(ray.Start.Z), CSIMD::load4(packet.AZ));
+
+		f32x4 u = CSIMD::mul4(CSIMD::madd4(sx, px, CSIMD::madd4(sy, py, CSIMD::mul4(sz, pz))), invDet);
+
+		// q = s x e1
+		f32x4 qx = CSIMD::sub4(CSIMD::mul4(sy, e1z), CSIMD::mul4(sz, e1y));
+		f32x4 qy = CSIMD::sub4(CSIMD::mul4(sz, e1x), CSIMD::mul4(sx, e1z));
+		f32x4 qz = CSIMD::sub4(CSIMD::mul4(sx, e1y), CSIMD::mul4(sy, e1x));
+
+		f32x4 v = CSIMD::mul4(CSIMD::madd4(dx, qx, CSIMD::madd4(dy, qy, CSIMD::mul4(dz, qz))), invDet);
+		f32x4 t = CSIMD::mul4(CSIMD::madd4(e2x, qx, CSIMD::madd4(e2y, qy, CSIMD::mul4(e2z, qz))), invDet);
+
+		f32x4 eps = CSIMD::splat4(-BVH_TRIANGLE_EPSILON);
+
+		f32x4 valid = CSIMD::less4(zero, CSIMD::mul4(det, det));
+		valid = CSIMD::and4(valid, CSIMD::lessEqual4(eps, u));
+		valid = CSIMD::and4(valid, CSIMD::lessEqual4(eps, v));
+		valid = CSIMD::and4(valid, CSIMD::lessEqual4(CSIMD::add4(u, v), CSIMD::splat4(1.0f + BVH_TRIANGLE_EPSILON)));
+		valid = CSIMD::and4(valid, CSIMD::lessEqual4(zero, t));
+		valid = CSIMD::and4(valid, CSIMD::less4(t, CSIMD::splat4(ray.TMax)));
+
+		int mask = CSIMD::mask4(valid);
+		if (mask == 0)
+			return -1;
+
+		f32 dist[4];
+		CSIMD::store4(dist, t);
+
+		s32 hit = -1;
+		for (int i = 0; i < 4; i++)
+		{
+			if ((mask & (1 << i)) && packet.Triangle[i] >= 0 && dist[i] < ray.TMax)
+			{
+				ray.TMax = dist[i];
+				hit = packet.Triangle[i];
+			}
+		}
+
+		return hit;
+	}
+
+	s32 CBVHBuilder::intersectRay(SRay& ray, bool anyHit)
+	{
+		if (m_bvhNodes.size() == 0)
+			return -1;
+
+		struct SEntry
+		{
+			s32 Child;
+			s32 Count;
+			f32 TNear;
+		};
+
+		SEntry stack[BVH_STACK_SIZE];
+		int top = 0;
+
+		stack[top].Child = 0;
+		stack[top].Count = 0;
+		stack[top].TNear = 0.0f;
+		top++;
+
+		f32x4 ox = CSIMD::splat4(ray.Start.X);
+		f32x4 oy = CSIMD::splat4(ray.Start.Y);
+		f32x4 oz = CSIMD::splat4(ray.Start.Z);
+		f32x4 ix = CSIMD::splat4(ray.InvVector.X);
+		f32x4 iy = CSIMD::splat4(ray.InvVector.Y);
+		f32x4 iz = CSIMD::splat4(ray.InvVector.Z);
+		f32x4 zero = CSIMD::splat4(0.0f);
+
+		s32 hit = -1;
+
+		while (top > 0)
+		{
+			const SEntry entry = stack[--top];
+
+			// a nearer triangle is hit, skip the far node
+			if (entry.TNear > ray.TMax)
+				continue;
+
+			if (entry.Child < 0)
+			{
+				const SBVHTrianglePacket* packets = m_packets.const_pointer() + (-entry.Child - 1);
+				for (s32 i = 0; i < entry.Count; i++)
+				{
+					s32 id = intersectPacket(packets[i], ray);
+					if (id >= 0)
+					{
+						hit = id;
+						if (anyHit)
+							return hit;
+					}
+				}
+				continue;
+			}
+
+			// slab test on 4 boxes
+			const SBVHNode4& node = m_bvhNodes[entry.Child];
+
+			f32x4 t0x = CSIMD::mul4(CSIMD::sub4(CSIMD::load4(node.MinX), ox), ix);
+			f32x4 t1x = CSIMD::mul4(CSIMD::sub4(CSIMD::load4(node.MaxX), ox), ix);
+			f32x4 t0y = CSIMD::mul4(CSIMD::sub4(CSIMD::load4(node.MinY), oy), iy);
+			f32x4 t1y = CSIMD::mul4(CSIMD::sub4(CSIMD::load4(node.MaxY), oy), iy);
+			f32x4 t0z = CSIMD::mul4(CSIMD::sub4(CSIMD::load4(node.MinZ), oz), iz);
+			f32x4 t1z = CSIMD::mul4(CSIMD::sub4(CSIMD::load4(node.MaxZ), oz), iz);
+
+			f32x4 tNear = CSIMD::max4(
+				CSIMD::max4(CSIMD::min4(t0x, t1x), CSIMD::min4(t0y, t1y)),
+				CSIMD::max4(CSIMD::min4(t0z, t1z), zero));
+
+			f32x4 tFar = CSIMD::min4(
+				CSIMD::min4(CSIMD::max4(t0x, t1x), CSIMD::max4(t0y, t1y)),
+				CSIMD::min4(CSIMD::max4(t0z, t1z), CSIMD::splat4(ray.TMax)));
+
+			int mask = CSIMD::mask4(CSIMD::lessEqual4(tNear, tFar));
+			if (mask == 0)
+				continue;
+
+			f32 dist[4];
+			CSIMD::store4(dist, tNear);
+
+			// sort the hit childs far to near, the nearest is on the top of stack
+			SEntry childs[4];
+			int numChild = 0;
+
+			for (int i = 0; i < 4; i++)
+			{
+				if ((mask & (1 << i)) == 0 || (node.Child[i] < 0 && node.Count[i] == 0))
+					continue;
+
+				int j = numChild++;
+				while (j > 0 && childs[j - 1].TNear < dist[i])
+				{
+					childs[j] = childs[j - 1];
+					j--;
+				}
+
+				childs[j].Child = node.Child[i];
+				childs[j].Count = node.Count[i];
+				childs[j].TNear = dist[i];
+			}
+
+			for (int i = 0; i < numChild; i++)
+				stack[top++] = childs[i];
+		}
+
+		return hit;
+	}
+
+	bool CBVHBuilder::getCollisionPoint(
+		const core::line3d<f32>& ray,
+		f32& outBestDistanceSquared,
+		core::vector3df& outIntersection,
+		core::triangle3df& outTriangle,
+		CCollisionNode*& outNode)
+	{
+		outNode = NULL;
+
+		SRay r;
+		if (!initRay(ray, outBestDistanceSquared, r))
+			return false;
+
+		s32 hit = intersectRay(r, false);
+		if (hit < 0)
+			return false;
+
+		const SBVHTriangleRef& ref = m_triangleRefs[hit];
+
+		outNode = ref.Node;
+		outTriangle = ref.Node->Triangles[ref.TriangleID];
+		outIntersection = r.Start + r.Vector * r.TMax;
+		outBestDistanceSquared = outIntersection.getDistanceFromSQ(ray.start);
+		return true;
+	}
+
+	bool CBVHBuilder::hasCollision(const core::line3d<f32>& ray)
+	{
+		SRay r;
+		if (!initRay(ray, ray.getLengthSQ(), r))
+			return false;
+
+		// stop at the first hit triangle
+		return intersectRay(r, true) >= 0;
+	}
+
+	void CBVHBuilder::getTriangles(const core::aabbox3df& box,
+		core::array<core::triangle3df*>& result,
+		core::array<CCollisionNode*>& nodes)
+	{
+		if (m_bvhNodes.size() == 0)
+			return;
+
+		s32 stack[BVH_STACK_SIZE];
+		int top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const SBVHNode4& node = m_bvhNodes[stack[--top]];
+
+			for (int i = 0; i < 4; i++)
+			{
+				if (node.Child[i] < 0 && node.Count[i] == 0)
+					continue;
+
+				if (node.MinX[i] > box.MaxEdge.X || node.MaxX[i] < box.MinEdge.X ||
+					node.MinY[i] > box.MaxEdge.Y || node.MaxY[i] < box.MinEdge.Y ||
+					node.MinZ[i] > box.MaxEdge.Z || node.MaxZ[i] < box.MinEdge.Z)
+					continue;
+
+				if (node.Child[i] >= 0)
+				{
+					stack[top++] = node.Child[i];
+					continue;
+				}
+
+				const SBVHTrianglePacket* packets = m_packets.const_pointer() + (-node.Child[i] - 1);
+				for (s32 p = 0; p < node.Count[i]; p++)
+				{
+					for (int lane = 0; lane < 4; lane++)
+					{
+						s32 refId = packets[p].Triangle[lane];
+						if (refId < 0)
+							continue;
+
+						const SBVHTriangleRef& ref = m_triangleRefs[refId];
+						core::triangle3df& triangle = ref.Node->Triangles[ref.TriangleID];
+
+						// if triangle collide the bbox
+						if (!triangle.isTotalOutsideBox(box))
+						{
+							result.push_back(&triangle);
+							nodes.push_back(ref.Node);
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,160 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the Rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CCollisionBuilder.h"
+
+namespace Skylicht
+{
+	// 4 child boxes of a bvh node in SoA layout, a ray test them at once
+	struct SBVHNode4
+	{
+		f32 MinX[4];
+		f32 MinY[4];
+		f32 MinZ[4];
+		f32 MaxX[4];
+		f32 MaxY[4];
+		f32 MaxZ[4];
+
+		// >= 0: index of the child node
+		// < 0: leaf, the first triangle packet is (-Child - 1)
+		s32 Child[4];
+
+		// number of triangle packets of the leaf (0 on the inner node)
+		s32 Count[4];
+	};
+
+	// 4 triangles in SoA layout: the point A and 2 edges
+	struct SBVHTrianglePacket
+	{
+		f32 AX[4];
+		f32 AY[4];
+		f32 AZ[4];
+		f32 E1X[4];
+		f32 E1Y[4];
+		f32 E1Z[4];
+		f32 E2X[4];
+		f32 E2Y[4];
+		f32 E2Z[4];
+
+		// index of the triangle reference, -1 on the empty lane
+		s32 Triangle[4];
+	};
+
+	struct SBVHTriangleRef
+	{
+		CCollisionNode* Node;
+		s32 TriangleID;
+	};
+
+	class CBVHBuilder : public CCollisionBuilder
+	{
+	protected:
+		struct SBuildNode
+		{
+			core::aabbox3df Box;
+			s32 Left;
+			s32 Right;
+			u32 First;
+			u32 Count;
+		};
+
+		struct SBuildContext
+		{
+			std::vector<core::aabbox3df> Boxes;
+			std::vector<core::vector3df> Centers;
+			std::vector<u32> Triangles;
+			std::vector<SBuildNode> Nodes;
+		};
+
+		struct SRay
+		{
+			core::vector3df Start;
+			core::vector3df Vector;
+			core::vector3df InvVector;
+
+			// hit distance in [0, TMax] of Vector
+			f32 TMax;
+		};
+
+		core::array<SBVHNode4> m_bvhNodes;
+		core::array<SBVHTrianglePacket> m_packets;
+		core::array<SBVHTriangleRef> m_triangleRefs;
+
+		u32 m_maxLeafTriangles;
+
+	public:
+		CBVHBuilder();
+
+		virtual ~CBVHBuilder();
+
+		virtual void build();
+
+		virtual void clear();
+
+		void drawDebug();
+
+		inline u32 getNodeCount()
+		{
+			return m_bvhNodes.size();
+		}
+
+		inline u32 getPacketCount()
+		{
+			return m_packets.size();
+		}
+
+	public:
+
+		virtual bool getCollisionPoint(
+			const core::line3d<f32>& ray,
+			f32& outBestDistanceSquared,
+			core::vector3df& outIntersection,
+			core::triangle3df& outTriangle,
+			CCollisionNode*& outNode);
+
+		virtual bool hasCollision(const core::line3d<f32>& ray);
+
+		virtual void getTriangles(const core::aabbox3df& box,
+			core::array<core::triangle3df*>& result,
+			core::array<CCollisionNode*>& nodes);
+
+	protected:
+
+		virtual void onRemoveCollision(CCollisionNode* node);
+
+		s32 buildNode(SBuildContext& context, u32 first, u32 count, int depth);
+
+		s32 collapseNode(SBuildContext& context, s32 buildNodeId);
+
+		void addLeafPackets(SBuildContext& context, const SBuildNode& leaf, s32& outChild, s32& outCount);
+
+		bool initRay(const core::line3d<f32>& line, f32 maxDistanceSquared, SRay& ray);
+
+		s32 intersectRay(SRay& ray, bool anyHit);
+
+		s32 intersectPacket(const SBVHTrianglePacket& packet, SRay& ray);
+	};
+}
@@ -24,8 +24,14 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CCollisionBuilder.h"
+#include "CMeshTriangleSelector.h"
+#include "CBBTriangleSelector.h"
 
 #include "GameObject/CGameObject.h"
+#include "RenderMesh/CRenderMesh.h"
+#include "Job/CJobSystem.h"
+
+#define MIN_COLLISION_QUERY_BATCH 32
 
 namespace Skylicht
 {
@@ -39,61 +45,89 @@ namespace Skylicht
 
 	}
 
+	CCollisionNode* CCollisionBuilder::addCollision(CGameObject* gameObject, CEntity* entity, CTriangleSelector* selector)
+	{
+		CCollisionNode* node = new CCollisionNode(gameObject, entity, selector);
+		m_nodes.push_back(node);
+		return node;
+	}
+
+	bool CCollisionBuilder::addMeshCollision(CGameObject* gameObject)
+	{
+		CRenderMesh* renderMesh = gameObject->getComponent<CRenderMesh>();
+		if (renderMesh == NULL)
+			return false;
+
+		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
+		for (CRenderMeshData* renderMesh : renderers)
+		{
+			CEntity* entity = renderMesh->Entity;
+			addCollision(gameObject, entity, new CMeshTriangleSelector(entity));
+		}
+
+		return renderers.size() > 0;
+	}
+
+	bool CCollisionBuilder::addBBoxCollision(CGameObject* gameObject)
+	{
+		CRenderMesh* renderMesh = gameObject->getComponent<CRenderMesh>();
+		if (renderMesh == NULL)
+			return false;
+
+		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
+		for (CRenderMeshData* renderMesh : renderers)
+		{
+			CEntity* entity = renderMesh->Entity;
+			addCollision(gameObject, entity, new CBBTriangleSelector(entity));
+		}
+
+		return renderers.size() > 0;
+	}
+
 	void CCollisionBuilder::removeCollision(CGameObject* object)
 	{
-		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		u32 i = 0;
+		while (i < m_nodes.size())
 		{
 			if (m_nodes[i]->GameObject == object)
-			{
-				if (n >= 2)
-				{
-					// swap to last and delete
-					CCollisionNode* t = m_nodes[n - 1];
-					m_nodes[n - 1] = m_nodes[i];
-					m_nodes[i] = t;
-					delete m_nodes[n - 1];
-					m_nodes.erase(n - 1);
-					return;
-				}
-				else
-				{
-					delete m_nodes[i];
-					m_nodes.erase(i);
-					return;
-				}
-			}
+				removeNode(i);
+			else
+				i++;
 		}
 	}
 
 	void CCollisionBuilder::removeCollision(CCollisionNode** nodes, int count)
 	{
-		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		u32 i = 0;
+		while (i < m_nodes.size())
 		{
 			int id = findNode(m_nodes[i], nodes, count);
 			if (id >= 0)
 			{
 				nodes[id] = NULL;
-
-				if (n >= 2)
-				{
-					// swap to last and delete
-					CCollisionNode* t = m_nodes[n - 1];
-					m_nodes[n - 1] = m_nodes[i];
-					m_nodes[i] = t;
-					delete m_nodes[n - 1];
-					m_nodes.erase(n - 1);
-					return;
-				}
-				else
-				{
-					delete m_nodes[i];
-					m_nodes.erase(i);
-					return;
-				}
+				removeNode(i);
+			}
+			else
+			{
+				i++;
 			}
 		}
 	}
 
+	void CCollisionBuilder::removeNode(u32 id)
+	{
+		CCollisionNode* node = m_nodes[id];
+		onRemoveCollision(node);
+
+		// swap to last and delete
+		u32 last = m_nodes.size() - 1;
+		m_nodes[id] = m_nodes[last];
+		m_nodes.erase(last);
+
+		delete node->Selector;
+		delete node;
+	}
+
 	void CCollisionBuilder::clear()
 	{
 		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
@@ -142,4 +176,141 @@ namespace Skylicht
 		float outBestDistanceSquared = ray.getLengthSQ();
 		return getCollisionPoint(ray, outBestDistanceSquared, outIntersection, outTriangle, outNode);
 	}
+
+	bool CCollisionBuilder::hasCollision(const core::line3d<f32>& ray)
+	{
+		f32 outBestDistanceSquared = ray.getLengthSQ();
+		core::vector3df outIntersection;
+		core::triangle3df outTriangle;
+		CCollisionNode* outNode = NULL;
+		return getCollisionPoint(ray, outBestDistanceSquared, outIntersection, outTriangle, outNode);
+	}
+
+	int CCollisionBuilder::getQueryBatchSize(u32 count, bool parallel)
+	{
+		// 0: query on the calling thread
+		if (!parallel || count < MIN_COLLISION_QUERY_BATCH * 2)
+			return 0;
+
+		int numThread = SkylichtSystem::CJobSystem::getInstance()->getWorkerCount() + 1;
+		if (numThread == 1)
+			return 0;
+
+		return core::max_(MIN_COLLISION_QUERY_BATCH, (int)count / (numThread * 4));
+	}
+
+	u32 CCollisionBuilder::getCollisionPoints(const core::line3d<f32>* rays, u32 count, SCollisionHit* results, bool parallel)
+	{
+		auto query = [this, rays, results](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+				{
+					SCollisionHit& hit = results[i];
+					hit.Node = NULL;
+					hit.DistanceSquared = rays[i].getLengthSQ();
+					getCollisionPoint(rays[i], hit.DistanceSquared, hit.Intersection, hit.Triangle, hit.Node);
+				}
+			};
+
+		int batch = getQueryBatchSize(count, parallel);
+		if (batch == 0)
+			query(0, (int)count);
+		else
+			SkylichtSystem::CJobSystem::getInstance()->parallelFor((int)count, batch, query);
+
+		u32 numHit = 0;
+		for (u32 i = 0; i < count; i++)
+		{
+			if (results[i].Node != NULL)
+				numHit++;
+		}
+		return numHit;
+	}
+
+	u32 CCollisionBuilder::hasCollisions(const core::line3d<f32>* rays, u32 count, bool* results, bool parallel)
+	{
+		auto query = [this, rays, results](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+					results[i] = hasCollision(rays[i]);
+			};
+
+		int batch = getQueryBatchSize(count, parallel);
+		if (batch == 0)
+			query(0, (int)count);
+		else
+			SkylichtSystem::CJobSystem::getInstance()->parallelFor((int)count, batch, query);
+
+		u32 numHit = 0;
+		for (u32 i = 0; i < count; i++)
+		{
+			if (results[i])
+				numHit++;
+		}
+		return numHit;
+	}
+
+	void CCollisionBuilder::getTrianglesInBoxes(const core::aabbox3df* boxes, u32 count, SCollisionOverlap& result, bool parallel)
+	{
+		result.Offsets.set_used(count + 1);
+		result.Triangles.set_used(0);
+		result.Nodes.set_used(0);
+		result.Offsets[0] = 0;
+
+		if (count == 0)
+			return;
+
+		int batch = getQueryBatchSize(count, parallel);
+		if (batch == 0)
+			batch = (int)count;
+
+		// each batch collects to its own arrays, they are merged in order of the boxes
+		int numChunk = ((int)count + batch - 1) / batch;
+		std::vector<SCollisionOverlap> chunks(numChunk);
+
+		auto query = [this, boxes, batch, &chunks, &result](int from, int to)
+			{
+				SCollisionOverlap& chunk = chunks[from / batch];
+				for (int i = from; i < to; i++)
+				{
+					// the offset in the chunk
+					result.Offsets[i] = chunk.Triangles.size();
+					getTriangles(boxes[i], chunk.Triangles, chunk.Nodes);
+				}
+			};
+
+		if (numChunk == 1)
+			query(0, (int)count);
+		else
+			SkylichtSystem::CJobSystem::getInstance()->parallelFor((int)count, batch, query);
+
+		u32 total = 0;
+		for (int c = 0; c < numChunk; c++)
+			total += chunks[c].Triangles.size();
+
+		result.Triangles.set_used(total);
+		result.Nodes.set_used(total);
+
+		u32 offset = 0;
+		for (int c = 0; c < numChunk; c++)
+		{
+			SCollisionOverlap& chunk = chunks[c];
+			u32 n = chunk.Triangles.size();
+
+			u32 from = (u32)(c * batch);
+			u32 to = core::min_(from + (u32)batch, count);
+			for (u32 i = from; i < to; i++)
+				result.Offsets[i] += offset;
+
+			if (n > 0)
+			{
+				memcpy(result.Triangles.pointer() + offset, chunk.Triangles.const_pointer(), n * sizeof(core::triangle3df*));
+				memcpy(result.Nodes.pointer() + offset, chunk.Nodes.const_pointer(), n * sizeof(CCollisionNode*));
+			}
+
+			offset += n;
+		}
+
+		result.Offsets[count] = offset;
+	}
 }
\ No newline at end of file
@@ -28,6 +28,26 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	// result of a ray in the batched query
+	struct SCollisionHit
+	{
+		// NULL if the ray does not hit
+		CCollisionNode* Node;
+
+		core::vector3df Intersection;
+		core::triangle3df Triangle;
+		f32 DistanceSquared;
+	};
+
+	// result of the batched box query
+	// the triangles of box i are in [Offsets[i], Offsets[i + 1])
+	struct SCollisionOverlap
+	{
+		core::array<u32> Offsets;
+		core::array<core::triangle3df*> Triangles;
+		core::array<CCollisionNode*> Nodes;
+	};
+
 	class CCollisionBuilder
 	{
 	protected:
@@ -38,10 +58,17 @@ namespace Skylicht
 
 		virtual ~CCollisionBuilder();
 
-		// remember build() after the remove
+		// remember build() after the add
+		CCollisionNode* addCollision(CGameObject* gameObject, CEntity* entity, CTriangleSelector* selector);
+
+		bool addMeshCollision(CGameObject* gameObject);
+
+		bool addBBoxCollision(CGameObject* gameObject);
+
+		// the builder remove the triangles of the nodes, no need to build() again
 		void removeCollision(CGameObject* object);
 
-		// remember build() after the remove
+		// the builder remove the triangles of the nodes, no need to build() again
 		void removeCollision(CCollisionNode** nodes, int count);
 
 		virtual void clear();
@@ -73,8 +100,33 @@ namespace Skylicht
 			core::triangle3df& outTriangle,
 			CCollisionNode*& outNode) = 0;
 
+		// line of sight test, the builder can stop at the first hit triangle
+		virtual bool hasCollision(const core::line3d<f32>& ray);
+
 		virtual void getTriangles(const core::aabbox3df& box,
 			core::array<core::triangle3df*>& result,
 			core::array<CCollisionNode*>& nodes) = 0;
+
+	public:
+
+		// The batched queries are split on CJobSystem workers (parallel = true).
+		// The queries are thread safe, but do not add, remove or build() the collision while querying.
+
+		// results[i] is the nearest hit of rays[i], return the number of hit
+		u32 getCollisionPoints(const core::line3d<f32>* rays, u32 count, SCollisionHit* results, bool parallel = true);
+
+		// results[i] = hasCollision(rays[i]), return the number of hit
+		u32 hasCollisions(const core::line3d<f32>* rays, u32 count, bool* results, bool parallel = true);
+
+		void getTrianglesInBoxes(const core::aabbox3df* boxes, u32 count, SCollisionOverlap& result, bool parallel = true);
+
+	protected:
+
+		int getQueryBatchSize(u32 count, bool parallel);
+
+		// the node is removed, it will be deleted after this call
+		virtual void onRemoveCollision(CCollisionNode* node) {}
+
+		void removeNode(u32 id);
 	};
 }
\ No newline at end of file
@@ -25,10 +25,6 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CCollisionManager.h"
 #include "COctreeNode.h"
-#include "CMeshTriangleSelector.h"
-#include "CBBTriangleSelector.h"
-#include "RenderMesh/CRenderMesh.h"
-#include "Entity/CEntityManager.h"
 
 namespace Skylicht
 {
@@ -41,44 +37,4 @@ namespace Skylicht
 	{
 
 	}
-
-	bool CCollisionManager::addMeshCollision(CGameObject* gameObject)
-	{
-		CRenderMesh* renderMesh = gameObject->getComponent<CRenderMesh>();
-		if (renderMesh == NULL)
-			return false;
-
-		CEntityManager* entityMgr = gameObject->getEntityManager();
-
-		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
-		for (CRenderMeshData* renderMesh : renderers)
-		{
-			CEntity* entity = renderMesh->Entity;
-			m_nodes.push_back(
-				new CCollisionNode(gameObject, entity, new CMeshTriangleSelector(entity))
-			);
-		}
-
-		return renderers.size() > 0;
-	}
-
-	bool CCollisionManager::addBBoxCollision(CGameObject* gameObject)
-	{
-		CRenderMesh* renderMesh = gameObject->getComponent<CRenderMesh>();
-		if (renderMesh == NULL)
-			return false;
-
-		CEntityManager* entityMgr = gameObject->getEntityManager();
-
-		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
-		for (CRenderMeshData* renderMesh : renderers)
-		{
-			CEntity* entity = renderMesh->Entity;
-			m_nodes.push_back(
-				new CCollisionNode(gameObject, entity, new CBBTriangleSelector(entity))
-			);
-		}
-
-		return renderers.size() > 0;
-	}
 }
\ No newline at end of file
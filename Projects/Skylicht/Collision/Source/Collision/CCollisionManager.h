@@ -36,9 +36,5 @@ namespace Skylicht
 		CCollisionManager();
 
 		virtual ~CCollisionManager();
-
-		bool addMeshCollision(CGameObject* gameObject);
-
-		bool addBBoxCollision(CGameObject* gameObject);
 	};
 }
\ No newline at end of file
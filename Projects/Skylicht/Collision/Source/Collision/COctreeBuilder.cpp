@@ -41,12 +41,26 @@ namespace Skylicht
 		clear();
 	}
 
+	// the box of the empty octree node: the point is never inside, addInternalPoint still works
+	static void resetEmptyBox(core::aabbox3df& box)
+	{
+		box.MinEdge.set(1e30f, 1e30f, 1e30f);
+		box.MaxEdge.set(-1e30f, -1e30f, -1e30f);
+	}
+
+	static bool isEmptyBox(const core::aabbox3df& box)
+	{
+		return box.MinEdge.X > box.MaxEdge.X;
+	}
+
 	void COctreeBuilder::clear()
 	{
 		if (m_root != NULL)
 			delete m_root;
 		m_root = NULL;
 
+		m_collisionOctrees.clear();
+
 		CCollisionBuilder::clear();
 	}
 
@@ -74,7 +88,7 @@ namespace Skylicht
 		// step 2: index triangle & bbox
 		u32 idx = 0;
 
-		m_root->Box.reset(m_nodes[0]->Triangles[0].pointA);
+		resetEmptyBox(m_root->Box);
 
 		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
 		{
@@ -102,11 +116,293 @@ namespace Skylicht
 		// step 3 build octree child node
 		constructOctree(m_root);
 
+		// step 4 the octree nodes of collisions, see removeTriangles
+		m_collisionOctrees.clear();
+		registerOctree(m_root);
+
 		c8 tmp[256];
 		sprintf(tmp, "Needed %ums to COctreeBuilder::build (%u polys)", os::Timer::getRealTime() - start, numPoly);
 		os::Printer::log(tmp, ELL_INFORMATION);
 	}
 
+	void COctreeBuilder::insertCollision(CCollisionNode* node)
+	{
+		if (m_root == NULL)
+		{
+			build();
+			return;
+		}
+
+		if (m_collisionOctrees.find(node) != m_collisionOctrees.end())
+			return;
+
+		node->updateTransform();
+		insertTriangles(node);
+	}
+
+	void COctreeBuilder::insertCollision(CGameObject* object)
+	{
+		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		{
+			if (m_nodes[i]->GameObject == object)
+				insertCollision(m_nodes[i]);
+		}
+	}
+
+	void COctreeBuilder::updateCollision(CCollisionNode* node)
+	{
+		if (m_root == NULL)
+		{
+			build();
+			return;
+		}
+
+		removeTriangles(node);
+		node->updateTransform();
+		insertTriangles(node);
+	}
+
+	void COctreeBuilder::updateCollision(CGameObject* object)
+	{
+		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		{
+			if (m_nodes[i]->GameObject == object)
+				updateCollision(m_nodes[i]);
+		}
+	}
+
+	void COctreeBuilder::onRemoveCollision(CCollisionNode* node)
+	{
+		if (m_root != NULL)
+			removeTriangles(node);
+	}
+
+	void COctreeBuilder::insertTriangles(CCollisionNode* node)
+	{
+		std::vector<COctreeNode*>& octrees = m_collisionOctrees[node];
+
+		u32 numTris = node->Triangles.size();
+		core::triangle3df* tris = node->Triangles.pointer();
+
+		for (u32 i = 0; i < numTris; i++)
+		{
+			core::triangle3df& tri = tris[i];
+
+			// step 1: the deepest child that contains the triangle
+			COctreeNode* octree = m_root;
+			bool found = true;
+			while (found)
+			{
+				found = false;
+				for (u32 ch = 0; ch < 8; ch++)
+				{
+					COctreeNode* child = octree->Childs[ch];
+					if (child && tri.isTotalInsideBox(child->OctreeBox))
+					{
+						octree = child;
+						found = true;
+						break;
+					}
+				}
+			}
+
+			octree->Triangles.push_back((int)i);
+			octree->Collisions.push_back(node);
+
+			// step 2: grow the bbox to the root
+			for (COctreeNode* p = octree; p != NULL; p = p->Parent)
+			{
+				p->Box.addInternalPoint(tri.pointA);
+				p->Box.addInternalPoint(tri.pointB);
+				p->Box.addInternalPoint(tri.pointC);
+			}
+
+			if (octrees.empty() || octrees.back() != octree)
+				octrees.push_back(octree);
+		}
+
+		// step 3: split the crowded node
+		// the node that has childs keeps the triangles that are not inside any child (out of the root bounds, on an empty octant)
+		// so it is split again when they are doubled from the last split
+		std::vector<COctreeNode*> crowded;
+		for (COctreeNode* octree : octrees)
+		{
+			u32 limit = core::max_(m_minimalPolysPerNode, octree->NumSplitTriangles * 2);
+			if (octree->Triangles.size() > limit)
+				crowded.push_back(octree);
+		}
+
+		if (crowded.empty())
+			return;
+
+		// the parent first, it also splits the childs
+		std::sort(crowded.begin(), crowded.end(), [](COctreeNode* a, COctreeNode* b)
+			{
+				return a->Level < b->Level;
+			});
+
+		std::set<COctreeNode*> removed;
+		for (COctreeNode* octree : crowded)
+		{
+			if (removed.find(octree) == removed.end())
+				splitOctree(octree, removed);
+		}
+	}
+
+	void COctreeBuilder::removeTriangles(CCollisionNode* node)
+	{
+		std::map<CCollisionNode*, std::vector<COctreeNode*>>::iterator it = m_collisionOctrees.find(node);
+		if (it == m_collisionOctrees.end())
+			return;
+
+		std::vector<COctreeNode*> changed;
+
+		for (COctreeNode* octree : it->second)
+		{
+			u32 used = 0;
+			for (u32 i = 0, n = octree->Triangles.size(); i < n; i++)
+			{
+				if (octree->Collisions[i] != node)
+				{
+					octree->Triangles[used] = octree->Triangles[i];
+					octree->Collisions[used] = octree->Collisions[i];
+					used++;
+				}
+			}
+
+			if (used == octree->Triangles.size())
+				continue;
+
+			octree->Triangles.set_used(used);
+			octree->Collisions.set_used(used);
+
+			refitBox(octree);
+			changed.push_back(octree);
+		}
+
+		m_collisionOctrees.erase(it);
+
+		// shrink the bbox to the root
+		refitParents(changed);
+	}
+
+	void COctreeBuilder::registerOctree(COctreeNode* node)
+	{
+		for (u32 i = 0, n = node->Collisions.size(); i < n; i++)
+		{
+			std::vector<COctreeNode*>& octrees = m_collisionOctrees[node->Collisions[i]];
+			if (octrees.empty() || octrees.back() != node)
+				octrees.push_back(node);
+		}
+
+		for (u32 i = 0; i < 8; i++)
+		{
+			if (node->Childs[i])
+				registerOctree(node->Childs[i]);
+		}
+	}
+
+	void COctreeBuilder::refitBox(COctreeNode* node)
+	{
+		resetEmptyBox(node->Box);
+
+		for (u32 i = 0, n = node->Triangles.size(); i < n; i++)
+		{
+			const core::triangle3df& tri = node->Collisions[i]->Triangles[node->Triangles[i]];
+			node->Box.addInternalPoint(tri.pointA);
+			node->Box.addInternalPoint(tri.pointB);
+			node->Box.addInternalPoint(tri.pointC);
+		}
+
+		for (u32 i = 0; i < 8; i++)
+		{
+			COctreeNode* child = node->Childs[i];
+			if (child && !isEmptyBox(child->Box))
+				node->Box.addInternalBox(child->Box);
+		}
+	}
+
+	void COctreeBuilder::refitParents(const std::vector<COctreeNode*>& nodes)
+	{
+		// each parent is refit once, the deeper parent first
+		std::vector<COctreeNode*> parents;
+		std::set<COctreeNode*> added;
+
+		for (COctreeNode* node : nodes)
+		{
+			for (COctreeNode* p = node->Parent; p != NULL && added.insert(p).second; p = p->Parent)
+				parents.push_back(p);
+		}
+
+		std::sort(parents.begin(), parents.end(), [](COctreeNode* a, COctreeNode* b)
+			{
+				return a->Level > b->Level;
+			});
+
+		for (COctreeNode* p : parents)
+			refitBox(p);
+	}
+
+	void COctreeBuilder::splitOctree(COctreeNode* node, std::set<COctreeNode*>& removed)
+	{
+		// step 1: move the triangles of the childs back to the node
+		std::vector<COctreeNode*> childs;
+		std::set<COctreeNode*> deleted;
+
+		for (u32 ch = 0; ch < 8; ch++)
+		{
+			if (node->Childs[ch])
+				childs.push_back(node->Childs[ch]);
+			node->Childs[ch] = NULL;
+		}
+
+		while (!childs.empty())
+		{
+			COctreeNode* child = childs.back();
+			childs.pop_back();
+
+			for (u32 i = 0, n = child->Triangles.size(); i < n; i++)
+			{
+				node->Triangles.push_back(child->Triangles[i]);
+				node->Collisions.push_back(child->Collisions[i]);
+			}
+
+			for (u32 ch = 0; ch < 8; ch++)
+			{
+				if (child->Childs[ch])
+					childs.push_back(child->Childs[ch]);
+				child->Childs[ch] = NULL;
+			}
+
+			deleted.insert(child);
+			delete child;
+		}
+
+		// step 2: the collisions forget the old octree nodes
+		std::set<CCollisionNode*> collisions;
+		for (u32 i = 0, n = node->Collisions.size(); i < n; i++)
+			collisions.insert(node->Collisions[i]);
+
+		for (CCollisionNode* collision : collisions)
+		{
+			std::vector<COctreeNode*>& octrees = m_collisionOctrees[collision];
+			octrees.erase(std::remove_if(octrees.begin(), octrees.end(), [node, &deleted](COctreeNode* o)
+				{
+					return o == node || deleted.find(o) != deleted.end();
+				}), octrees.end());
+		}
+
+		// step 3: split on the bbox of the triangles, the root bounds are grown to the triangles
+		refitBox(node);
+		if (node == m_root)
+			node->OctreeBox = node->Box;
+
+		constructOctree(node);
+		registerOctree(node);
+
+		removed.insert(deleted.begin(), deleted.end());
+	}
+
 	void COctreeBuilder::drawDebug()
 	{
 		std::queue<COctreeNode*> nodes;
@@ -224,6 +520,9 @@ namespace Skylicht
 					constructOctree(node->Childs[ch]);
 				}
 			}
+
+			// the triangles that are not inside any child, see insertTriangles
+			node->NumSplitTriangles = node->Triangles.size();
 		}
 	}
 
@@ -241,15 +540,22 @@ namespace Skylicht
 
 		float halfLength = ray.getLength() * 0.5f;
 
-		m_triangles.set_used(0);
-		m_collisions.set_used(0);
+		// thread local scratch, the queries can run on many threads
+		static thread_local core::array<core::triangle3df*> triangles;
+		static thread_local core::array<CCollisionNode*> collisions;
+
+		triangles.set_used(0);
+		collisions.set_used(0);
+
+		if (m_root == NULL)
+			return false;
 
 		// step 1: get list triangle collide with ray
-		getTrianglesFromOctree(m_triangles, m_collisions, m_root, mid, vec, halfLength);
+		getTrianglesFromOctree(triangles, collisions, m_root, mid, vec, halfLength);
 
 		// step 2: find nearest triangle
-		s32 cnt = (s32)m_triangles.size();
-		core::triangle3df** listTris = m_triangles.pointer();
+		s32 cnt = (s32)triangles.size();
+		core::triangle3df** listTris = triangles.pointer();
 
 		core::vector3df intersection;
 		f32 nearest = outBestDistanceSquared;
@@ -293,7 +599,7 @@ namespace Skylicht
 
 					outTriangle = *triangle;
 					outIntersection = intersection;
-					outNode = m_collisions[i];
+					outNode = collisions[i];
 					found = true;
 				}
 			}
@@ -343,7 +649,8 @@ namespace Skylicht
 		core::array<core::triangle3df*>& result,
 		core::array<CCollisionNode*>& nodes)
 	{
-		getTrianglesFromOctree(result, nodes, m_root, box);
+		if (m_root != NULL)
+			getTrianglesFromOctree(result, nodes, m_root, box);
 	}
 
 	void COctreeBuilder::getTrianglesFromOctree(
@@ -26,6 +26,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CCollisionBuilder.h"
 
+#include <set>
+
 namespace Skylicht
 {
 	class COctreeBuilder : public CCollisionBuilder
@@ -35,8 +37,8 @@ namespace Skylicht
 
 		u32 m_minimalPolysPerNode;
 
-		core::array<core::triangle3df*> m_triangles;
-		core::array<CCollisionNode*> m_collisions;
+		// the octree nodes that have triangles of the collision
+		std::map<CCollisionNode*, std::vector<COctreeNode*>> m_collisionOctrees;
 
 	public:
 		COctreeBuilder();
@@ -49,6 +51,25 @@ namespace Skylicht
 
 		void drawDebug();
 
+		inline COctreeNode* getRoot()
+		{
+			return m_root;
+		}
+
+		// Dynamic update on the built octree, no need to build() again
+		// - the node added (addCollision, addMeshCollision...) after build() is inserted
+		// - the bbox of nodes are grown, the crowded leaf is split
+		// - the crowded node that has childs (or the root, if the triangles are out of its bounds) is split again
+		// - the bbox of nodes are shrunk on remove
+		void insertCollision(CCollisionNode* node);
+
+		void insertCollision(CGameObject* object);
+
+		// the world transform of the node is changed
+		void updateCollision(CCollisionNode* node);
+
+		void updateCollision(CGameObject* object);
+
 	public:
 
 		virtual bool getCollisionPoint(
@@ -64,6 +85,20 @@ namespace Skylicht
 
 	protected:
 
+		virtual void onRemoveCollision(CCollisionNode* node);
+
+		void insertTriangles(CCollisionNode* node);
+
+		void removeTriangles(CCollisionNode* node);
+
+		void registerOctree(COctreeNode* node);
+
+		void refitBox(COctreeNode* node);
+
+		void refitParents(const std::vector<COctreeNode*>& nodes);
+
+		void splitOctree(COctreeNode* node, std::set<COctreeNode*>& removed);
+
 		void constructOctree(COctreeNode* node);
 
 		void getTrianglesFromOctree(
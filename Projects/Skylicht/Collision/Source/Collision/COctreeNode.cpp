@@ -29,7 +29,8 @@ namespace Skylicht
 {
 	COctreeNode::COctreeNode() :
 		Parent(NULL),
-		Level(0)
+		Level(0),
+		NumSplitTriangles(0)
 	{
 		for (u32 i = 0; i != 8; ++i)
 			Childs[i] = 0;
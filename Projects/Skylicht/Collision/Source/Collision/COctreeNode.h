@@ -45,6 +45,9 @@ namespace Skylicht
 
 		int Level;
 
+		//! The number of triangles kept on this node (they are not inside any child) after the last split, see COctreeBuilder::insertTriangles
+		u32 NumSplitTriangles;
+
 	public:
 		COctreeNode();
 
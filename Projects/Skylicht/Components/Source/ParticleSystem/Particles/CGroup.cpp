@@ -102,8 +102,8 @@ namespace Skylicht
 
 			updateLaunchEmitter();
 
-			CParticle* particles = m_particles.pointer();
-			u32 numParticles = m_particles.size();
+			CParticleArray* particles = &m_particles;
+			u32 numParticles = m_particles.getCount();
 
 			if (visible == true)
 			{
@@ -125,28 +125,31 @@ namespace Skylicht
 			for (IParticleCallback* cb : m_callback)
 				cb->OnParticleUpdate(particles, numParticles, this, dt);
 
-			if (numParticles > 0)
-				m_bbox.reset(particles[0].Position);
-
-			// remove die particle & update box
-			for (u32 i = 0; i < numParticles; i++)
+			// remove dead particle
+			if (m_callback.size() == 0)
 			{
-				CParticle& p = particles[i];
-
-				if (p.Life < 0)
-				{
-					// remove dead particle
-					remove(i);
-					--i;
-					--numParticles;
-				}
-				else
+				m_particles.removeDead();
+			}
+			else
+			{
+				// the callbacks need the dead particle data
+				f32* life = particles->getChannel(CParticleArray::Life);
+				for (u32 i = 0; i < numParticles; i++)
 				{
-					// add bbox
-					m_bbox.addInternalPoint(p.Position);
+					if (life[i] < 0)
+					{
+						remove(i);
+						--i;
+						--numParticles;
+					}
 				}
 			}
 
+			numParticles = m_particles.getCount();
+
+			// update box
+			m_particles.getBoundingBox(m_bbox);
+
 			// update instancing buffer		
 			if (visible == true && m_renderer != NULL)
 			{
@@ -189,11 +192,12 @@ namespace Skylicht
 				SLaunchParticle& launch = m_launch[i];
 				if (launch.Number > 0)
 				{
-					CParticle* newParticles = create(launch.Number);
+					u32 first = create(launch.Number);
 					for (u32 j = 0, n = launch.Number; j < n; j++)
 					{
-						CParticle& p = newParticles[j];
+						CParticle p(first + j);
 						launchParticle(p, launch);
+						m_particles.set(p.Index, p);
 					}
 				}
 			}
@@ -250,70 +254,79 @@ namespace Skylicht
 
 		int CGroup::addParticleByEmitter(CEmitter* emitter, const core::vector3df& position, const core::vector3df& subEmitterDirection)
 		{
-			CParticle* p = create(1);
+			CParticle p(create(1));
 
-			initParticleLifeTime(*p);
+			initParticleLifeTime(p);
 
-			if (p->LifeTime > 0)
+			if (p.LifeTime > 0)
 			{
-				emitter->generateVelocity(*p, emitter->getZone(), this);
+				emitter->generateVelocity(p, emitter->getZone(), this);
 
-				initParticleModel(*p);
+				initParticleModel(p);
 
-				p->Position = position;
-				p->SubEmitterDirection = subEmitterDirection;
+				p.Position = position;
+				p.SubEmitterDirection = subEmitterDirection;
 			}
 
-			return (int)p->Index;
+			m_particles.set(p.Index, p);
+			return (int)p.Index;
 		}
 
 		int CGroup::addParticleVelocityByEmitter(CEmitter* emitter, const core::vector3df& position, const core::vector3df& velocity)
 		{
-			CParticle* p = create(1);
+			CParticle p(create(1));
 
-			initParticleLifeTime(*p);
+			initParticleLifeTime(p);
 
-			if (p->LifeTime > 0)
+			if (p.LifeTime > 0)
 			{
-				emitter->generateVelocity(*p, emitter->getZone(), this);
+				emitter->generateVelocity(p, emitter->getZone(), this);
 
-				initParticleModel(*p);
+				initParticleModel(p);
 
-				p->Position = position;
-				p->Velocity = velocity;
+				p.Position = position;
+				p.Velocity = velocity;
 			}
 
-			return (int)p->Index;
+			m_particles.set(p.Index, p);
+			return (int)p.Index;
 		}
 
-		CParticle* CGroup::create(u32 num)
+		u32 CGroup::create(u32 num)
 		{
-			u32 total = m_particles.size();
-			for (u32 i = 0; i < num; i++)
-			{
-				m_particles.push_back(CParticle(total + i));
-			}
-			return m_particles.pointer() + total;
+			// the new particles are inited by CParticle (see launchParticle)
+			return m_particles.create(num, false);
 		}
 
 		void CGroup::remove(u32 index)
 		{
-			u32 total = m_particles.size();
+			u32 total = m_particles.getCount();
 			if (index >= total)
 				return;
 
-			if (index != total - 1)
+			if (m_callback.size() == 0)
 			{
-				for (IParticleCallback* cb : m_callback)
-					cb->OnSwapParticleData(m_particles[index], m_particles.getLast());
+				m_particles.remove(index);
+				return;
+			}
+
+			// the dead particle data at the last index
+			u32 last = total - 1;
 
-				m_particles[index].swap(m_particles.getLast());
+			CParticle p(last);
+			m_particles.get(index, p);
+			p.Index = last;
+
+			if (index != last)
+			{
+				for (IParticleCallback* cb : m_callback)
+					cb->OnSwapParticleData(index, last);
 			}
 
-			for (IParticleCallback* cb : m_callback)
-				cb->OnParticleDead(m_particles.getLast());
+			m_particles.remove(index);
 
-			m_particles.set_used(total - 1);
+			for (IParticleCallback* cb : m_callback)
+				cb->OnParticleDead(p);
 		}
 
 		CModel* CGroup::createModel(EParticleParams param)
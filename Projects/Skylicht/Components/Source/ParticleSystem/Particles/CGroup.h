@@ -25,6 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "CParticle.h"
+#include "CParticleArray.h"
 #include "Entity/CEntityPrefab.h"
 
 #include "Emitters/CEmitter.h"
@@ -72,7 +73,7 @@ namespace Skylicht
 
 			}
 
-			virtual void OnParticleUpdate(CParticle *particles, int num, CGroup *group, float dt)
+			virtual void OnParticleUpdate(CParticleArray* particles, int num, CGroup* group, float dt)
 			{
 
 			}
@@ -87,7 +88,8 @@ namespace Skylicht
 
 			}
 
-			virtual void OnSwapParticleData(CParticle &p1, CParticle &p2)
+			// the particle index2 is moved to index1 (index1 is dead)
+			virtual void OnSwapParticleData(u32 index1, u32 index2)
 			{
 
 			}
@@ -101,7 +103,7 @@ namespace Skylicht
 		class COMPONENT_API CGroup
 		{
 		protected:
-			core::array<CParticle> m_particles;
+			CParticleArray m_particles;
 			core::array<SLaunchParticle> m_launch;
 
 			std::vector<CEmitter*> m_emitters;
@@ -162,12 +164,12 @@ namespace Skylicht
 
 			inline u32 getNumParticles()
 			{
-				return m_particles.size();
+				return m_particles.getCount();
 			}
 
-			inline CParticle* getParticlePointer()
+			inline CParticleArray* getParticles()
 			{
-				return m_particles.pointer();
+				return &m_particles;
 			}
 
 			inline CEmitter* addEmitter(CEmitter *e)
@@ -267,7 +269,7 @@ namespace Skylicht
 
 			inline u32 getCurrentParticleCount()
 			{
-				return m_particles.size();
+				return m_particles.getCount();
 			}
 
 			CModel* createModel(EParticleParams param);
@@ -308,7 +310,8 @@ namespace Skylicht
 				p.HaveRotate = false;
 			}
 
-			CParticle* create(u32 num);
+			// return the index of the first new particle
+			u32 create(u32 num);
 
 			void remove(u32 i);
 		};
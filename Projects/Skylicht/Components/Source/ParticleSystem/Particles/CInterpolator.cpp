@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CInterpolator.h"
+#include "Utils/CSIMD.h"
 
 namespace Skylicht
 {
@@ -73,5 +74,48 @@ namespace Skylicht
 			float ratioX = (x - previousEntry.x) / (nextEntry.x - previousEntry.x);
 			return y0 + ratioX * (y1 - y0);
 		}
+
+		void CInterpolator::interpolate(const float* x, float* y, u32 count)
+		{
+			if (m_graph.empty())
+			{
+				memset(y, 0, sizeof(float) * count);
+				return;
+			}
+
+			// the graph is small, evaluate all segments on 4 values
+			// the segment k is used when x >= x[k], it is clamped at the next entry
+			std::set<SInterpolatorEntry>::const_iterator it = m_graph.begin();
+			f32x4 y0 = CSIMD::splat4((*it).y);
+
+			for (u32 i = 0; i < count; i += 4)
+				CSIMD::store4(y + i, y0);
+
+			f32x4 zero = CSIMD::splat4(0.0f);
+			f32x4 one = CSIMD::splat4(1.0f);
+
+			std::set<SInterpolatorEntry>::const_iterator next = it;
+			for (++next; next != m_graph.end(); ++it, ++next)
+			{
+				const SInterpolatorEntry& e0 = *it;
+				const SInterpolatorEntry& e1 = *next;
+
+				f32x4 x0 = CSIMD::splat4(e0.x);
+				f32x4 invRange = CSIMD::splat4(1.0f / (e1.x - e0.x));
+				f32x4 startY = CSIMD::splat4(e0.y);
+				f32x4 rangeY = CSIMD::splat4(e1.y - e0.y);
+
+				for (u32 i = 0; i < count; i += 4)
+				{
+					f32x4 v = CSIMD::load4(x + i);
+					f32x4 t = CSIMD::mul4(CSIMD::sub4(v, x0), invRange);
+					t = CSIMD::min4(CSIMD::max4(t, zero), one);
+
+					// x < x0: keep the value of the last segment
+					f32x4 r = CSIMD::select4(CSIMD::less4(v, x0), CSIMD::load4(y + i), CSIMD::madd4(t, rangeY, startY));
+					CSIMD::store4(y + i, r);
+				}
+			}
+		}
 	}
-}
\ No newline at end of file
+}
@@ -62,6 +62,9 @@ namespace Skylicht
 
 			float interpolate(float x);
 
+			// y[i] = interpolate(x[i]), count must be a multiple of 4
+			void interpolate(const float* x, float* y, u32 count);
+
 			inline std::set<SInterpolatorEntry>& getGraph()
 			{
 				return m_graph;
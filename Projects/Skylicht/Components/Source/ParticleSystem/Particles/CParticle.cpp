@@ -39,6 +39,7 @@ namespace Skylicht
 			HaveRotate(false),
 			SubEmitterDirection(0.0f, 1.0f, 0.0f)
 		{
+			memset(Params, 0, sizeof(float) * NumParams);
 			memset(StartValue, 0, sizeof(float) * NumParams);
 			memset(EndValue, 0, sizeof(float) * NumParams);
 
@@ -63,59 +64,5 @@ namespace Skylicht
 		{
 
 		}
-
-		void CParticle::swap(CParticle& p)
-		{
-			float temp[NumParams];
-			u32 size = sizeof(float) * NumParams;
-
-			memcpy(temp, Params, size);
-			memcpy(Params, p.Params, size);
-			memcpy(p.Params, temp, size);
-
-			memcpy(temp, StartValue, size);
-			memcpy(StartValue, p.StartValue, size);
-			memcpy(p.StartValue, temp, size);
-
-			memcpy(temp, EndValue, size);
-			memcpy(EndValue, p.EndValue, size);
-			memcpy(p.EndValue, temp, size);
-
-			float age = Age;
-			float life = Life;
-			float lifeTime = LifeTime;
-			bool haveRotate = HaveRotate;
-			int parentIndex = ParentIndex;
-
-			core::vector3df lastPosition = LastPosition;
-			core::vector3df position = Position;
-			core::vector3df rotation = Rotation;
-			core::vector3df velocity = Velocity;
-			core::vector3df subEmitterDirection = SubEmitterDirection;
-
-			// note: 
-			// Dont swap [p.Index], just swap data
-			Age = p.Age;
-			Life = p.Life;
-			LifeTime = p.LifeTime;
-			LastPosition = p.LastPosition;
-			Position = p.Position;
-			Rotation = p.Rotation;
-			Velocity = p.Velocity;
-			HaveRotate = p.HaveRotate;
-			ParentIndex = p.ParentIndex;
-			SubEmitterDirection = p.SubEmitterDirection;
-
-			p.Age = age;
-			p.Life = life;
-			p.LifeTime = lifeTime;
-			p.LastPosition = lastPosition;
-			p.Position = position;
-			p.Rotation = rotation;
-			p.Velocity = velocity;
-			p.HaveRotate = haveRotate;
-			p.ParentIndex = parentIndex;
-			p.SubEmitterDirection = subEmitterDirection;
-		}
 	}
 }
\ No newline at end of file
@@ -51,6 +51,8 @@ namespace Skylicht
 			NumParams
 		};
 
+		// The data of a particle, it is used to init the particle at born (see CEmitter, CZone)
+		// The group stores the particles in CParticleArray
 		class COMPONENT_API CParticle
 		{
 		public:
@@ -80,9 +82,7 @@ namespace Skylicht
 		public:
 			CParticle(u32 index);
 
-			virtual ~CParticle();
-
-			void swap(CParticle& p);
+			~CParticle();
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,317 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CParticleArray.h"
+#include "Utils/CSIMD.h"
+
+namespace Skylicht
+{
+	namespace Particle
+	{
+		CParticleArray::CParticleArray() :
+			m_count(0),
+			m_capacity(0)
+		{
+
+		}
+
+		CParticleArray::~CParticleArray()
+		{
+
+		}
+
+		void CParticleArray::reserve(u32 num)
+		{
+			if (num <= m_capacity)
+				return;
+
+			u32 capacity = (num + 3) & ~3;
+
+			core::array<f32> data;
+			data.set_used(capacity * ChannelCount);
+
+			f32* dst = data.pointer();
+			memset(dst, 0, sizeof(f32) * capacity * ChannelCount);
+
+			if (m_count > 0)
+			{
+				f32* src = m_data.pointer();
+				for (int c = 0; c < ChannelCount; c++)
+					memcpy(dst + c * capacity, src + c * m_capacity, sizeof(f32) * m_count);
+			}
+
+			m_data.swap(data);
+			m_parentIndex.reallocate(capacity);
+			m_capacity = capacity;
+		}
+
+		u32 CParticleArray::create(u32 num, bool initDefault)
+		{
+			u32 first = m_count;
+			u32 count = m_count + num;
+
+			if (count > m_capacity)
+				reserve(core::max_(count, m_capacity * 2));
+
+			m_parentIndex.set_used(count);
+			m_count = count;
+
+			if (!initDefault)
+				return first;
+
+			f32* data = m_data.pointer();
+			u32 size = sizeof(f32) * num;
+
+			// see CParticle::CParticle
+			for (int c = 0; c < ChannelCount; c++)
+				memset(data + c * m_capacity + first, 0, size);
+
+			const EParticleParams defaultParams[] = { ScaleX, ScaleY, ScaleZ, ColorR, ColorG, ColorB, ColorA, Mass };
+			for (EParticleParams param : defaultParams)
+			{
+				f32* value = data + (ParamsChannel + param) * m_capacity + first;
+				for (u32 i = 0; i < num; i++)
+					value[i] = 1.0f;
+			}
+
+			f32* dir = data + SubEmitterDirectionY * m_capacity + first;
+			for (u32 i = 0; i < num; i++)
+				dir[i] = 1.0f;
+
+			for (u32 i = first; i < count; i++)
+				m_parentIndex[i] = -1;
+
+			return first;
+		}
+
+		void CParticleArray::remove(u32 i)
+		{
+			if (i >= m_count)
+				return;
+
+			u32 last = m_count - 1;
+			if (i != last)
+			{
+				f32* data = m_data.pointer();
+				for (int c = 0; c < ChannelCount; c++)
+				{
+					f32* channel = data + c * m_capacity;
+					channel[i] = channel[last];
+				}
+
+				m_parentIndex[i] = m_parentIndex[last];
+			}
+
+			m_parentIndex.set_used(last);
+			m_count = last;
+		}
+
+		u32 CParticleArray::removeDead()
+		{
+			f32* life = getChannel(Life);
+			u32 count = m_count;
+
+			m_moveTo.set_used(0);
+			m_moveFrom.set_used(0);
+
+			// only the life channel is moved here, to check the moved particle
+			for (u32 i = 0; i < count; )
+			{
+				if (life[i] < 0.0f)
+				{
+					u32 last = count - 1;
+					if (i != last)
+					{
+						life[i] = life[last];
+						m_moveTo.push_back(i);
+						m_moveFrom.push_back(last);
+					}
+					count--;
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			// the source is always after the count, so the moves do not overlap
+			u32 numMove = m_moveTo.size();
+			if (numMove > 0)
+			{
+				u32* to = m_moveTo.pointer();
+				u32* from = m_moveFrom.pointer();
+
+				for (int c = 0; c < ChannelCount; c++)
+				{
+					if (c == Life)
+						continue;
+
+					f32* channel = getChannel(c);
+					for (u32 i = 0; i < numMove; i++)
+						channel[to[i]] = channel[from[i]];
+				}
+
+				s32* parentIndex = m_parentIndex.pointer();
+				for (u32 i = 0; i < numMove; i++)
+					parentIndex[to[i]] = parentIndex[from[i]];
+			}
+
+			u32 removed = m_count - count;
+
+			m_parentIndex.set_used(count);
+			m_count = count;
+
+			return removed;
+		}
+
+		bool CParticleArray::getBoundingBox(core::aabbox3df& box)
+		{
+			if (m_count == 0)
+				return false;
+
+			f32* x = getChannel(PositionX);
+			f32* y = getChannel(PositionY);
+			f32* z = getChannel(PositionZ);
+
+			box.reset(x[0], y[0], z[0]);
+
+			u32 count4 = m_count & ~3;
+			if (count4 > 0)
+			{
+				f32x4 minX = CSIMD::load4(x), maxX = minX;
+				f32x4 minY = CSIMD::load4(y), maxY = minY;
+				f32x4 minZ = CSIMD::load4(z), maxZ = minZ;
+
+				for (u32 i = 4; i < count4; i += 4)
+				{
+					f32x4 vx = CSIMD::load4(x + i);
+					f32x4 vy = CSIMD::load4(y + i);
+					f32x4 vz = CSIMD::load4(z + i);
+
+					minX = CSIMD::min4(minX, vx);
+					maxX = CSIMD::max4(maxX, vx);
+					minY = CSIMD::min4(minY, vy);
+					maxY = CSIMD::max4(maxY, vy);
+					minZ = CSIMD::min4(minZ, vz);
+					maxZ = CSIMD::max4(maxZ, vz);
+				}
+
+				f32 v[6][4];
+				CSIMD::store4(v[0], minX);
+				CSIMD::store4(v[1], minY);
+				CSIMD::store4(v[2], minZ);
+				CSIMD::store4(v[3], maxX);
+				CSIMD::store4(v[4], maxY);
+				CSIMD::store4(v[5], maxZ);
+
+				for (int i = 0; i < 4; i++)
+				{
+					box.addInternalPoint(v[0][i], v[1][i], v[2][i]);
+					box.addInternalPoint(v[3][i], v[4][i], v[5][i]);
+				}
+			}
+
+			for (u32 i = count4; i < m_count; i++)
+				box.addInternalPoint(x[i], y[i], z[i]);
+
+			return true;
+		}
+
+		void CParticleArray::clear()
+		{
+			m_parentIndex.set_used(0);
+			m_count = 0;
+		}
+
+		void CParticleArray::get(u32 i, CParticle& p)
+		{
+			f32* data = m_data.pointer() + i;
+			u32 s = m_capacity;
+
+			p.Index = i;
+			p.ParentIndex = m_parentIndex[i];
+			p.Immortal = data[Immortal * s] != 0.0f;
+			p.HaveRotate = data[HaveRotate * s] != 0.0f;
+
+			for (int j = 0; j < NumParams; j++)
+			{
+				p.Params[j] = data[(ParamsChannel + j) * s];
+				p.StartValue[j] = data[(StartValueChannel + j) * s];
+				p.EndValue[j] = data[(EndValueChannel + j) * s];
+			}
+
+			p.Age = data[Age * s];
+			p.Life = data[Life * s];
+			p.LifeTime = data[LifeTime * s];
+
+			p.Position.set(data[PositionX * s], data[PositionY * s], data[PositionZ * s]);
+			p.Rotation.set(data[RotationX * s], data[RotationY * s], data[RotationZ * s]);
+			p.Velocity.set(data[VelocityX * s], data[VelocityY * s], data[VelocityZ * s]);
+			p.LastPosition.set(data[LastPositionX * s], data[LastPositionY * s], data[LastPositionZ * s]);
+			p.SubEmitterDirection.set(data[SubEmitterDirectionX * s], data[SubEmitterDirectionY * s], data[SubEmitterDirectionZ * s]);
+		}
+
+		void CParticleArray::set(u32 i, const CParticle& p)
+		{
+			f32* data = m_data.pointer() + i;
+			u32 s = m_capacity;
+
+			m_parentIndex[i] = p.ParentIndex;
+			data[Immortal * s] = p.Immortal ? 1.0f : 0.0f;
+			data[HaveRotate * s] = p.HaveRotate ? 1.0f : 0.0f;
+
+			for (int j = 0; j < NumParams; j++)
+			{
+				data[(ParamsChannel + j) * s] = p.Params[j];
+				data[(StartValueChannel + j) * s] = p.StartValue[j];
+				data[(EndValueChannel + j) * s] = p.EndValue[j];
+			}
+
+			data[Age * s] = p.Age;
+			data[Life * s] = p.Life;
+			data[LifeTime * s] = p.LifeTime;
+
+			data[PositionX * s] = p.Position.X;
+			data[PositionY * s] = p.Position.Y;
+			data[PositionZ * s] = p.Position.Z;
+
+			data[RotationX * s] = p.Rotation.X;
+			data[RotationY * s] = p.Rotation.Y;
+			data[RotationZ * s] = p.Rotation.Z;
+
+			data[VelocityX * s] = p.Velocity.X;
+			data[VelocityY * s] = p.Velocity.Y;
+			data[VelocityZ * s] = p.Velocity.Z;
+
+			data[LastPositionX * s] = p.LastPosition.X;
+			data[LastPositionY * s] = p.LastPosition.Y;
+			data[LastPositionZ * s] = p.LastPosition.Z;
+
+			data[SubEmitterDirectionX * s] = p.SubEmitterDirection.X;
+			data[SubEmitterDirectionY * s] = p.SubEmitterDirection.Y;
+			data[SubEmitterDirectionZ * s] = p.SubEmitterDirection.Z;
+		}
+	}
+}
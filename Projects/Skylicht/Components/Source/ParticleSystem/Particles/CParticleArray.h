@@ -0,0 +1,177 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CParticle.h"
+
+namespace Skylicht
+{
+	namespace Particle
+	{
+		// The particles of a group in SoA layout: one float array per channel,
+		// the particle index is the position in the array (see CParticle::Index)
+		// The channel size is padded to 4 so the update kernels work on 4 particles per step
+		class COMPONENT_API CParticleArray
+		{
+		public:
+			enum EChannel
+			{
+				PositionX = 0,
+				PositionY,
+				PositionZ,
+				VelocityX,
+				VelocityY,
+				VelocityZ,
+				LastPositionX,
+				LastPositionY,
+				LastPositionZ,
+				RotationX,
+				RotationY,
+				RotationZ,
+				SubEmitterDirectionX,
+				SubEmitterDirectionY,
+				SubEmitterDirectionZ,
+				Age,
+				Life,
+				LifeTime,
+				// 1.0f or 0.0f
+				Immortal,
+				HaveRotate,
+				ParamsChannel,
+				StartValueChannel = ParamsChannel + NumParams,
+				EndValueChannel = StartValueChannel + NumParams,
+				ChannelCount = EndValueChannel + NumParams
+			};
+
+		protected:
+			core::array<f32> m_data;
+
+			core::array<s32> m_parentIndex;
+
+			// the moves of removeDead
+			core::array<u32> m_moveTo;
+			core::array<u32> m_moveFrom;
+
+			u32 m_count;
+
+			u32 m_capacity;
+
+		public:
+			CParticleArray();
+
+			virtual ~CParticleArray();
+
+			inline u32 getCount()
+			{
+				return m_count;
+			}
+
+			// the channel size, it is a multiple of 4
+			inline u32 getCapacity()
+			{
+				return m_capacity;
+			}
+
+			inline f32* getChannel(int channel)
+			{
+				return m_data.pointer() + channel * m_capacity;
+			}
+
+			inline f32* getParams(EParticleParams param)
+			{
+				return getChannel(ParamsChannel + param);
+			}
+
+			inline f32* getStartValue(EParticleParams param)
+			{
+				return getChannel(StartValueChannel + param);
+			}
+
+			inline f32* getEndValue(EParticleParams param)
+			{
+				return getChannel(EndValueChannel + param);
+			}
+
+			inline s32* getParentIndex()
+			{
+				return m_parentIndex.pointer();
+			}
+
+			inline core::vector3df getPosition(u32 i)
+			{
+				f32* p = m_data.pointer();
+				return core::vector3df(p[PositionX * m_capacity + i], p[PositionY * m_capacity + i], p[PositionZ * m_capacity + i]);
+			}
+
+			inline void setPosition(u32 i, const core::vector3df& v)
+			{
+				f32* p = m_data.pointer();
+				p[PositionX * m_capacity + i] = v.X;
+				p[PositionY * m_capacity + i] = v.Y;
+				p[PositionZ * m_capacity + i] = v.Z;
+			}
+
+			inline core::vector3df getVelocity(u32 i)
+			{
+				f32* p = m_data.pointer();
+				return core::vector3df(p[VelocityX * m_capacity + i], p[VelocityY * m_capacity + i], p[VelocityZ * m_capacity + i]);
+			}
+
+			inline f32 getLife(u32 i)
+			{
+				return m_data[Life * m_capacity + i];
+			}
+
+			inline void setLife(u32 i, f32 life)
+			{
+				m_data[Life * m_capacity + i] = life;
+			}
+
+			// add num particles, return the index of the first particle
+			// initDefault = false: the data is not initialized, call set for each particle
+			u32 create(u32 num, bool initDefault = true);
+
+			// move the last particle to i (the last particle index is changed to i)
+			void remove(u32 i);
+
+			// remove the particles that have Life < 0, the result is the same as calling remove(i) from the first particle
+			// the moves are applied channel by channel, return the number of removed particles
+			u32 removeDead();
+
+			// the box of the particle positions, return false if there is no particle
+			bool getBoundingBox(core::aabbox3df& box);
+
+			void clear();
+
+			void reserve(u32 num);
+
+			// copy the particle i to p
+			void get(u32 i, CParticle& p);
+
+			// copy p to the particle i
+			void set(u32 i, const CParticle& p);
+		};
+	}
+}
@@ -372,22 +372,27 @@ namespace Skylicht
 			m_meshBuffer->setDirty(EBT_VERTEX_AND_INDEX);
 		}
 
-		void CParticleTrail::OnParticleUpdate(CParticle *particles, int num, CGroup *group, float dt)
+		void CParticleTrail::OnParticleUpdate(CParticleArray* particles, int num, CGroup* group, float dt)
 		{
 			float seg2 = m_segmentLength * m_segmentLength;
 
+			f32* r = particles->getParams(ColorR);
+			f32* g = particles->getParams(ColorG);
+			f32* b = particles->getParams(ColorB);
+			f32* a = particles->getParams(ColorA);
+
 			for (u32 i = 0; i < (u32)num; i++)
 			{
-				CParticle& p = particles[i];
+				core::vector3df position = particles->getPosition(i);
 
-				STrailInfo &trail = m_trails[p.Index];
+				STrailInfo &trail = m_trails[i];
 
-				trail.CurrentPosition = p.Position;
+				trail.CurrentPosition = position;
 				trail.CurrentColor.set(
-					(u32)(p.Params[ColorA] * 255.0f),
-					(u32)(p.Params[ColorR] * 255.0f),
-					(u32)(p.Params[ColorG] * 255.0f),
-					(u32)(p.Params[ColorB] * 255.0f)
+					(u32)(a[i] * 255.0f),
+					(u32)(r[i] * 255.0f),
+					(u32)(g[i] * 255.0f),
+					(u32)(b[i] * 255.0f)
 				);
 
 				if (trail.Position->size() == 0)
@@ -395,24 +400,24 @@ namespace Skylicht
 					SParticlePosition pos;
 					pos.Width = m_width;
 					pos.Alpha = 1.0f;
-					pos.Position = p.Position;
+					pos.Position = position;
 
 					trail.Position->push_back(pos);
 
-					trail.LastPosition = p.Position;
+					trail.LastPosition = position;
 				}
 				else
 				{
-					if (p.Position.getDistanceFromSQ(trail.LastPosition) >= seg2)
+					if (position.getDistanceFromSQ(trail.LastPosition) >= seg2)
 					{
 						trail.Position->push_back(SParticlePosition());
 
 						SParticlePosition& pos = trail.Position->getLast();
 						pos.Width = m_width;
 						pos.Alpha = 1.0f;
-						pos.Position = p.Position;
+						pos.Position = position;
 
-						trail.LastPosition = p.Position;
+						trail.LastPosition = position;
 					}
 				}
 			}
@@ -451,11 +456,8 @@ namespace Skylicht
 			m_trails.set_used(m_trailCount);
 		}
 
-		void CParticleTrail::OnSwapParticleData(CParticle &p1, CParticle &p2)
+		void CParticleTrail::OnSwapParticleData(u32 index1, u32 index2)
 		{
-			int index1 = p1.Index;
-			int index2 = p2.Index;
-
 			STrailInfo t = m_trails[index1];
 
 			m_trails[index1] = m_trails[index2];
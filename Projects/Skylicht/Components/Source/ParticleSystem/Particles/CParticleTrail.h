@@ -106,13 +106,13 @@ namespace Skylicht
 
 			virtual void update(CCamera *camera);
 
-			virtual void OnParticleUpdate(CParticle *particles, int num, CGroup *group, float dt);
+			virtual void OnParticleUpdate(CParticleArray* particles, int num, CGroup* group, float dt);
 
 			virtual void OnParticleBorn(CParticle &p);
 
 			virtual void OnParticleDead(CParticle &p);
 
-			virtual void OnSwapParticleData(CParticle &p1, CParticle &p2);
+			virtual void OnSwapParticleData(u32 index1, u32 index2);
 
 			virtual void OnGroupDestroy();
 
@@ -67,32 +67,35 @@ namespace Skylicht
 				e->deleteBornData();
 			}
 
-			CParticle* particles = getParticlePointer();
+			s32* parentIndex = m_particles.getParentIndex();
+			s32 index = (s32)p.Index;
 			u32 n = getNumParticles();
 
 			for (u32 i = 0; i < n; i++)
 			{
-				if (particles[i].ParentIndex == p.Index)
-					particles[i].ParentIndex = -1;
+				if (parentIndex[i] == index)
+					parentIndex[i] = -1;
 			}
 		}
 
-		void CSubGroup::OnSwapParticleData(CParticle &p1, CParticle &p2)
+		void CSubGroup::OnSwapParticleData(u32 index1, u32 index2)
 		{
 			for (CEmitter *e : m_emitters)
 			{
-				e->swapBornData(p1.Index, p2.Index);
+				e->swapBornData(index1, index2);
 			}
 
-			CParticle* particles = getParticlePointer();
+			s32* parentIndex = m_particles.getParentIndex();
+			s32 i1 = (s32)index1;
+			s32 i2 = (s32)index2;
 			u32 n = getNumParticles();
 
 			for (u32 i = 0; i < n; i++)
 			{
-				if (particles[i].ParentIndex == p1.Index)
-					particles[i].ParentIndex = p2.Index;
-				else if (particles[i].ParentIndex == p2.Index)
-					particles[i].ParentIndex = p1.Index;
+				if (parentIndex[i] == i1)
+					parentIndex[i] = i2;
+				else if (parentIndex[i] == i2)
+					parentIndex[i] = i1;
 			}
 		}
 
@@ -132,7 +135,7 @@ namespace Skylicht
 			u32 emiterId = 0;
 			u32 emiterLaunch = m_launch.size();
 
-			CParticle* baseParticles = m_parentGroup->getParticlePointer();
+			CParticleArray* baseParticles = m_parentGroup->getParticles();
 
 			for (u32 i = emiterId; i < emiterLaunch; i++)
 			{
@@ -141,26 +144,30 @@ namespace Skylicht
 				{
 					s32 parentIndex = launch.Parent;
 
-					CParticle& base = baseParticles[parentIndex];
-
 					// base orientation
-					m_position = base.Position;
+					m_position = baseParticles->getPosition(parentIndex);
 
-					m_direction = base.Velocity;
+					m_direction = baseParticles->getVelocity(parentIndex);
 					if (m_direction.getLengthSQ() == 0.0f)
-						m_direction = base.SubEmitterDirection;
+					{
+						m_direction.set(
+							baseParticles->getChannel(CParticleArray::SubEmitterDirectionX)[parentIndex],
+							baseParticles->getChannel(CParticleArray::SubEmitterDirectionY)[parentIndex],
+							baseParticles->getChannel(CParticleArray::SubEmitterDirectionZ)[parentIndex]);
+					}
 					m_direction.normalize();
 
 					m_rotate.rotationFromTo(Transform::Oy, m_direction);
 
 					// init new particle
-					CParticle* newParticles = create(launch.Number);
+					u32 first = create(launch.Number);
 
 					for (u32 j = 0, n = launch.Number; j < n; j++)
 					{
-						CParticle &p = newParticles[j];
+						CParticle p(first + j);
 						p.ParentIndex = parentIndex;
 						launchParticle(p, launch);
+						m_particles.set(p.Index, p);
 					}
 				}
 			}
@@ -55,7 +55,7 @@ namespace Skylicht
 
 			virtual void OnParticleDead(CParticle &p);
 
-			virtual void OnSwapParticleData(CParticle &p1, CParticle &p2);
+			virtual void OnSwapParticleData(u32 index1, u32 index2);
 
 			virtual void OnGroupDestroy();
 
@@ -59,7 +59,7 @@ namespace Skylicht
 			m_material->applyMaterial();
 		}
 
-		void CBillboardAdditiveRenderer::updateParticleBuffer(IMeshBuffer* buffer, CParticle* particles, int num)
+		void CBillboardAdditiveRenderer::updateParticleBuffer(IMeshBuffer* buffer, CParticleArray* particles, int num)
 		{
 			IVertexBuffer* vtx = buffer->getVertexBuffer();
 			IIndexBuffer* idx = buffer->getIndexBuffer();
@@ -69,10 +69,20 @@ namespace Skylicht
 
 			video::S3DVertex* vertices = (video::S3DVertex*)vtx->getVertices();
 
-			CParticle* p;
-			float* params;
 			u32 frame, row, col;
 
+			f32* px = particles->getChannel(CParticleArray::PositionX);
+			f32* py = particles->getChannel(CParticleArray::PositionY);
+			f32* pz = particles->getChannel(CParticleArray::PositionZ);
+			f32* rz = particles->getChannel(CParticleArray::RotationZ);
+			f32* r = particles->getParams(ColorR);
+			f32* g = particles->getParams(ColorG);
+			f32* b = particles->getParams(ColorB);
+			f32* a = particles->getParams(ColorA);
+			f32* scaleX = particles->getParams(ScaleX);
+			f32* scaleY = particles->getParams(ScaleY);
+			f32* frameIndex = particles->getParams(FrameIndex);
+
 			u32 totalFrames = m_atlasNx * m_atlasNy;
 			float frameW = 1.0f / m_atlasNx;
 			float frameH = 1.0f / m_atlasNy;
@@ -88,13 +98,10 @@ namespace Skylicht
 
 			for (int i = 0; i < num; i++)
 			{
-				p = particles + i;
-				params = p->Params;
-
-				float sx = SizeX * params[ScaleX];
-				float sy = SizeY * params[ScaleY];
+				float sx = SizeX * scaleX[i];
+				float sy = SizeY * scaleY[i];
 
-				float rotation = p->Rotation.Z;
+				float rotation = rz[i];
 
 				float cosA = cosf(rotation);
 				float sinA = sinf(rotation);
@@ -116,18 +123,18 @@ namespace Skylicht
 				sideQuad *= sx;
 				upQuad *= sy;
 
-				x = p->Position.X;
-				y = p->Position.Y;
-				z = p->Position.Z;
+				x = px[i];
+				y = py[i];
+				z = pz[i];
 
 				color.set(
-					(u32)(params[ColorA] * 255.0f),
-					(u32)(params[ColorR] * 255.0f),
-					(u32)(params[ColorG] * 255.0f),
-					(u32)(params[ColorB] * 255.0f)
+					(u32)(a[i] * 255.0f),
+					(u32)(r[i] * 255.0f),
+					(u32)(g[i] * 255.0f),
+					(u32)(b[i] * 255.0f)
 				);
 
-				frame = (u32)params[FrameIndex];
+				frame = (u32)frameIndex[i];
 				frame = frame < 0 ? 0 : frame;
 				frame = frame >= totalFrames ? totalFrames - 1 : frame;
 
@@ -25,7 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "IRenderer.h"
-#include "ParticleSystem/Particles/CParticle.h"
+#include "ParticleSystem/Particles/CParticleArray.h"
 
 namespace Skylicht
 {
@@ -47,7 +47,7 @@ namespace Skylicht
 
 			virtual void getParticleBuffer(IMeshBuffer *buffer);
 
-			virtual void updateParticleBuffer(IMeshBuffer *buffer, CParticle *particles, int num);
+			virtual void updateParticleBuffer(IMeshBuffer* buffer, CParticleArray* particles, int num);
 
 			void setAtlas(u32 x, u32 y)
 			{
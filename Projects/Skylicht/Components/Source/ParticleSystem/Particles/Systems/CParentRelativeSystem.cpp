@@ -25,7 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CParentRelativeSystem.h"
 
-#include "ParticleSystem/Particles/CParticle.h"
+#include "ParticleSystem/Particles/CParticleArray.h"
 #include "ParticleSystem/Particles/CSubGroup.h"
 
 namespace Skylicht
@@ -44,7 +44,7 @@ namespace Skylicht
 
 		}
 
-		void CParentRelativeSystem::update(CParticle *particles, int num, CGroup *group, float dt)
+		void CParentRelativeSystem::update(CParticleArray* particles, int num, CGroup* group, float dt)
 		{
 			CSubGroup *subGroup = dynamic_cast<CSubGroup*>(group);
 			if (subGroup == NULL)
@@ -52,33 +52,57 @@ namespace Skylicht
 
 			CGroup *parentGroup = subGroup->getParentGroup();
 
-			CParticle *baseParticles = parentGroup->getParticlePointer();
-			CParticle *p;
+			CParticleArray* baseParticles = parentGroup->getParticles();
+
+			s32* parentIndex = particles->getParentIndex();
+
+			f32* position[3];
+			f32* lastPosition[3];
+			f32* basePosition[3];
+			for (int j = 0; j < 3; j++)
+			{
+				position[j] = particles->getChannel(CParticleArray::PositionX + j);
+				lastPosition[j] = particles->getChannel(CParticleArray::LastPositionX + j);
+				basePosition[j] = baseParticles->getChannel(CParticleArray::PositionX + j);
+			}
+
+			// age, life, lifetime
+			f32* life[3];
+			f32* baseLife[3];
+			for (int j = 0; j < 3; j++)
+			{
+				life[j] = particles->getChannel(CParticleArray::Age + j);
+				baseLife[j] = baseParticles->getChannel(CParticleArray::Age + j);
+			}
+
+			// r, g, b, a
+			f32* color[4];
+			f32* baseColor[4];
+			for (int j = 0; j < 4; j++)
+			{
+				color[j] = particles->getParams((EParticleParams)(ColorR + j));
+				baseColor[j] = baseParticles->getParams((EParticleParams)(ColorR + j));
+			}
 
-#pragma omp parallel for private(p)
 			for (int i = 0; i < num; i++)
 			{
-				p = particles + i;
+				s32 parent = parentIndex[i];
 
-				if (p->ParentIndex >= 0)
+				if (parent >= 0)
 				{
-					CParticle &parent = baseParticles[p->ParentIndex];
-
-					p->Position = (p->Position - p->LastPosition) + parent.Position;
+					for (int j = 0; j < 3; j++)
+						position[j][i] = (position[j][i] - lastPosition[j][i]) + basePosition[j][parent];
 
 					if (m_syncLife == true)
 					{
-						p->Age = parent.Age;
-						p->Life = parent.Life;
-						p->LifeTime = parent.LifeTime;
+						for (int j = 0; j < 3; j++)
+							life[j][i] = baseLife[j][parent];
 					}
 
 					if (m_syncColor == true)
 					{
-						p->Params[ColorR] = parent.Params[ColorR];
-						p->Params[ColorG] = parent.Params[ColorG];
-						p->Params[ColorB] = parent.Params[ColorB];
-						p->Params[ColorA] = parent.Params[ColorA];
+						for (int j = 0; j < 4; j++)
+							color[j][i] = baseColor[j][parent];
 					}
 				}
 				else
@@ -86,7 +110,7 @@ namespace Skylicht
 					// sync dead
 					if (m_syncLife == true)
 					{
-						p->Life = -1.0f;
+						particles->setLife(i, -1.0f);
 					}
 				}
 			}
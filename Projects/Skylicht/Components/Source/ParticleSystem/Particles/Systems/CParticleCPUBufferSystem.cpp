@@ -25,7 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CParticleCPUBufferSystem.h"
 
-#include "ParticleSystem/Particles/CParticle.h"
+#include "ParticleSystem/Particles/CParticleArray.h"
 #include "ParticleSystem/Particles/CGroup.h"
 
 #include "ParticleSystem/Particles/Renderers/CBillboardAdditiveRenderer.h"
@@ -44,7 +44,7 @@ namespace Skylicht
 
 		}
 
-		void CParticleCPUBufferSystem::update(CParticle *particles, int num, CGroup *group, float dt)
+		void CParticleCPUBufferSystem::update(CParticleArray* particles, int num, CGroup* group, float dt)
 		{
 			CBillboardAdditiveRenderer *billboard = dynamic_cast<CBillboardAdditiveRenderer*>(group->getRenderer());
 			IMeshBuffer *mb = group->getParticleBuffer()->getMeshBuffer();
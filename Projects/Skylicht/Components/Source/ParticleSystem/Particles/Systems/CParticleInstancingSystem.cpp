@@ -25,7 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CParticleInstancingSystem.h"
 
-#include "ParticleSystem/Particles/CParticle.h"
+#include "ParticleSystem/Particles/CParticleArray.h"
 #include "ParticleSystem/Particles/CGroup.h"
 
 #include "ParticleSystem/Particles/Renderers/CQuadRenderer.h"
@@ -44,7 +44,7 @@ namespace Skylicht
 
 		}
 
-		void CParticleInstancingSystem::update(CParticle* particles, int num, CGroup* group, float dt)
+		void CParticleInstancingSystem::update(CParticleArray* particles, int num, CGroup* group, float dt)
 		{
 			CVertexBuffer<SParticleInstance>* buffer = group->getIntancing()->getInstanceBuffer();
 
@@ -55,8 +55,6 @@ namespace Skylicht
 
 			SParticleInstance* vtx = (SParticleInstance*)buffer->getVertices();
 
-			CParticle* p;
-			float* params;
 			SParticleInstance* data;
 
 			u32 frameX = 1;
@@ -86,37 +84,52 @@ namespace Skylicht
 			float frameH = 1.0f / frameY;
 			u32 frame, row, col;
 
-#pragma omp parallel for private(p, params, data, frame, row, col)
+			f32* px = particles->getChannel(CParticleArray::PositionX);
+			f32* py = particles->getChannel(CParticleArray::PositionY);
+			f32* pz = particles->getChannel(CParticleArray::PositionZ);
+			f32* rx = particles->getChannel(CParticleArray::RotationX);
+			f32* ry = particles->getChannel(CParticleArray::RotationY);
+			f32* rz = particles->getChannel(CParticleArray::RotationZ);
+			f32* vx = particles->getChannel(CParticleArray::VelocityX);
+			f32* vy = particles->getChannel(CParticleArray::VelocityY);
+			f32* vz = particles->getChannel(CParticleArray::VelocityZ);
+			f32* r = particles->getParams(ColorR);
+			f32* g = particles->getParams(ColorG);
+			f32* b = particles->getParams(ColorB);
+			f32* a = particles->getParams(ColorA);
+			f32* scaleX = particles->getParams(ScaleX);
+			f32* scaleY = particles->getParams(ScaleY);
+			f32* scaleZ = particles->getParams(ScaleZ);
+			f32* frameIndex = particles->getParams(FrameIndex);
+
 			for (int i = 0; i < num; i++)
 			{
-				p = particles + i;
-				params = p->Params;
 				data = vtx + i;
 
-				data->Pos.X = p->Position.X;
-				data->Pos.Y = p->Position.Y;
-				data->Pos.Z = p->Position.Z;
+				data->Pos.X = px[i];
+				data->Pos.Y = py[i];
+				data->Pos.Z = pz[i];
 
 				data->Color.set(
-					(u32)(params[ColorA] * 255.0f),
-					(u32)(params[ColorR] * 255.0f),
-					(u32)(params[ColorG] * 255.0f),
-					(u32)(params[ColorB] * 255.0f)
+					(u32)(a[i] * 255.0f),
+					(u32)(r[i] * 255.0f),
+					(u32)(g[i] * 255.0f),
+					(u32)(b[i] * 255.0f)
 				);
 
-				data->Size.X = sx * params[ScaleX];
-				data->Size.Y = sy * params[ScaleY];
-				data->Size.Z = sz * params[ScaleZ];
+				data->Size.X = sx * scaleX[i];
+				data->Size.Y = sy * scaleY[i];
+				data->Size.Z = sz * scaleZ[i];
 
-				data->Rotation.X = p->Rotation.X;
-				data->Rotation.Y = p->Rotation.Y;
-				data->Rotation.Z = p->Rotation.Z;
+				data->Rotation.X = rx[i];
+				data->Rotation.Y = ry[i];
+				data->Rotation.Z = rz[i];
 
-				data->Velocity.X = p->Velocity.X;
-				data->Velocity.Y = p->Velocity.Y;
-				data->Velocity.Z = p->Velocity.Z;
+				data->Velocity.X = vx[i];
+				data->Velocity.Y = vy[i];
+				data->Velocity.Z = vz[i];
 
-				frame = (u32)params[FrameIndex];
+				frame = (u32)frameIndex[i];
 				frame = frame < 0 ? 0 : frame;
 				frame = frame >= totalFrames ? totalFrames - 1 : frame;
 
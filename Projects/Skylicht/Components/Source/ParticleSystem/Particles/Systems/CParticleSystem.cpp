@@ -25,9 +25,17 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CParticleSystem.h"
 
-#include "ParticleSystem/Particles/CParticle.h"
+#include "ParticleSystem/Particles/CParticleArray.h"
 #include "ParticleSystem/Particles/CGroup.h"
 
+#include "Utils/CSIMD.h"
+#include "Job/CJobSystem.h"
+
+#define MIN_PARTICLE_BATCH 4096
+
+// the interpolate values are computed on this number of particles
+#define PARTICLE_CHUNK 256
+
 namespace Skylicht
 {
 	namespace Particle
@@ -42,124 +50,207 @@ namespace Skylicht
 
 		}
 
-		void CParticleSystem::updateLifeTime(CParticle *particles, int num, CGroup *group, float dt)
+		void CParticleSystem::updateLifeTime(CParticleArray* particles, int num, CGroup* group, float dt)
 		{
 			dt = dt * 0.001f;
 
-			CParticle *p;
+			f32* age = particles->getChannel(CParticleArray::Age);
+			f32* life = particles->getChannel(CParticleArray::Life);
+			f32* immortal = particles->getChannel(CParticleArray::Immortal);
 
-#pragma omp parallel for private(p)
-			for (int i = 0; i < num; i++)
-			{
-				p = particles + i;
+			f32x4 vdt = CSIMD::splat4(dt);
 
+			// the channel is padded to 4
+			for (int i = 0; i < num; i += 4)
+			{
 				// update life time
-				p->Age = p->Age + dt;
+				CSIMD::store4(age + i, CSIMD::add4(CSIMD::load4(age + i), vdt));
+
+				// life = life - dt (immortal = 0)
+				f32x4 l = CSIMD::sub4(CSIMD::load4(life + i), vdt);
+				CSIMD::store4(life + i, CSIMD::madd4(CSIMD::load4(immortal + i), vdt, l));
+			}
+		}
+
+		void CParticleSystem::update(CParticleArray* particles, int num, CGroup* group, float dt)
+		{
+			if (num == 0)
+				return;
+
+			SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+			int numThread = jobSystem->getWorkerCount() + 1;
+
+			if (numThread == 1 || num < MIN_PARTICLE_BATCH * 2)
+			{
+				updateParticles(particles, 0, num, group, dt);
+			}
+			else
+			{
+				// the batch must be aligned 4 for the SIMD kernel
+				int batch = core::max_(MIN_PARTICLE_BATCH, num / (numThread * 4));
+				batch = (batch + 3) & ~3;
 
-				if (!p->Immortal)
-					p->Life -= dt;
+				jobSystem->parallelFor(num, batch, [this, particles, group, dt](int begin, int end)
+					{
+						updateParticles(particles, begin, end, group, dt);
+					});
 			}
 		}
 
-		void CParticleSystem::update(CParticle *particles, int num, CGroup *group, float dt)
+		void CParticleSystem::updateParticles(CParticleArray* particles, int begin, int end, CGroup* group, float dt)
 		{
 			dt = dt * 0.001f;
 
+			// the channel is padded to 4
+			end = (end + 3) & ~3;
+
 			float pi2 = 2 * core::PI;
 			core::vector3df gravity = group->Gravity * dt;
 
+			bool haveFriction = group->Friction > 0.0f;
 			float friction = group->Friction * dt;
 
-			CParticle *p;
-			float *params;
+			f32* px = particles->getChannel(CParticleArray::PositionX);
+			f32* py = particles->getChannel(CParticleArray::PositionY);
+			f32* pz = particles->getChannel(CParticleArray::PositionZ);
+			f32* vx = particles->getChannel(CParticleArray::VelocityX);
+			f32* vy = particles->getChannel(CParticleArray::VelocityY);
+			f32* vz = particles->getChannel(CParticleArray::VelocityZ);
+			f32* lx = particles->getChannel(CParticleArray::LastPositionX);
+			f32* ly = particles->getChannel(CParticleArray::LastPositionY);
+			f32* lz = particles->getChannel(CParticleArray::LastPositionZ);
+			f32* rx = particles->getChannel(CParticleArray::RotationX);
+			f32* ry = particles->getChannel(CParticleArray::RotationY);
+			f32* rz = particles->getChannel(CParticleArray::RotationZ);
+			f32* age = particles->getChannel(CParticleArray::Age);
+			f32* life = particles->getChannel(CParticleArray::Life);
+			f32* lifeTime = particles->getChannel(CParticleArray::LifeTime);
+			f32* immortal = particles->getChannel(CParticleArray::Immortal);
+			f32* haveRotate = particles->getChannel(CParticleArray::HaveRotate);
+			f32* rsx = particles->getParams(RotateSpeedX);
+			f32* rsy = particles->getParams(RotateSpeedY);
+			f32* rsz = particles->getParams(RotateSpeedZ);
+			f32* mass = particles->getParams(Mass);
 
 			// model
 			std::vector<CModel*>& listModel = group->getModels();
 
-			std::vector<EParticleParams> listParams;
-			std::vector<CInterpolator*> listModelInterpolators;
-
-			for (CModel *m : listModel)
-			{
-				listParams.push_back(m->getType());
-				listModelInterpolators.push_back(m->getInterpolator());
-			}
-
-			// list model and param
-			u32 numModels = (u32)listModel.size();
-			CModel** models = listModel.data();
-			EParticleParams* paramTypes = listParams.data();
-			CInterpolator** modelInterpolators = listModelInterpolators.data();
+			f32x4 zero = CSIMD::splat4(0.0f);
+			f32x4 one = CSIMD::splat4(1.0f);
+			f32x4 vdt = CSIMD::splat4(dt);
+			f32x4 gx = CSIMD::splat4(gravity.X);
+			f32x4 gy = CSIMD::splat4(gravity.Y);
+			f32x4 gz = CSIMD::splat4(gravity.Z);
+			f32x4 vfriction = CSIMD::splat4(friction);
+			f32x4 vpi2 = CSIMD::splat4(pi2);
+			f32x4 invPi2 = CSIMD::splat4(1.0f / pi2);
 
-			float f, y;
+			float x[PARTICLE_CHUNK];
 
-#pragma omp parallel for private(p, params, f, y)
-			for (int i = 0; i < num; i++)
+			for (int chunk = begin; chunk < end; chunk += PARTICLE_CHUNK)
 			{
-				p = particles + i;
-				params = p->Params;
-
-				// update life time
-				p->Age = p->Age + dt;
+				int chunkEnd = core::min_(chunk + PARTICLE_CHUNK, end);
 
-				if (!p->Immortal)
-					p->Life -= dt;
+				for (int i = chunk; i < chunkEnd; i += 4)
+				{
+					// update life time
+					f32x4 a = CSIMD::add4(CSIMD::load4(age + i), vdt);
+					CSIMD::store4(age + i, a);
+
+					f32x4 l = CSIMD::sub4(CSIMD::load4(life + i), vdt);
+					CSIMD::store4(life + i, CSIMD::madd4(CSIMD::load4(immortal + i), vdt, l));
+
+					// update position
+					f32x4 x0 = CSIMD::load4(px + i);
+					f32x4 y0 = CSIMD::load4(py + i);
+					f32x4 z0 = CSIMD::load4(pz + i);
+					CSIMD::store4(lx + i, x0);
+					CSIMD::store4(ly + i, y0);
+					CSIMD::store4(lz + i, z0);
+
+					f32x4 velX = CSIMD::load4(vx + i);
+					f32x4 velY = CSIMD::load4(vy + i);
+					f32x4 velZ = CSIMD::load4(vz + i);
+					CSIMD::store4(px + i, CSIMD::madd4(velX, vdt, x0));
+					CSIMD::store4(py + i, CSIMD::madd4(velY, vdt, y0));
+					CSIMD::store4(pz + i, CSIMD::madd4(velZ, vdt, z0));
+
+					// update gravity
+					velX = CSIMD::add4(velX, gx);
+					velY = CSIMD::add4(velY, gy);
+					velZ = CSIMD::add4(velZ, gz);
+
+					// update friction
+					if (haveFriction)
+					{
+						f32x4 f = CSIMD::sub4(one, CSIMD::min4(one, CSIMD::div4(vfriction, CSIMD::load4(mass + i))));
+						velX = CSIMD::mul4(velX, f);
+						velY = CSIMD::mul4(velY, f);
+						velZ = CSIMD::mul4(velZ, f);
+					}
 
-				p->LastPosition = p->Position;
+					CSIMD::store4(vx + i, velX);
+					CSIMD::store4(vy + i, velY);
+					CSIMD::store4(vz + i, velZ);
 
-				p->Position += p->Velocity * dt;
+					// update rotation (fmod 2pi)
+					f32x4 rotateMask = CSIMD::less4(zero, CSIMD::load4(haveRotate + i));
 
-				// update gravity
-				p->Velocity += gravity;
+					f32x4 r = CSIMD::madd4(CSIMD::load4(rsx + i), vdt, CSIMD::load4(rx + i));
+					r = CSIMD::sub4(r, CSIMD::mul4(CSIMD::trunc4(CSIMD::mul4(r, invPi2)), vpi2));
+					CSIMD::store4(rx + i, CSIMD::select4(rotateMask, r, CSIMD::load4(rx + i)));
 
-				// update rotation
-				if (p->HaveRotate == true)
-				{
-					p->Rotation.X = p->Rotation.X + params[RotateSpeedX] * dt;
-					p->Rotation.Y = p->Rotation.Y + params[RotateSpeedY] * dt;
-					p->Rotation.Z = p->Rotation.Z + params[RotateSpeedZ] * dt;
+					r = CSIMD::madd4(CSIMD::load4(rsy + i), vdt, CSIMD::load4(ry + i));
+					r = CSIMD::sub4(r, CSIMD::mul4(CSIMD::trunc4(CSIMD::mul4(r, invPi2)), vpi2));
+					CSIMD::store4(ry + i, CSIMD::select4(rotateMask, r, CSIMD::load4(ry + i)));
 
-					p->Rotation.X = fmod(p->Rotation.X, pi2);
-					p->Rotation.Y = fmod(p->Rotation.Y, pi2);
-					p->Rotation.Z = fmod(p->Rotation.Z, pi2);
-				}
+					r = CSIMD::madd4(CSIMD::load4(rsz + i), vdt, CSIMD::load4(rz + i));
+					r = CSIMD::sub4(r, CSIMD::mul4(CSIMD::trunc4(CSIMD::mul4(r, invPi2)), vpi2));
+					CSIMD::store4(rz + i, CSIMD::select4(rotateMask, r, CSIMD::load4(rz + i)));
 
-				// update friction
-				if (group->Friction > 0.0f)
-				{
-					f = 1.0f - core::min_(1.0f, friction / params[Mass]);
-					p->Velocity *= f;
+					// interpolate x = age / lifeTime
+					f32x4 t = CSIMD::div4(a, CSIMD::load4(lifeTime + i));
+					CSIMD::store4(x + i - chunk, CSIMD::min4(CSIMD::max4(t, zero), one));
 				}
 
 				// update interpolate parameters
-				float x = core::clamp(p->Age / p->LifeTime, 0.0f, 1.0f);
+				u32 count = (u32)(chunkEnd - chunk);
 
-				for (u32 j = 0; j < numModels; j++)
+				for (CModel* m : listModel)
 				{
-					// linear
-					y = x;
-					EParticleParams t = paramTypes[j];
+					EParticleParams type = m->getType();
+					CInterpolator* interpolator = m->getInterpolator();
+
+					f32* params = particles->getParams(type) + chunk;
 
-					if (modelInterpolators[j] != NULL)
+					if (interpolator != NULL)
 					{
 						// interpolate
-						y = modelInterpolators[j]->interpolate(x);
-						params[t] = y;
+						interpolator->interpolate(x, params, count);
 					}
 					else
 					{
-						// update param value
-						params[t] = p->StartValue[t] + (p->EndValue[t] - p->StartValue[t]) * y;
+						// linear
+						f32* startValue = particles->getStartValue(type) + chunk;
+						f32* endValue = particles->getEndValue(type) + chunk;
+
+						for (u32 i = 0; i < count; i += 4)
+						{
+							f32x4 s = CSIMD::load4(startValue + i);
+							f32x4 e = CSIMD::load4(endValue + i);
+							CSIMD::store4(params + i, CSIMD::madd4(CSIMD::sub4(e, s), CSIMD::load4(x + i), s));
+						}
 					}
 
-					if (t == Scale)
+					if (type == Scale)
 					{
-						params[ScaleX] = params[Scale];
-						params[ScaleY] = params[Scale];
-						params[ScaleZ] = params[Scale];
+						u32 size = sizeof(f32) * count;
+						memcpy(particles->getParams(ScaleX) + chunk, params, size);
+						memcpy(particles->getParams(ScaleY) + chunk, params, size);
+						memcpy(particles->getParams(ScaleZ) + chunk, params, size);
 					}
 				}
 			}
 		}
 	}
-}
\ No newline at end of file
+}
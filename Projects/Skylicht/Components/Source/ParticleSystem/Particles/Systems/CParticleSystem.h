@@ -37,9 +37,13 @@ namespace Skylicht
 
 			virtual ~CParticleSystem();
 
-			void updateLifeTime(CParticle *particles, int num, CGroup *group, float dt);
+			void updateLifeTime(CParticleArray* particles, int num, CGroup* group, float dt);
 
-			virtual void update(CParticle *particles, int num, CGroup *group, float dt);
+			virtual void update(CParticleArray* particles, int num, CGroup* group, float dt);
+
+		protected:
+
+			void updateParticles(CParticleArray* particles, int begin, int end, CGroup* group, float dt);
 		};
 	}
 }
\ No newline at end of file
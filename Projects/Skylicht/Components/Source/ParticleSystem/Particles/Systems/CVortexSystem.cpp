@@ -25,7 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CVortexSystem.h"
 
-#include "ParticleSystem/Particles/CParticle.h"
+#include "ParticleSystem/Particles/CParticleArray.h"
 #include "ParticleSystem/Particles/CGroup.h"
 
 namespace Skylicht
@@ -49,7 +49,7 @@ namespace Skylicht
 
 		}
 
-		void CVortexSystem::update(CParticle *particles, int num, CGroup *group, float dt)
+		void CVortexSystem::update(CParticleArray* particles, int num, CGroup* group, float dt)
 		{
 			core::vector3df position = group->getTransformPosition(m_position);
 
@@ -58,17 +58,15 @@ namespace Skylicht
 
 			float deltaTime = dt * 0.001f;
 
-			CParticle *p;
 			float dist, angle, endRadius;
-			core::vector3df rotationCenter, normal, tangent, attraction;
+			core::vector3df p, rotationCenter, normal, tangent, attraction;
 
-#pragma omp parallel for private(p, dist, angle, endRadius, rotationCenter, normal, tangent, attraction)
 			for (int i = 0; i < num; i++)
 			{
-				p = particles + i;
+				p = particles->getPosition(i);
 
 				// Distance of the projection point from the position of the vortex
-				dist = direction.dotProduct(p->Position - position);
+				dist = direction.dotProduct(p - position);
 
 				// Position of the rotation center (orthogonal projection of the particle)
 				rotationCenter = direction;
@@ -79,12 +77,12 @@ namespace Skylicht
 				rotationCenter += position;
 
 				// Distance of the particle from the eye of the vortex
-				dist = rotationCenter.getDistanceFrom(p->Position);
+				dist = rotationCenter.getDistanceFrom(p);
 
 				if (dist <= m_eyeRadius)
 				{
 					if (m_killingParticleEnabled)
-						p->Life = -1.0f;
+						particles->setLife(i, -1.0f);
 					continue;
 				}
 
@@ -95,7 +93,7 @@ namespace Skylicht
 				attraction *= m_eyeAttractionSpeed * deltaTime / dist;
 
 				// Computes ortho base
-				normal = (p->Position - rotationCenter) / dist;
+				normal = (p - rotationCenter) / dist;
 				tangent = direction.crossProduct(normal);
 
 				endRadius = dist - m_attractionSpeed * deltaTime;
@@ -103,12 +101,14 @@ namespace Skylicht
 				{
 					endRadius = m_eyeRadius;
 					if (m_killingParticleEnabled)
-						p->Life = -1.0f;
+						particles->setLife(i, -1.0f);
 				}
 
-				p->Position = rotationCenter + normal * endRadius * cosf(angle) + tangent * endRadius * sinf(angle);
+				p = rotationCenter + normal * endRadius * cosf(angle) + tangent * endRadius * sinf(angle);
 
-				p->Position += attraction;
+				p += attraction;
+
+				particles->setPosition(i, p);
 			}
 		}
 	}
@@ -46,7 +46,7 @@ namespace Skylicht
 
 			virtual ~CVortexSystem();
 
-			virtual void update(CParticle *particles, int num, CGroup *group, float dt);
+			virtual void update(CParticleArray* particles, int num, CGroup* group, float dt);
 
 			inline core::vector3df getPosition()
 			{
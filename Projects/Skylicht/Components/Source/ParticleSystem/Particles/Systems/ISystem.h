@@ -28,7 +28,7 @@ namespace Skylicht
 {
 	namespace Particle
 	{
-		class CParticle;
+		class CParticleArray;
 		class CGroup;
 
 		class COMPONENT_API ISystem
@@ -48,7 +48,7 @@ namespace Skylicht
 
 			}
 
-			virtual void update(CParticle *particles, int num, CGroup *group, float dt) = 0;
+			virtual void update(CParticleArray* particles, int num, CGroup* group, float dt) = 0;
 
 			inline void setEnable(bool b)
 			{
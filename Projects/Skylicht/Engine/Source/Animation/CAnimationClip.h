@@ -99,6 +99,23 @@ namespace Skylicht
 			return AnimNameToInfo[sceneNodeName];
 		}
 
+		// resample all the tracks to the compressed format
+		void compress(float sampleRate = 30.0f)
+		{
+			for (SEntityAnim*& i : AnimInfo)
+				i->Data.compress(sampleRate, Duration);
+		}
+
+		bool isCompressed()
+		{
+			for (SEntityAnim*& i : AnimInfo)
+			{
+				if (!i->Data.isCompressed())
+					return false;
+			}
+			return AnimInfo.size() > 0;
+		}
+
 		float getRealTimeLength(float baseFps = 30.0f)
 		{
 			return Duration * 1000.0f / baseFps;
@@ -27,17 +27,28 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CAnimationController.h"
 
 #include "RenderMesh/CRenderMesh.h"
+#include "Culling/CCullingData.h"
+#include "Camera/CCamera.h"
+#include "Entity/CEntityManager.h"
 
 namespace Skylicht
 {
 	CAnimationController::CAnimationController() :
-		m_output(NULL)
+		m_output(NULL),
+		m_parallelUpdate(false),
+		m_waitApplyTransform(false),
+		m_enableLOD(false),
+		m_culledInterval(0),
+		m_lodInterval(1),
+		m_lodFrame(0),
+		m_lodPoseValid(false)
 	{
 
 	}
 
 	CAnimationController::~CAnimationController()
 	{
+		waitUpdate();
 		releaseAllSkeleton();
 	}
 
@@ -54,6 +65,173 @@ namespace Skylicht
 				skeleton->getTimeline().update();
 		}
 
+		if (!updateLOD())
+		{
+			// no evaluation at this frame
+			if (m_lodInterval > 1)
+				applyOutput();
+			return;
+		}
+
+		if (m_parallelUpdate)
+		{
+			SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+			if (jobSystem->getWorkerCount() > 0)
+			{
+				if (!m_gameObject->isEnableEndUpdate())
+					m_gameObject->setEnableEndUpdate(true);
+
+				// the job will be done at endUpdate
+				jobSystem->run(&m_job, [this]() { updateSkeletons(); });
+				m_waitApplyTransform = true;
+				return;
+			}
+		}
+
+		updateSkeletons();
+
+		applyOutput();
+	}
+
+	void CAnimationController::endUpdate()
+	{
+		if (!m_waitApplyTransform)
+			return;
+
+		waitUpdate();
+		m_waitApplyTransform = false;
+
+		applyOutput();
+	}
+
+	void CAnimationController::addLOD(f32 distance, int interval, bool skipLeafJoints)
+	{
+		SAnimationLOD lod;
+		lod.Distance = distance;
+		lod.Interval = interval;
+		lod.SkipLeafJoints = skipLeafJoints;
+
+		// sort by distance
+		std::vector<SAnimationLOD>::iterator i = m_lods.begin();
+		while (i != m_lods.end() && i->Distance <= distance)
+			++i;
+		m_lods.insert(i, lod);
+	}
+
+	void CAnimationController::clearLOD()
+	{
+		m_lods.clear();
+	}
+
+	bool CAnimationController::isVisible()
+	{
+		CRenderMesh* renderMesh = m_gameObject->getComponent<CRenderMesh>();
+		if (renderMesh == NULL)
+			return true;
+
+		std::vector<CRenderMeshData*>& renderers = renderMesh->getRenderers();
+		if (renderers.size() == 0)
+			return true;
+
+		for (CRenderMeshData* renderer : renderers)
+		{
+			CCullingData* culling = GET_ENTITY_DATA(renderer->Entity, CCullingData);
+			if (culling == NULL || culling->Visible)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool CAnimationController::updateLOD()
+	{
+		int interval = 1;
+		bool skipLeafJoints = false;
+
+		if (m_enableLOD && m_output != NULL)
+		{
+			if (!isVisible())
+			{
+				// the culling result is from the last rendered frame
+				interval = m_culledInterval;
+				skipLeafJoints = true;
+			}
+			else if (m_lods.size() > 0)
+			{
+				CCamera* camera = m_gameObject->getEntityManager()->getCamera();
+				if (camera != NULL)
+				{
+					f32 d = camera->getGameObject()->getPosition().getDistanceFromSQ(m_gameObject->getPosition());
+					for (SAnimationLOD& lod : m_lods)
+					{
+						if (d >= lod.Distance * lod.Distance)
+						{
+							interval = lod.Interval;
+							skipLeafJoints = lod.SkipLeafJoints;
+						}
+					}
+				}
+			}
+		}
+
+		for (CSkeleton*& skeleton : m_skeletons)
+			skeleton->setSkipLeafJoints(skipLeafJoints);
+
+		m_lodInterval = interval;
+
+		if (interval == 0)
+		{
+			// freeze: keep the last pose, the joint transforms are not changed
+			return false;
+		}
+
+		if (interval == 1)
+		{
+			m_lodFrame = 0;
+			m_lodPoseValid = false;
+			return true;
+		}
+
+		m_lodFrame++;
+		if (m_lodFrame >= interval)
+			m_lodFrame = 0;
+
+		return m_lodFrame == 0 || !m_lodPoseValid;
+	}
+
+	void CAnimationController::applyOutput()
+	{
+		if (m_output == NULL)
+			return;
+
+		if (m_lodInterval > 1)
+		{
+			// the evaluated pose is the target, the applied pose reaches it at the next evaluation
+			CSkeletonPose& pose = m_output->getPose();
+			if (!m_lodPoseValid || m_lodPose.getCount() != pose.getCount())
+			{
+				m_lodPose = pose;
+				m_lodPoseValid = true;
+			}
+			else
+			{
+				m_lodPose.lerp(pose, 1.0f / (f32)(m_lodInterval - m_lodFrame));
+			}
+
+			m_output->writePoseToJoints(m_lodPose);
+		}
+
+		m_output->applyTransform();
+	}
+
+	void CAnimationController::waitUpdate()
+	{
+		if (!m_job.isDone())
+			SkylichtSystem::CJobSystem::getInstance()->wait(&m_job);
+	}
+
+	void CAnimationController::updateSkeletons()
+	{
 		for (CSkeleton*& skeleton : m_skeletons)
 		{
 			if (skeleton->isEnable() == true && skeleton->getAnimationType() == CSkeleton::Blending)
@@ -67,9 +245,6 @@ namespace Skylicht
 				skeleton->update();
 			}
 		}
-
-		if (m_output != NULL)
-			m_output->applyTransform();
 	}
 
 	CSkeleton* CAnimationController::createSkeleton()
@@ -109,11 +284,14 @@ namespace Skylicht
 
 	void CAnimationController::releaseAllSkeleton()
 	{
+		waitUpdate();
+
 		for (CSkeleton*& skeleton : m_skeletons)
 		{
 			delete skeleton;
 		}
 		m_skeletons.clear();
 		m_output = NULL;
+		m_lodPoseValid = false;
 	}
 }
\ No newline at end of file
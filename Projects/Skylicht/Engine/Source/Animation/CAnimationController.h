@@ -26,16 +26,49 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Skeleton/CSkeleton.h"
 #include "Components/CComponentSystem.h"
+#include "Job/CJobSystem.h"
 
 namespace Skylicht
 {
 	class SKYLICHT_API CAnimationController : public CComponentSystem
 	{
+	public:
+		// animation LOD level
+		// Interval: evaluate the skeletons every Interval frames (0: freeze the pose)
+		// SkipLeafJoints: do not evaluate the joints that have no child
+		struct SAnimationLOD
+		{
+			f32 Distance;
+			int Interval;
+			bool SkipLeafJoints;
+		};
+
 	protected:
 		std::vector<CSkeleton*> m_skeletons;
 
 		CSkeleton* m_output;
 
+		bool m_parallelUpdate;
+
+		bool m_waitApplyTransform;
+
+		SkylichtSystem::CJobGroup m_job;
+
+		std::vector<SAnimationLOD> m_lods;
+
+		bool m_enableLOD;
+
+		int m_culledInterval;
+
+		int m_lodInterval;
+
+		int m_lodFrame;
+
+		bool m_lodPoseValid;
+
+		// the interpolated pose that is applied when the skeletons are not evaluated every frame
+		CSkeletonPose m_lodPose;
+
 	public:
 		CAnimationController();
 
@@ -45,6 +78,8 @@ namespace Skylicht
 
 		virtual void updateComponent();
 
+		virtual void endUpdate();
+
 	public:
 
 		CSkeleton* createSkeleton();
@@ -67,5 +102,62 @@ namespace Skylicht
 		{
 			m_output = skeleton;
 		}
+
+		// the skeletons are evaluated on job system (parallel with the other controllers)
+		// and the output transform is applied at endUpdate
+		// note: the other components can not read the pose at updateComponent
+		inline void setParallelUpdate(bool b)
+		{
+			m_parallelUpdate = b;
+		}
+
+		inline bool isParallelUpdate()
+		{
+			return m_parallelUpdate;
+		}
+
+		// add the LOD level that is used when the camera distance >= distance
+		void addLOD(f32 distance, int interval, bool skipLeafJoints);
+
+		void clearLOD();
+
+		inline void setEnableLOD(bool b)
+		{
+			m_enableLOD = b;
+		}
+
+		inline bool isEnableLOD()
+		{
+			return m_enableLOD;
+		}
+
+		// the update interval when the character is culled (0: freeze the pose)
+		inline void setCulledInterval(int interval)
+		{
+			m_culledInterval = interval;
+		}
+
+		inline int getCulledInterval()
+		{
+			return m_culledInterval;
+		}
+
+		// the interval of the current frame (1: full rate, 0: frozen)
+		inline int getLODInterval()
+		{
+			return m_lodInterval;
+		}
+
+	protected:
+
+		bool updateLOD();
+
+		bool isVisible();
+
+		void applyOutput();
+
+		void updateSkeletons();
+
+		void waitUpdate();
 	};
 }
\ No newline at end of file
@@ -27,8 +27,58 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	f32 CAnimationData::getLastFrame()
+	{
+		if (isCompressed())
+			return Compressed.getLastFrame();
+
+		f32 totalFrame = Positions.getLastFrame();
+		totalFrame = core::max_(totalFrame, Rotations.getLastFrame());
+		totalFrame = core::max_(totalFrame, Scales.getLastFrame());
+		return totalFrame;
+	}
+
+	void CAnimationData::compress(f32 sampleRate, f32 duration, bool freeKeyFrame)
+	{
+		if (isCompressed())
+			return;
+
+		duration = core::max_(duration, getLastFrame());
+
+		u32 numSample = (u32)core::ceil32(duration * sampleRate) + 1;
+
+		core::array<core::vector3df> positions;
+		core::array<core::quaternion> rotations;
+		core::array<core::vector3df> scales;
+
+		positions.set_used(numSample);
+		rotations.set_used(numSample);
+		scales.set_used(numSample);
+
+		CAnimationTrack track;
+		track.setAnimationData(this);
+
+		for (u32 i = 0; i < numSample; i++)
+		{
+			f32 frame = core::min_((f32)i / sampleRate, duration);
+			track.getFrameData(frame, positions[i], scales[i], rotations[i]);
+		}
+
+		Compressed.compress(positions, rotations, scales, sampleRate);
+
+		if (freeKeyFrame)
+		{
+			Positions.Data.clear();
+			Rotations.Data.clear();
+			Scales.Data.clear();
+		}
+	}
+
 	CAnimationTrack::CAnimationTrack() :
 		m_data(NULL),
+		m_positionHint(0),
+		m_rotationHint(0),
+		m_scaleHint(0),
 		HaveAnimation(false)
 	{
 	}
@@ -54,6 +104,12 @@ namespace Skylicht
 			return;
 		}
 
+		if (data->isCompressed())
+		{
+			data->Compressed.getFrameData(frame, position, scale, rotation);
+			return;
+		}
+
 		s32 foundPositionIndex = -1;
 		s32 foundScaleIndex = -1;
 		s32 foundRotationIndex = -1;
@@ -64,7 +120,7 @@ namespace Skylicht
 
 		if (numPositionKey)
 		{
-			foundPositionIndex = data->Positions.getIndex(frame);
+			foundPositionIndex = data->Positions.getIndex(frame, m_positionHint);
 			CPositionKey* pPositions = data->Positions.pointer();
 
 			// Do interpolation...
@@ -110,7 +166,7 @@ namespace Skylicht
 		u32 numScaleKey = data->Scales.size();
 		if (numScaleKey)
 		{
-			foundScaleIndex = data->Scales.getIndex(frame);
+			foundScaleIndex = data->Scales.getIndex(frame, m_scaleHint);
 			CScaleKey* pScale = data->Scales.pointer();
 
 			// Do interpolation...
@@ -156,7 +212,7 @@ namespace Skylicht
 
 		if (numRotKey)
 		{
-			foundRotationIndex = data->Rotations.getIndex(frame);
+			foundRotationIndex = data->Rotations.getIndex(frame, m_rotationHint);
 			CRotationKey* pRotation = data->Rotations.pointer();
 
 			// Do interpolation...
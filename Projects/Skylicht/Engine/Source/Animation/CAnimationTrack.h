@@ -24,6 +24,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #pragma once
 
+#include "CCompressedAnimationData.h"
+
 namespace Skylicht
 {
 	template<class T>
@@ -46,19 +48,13 @@ namespace Skylicht
 
 		T Default;
 
-		int Hint;
-
-		CArrayKeyFrame() :
-			Hint(0)
-		{
-		}
-
-		inline void clearHint()
+		CArrayKeyFrame()
 		{
-			Hint = 0;
 		}
 
-		int getIndex(f32 frame);
+		// hint is the last found index, it is owned by the caller (see CAnimationTrack)
+		// because the key frames are shared by all the characters that play the clip
+		int getIndex(f32 frame, int& hint);
 
 		inline u32 size()
 		{
@@ -80,7 +76,7 @@ namespace Skylicht
 	};
 
 	template<class T>
-	int CArrayKeyFrame<T>::getIndex(f32 frame)
+	int CArrayKeyFrame<T>::getIndex(f32 frame, int& hint)
 	{
 		int foundPositionIndex = -1;
 
@@ -88,31 +84,40 @@ namespace Skylicht
 		CKeyFrameData<T>* pData = Data.pointer();
 
 		// Test the Hints...
-		if (Hint >= 0 && Hint < numKey)
+		if (hint >= 0 && hint < numKey)
 		{
-			if (Hint > 0 && pData[Hint].Frame >= frame && pData[Hint - 1].Frame < frame)
-				foundPositionIndex = Hint;
-			else if (Hint + 1 < numKey)
+			if (hint > 0 && pData[hint].Frame >= frame && pData[hint - 1].Frame < frame)
+				foundPositionIndex = hint;
+			else if (hint + 1 < numKey)
 			{
-				if (pData[Hint + 1].Frame >= frame && pData[Hint + 0].Frame < frame)
+				if (pData[hint + 1].Frame >= frame && pData[hint + 0].Frame < frame)
 				{
-					Hint++;
-					foundPositionIndex = Hint;
+					hint++;
+					foundPositionIndex = hint;
 				}
 			}
 		}
 
-		// The Hint test failed, do a full scan...
+		// The hint test failed (seek), binary search the first key >= frame
 		if (foundPositionIndex == -1)
 		{
-			for (s32 i = 0; i < numKey; ++i)
+			int low = 0;
+			int high = numKey;
+
+			// Keys should to be sorted by frame
+			while (low < high)
 			{
-				if (pData[i].Frame >= frame) // Keys should to be sorted by frame
-				{
-					foundPositionIndex = i;
-					Hint = i;
-					break;
-				}
+				int mid = (low + high) >> 1;
+				if (pData[mid].Frame < frame)
+					low = mid + 1;
+				else
+					high = mid;
+			}
+
+			if (low < numKey)
+			{
+				foundPositionIndex = low;
+				hint = low;
 			}
 		}
 
@@ -126,9 +131,23 @@ namespace Skylicht
 		CArrayKeyFrame<core::quaternion> Rotations;
 		CArrayKeyFrame<core::vector3df> Scales;
 
+		// uniform sampled & quantized keys, see compress
+		CCompressedAnimationData Compressed;
+
 		CAnimationData()
 		{
 		}
+
+		inline bool isCompressed()
+		{
+			return !Compressed.isEmpty();
+		}
+
+		f32 getLastFrame();
+
+		// resample the key frames at sampleRate (keys per second) to Compressed
+		// and release the key frames if freeKeyFrame
+		void compress(f32 sampleRate, f32 duration, bool freeKeyFrame = true);
 	};
 
 	class SKYLICHT_API CAnimationTrack
@@ -137,6 +156,11 @@ namespace Skylicht
 
 		CAnimationData* m_data;
 
+		// the key frame search hints of this track
+		int m_positionHint;
+		int m_rotationHint;
+		int m_scaleHint;
+
 	public:
 		std::string Name;
 
@@ -158,12 +182,9 @@ namespace Skylicht
 
 		void clearAllKeyFrame()
 		{
-			if (m_data)
-			{
-				m_data->Positions.clearHint();
-				m_data->Rotations.clearHint();
-				m_data->Scales.clearHint();
-			}
+			m_positionHint = 0;
+			m_rotationHint = 0;
+			m_scaleHint = 0;
 
 			m_data = NULL;
 
@@ -174,6 +195,10 @@ namespace Skylicht
 		void setAnimationData(CAnimationData* data)
 		{
 			m_data = data;
+
+			m_positionHint = 0;
+			m_rotationHint = 0;
+			m_scaleHint = 0;
 		}
 
 		CAnimationData* getFrameData()
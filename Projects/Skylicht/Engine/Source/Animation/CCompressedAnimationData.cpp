@@ -0,0 +1,284 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCompressedAnimationData.h"
+#include "CAnimationTrack.h"
+
+#define QUANTIZE_MAX 65535.0f
+
+// smallest three components are in [-1/sqrt(2), 1/sqrt(2)]
+#define QUAT_RANGE 0.70710678f
+#define QUAT_BITS_MAX 32767.0f
+
+namespace Skylicht
+{
+	CCompressedAnimationData::CCompressedAnimationData() :
+		SampleRate(30.0f),
+		NumSample(0)
+	{
+
+	}
+
+	void CCompressedAnimationData::clear()
+	{
+		NumSample = 0;
+		Positions.clear();
+		Rotations.clear();
+		Scales.clear();
+	}
+
+	void CCompressedAnimationData::compress(const core::array<core::vector3df>& positions,
+		const core::array<core::quaternion>& rotations,
+		const core::array<core::vector3df>& scales,
+		f32 sampleRate)
+	{
+		clear();
+
+		NumSample = positions.size();
+		SampleRate = sampleRate;
+
+		if (NumSample == 0)
+			return;
+
+		packVector(positions, PositionMin, PositionRange, Positions);
+		packVector(scales, ScaleMin, ScaleRange, Scales);
+
+		// constant rotation only stores 1 key
+		u32 numRotation = 1;
+		for (u32 i = 1; i < NumSample; i++)
+		{
+			if (!rotations[i].equals(rotations[0]))
+			{
+				numRotation = NumSample;
+				break;
+			}
+		}
+
+		Rotations.set_used(numRotation * 3);
+		for (u32 i = 0; i < numRotation; i++)
+			packQuaternion(rotations[i], &Rotations[i * 3]);
+	}
+
+	void CCompressedAnimationData::getFrameData(f32 frame,
+		core::vector3df& position,
+		core::vector3df& scale,
+		core::quaternion& rotation)
+	{
+		if (NumSample == 0)
+			return;
+
+		int last = (int)NumSample - 1;
+
+		f32 f = core::clamp(frame * SampleRate, 0.0f, (f32)last);
+		int i0 = (int)f;
+		int i1 = core::min_(i0 + 1, last);
+		f32 t = f - (f32)i0;
+
+		core::vector3df a, b;
+
+		// position
+		if (Positions.size() == 3)
+		{
+			unpackVector(Positions.const_pointer(), PositionMin, PositionRange, position);
+		}
+		else
+		{
+			unpackVector(&Positions[i0 * 3], PositionMin, PositionRange, a);
+			unpackVector(&Positions[i1 * 3], PositionMin, PositionRange, b);
+			position = a + (b - a) * t;
+		}
+
+		// scale
+		if (Scales.size() == 3)
+		{
+			unpackVector(Scales.const_pointer(), ScaleMin, ScaleRange, scale);
+		}
+		else
+		{
+			unpackVector(&Scales[i0 * 3], ScaleMin, ScaleRange, a);
+			unpackVector(&Scales[i1 * 3], ScaleMin, ScaleRange, b);
+			scale = a + (b - a) * t;
+		}
+
+		// rotation
+		if (Rotations.size() == 3)
+		{
+			unpackQuaternion(Rotations.const_pointer(), rotation);
+		}
+		else
+		{
+			core::quaternion q1, q2;
+			unpackQuaternion(&Rotations[i0 * 3], q1);
+			unpackQuaternion(&Rotations[i1 * 3], q2);
+			CAnimationTrack::quaternionSlerp(rotation, q1, q2, t);
+		}
+	}
+
+	u32 CCompressedAnimationData::getMemorySize()
+	{
+		return sizeof(CCompressedAnimationData) + (Positions.size() + Rotations.size() + Scales.size()) * sizeof(u16);
+	}
+
+	void CCompressedAnimationData::packVector(const core::array<core::vector3df>& values, core::vector3df& min, core::vector3df& range, core::array<u16>& out)
+	{
+		u32 n = values.size();
+
+		core::aabbox3df box(values[0]);
+		for (u32 i = 1; i < n; i++)
+			box.addInternalPoint(values[i]);
+
+		min = box.MinEdge;
+		range = box.MaxEdge - box.MinEdge;
+
+		// constant channel
+		if (range.X <= core::ROUNDING_ERROR_f32 &&
+			range.Y <= core::ROUNDING_ERROR_f32 &&
+			range.Z <= core::ROUNDING_ERROR_f32)
+		{
+			range.set(0.0f, 0.0f, 0.0f);
+			n = 1;
+		}
+
+		core::vector3df scale(
+			range.X > 0.0f ? QUANTIZE_MAX / range.X : 0.0f,
+			range.Y > 0.0f ? QUANTIZE_MAX / range.Y : 0.0f,
+			range.Z > 0.0f ? QUANTIZE_MAX / range.Z : 0.0f);
+
+		out.set_used(n * 3);
+		for (u32 i = 0; i < n; i++)
+		{
+			core::vector3df v = (values[i] - min) * scale;
+			out[i * 3] = (u16)core::round_(v.X);
+			out[i * 3 + 1] = (u16)core::round_(v.Y);
+			out[i * 3 + 2] = (u16)core::round_(v.Z);
+		}
+	}
+
+	void CCompressedAnimationData::unpackVector(const u16* in, const core::vector3df& min, const core::vector3df& range, core::vector3df& v)
+	{
+		const f32 inv = 1.0f / QUANTIZE_MAX;
+		v.X = min.X + in[0] * inv * range.X;
+		v.Y = min.Y + in[1] * inv * range.Y;
+		v.Z = min.Z + in[2] * inv * range.Z;
+	}
+
+	void CCompressedAnimationData::packQuaternion(const core::quaternion& quat, u16* out)
+	{
+		core::quaternion q = quat;
+		q.normalize();
+
+		f32* c = &q.X;
+
+		// find the largest component
+		int largest = 0;
+		for (int i = 1; i < 4; i++)
+		{
+			if (fabsf(c[i]) > fabsf(c[largest]))
+				largest = i;
+		}
+
+		// q & -q is the same rotation, keep the largest positive
+		f32 sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+		int j = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			f32 v = core::clamp(c[i] * sign, -QUAT_RANGE, QUAT_RANGE);
+			v = (v + QUAT_RANGE) / (2.0f * QUAT_RANGE) * QUAT_BITS_MAX;
+			out[j++] = (u16)core::round_(v);
+		}
+
+		// 2 bits index on the high bit of the first 2 values
+		out[0] |= (u16)((largest & 1) << 15);
+		out[1] |= (u16)((largest >> 1) << 15);
+	}
+
+	void CCompressedAnimationData::unpackQuaternion(const u16* in, core::quaternion& q)
+	{
+		int largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+
+		f32* c = &q.X;
+		f32 sum = 0.0f;
+
+		int j = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			f32 v = (f32)(in[j++] & 0x7fff) / QUAT_BITS_MAX;
+			v = v * 2.0f * QUAT_RANGE - QUAT_RANGE;
+			c[i] = v;
+			sum += v * v;
+		}
+
+		c[largest] = sqrtf(core::max_(0.0f, 1.0f - sum));
+	}
+
+	void CCompressedAnimationData::writeVector(CMemoryStream* stream, const core::vector3df& min, const core::vector3df& range, core::array<u16>& data)
+	{
+		stream->writeFloatArray(&min.X, 3);
+		stream->writeFloatArray(&range.X, 3);
+		stream->writeUInt(data.size());
+		stream->writeData(data.pointer(), data.size() * sizeof(u16));
+	}
+
+	void CCompressedAnimationData::readVector(CMemoryStream* stream, core::vector3df& min, core::vector3df& range, core::array<u16>& data)
+	{
+		stream->readFloatArray(&min.X, 3);
+		stream->readFloatArray(&range.X, 3);
+		data.set_used(stream->readUInt());
+		stream->readData(data.pointer(), data.size() * sizeof(u16));
+	}
+
+	void CCompressedAnimationData::write(CMemoryStream* stream)
+	{
+		stream->writeFloat(SampleRate);
+		stream->writeUInt(NumSample);
+
+		writeVector(stream, PositionMin, PositionRange, Positions);
+
+		stream->writeUInt(Rotations.size());
+		stream->writeData(Rotations.pointer(), Rotations.size() * sizeof(u16));
+
+		writeVector(stream, ScaleMin, ScaleRange, Scales);
+	}
+
+	void CCompressedAnimationData::read(CMemoryStream* stream)
+	{
+		SampleRate = stream->readFloat();
+		NumSample = stream->readUInt();
+
+		readVector(stream, PositionMin, PositionRange, Positions);
+
+		Rotations.set_used(stream->readUInt());
+		stream->readData(Rotations.pointer(), Rotations.size() * sizeof(u16));
+
+		readVector(stream, ScaleMin, ScaleRange, Scales);
+	}
+}
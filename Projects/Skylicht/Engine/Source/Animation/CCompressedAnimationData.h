@@ -0,0 +1,101 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Utils/CMemoryStream.h"
+
+namespace Skylicht
+{
+	// Uniform sampled animation curves with quantized keys
+	// - sampling is O(1): key index = frame * SampleRate
+	// - position & scale: 3 x u16 in [Min, Min + Range]
+	// - rotation: smallest three, 3 x u16 (15 bits value + 2 bits index of the largest component)
+	// - a constant channel only stores 1 key
+	class SKYLICHT_API CCompressedAnimationData
+	{
+	public:
+		f32 SampleRate;
+
+		u32 NumSample;
+
+		core::vector3df PositionMin;
+		core::vector3df PositionRange;
+		core::array<u16> Positions;
+
+		core::array<u16> Rotations;
+
+		core::vector3df ScaleMin;
+		core::vector3df ScaleRange;
+		core::array<u16> Scales;
+
+	public:
+		CCompressedAnimationData();
+
+		inline bool isEmpty()
+		{
+			return NumSample == 0;
+		}
+
+		inline f32 getLastFrame()
+		{
+			if (NumSample == 0)
+				return 0.0f;
+
+			return (NumSample - 1) / SampleRate;
+		}
+
+		void clear();
+
+		void compress(const core::array<core::vector3df>& positions,
+			const core::array<core::quaternion>& rotations,
+			const core::array<core::vector3df>& scales,
+			f32 sampleRate);
+
+		void getFrameData(f32 frame,
+			core::vector3df& position,
+			core::vector3df& scale,
+			core::quaternion& rotation);
+
+		u32 getMemorySize();
+
+		void write(CMemoryStream* stream);
+
+		void read(CMemoryStream* stream);
+
+		static void packQuaternion(const core::quaternion& q, u16* out);
+
+		static void unpackQuaternion(const u16* in, core::quaternion& q);
+
+	protected:
+
+		static void packVector(const core::array<core::vector3df>& values, core::vector3df& min, core::vector3df& range, core::array<u16>& out);
+
+		static void unpackVector(const u16* in, const core::vector3df& min, const core::vector3df& range, core::vector3df& v);
+
+		static void writeVector(CMemoryStream* stream, const core::vector3df& min, const core::vector3df& range, core::array<u16>& data);
+
+		static void readVector(CMemoryStream* stream, core::vector3df& min, core::vector3df& range, core::array<u16>& data);
+	};
+}
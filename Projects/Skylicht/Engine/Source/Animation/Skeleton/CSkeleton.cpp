@@ -40,6 +40,7 @@ namespace Skylicht
 		m_target(NULL),
 		m_root(NULL),
 		m_layerType(DefaultBlending),
+		m_skipLeafJoints(false),
 		m_needUpdateActivateEntities(true)
 	{
 
@@ -117,6 +118,68 @@ namespace Skylicht
 			COPY_VECTOR3DF(animationData->AnimScale, animationData->DefaultScale);
 			COPY_QUATERNION(animationData->AnimRotation, animationData->DefaultRotation);
 		}
+
+		initPose();
+	}
+
+	void CSkeleton::initPose()
+	{
+		u32 numJoint = (u32)m_entitiesData.size();
+
+		m_pose.resize(numJoint);
+
+		u32 stride = m_pose.getStride();
+		m_jointWeights.set_used(stride);
+		m_activeMask.set_used(stride);
+		m_layerWeights.set_used(stride);
+
+		for (u32 i = 0; i < stride; i++)
+		{
+			m_jointWeights[i] = 0.0f;
+			m_activeMask[i] = 0.0f;
+			m_layerWeights[i] = 0.0f;
+		}
+
+		m_jointHasChild.set_used(numJoint);
+		for (u32 i = 0; i < numJoint; i++)
+			m_jointHasChild[i] = 0;
+
+		for (u32 i = 0; i < numJoint; i++)
+		{
+			CAnimationTransformData* entity = m_entitiesData[i];
+			m_pose.set(i, entity->AnimPosition, entity->AnimRotation, entity->AnimScale);
+
+			if (entity->ParentID >= 0)
+				m_jointHasChild[entity->ParentID] = 1;
+		}
+
+		m_needUpdateActivateEntities = true;
+	}
+
+	void CSkeleton::writePoseToJoints()
+	{
+		writePoseToJoints(m_pose);
+	}
+
+	void CSkeleton::writePoseToJoints(const CSkeletonPose& pose)
+	{
+		CAnimationTransformData** entities = m_entitiesActivated.pointer();
+		u32 count = (u32)m_entitiesActivated.size();
+
+		for (u32 i = 0; i < count; i++)
+		{
+			CAnimationTransformData* entity = entities[i];
+			pose.get(entity->ID, entity->AnimPosition, entity->AnimRotation, entity->AnimScale);
+		}
+	}
+
+	void CSkeleton::setSkipLeafJoints(bool b)
+	{
+		if (m_skipLeafJoints != b)
+		{
+			m_skipLeafJoints = b;
+			m_needUpdateActivateEntities = true;
+		}
 	}
 
 	void CSkeleton::releaseAllEntities()
@@ -124,6 +187,8 @@ namespace Skylicht
 		m_entities.releaseAllEntities();
 		m_entitiesData.clear();
 		m_root = NULL;
+
+		initPose();
 	}
 
 	void CSkeleton::setAnimation(CAnimationClip* clip, bool loop, float from, float duration, bool pause)
@@ -184,9 +249,7 @@ namespace Skylicht
 				track.setAnimationData(&anim->Data);
 
 				// get anim duration
-				float totalFrame = anim->Data.Positions.getLastFrame();
-				totalFrame = core::max_(totalFrame, anim->Data.Rotations.getLastFrame());
-				totalFrame = core::max_(totalFrame, anim->Data.Scales.getLastFrame());
+				float totalFrame = anim->Data.getLastFrame();
 
 				if (m_timeline.Duration < totalFrame)
 					m_timeline.Duration = totalFrame;
@@ -212,8 +275,13 @@ namespace Skylicht
 
 			for (CAnimationTransformData*& entity : m_entitiesData)
 			{
-				if (entity->DisableAnimation || entity->Weight == 0.0f)
+				m_jointWeights[entity->ID] = entity->Weight;
+				m_activeMask[entity->ID] = 0.0f;
+
+				if (entity->DisableAnimation || entity->Weight == 0.0f || isSkippedJoint(entity))
 					continue;
+
+				m_activeMask[entity->ID] = 1.0f;
 				m_entitiesActivated.push_back(entity);
 			}
 		}
@@ -311,7 +379,7 @@ namespace Skylicht
 	{
 		for (CAnimationTransformData*& entity : m_entitiesData)
 		{
-			if (entity->DisableAnimation)
+			if (entity->DisableAnimation || isSkippedJoint(entity))
 				continue;
 
 			// todo calc relative matrix & position
@@ -371,6 +439,8 @@ namespace Skylicht
 				COPY_VECTOR3DF(entity->AnimScale, entity->DefaultScale);
 				COPY_QUATERNION(entity->AnimRotation, entity->DefaultRotation);
 			}
+
+			m_pose.set(entity->ID, entity->AnimPosition, entity->AnimRotation, entity->AnimScale);
 		}
 	}
 
@@ -424,162 +494,40 @@ namespace Skylicht
 
 			first = false;
 		}
+
+		// the joints (IK, applyTransform) read the result at AnimPosition, AnimRotation, AnimScale
+		writePoseToJoints();
 	}
 
-	void CSkeleton::doBlending(CSkeleton* skeleton, bool first)
+	void CSkeleton::updateLayerWeights(CSkeleton* skeleton)
 	{
-		float skeletonWeight = skeleton->getTimeline().Weight;
-
-		CAnimationTransformData** entities = m_entitiesActivated.pointer();
-		u32 count = (u32)m_entitiesActivated.size();
-
-		for (u32 i = 0; i < count; i++)
-		{
-			CAnimationTransformData* entity = entities[i];
-
-			CAnimationTransformData* src = skeleton->m_entitiesData[entity->ID];
-
-			float weight = skeletonWeight * src->Weight;
+		skeleton->updateActivateEntities();
 
-			core::quaternion* rotation = &src->AnimRotation;
-			core::vector3df* position = &src->AnimPosition;
-			core::vector3df* scale = &src->AnimScale;
-
-			if (first == true)
-			{
-				entity->AnimRotation.X = rotation->X * weight;
-				entity->AnimRotation.Y = rotation->Y * weight;
-				entity->AnimRotation.Z = rotation->Z * weight;
-				entity->AnimRotation.W = rotation->W * weight;
-
-				entity->AnimPosition.X = position->X * weight;
-				entity->AnimPosition.Y = position->Y * weight;
-				entity->AnimPosition.Z = position->Z * weight;
-
-				entity->AnimScale.X = scale->X * weight;
-				entity->AnimScale.Y = scale->Y * weight;
-				entity->AnimScale.Z = scale->Z * weight;
-			}
-			else
-			{
-				entity->AnimPosition.X += position->X * weight;
-				entity->AnimPosition.Y += position->Y * weight;
-				entity->AnimPosition.Z += position->Z * weight;
-
-				entity->AnimScale.X += scale->X * weight;
-				entity->AnimScale.Y += scale->Y * weight;
-				entity->AnimScale.Z += scale->Z * weight;
-
-				float Rx = rotation->X;
-				float Ry = rotation->Y;
-				float Rz = rotation->Z;
-				float Rw = rotation->W;
+		float skeletonWeight = skeleton->getTimeline().Weight;
 
-				float dot = entity->AnimRotation.X * Rx + entity->AnimRotation.Y * Ry + entity->AnimRotation.Z * Rz + entity->AnimRotation.W * Rw;
+		const f32* jointWeights = skeleton->m_jointWeights.const_pointer();
+		f32* layerWeights = m_layerWeights.pointer();
 
-				if (dot < 0.0f)
-				{
-					Rx *= -1.0f;
-					Ry *= -1.0f;
-					Rz *= -1.0f;
-					Rw *= -1.0f;
-				}
+		for (u32 i = 0, n = m_layerWeights.size(); i < n; i++)
+			layerWeights[i] = skeletonWeight * jointWeights[i];
+	}
 
-				entity->AnimRotation.X += Rx * weight;
-				entity->AnimRotation.Y += Ry * weight;
-				entity->AnimRotation.Z += Rz * weight;
-				entity->AnimRotation.W += Rw * weight;
-			}
-		}
+	void CSkeleton::doBlending(CSkeleton* skeleton, bool first)
+	{
+		updateLayerWeights(skeleton);
+		m_pose.blend(skeleton->m_pose, m_layerWeights.const_pointer(), m_activeMask.const_pointer(), first);
 	}
 
 	void CSkeleton::doAddtive(CSkeleton* skeleton, bool first)
 	{
-		core::quaternion addRotate;
-
-		float skeletonWeight = skeleton->getTimeline().Weight;
-
-		// Reference:
-		// https://github.com/guillaumeblanc/ozz-animation/blob/master/src/animation/runtime/blending_job.cc
-		// OZZ_ADD_PASS
-
-		CAnimationTransformData** entities = m_entitiesActivated.pointer();
-		u32 count = (u32)m_entitiesActivated.size();
-
-		for (u32 i = 0; i < count; i++)
-		{
-			CAnimationTransformData* entity = entities[i];
-			CAnimationTransformData* src = skeleton->m_entitiesData[entity->ID];
-
-			float weight = skeletonWeight * src->Weight;
-			float oneMinsWeight = 1.0f - weight;
-
-			core::quaternion* rotation = &src->AnimRotation;
-			core::vector3df* position = &src->AnimPosition;
-			core::vector3df* scale = &src->AnimScale;
-
-			entity->AnimPosition.X += position->X * weight;
-			entity->AnimPosition.Y += position->Y * weight;
-			entity->AnimPosition.Z += position->Z * weight;
-
-			entity->AnimScale.X = entity->AnimScale.X * (oneMinsWeight + (scale->X * weight));
-			entity->AnimScale.Y = entity->AnimScale.Y * (oneMinsWeight + (scale->Y * weight));
-			entity->AnimScale.Z = entity->AnimScale.Z * (oneMinsWeight + (scale->Z * weight));
-
-			float Rx = rotation->X;
-			float Ry = rotation->Y;
-			float Rz = rotation->Z;
-			float Rw = rotation->W;
-
-			if (Rw < 0.0f)
-			{
-				Rx *= -1.0f;
-				Ry *= -1.0f;
-				Rz *= -1.0f;
-				Rw *= -1.0f;
-			}
-
-			addRotate.set(
-				Rx * weight,
-				Ry * weight,
-				Rz * weight,
-				(Rw - 1.0f) * weight + 1.0f
-			);
-			addRotate.normalize();
-			entity->AnimRotation = addRotate * entity->AnimRotation;
-		}
+		updateLayerWeights(skeleton);
+		m_pose.additive(skeleton->m_pose, m_layerWeights.const_pointer(), m_activeMask.const_pointer());
 	}
 
 	void CSkeleton::doReplace(CSkeleton* skeleton, bool first)
 	{
-		float skeletonWeight = skeleton->getTimeline().Weight;
-
-		CAnimationTransformData** entities = m_entitiesActivated.pointer();
-		u32 count = (u32)m_entitiesActivated.size();
-
-		for (u32 i = 0; i < count; i++)
-		{
-			CAnimationTransformData* entity = entities[i];
-
-			CAnimationTransformData* src = skeleton->m_entitiesData[entity->ID];
-
-			float weight = skeletonWeight * src->Weight;
-			float oneMinWeight = 1.0f - weight;
-
-			core::quaternion* rotation = &src->AnimRotation;
-			core::vector3df* position = &src->AnimPosition;
-			core::vector3df* scale = &src->AnimScale;
-
-			CAnimationTrack::quaternionSlerp(entity->AnimRotation, entity->AnimRotation, *rotation, weight);
-
-			entity->AnimPosition.X = entity->AnimPosition.X * oneMinWeight + position->X * weight;
-			entity->AnimPosition.Y = entity->AnimPosition.Y * oneMinWeight + position->Y * weight;
-			entity->AnimPosition.Z = entity->AnimPosition.Z * oneMinWeight + position->Z * weight;
-
-			entity->AnimScale.X = entity->AnimScale.X * oneMinWeight + scale->X * weight;
-			entity->AnimScale.Y = entity->AnimScale.Y * oneMinWeight + scale->Y * weight;
-			entity->AnimScale.Z = entity->AnimScale.Z * oneMinWeight + scale->Z * weight;
-		}
+		updateLayerWeights(skeleton);
+		m_pose.replace(skeleton->m_pose, m_layerWeights.const_pointer(), m_activeMask.const_pointer());
 	}
 
 	void CSkeleton::syncAnimationByTimeScale()
@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CAnimationTimeline.h"
 #include "CAnimationTransformData.h"
+#include "CSkeletonPose.h"
 #include "Entity/CEntityPrefab.h"
 #include "Animation/CAnimationClip.h"
 
@@ -70,6 +71,21 @@ namespace Skylicht
 
 		EAnimationLayerType m_layerType;
 
+		// SoA pose of all joints (index by CAnimationTransformData::ID)
+		CSkeletonPose m_pose;
+
+		// per joint: Weight and 1.0 if the joint is activated
+		core::array<f32> m_jointWeights;
+		core::array<f32> m_activeMask;
+
+		// per joint: layer weight * joint weight of the blending skeleton
+		core::array<f32> m_layerWeights;
+
+		// per joint: 1 if the joint has child joints
+		core::array<u8> m_jointHasChild;
+
+		bool m_skipLeafJoints;
+
 	protected:
 
 		CSkeleton* m_target;
@@ -116,6 +132,22 @@ namespace Skylicht
 			return m_entitiesData;
 		}
 
+		inline CSkeletonPose& getPose()
+		{
+			return m_pose;
+		}
+
+		// write the pose to the activated joints (AnimPosition, AnimRotation, AnimScale)
+		void writePoseToJoints(const CSkeletonPose& pose);
+
+		// animation LOD: do not evaluate & apply the joints that have no child (finger, toe...)
+		void setSkipLeafJoints(bool b);
+
+		inline bool isSkipLeafJoints()
+		{
+			return m_skipLeafJoints;
+		}
+
 		inline CAnimationClip* getCurrentAnimation()
 		{
 			return m_clip;
@@ -174,10 +206,21 @@ namespace Skylicht
 
 		void setAnimationData();
 
+		void initPose();
+
+		void writePoseToJoints();
+
+		inline bool isSkippedJoint(CAnimationTransformData* entity)
+		{
+			return m_skipLeafJoints && m_jointHasChild[entity->ID] == 0;
+		}
+
 		void updateTrackKeyFrame();
 
 		void updateBlending();
 
+		void updateLayerWeights(CSkeleton* skeleton);
+
 		void doBlending(CSkeleton* skeleton, bool first);
 
 		void doAddtive(CSkeleton* skeleton, bool first);
@@ -0,0 +1,348 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSkeletonPose.h"
+#include "Animation/CAnimationTrack.h"
+#include "Utils/CSIMD.h"
+
+namespace Skylicht
+{
+	CSkeletonPose::CSkeletonPose() :
+		m_count(0),
+		m_stride(0)
+	{
+
+	}
+
+	CSkeletonPose::~CSkeletonPose()
+	{
+
+	}
+
+	void CSkeletonPose::resize(u32 count)
+	{
+		m_count = count;
+		m_stride = (count + 3) & ~3;
+
+		m_data.set_used(m_stride * ChannelCount);
+
+		// identity
+		for (int c = 0; c < ChannelCount; c++)
+		{
+			f32 value = (c == RotationW || c >= ScaleX) ? 1.0f : 0.0f;
+
+			f32* data = getChannel(c);
+			for (u32 i = 0; i < m_stride; i++)
+				data[i] = value;
+		}
+	}
+
+	void CSkeletonPose::set(u32 id, const core::vector3df& position, const core::quaternion& rotation, const core::vector3df& scale)
+	{
+		f32* data = m_data.pointer() + id;
+		data[PositionX * m_stride] = position.X;
+		data[PositionY * m_stride] = position.Y;
+		data[PositionZ * m_stride] = position.Z;
+		data[RotationX * m_stride] = rotation.X;
+		data[RotationY * m_stride] = rotation.Y;
+		data[RotationZ * m_stride] = rotation.Z;
+		data[RotationW * m_stride] = rotation.W;
+		data[ScaleX * m_stride] = scale.X;
+		data[ScaleY * m_stride] = scale.Y;
+		data[ScaleZ * m_stride] = scale.Z;
+	}
+
+	void CSkeletonPose::get(u32 id, core::vector3df& position, core::quaternion& rotation, core::vector3df& scale) const
+	{
+		const f32* data = m_data.const_pointer() + id;
+		position.X = data[PositionX * m_stride];
+		position.Y = data[PositionY * m_stride];
+		position.Z = data[PositionZ * m_stride];
+		rotation.X = data[RotationX * m_stride];
+		rotation.Y = data[RotationY * m_stride];
+		rotation.Z = data[RotationZ * m_stride];
+		rotation.W = data[RotationW * m_stride];
+		scale.X = data[ScaleX * m_stride];
+		scale.Y = data[ScaleY * m_stride];
+		scale.Z = data[ScaleZ * m_stride];
+	}
+
+	void CSkeletonPose::blend(const CSkeletonPose& src, const f32* weight, const f32* mask, bool first)
+	{
+		f32* out[ChannelCount];
+		const f32* in[ChannelCount];
+		for (int c = 0; c < ChannelCount; c++)
+		{
+			out[c] = getChannel(c);
+			in[c] = src.getChannel(c);
+		}
+
+		f32x4 zero = CSIMD::splat4(0.0f);
+		f32x4 minusOne = CSIMD::splat4(-1.0f);
+		f32x4 one = CSIMD::splat4(1.0f);
+
+		for (u32 i = 0; i < m_stride; i += 4)
+		{
+			f32x4 w = CSIMD::load4(weight + i);
+			f32x4 update = CSIMD::less4(zero, CSIMD::load4(mask + i));
+
+			if (first)
+			{
+				for (int c = 0; c < ChannelCount; c++)
+				{
+					f32x4 v = CSIMD::mul4(CSIMD::load4(in[c] + i), w);
+					CSIMD::store4(out[c] + i, CSIMD::select4(update, v, CSIMD::load4(out[c] + i)));
+				}
+			}
+			else
+			{
+				// position & scale
+				for (int c = PositionX; c <= PositionZ; c++)
+				{
+					f32x4 v = CSIMD::madd4(CSIMD::load4(in[c] + i), w, CSIMD::load4(out[c] + i));
+					CSIMD::store4(out[c] + i, CSIMD::select4(update, v, CSIMD::load4(out[c] + i)));
+				}
+
+				for (int c = ScaleX; c <= ScaleZ; c++)
+				{
+					f32x4 v = CSIMD::madd4(CSIMD::load4(in[c] + i), w, CSIMD::load4(out[c] + i));
+					CSIMD::store4(out[c] + i, CSIMD::select4(update, v, CSIMD::load4(out[c] + i)));
+				}
+
+				// rotation, use the short way
+				f32x4 dot = zero;
+				for (int c = RotationX; c <= RotationW; c++)
+					dot = CSIMD::madd4(CSIMD::load4(out[c] + i), CSIMD::load4(in[c] + i), dot);
+
+				f32x4 sign = CSIMD::select4(CSIMD::less4(dot, zero), minusOne, one);
+				f32x4 ws = CSIMD::mul4(w, sign);
+
+				for (int c = RotationX; c <= RotationW; c++)
+				{
+					f32x4 v = CSIMD::madd4(CSIMD::load4(in[c] + i), ws, CSIMD::load4(out[c] + i));
+					CSIMD::store4(out[c] + i, CSIMD::select4(update, v, CSIMD::load4(out[c] + i)));
+				}
+			}
+		}
+	}
+
+	void CSkeletonPose::additive(const CSkeletonPose& src, const f32* weight, const f32* mask)
+	{
+		// Reference:
+		// https://github.com/guillaumeblanc/ozz-animation/blob/master/src/animation/runtime/blending_job.cc
+		// OZZ_ADD_PASS
+
+		f32* out[ChannelCount];
+		const f32* in[ChannelCount];
+		for (int c = 0; c < ChannelCount; c++)
+		{
+			out[c] = getChannel(c);
+			in[c] = src.getChannel(c);
+		}
+
+		f32x4 zero = CSIMD::splat4(0.0f);
+		f32x4 minusOne = CSIMD::splat4(-1.0f);
+		f32x4 one = CSIMD::splat4(1.0f);
+
+		for (u32 i = 0; i < m_stride; i += 4)
+		{
+			f32x4 w = CSIMD::load4(weight + i);
+			f32x4 oneMinusWeight = CSIMD::sub4(one, w);
+			f32x4 update = CSIMD::less4(zero, CSIMD::load4(mask + i));
+
+			// position
+			for (int c = PositionX; c <= PositionZ; c++)
+			{
+				f32x4 v = CSIMD::madd4(CSIMD::load4(in[c] + i), w, CSIMD::load4(out[c] + i));
+				CSIMD::store4(out[c] + i, CSIMD::select4(update, v, CSIMD::load4(out[c] + i)));
+			}
+
+			// scale
+			for (int c = ScaleX; c <= ScaleZ; c++)
+			{
+				f32x4 o = CSIMD::load4(out[c] + i);
+				f32x4 v = CSIMD::mul4(o, CSIMD::madd4(CSIMD::load4(in[c] + i), w, oneMinusWeight));
+				CSIMD::store4(out[c] + i, CSIMD::select4(update, v, o));
+			}
+
+			// rotation: add = normalize(lerp(identity, src, weight)), out = add * out
+			f32x4 rw = CSIMD::load4(in[RotationW] + i);
+			f32x4 sign = CSIMD::select4(CSIMD::less4(rw, zero), minusOne, one);
+			f32x4 ws = CSIMD::mul4(w, sign);
+
+			f32x4 ax = CSIMD::mul4(CSIMD::load4(in[RotationX] + i), ws);
+			f32x4 ay = CSIMD::mul4(CSIMD::load4(in[RotationY] + i), ws);
+			f32x4 az = CSIMD::mul4(CSIMD::load4(in[RotationZ] + i), ws);
+			f32x4 aw = CSIMD::madd4(CSIMD::sub4(CSIMD::mul4(rw, sign), one), w, one);
+
+			f32x4 len = CSIMD::mul4(ax, ax);
+			len = CSIMD::madd4(ay, ay, len);
+			len = CSIMD::madd4(az, az, len);
+			len = CSIMD::madd4(aw, aw, len);
+
+			f32x4 invLen = CSIMD::div4(one, CSIMD::sqrt4(len));
+			ax = CSIMD::mul4(ax, invLen);
+			ay = CSIMD::mul4(ay, invLen);
+			az = CSIMD::mul4(az, invLen);
+			aw = CSIMD::mul4(aw, invLen);
+
+			f32x4 ox = CSIMD::load4(out[RotationX] + i);
+			f32x4 oy = CSIMD::load4(out[RotationY] + i);
+			f32x4 oz = CSIMD::load4(out[RotationZ] + i);
+			f32x4 ow = CSIMD::load4(out[RotationW] + i);
+
+			// same as core::quaternion operator* (add * out)
+			f32x4 x = CSIMD::mul4(ow, ax);
+			x = CSIMD::madd4(ox, aw, x);
+			x = CSIMD::madd4(oy, az, x);
+			x = CSIMD::sub4(x, CSIMD::mul4(oz, ay));
+
+			f32x4 y = CSIMD::mul4(ow, ay);
+			y = CSIMD::madd4(oy, aw, y);
+			y = CSIMD::madd4(oz, ax, y);
+			y = CSIMD::sub4(y, CSIMD::mul4(ox, az));
+
+			f32x4 z = CSIMD::mul4(ow, az);
+			z = CSIMD::madd4(oz, aw, z);
+			z = CSIMD::madd4(ox, ay, z);
+			z = CSIMD::sub4(z, CSIMD::mul4(oy, ax));
+
+			f32x4 rotW = CSIMD::mul4(ow, aw);
+			rotW = CSIMD::sub4(rotW, CSIMD::mul4(ox, ax));
+			rotW = CSIMD::sub4(rotW, CSIMD::mul4(oy, ay));
+			rotW = CSIMD::sub4(rotW, CSIMD::mul4(oz, az));
+
+			CSIMD::store4(out[RotationX] + i, CSIMD::select4(update, x, ox));
+			CSIMD::store4(out[RotationY] + i, CSIMD::select4(update, y, oy));
+			CSIMD::store4(out[RotationZ] + i, CSIMD::select4(update, z, oz));
+			CSIMD::store4(out[RotationW] + i, CSIMD::select4(update, rotW, ow));
+		}
+	}
+
+	void CSkeletonPose::replace(const CSkeletonPose& src, const f32* weight, const f32* mask)
+	{
+		f32* out[ChannelCount];
+		const f32* in[ChannelCount];
+		for (int c = 0; c < ChannelCount; c++)
+		{
+			out[c] = getChannel(c);
+			in[c] = src.getChannel(c);
+		}
+
+		f32x4 zero = CSIMD::splat4(0.0f);
+		f32x4 one = CSIMD::splat4(1.0f);
+
+		// lerp position & scale
+		for (u32 i = 0; i < m_stride; i += 4)
+		{
+			f32x4 w = CSIMD::load4(weight + i);
+			f32x4 oneMinusWeight = CSIMD::sub4(one, w);
+			f32x4 update = CSIMD::less4(zero, CSIMD::load4(mask + i));
+
+			for (int c = PositionX; c <= PositionZ; c++)
+			{
+				f32x4 o = CSIMD::load4(out[c] + i);
+				f32x4 v = CSIMD::madd4(CSIMD::load4(in[c] + i), w, CSIMD::mul4(o, oneMinusWeight));
+				CSIMD::store4(out[c] + i, CSIMD::select4(update, v, o));
+			}
+
+			for (int c = ScaleX; c <= ScaleZ; c++)
+			{
+				f32x4 o = CSIMD::load4(out[c] + i);
+				f32x4 v = CSIMD::madd4(CSIMD::load4(in[c] + i), w, CSIMD::mul4(o, oneMinusWeight));
+				CSIMD::store4(out[c] + i, CSIMD::select4(update, v, o));
+			}
+		}
+
+		// slerp rotation
+		core::quaternion q1, q2, r;
+		for (u32 i = 0; i < m_count; i++)
+		{
+			if (mask[i] <= 0.0f)
+				continue;
+
+			q1.set(out[RotationX][i], out[RotationY][i], out[RotationZ][i], out[RotationW][i]);
+			q2.set(in[RotationX][i], in[RotationY][i], in[RotationZ][i], in[RotationW][i]);
+
+			CAnimationTrack::quaternionSlerp(r, q1, q2, weight[i]);
+
+			out[RotationX][i] = r.X;
+			out[RotationY][i] = r.Y;
+			out[RotationZ][i] = r.Z;
+			out[RotationW][i] = r.W;
+		}
+	}
+
+	void CSkeletonPose::lerp(const CSkeletonPose& target, f32 t)
+	{
+		f32* out[ChannelCount];
+		const f32* in[ChannelCount];
+		for (int c = 0; c < ChannelCount; c++)
+		{
+			out[c] = getChannel(c);
+			in[c] = target.getChannel(c);
+		}
+
+		f32x4 zero = CSIMD::splat4(0.0f);
+		f32x4 one = CSIMD::splat4(1.0f);
+		f32x4 w = CSIMD::splat4(t);
+		f32x4 minusW = CSIMD::splat4(-t);
+
+		for (u32 i = 0; i < m_stride; i += 4)
+		{
+			for (int c = PositionX; c <= PositionZ; c++)
+			{
+				f32x4 o = CSIMD::load4(out[c] + i);
+				CSIMD::store4(out[c] + i, CSIMD::madd4(CSIMD::sub4(CSIMD::load4(in[c] + i), o), w, o));
+			}
+
+			for (int c = ScaleX; c <= ScaleZ; c++)
+			{
+				f32x4 o = CSIMD::load4(out[c] + i);
+				CSIMD::store4(out[c] + i, CSIMD::madd4(CSIMD::sub4(CSIMD::load4(in[c] + i), o), w, o));
+			}
+
+			// rotation, use the short way
+			f32x4 dot = zero;
+			for (int c = RotationX; c <= RotationW; c++)
+				dot = CSIMD::madd4(CSIMD::load4(out[c] + i), CSIMD::load4(in[c] + i), dot);
+
+			f32x4 ws = CSIMD::select4(CSIMD::less4(dot, zero), minusW, w);
+			f32x4 oneMinusW = CSIMD::sub4(one, w);
+
+			f32x4 q[4];
+			f32x4 len = zero;
+			for (int c = 0; c < 4; c++)
+			{
+				q[c] = CSIMD::madd4(CSIMD::load4(in[RotationX + c] + i), ws, CSIMD::mul4(CSIMD::load4(out[RotationX + c] + i), oneMinusW));
+				len = CSIMD::madd4(q[c], q[c], len);
+			}
+
+			f32x4 invLen = CSIMD::div4(one, CSIMD::sqrt4(len));
+			for (int c = 0; c < 4; c++)
+				CSIMD::store4(out[RotationX + c] + i, CSIMD::mul4(q[c], invLen));
+		}
+	}
+}
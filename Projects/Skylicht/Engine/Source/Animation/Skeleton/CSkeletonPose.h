@@ -0,0 +1,98 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	// The pose of a skeleton in SoA layout: one float array per channel,
+	// the joint index is CAnimationTransformData::ID
+	// The channel size is padded to 4 so the blending loops work on 4 joints per step
+	class SKYLICHT_API CSkeletonPose
+	{
+	public:
+		enum EChannel
+		{
+			PositionX = 0,
+			PositionY,
+			PositionZ,
+			RotationX,
+			RotationY,
+			RotationZ,
+			RotationW,
+			ScaleX,
+			ScaleY,
+			ScaleZ,
+			ChannelCount
+		};
+
+	protected:
+		core::array<f32> m_data;
+
+		u32 m_count;
+
+		u32 m_stride;
+
+	public:
+		CSkeletonPose();
+
+		virtual ~CSkeletonPose();
+
+		void resize(u32 count);
+
+		inline u32 getCount() const
+		{
+			return m_count;
+		}
+
+		inline u32 getStride() const
+		{
+			return m_stride;
+		}
+
+		inline f32* getChannel(int channel)
+		{
+			return m_data.pointer() + channel * m_stride;
+		}
+
+		inline const f32* getChannel(int channel) const
+		{
+			return m_data.const_pointer() + channel * m_stride;
+		}
+
+		void set(u32 id, const core::vector3df& position, const core::quaternion& rotation, const core::vector3df& scale);
+
+		void get(u32 id, core::vector3df& position, core::quaternion& rotation, core::vector3df& scale) const;
+
+		// weight: per joint weight, mask: per joint 1.0 (update) or 0.0 (keep the current value)
+		void blend(const CSkeletonPose& src, const f32* weight, const f32* mask, bool first);
+
+		void additive(const CSkeletonPose& src, const f32* weight, const f32* mask);
+
+		void replace(const CSkeletonPose& src, const f32* weight, const f32* mask);
+
+		// move this pose to the target pose by t (rotation is nlerp)
+		void lerp(const CSkeletonPose& target, f32 t);
+	};
+}
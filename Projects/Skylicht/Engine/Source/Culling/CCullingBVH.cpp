@@ -0,0 +1,464 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCullingBVH.h"
+
+namespace Skylicht
+{
+	static inline f32 getBoxArea(const core::aabbox3df& box)
+	{
+		core::vector3df e = box.getExtent();
+		return 2.0f * (e.X * e.Y + e.Y * e.Z + e.Z * e.X);
+	}
+
+	static inline core::aabbox3df mergeBox(const core::aabbox3df& a, const core::aabbox3df& b)
+	{
+		core::aabbox3df r = a;
+		r.addInternalBox(b);
+		return r;
+	}
+
+	static inline bool isBoxInside(const core::aabbox3df& inner, const core::aabbox3df& outer)
+	{
+		return outer.MinEdge.X <= inner.MinEdge.X && outer.MinEdge.Y <= inner.MinEdge.Y && outer.MinEdge.Z <= inner.MinEdge.Z &&
+			inner.MaxEdge.X <= outer.MaxEdge.X && inner.MaxEdge.Y <= outer.MaxEdge.Y && inner.MaxEdge.Z <= outer.MaxEdge.Z;
+	}
+
+	static inline bool isBoxOutsideFrustum(const core::aabbox3df& box, const SViewFrustum* frustum)
+	{
+		core::vector3df c = box.getCenter();
+		core::vector3df e = box.getExtent() * 0.5f;
+
+		for (int i = 0; i < SViewFrustum::VF_PLANE_COUNT; i++)
+		{
+			const core::plane3df& plane = frustum->planes[i];
+			const core::vector3df& n = plane.Normal;
+
+			f32 d = n.X * c.X + n.Y * c.Y + n.Z * c.Z + plane.D;
+			f32 r = fabsf(n.X) * e.X + fabsf(n.Y) * e.Y + fabsf(n.Z) * e.Z;
+
+			if (d - r > core::ROUNDING_ERROR_f32)
+				return true;
+		}
+
+		return false;
+	}
+
+	CCullingBVH::CCullingBVH(f32 margin) :
+		m_root(-1),
+		m_freeList(-1),
+		m_proxyCount(0),
+		m_margin(margin)
+	{
+
+	}
+
+	CCullingBVH::~CCullingBVH()
+	{
+
+	}
+
+	void CCullingBVH::clear()
+	{
+		m_nodes.set_used(0);
+		m_leaves.set_used(0);
+		m_root = -1;
+		m_freeList = -1;
+		m_proxyCount = 0;
+	}
+
+	int CCullingBVH::allocNode()
+	{
+		int id;
+		if (m_freeList != -1)
+		{
+			id = m_freeList;
+			m_freeList = m_nodes[id].Parent;
+		}
+		else
+		{
+			id = (int)m_nodes.size();
+			m_nodes.push_back(SNode());
+			m_leaves.push_back(SLeaf());
+		}
+
+		SNode& node = m_nodes[id];
+		node.Parent = -1;
+		node.Child1 = -1;
+		node.Child2 = -1;
+		node.Height = 0;
+
+		SLeaf& leaf = m_leaves[id];
+		leaf.Owner = NULL;
+		leaf.UserData = -1;
+		leaf.Tag = 0;
+		return id;
+	}
+
+	void CCullingBVH::freeNode(int node)
+	{
+		m_nodes[node].Parent = m_freeList;
+		m_nodes[node].Height = -1;
+		m_leaves[node].Owner = NULL;
+		m_freeList = node;
+	}
+
+	int CCullingBVH::createProxy(const core::aabbox3df& box, const core::aabbox3df& localBox, void* owner, int userData, const core::matrix4& world)
+	{
+		int proxy = allocNode();
+
+		core::vector3df margin = box.getExtent() * m_margin;
+
+		SNode& node = m_nodes[proxy];
+		node.Box.MinEdge = box.MinEdge - margin;
+		node.Box.MaxEdge = box.MaxEdge + margin;
+
+		SLeaf& leaf = m_leaves[proxy];
+		leaf.LocalBox = localBox;
+		leaf.World = world;
+		leaf.Owner = owner;
+		leaf.UserData = userData;
+
+		insertLeaf(proxy);
+		m_proxyCount++;
+		return proxy;
+	}
+
+	void CCullingBVH::destroyProxy(int proxy)
+	{
+		removeLeaf(proxy);
+		freeNode(proxy);
+		m_proxyCount--;
+	}
+
+	bool CCullingBVH::moveProxy(int proxy, const core::aabbox3df& box, const core::aabbox3df& localBox, const core::matrix4& world)
+	{
+		m_leaves[proxy].LocalBox = localBox;
+		m_leaves[proxy].World = world;
+
+		// the enlarged box still contains the box
+		if (isBoxInside(box, m_nodes[proxy].Box))
+			return false;
+
+		removeLeaf(proxy);
+
+		core::vector3df margin = box.getExtent() * m_margin;
+
+		SNode& node = m_nodes[proxy];
+		node.Box.MinEdge = box.MinEdge - margin;
+		node.Box.MaxEdge = box.MaxEdge + margin;
+
+		insertLeaf(proxy);
+		return true;
+	}
+
+	int CCullingBVH::destroyProxies(u32 keepTag)
+	{
+		int count = 0;
+		for (int i = 0, n = (int)m_nodes.size(); i < n; i++)
+		{
+			if (m_nodes[i].Height == 0 && m_leaves[i].Tag != keepTag)
+			{
+				destroyProxy(i);
+				count++;
+			}
+		}
+		return count;
+	}
+
+	void CCullingBVH::updateNode(int node)
+	{
+		SNode& n = m_nodes[node];
+		SNode& c1 = m_nodes[n.Child1];
+		SNode& c2 = m_nodes[n.Child2];
+
+		n.Height = 1 + core::max_(c1.Height, c2.Height);
+		n.Box = mergeBox(c1.Box, c2.Box);
+	}
+
+	void CCullingBVH::insertLeaf(int leaf)
+	{
+		if (m_root == -1)
+		{
+			m_root = leaf;
+			m_nodes[leaf].Parent = -1;
+			return;
+		}
+
+		// find the best sibling by surface area
+		core::aabbox3df leafBox = m_nodes[leaf].Box;
+
+		int index = m_root;
+		while (!m_nodes[index].isLeaf())
+		{
+			SNode& node = m_nodes[index];
+			int child1 = node.Child1;
+			int child2 = node.Child2;
+
+			f32 area = getBoxArea(node.Box);
+			f32 combinedArea = getBoxArea(mergeBox(node.Box, leafBox));
+
+			// cost of creating a new parent for this node and the new leaf
+			f32 cost = 2.0f * combinedArea;
+
+			// minimum cost of pushing the leaf further down the tree
+			f32 inheritanceCost = 2.0f * (combinedArea - area);
+
+			f32 cost1 = getBoxArea(mergeBox(leafBox, m_nodes[child1].Box)) + inheritanceCost;
+			if (!m_nodes[child1].isLeaf())
+				cost1 -= getBoxArea(m_nodes[child1].Box);
+
+			f32 cost2 = getBoxArea(mergeBox(leafBox, m_nodes[child2].Box)) + inheritanceCost;
+			if (!m_nodes[child2].isLeaf())
+				cost2 -= getBoxArea(m_nodes[child2].Box);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		int sibling = index;
+
+		// create a new parent
+		int oldParent = m_nodes[sibling].Parent;
+		int newParent = allocNode();
+
+		SNode& parent = m_nodes[newParent];
+		parent.Parent = oldParent;
+		parent.Box = mergeBox(leafBox, m_nodes[sibling].Box);
+		parent.Height = m_nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+
+		if (oldParent != -1)
+		{
+			if (m_nodes[oldParent].Child1 == sibling)
+				m_nodes[oldParent].Child1 = newParent;
+			else
+				m_nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].Parent = newParent;
+		m_nodes[leaf].Parent = newParent;
+
+		// walk back up the tree fixing heights and boxes
+		index = m_nodes[leaf].Parent;
+		while (index != -1)
+		{
+			index = balance(index);
+			updateNode(index);
+			index = m_nodes[index].Parent;
+		}
+	}
+
+	void CCullingBVH::removeLeaf(int leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = -1;
+			return;
+		}
+
+		int parent = m_nodes[leaf].Parent;
+		int grandParent = m_nodes[parent].Parent;
+		int sibling = m_nodes[parent].Child1 == leaf ? m_nodes[parent].Child2 : m_nodes[parent].Child1;
+
+		if (grandParent != -1)
+		{
+			// destroy parent and connect sibling to grandParent
+			if (m_nodes[grandParent].Child1 == parent)
+				m_nodes[grandParent].Child1 = sibling;
+			else
+				m_nodes[grandParent].Child2 = sibling;
+
+			m_nodes[sibling].Parent = grandParent;
+			freeNode(parent);
+
+			int index = grandParent;
+			while (index != -1)
+			{
+				index = balance(index);
+				updateNode(index);
+				index = m_nodes[index].Parent;
+			}
+		}
+		else
+		{
+			m_root = sibling;
+			m_nodes[sibling].Parent = -1;
+			freeNode(parent);
+		}
+	}
+
+	int CCullingBVH::balance(int iA)
+	{
+		SNode& A = m_nodes[iA];
+		if (A.isLeaf() || A.Height < 2)
+			return iA;
+
+		int iB = A.Child1;
+		int iC = A.Child2;
+		SNode& B = m_nodes[iB];
+		SNode& C = m_nodes[iC];
+
+		int balance = C.Height - B.Height;
+
+		// rotate C up
+		if (balance > 1)
+		{
+			int iF = C.Child1;
+			int iG = C.Child2;
+			SNode& F = m_nodes[iF];
+			SNode& G = m_nodes[iG];
+
+			C.Child1 = iA;
+			C.Parent = A.Parent;
+			A.Parent = iC;
+
+			if (C.Parent != -1)
+			{
+				if (m_nodes[C.Parent].Child1 == iA)
+					m_nodes[C.Parent].Child1 = iC;
+				else
+					m_nodes[C.Parent].Child2 = iC;
+			}
+			else
+			{
+				m_root = iC;
+			}
+
+			if (F.Height > G.Height)
+			{
+				C.Child2 = iF;
+				A.Child2 = iG;
+				G.Parent = iA;
+				A.Box = mergeBox(B.Box, G.Box);
+				C.Box = mergeBox(A.Box, F.Box);
+				A.Height = 1 + core::max_(B.Height, G.Height);
+				C.Height = 1 + core::max_(A.Height, F.Height);
+			}
+			else
+			{
+				C.Child2 = iG;
+				A.Child2 = iF;
+				F.Parent = iA;
+				A.Box = mergeBox(B.Box, F.Box);
+				C.Box = mergeBox(A.Box, G.Box);
+				A.Height = 1 + core::max_(B.Height, F.Height);
+				C.Height = 1 + core::max_(A.Height, G.Height);
+			}
+
+			return iC;
+		}
+
+		// rotate B up
+		if (balance < -1)
+		{
+			int iD = B.Child1;
+			int iE = B.Child2;
+			SNode& D = m_nodes[iD];
+			SNode& E = m_nodes[iE];
+
+			B.Child1 = iA;
+			B.Parent = A.Parent;
+			A.Parent = iB;
+
+			if (B.Parent != -1)
+			{
+				if (m_nodes[B.Parent].Child1 == iA)
+					m_nodes[B.Parent].Child1 = iB;
+				else
+					m_nodes[B.Parent].Child2 = iB;
+			}
+			else
+			{
+				m_root = iB;
+			}
+
+			if (D.Height > E.Height)
+			{
+				B.Child2 = iD;
+				A.Child1 = iE;
+				E.Parent = iA;
+				A.Box = mergeBox(C.Box, E.Box);
+				B.Box = mergeBox(A.Box, D.Box);
+				A.Height = 1 + core::max_(C.Height, E.Height);
+				B.Height = 1 + core::max_(A.Height, D.Height);
+			}
+			else
+			{
+				B.Child2 = iE;
+				A.Child1 = iD;
+				D.Parent = iA;
+				A.Box = mergeBox(C.Box, D.Box);
+				B.Box = mergeBox(A.Box, E.Box);
+				A.Height = 1 + core::max_(C.Height, D.Height);
+				B.Height = 1 + core::max_(A.Height, E.Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void CCullingBVH::query(const core::aabbox3df& box, const SViewFrustum* frustum, CFastArray<int>& result)
+	{
+		if (m_root == -1)
+			return;
+
+		m_stack.set_used(0);
+		m_stack.push_back(m_root);
+
+		while (m_stack.size() > 0)
+		{
+			int id = m_stack.getLast();
+			m_stack.set_used(m_stack.size() - 1);
+
+			const SNode& node = m_nodes[id];
+
+			if (!node.Box.intersectsWithBox(box))
+				continue;
+
+			if (frustum != NULL && isBoxOutsideFrustum(node.Box, frustum))
+				continue;
+
+			if (node.isLeaf())
+			{
+				result.push(m_leaves[id].UserData);
+			}
+			else
+			{
+				m_stack.push_back(node.Child1);
+				m_stack.push_back(node.Child2);
+			}
+		}
+	}
+}
@@ -0,0 +1,165 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Entity/CArrayUtils.h"
+
+namespace Skylicht
+{
+	// Dynamic bounding volume tree of world boxes for culling
+	// The leaf box is enlarged by a margin, so the small moving does not need to update the tree
+	// and the static objects are rejected by the whole subtree
+	class SKYLICHT_API CCullingBVH
+	{
+	public:
+		struct SNode
+		{
+			// leaf: enlarged box of proxy, node: union of childs
+			core::aabbox3df Box;
+
+			// parent or next free node
+			int Parent;
+			int Child1;
+			int Child2;
+
+			// leaf = 0, free node = -1
+			int Height;
+
+			inline bool isLeaf() const
+			{
+				return Child1 == -1;
+			}
+		};
+
+		struct SLeaf
+		{
+			void* Owner;
+			core::aabbox3df LocalBox;
+			core::matrix4 World;
+			int UserData;
+			u32 Tag;
+		};
+
+	protected:
+		// the leaf data is stored separately, so the traversal only touches the small node
+		core::array<SNode> m_nodes;
+		core::array<SLeaf> m_leaves;
+
+		int m_root;
+		int m_freeList;
+		int m_proxyCount;
+
+		f32 m_margin;
+
+		core::array<int> m_stack;
+
+	public:
+		// margin: the ratio of box size that the leaf box is enlarged
+		CCullingBVH(f32 margin = 0.1f);
+
+		virtual ~CCullingBVH();
+
+		void clear();
+
+		// box: the world box, localBox & world: the box in owner space and its transform that are used to check the change
+		int createProxy(const core::aabbox3df& box, const core::aabbox3df& localBox, void* owner, int userData, const core::matrix4& world = core::IdentityMatrix);
+
+		void destroyProxy(int proxy);
+
+		// return true if the proxy is reinserted
+		bool moveProxy(int proxy, const core::aabbox3df& box, const core::aabbox3df& localBox, const core::matrix4& world = core::IdentityMatrix);
+
+		inline bool isProxyOf(int proxy, void* owner)
+		{
+			return proxy >= 0 && proxy < (int)m_nodes.size() && m_nodes[proxy].Height == 0 && m_leaves[proxy].Owner == owner;
+		}
+
+		inline const core::aabbox3df& getLocalBox(int proxy)
+		{
+			return m_leaves[proxy].LocalBox;
+		}
+
+		// compare with the transform & box of the last update, not with a frame flag
+		// because the owner can be updated many times before the culling
+		inline bool isChanged(int proxy, const core::aabbox3df& localBox, const core::matrix4& world)
+		{
+			const SLeaf& leaf = m_leaves[proxy];
+			return leaf.LocalBox != localBox || leaf.World != world;
+		}
+
+		inline void setUserData(int proxy, int userData)
+		{
+			m_leaves[proxy].UserData = userData;
+		}
+
+		inline int getUserData(int proxy)
+		{
+			return m_leaves[proxy].UserData;
+		}
+
+		inline void setTag(int proxy, u32 tag)
+		{
+			m_leaves[proxy].Tag = tag;
+		}
+
+		inline const core::aabbox3df& getFatBox(int proxy)
+		{
+			return m_nodes[proxy].Box;
+		}
+
+		inline int getProxyCount()
+		{
+			return m_proxyCount;
+		}
+
+		inline int getHeight()
+		{
+			return m_root == -1 ? 0 : m_nodes[m_root].Height;
+		}
+
+		// destroy all proxies that have tag different with this tag
+		// return the number of destroyed proxies
+		int destroyProxies(u32 keepTag);
+
+		// get user data of the leaves that intersect the box
+		// and are in the frustum (frustum can be NULL)
+		// note: this function is not thread safe
+		void query(const core::aabbox3df& box, const SViewFrustum* frustum, CFastArray<int>& result);
+
+	protected:
+
+		int allocNode();
+
+		void freeNode(int node);
+
+		void insertLeaf(int leaf);
+
+		void removeLeaf(int leaf);
+
+		int balance(int node);
+
+		void updateNode(int node);
+	};
+}
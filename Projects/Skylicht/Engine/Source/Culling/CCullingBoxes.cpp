@@ -0,0 +1,309 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCullingBoxes.h"
+#include "Utils/CSIMD.h"
+
+namespace Skylicht
+{
+	CCullingBoxes::CCullingBoxes() :
+		m_count(0)
+	{
+
+	}
+
+	CCullingBoxes::~CCullingBoxes()
+	{
+
+	}
+
+	void CCullingBoxes::reset()
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			m_min[i].reset();
+			m_max[i].reset();
+			m_center[i].reset();
+		}
+
+		for (int i = 0; i < 9; i++)
+			m_axis[i].reset();
+
+		m_testFrustum.reset();
+		m_count = 0;
+	}
+
+	void CCullingBoxes::add(const core::aabbox3df& localBox, const core::matrix4& world, bool testFrustum, core::aabbox3df& worldBox)
+	{
+		const f32* m = world.pointer();
+
+		core::vector3df c = localBox.getCenter();
+		core::vector3df h = localBox.getExtent() * 0.5f;
+
+		f32 center[3];
+		f32 axis[9];
+		f32 e[3];
+
+		for (int i = 0; i < 3; i++)
+		{
+			center[i] = m[i] * c.X + m[4 + i] * c.Y + m[8 + i] * c.Z + m[12 + i];
+
+			// the half axis of oriented box
+			axis[i] = m[i] * h.X;
+			axis[3 + i] = m[4 + i] * h.Y;
+			axis[6 + i] = m[8 + i] * h.Z;
+
+			// world aabb, same as matrix4::transformBoxEx
+			e[i] = fabsf(axis[i]) + fabsf(axis[3 + i]) + fabsf(axis[6 + i]);
+
+			m_min[i].push(center[i] - e[i]);
+			m_max[i].push(center[i] + e[i]);
+			m_center[i].push(center[i]);
+		}
+
+		for (int i = 0; i < 9; i++)
+			m_axis[i].push(axis[i]);
+
+		m_testFrustum.push(testFrustum ? 1 : 0);
+
+		worldBox.MinEdge.set(center[0] - e[0], center[1] - e[1], center[2] - e[2]);
+		worldBox.MaxEdge.set(center[0] + e[0], center[1] + e[1], center[2] + e[2]);
+
+		m_count++;
+	}
+
+	void CCullingBoxes::cull(const core::aabbox3df& box, const SViewFrustum* frustum, u8* result, int begin, int end)
+	{
+#if defined(SKYLICHT_SSE) || defined(SKYLICHT_NEON)
+		const f32* minX = m_min[0].pointer();
+		const f32* minY = m_min[1].pointer();
+		const f32* minZ = m_min[2].pointer();
+		const f32* maxX = m_max[0].pointer();
+		const f32* maxY = m_max[1].pointer();
+		const f32* maxZ = m_max[2].pointer();
+
+		const f32* cx = m_center[0].pointer();
+		const f32* cy = m_center[1].pointer();
+		const f32* cz = m_center[2].pointer();
+
+		const f32* a[9];
+		for (int j = 0; j < 9; j++)
+			a[j] = m_axis[j].pointer();
+
+		const u8* testFrustum = m_testFrustum.pointer();
+
+		int simdEnd = begin + ((end - begin) & ~3);
+		int i = begin;
+#endif
+
+#if defined(SKYLICHT_SSE)
+		const __m128 boxMinX = _mm_set1_ps(box.MinEdge.X);
+		const __m128 boxMinY = _mm_set1_ps(box.MinEdge.Y);
+		const __m128 boxMinZ = _mm_set1_ps(box.MinEdge.Z);
+		const __m128 boxMaxX = _mm_set1_ps(box.MaxEdge.X);
+		const __m128 boxMaxY = _mm_set1_ps(box.MaxEdge.Y);
+		const __m128 boxMaxZ = _mm_set1_ps(box.MaxEdge.Z);
+
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 epsilon = _mm_set1_ps(core::ROUNDING_ERROR_f32);
+
+		for (; i < simdEnd; i += 4)
+		{
+			// aabb intersects
+			__m128 inside = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX + i), boxMaxX), _mm_cmpge_ps(_mm_loadu_ps(maxX + i), boxMinX));
+			inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY + i), boxMaxY), _mm_cmpge_ps(_mm_loadu_ps(maxY + i), boxMinY)));
+			inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minZ + i), boxMaxZ), _mm_cmpge_ps(_mm_loadu_ps(maxZ + i), boxMinZ)));
+
+			if (frustum != NULL && _mm_movemask_ps(inside) != 0)
+			{
+				__m128 testMask = _mm_cmpneq_ps(
+					_mm_set_ps(testFrustum[i + 3], testFrustum[i + 2], testFrustum[i + 1], testFrustum[i]),
+					zero);
+
+				if (_mm_movemask_ps(testMask) != 0)
+				{
+					__m128 x = _mm_loadu_ps(cx + i);
+					__m128 y = _mm_loadu_ps(cy + i);
+					__m128 z = _mm_loadu_ps(cz + i);
+
+					__m128 ax[9];
+					for (int j = 0; j < 9; j++)
+						ax[j] = _mm_loadu_ps(a[j] + i);
+
+					__m128 outside = zero;
+
+					for (int p = 0; p < SViewFrustum::VF_PLANE_COUNT; p++)
+					{
+						const core::plane3df& plane = frustum->planes[p];
+						__m128 nx = _mm_set1_ps(plane.Normal.X);
+						__m128 ny = _mm_set1_ps(plane.Normal.Y);
+						__m128 nz = _mm_set1_ps(plane.Normal.Z);
+
+						// distance of center
+						__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_add_ps(_mm_mul_ps(nz, z), _mm_set1_ps(plane.D)));
+
+						// projected radius of oriented box
+						__m128 r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, ax[0]), _mm_mul_ps(ny, ax[1])), _mm_mul_ps(nz, ax[2]));
+						__m128 r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, ax[3]), _mm_mul_ps(ny, ax[4])), _mm_mul_ps(nz, ax[5]));
+						__m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, ax[6]), _mm_mul_ps(ny, ax[7])), _mm_mul_ps(nz, ax[8]));
+						__m128 r = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, r0), _mm_andnot_ps(signMask, r1)), _mm_andnot_ps(signMask, r2));
+
+						// all corners are in front of plane
+						outside = _mm_or_ps(outside, _mm_cmpgt_ps(_mm_sub_ps(d, r), epsilon));
+					}
+
+					inside = _mm_andnot_ps(_mm_and_ps(outside, testMask), inside);
+				}
+			}
+
+			int bits = _mm_movemask_ps(inside);
+			result[i] = bits & 1;
+			result[i + 1] = (bits >> 1) & 1;
+			result[i + 2] = (bits >> 2) & 1;
+			result[i + 3] = (bits >> 3) & 1;
+		}
+
+		cullScalar(box, frustum, result, i, end);
+#elif defined(SKYLICHT_NEON)
+		const float32x4_t boxMinX = vdupq_n_f32(box.MinEdge.X);
+		const float32x4_t boxMinY = vdupq_n_f32(box.MinEdge.Y);
+		const float32x4_t boxMinZ = vdupq_n_f32(box.MinEdge.Z);
+		const float32x4_t boxMaxX = vdupq_n_f32(box.MaxEdge.X);
+		const float32x4_t boxMaxY = vdupq_n_f32(box.MaxEdge.Y);
+		const float32x4_t boxMaxZ = vdupq_n_f32(box.MaxEdge.Z);
+
+		const float32x4_t epsilon = vdupq_n_f32(core::ROUNDING_ERROR_f32);
+
+		for (; i < simdEnd; i += 4)
+		{
+			// aabb intersects
+			uint32x4_t inside = vandq_u32(vcleq_f32(vld1q_f32(minX + i), boxMaxX), vcgeq_f32(vld1q_f32(maxX + i), boxMinX));
+			inside = vandq_u32(inside, vandq_u32(vcleq_f32(vld1q_f32(minY + i), boxMaxY), vcgeq_f32(vld1q_f32(maxY + i), boxMinY)));
+			inside = vandq_u32(inside, vandq_u32(vcleq_f32(vld1q_f32(minZ + i), boxMaxZ), vcgeq_f32(vld1q_f32(maxZ + i), boxMinZ)));
+
+			if (frustum != NULL)
+			{
+				uint32_t test[4] = {
+					testFrustum[i] ? 0xffffffff : 0,
+					testFrustum[i + 1] ? 0xffffffff : 0,
+					testFrustum[i + 2] ? 0xffffffff : 0,
+					testFrustum[i + 3] ? 0xffffffff : 0
+				};
+				uint32x4_t testMask = vld1q_u32(test);
+
+				float32x4_t x = vld1q_f32(cx + i);
+				float32x4_t y = vld1q_f32(cy + i);
+				float32x4_t z = vld1q_f32(cz + i);
+
+				float32x4_t ax[9];
+				for (int j = 0; j < 9; j++)
+					ax[j] = vld1q_f32(a[j] + i);
+
+				uint32x4_t outside = vdupq_n_u32(0);
+
+				for (int p = 0; p < SViewFrustum::VF_PLANE_COUNT; p++)
+				{
+					const core::plane3df& plane = frustum->planes[p];
+					const f32 nx = plane.Normal.X;
+					const f32 ny = plane.Normal.Y;
+					const f32 nz = plane.Normal.Z;
+
+					float32x4_t d = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(plane.D), x, nx), y, ny), z, nz);
+
+					float32x4_t r0 = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(ax[0], nx), ax[1], ny), ax[2], nz);
+					float32x4_t r1 = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(ax[3], nx), ax[4], ny), ax[5], nz);
+					float32x4_t r2 = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(ax[6], nx), ax[7], ny), ax[8], nz);
+					float32x4_t r = vaddq_f32(vaddq_f32(vabsq_f32(r0), vabsq_f32(r1)), vabsq_f32(r2));
+
+					outside = vorrq_u32(outside, vcgtq_f32(vsubq_f32(d, r), epsilon));
+				}
+
+				inside = vbicq_u32(inside, vandq_u32(outside, testMask));
+			}
+
+			result[i] = vgetq_lane_u32(inside, 0) ? 1 : 0;
+			result[i + 1] = vgetq_lane_u32(inside, 1) ? 1 : 0;
+			result[i + 2] = vgetq_lane_u32(inside, 2) ? 1 : 0;
+			result[i + 3] = vgetq_lane_u32(inside, 3) ? 1 : 0;
+		}
+
+		cullScalar(box, frustum, result, i, end);
+#else
+		cullScalar(box, frustum, result, begin, end);
+#endif
+	}
+
+	void CCullingBoxes::cullScalar(const core::aabbox3df& box, const SViewFrustum* frustum, u8* result, int begin, int end)
+	{
+		const f32* minX = m_min[0].pointer();
+		const f32* minY = m_min[1].pointer();
+		const f32* minZ = m_min[2].pointer();
+		const f32* maxX = m_max[0].pointer();
+		const f32* maxY = m_max[1].pointer();
+		const f32* maxZ = m_max[2].pointer();
+
+		const u8* testFrustum = m_testFrustum.pointer();
+
+		for (int i = begin; i < end; i++)
+		{
+			bool inside =
+				minX[i] <= box.MaxEdge.X && maxX[i] >= box.MinEdge.X &&
+				minY[i] <= box.MaxEdge.Y && maxY[i] >= box.MinEdge.Y &&
+				minZ[i] <= box.MaxEdge.Z && maxZ[i] >= box.MinEdge.Z;
+
+			if (inside && frustum != NULL && testFrustum[i])
+			{
+				f32 x = m_center[0].pointer()[i];
+				f32 y = m_center[1].pointer()[i];
+				f32 z = m_center[2].pointer()[i];
+
+				f32 ax[9];
+				for (int j = 0; j < 9; j++)
+					ax[j] = m_axis[j].pointer()[i];
+
+				for (int p = 0; p < SViewFrustum::VF_PLANE_COUNT; p++)
+				{
+					const core::plane3df& plane = frustum->planes[p];
+					const core::vector3df& n = plane.Normal;
+
+					f32 d = n.X * x + n.Y * y + n.Z * z + plane.D;
+					f32 r = fabsf(n.X * ax[0] + n.Y * ax[1] + n.Z * ax[2]) +
+						fabsf(n.X * ax[3] + n.Y * ax[4] + n.Z * ax[5]) +
+						fabsf(n.X * ax[6] + n.Y * ax[7] + n.Z * ax[8]);
+
+					// all corners are in front of plane
+					if (d - r > core::ROUNDING_ERROR_f32)
+					{
+						inside = false;
+						break;
+					}
+				}
+			}
+
+			result[i] = inside ? 1 : 0;
+		}
+	}
+}
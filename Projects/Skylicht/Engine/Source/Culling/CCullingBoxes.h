@@ -0,0 +1,73 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Entity/CArrayUtils.h"
+
+namespace Skylicht
+{
+	// The world boxes of culling entities in SoA layout, that is tested 4 boxes per SIMD instruction
+	// Each box is stored as an oriented box: center + 3 half axis (local box transformed by world matrix)
+	class SKYLICHT_API CCullingBoxes
+	{
+	protected:
+		// world aabb
+		CFastArray<f32> m_min[3];
+		CFastArray<f32> m_max[3];
+
+		// world oriented box
+		CFastArray<f32> m_center[3];
+		CFastArray<f32> m_axis[9];
+
+		// 1: need test with the frustum planes
+		CFastArray<u8> m_testFrustum;
+
+		int m_count;
+
+	public:
+		CCullingBoxes();
+
+		virtual ~CCullingBoxes();
+
+		void reset();
+
+		// add the local box transformed by world matrix, and return the world aabb
+		void add(const core::aabbox3df& localBox, const core::matrix4& world, bool testFrustum, core::aabbox3df& worldBox);
+
+		inline int count()
+		{
+			return m_count;
+		}
+
+		// result[i] = 1 if the box i (in range [begin, end)) intersects the box
+		// and it is in the frustum (if it need test frustum)
+		// frustum can be NULL to skip the plane test
+		void cull(const core::aabbox3df& box, const SViewFrustum* frustum, u8* result, int begin, int end);
+
+	protected:
+
+		void cullScalar(const core::aabbox3df& box, const SViewFrustum* frustum, u8* result, int begin, int end);
+	};
+}
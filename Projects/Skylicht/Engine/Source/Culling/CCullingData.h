@@ -49,6 +49,9 @@ namespace Skylicht
 
 		bool Occlusion;
 
+		// the proxy on CCullingSystem spatial tree
+		int TreeProxy;
+
 	public:
 		CCullingData();
 
@@ -31,6 +31,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "RenderPipeline/CShadowMapRP.h"
 
+#include "Job/CJobSystem.h"
+
+#define MIN_CULLING_BATCH 1024
+
 namespace Skylicht
 {
 	bool g_useCacheCulling = false;
@@ -45,8 +49,21 @@ namespace Skylicht
 		return g_useCacheCulling;
 	}
 
+	bool g_useCullingTree = true;
+
+	void CCullingSystem::useCullingTree(bool b)
+	{
+		g_useCullingTree = b;
+	}
+
+	bool CCullingSystem::useCullingTree()
+	{
+		return g_useCullingTree;
+	}
+
 	CCullingSystem::CCullingSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_treeTag(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
@@ -77,6 +94,9 @@ namespace Skylicht
 		numEntity = m_group->getEntityCount();
 
 		m_bboxAndMaterials.reset();
+		m_boxes.reset();
+
+		m_treeTag++;
 
 		for (int i = 0; i < numEntity; i++)
 		{
@@ -103,6 +123,8 @@ namespace Skylicht
 					m->Culling = culling;
 					m->BBox = meshObj->getBoundingBoxPtr();
 					m->Materials = &meshObj->Materials;
+
+					addCullingBox(entity, culling, m->BBox);
 				}
 				else
 				{
@@ -114,10 +136,60 @@ namespace Skylicht
 						m->Culling = culling;
 						m->BBox = &bbox->BBox;
 						m->Materials = &bbox->Materials;
+
+						addCullingBox(entity, culling, m->BBox);
 					}
 				}
 			}
 		}
+
+		if (g_useCullingTree)
+		{
+			// remove the proxies of the entities that are not in the list
+			if (m_tree.getProxyCount() != m_bboxAndMaterials.count())
+				m_tree.destroyProxies(m_treeTag);
+		}
+		else if (m_tree.getProxyCount() > 0)
+		{
+			m_tree.clear();
+		}
+	}
+
+	void CCullingSystem::addCullingBox(CEntity* entity, CCullingData* culling, core::aabbox3df* bbox)
+	{
+		CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+
+		bool testFrustum = false;
+		if (culling->Type == CCullingData::FrustumBox)
+			testFrustum = GET_ENTITY_DATA(entity, CWorldInverseTransformData) != NULL;
+
+		// culling->BBox is the world bbox
+		if (g_useCullingTree)
+		{
+			int index = m_bboxAndMaterials.count() - 1;
+
+			// update the proxy only when the transform or bbox is changed
+			// NeedValidate is not used, it is reset on each CEntityManager::update that can run many times before render
+			int proxy = culling->TreeProxy;
+			if (!m_tree.isProxyOf(proxy, culling))
+			{
+				m_boxes.add(*bbox, transform->World, testFrustum, culling->BBox);
+				proxy = m_tree.createProxy(culling->BBox, *bbox, culling, index, transform->World);
+				culling->TreeProxy = proxy;
+			}
+			else if (m_tree.isChanged(proxy, *bbox, transform->World))
+			{
+				m_boxes.add(*bbox, transform->World, testFrustum, culling->BBox);
+				m_tree.moveProxy(proxy, culling->BBox, *bbox, transform->World);
+			}
+
+			m_tree.setUserData(proxy, index);
+			m_tree.setTag(proxy, m_treeTag);
+		}
+		else
+		{
+			m_boxes.add(*bbox, transform->World, testFrustum, culling->BBox);
+		}
 	}
 
 	void CCullingSystem::init(CEntityManager* entityManager)
@@ -131,21 +203,102 @@ namespace Skylicht
 		if (rp == NULL)
 			return;
 
-		core::matrix4 invTrans;
-
 		// camera
 		CCamera* camera = entityManager->getCamera();
 		u32 cameraCullingMask = camera->getCullingMask();
-		const core::aabbox3df& cameraBox = camera->getViewFrustum().getBoundingBox();
 
 		int count = m_bboxAndMaterials.count();
 		SBBoxAndMaterial* bboxMats = m_bboxAndMaterials.pointer();
 
+		m_cullResult.set_used(count);
+		u8* cullResult = m_cullResult.pointer();
+
+		if (!g_useCacheCulling && count > 0 && g_useCullingTree)
+		{
+			const core::aabbox3df* box = &camera->getViewFrustum().getBoundingBox();
+			const SViewFrustum* frustum = &camera->getViewFrustum();
+
+			if (rp->getType() == IRenderPipeline::ShadowMap)
+			{
+				CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+				box = &shadowMapRP->getFrustumBox();
+				frustum = NULL;
+			}
+
+			memset(cullResult, 0, count);
+
+			// the static boxes are rejected by the tree nodes
+			m_treeResult.reset();
+			m_tree.query(*box, frustum, m_treeResult);
+
+			// exact test the tree result
+			int numResult = m_treeResult.count();
+			int* result = m_treeResult.pointer();
+
+			m_boxes.reset();
+			for (int i = 0; i < numResult; i++)
+			{
+				SBBoxAndMaterial* bbBoxMat = &bboxMats[result[i]];
+				CEntity* entity = bbBoxMat->Entity;
+				CCullingData* culling = bbBoxMat->Culling;
+
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+
+				bool testFrustum = false;
+				if (culling->Type == CCullingData::FrustumBox)
+					testFrustum = GET_ENTITY_DATA(entity, CWorldInverseTransformData) != NULL;
+
+				m_boxes.add(*bbBoxMat->BBox, transform->World, testFrustum, culling->BBox);
+			}
+
+			m_treeCullResult.set_used(numResult);
+			if (numResult > 0)
+			{
+				u8* treeCullResult = m_treeCullResult.pointer();
+				m_boxes.cull(*box, frustum, treeCullResult, 0, numResult);
+
+				for (int i = 0; i < numResult; i++)
+					cullResult[result[i]] = treeCullResult[i];
+			}
+		}
+		else if (!g_useCacheCulling && count > 0)
+		{
+			// 1. Detect by bounding box
+			// 2. Detect by frustum planes (CCullingData::FrustumBox)
+			const core::aabbox3df* box = &camera->getViewFrustum().getBoundingBox();
+			const SViewFrustum* frustum = &camera->getViewFrustum();
+
+			if (rp->getType() == IRenderPipeline::ShadowMap)
+			{
+				CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+				box = &shadowMapRP->getFrustumBox();
+				frustum = NULL;
+			}
+
+			SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+			int numThread = jobSystem->getWorkerCount() + 1;
+
+			if (numThread == 1 || count < MIN_CULLING_BATCH * 2)
+			{
+				m_boxes.cull(*box, frustum, cullResult, 0, count);
+			}
+			else
+			{
+				// the batch is aligned 4 boxes for simd
+				int batch = core::max_(MIN_CULLING_BATCH, count / (numThread * 4));
+				batch = (batch + 3) & ~3;
+
+				jobSystem->parallelFor(count, batch, [this, box, frustum, cullResult](int begin, int end)
+					{
+						m_boxes.cull(*box, frustum, cullResult, begin, end);
+					});
+			}
+		}
+
 		for (int i = 0; i < count; i++)
 		{
 			SBBoxAndMaterial* bbBoxMat = &bboxMats[i];
 
-			CEntity* entity = bbBoxMat->Entity;
 			CCullingData* culling = bbBoxMat->Culling;
 
 			if (g_useCacheCulling)
@@ -192,67 +345,8 @@ namespace Skylicht
 			if (g_useCacheCulling)
 				continue;
 
-			// transform world bbox
-			culling->BBox = *bbBoxMat->BBox;
-
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			transform->World.transformBoxEx(culling->BBox);
-
-			// 1. Detect by bounding box
-			if (rp->getType() == IRenderPipeline::ShadowMap)
-			{
-				CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
-
-				const core::aabbox3df& box = shadowMapRP->getFrustumBox();
-				culling->CameraCulled = !culling->BBox.intersectsWithBox(box);
-				culling->Visible = !culling->CameraCulled;
-				continue;
-			}
-			else
-			{
-				culling->CameraCulled = !culling->BBox.intersectsWithBox(cameraBox);
-				culling->Visible = !culling->CameraCulled;
-			}
-
-			// 2. Detect algorithm
-			if (culling->Visible == true)
-			{
-				if (culling->Type == CCullingData::FrustumBox)
-				{
-					CWorldInverseTransformData* invTransform = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
-					if (invTransform)
-					{
-						// transform the frustum to the node's current absolute transformation
-						invTrans = invTransform->WorldInverse;
-
-						SViewFrustum frust = camera->getViewFrustum();
-						frust.transform(invTrans);
-
-						core::vector3df edges[8];
-						bbBoxMat->BBox->getEdges(edges);
-
-						for (s32 i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; ++i)
-						{
-							bool boxInFrustum = false;
-							for (u32 j = 0; j < 8; ++j)
-							{
-								if (frust.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
-								{
-									boxInFrustum = true;
-									break;
-								}
-							}
-
-							if (!boxInFrustum)
-							{
-								culling->CameraCulled = true;
-								culling->Visible = false;
-								break;
-							}
-						}
-					} // if invTransform
-				}
-			}
+			culling->CameraCulled = cullResult[i] == 0;
+			culling->Visible = !culling->CameraCulled;
 		}
 	}
 
@@ -26,6 +26,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CCullingData.h"
 #include "CVisibleData.h"
+#include "CCullingBoxes.h"
+#include "CCullingBVH.h"
 #include "Entity/CEntityGroup.h"
 #include "Entity/IRenderSystem.h"
 #include "Transform/CWorldTransformData.h"
@@ -58,6 +60,17 @@ namespace Skylicht
 	protected:
 		CFastArray<SBBoxAndMaterial> m_bboxAndMaterials;
 
+		// world boxes of m_bboxAndMaterials
+		CCullingBoxes m_boxes;
+
+		core::array<u8> m_cullResult;
+
+		// spatial tree of world boxes, see useCullingTree
+		CCullingBVH m_tree;
+		CFastArray<int> m_treeResult;
+		core::array<u8> m_treeCullResult;
+		u32 m_treeTag;
+
 		CEntityGroup* m_group;
 
 	public:
@@ -80,5 +93,20 @@ namespace Skylicht
 		static void useCacheCulling(bool b);
 
 		static bool useCacheCulling();
+
+		// use the spatial tree to reject the static objects by the whole subtree
+		// the proxy is only updated when the entity transform is changed
+		static void useCullingTree(bool b);
+
+		static bool useCullingTree();
+
+		inline CCullingBVH* getCullingTree()
+		{
+			return &m_tree;
+		}
+
+	protected:
+
+		void addCullingBox(CEntity* entity, CCullingData* culling, core::aabbox3df* bbox);
 	};
 }
\ No newline at end of file
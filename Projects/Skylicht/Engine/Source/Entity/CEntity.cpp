@@ -37,7 +37,9 @@ namespace Skylicht
 	CEntity::CEntity(CEntityManager* mgr) :
 		m_alive(true),
 		m_visible(true),
-		m_mgr(mgr)
+		m_mgr(mgr),
+		m_dataMask(0),
+		m_poolMask(0)
 	{
 		m_index = mgr->getNumEntities();
 
@@ -48,7 +50,9 @@ namespace Skylicht
 	CEntity::CEntity(CEntityPrefab* mgr) :
 		m_alive(true),
 		m_visible(true),
-		m_mgr(NULL)
+		m_mgr(NULL),
+		m_dataMask(0),
+		m_poolMask(0)
 	{
 		m_index = mgr->getNumEntities();
 
@@ -67,14 +71,73 @@ namespace Skylicht
 		{
 			notifyUpdateGroup(index);
 
-			delete Data[index];
-			Data[index] = NULL;
+			deleteData(index);
 			return true;
 		}
 
 		return false;
 	}
 
+	void* CEntity::allocDataMemory(u32 index, u32 size)
+	{
+		if (m_mgr == NULL || !m_mgr->isDataPoolMode())
+			return NULL;
+
+		CEntityDataPool* pool = m_mgr->getDataPool(index, size);
+		if (pool == NULL)
+			return NULL;
+
+		return pool->alloc();
+	}
+
+	void CEntity::freeDataMemory(u32 index, void* p)
+	{
+		CEntityDataPool* pool = m_mgr->getDataPool(index, 0);
+		pool->free(p);
+	}
+
+	void CEntity::setData(u32 index, IEntityData* data, bool fromPool)
+	{
+		if (Data[index])
+			deleteData(index);
+
+		u64 bit = (u64)1 << index;
+
+		Data[index] = data;
+		m_dataMask |= bit;
+
+		if (fromPool)
+			m_poolMask |= bit;
+
+		notifyUpdateGroup(index);
+	}
+
+	void CEntity::deleteData(u32 index)
+	{
+		IEntityData* data = Data[index];
+		if (data == NULL)
+			return;
+
+		u64 bit = (u64)1 << index;
+
+		if (m_poolMask & bit)
+		{
+			// the pool memory is the address of most derived object
+			void* memory = dynamic_cast<void*>(data);
+			data->~IEntityData();
+			freeDataMemory(index, memory);
+
+			m_poolMask &= ~bit;
+		}
+		else
+		{
+			delete data;
+		}
+
+		Data[index] = NULL;
+		m_dataMask &= ~bit;
+	}
+
 	IEntityData* CEntity::addDataByActivator(const char* dataType)
 	{
 		IActivatorObject* obj = CActivator::getInstance()->createInstance(dataType);
@@ -97,13 +160,8 @@ namespace Skylicht
 
 		int index = CEntityDataTypeManager::getDataIndex(typeid(*data));
 
-		if (Data[index])
-			delete Data[index];
-
 		// save at index
-		Data[index] = data;
-
-		notifyUpdateGroup(index);
+		setData(index, data, false);
 
 		return data;
 	}
@@ -114,8 +172,7 @@ namespace Skylicht
 		{
 			if (Data[i])
 			{
-				delete Data[i];
-				Data[i] = NULL;
+				deleteData(i);
 
 				notifyUpdateGroup(i);
 			}
@@ -52,6 +52,13 @@ namespace Skylicht
 		std::string m_id;
 
 		CEntityManager* m_mgr;
+
+		// bit i is on if Data[i] is not NULL
+		u64 m_dataMask;
+
+		// bit i is on if Data[i] is allocated from CEntityManager data pool
+		u64 m_poolMask;
+
 	public:
 
 		IEntityData* Data[MAX_ENTITY_DATA];
@@ -80,6 +87,16 @@ namespace Skylicht
 			return Data[dataIndex];
 		}
 
+		inline u64 getDataMask()
+		{
+			return m_dataMask;
+		}
+
+		inline bool haveDataMask(u64 mask)
+		{
+			return (m_dataMask & mask) == mask;
+		}
+
 		inline void setID(const char* id)
 		{
 			m_id = id;
@@ -126,45 +143,30 @@ namespace Skylicht
 			m_alive = b;
 		}
 
+		void* allocDataMemory(u32 index, u32 size);
+
+		void freeDataMemory(u32 index, void* p);
+
+		void setData(u32 index, IEntityData* data, bool fromPool);
+
+		void deleteData(u32 index);
 	};
 
 	template<class T>
 	T* CEntity::addData()
 	{
-		T* newData = new T();
-		IEntityData* data = dynamic_cast<IEntityData*>(newData);
-		if (data == NULL)
-		{
-			char exceptionInfo[512];
-			sprintf(exceptionInfo, "CEntity::addData %s must inherit IEntityData", typeid(T).name());
-			os::Printer::log(exceptionInfo);
-
-			delete newData;
-			return NULL;
-		}
-
 		// get index of type
 		u32 index = CEntityDataTypeManager::getDataIndex(typeid(T));
-
-		// also save this entity index
-		data->EntityIndex = m_index;
-		data->Entity = this;
-
-		if (Data[index])
-			delete Data[index];
-
-		// save at index
-		Data[index] = newData;
-
-		notifyUpdateGroup(index);
-
-		return newData;
+		return addData<T>((int)index);
 	}
 
 	template<class T>
 	T* CEntity::addData(int index)
 	{
-		T* newData = new T();
+		// data pool mode: the data is allocated on the pool of entity manager
+		void* memory = allocDataMemory((u32)index, (u32)sizeof(T));
+
+		T* newData = memory ? new (memory) T() : new T();
 		IEntityData* data = dynamic_cast<IEntityData*>(newData);
 		if (data == NULL)
 		{
@@ -172,7 +174,15 @@ namespace Skylicht
 			sprintf(exceptionInfo, "CEntity::addData %s must inherit IEntityData", typeid(T).name());
 			os::Printer::log(exceptionInfo);
 
-			delete newData;
+			if (memory)
+			{
+				newData->~T();
+				freeDataMemory((u32)index, memory);
+			}
+			else
+			{
+				delete newData;
+			}
 			return NULL;
 		}
 
@@ -180,13 +190,8 @@ namespace Skylicht
 		data->EntityIndex = m_index;
 		data->Entity = this;
 
-		if (Data[index])
-			delete Data[index];
-
 		// save at index
-		Data[index] = newData;
-
-		notifyUpdateGroup(index);
+		setData((u32)index, data, memory != NULL);
 
 		return newData;
 	}
@@ -217,8 +222,7 @@ namespace Skylicht
 
 		if (Data[index])
 		{
-			delete Data[index];
-			Data[index] = NULL;
+			deleteData(index);
 
 			notifyUpdateGroup(index);
 
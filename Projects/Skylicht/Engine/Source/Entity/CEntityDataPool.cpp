@@ -0,0 +1,90 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CEntityDataPool.h"
+
+#define ENTITY_DATA_ALIGNMENT 16
+
+namespace Skylicht
+{
+	CEntityDataPool::CEntityDataPool(u32 elementSize, u32 chunkSize) :
+		m_chunkSize(chunkSize),
+		m_chunkUsed(chunkSize),
+		m_free(NULL),
+		m_allocCount(0)
+	{
+		// the free list is stored inside the released element
+		if (elementSize < sizeof(void*))
+			elementSize = sizeof(void*);
+
+		m_elementSize = (elementSize + ENTITY_DATA_ALIGNMENT - 1) & ~(ENTITY_DATA_ALIGNMENT - 1);
+	}
+
+	CEntityDataPool::~CEntityDataPool()
+	{
+		for (u32 i = 0, n = m_chunks.size(); i < n; i++)
+			delete[] m_chunks[i];
+		m_chunks.clear();
+	}
+
+	void* CEntityDataPool::alloc()
+	{
+		m_allocCount++;
+
+		if (m_free != NULL)
+		{
+			void* p = m_free;
+			m_free = *((void**)p);
+			return p;
+		}
+
+		if (m_chunkUsed >= m_chunkSize)
+		{
+			// new[] of u8 only guarantees the fundamental alignment
+			// so the chunk is allocated with a padding
+			u8* chunk = new u8[m_elementSize * m_chunkSize + ENTITY_DATA_ALIGNMENT];
+			m_chunks.push_back(chunk);
+			m_chunkUsed = 0;
+		}
+
+		u8* chunk = m_chunks.getLast();
+		uintptr_t begin = ((uintptr_t)chunk + ENTITY_DATA_ALIGNMENT - 1) & ~((uintptr_t)ENTITY_DATA_ALIGNMENT - 1);
+
+		void* p = (void*)(begin + m_elementSize * m_chunkUsed);
+		m_chunkUsed++;
+		return p;
+	}
+
+	void CEntityDataPool::free(void* p)
+	{
+		if (p == NULL)
+			return;
+
+		*((void**)p) = m_free;
+		m_free = p;
+
+		m_allocCount--;
+	}
+}
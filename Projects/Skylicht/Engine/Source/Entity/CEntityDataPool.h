@@ -0,0 +1,71 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	// Chunked storage for the data of one entity data type
+	// see CEntityManager::setDataPoolMode
+	class SKYLICHT_API CEntityDataPool
+	{
+	protected:
+		u32 m_elementSize;
+		u32 m_chunkSize;
+
+		core::array<u8*> m_chunks;
+
+		// the number of elements used in last chunk
+		u32 m_chunkUsed;
+
+		// single linked list of released elements
+		void* m_free;
+
+		u32 m_allocCount;
+
+	public:
+		CEntityDataPool(u32 elementSize, u32 chunkSize = 256);
+
+		virtual ~CEntityDataPool();
+
+		void* alloc();
+
+		void free(void* p);
+
+		inline u32 getElementSize()
+		{
+			return m_elementSize;
+		}
+
+		inline u32 getAllocCount()
+		{
+			return m_allocCount;
+		}
+
+		inline u32 getChunkCount()
+		{
+			return m_chunks.size();
+		}
+	};
+}
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CEntityGroup.h"
+#include "CEntityManager.h"
 
 namespace Skylicht
 {
@@ -54,6 +55,10 @@ namespace Skylicht
 		u32* types = m_dataTypes.pointer();
 		int count = m_dataTypes.size();
 
+		u64 mask = 0;
+		for (int j = 0; j < count; j++)
+			mask |= (u64)1 << types[j];
+
 		m_entities.reset();
 
 		if (m_parentGroup)
@@ -61,25 +66,47 @@ namespace Skylicht
 			numEntity = m_parentGroup->getEntityCount();
 			entities = m_parentGroup->getEntities();
 		}
-
-		for (int i = 0; i < numEntity; i++)
+		else if (entityManager->isDataPoolMode())
 		{
-			CEntity* entity = entities[i];
-			bool selectEntity = true;
+			// just select the mask groups that have the data types
+			core::array<CEntityMaskGroup*>& maskGroups = entityManager->getMaskGroups();
+			u32 numMaskGroup = maskGroups.size();
 
-			for (int j = 0; j < count; j++)
+			int numDepth = 0;
+			for (u32 i = 0; i < numMaskGroup; i++)
 			{
-				if (entity->Data[types[j]] == NULL)
+				if (maskGroups[i]->haveDataMask(mask))
+					numDepth = core::max_(numDepth, maskGroups[i]->getDepthCount());
+			}
+
+			// keep the order of depth, the parent transform is updated before the children
+			for (int depth = 0; depth < numDepth; depth++)
+			{
+				for (u32 i = 0; i < numMaskGroup; i++)
 				{
-					selectEntity = false;
-					break;
+					CEntityMaskGroup* maskGroup = maskGroups[i];
+					if (!maskGroup->haveDataMask(mask) || depth >= maskGroup->getDepthCount())
+						continue;
+
+					int begin, end;
+					maskGroup->getDepthRange(depth, begin, end);
+
+					CEntity** groupEntities = maskGroup->getEntities();
+					for (int j = begin; j < end; j++)
+						m_entities.push(groupEntities[j]);
 				}
 			}
 
-			if (selectEntity)
-			{
+			m_needQuery = false;
+			m_needValidate = true;
+			return;
+		}
+
+		for (int i = 0; i < numEntity; i++)
+		{
+			CEntity* entity = entities[i];
+			if (entity->haveDataMask(mask))
 				m_entities.push(entity);
-			}
 		}
 
 		m_needQuery = false;
@@ -50,8 +50,14 @@ namespace Skylicht
 		m_camera(NULL),
 		m_renderPipeline(NULL),
 		m_systemChanged(true),
-		m_needSortEntities(true)
+		m_needSortEntities(true),
+		m_parallelUpdate(true),
+		m_dataPoolMode(false),
+		m_needUpdateMaskGroups(true)
 	{
+		for (int i = 0; i < MAX_ENTITY_DATA; i++)
+			m_dataPools[i] = NULL;
+
 		// core engine systems
 		addSystem<CVisibleSystem>();
 		addSystem<CComponentTransformSystem>();
@@ -82,6 +88,17 @@ namespace Skylicht
 		releaseAllEntities();
 		releaseAllSystems();
 		releaseAllGroups();
+		releaseAllMaskGroups();
+
+		// the pools must be released after all entities
+		for (int i = 0; i < MAX_ENTITY_DATA; i++)
+		{
+			if (m_dataPools[i])
+			{
+				delete m_dataPools[i];
+				m_dataPools[i] = NULL;
+			}
+		}
 	}
 
 	void CEntityManager::releaseAllEntities()
@@ -108,6 +125,12 @@ namespace Skylicht
 
 		m_systems.clear();
 		m_renders.clear();
+
+		for (SkylichtSystem::CJobGroup* job : m_systemJobs)
+			delete job;
+		m_systemJobs.clear();
+
+		m_systemChanged = true;
 	}
 
 	void CEntityManager::releaseAllGroups()
@@ -117,6 +140,93 @@ namespace Skylicht
 		m_groups.clear();
 	}
 
+	void CEntityManager::releaseAllMaskGroups()
+	{
+		for (u32 i = 0, n = m_maskGroups.size(); i < n; i++)
+			delete m_maskGroups[i];
+		m_maskGroups.clear();
+		m_maskGroupMap.clear();
+
+		m_needUpdateMaskGroups = true;
+	}
+
+	void CEntityManager::setDataPoolMode(bool b)
+	{
+		if (m_dataPoolMode == b)
+			return;
+
+		m_dataPoolMode = b;
+
+		if (!m_dataPoolMode)
+			releaseAllMaskGroups();
+
+		notifyUpdateSortEntities();
+	}
+
+	CEntityMaskGroup* CEntityManager::getMaskGroup(u64 dataMask)
+	{
+		std::map<u64, CEntityMaskGroup*>::iterator i = m_maskGroupMap.find(dataMask);
+		if (i != m_maskGroupMap.end())
+			return i->second;
+
+		CEntityMaskGroup* maskGroup = new CEntityMaskGroup(dataMask);
+		m_maskGroups.push_back(maskGroup);
+		m_maskGroupMap[dataMask] = maskGroup;
+		return maskGroup;
+	}
+
+	CEntityDataPool* CEntityManager::getDataPool(u32 dataType, u32 dataSize)
+	{
+		CEntityDataPool* pool = m_dataPools[dataType];
+		if (pool == NULL)
+		{
+			if (dataSize == 0)
+				return NULL;
+
+			pool = new CEntityDataPool(dataSize);
+			m_dataPools[dataType] = pool;
+		}
+
+		// a custom data index (see CEntity::addData(int)) can use a bigger class
+		if (dataSize > pool->getElementSize())
+			return NULL;
+
+		return pool;
+	}
+
+	void CEntityManager::updateMaskGroups()
+	{
+		for (u32 i = 0, n = m_maskGroups.size(); i < n; i++)
+			m_maskGroups[i]->reset();
+
+		CEntityMaskGroup* maskGroup = NULL;
+
+		// the alives are sorted by depth (see sortAliveEntities)
+		u32 numAlive = m_alives.size();
+		u32 count = 0;
+
+		for (int depth = 0; depth < MAX_ENTITY_DEPTH && count < numAlive; depth++)
+		{
+			CEntity** entities = m_sortDepth[depth].pointer();
+
+			for (int i = 0, n = m_sortDepth[depth].count(); i < n; i++)
+			{
+				CEntity* entity = entities[i];
+				u64 mask = entity->getDataMask();
+
+				// the neighbour entities usually have the same data types
+				if (maskGroup == NULL || maskGroup->getDataMask() != mask)
+					maskGroup = getMaskGroup(mask);
+
+				maskGroup->addEntity(entity, depth);
+			}
+
+			count += m_sortDepth[depth].count();
+		}
+
+		m_needUpdateMaskGroups = false;
+	}
+
 	CEntity* CEntityManager::createEntity()
 	{
 		if (m_unused.size() > 0)
@@ -261,20 +371,48 @@ namespace Skylicht
 			m_sortDepth[i].reset();
 		}
 
+		m_entityDepth.set_used(numEntity);
+		int* entityDepth = m_entityDepth.pointer();
+		for (u32 i = 0; i < numEntity; i++)
+			entityDepth[i] = -1;
+
 		for (u32 i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
 
 			if (entity->isAlive())
 			{
-				CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+				// walk up the parent (or attach parent) chain until a known depth
+				// an entity attached to an attached entity must be deeper than its parent
+				int depth = -1;
+				int index = (int)i;
 
-				int depth = world->Depth;
-				if (world->AttachParentIndex >= 0)
+				m_depthStack.reset();
+				while (index >= 0 && (depth = entityDepth[index]) < 0)
 				{
-					CEntity* parent = m_entities[world->AttachParentIndex];
-					CWorldTransformData* parentWorld = GET_ENTITY_DATA(parent, CWorldTransformData);
-					depth = parentWorld->Depth + 1;
+					// the parent is removed
+					CWorldTransformData* world = GET_ENTITY_DATA(entities[index], CWorldTransformData);
+					if (world == NULL)
+						break;
+
+					m_depthStack.push(index);
+					if (m_depthStack.count() >= MAX_ENTITY_DEPTH)
+						break;
+
+					index = world->AttachParentIndex >= 0 ? world->AttachParentIndex : world->ParentIndex;
+				}
+
+				int* stack = m_depthStack.pointer();
+				for (int j = (int)m_depthStack.count() - 1; j >= 0; j--)
+				{
+					// the top of chain keeps its depth
+					if (depth < 0)
+						depth = GET_ENTITY_DATA(entities[stack[j]], CWorldTransformData)->Depth;
+					else
+						depth = depth + 1;
+
+					depth = core::clamp(depth, 0, MAX_ENTITY_DEPTH - 1);
+					entityDepth[stack[j]] = depth;
 				}
 
 				m_sortDepth[depth].push(entity);
@@ -319,6 +457,13 @@ namespace Skylicht
 		} customLess;
 
 		std::sort(m_sortUpdate.begin(), m_sortUpdate.end(), customLess);
+
+		for (SkylichtSystem::CJobGroup* job : m_systemJobs)
+			delete job;
+		m_systemJobs.clear();
+
+		for (size_t i = 0, n = m_sortUpdate.size(); i < n; i++)
+			m_systemJobs.push_back(new SkylichtSystem::CJobGroup());
 	}
 
 	void CEntityManager::update()
@@ -336,6 +481,9 @@ namespace Skylicht
 		if (m_needSortEntities)
 			sortAliveEntities();
 
+		if (m_dataPoolMode && m_needUpdateMaskGroups)
+			updateMaskGroups();
+
 		CEntity** entities = m_alives.pointer();
 		int numEntity = (int)m_alives.size();
 
@@ -348,6 +496,13 @@ namespace Skylicht
 				g->onQuery(this, entities, numEntity);
 		}
 
+		SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+		if (m_parallelUpdate && jobSystem->getWorkerCount() > 0)
+		{
+			updateSystemsParallel(entities, numEntity);
+			return;
+		}
+
 		for (IEntitySystem*& s : m_sortUpdate)
 		{
 			// note: Render system will be updated in cullingAndRender function
@@ -359,6 +514,51 @@ namespace Skylicht
 		}
 	}
 
+	void CEntityManager::updateSystemsParallel(CEntity** entities, int numEntity)
+	{
+		SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+
+		std::vector<int> running;
+
+		for (int i = 0, n = (int)m_sortUpdate.size(); i < n; i++)
+		{
+			IEntitySystem* s = m_sortUpdate[i];
+
+			// note: Render system will be updated in cullingAndRender function
+			if (s->isRenderSystem())
+				continue;
+
+			if (!s->haveDataDependency())
+			{
+				// unknown dependency, wait all running systems
+				for (int j : running)
+					jobSystem->wait(m_systemJobs[j]);
+				running.clear();
+
+				s->onQuery(this, entities, numEntity);
+				s->update(this);
+				continue;
+			}
+
+			// wait the systems that read/write the same data
+			for (int j : running)
+			{
+				if (s->isConflict(m_sortUpdate[j]))
+					jobSystem->wait(m_systemJobs[j]);
+			}
+
+			running.push_back(i);
+			jobSystem->run(m_systemJobs[i], [this, s, entities, numEntity]()
+				{
+					s->onQuery(this, entities, numEntity);
+					s->update(this);
+				});
+		}
+
+		for (int j : running)
+			jobSystem->wait(m_systemJobs[j]);
+	}
+
 	void CEntityManager::sortRenderer()
 	{
 		m_sortRender = m_renders;
@@ -592,6 +792,7 @@ namespace Skylicht
 	void CEntityManager::notifyUpdateSortEntities()
 	{
 		m_needSortEntities = true;
+		m_needUpdateMaskGroups = true;
 
 		u32 count = m_groups.size();
 		for (u32 i = 0; i < count; i++)
@@ -602,6 +803,8 @@ namespace Skylicht
 
 	void CEntityManager::notifyUpdateGroup(u32 dataType)
 	{
+		m_needUpdateMaskGroups = true;
+
 		u32 count = m_groups.size();
 		for (u32 i = 0; i < count; i++)
 		{
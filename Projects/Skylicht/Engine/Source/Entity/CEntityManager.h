@@ -28,10 +28,14 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "IRenderSystem.h"
 #include "CEntity.h"
 #include "CEntityGroup.h"
+#include "CEntityMaskGroup.h"
+#include "CEntityDataPool.h"
 
 #include "GameObject/CGameObject.h"
 #include "Camera/CCamera.h"
 
+#include "Job/CJobSystem.h"
+
 #define MAX_ENTITY_DEPTH 256
 
 namespace Skylicht
@@ -47,15 +51,30 @@ namespace Skylicht
 
 		CFastArray<CEntity*> m_sortDepth[MAX_ENTITY_DEPTH];
 
+		// the update depth of each entity (index by entity index), see sortAliveEntities
+		core::array<int> m_entityDepth;
+		CFastArray<int> m_depthStack;
+
 		std::vector<IEntitySystem*> m_systems;
 		std::vector<IRenderSystem*> m_renders;
 
 		std::vector<IEntitySystem*> m_sortUpdate;
 		std::vector<IRenderSystem*> m_sortRender;
 
+		std::vector<SkylichtSystem::CJobGroup*> m_systemJobs;
+
 		bool m_systemChanged;
+		bool m_parallelUpdate;
 		bool m_needSortEntities;
 
+		bool m_dataPoolMode;
+		bool m_needUpdateMaskGroups;
+
+		core::array<CEntityMaskGroup*> m_maskGroups;
+		std::map<u64, CEntityMaskGroup*> m_maskGroupMap;
+
+		CEntityDataPool* m_dataPools[MAX_ENTITY_DATA];
+
 		CCamera* m_camera;
 
 		IRenderPipeline* m_renderPipeline;
@@ -77,8 +96,45 @@ namespace Skylicht
 
 		void sortAliveEntities();
 
+		void updateSystemsParallel(CEntity** entities, int numEntity);
+
+		void updateMaskGroups();
+
 	public:
 
+		// The systems that declared read/write data types (see IEntitySystem::readDataType)
+		// will be updated on job system if they are not conflict
+		inline void setParallelUpdate(bool b)
+		{
+			m_parallelUpdate = b;
+		}
+
+		inline bool isParallelUpdate()
+		{
+			return m_parallelUpdate;
+		}
+
+		// In data pool mode, entity data are allocated on a chunk pool per data type
+		// and the alive entities are grouped by their data mask (see CEntityMaskGroup)
+		// GET_ENTITY_DATA still works on all entities
+		// This is not an archetype storage (SoA): the data are not moved to columns, because the systems keep the pointers
+		// of the data (ex: CWorldTransformData::Parent), so the mask group only keeps the data pointers
+		void setDataPoolMode(bool b);
+
+		inline bool isDataPoolMode()
+		{
+			return m_dataPoolMode;
+		}
+
+		inline core::array<CEntityMaskGroup*>& getMaskGroups()
+		{
+			return m_maskGroups;
+		}
+
+		CEntityMaskGroup* getMaskGroup(u64 dataMask);
+
+		CEntityDataPool* getDataPool(u32 dataType, u32 dataSize);
+
 		inline void setCamera(CCamera* camera)
 		{
 			m_camera = camera;
@@ -109,6 +165,8 @@ namespace Skylicht
 
 		void releaseAllGroups();
 
+		void releaseAllMaskGroups();
+
 		inline int getNumEntities()
 		{
 			return (int)m_entities.size();
@@ -126,6 +184,13 @@ namespace Skylicht
 
 		CEntity* getEntityByID(const char* id);
 
+		// the depth follows the attach parent and the parent chain, so an entity is always
+		// updated after the transform that it depends on (valid after sortAliveEntities)
+		inline int getEntityDepth(int index)
+		{
+			return m_entityDepth[index];
+		}
+
 		void removeEntity(int index);
 
 		void removeEntity(CEntity* entity);
@@ -0,0 +1,82 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CEntityMaskGroup.h"
+
+namespace Skylicht
+{
+	CEntityMaskGroup::CEntityMaskGroup(u64 dataMask) :
+		m_dataMask(dataMask)
+	{
+		for (u32 i = 0; i < MAX_ENTITY_DATA; i++)
+		{
+			if (m_dataMask & ((u64)1 << i))
+			{
+				m_dataTypes.push_back(i);
+				m_dataPointers[i] = new CFastArray<IEntityData*>();
+			}
+			else
+			{
+				m_dataPointers[i] = NULL;
+			}
+		}
+	}
+
+	CEntityMaskGroup::~CEntityMaskGroup()
+	{
+		for (u32 i = 0; i < MAX_ENTITY_DATA; i++)
+		{
+			if (m_dataPointers[i])
+				delete m_dataPointers[i];
+		}
+	}
+
+	void CEntityMaskGroup::reset()
+	{
+		m_entities.reset();
+		m_depthEnd.set_used(0);
+
+		u32* types = m_dataTypes.pointer();
+		for (u32 i = 0, n = m_dataTypes.size(); i < n; i++)
+			m_dataPointers[types[i]]->reset();
+	}
+
+	void CEntityMaskGroup::addEntity(CEntity* entity, int depth)
+	{
+		m_entities.push(entity);
+
+		// the empty depths have the same end
+		while ((int)m_depthEnd.size() <= depth)
+			m_depthEnd.push_back(m_entities.count() - 1);
+		m_depthEnd[depth] = m_entities.count();
+
+		u32* types = m_dataTypes.pointer();
+		for (u32 i = 0, n = m_dataTypes.size(); i < n; i++)
+		{
+			u32 type = types[i];
+			m_dataPointers[type]->push(entity->Data[type]);
+		}
+	}
+}
@@ -0,0 +1,103 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CEntity.h"
+#include "CArrayUtils.h"
+
+namespace Skylicht
+{
+	// The list of entities have the same set of data types (data mask), sorted by the depth
+	// The data stay in the pool (see CEntityDataPool), the group only keeps
+	// the pointers to the data of each type in the same order of entities
+	class SKYLICHT_API CEntityMaskGroup
+	{
+	protected:
+		u64 m_dataMask;
+
+		core::array<u32> m_dataTypes;
+
+		CFastArray<CEntity*> m_entities;
+
+		// m_depthEnd[i] is the end of the entities at depth i
+		core::array<int> m_depthEnd;
+
+		CFastArray<IEntityData*>* m_dataPointers[MAX_ENTITY_DATA];
+
+	public:
+		CEntityMaskGroup(u64 dataMask);
+
+		virtual ~CEntityMaskGroup();
+
+		void reset();
+
+		// the entities must be added by the order of depth
+		void addEntity(CEntity* entity, int depth);
+
+		inline u64 getDataMask()
+		{
+			return m_dataMask;
+		}
+
+		inline bool haveDataMask(u64 mask)
+		{
+			return (m_dataMask & mask) == mask;
+		}
+
+		inline core::array<u32>& getDataTypes()
+		{
+			return m_dataTypes;
+		}
+
+		inline CEntity** getEntities()
+		{
+			return m_entities.pointer();
+		}
+
+		inline int getEntityCount()
+		{
+			return m_entities.count();
+		}
+
+		inline int getDepthCount()
+		{
+			return (int)m_depthEnd.size();
+		}
+
+		inline void getDepthRange(int depth, int& begin, int& end)
+		{
+			begin = depth == 0 ? 0 : m_depthEnd[depth - 1];
+			end = m_depthEnd[depth];
+		}
+
+		inline IEntityData** getDataPointers(u32 dataType)
+		{
+			CFastArray<IEntityData*>* pointers = m_dataPointers[dataType];
+			if (pointers == NULL)
+				return NULL;
+			return pointers->pointer();
+		}
+	};
+}
@@ -35,9 +35,20 @@ namespace Skylicht
 	protected:
 		int m_systemOrder;
 
+		// the data types that system read/write in update
+		// that is used for schedule the systems in parallel, see CEntityManager::update
+		u64 m_readDataMask;
+		u64 m_writeDataMask;
+		u64 m_writeFieldMask;
+		bool m_declareDataDependency;
+
 	public:
 		IEntitySystem() :
-			m_systemOrder(0)
+			m_systemOrder(0),
+			m_readDataMask(0),
+			m_writeDataMask(0),
+			m_writeFieldMask(0),
+			m_declareDataDependency(false)
 		{
 		}
 
@@ -68,5 +79,59 @@ namespace Skylicht
 		{
 			return m_systemOrder;
 		}
+
+		inline void readDataType(u32 dataType)
+		{
+			m_readDataMask |= (1ULL << dataType);
+			m_declareDataDependency = true;
+		}
+
+		inline void writeDataType(u32 dataType)
+		{
+			m_writeDataMask |= (1ULL << dataType);
+			m_declareDataDependency = true;
+		}
+
+		// the system only writes some fields of the data, that the other systems do not read/write
+		// so the systems that write the different fields of the same data type can run in parallel
+		inline void writeDataTypeFields(u32 dataType)
+		{
+			m_writeFieldMask |= (1ULL << dataType);
+			m_declareDataDependency = true;
+		}
+
+		inline u64 getReadDataMask()
+		{
+			return m_readDataMask;
+		}
+
+		inline u64 getWriteDataMask()
+		{
+			return m_writeDataMask;
+		}
+
+		// the system that do not declare the dependency will run alone (after all previous systems finish)
+		inline bool haveDataDependency()
+		{
+			return m_declareDataDependency;
+		}
+
+		inline u64 getWriteFieldMask()
+		{
+			return m_writeFieldMask;
+		}
+
+		bool isConflict(IEntitySystem* system)
+		{
+			if (m_writeDataMask & (system->m_readDataMask | system->m_writeDataMask | system->m_writeFieldMask))
+				return true;
+			if (system->m_writeDataMask & (m_readDataMask | m_writeFieldMask))
+				return true;
+			if (m_writeFieldMask & system->m_readDataMask)
+				return true;
+			if (system->m_writeFieldMask & m_readDataMask)
+				return true;
+			return false;
+		}
 	};
 }
\ No newline at end of file
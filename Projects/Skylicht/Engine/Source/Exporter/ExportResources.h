@@ -30,7 +30,8 @@ namespace Skylicht
 	{
 		Unknown = 0,
 		AssetModel,
-		AssetAnimation
+		AssetAnimation,
+		AssetScene
 	};
 
 	struct SAssetHeader
@@ -54,9 +54,14 @@ namespace Skylicht
 		SAssetHeader assetHeader;
 		strcpy(assetHeader.Sign, "SLT");
 		assetHeader.AssetType = (u32)AssetAnimation;
-		assetHeader.AssetVersion = 1;
+		// version 2: compressed clip
+		// version 3: the key frames are aligned array, that is read by one copy
+		bool compressed = clip->isCompressed();
+		assetHeader.AssetVersion = compressed ? 2 : 3;
 		writeFile->write(&assetHeader, sizeof(SAssetHeader));
 
+		u32 fileOffset = sizeof(SAssetHeader);
+
 		// init memory (it will grow later)
 		CMemoryStream memoryAnim(512);
 
@@ -69,6 +74,7 @@ namespace Skylicht
 
 		// flush to file
 		writeFile->write(memoryAnim.getData(), memoryAnim.getSize());
+		fileOffset += memoryAnim.getSize();
 
 		for (u32 i = 0; i < count; i++)
 		{
@@ -77,6 +83,19 @@ namespace Skylicht
 			memoryAnim.resetWrite();
 			memoryAnim.writeString(entityAnim->Name);
 
+			if (compressed)
+			{
+				memoryAnim.writeFloatArray(&entityAnim->Data.Positions.Default.X, 3);
+				memoryAnim.writeFloatArray(&entityAnim->Data.Rotations.Default.X, 4);
+				memoryAnim.writeFloatArray(&entityAnim->Data.Scales.Default.X, 3);
+
+				entityAnim->Data.Compressed.write(&memoryAnim);
+
+				writeFile->write(memoryAnim.getData(), memoryAnim.getSize());
+				fileOffset += memoryAnim.getSize();
+				continue;
+			}
+
 			// position
 			CArrayKeyFrame<core::vector3df>& positions = entityAnim->Data.Positions;
 
@@ -85,12 +104,8 @@ namespace Skylicht
 			u32 numKey = positions.size();
 			memoryAnim.writeUInt(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				const CPositionKey& posKey = positions.Data[j];
-				memoryAnim.writeFloat(posKey.Frame);
-				memoryAnim.writeFloatArray(&posKey.Value.X, 3);
-			}
+			memoryAnim.writeAlign(16, fileOffset);
+			memoryAnim.writeData(positions.Data.const_pointer(), numKey * sizeof(CPositionKey));
 
 			// rotation
 			CArrayKeyFrame<core::quaternion>& rotations = entityAnim->Data.Rotations;
@@ -100,12 +115,8 @@ namespace Skylicht
 			numKey = rotations.size();
 			memoryAnim.writeUInt(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				const CRotationKey& rotKey = rotations.Data[j];
-				memoryAnim.writeFloat(rotKey.Frame);
-				memoryAnim.writeFloatArray(&rotKey.Value.X, 4);
-			}
+			memoryAnim.writeAlign(16, fileOffset);
+			memoryAnim.writeData(rotations.Data.const_pointer(), numKey * sizeof(CRotationKey));
 
 			// scale
 			CArrayKeyFrame<core::vector3df>& scales = entityAnim->Data.Scales;
@@ -115,15 +126,12 @@ namespace Skylicht
 			numKey = scales.size();
 			memoryAnim.writeUInt(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				const CScaleKey& scaleKey = scales.Data[j];
-				memoryAnim.writeFloat(scaleKey.Frame);
-				memoryAnim.writeFloatArray(&scaleKey.Value.X, 3);
-			}
+			memoryAnim.writeAlign(16, fileOffset);
+			memoryAnim.writeData(scales.Data.const_pointer(), numKey * sizeof(CScaleKey));
 
 			// flush data to file
 			writeFile->write(memoryAnim.getData(), memoryAnim.getSize());
+			fileOffset += memoryAnim.getSize();
 		}
 
 		writeFile->drop();
@@ -54,12 +54,15 @@ namespace Skylicht
 		SAssetHeader assetHeader;
 		strcpy(assetHeader.Sign, "SLT");
 		assetHeader.AssetType = (u32)AssetModel;
-		assetHeader.AssetVersion = 1;
+		// version 2: the entity data is aligned, so the vertex and index blocks can be read from the mapped file
+		assetHeader.AssetVersion = 2;
 		writeFile->write(&assetHeader, sizeof(SAssetHeader));
 
 		// write num of entities
 		writeFile->write(&count, sizeof(u32));
 
+		u32 fileOffset = sizeof(SAssetHeader) + sizeof(u32);
+
 		// init memory (it will grow later)
 		CMemoryStream memoryEntity(512);
 		CMemoryStream memoryData(512);
@@ -104,6 +107,9 @@ namespace Skylicht
 					// name					
 					memoryEntity.writeString(typeName);
 
+					// align data
+					memoryEntity.writeAlign(16, fileOffset);
+
 					// data
 					memoryEntity.writeStream(&memoryData);
 				}
@@ -122,6 +128,7 @@ namespace Skylicht
 
 			// flush data to file
 			writeFile->write(memoryEntity.getData(), memoryEntity.getSize());
+			fileOffset += memoryEntity.getSize();
 		}
 
 		writeFile->drop();
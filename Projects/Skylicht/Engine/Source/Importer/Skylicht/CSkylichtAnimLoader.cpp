@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Exporter/ExportResources.h"
 
 #include "Utils/CMemoryStream.h"
+#include "Utils/CMappedFile.h"
 #include "Animation/CAnimationClip.h"
 
 namespace Skylicht
@@ -44,46 +45,28 @@ namespace Skylicht
 
 	bool CSkylichtAnimLoader::loadAnimation(const char* resource, CAnimationClip* output)
 	{
-		IrrlichtDevice* device = getIrrlichtDevice();
-		io::IFileSystem* fs = device->getFileSystem();
-
-		io::IReadFile* readFile = fs->createAndOpenFile(resource);
-		if (readFile == NULL)
+		// map the file, the data is read without copy to the temp buffer
+		CMappedFile file;
+		if (!file.open(resource))
 			return false;
 
-		u32 size = readFile->getSize();
-
-		unsigned char* data = new unsigned char[size];
-		readFile->read(data, size);
-		readFile->drop();
-
-		CMemoryStream stream(data, size);
+		CMemoryStream stream(file.getData(), file.getSize());
 
 		// read header
 		SAssetHeader assetHeader;
 		stream.readData(&assetHeader, sizeof(SAssetHeader));
 
 		if (strcmp(assetHeader.Sign, "SLT") != 0)
-		{
-			delete[] data;
 			return false;
-		}
 
 		if (assetHeader.AssetType != (u32)AssetAnimation)
-		{
-			delete[] data;
 			return false;
-		}
 
-		if (assetHeader.AssetVersion == 1)
+		if (assetHeader.AssetVersion >= 1 && assetHeader.AssetVersion <= 3)
 			loadVersion(&stream, output, assetHeader.AssetVersion);
 		else
-		{
-			delete[] data;
 			return false;
-		}
 
-		delete[] data;
 		return true;
 	}
 
@@ -100,6 +83,19 @@ namespace Skylicht
 			SEntityAnim* entityAnim = new SEntityAnim();
 			entityAnim->Name = stream->readString();
 
+			if (version == 2)
+			{
+				// compressed clip
+				stream->readFloatArray(&entityAnim->Data.Positions.Default.X, 3);
+				stream->readFloatArray(&entityAnim->Data.Rotations.Default.X, 4);
+				stream->readFloatArray(&entityAnim->Data.Scales.Default.X, 3);
+
+				entityAnim->Data.Compressed.read(stream);
+
+				output->addAnim(entityAnim);
+				continue;
+			}
+
 			// positions
 			CArrayKeyFrame<core::vector3df>& positions = entityAnim->Data.Positions;
 
@@ -108,11 +104,19 @@ namespace Skylicht
 			u32 numKey = stream->readUInt();
 			positions.Data.set_used(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
+			if (version == 3)
+			{
+				stream->readAlign(16);
+				stream->readData(positions.Data.pointer(), numKey * sizeof(CPositionKey));
+			}
+			else
 			{
-				CPositionKey& posKey = positions.Data[j];
-				posKey.Frame = stream->readFloat();
-				stream->readFloatArray(&posKey.Value.X, 3);
+				for (u32 j = 0; j < numKey; j++)
+				{
+					CPositionKey& posKey = positions.Data[j];
+					posKey.Frame = stream->readFloat();
+					stream->readFloatArray(&posKey.Value.X, 3);
+				}
 			}
 
 			// rotations
@@ -123,11 +127,19 @@ namespace Skylicht
 			numKey = stream->readUInt();
 			rotations.Data.set_used(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
+			if (version == 3)
+			{
+				stream->readAlign(16);
+				stream->readData(rotations.Data.pointer(), numKey * sizeof(CRotationKey));
+			}
+			else
 			{
-				CRotationKey& rotKey = rotations.Data[j];
-				rotKey.Frame = stream->readFloat();
-				stream->readFloatArray(&rotKey.Value.X, 4);
+				for (u32 j = 0; j < numKey; j++)
+				{
+					CRotationKey& rotKey = rotations.Data[j];
+					rotKey.Frame = stream->readFloat();
+					stream->readFloatArray(&rotKey.Value.X, 4);
+				}
 			}
 
 			// scales
@@ -138,11 +150,19 @@ namespace Skylicht
 			numKey = stream->readUInt();
 			scales.Data.set_used(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
+			if (version == 3)
+			{
+				stream->readAlign(16);
+				stream->readData(scales.Data.pointer(), numKey * sizeof(CScaleKey));
+			}
+			else
 			{
-				CScaleKey& scaleKey = scales.Data[j];
-				scaleKey.Frame = stream->readFloat();
-				stream->readFloatArray(&scaleKey.Value.X, 3);
+				for (u32 j = 0; j < numKey; j++)
+				{
+					CScaleKey& scaleKey = scales.Data[j];
+					scaleKey.Frame = stream->readFloat();
+					stream->readFloatArray(&scaleKey.Value.X, 3);
+				}
 			}
 
 			output->addAnim(entityAnim);
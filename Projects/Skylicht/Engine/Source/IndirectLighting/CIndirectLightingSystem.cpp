@@ -34,6 +34,12 @@ namespace Skylicht
 		m_groupProbes(NULL)
 	{
 		m_kdtree = kd_create(3);
+
+		readDataType(DATA_TYPE_INDEX(CWorldTransformData));
+		writeDataType(DATA_TYPE_INDEX(CLightProbeData));
+
+		// SH & InvalidateProbe, so it can run with CReflectionProbeSystem
+		writeDataTypeFields(DATA_TYPE_INDEX(CIndirectLightingData));
 	}
 
 	CIndirectLightingSystem::~CIndirectLightingSystem()
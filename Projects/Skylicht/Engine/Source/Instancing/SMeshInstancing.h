@@ -69,6 +69,10 @@ namespace Skylicht
 		// the group, that have many instance will be render
 		SMeshInstancingGroup* InstancingGroup;
 
+		// number of CRenderMeshData instancing that use this data (see CMeshRendererInstancing)
+		// so CMeshRenderer must not batch it to the shared TransformBuffer
+		int InstancingRendererCount;
+
 		// That tell us that, transform and lighting buffer is shared with another Mesh
 		bool UseShareTransformBuffer;
 		bool UseShareMaterialsBuffer;
@@ -83,6 +87,7 @@ namespace Skylicht
 			TransformBuffer = NULL;
 			IndirectLightingBuffer = NULL;
 			InstancingGroup = NULL;
+			InstancingRendererCount = 0;
 			UseShareTransformBuffer = false;
 			UseShareMaterialsBuffer = false;
 			ShareDataTransform = NULL;
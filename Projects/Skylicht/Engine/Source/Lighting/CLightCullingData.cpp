@@ -32,7 +32,8 @@ namespace Skylicht
 	CLightCullingData::CLightCullingData() :
 		Visible(true),
 		Light(NULL),
-		CameraDistance(0.0f)
+		CameraDistance(0.0f),
+		TreeProxy(-1)
 	{
 
 	}
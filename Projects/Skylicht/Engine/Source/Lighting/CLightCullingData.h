@@ -41,6 +41,9 @@ namespace Skylicht
 
 		float CameraDistance;
 
+		// the proxy on CLightCullingSystem spatial tree
+		int TreeProxy;
+
 	public:
 		CLightCullingData();
 
@@ -27,11 +27,13 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Culling/CVisibleData.h"
 #include "Entity/CEntityManager.h"
 #include "Material/Shader/CShaderManager.h"
+#include "Culling/CCullingSystem.h"
 
 namespace Skylicht
 {
 	CLightCullingSystem::CLightCullingSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_treeTag(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
@@ -59,6 +61,9 @@ namespace Skylicht
 		entities = m_group->getEntities();
 		numEntity = m_group->getEntityCount();
 
+		bool useTree = CCullingSystem::useCullingTree();
+		m_treeTag++;
+
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
@@ -70,6 +75,40 @@ namespace Skylicht
 			m_cullings.push_back(culling);
 			m_transforms.push_back(transform);
 			m_invTransforms.push_back(invTransform);
+
+			if (useTree)
+			{
+				// update the proxy only when the light is moved or the bbox is changed (see CCullingSystem::addCullingBox)
+				int proxy = culling->TreeProxy;
+				bool isProxy = m_tree.isProxyOf(proxy, culling);
+
+				if (!isProxy || m_tree.isChanged(proxy, culling->BBox, transform->World))
+				{
+					core::aabbox3df lightBox = culling->BBox;
+					transform->World.transformBoxEx(lightBox);
+
+					if (isProxy)
+						m_tree.moveProxy(proxy, lightBox, culling->BBox, transform->World);
+					else
+					{
+						proxy = m_tree.createProxy(lightBox, culling->BBox, culling, i, transform->World);
+						culling->TreeProxy = proxy;
+					}
+				}
+
+				m_tree.setUserData(proxy, i);
+				m_tree.setTag(proxy, m_treeTag);
+			}
+		}
+
+		if (useTree)
+		{
+			if (m_tree.getProxyCount() != numEntity)
+				m_tree.destroyProxies(m_treeTag);
+		}
+		else if (m_tree.getProxyCount() > 0)
+		{
+			m_tree.clear();
 		}
 	}
 
@@ -94,6 +133,23 @@ namespace Skylicht
 		core::vector3df camPos = camera->getGameObject()->getPosition();
 
 		u32 numEntity = m_cullings.size();
+
+		bool useTree = CCullingSystem::useCullingTree();
+		if (useTree)
+		{
+			// the lights that are out of camera are rejected by the tree
+			m_treeResult.reset();
+			m_tree.query(camBox, &camera->getViewFrustum(), m_treeResult);
+
+			m_inTree.set_used(numEntity);
+			if (numEntity > 0)
+				memset(m_inTree.pointer(), 0, numEntity);
+
+			int* result = m_treeResult.pointer();
+			for (int i = 0, n = m_treeResult.count(); i < n; i++)
+				m_inTree[result[i]] = 1;
+		}
+
 		for (u32 i = 0; i < numEntity; i++)
 		{
 			// get mesh bbox
@@ -101,6 +157,13 @@ namespace Skylicht
 			CWorldTransformData* transform = transforms[i];
 			CWorldInverseTransformData* invTransform = invTransforms[i];
 
+			if (useTree && m_inTree[i] == 0)
+			{
+				culling->Visible = false;
+				culling->CameraDistance = transform->World.getTranslation().getDistanceFromSQ(camPos);
+				continue;
+			}
+
 			culling->Visible = true;
 
 			// transform world bbox
@@ -29,6 +29,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityGroup.h"
 #include "Transform/CWorldTransformData.h"
 #include "Transform/CWorldInverseTransformData.h"
+#include "Culling/CCullingBVH.h"
 
 namespace Skylicht
 {
@@ -42,6 +43,12 @@ namespace Skylicht
 
 		CEntityGroup* m_group;
 
+		// spatial tree of light boxes, see CCullingSystem::useCullingTree
+		CCullingBVH m_tree;
+		CFastArray<int> m_treeResult;
+		core::array<u8> m_inTree;
+		u32 m_treeTag;
+
 	public:
 		CLightCullingSystem();
 
@@ -285,6 +285,29 @@ namespace Skylicht
 		return shader;
 	}
 
+	void CShaderManager::addShader(CShader* shader)
+	{
+		shader->grab();
+		m_listShader.push_back(shader);
+
+		const std::string& shaderName = shader->getName();
+		int materialID = shader->getMaterialRenderID();
+
+		if (shaderName.empty() == false && materialID >= 0)
+			m_listShaderID[shaderName] = materialID;
+	}
+
+	void CShaderManager::removeShader(CShader* shader)
+	{
+		auto it = std::find(m_listShader.begin(), m_listShader.end(), shader);
+		if (it == m_listShader.end())
+			return;
+
+		m_listShader.erase(it);
+		m_listShaderID.erase(shader->getName());
+		shader->drop();
+	}
+
 	int CShaderManager::getShaderIDByName(const char* name)
 	{
 		std::map<std::string, int>::iterator it = m_listShaderID.find(name);
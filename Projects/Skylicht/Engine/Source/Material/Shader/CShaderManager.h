@@ -102,6 +102,12 @@ namespace Skylicht
 		// load game shader from file config
 		CShader* loadShader(const char* shaderConfig, IShaderInstancing* instancing = NULL);
 
+		// addShader
+		// add the shader that is built by code (it is found by getShaderByPath), the manager will grab it
+		void addShader(CShader* shader);
+
+		void removeShader(CShader* shader);
+
 		int getShaderIDByName(const char* name);
 
 		CShader* getShaderByName(const char* name);
@@ -12,12 +12,15 @@
 #include "RenderMesh/CRenderMeshData.h"
 #include "Material/Shader/CShaderManager.h"
 #include "Material/Shader/CShader.h"
+#include "TextureManager/CTextureManager.h"
+#include "Job/CJobSystem.h"
 
 namespace Skylicht
 {
 	IMPLEMENT_SINGLETON(CMeshManager);
 
-	CMeshManager::CMeshManager()
+	CMeshManager::CMeshManager() :
+		m_instancingVersion(0)
 	{
 
 	}
@@ -82,6 +85,7 @@ namespace Skylicht
 			delete data;
 		}
 		m_instancingData.clear();
+		m_instancingVersion++;
 	}
 
 	CEntityPrefab* CMeshManager::loadModel(const char* resource, const char* texturePath, bool loadNormalMap, bool flipNormalMap, bool loadTexcoord2, bool createBatching)
@@ -93,55 +97,156 @@ namespace Skylicht
 			return (*findCache).second;
 		}
 
-		IMeshImporter* importer = NULL;
-		CEntityPrefab* output = NULL;
+		CEntityPrefab* output = importModel(resource, texturePath, loadNormalMap, flipNormalMap, loadTexcoord2, createBatching);
 
-		// load from file
-		std::string ext = CPath::getFileNameExt(resource);
-		if (ext == "dae")
-			importer = new CColladaLoader();
-		else if (ext == "obj")
-			importer = new COBJMeshFileLoader();
-		else if (ext == "smesh")
-			importer = new CSkylichtMeshLoader();
-		else if (ext == "fbx")
-			importer = new CFBXMeshLoader();
+		// cached resource
+		if (output != NULL)
+			m_meshPrefabs[resource] = output;
 
-		if (importer != NULL)
+		return output;
+	}
+
+	void CMeshManager::loadModels(const std::vector<std::string>& resources, std::vector<CEntityPrefab*>& output, const char* texturePath, bool loadNormalMap, bool flipNormalMap, bool loadTexcoord2, bool createBatching)
+	{
+		struct SImportJob
 		{
-			output = new CEntityPrefab();
+			std::string Resource;
+			CEntityPrefab* Prefab;
+		};
 
-			// add search texture path
-			if (texturePath != NULL)
-				importer->addTextureFolder(texturePath);
+		u32 numResource = (u32)resources.size();
+		output.resize(numResource);
 
-			// add base folder path
-			std::string baseFolderPath = CPath::getFolderPath(resource);
-			importer->addTextureFolder(baseFolderPath.c_str());
+		// the same resource is imported only once
+		std::map<std::string, u32> jobIndex;
+		std::vector<u32> resourceJob(numResource, 0);
+		std::vector<SImportJob> jobs;
+		jobs.reserve(numResource);
 
-			// hard code list folder
-			CRenderMeshData::setImportTextureFolder(importer->getTextureFolder());
+		for (u32 i = 0; i < numResource; i++)
+		{
+			const std::string& resource = resources[i];
+			output[i] = NULL;
 
-			// load model
-			if (importer->loadModel(resource, output, loadNormalMap, flipNormalMap, loadTexcoord2, createBatching) == true)
+			std::map<std::string, CEntityPrefab*>::iterator findCache = m_meshPrefabs.find(resource);
+			if (findCache != m_meshPrefabs.end())
 			{
-				// cached resource
-				m_meshPrefabs[resource] = output;
+				output[i] = (*findCache).second;
+				resourceJob[i] = (u32)-1;
+				continue;
 			}
-			else
+
+			std::map<std::string, u32>::iterator findJob = jobIndex.find(resource);
+			if (findJob != jobIndex.end())
 			{
-				// load failed!
-				delete output;
-				output = NULL;
+				resourceJob[i] = findJob->second;
+				continue;
 			}
 
-			// clear cache load model
-			delete importer;
+			SImportJob job;
+			job.Resource = resource;
+			job.Prefab = NULL;
+
+			resourceJob[i] = (u32)jobs.size();
+			jobIndex[resource] = (u32)jobs.size();
+			jobs.push_back(job);
 		}
 
+		std::string textureFolder = texturePath != NULL ? texturePath : "";
+
+		SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+		SkylichtSystem::CJobGroup group;
+
+		for (SImportJob& job : jobs)
+		{
+			SImportJob* j = &job;
+			jobSystem->run(&group, [this, j, &textureFolder, loadNormalMap, flipNormalMap, loadTexcoord2, createBatching]()
+				{
+					j->Prefab = importModel(j->Resource.c_str(), textureFolder.c_str(), loadNormalMap, flipNormalMap, loadTexcoord2, createBatching);
+				});
+		}
+
+		// the main thread create the textures for the import threads
+		CTextureManager* textureMgr = CTextureManager::getInstance();
+		while (!group.isDone())
+		{
+			textureMgr->updateTextureRequest();
+			std::this_thread::yield();
+		}
+
+		// register on main thread
+		for (SImportJob& job : jobs)
+		{
+			if (job.Prefab != NULL)
+				m_meshPrefabs[job.Resource] = job.Prefab;
+		}
+
+		for (u32 i = 0; i < numResource; i++)
+		{
+			if (resourceJob[i] != (u32)-1)
+				output[i] = jobs[resourceJob[i]].Prefab;
+		}
+	}
+
+	IMeshImporter* CMeshManager::createImporter(const char* resource)
+	{
+		std::string ext = CPath::getFileNameExt(resource);
+		if (ext == "dae")
+			return new CColladaLoader();
+		else if (ext == "obj")
+			return new COBJMeshFileLoader();
+		else if (ext == "smesh")
+			return new CSkylichtMeshLoader();
+		else if (ext == "fbx")
+			return new CFBXMeshLoader();
+		return NULL;
+	}
+
+	CEntityPrefab* CMeshManager::importModel(const char* resource, const char* texturePath, bool loadNormalMap, bool flipNormalMap, bool loadTexcoord2, bool createBatching)
+	{
+		// load from file
+		IMeshImporter* importer = createImporter(resource);
+		if (importer == NULL)
+			return NULL;
+
+		CEntityPrefab* output = new CEntityPrefab();
+
+		// add search texture path
+		if (texturePath != NULL)
+			importer->addTextureFolder(texturePath);
+
+		// add base folder path
+		std::string baseFolderPath = CPath::getFolderPath(resource);
+		importer->addTextureFolder(baseFolderPath.c_str());
+
+		// hard code list folder
+		CRenderMeshData::setImportTextureFolder(importer->getTextureFolder());
+
+		// load model
+		if (importer->loadModel(resource, output, loadNormalMap, flipNormalMap, loadTexcoord2, createBatching) == false)
+		{
+			// load failed!
+			delete output;
+			output = NULL;
+		}
+
+		// clear cache load model
+		delete importer;
+
 		return output;
 	}
 
+	CEntityPrefab* CMeshManager::addPrefab(const char* resource, CEntityPrefab* prefab)
+	{
+		// the model is loaded before, caller need delete the prefab
+		std::map<std::string, CEntityPrefab*>::iterator findCache = m_meshPrefabs.find(resource);
+		if (findCache != m_meshPrefabs.end())
+			return (*findCache).second;
+
+		m_meshPrefabs[resource] = prefab;
+		return prefab;
+	}
+
 	bool CMeshManager::exportModel(CEntity** entities, u32 count, const char* output)
 	{
 		IMeshExporter* exporter = NULL;
@@ -4,6 +4,7 @@
 #include "Entity/CEntityPrefab.h"
 #include "Utils/CSingleton.h"
 #include "Instancing/SMeshInstancing.h"
+#include "Importer/IMeshImporter.h"
 
 namespace Skylicht
 {
@@ -17,6 +18,8 @@ namespace Skylicht
 
 		std::vector<SMeshInstancing*> m_instancingData;
 
+		u32 m_instancingVersion;
+
 	public:
 		CMeshManager();
 
@@ -24,14 +27,26 @@ namespace Skylicht
 
 		CEntityPrefab* loadModel(const char* resource, const char* texturePath, bool loadNormalMap = true, bool flipNormalMap = true, bool loadTexcoord2 = false, bool createBatching = false);
 
+		// parse the models on CJobSystem threads, then register the prefabs on main thread
+		// the output[i] is the prefab of resources[i], it is NULL if the model is failed to load
+		void loadModels(const std::vector<std::string>& resources, std::vector<CEntityPrefab*>& output, const char* texturePath, bool loadNormalMap = true, bool flipNormalMap = true, bool loadTexcoord2 = false, bool createBatching = false);
+
 		bool exportModel(CEntity** entities, u32 count, const char* output);
 
+		CEntityPrefab* addPrefab(const char* resource, CEntityPrefab* prefab);
+
 		void releasePrefab(CEntityPrefab* prefab);
 
 		void releaseAllPrefabs();
 
 		void releaseAllInstancingMesh();
 
+		// it is increased when the instancing data is released, the cached SMeshInstancing pointers are invalid
+		inline u32 getInstancingVersion()
+		{
+			return m_instancingVersion;
+		}
+
 		SMeshInstancing* createGetInstancingMesh(CMesh* mesh);
 
 		SMeshInstancing* createGetInstancingMesh(CMesh* mesh, IShaderInstancing* shaderInstancing);
@@ -42,6 +57,10 @@ namespace Skylicht
 
 	protected:
 
+		IMeshImporter* createImporter(const char* resource);
+
+		CEntityPrefab* importModel(const char* resource, const char* texturePath, bool loadNormalMap, bool flipNormalMap, bool loadTexcoord2, bool createBatching);
+
 		bool canCreateInstancingMesh(CMesh* mesh);
 
 		bool compareMeshBuffer(CMesh* mesh, SMeshInstancing* data);
@@ -32,7 +32,9 @@ namespace Skylicht
 	CJointAnimationSystem::CJointAnimationSystem() :
 		m_group(NULL)
 	{
-
+		readDataType(DATA_TYPE_INDEX(CWorldTransformData));
+		readDataType(DATA_TYPE_INDEX(CWorldInverseTransformData));
+		writeDataType(DATA_TYPE_INDEX(CJointData));
 	}
 
 	CJointAnimationSystem::~CJointAnimationSystem()
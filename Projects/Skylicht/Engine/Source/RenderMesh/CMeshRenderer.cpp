@@ -27,30 +27,89 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Culling/CCullingData.h"
 #include "Entity/CEntityManager.h"
+#include "RenderPipeline/CRenderStateCache.h"
 
 #include "Material/Shader/ShaderCallback/CShaderSH.h"
 #include "Material/Shader/ShaderCallback/CShaderLighting.h"
+#include "Material/Shader/ShaderCallback/CShaderMaterial.h"
+#include "MeshManager/CMeshManager.h"
 
 namespace Skylicht
 {
-	CMeshRenderer::CMeshRenderer()
+	CMeshRenderer::CMeshRenderer() :
+		m_cameraFar(1.0f),
+		m_enableInstancing(true),
+		m_supportInstancing(false),
+		m_minInstancing(4),
+		m_instancingVersion(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
 
 	CMeshRenderer::~CMeshRenderer()
 	{
+		releaseInstancingCache();
+	}
+
+	void CMeshRenderer::releaseInstancingCache()
+	{
+		for (auto it : m_instancingMeshs)
+			it.first->drop();
+		m_instancingMeshs.clear();
+
+		for (auto it : m_instancingGroups)
+			delete it.second;
+		m_instancingGroups.clear();
+
+		m_activeGroups.set_used(0);
+	}
 
+	void CMeshRenderer::removeUnusedInstancingMesh()
+	{
+		auto it = m_instancingMeshs.begin();
+		while (it != m_instancingMeshs.end())
+		{
+			CMesh* mesh = it->first;
+			if (mesh->getReferenceCount() == 1)
+			{
+				// the mesh is released by all the entities
+				mesh->drop();
+				it = m_instancingMeshs.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
 	}
 
 	void CMeshRenderer::beginQuery(CEntityManager* entityManager)
 	{
 		m_meshs.set_used(0);
+		m_queue.reset();
+		m_instancingQueue.reset();
+
+		for (u32 i = 0, n = m_activeGroups.size(); i < n; i++)
+		{
+			m_activeGroups[i]->Group.Entities.reset();
+			m_activeGroups[i]->Objects.reset();
+		}
+		m_activeGroups.set_used(0);
+
+		// the instancing data is deleted by CMeshManager
+		u32 version = CMeshManager::getInstance()->getInstancingVersion();
+		if (m_instancingVersion != version)
+		{
+			releaseInstancingCache();
+			m_instancingVersion = version;
+		}
+
+		removeUnusedInstancingMesh();
 
 		CMeshRenderSystem::beginQuery(entityManager);
 	}
 
-	void CMeshRenderer::addToListMesh(CEntity** entities, int numEntity)
+	void CMeshRenderer::addToListMesh(CEntity** entities, int numEntity, bool instancing)
 	{
 		for (int i = 0; i < numEntity; i++)
 		{
@@ -66,19 +125,75 @@ namespace Skylicht
 				cullingVisible = cullingData->Visible;
 
 			// only render visible culling mesh
-			if (cullingVisible == true)
-				m_meshs.push_back(meshData);
+			if (cullingVisible == false)
+				continue;
+
+			u32 object = m_meshs.size();
+			m_meshs.push_back(meshData);
+
+			if (instancing)
+			{
+				// collect to instancing group, the key will build on update
+				SAutoInstancingGroup* group = getInstancingGroup(meshData);
+				if (group != NULL)
+				{
+					if (group->Objects.count() == 0)
+						m_activeGroups.push_back(group);
+
+					group->Objects.push(object);
+					group->Group.Entities.push(entity);
+					continue;
+				}
+			}
+
+			pushMesh(object);
+		}
+	}
+
+	void CMeshRenderer::pushMesh(u32 object)
+	{
+		CRenderMeshData* meshData = m_meshs[object];
+
+		CWorldTransformData* transform = GET_ENTITY_DATA(meshData->Entity, CWorldTransformData);
+		f32 depth = CRenderQueue::getDepth(transform->World.getTranslation(), m_cameraPosition, m_cameraFar);
+
+		CMesh* mesh = getRenderMesh(meshData);
+		std::vector<CMaterial*>& materials = meshData->getMesh()->Materials;
+
+		// build the sort key once for each mesh buffer
+		for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
+		{
+			CMaterial* material = j < materials.size() ? materials[j] : NULL;
+
+			bool transparent = material != NULL &&
+				material->getShader() != NULL &&
+				material->getShader()->isOpaque() == false;
+
+			m_queue.push(
+				CRenderQueue::makeKey(material, mesh->getMeshBuffer(j), depth, transparent),
+				object,
+				j);
 		}
 	}
 
 	void CMeshRenderer::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
 	{
+		m_cameraPosition.set(0.0f, 0.0f, 0.0f);
+		m_cameraFar = 1.0f;
+
+		CCamera* camera = entityManager->getCamera();
+		if (camera != NULL)
+		{
+			m_cameraPosition = camera->getPosition();
+			m_cameraFar = core::max_(camera->getFarValue(), 1.0f);
+		}
+
 		// do not render gpu skinning, pass for CSkinMeshRenderer
 		// do not render instancing mesh, pass for CInstancingMeshRenderer
 		entities = m_groupMesh->getStaticMeshes();
 		numEntity = m_groupMesh->getNumStaticMesh();
 
-		addToListMesh(entities, numEntity);
+		addToListMesh(entities, numEntity, m_enableInstancing && m_supportInstancing);
 
 		// render software skinned mesh
 		entities = m_groupMesh->getSoftwareSkinnedMeshes();
@@ -89,122 +204,238 @@ namespace Skylicht
 
 	void CMeshRenderer::init(CEntityManager* entityManager)
 	{
+		// the driver need the per instance vertex stream, other will fallback to draw each mesh
+		E_DRIVER_TYPE type = getVideoDriver()->getDriverType();
+		m_supportInstancing =
+			type == video::EDT_DIRECT3D11 ||
+			type == video::EDT_OPENGL ||
+			type == video::EDT_OPENGLES;
+	}
 
+	CMesh* CMeshRenderer::getRenderMesh(CRenderMeshData* meshData)
+	{
+		CMesh* mesh = meshData->getMesh();
+		if (meshData->isSoftwareBlendShape())
+			mesh = meshData->getSoftwareBlendShapeMesh();
+		if (meshData->isSoftwareSkinning())
+			mesh = meshData->getSoftwareSkinnedMesh();
+		return mesh;
 	}
 
-	int cmpRenderMeshFunc(const void* a, const void* b)
+	SMeshInstancing* CMeshRenderer::getMeshInstancing(CMesh* mesh)
 	{
-		CRenderMeshData* pa = *((CRenderMeshData**)a);
-		CRenderMeshData* pb = *((CRenderMeshData**)b);
+		auto it = m_instancingMeshs.find(mesh);
+		if (it != m_instancingMeshs.end() && it->second.Materials == mesh->Materials)
+			return it->second.Data;
 
-		CMesh* meshA = pa->getMesh();
-		CMesh* meshB = pb->getMesh();
+		// the material changed or new mesh
+		if (it == m_instancingMeshs.end())
+			mesh->grab();
 
-		std::vector<CMaterial*>& materialsA = meshA->Materials;
-		std::vector<CMaterial*>& materialsB = meshB->Materials;
+		SAutoInstancingMesh& instancing = m_instancingMeshs[mesh];
+		instancing.Data = NULL;
+		instancing.Materials = mesh->Materials;
 
-		// no material, compare by mesh
-		if (materialsA.size() == 0 || materialsA.size() == 0)
-		{
-			if (meshA == meshB)
-				return 0;
+		u32 mbCount = mesh->getMeshBufferCount();
+		if (mbCount == 0 || mesh->Materials.size() < mbCount)
+			return NULL;
 
-			return meshA < meshB ? -1 : 1;
+		// all mesh buffers must be opaque & have the instancing shader
+		for (u32 i = 0; i < mbCount; i++)
+		{
+			CMaterial* material = mesh->Materials[i];
+			if (material == NULL)
+				return NULL;
+
+			CShader* shader = material->getShader();
+			if (shader == NULL ||
+				shader->isOpaque() == false ||
+				shader->getInstancing() == NULL ||
+				shader->getInstancingShader() == NULL)
+				return NULL;
 		}
 
-		CMaterial* materialA = materialsA[0];
-		CMaterial* materialB = materialsB[0];
-
-		// compare by mesh
-		if (materialA == NULL || materialB == NULL)
-		{
-			IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-			IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+		SMeshInstancing* data = CMeshManager::getInstance()->createGetInstancingMesh(mesh);
+		if (data == NULL || data->RenderMeshBuffers.size() != mbCount)
+			return NULL;
 
-			if (mbA == mbB)
-				return 0;
+		instancing.Data = data;
+		return data;
+	}
 
-			return mbA < mbB ? -1 : 1;
+	CMeshRenderer::SAutoInstancingGroup* CMeshRenderer::getInstancingGroup(CRenderMeshData* meshData)
+	{
+		if (meshData->isSoftwareBlendShape() || meshData->isSoftwareSkinning())
+			return NULL;
+
+		// the instancing shader only bake SH & ambient lighting
+		CIndirectLightingData* lightingData = GET_ENTITY_DATA(meshData->Entity, CIndirectLightingData);
+		if (lightingData != NULL &&
+			lightingData->Type != CIndirectLightingData::SH9 &&
+			lightingData->Type != CIndirectLightingData::AmbientColor)
+			return NULL;
+
+		SMeshInstancing* data = getMeshInstancing(meshData->getMesh());
+		if (data == NULL)
+			return NULL;
+
+		// this data is used by CMeshRendererInstancing
+		if (data->InstancingRendererCount > 0 || data->InstancingGroup != NULL)
+			return NULL;
+
+		SAutoInstancingGroup*& group = m_instancingGroups[data];
+		if (group == NULL)
+		{
+			group = new SAutoInstancingGroup();
+			group->Data = data;
 		}
 
-		// comprate by texture
-		ITexture* textureA = materialA->getTexture(0);
-		ITexture* textureB = materialB->getTexture(0);
+		return group;
+	}
+
+	void CMeshRenderer::batchInstancing(SAutoInstancingGroup* group, u32 groupID)
+	{
+		SMeshInstancing* data = group->Data;
+		SMeshInstancingGroup& instancingGroup = group->Group;
 
-		// if no texture
-		if (textureA == NULL || textureB == NULL)
-		{
-			if (materialA == materialB)
-			{
-				// compare mesh
-				IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-				IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+		CEntity** entities = instancingGroup.Entities.pointer();
+		int count = instancingGroup.Entities.count();
 
-				if (mbA == mbB)
-					return 0;
-			}
+		instancingGroup.RootEntityIndex = entities[0]->getIndex();
 
-			return materialA < materialB ? -1 : 1;
+		for (u32 i = 0, n = data->RenderMeshBuffers.size(); i < n; i++)
+		{
+			instancingGroup.Materials.reset();
+			for (int j = 0; j < count; j++)
+				instancingGroup.Materials.push(data->Materials[i]);
+
+			// batching material data to buffer
+			data->InstancingShader[i]->batchIntancing(
+				data->MaterialBuffer[i],
+				instancingGroup.Materials.pointer(),
+				entities,
+				count
+			);
 		}
 
-		// sort by texture 0
-		if (textureA == textureB)
-		{
-			// compare mesh
-			IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-			IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+		// batching transform & lighting
+		IShaderInstancing::batchTransformAndLighting(
+			data->TransformBuffer,
+			data->IndirectLightingBuffer,
+			entities,
+			count
+		);
 
-			if (mbA == mbB)
-				return 0;
+		CWorldTransformData* transform = GET_ENTITY_DATA(entities[0], CWorldTransformData);
+		f32 depth = CRenderQueue::getDepth(transform->World.getTranslation(), m_cameraPosition, m_cameraFar);
 
-			return mbA < mbB ? -1 : 1;
+		for (u32 i = 0, n = data->RenderMeshBuffers.size(); i < n; i++)
+		{
+			m_instancingQueue.push(
+				CRenderQueue::makeKey(data->Materials[i], data->RenderMeshBuffers[i], depth, false),
+				groupID,
+				i);
 		}
-
-		return textureA < textureB ? -1 : 1;
 	}
 
 	void CMeshRenderer::update(CEntityManager* entityManager)
 	{
-		// need sort render by material, texture, mesh		
-		u32 count = m_meshs.size();
-		if (count > 0)
+		// the small group will draw each mesh
+		for (u32 i = 0, n = m_activeGroups.size(); i < n; i++)
 		{
-			// need sort by material
-			qsort(m_meshs.pointer(), count, sizeof(CRenderMeshData*), cmpRenderMeshFunc);
+			SAutoInstancingGroup* group = m_activeGroups[i];
+
+			u32 count = (u32)group->Objects.count();
+			if (count < m_minInstancing)
+			{
+				u32* objects = group->Objects.pointer();
+				for (u32 j = 0; j < count; j++)
+					pushMesh(objects[j]);
+			}
+			else
+			{
+				batchInstancing(group, i);
+			}
 		}
+
+		// need sort render by pass, shader, material, texture, mesh
+		m_queue.sort();
+		m_instancingQueue.sort();
 	}
 
 	void CMeshRenderer::render(CEntityManager* entityManager)
 	{
-		IVideoDriver* driver = getVideoDriver();
+		CRenderStateCache* cache = CRenderStateCache::getInstance();
 		IRenderPipeline* rp = entityManager->getRenderPipeline();
 		CRenderMeshData** meshs = m_meshs.pointer();
 
-		for (u32 i = 0, n = m_meshs.size(); i < n; i++)
-		{
-			CRenderMeshData* meshData = m_meshs[i];
-			CEntity* entity = meshData->Entity;
+		CRenderQueue::SItem* items = m_queue.getItems();
+		CRenderMeshData* lastMeshData = NULL;
+		CMesh* mesh = NULL;
+
+		cache->beginBatch();
 
-			CMesh* mesh = meshData->getMesh();
-			if (meshData->isSoftwareBlendShape())
-				mesh = meshData->getSoftwareBlendShapeMesh();
-			if (meshData->isSoftwareSkinning())
-				mesh = meshData->getSoftwareSkinnedMesh();
+		for (u32 i = 0, n = m_queue.getCount(); i < n; i++)
+		{
+			CRenderMeshData* meshData = meshs[items[i].Object];
 
-			CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
-			if (lightingData != NULL)
+			// only change the entity state when it changed
+			if (meshData != lastMeshData)
 			{
-				if (lightingData->Type == CIndirectLightingData::SH9)
-					CShaderSH::setSH9(lightingData->SH);
-				else if (lightingData->Type == CIndirectLightingData::AmbientColor)
-					CShaderLighting::setLightAmbient(lightingData->Color);
+				CEntity* entity = meshData->Entity;
+
+				mesh = getRenderMesh(meshData);
+
+				CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
+				if (lightingData != NULL)
+				{
+					if (lightingData->Type == CIndirectLightingData::SH9)
+						cache->setSH9(lightingData->SH);
+					else if (lightingData->Type == CIndirectLightingData::AmbientColor)
+						cache->setLightAmbient(lightingData->Color);
+				}
+
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+				cache->setWorldTransform(transform->World);
+
+				lastMeshData = meshData;
 			}
 
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			driver->setTransform(video::ETS_WORLD, transform->World);
+			rp->drawMeshBuffer(mesh, items[i].BufferID, entityManager, meshData->EntityIndex, false);
+		}
+
+		// draw the instancing group
+		u32 numInstancing = m_instancingQueue.getCount();
+		if (numInstancing > 0)
+		{
+			cache->setWorldTransform(core::IdentityMatrix);
 
-			for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
-				rp->drawMeshBuffer(mesh, j, entityManager, meshData->EntityIndex, false);
+			items = m_instancingQueue.getItems();
+			SAutoInstancingGroup** groups = m_activeGroups.pointer();
+
+			for (u32 i = 0; i < numInstancing; i++)
+			{
+				SAutoInstancingGroup* group = groups[items[i].Object];
+				SMeshInstancing* data = group->Data;
+				u32 bufferID = items[i].BufferID;
+
+				CShader* shader = data->Materials[bufferID]->getShader();
+				if (!rp->canRenderShader(shader))
+					continue;
+
+				cache->setShaderMaterial(data->Materials[bufferID]);
+
+				rp->drawInstancingMeshBuffer(
+					(CMesh*)data->InstancingMesh,
+					bufferID,
+					shader->getInstancingShader(),
+					entityManager,
+					group->Group.RootEntityIndex,
+					false
+				);
+			}
 		}
+
+		cache->endBatch();
 	}
 }
\ No newline at end of file
@@ -26,16 +26,54 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CRenderMeshData.h"
 #include "CMeshRenderSystem.h"
+#include "CRenderQueue.h"
 #include "Transform/CWorldTransformData.h"
 #include "IndirectLighting/CIndirectLightingData.h"
 
+#include "Instancing/SMeshInstancing.h"
+#include "Instancing/SMeshInstancingGroup.h"
+
 namespace Skylicht
 {
 	class SKYLICHT_API CMeshRenderer : public CMeshRenderSystem
 	{
 	protected:
+		// instancing data of a static mesh, NULL if the mesh can't be instanced
+		struct SAutoInstancingMesh
+		{
+			SMeshInstancing* Data;
+			std::vector<CMaterial*> Materials;
+		};
+
+		// visible entities that share the same mesh buffers & materials
+		struct SAutoInstancingGroup
+		{
+			SMeshInstancing* Data;
+			SMeshInstancingGroup Group;
+			CFastArray<u32> Objects;
+		};
+
 		core::array<CRenderMeshData*> m_meshs;
 
+		CRenderQueue m_queue;
+
+		core::vector3df m_cameraPosition;
+		f32 m_cameraFar;
+
+		bool m_enableInstancing;
+		bool m_supportInstancing;
+		u32 m_minInstancing;
+
+		// the cached meshes are grabbed, they are released when the renderer holds the last reference
+		std::map<CMesh*, SAutoInstancingMesh> m_instancingMeshs;
+		std::map<SMeshInstancing*, SAutoInstancingGroup*> m_instancingGroups;
+		core::array<SAutoInstancingGroup*> m_activeGroups;
+
+		// see CMeshManager::getInstancingVersion
+		u32 m_instancingVersion;
+
+		CRenderQueue m_instancingQueue;
+
 	public:
 		CMeshRenderer();
 
@@ -43,7 +81,7 @@ namespace Skylicht
 
 		virtual void beginQuery(CEntityManager* entityManager);
 
-		void addToListMesh(CEntity** entities, int numEntity);
+		void addToListMesh(CEntity** entities, int numEntity, bool instancing = false);
 
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
 
@@ -52,5 +90,58 @@ namespace Skylicht
 		virtual void update(CEntityManager* entityManager);
 
 		virtual void render(CEntityManager* entityManager);
+
+		inline CRenderQueue* getRenderQueue()
+		{
+			return &m_queue;
+		}
+
+		inline CRenderQueue* getInstancingQueue()
+		{
+			return &m_instancingQueue;
+		}
+
+		/// @brief Draw the visible static meshes that share mesh buffers & materials in one instanced call
+		inline void setEnableInstancing(bool b)
+		{
+			m_enableInstancing = b;
+		}
+
+		inline bool isEnableInstancing()
+		{
+			return m_enableInstancing;
+		}
+
+		/// @brief Minimum visible count of a mesh to draw by instancing
+		inline void setMinInstancing(u32 count)
+		{
+			m_minInstancing = core::max_(count, 2u);
+		}
+
+		inline u32 getMinInstancing()
+		{
+			return m_minInstancing;
+		}
+
+		inline u32 getNumInstancingMeshCache()
+		{
+			return (u32)m_instancingMeshs.size();
+		}
+
+		void releaseInstancingCache();
+
+	protected:
+
+		CMesh* getRenderMesh(CRenderMeshData* meshData);
+
+		void pushMesh(u32 object);
+
+		SAutoInstancingGroup* getInstancingGroup(CRenderMeshData* meshData);
+
+		SMeshInstancing* getMeshInstancing(CMesh* mesh);
+
+		void batchInstancing(SAutoInstancingGroup* group, u32 groupID);
+
+		void removeUnusedInstancingMesh();
 	};
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Culling/CCullingData.h"
 #include "Entity/CEntityManager.h"
+#include "RenderPipeline/CRenderStateCache.h"
 
 #include "Material/Shader/ShaderCallback/CShaderSH.h"
 #include "Material/Shader/ShaderCallback/CShaderLighting.h"
@@ -51,6 +52,8 @@ namespace Skylicht
 	void CMeshRendererInstancing::beginQuery(CEntityManager* entityManager)
 	{
 		m_meshs.set_used(0);
+		m_renderGroups.set_used(0);
+		m_queue.reset();
 
 		for (auto it : m_groups)
 		{
@@ -190,46 +193,85 @@ namespace Skylicht
 				);
 			}
 		}
-	}
 
-	void CMeshRendererInstancing::render(CEntityManager* entityManager)
-	{
-		IVideoDriver* driver = getVideoDriver();
-		IRenderPipeline* rp = entityManager->getRenderPipeline();
+		// build the draw queue
+		core::vector3df cameraPosition;
+		f32 cameraFar = 1.0f;
 
-		driver->setTransform(video::ETS_WORLD, core::IdentityMatrix);
+		CCamera* camera = entityManager->getCamera();
+		if (camera != NULL)
+		{
+			cameraPosition = camera->getPosition();
+			cameraFar = core::max_(camera->getFarValue(), 1.0f);
+		}
 
-		for (auto& it : m_groups)
+		for (auto it : m_groups)
 		{
 			SMeshInstancing* data = it.first;
 			SMeshInstancingGroup* group = it.second;
 
-			int count = group->Entities.count();
-			if (count == 0)
+			if (group->Entities.count() == 0)
 				continue;
 
-			u32 numMeshBuffer = data->RenderMeshBuffers.size();
-			for (u32 i = 0; i < numMeshBuffer; i++)
+			u32 object = m_renderGroups.size();
+			m_renderGroups.push_back(data);
+
+			CWorldTransformData* transform = GET_ENTITY_DATA(group->Entities.pointer()[0], CWorldTransformData);
+			f32 depth = CRenderQueue::getDepth(transform->World.getTranslation(), cameraPosition, cameraFar);
+
+			for (u32 i = 0, n = data->RenderMeshBuffers.size(); i < n; i++)
 			{
-				if (data->Materials[i] == NULL)
+				CMaterial* material = data->Materials[i];
+				if (material == NULL || material->getShader() == NULL)
 					continue;
 
-				CShader* shader = data->Materials[i]->getShader();
+				m_queue.push(
+					CRenderQueue::makeKey(material, data->RenderMeshBuffers[i], depth, !material->getShader()->isOpaque()),
+					object,
+					i);
+			}
+		}
 
-				if (!rp->canRenderShader(shader))
-					continue;
+		m_queue.sort();
+	}
 
-				CShaderMaterial::setMaterial(data->Materials[i]);
+	void CMeshRendererInstancing::render(CEntityManager* entityManager)
+	{
+		if (m_queue.getCount() == 0)
+			return;
 
-				rp->drawInstancingMeshBuffer(
-					(CMesh*)data->InstancingMesh,
-					i,
-					shader->getInstancingShader(),
-					entityManager,
-					group->RootEntityIndex,
-					false
-				);
-			}
+		CRenderStateCache* cache = CRenderStateCache::getInstance();
+		IRenderPipeline* rp = entityManager->getRenderPipeline();
+
+		cache->beginBatch();
+		cache->setWorldTransform(core::IdentityMatrix);
+
+		CRenderQueue::SItem* items = m_queue.getItems();
+		SMeshInstancing** groups = m_renderGroups.pointer();
+
+		for (u32 i = 0, n = m_queue.getCount(); i < n; i++)
+		{
+			SMeshInstancing* data = groups[items[i].Object];
+			SMeshInstancingGroup* group = data->InstancingGroup;
+			u32 bufferID = items[i].BufferID;
+
+			CShader* shader = data->Materials[bufferID]->getShader();
+
+			if (!rp->canRenderShader(shader))
+				continue;
+
+			cache->setShaderMaterial(data->Materials[bufferID]);
+
+			rp->drawInstancingMeshBuffer(
+				(CMesh*)data->InstancingMesh,
+				bufferID,
+				shader->getInstancingShader(),
+				entityManager,
+				group->RootEntityIndex,
+				false
+			);
 		}
+
+		cache->endBatch();
 	}
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CRenderMeshData.h"
 #include "CMeshRenderSystem.h"
+#include "CRenderQueue.h"
 #include "Transform/CWorldTransformData.h"
 #include "IndirectLighting/CIndirectLightingData.h"
 
@@ -41,6 +42,10 @@ namespace Skylicht
 
 		std::map<SMeshInstancing*, SMeshInstancingGroup*> m_groups;
 
+		core::array<SMeshInstancing*> m_renderGroups;
+
+		CRenderQueue m_queue;
+
 	public:
 		CMeshRendererInstancing();
 
@@ -55,5 +60,10 @@ namespace Skylicht
 		virtual void update(CEntityManager* entityManager);
 
 		virtual void render(CEntityManager* entityManager);
+
+		inline CRenderQueue* getRenderQueue()
+		{
+			return &m_queue;
+		}
 	};
 }
\ No newline at end of file
@@ -40,13 +40,38 @@ namespace Skylicht
 
 	IMPLEMENT_DATA_TYPE_INDEX(CRenderMeshData);
 
-	std::vector<std::string> g_importTextureFolder;
+	// per thread, the mesh can be imported on main thread and streaming thread
+	thread_local std::vector<std::string> g_importTextureFolder;
+	thread_local std::vector<CRenderMeshData::SDeferTexture>* g_deferTexture = NULL;
 
 	void CRenderMeshData::setImportTextureFolder(std::vector<std::string>& folders)
 	{
 		g_importTextureFolder = folders;
 	}
 
+	void CRenderMeshData::setDeferTexture(std::vector<SDeferTexture>* textures)
+	{
+		g_deferTexture = textures;
+	}
+
+	void CRenderMeshData::applyTexture(IMeshBuffer* mb, int slot, ITexture* texture, bool skinnedMesh)
+	{
+		if (texture == NULL)
+			return;
+
+		video::SMaterial& irrMaterial = mb->getMaterial();
+		irrMaterial.setTexture(slot, texture);
+
+		if (slot == 0)
+		{
+			CShaderManager* shaderMgr = CShaderManager::getInstance();
+			if (skinnedMesh == false)
+				irrMaterial.MaterialType = shaderMgr->getShaderIDByName("TextureColor");
+			else
+				irrMaterial.MaterialType = shaderMgr->getShaderIDByName("Skin");
+		}
+	}
+
 	CRenderMeshData::CRenderMeshData() :
 		RenderMesh(NULL),
 		SoftwareSkinnedMesh(NULL),
@@ -57,6 +82,7 @@ namespace Skylicht
 		IsInstancing(false),
 		IsSkinnedInstancing(false),
 		MeshInstancing(NULL),
+		MeshInstancingVersion(0),
 		Visible(true)
 	{
 
@@ -64,6 +90,8 @@ namespace Skylicht
 
 	CRenderMeshData::~CRenderMeshData()
 	{
+		releaseMeshInstancing();
+
 		if (RenderMesh != NULL)
 			RenderMesh->drop();
 
@@ -101,24 +129,51 @@ namespace Skylicht
 
 	void CRenderMeshData::setInstancing(bool b)
 	{
+		releaseMeshInstancing();
+
 		if (b)
-			MeshInstancing = CMeshManager::getInstance()->createGetInstancingMesh(RenderMesh);
-		else
-			MeshInstancing = NULL;
+		{
+			CMeshManager* meshManager = CMeshManager::getInstance();
+			MeshInstancing = meshManager->createGetInstancingMesh(RenderMesh);
+			MeshInstancingVersion = meshManager->getInstancingVersion();
+		}
+
+		if (MeshInstancing)
+			MeshInstancing->InstancingRendererCount++;
 
 		IsInstancing = b;
 	}
 
 	void CRenderMeshData::setSkinnedInstancing(bool b)
 	{
+		releaseMeshInstancing();
+
 		if (b)
-			MeshInstancing = CMeshManager::getInstance()->createGetInstancingMesh(RenderMesh, new CSkinTBNSGInstancing());
-		else
-			MeshInstancing = NULL;
+		{
+			CMeshManager* meshManager = CMeshManager::getInstance();
+			MeshInstancing = meshManager->createGetInstancingMesh(RenderMesh, new CSkinTBNSGInstancing());
+			MeshInstancingVersion = meshManager->getInstancingVersion();
+		}
+
+		if (MeshInstancing)
+			MeshInstancing->InstancingRendererCount++;
 
 		IsSkinnedInstancing = b;
 	}
 
+	void CRenderMeshData::releaseMeshInstancing()
+	{
+		if (MeshInstancing == NULL)
+			return;
+
+		// the data is deleted by CMeshManager::releaseAllInstancingMesh, that increase the version
+		CMeshManager* meshManager = CMeshManager::getInstance();
+		if (meshManager != NULL && meshManager->getInstancingVersion() == MeshInstancingVersion)
+			MeshInstancing->InstancingRendererCount--;
+
+		MeshInstancing = NULL;
+	}
+
 	void CRenderMeshData::setMaterial(CMaterial* material)
 	{
 		CMesh* mesh = RenderMesh;
@@ -368,9 +423,11 @@ namespace Skylicht
 			}
 
 			// write vertex data
+			stream->writeAlign(16);
 			stream->writeData(vb->getVertices(), vtxBufferSize);
 
 			// write indices data
+			stream->writeAlign(16);
 			stream->writeData(ib->getIndices(), idxBufferSize);
 		}
 
@@ -379,8 +436,6 @@ namespace Skylicht
 
 	bool CRenderMeshData::deserializable(CMemoryStream* stream, int version)
 	{
-		CShaderManager* shaderMgr = CShaderManager::getInstance();
-
 		IsSkinnedMesh = stream->readChar() == 1 ? true : false;
 
 		if (IsSkinnedMesh == true)
@@ -491,32 +546,39 @@ namespace Skylicht
 				IVertexBuffer* vtxBuffer = mb->getVertexBuffer();
 				IIndexBuffer* idxBuffer = mb->getIndexBuffer();
 
+				// version 2: the blocks are aligned
+				if (version >= 2)
+					stream->readAlign(16);
+
 				vtxBuffer->set_used(vtxCount);
 				stream->readData(vtxBuffer->getVertices(), vtxBufferSize);
 
+				if (version >= 2)
+					stream->readAlign(16);
+
 				idxBuffer->set_used(idxCount);
 				stream->readData(idxBuffer->getIndices(), idxBufferSize);
 
 				mb->getBoundingBox() = bbox;
 				mb->setHardwareMappingHint(EHM_STATIC);
 
-				video::SMaterial& irrMaterial = mb->getMaterial();
-
 				for (int t = 0; t < 3; t++)
 				{
 					if (textures[t].empty() == false)
 					{
-						ITexture* texture = CTextureManager::getInstance()->getTexture(textures[t].c_str(), g_importTextureFolder);
-						if (texture != NULL)
-							irrMaterial.setTexture(t, texture);
-
-						if (t == 0 && texture != NULL)
+						if (g_deferTexture != NULL)
 						{
-							if (IsSkinnedMesh == false)
-								irrMaterial.MaterialType = shaderMgr->getShaderIDByName("TextureColor");
-							else
-								irrMaterial.MaterialType = shaderMgr->getShaderIDByName("Skin");
+							SDeferTexture defer;
+							defer.MeshBuffer = mb;
+							defer.Slot = t;
+							defer.SkinnedMesh = IsSkinnedMesh;
+							defer.Path = textures[t];
+							g_deferTexture->push_back(defer);
+							continue;
 						}
+
+						ITexture* texture = CTextureManager::getInstance()->getTexture(textures[t].c_str(), g_importTextureFolder);
+						applyTexture(mb, t, texture, IsSkinnedMesh);
 					}
 				}
 
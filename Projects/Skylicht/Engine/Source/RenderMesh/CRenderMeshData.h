@@ -37,8 +37,22 @@ namespace Skylicht
 	class SKYLICHT_API CRenderMeshData : public IEntityData
 	{
 	public:
+		// the texture of mesh buffer that is not loaded yet, see setDeferTexture
+		struct SDeferTexture
+		{
+			IMeshBuffer* MeshBuffer;
+			int Slot;
+			bool SkinnedMesh;
+			std::string Path;
+		};
+
 		static void setImportTextureFolder(std::vector<std::string>& folders);
 
+		// the mesh is loaded on the streaming thread, the textures will be set on main thread by applyTexture
+		static void setDeferTexture(std::vector<SDeferTexture>* textures);
+
+		static void applyTexture(IMeshBuffer* mb, int slot, ITexture* texture, bool skinnedMesh);
+
 	protected:
 		CMesh* RenderMesh;
 		CMesh* SoftwareSkinnedMesh;
@@ -52,6 +66,9 @@ namespace Skylicht
 
 		SMeshInstancing* MeshInstancing;
 
+		// see CMeshManager::getInstancingVersion
+		u32 MeshInstancingVersion;
+
 		bool Visible;
 
 	public:
@@ -105,6 +122,8 @@ namespace Skylicht
 			return IsSkinnedInstancing;
 		}
 
+		void releaseMeshInstancing();
+
 		void setSoftwareSkinning(bool b)
 		{
 			IsSoftwareSkinning = b;
@@ -0,0 +1,163 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CRenderQueue.h"
+
+#include "Material/CMaterial.h"
+#include "Material/Shader/CShader.h"
+
+namespace Skylicht
+{
+	CRenderQueue::CRenderQueue() :
+		m_numOpaque(0)
+	{
+
+	}
+
+	CRenderQueue::~CRenderQueue()
+	{
+
+	}
+
+	u64 CRenderQueue::makeKey(EPass pass, u32 shader, u32 material, u32 texture, u32 meshBuffer, f32 depth)
+	{
+		u64 key = (u64)(pass & 0x3) << 62;
+
+		if (pass == Opaque)
+		{
+			u64 d = (u64)(depth * 65535.0f);
+			key |= (u64)(shader & 0x3ff) << 52;
+			key |= (u64)(material & 0xfff) << 40;
+			key |= (u64)(texture & 0xfff) << 28;
+			key |= (u64)(meshBuffer & 0xfff) << 16;
+			key |= d & 0xffff;
+		}
+		else
+		{
+			// far object draw first
+			u64 d = 0xffff - ((u64)(depth * 65535.0f) & 0xffff);
+			key |= d << 46;
+			key |= (u64)(shader & 0x3ff) << 36;
+			key |= (u64)(material & 0xfff) << 24;
+			key |= (u64)(texture & 0xfff) << 12;
+			key |= (u64)(meshBuffer & 0xfff);
+		}
+
+		return key;
+	}
+
+	u64 CRenderQueue::makeKey(CMaterial* material, IMeshBuffer* mb, f32 depth, bool transparent)
+	{
+		u32 shaderId = 0;
+		u32 materialId = 0;
+		u32 textureId = 0;
+
+		if (material != NULL)
+		{
+			CShader* shader = material->getShader();
+			if (shader != NULL)
+				shaderId = (u32)(shader->getMaterialRenderID() + 1);
+
+			materialId = hashPointer(material, 12);
+			textureId = hashPointer(material->getTexture(0), 12);
+		}
+
+		return makeKey(
+			transparent ? Transparent : Opaque,
+			shaderId,
+			materialId,
+			textureId,
+			hashPointer(mb, 12),
+			depth);
+	}
+
+	void CRenderQueue::sort()
+	{
+		u32 count = getCount();
+		m_numOpaque = 0;
+
+		if (count == 0)
+			return;
+
+		if (count > 1)
+		{
+			// build 8 histograms in one pass
+			u32 histogram[8][256];
+			memset(histogram, 0, sizeof(histogram));
+
+			SItem* items = m_items.pointer();
+			for (u32 i = 0; i < count; i++)
+			{
+				u64 key = items[i].Key;
+				for (u32 b = 0; b < 8; b++)
+					histogram[b][(key >> (b * 8)) & 0xff]++;
+			}
+
+			if (m_temp.size() < count)
+				m_temp.set_used(count);
+
+			SItem* src = items;
+			SItem* dst = m_temp.pointer();
+
+			for (u32 b = 0; b < 8; b++)
+			{
+				u32* h = histogram[b];
+
+				// all keys have the same digit
+				if (h[(src[0].Key >> (b * 8)) & 0xff] == count)
+					continue;
+
+				u32 offset = 0;
+				for (u32 i = 0; i < 256; i++)
+				{
+					u32 c = h[i];
+					h[i] = offset;
+					offset += c;
+				}
+
+				u32 shift = b * 8;
+				for (u32 i = 0; i < count; i++)
+				{
+					u32 digit = (src[i].Key >> shift) & 0xff;
+					dst[h[digit]++] = src[i];
+				}
+
+				SItem* t = src;
+				src = dst;
+				dst = t;
+			}
+
+			if (src != items)
+				memcpy(items, src, sizeof(SItem) * count);
+		}
+
+		// opaque pass is at the begin
+		SItem* items = m_items.pointer();
+		u32 n = 0;
+		while (n < count && (items[n].Key >> 62) == Opaque)
+			n++;
+		m_numOpaque = n;
+	}
+}
@@ -0,0 +1,119 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Entity/CArrayUtils.h"
+
+namespace Skylicht
+{
+	class CMaterial;
+
+	/// @brief Draw list sorted by a packed 64-bit state key
+	/// Opaque key (msb -> lsb): pass 2 | shader 10 | material 12 | texture 12 | mesh buffer 12 | depth 16 (front to back)
+	/// Transparent key: pass 2 | depth 16 (back to front) | shader 10 | material 12 | texture 12 | mesh buffer 12
+	class SKYLICHT_API CRenderQueue
+	{
+	public:
+		enum EPass
+		{
+			Opaque = 0,
+			Transparent,
+		};
+
+		struct SItem
+		{
+			u64 Key;
+			u32 Object;
+			u32 BufferID;
+		};
+
+	protected:
+		CFastArray<SItem> m_items;
+		core::array<SItem> m_temp;
+
+		u32 m_numOpaque;
+
+	public:
+		CRenderQueue();
+
+		virtual ~CRenderQueue();
+
+		inline void reset()
+		{
+			m_items.reset();
+			m_numOpaque = 0;
+		}
+
+		inline void push(u64 key, u32 object, u32 bufferID)
+		{
+			SItem* item = m_items.getPush();
+			item->Key = key;
+			item->Object = object;
+			item->BufferID = bufferID;
+		}
+
+		inline SItem* getItems()
+		{
+			return m_items.pointer();
+		}
+
+		inline u32 getCount()
+		{
+			return (u32)m_items.count();
+		}
+
+		/// @brief Count of items in opaque pass, valid after sort
+		inline u32 getNumOpaque()
+		{
+			return m_numOpaque;
+		}
+
+		/// @brief LSD radix sort on Key, stable, skip the digit when all keys share it
+		void sort();
+
+		static u64 makeKey(EPass pass, u32 shader, u32 material, u32 texture, u32 meshBuffer, f32 depth);
+
+		/// @brief Key of a mesh buffer draw with its material (can be NULL)
+		static u64 makeKey(CMaterial* material, IMeshBuffer* mb, f32 depth, bool transparent);
+
+		/// @brief Fold a pointer to n bits id, collision only breaks the batching
+		static inline u32 hashPointer(const void* p, u32 bits)
+		{
+			if (p == NULL)
+				return 0;
+
+			u64 v = (u64)(size_t)p >> 4;
+			v = (v ^ (v >> 29)) * 0x9E3779B97F4A7C15ULL;
+			return (u32)(v >> (64 - bits));
+		}
+
+		/// @brief Map a camera distance to [0, 1] for the depth bucket
+		static inline f32 getDepth(const core::vector3df& position, const core::vector3df& camPosition, f32 farValue)
+		{
+			f32 d = position.getDistanceFrom(camPosition) / farValue;
+			return core::clamp(d, 0.0f, 1.0f);
+		}
+	};
+}
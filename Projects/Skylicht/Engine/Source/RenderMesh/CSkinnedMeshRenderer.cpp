@@ -31,6 +31,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Material/Shader/ShaderCallback/CShaderLighting.h"
 
 #include "Entity/CEntityManager.h"
+#include "RenderPipeline/CRenderStateCache.h"
 
 namespace Skylicht
 {
@@ -52,7 +53,7 @@ namespace Skylicht
 	void CSkinnedMeshRenderer::beginQuery(CEntityManager* entityManager)
 	{
 		m_meshs.set_used(0);
-		m_transparents.set_used(0);
+		m_queue.reset();
 
 		CMeshRenderSystem::beginQuery(entityManager);
 	}
@@ -62,6 +63,16 @@ namespace Skylicht
 		numEntity = m_groupMesh->getNumHardwareSkinnedMesh();
 		entities = m_groupMesh->getHardwareSkinnedMeshes();
 
+		core::vector3df cameraPosition;
+		f32 cameraFar = 1.0f;
+
+		CCamera* camera = entityManager->getCamera();
+		if (camera != NULL)
+		{
+			cameraPosition = camera->getPosition();
+			cameraFar = core::max_(camera->getFarValue(), 1.0f);
+		}
+
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
@@ -75,194 +86,104 @@ namespace Skylicht
 				cullingVisible = cullingData->Visible;
 
 			// only render visible culling mesh
-			if (cullingVisible == true)
-				m_meshs.push_back(meshData);
-		}
-	}
-
-	int cmpRenderSkinMeshFunc(const void* a, const void* b)
-	{
-		CRenderMeshData* pa = *((CRenderMeshData**)a);
-		CRenderMeshData* pb = *((CRenderMeshData**)b);
-
-		CMesh* meshA = pa->getMesh();
-		CMesh* meshB = pb->getMesh();
-
-		std::vector<CMaterial*>& materialsA = meshA->Materials;
-		std::vector<CMaterial*>& materialsB = meshB->Materials;
+			if (cullingVisible == false)
+				continue;
 
-		// no material, compare by mesh
-		if (materialsA.size() == 0 || materialsA.size() == 0)
-		{
-			if (meshA == meshB)
-				return 0;
-
-			return meshA < meshB ? -1 : 1;
-		}
-
-		CMaterial* materialA = materialsA[0];
-		CMaterial* materialB = materialsB[0];
-
-		// compare by mesh
-		if (materialA == NULL || materialB == NULL)
-		{
-			IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-			IMeshBuffer* mbB = meshB->getMeshBuffer(0);
-
-			if (mbA == mbB)
-				return 0;
+			u32 object = m_meshs.size();
+			m_meshs.push_back(meshData);
 
-			return mbA < mbB ? -1 : 1;
-		}
+			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+			f32 depth = CRenderQueue::getDepth(transform->World.getTranslation(), cameraPosition, cameraFar);
 
-		// compare by texture
-		ITexture* textureA = materialA->getTexture(0);
-		ITexture* textureB = materialB->getTexture(0);
+			CMesh* mesh = meshData->getMesh();
+			if (meshData->isSoftwareBlendShape())
+				mesh = meshData->getSoftwareBlendShapeMesh();
 
-		// if no texture
-		if (textureA == NULL || textureB == NULL)
-		{
-			if (materialA == materialB)
-				return 0;
-			return materialA < materialB ? -1 : 1;
-		}
-
-		// sort by texture 0
-		if (textureA == textureB)
-		{
-			IMeshBuffer* mbA = meshA->getMeshBuffer(0);
-			IMeshBuffer* mbB = meshB->getMeshBuffer(0);
+			for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
+			{
+				CMaterial* material = mesh->Materials[j];
 
-			if (mbA == mbB)
-				return 0;
+				// unknown material will draw in opaque pass
+				bool transparent = material != NULL &&
+					material->getShader() != NULL &&
+					material->getShader()->isOpaque() == false;
 
-			return mbA < mbB ? -1 : 1;
+				m_queue.push(
+					CRenderQueue::makeKey(material, mesh->getMeshBuffer(j), depth, transparent),
+					object,
+					j);
+			}
 		}
-
-		return textureA < textureB ? -1 : 1;
 	}
 
 	void CSkinnedMeshRenderer::update(CEntityManager* entityManager)
 	{
-		// need sort render by material, texture, mesh		
-		u32 count = m_meshs.size();
-		if (count > 0)
-		{
-			// need sort by material
-			qsort(m_meshs.pointer(), count, sizeof(CRenderMeshData*), cmpRenderSkinMeshFunc);
-		}
+		// need sort render by pass, shader, material, texture, mesh
+		m_queue.sort();
 	}
 
 	void CSkinnedMeshRenderer::render(CEntityManager* entityManager)
 	{
-		IVideoDriver* driver = getVideoDriver();
-
-		CRenderMeshData** meshs = m_meshs.pointer();
-		CShaderManager* shaderManager = CShaderManager::getInstance();
-		IRenderPipeline* rp = entityManager->getRenderPipeline();
-
-		for (u32 i = 0, n = m_meshs.size(); i < n; i++)
-		{
-			CRenderMeshData* renderMeshData = m_meshs[i];
-			CEntity* entity = renderMeshData->Entity;
-
-			CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
-			if (lightingData != NULL)
-			{
-				if (lightingData->Type == CIndirectLightingData::SH9)
-					CShaderSH::setSH9(lightingData->SH);
-				else if (lightingData->Type == CIndirectLightingData::AmbientColor)
-					CShaderLighting::setLightAmbient(lightingData->Color);
-			}
-
-			// set bone matrix to shader callback
-			CSkinnedMesh* mesh = (CSkinnedMesh*)renderMeshData->getMesh();
-			shaderManager->BoneMatrix = mesh->SkinningMatrix;
-			shaderManager->BoneCount = mesh->Joints.size();
-
-			// software blendshape
-			if (renderMeshData->isSoftwareBlendShape())
-				mesh = (CSkinnedMesh*)renderMeshData->getSoftwareBlendShapeMesh();
-
-			// set transform
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			driver->setTransform(video::ETS_WORLD, transform->World);
-
-			bool haveTransparent = false;
-
-			// render mesh
-			for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
-			{
-				CMaterial* material = mesh->Materials[j];
-				if (material == NULL)
-				{
-					// draw opaque mesh because unknown material
-					rp->drawMeshBuffer(mesh, j, entityManager, renderMeshData->EntityIndex, true);
-				}
-				else if (material->getShader() != NULL && material->getShader()->isOpaque() == false)
-				{
-					// draw transparent material later
-					haveTransparent = true;
-				}
-				else
-				{
-					// draw opaque mesh
-					rp->drawMeshBuffer(mesh, j, entityManager, renderMeshData->EntityIndex, true);
-				}
-			}
-
-			if (haveTransparent == true)
-			{
-				// this will render in transparent pass
-				m_transparents.push_back(i);
-			}
-		}
+		renderQueue(entityManager, 0, m_queue.getNumOpaque());
 	}
 
 	void CSkinnedMeshRenderer::renderTransparent(CEntityManager* entityManager)
 	{
-		u32 numTransparent = m_transparents.size();
-		if (numTransparent == 0)
+		renderQueue(entityManager, m_queue.getNumOpaque(), m_queue.getCount());
+	}
+
+	void CSkinnedMeshRenderer::renderQueue(CEntityManager* entityManager, u32 begin, u32 end)
+	{
+		if (begin >= end)
 			return;
 
-		IVideoDriver* driver = getVideoDriver();
+		CRenderStateCache* cache = CRenderStateCache::getInstance();
 		CShaderManager* shaderManager = CShaderManager::getInstance();
 		IRenderPipeline* rp = entityManager->getRenderPipeline();
 		CRenderMeshData** meshs = m_meshs.pointer();
-		CEntity** allEntities = entityManager->getEntities();
 
-		for (u32 i = 0; i < numTransparent; i++)
-		{
-			u32 meshID = m_transparents[i];
-
-			CRenderMeshData* renderMeshData = m_meshs[meshID];
-			CEntity* entity = renderMeshData->Entity;
+		CRenderQueue::SItem* items = m_queue.getItems();
+		CRenderMeshData* lastMeshData = NULL;
+		CSkinnedMesh* mesh = NULL;
 
-			// set bone matrix to shader callback
-			CSkinnedMesh* mesh = (CSkinnedMesh*)renderMeshData->getMesh();
-			shaderManager->BoneMatrix = mesh->SkinningMatrix;
-			shaderManager->BoneCount = mesh->Joints.size();
+		cache->beginBatch();
 
-			// set transform
-			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
-			driver->setTransform(video::ETS_WORLD, transform->World);
-
-			// software blendshape
-			if (renderMeshData->isSoftwareBlendShape())
-				mesh = (CSkinnedMesh*)renderMeshData->getSoftwareBlendShapeMesh();
+		for (u32 i = begin; i < end; i++)
+		{
+			CRenderMeshData* renderMeshData = meshs[items[i].Object];
 
-			// render mesh
-			for (u32 j = 0, m = mesh->getMeshBufferCount(); j < m; j++)
+			if (renderMeshData != lastMeshData)
 			{
-				CMaterial* material = mesh->Materials[j];
+				CEntity* entity = renderMeshData->Entity;
 
-				if (material != NULL &&
-					material->getShader() != NULL &&
-					material->getShader()->isOpaque() == false)
+				CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
+				if (lightingData != NULL)
 				{
-					rp->drawMeshBuffer(mesh, j, entityManager, renderMeshData->EntityIndex, true);
+					if (lightingData->Type == CIndirectLightingData::SH9)
+						cache->setSH9(lightingData->SH);
+					else if (lightingData->Type == CIndirectLightingData::AmbientColor)
+						cache->setLightAmbient(lightingData->Color);
 				}
+
+				// set bone matrix to shader callback
+				mesh = (CSkinnedMesh*)renderMeshData->getMesh();
+				shaderManager->BoneMatrix = mesh->SkinningMatrix;
+				shaderManager->BoneCount = mesh->Joints.size();
+
+				// software blendshape
+				if (renderMeshData->isSoftwareBlendShape())
+					mesh = (CSkinnedMesh*)renderMeshData->getSoftwareBlendShapeMesh();
+
+				// set transform
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+				cache->setWorldTransform(transform->World);
+
+				lastMeshData = renderMeshData;
 			}
+
+			rp->drawMeshBuffer(mesh, items[i].BufferID, entityManager, renderMeshData->EntityIndex, true);
 		}
+
+		cache->endBatch();
 	}
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CRenderMeshData.h"
 #include "CMeshRenderSystem.h"
+#include "CRenderQueue.h"
 #include "Transform/CWorldTransformData.h"
 #include "IndirectLighting/CIndirectLightingData.h"
 
@@ -35,7 +36,8 @@ namespace Skylicht
 	{
 	protected:
 		core::array<CRenderMeshData*> m_meshs;
-		core::array<u32> m_transparents;
+
+		CRenderQueue m_queue;
 
 	public:
 		CSkinnedMeshRenderer();
@@ -53,5 +55,14 @@ namespace Skylicht
 		virtual void render(CEntityManager* entityManager);
 
 		virtual void renderTransparent(CEntityManager* entityManager);
+
+		inline CRenderQueue* getRenderQueue()
+		{
+			return &m_queue;
+		}
+
+	protected:
+
+		void renderQueue(CEntityManager* entityManager, u32 begin, u32 end);
 	};
 }
\ No newline at end of file
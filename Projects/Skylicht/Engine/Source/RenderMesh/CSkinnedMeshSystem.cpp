@@ -31,7 +31,9 @@ namespace Skylicht
 {
 	CSkinnedMeshSystem::CSkinnedMeshSystem()
 	{
-
+		// write skinning matrix on mesh
+		readDataType(DATA_TYPE_INDEX(CJointData));
+		writeDataType(DATA_TYPE_INDEX(CRenderMeshData));
 	}
 
 	CSkinnedMeshSystem::~CSkinnedMeshSystem()
@@ -28,12 +28,17 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Culling/CVisibleData.h"
 #include "Entity/CEntityManager.h"
 #include "VertexAnimation/CSoftwareSkinningUtils.h"
+#include "Job/CJobSystem.h"
+
+#define BLENDSHAPE_BATCH 2048
 
 namespace Skylicht
 {
-	CSoftwareBlendShapeSystem::CSoftwareBlendShapeSystem()
+	CSoftwareBlendShapeSystem::CSoftwareBlendShapeSystem() :
+		m_parallelUpdate(true)
 	{
-
+		readDataType(DATA_TYPE_INDEX(CCullingData));
+		writeDataType(DATA_TYPE_INDEX(CRenderMeshData));
 	}
 
 	CSoftwareBlendShapeSystem::~CSoftwareBlendShapeSystem()
@@ -61,6 +66,9 @@ namespace Skylicht
 		int numEntity = m_groupMesh->getNumBlendShape();
 		CEntity** entities = m_groupMesh->getBlendShapeMeshes();
 
+		m_tasks.set_used(0);
+		m_blendShapeMeshes.set_used(0);
+
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
@@ -72,7 +80,61 @@ namespace Skylicht
 			CRenderMeshData* renderer = GET_ENTITY_DATA(entity, CRenderMeshData);
 			if (renderer != NULL && renderer->isSoftwareBlendShape())
 			{
-				CSoftwareSkinningUtils::softwareBlendShape(renderer->getSoftwareBlendShapeMesh(), renderer->getMesh());
+				addBlendShapeTask(renderer->getSoftwareBlendShapeMesh(), renderer->getMesh());
+				m_blendShapeMeshes.push_back(renderer->getSoftwareBlendShapeMesh());
+			}
+		}
+
+		int numTask = (int)m_tasks.size();
+
+		SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+		int numThread = jobSystem->getWorkerCount() + 1;
+
+		if (!m_parallelUpdate || numThread == 1 || numTask <= 1)
+		{
+			for (int i = 0; i < numTask; i++)
+			{
+				SBlendShapeTask& t = m_tasks[i];
+				CSoftwareSkinningUtils::blendShapeVertices(t.BlendShape, t.NumBlendShape, t.Vertex, t.Result, t.Begin, t.End);
+			}
+		}
+		else
+		{
+			SBlendShapeTask* tasks = m_tasks.pointer();
+			jobSystem->parallelFor(numTask, 1, [tasks](int from, int to)
+				{
+					for (int i = from; i < to; i++)
+					{
+						SBlendShapeTask& t = tasks[i];
+						CSoftwareSkinningUtils::blendShapeVertices(t.BlendShape, t.NumBlendShape, t.Vertex, t.Result, t.Begin, t.End);
+					}
+				});
+		}
+
+		for (u32 i = 0, n = m_blendShapeMeshes.size(); i < n; i++)
+			m_blendShapeMeshes[i]->setDirty(EBT_VERTEX);
+	}
+
+	void CSoftwareBlendShapeSystem::addBlendShapeTask(CMesh* blendShape, CMesh* originalMesh)
+	{
+		SBlendShapeTask task;
+		task.BlendShape = originalMesh->BlendShape.pointer();
+		task.NumBlendShape = originalMesh->BlendShape.size();
+
+		for (u32 i = 0, n = originalMesh->getMeshBufferCount(); i < n; i++)
+		{
+			IVertexBuffer* originalVertexBuffer = originalMesh->getMeshBuffer(i)->getVertexBuffer(0);
+			IVertexBuffer* vertexBuffer = blendShape->getMeshBuffer(i)->getVertexBuffer(0);
+
+			task.Vertex = (video::S3DVertexSkinTangents*)originalVertexBuffer->getVertices();
+			task.Result = (video::S3DVertexSkinTangents*)vertexBuffer->getVertices();
+
+			int numVertex = (int)originalVertexBuffer->getVertexCount();
+			for (int begin = 0; begin < numVertex; begin += BLENDSHAPE_BATCH)
+			{
+				task.Begin = begin;
+				task.End = core::min_(begin + BLENDSHAPE_BATCH, numVertex);
+				m_tasks.push_back(task);
 			}
 		}
 	}
@@ -33,6 +33,23 @@ namespace Skylicht
 {
 	class SKYLICHT_API CSoftwareBlendShapeSystem : public CMeshSystem
 	{
+	protected:
+		struct SBlendShapeTask
+		{
+			CBlendShape** BlendShape;
+			u32 NumBlendShape;
+			video::S3DVertexSkinTangents* Vertex;
+			video::S3DVertexSkinTangents* Result;
+			int Begin;
+			int End;
+		};
+
+		core::array<SBlendShapeTask> m_tasks;
+
+		core::array<CMesh*> m_blendShapeMeshes;
+
+		bool m_parallelUpdate;
+
 	public:
 		CSoftwareBlendShapeSystem();
 
@@ -45,5 +62,20 @@ namespace Skylicht
 		virtual void init(CEntityManager* entityManager);
 
 		virtual void update(CEntityManager* entityManager);
+
+		// morph the vertex chunks on job system
+		inline void setParallelUpdate(bool b)
+		{
+			m_parallelUpdate = b;
+		}
+
+		inline bool isParallelUpdate()
+		{
+			return m_parallelUpdate;
+		}
+
+	protected:
+
+		void addBlendShapeTask(CMesh* blendShape, CMesh* originalMesh);
 	};
 }
\ No newline at end of file
@@ -26,12 +26,17 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CSoftwareSkinningSystem.h"
 #include "Culling/CCullingData.h"
 #include "VertexAnimation/CSoftwareSkinningUtils.h"
+#include "Job/CJobSystem.h"
+
+#define SKINNING_BATCH 1024
 
 namespace Skylicht
 {
-	CSoftwareSkinningSystem::CSoftwareSkinningSystem()
+	CSoftwareSkinningSystem::CSoftwareSkinningSystem() :
+		m_parallelUpdate(true)
 	{
-
+		readDataType(DATA_TYPE_INDEX(CCullingData));
+		writeDataType(DATA_TYPE_INDEX(CRenderMeshData));
 	}
 
 	CSoftwareSkinningSystem::~CSoftwareSkinningSystem()
@@ -59,6 +64,9 @@ namespace Skylicht
 		int numEntity = m_groupMesh->getNumSoftwareSkinnedMesh();
 		CEntity** entities = m_groupMesh->getSoftwareSkinnedMeshes();
 
+		m_tasks.set_used(0);
+		m_skinnedMeshes.set_used(0);
+
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
@@ -73,10 +81,74 @@ namespace Skylicht
 			CSkinnedMesh* blendShapeMesh = dynamic_cast<CSkinnedMesh*>(renderer->getSoftwareBlendShapeMesh());
 			CMesh* skinnedMesh = renderer->getSoftwareSkinnedMesh();
 
-			if (renderMesh->getMeshBuffer(0)->getVertexType() == video::EVT_SKIN_TANGENTS)
-				CSoftwareSkinningUtils::softwareSkinningTangent(skinnedMesh, renderMesh, blendShapeMesh);
+			addSkinningTask(skinnedMesh, renderMesh, blendShapeMesh);
+			m_skinnedMeshes.push_back(skinnedMesh);
+		}
+
+		int numTask = (int)m_tasks.size();
+
+		SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+		int numThread = jobSystem->getWorkerCount() + 1;
+
+		if (!m_parallelUpdate || numThread == 1 || numTask <= 1)
+		{
+			for (int i = 0; i < numTask; i++)
+				runSkinningTask(m_tasks[i]);
+		}
+		else
+		{
+			SSkinningTask* tasks = m_tasks.pointer();
+			jobSystem->parallelFor(numTask, 1, [this, tasks](int from, int to)
+				{
+					for (int i = from; i < to; i++)
+						runSkinningTask(tasks[i]);
+				});
+		}
+
+		for (u32 i = 0, n = m_skinnedMeshes.size(); i < n; i++)
+			m_skinnedMeshes[i]->setDirty(EBT_VERTEX);
+	}
+
+	void CSoftwareSkinningSystem::addSkinningTask(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh)
+	{
+		CSkinnedMesh::SJoint* arrayJoint = originalMesh->Joints.pointer();
+
+		CSkinnedMesh* sourceMesh = blendShapeMesh ? blendShapeMesh : originalMesh;
+
+		bool tangent = originalMesh->getMeshBuffer(0)->getVertexType() == video::EVT_SKIN_TANGENTS;
+
+		for (u32 i = 0, n = sourceMesh->getMeshBufferCount(); i < n; i++)
+		{
+			IVertexBuffer* originalVertexBuffer = sourceMesh->getMeshBuffer(i)->getVertexBuffer(0);
+			IVertexBuffer* vertexBuffer = skinnedMesh->getMeshBuffer(i)->getVertexBuffer(0);
+
+			SSkinningTask task;
+			task.Joints = arrayJoint;
+			task.Vertex = NULL;
+			task.VertexTangent = NULL;
+			task.Result = (video::S3DVertex*)vertexBuffer->getVertices();
+
+			if (tangent)
+				task.VertexTangent = (video::S3DVertexSkinTangents*)originalVertexBuffer->getVertices();
 			else
-				CSoftwareSkinningUtils::softwareSkinning(skinnedMesh, renderMesh, blendShapeMesh);
+				task.Vertex = (video::S3DVertexSkin*)originalVertexBuffer->getVertices();
+
+			// split the big mesh buffer to chunks
+			int numVertex = (int)originalVertexBuffer->getVertexCount();
+			for (int begin = 0; begin < numVertex; begin += SKINNING_BATCH)
+			{
+				task.Begin = begin;
+				task.End = core::min_(begin + SKINNING_BATCH, numVertex);
+				m_tasks.push_back(task);
+			}
 		}
 	}
+
+	void CSoftwareSkinningSystem::runSkinningTask(const SSkinningTask& task)
+	{
+		if (task.VertexTangent)
+			CSoftwareSkinningUtils::skinVertices(task.Joints, task.VertexTangent, task.Result, task.Begin, task.End);
+		else
+			CSoftwareSkinningUtils::skinVertices(task.Joints, task.Vertex, task.Result, task.Begin, task.End);
+	}
 }
\ No newline at end of file
@@ -33,6 +33,23 @@ namespace Skylicht
 {
 	class SKYLICHT_API CSoftwareSkinningSystem : public CMeshSystem
 	{
+	protected:
+		struct SSkinningTask
+		{
+			CSkinnedMesh::SJoint* Joints;
+			video::S3DVertexSkin* Vertex;
+			video::S3DVertexSkinTangents* VertexTangent;
+			video::S3DVertex* Result;
+			int Begin;
+			int End;
+		};
+
+		core::array<SSkinningTask> m_tasks;
+
+		core::array<CMesh*> m_skinnedMeshes;
+
+		bool m_parallelUpdate;
+
 	public:
 		CSoftwareSkinningSystem();
 
@@ -45,5 +62,22 @@ namespace Skylicht
 		virtual void init(CEntityManager* entityManager);
 
 		virtual void update(CEntityManager* entityManager);
+
+		// skin the vertex chunks on job system
+		inline void setParallelUpdate(bool b)
+		{
+			m_parallelUpdate = b;
+		}
+
+		inline bool isParallelUpdate()
+		{
+			return m_parallelUpdate;
+		}
+
+	protected:
+
+		void addSkinningTask(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh);
+
+		void runSkinningTask(const SSkinningTask& task);
 	};
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CBaseRP.h"
+#include "CRenderStateCache.h"
 #include "RenderMesh/CMesh.h"
 #include "Material/CMaterial.h"
 #include "Material/Shader/CShaderManager.h"
@@ -162,7 +163,7 @@ namespace Skylicht
 				updateShaderResource(shader, entity, entityId, irrMaterial);
 			}
 
-			CShaderMaterial::setMaterial(material);
+			CRenderStateCache::getInstance()->setShaderMaterial(material);
 		}
 	}
 
@@ -249,7 +250,6 @@ namespace Skylicht
 		updateTextureResource(mesh, bufferID, entity, entityID, skinnedMesh);
 
 		IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-		IVideoDriver* driver = getVideoDriver();
 
 		video::SMaterial& irrMaterial = mb->getMaterial();
 
@@ -258,10 +258,10 @@ namespace Skylicht
 		shaderMgr->setCurrentMeshBuffer(mb);
 
 		// set irrlicht material
-		driver->setMaterial(irrMaterial);
+		CRenderStateCache::getInstance()->setMaterial(irrMaterial);
 
 		// draw mesh buffer
-		driver->drawMeshBuffer(mb);
+		CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 	}
 
 	void CBaseRP::drawInstancingMeshBuffer(CMesh* mesh, int bufferID, CShader* instancingShader, CEntityManager* entity, int entityID, bool skinnedMesh)
@@ -269,7 +269,6 @@ namespace Skylicht
 		updateTextureResource(mesh, bufferID, entity, entityID, skinnedMesh);
 
 		IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-		IVideoDriver* driver = getVideoDriver();
 
 		video::SMaterial& irrMaterial = mb->getMaterial();
 		irrMaterial.MaterialType = instancingShader->getMaterialRenderID();
@@ -278,8 +277,8 @@ namespace Skylicht
 		shaderMgr->setCurrentMaterial(irrMaterial);
 		shaderMgr->setCurrentMeshBuffer(mb);
 
-		driver->setMaterial(irrMaterial);
-		driver->drawMeshBuffer(mb);
+		CRenderStateCache::getInstance()->setMaterial(irrMaterial);
+		CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 	}
 
 	void CBaseRP::beginRender2D(float w, float h)
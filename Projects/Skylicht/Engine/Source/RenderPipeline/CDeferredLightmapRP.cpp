@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CDeferredLightmapRP.h"
+#include "CRenderStateCache.h"
 #include "CForwardRP.h"
 #include "RenderMesh/CMesh.h"
 #include "Material/CMaterial.h"
@@ -250,10 +251,9 @@ namespace Skylicht
 
 			// set shader (uniform) material
 			if (mesh->Materials.size() > (u32)bufferID)
-				CShaderMaterial::setMaterial(mesh->Materials[bufferID]);
+				CRenderStateCache::getInstance()->setShaderMaterial(mesh->Materials[bufferID]);
 
 			IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-			IVideoDriver* driver = getVideoDriver();
 
 			video::SMaterial& material = mb->getMaterial();
 
@@ -266,10 +266,10 @@ namespace Skylicht
 				lightmapMat.setTexture(0, indirectData->IndirectTexture);
 
 				// set irrlicht material
-				driver->setMaterial(lightmapMat);
+				CRenderStateCache::getInstance()->setMaterial(lightmapMat);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 		}
 		else if (m_isDirectionalPass)
@@ -288,10 +288,9 @@ namespace Skylicht
 
 			// set shader (uniform) material
 			if (mesh->Materials.size() > (u32)bufferID)
-				CShaderMaterial::setMaterial(mesh->Materials[bufferID]);
+				CRenderStateCache::getInstance()->setShaderMaterial(mesh->Materials[bufferID]);
 
 			IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-			IVideoDriver* driver = getVideoDriver();
 
 			video::SMaterial& material = mb->getMaterial();
 
@@ -306,10 +305,10 @@ namespace Skylicht
 				CShaderManager::getInstance()->LightmapIndex = (float)lightmapData->LightmapIndex;
 
 				// set irrlicht material
-				driver->setMaterial(lightmapMat);
+				CRenderStateCache::getInstance()->setMaterial(lightmapMat);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 		}
 		else
@@ -320,16 +319,15 @@ namespace Skylicht
 				updateTextureResource(mesh, bufferID, entity, entityID, skinnedMesh);
 
 				IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-				IVideoDriver* driver = getVideoDriver();
 
 				video::SMaterial irrMaterial = mb->getMaterial();
 				irrMaterial.BackfaceCulling = false;
 
 				// set irrlicht material
-				driver->setMaterial(irrMaterial);
+				CRenderStateCache::getInstance()->setMaterial(irrMaterial);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 			else
 			{
@@ -353,14 +351,13 @@ namespace Skylicht
 			if (s_bakeMode == true)
 			{
 				IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-				IVideoDriver* driver = getVideoDriver();
 
 				video::SMaterial irrMaterial = mb->getMaterial();
 				irrMaterial.MaterialType = instancingShader->getMaterialRenderID();
 				irrMaterial.BackfaceCulling = false;
 
-				driver->setMaterial(irrMaterial);
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->setMaterial(irrMaterial);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 			else
 			{
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CDeferredRP.h"
+#include "CRenderStateCache.h"
 #include "CForwardRP.h"
 #include "RenderMesh/CMesh.h"
 #include "Material/CMaterial.h"
@@ -304,10 +305,9 @@ namespace Skylicht
 
 			// set shader (uniform) material
 			if (mesh->Materials.size() > (u32)bufferID)
-				CShaderMaterial::setMaterial(mesh->Materials[bufferID]);
+				CRenderStateCache::getInstance()->setShaderMaterial(mesh->Materials[bufferID]);
 
 			IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-			IVideoDriver* driver = getVideoDriver();
 
 			video::SMaterial& material = mb->getMaterial();
 
@@ -318,10 +318,10 @@ namespace Skylicht
 				vertexLightmap.MaterialType = m_lightmapVertexShader;
 
 				// set irrlicht material
-				driver->setMaterial(vertexLightmap);
+				CRenderStateCache::getInstance()->setMaterial(vertexLightmap);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 			else if (indirectData->Type == CIndirectLightingData::LightmapArray)
 			{
@@ -334,10 +334,10 @@ namespace Skylicht
 					indirectColor.setTexture(0, indirectData->IndirectTexture);
 
 					// set irrlicht material
-					driver->setMaterial(indirectColor);
+					CRenderStateCache::getInstance()->setMaterial(indirectColor);
 
 					// draw mesh buffer
-					driver->drawMeshBuffer(mb);
+					CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 				}
 			}
 			else if (indirectData->Type == CIndirectLightingData::SH9 && indirectData->SH)
@@ -349,10 +349,10 @@ namespace Skylicht
 				shMaterial.MaterialType = m_lightmapSHShader;
 
 				// set irrlicht material
-				driver->setMaterial(shMaterial);
+				CRenderStateCache::getInstance()->setMaterial(shMaterial);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 			else if (indirectData->Type == CIndirectLightingData::AmbientColor)
 			{
@@ -363,10 +363,10 @@ namespace Skylicht
 				shMaterial.MaterialType = m_lightmapColorShader;
 
 				// set irrlicht material
-				driver->setMaterial(shMaterial);
+				CRenderStateCache::getInstance()->setMaterial(shMaterial);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 		}
 		else
@@ -377,16 +377,15 @@ namespace Skylicht
 				updateTextureResource(mesh, bufferID, entity, entityID, skinnedMesh);
 
 				IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-				IVideoDriver* driver = getVideoDriver();
 
 				video::SMaterial irrMaterial = mb->getMaterial();
 				irrMaterial.BackfaceCulling = false;
 
 				// set irrlicht material
-				driver->setMaterial(irrMaterial);
+				CRenderStateCache::getInstance()->setMaterial(irrMaterial);
 
 				// draw mesh buffer
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 			else
 			{
@@ -414,9 +413,8 @@ namespace Skylicht
 				else if (size == sizeof(video::S3DVertexTangents))
 					irrMaterial.MaterialType = m_lmInstancingTBN;
 
-				IVideoDriver* driver = getVideoDriver();
-				driver->setMaterial(irrMaterial);
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->setMaterial(irrMaterial);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 		}
 		else
@@ -424,14 +422,13 @@ namespace Skylicht
 			if (s_bakeMode == true)
 			{
 				IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-				IVideoDriver* driver = getVideoDriver();
 
 				video::SMaterial irrMaterial = mb->getMaterial();
 				irrMaterial.MaterialType = instancingShader->getMaterialRenderID();
 				irrMaterial.BackfaceCulling = false;
 
-				driver->setMaterial(irrMaterial);
-				driver->drawMeshBuffer(mb);
+				CRenderStateCache::getInstance()->setMaterial(irrMaterial);
+				CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 			}
 			else
 			{
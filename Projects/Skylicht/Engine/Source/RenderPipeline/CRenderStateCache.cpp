@@ -0,0 +1,171 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CRenderStateCache.h"
+
+#include "Material/CMaterial.h"
+#include "Material/Shader/ShaderCallback/CShaderSH.h"
+#include "Material/Shader/ShaderCallback/CShaderLighting.h"
+#include "Material/Shader/ShaderCallback/CShaderMaterial.h"
+
+namespace Skylicht
+{
+	IMPLEMENT_SINGLETON(CRenderStateCache);
+
+	CRenderStateCache::CRenderStateCache() :
+		m_enable(true),
+		m_batching(false)
+	{
+		invalidate();
+	}
+
+	CRenderStateCache::~CRenderStateCache()
+	{
+
+	}
+
+	void CRenderStateCache::beginFrame()
+	{
+		m_lastFrameStats = m_stats;
+		m_stats.reset();
+		invalidate();
+	}
+
+	void CRenderStateCache::invalidate()
+	{
+		m_validMaterial = false;
+		m_validWorld = false;
+		m_validAmbient = false;
+		m_sh = NULL;
+		m_shaderMaterial = NULL;
+	}
+
+	void CRenderStateCache::beginBatch()
+	{
+		invalidate();
+		m_batching = m_enable;
+	}
+
+	void CRenderStateCache::endBatch()
+	{
+		m_batching = false;
+		invalidate();
+	}
+
+	void CRenderStateCache::setMaterial(const video::SMaterial& material)
+	{
+		if (m_batching && m_validMaterial && !(m_material != material))
+		{
+			m_stats.SkipState++;
+			return;
+		}
+
+		for (u32 i = 0; i < MATERIAL_MAX_TEXTURES; i++)
+		{
+			if (!m_validMaterial || m_material.getTexture(i) != material.getTexture(i))
+			{
+				if (material.getTexture(i) != NULL)
+					m_stats.TextureChange++;
+			}
+		}
+
+		m_material = material;
+		m_validMaterial = true;
+		m_stats.MaterialChange++;
+
+		getVideoDriver()->setMaterial(material);
+	}
+
+	void CRenderStateCache::setWorldTransform(const core::matrix4& world)
+	{
+		if (m_batching && m_validWorld && memcmp(m_world.pointer(), world.pointer(), sizeof(f32) * 16) == 0)
+		{
+			m_stats.SkipState++;
+			return;
+		}
+
+		m_world = world;
+		m_validWorld = true;
+		m_stats.TransformChange++;
+
+		getVideoDriver()->setTransform(video::ETS_WORLD, world);
+	}
+
+	void CRenderStateCache::setSH9(core::vector3df* sh)
+	{
+		if (m_batching && sh == m_sh)
+		{
+			m_stats.SkipState++;
+			return;
+		}
+
+		m_sh = sh;
+		m_validAmbient = false;
+		m_stats.UniformUpload++;
+
+		CShaderSH::setSH9(sh);
+	}
+
+	void CRenderStateCache::setLightAmbient(const SColor& color)
+	{
+		if (m_batching && m_validAmbient && m_ambient == color)
+		{
+			m_stats.SkipState++;
+			return;
+		}
+
+		m_ambient = color;
+		m_validAmbient = true;
+		m_stats.UniformUpload++;
+
+		CShaderLighting::setLightAmbient(color);
+	}
+
+	void CRenderStateCache::setShaderMaterial(CMaterial* material)
+	{
+		if (m_batching && material == m_shaderMaterial)
+		{
+			m_stats.SkipState++;
+			return;
+		}
+
+		m_shaderMaterial = material;
+		m_stats.UniformUpload++;
+
+		CShaderMaterial::setMaterial(material);
+	}
+
+	void CRenderStateCache::drawMeshBuffer(IMeshBuffer* mb)
+	{
+		m_stats.DrawCall++;
+		m_stats.Primitive += mb->getPrimitiveCount();
+
+		IVertexBuffer* vb = mb->getVertexBuffer(0);
+		if (vb != NULL)
+			m_stats.Vertex += vb->getVertexCount();
+
+		getVideoDriver()->drawMeshBuffer(mb);
+	}
+}
@@ -0,0 +1,140 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Utils/CSingleton.h"
+
+namespace Skylicht
+{
+	class CMaterial;
+
+	struct SRenderStats
+	{
+		u32 DrawCall;
+		u32 Primitive;
+		u32 Vertex;
+		u32 MaterialChange;
+		u32 TextureChange;
+		u32 TransformChange;
+		u32 UniformUpload;
+		u32 SkipState;
+
+		SRenderStats()
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			DrawCall = 0;
+			Primitive = 0;
+			Vertex = 0;
+			MaterialChange = 0;
+			TextureChange = 0;
+			TransformChange = 0;
+			UniformUpload = 0;
+			SkipState = 0;
+		}
+	};
+
+	/// @brief Cache the last state was sent to IVideoDriver by the mesh render path, skip the redundant binds and count the frame stats.
+	/// The state is only skipped between beginBatch/endBatch, where all binds go through this cache.
+	/// The counters do not depend on the driver, so they also work with CNullDriver.
+	class SKYLICHT_API CRenderStateCache
+	{
+	public:
+		DECLARE_SINGLETON(CRenderStateCache)
+
+	protected:
+		SRenderStats m_stats;
+		SRenderStats m_lastFrameStats;
+
+		bool m_enable;
+		bool m_batching;
+
+		bool m_validMaterial;
+		video::SMaterial m_material;
+
+		bool m_validWorld;
+		core::matrix4 m_world;
+
+		core::vector3df* m_sh;
+
+		bool m_validAmbient;
+		SColor m_ambient;
+
+		CMaterial* m_shaderMaterial;
+
+	public:
+		CRenderStateCache();
+
+		virtual ~CRenderStateCache();
+
+		/// @brief Save the stats to last frame and reset the counters
+		void beginFrame();
+
+		/// @brief Call when the driver state may be changed outside of the cache
+		void invalidate();
+
+		/// @brief Begin a draw loop, that all the state is set through this cache
+		void beginBatch();
+
+		void endBatch();
+
+		void setMaterial(const video::SMaterial& material);
+
+		void setWorldTransform(const core::matrix4& world);
+
+		void setSH9(core::vector3df* sh);
+
+		void setLightAmbient(const SColor& color);
+
+		void setShaderMaterial(CMaterial* material);
+
+		void drawMeshBuffer(IMeshBuffer* mb);
+
+		inline void setEnable(bool b)
+		{
+			m_enable = b;
+			m_batching = false;
+			invalidate();
+		}
+
+		inline bool isEnable()
+		{
+			return m_enable;
+		}
+
+		inline const SRenderStats& getStats()
+		{
+			return m_stats;
+		}
+
+		inline const SRenderStats& getLastFrameStats()
+		{
+			return m_lastFrameStats;
+		}
+	};
+}
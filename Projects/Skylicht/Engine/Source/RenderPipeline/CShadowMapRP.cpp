@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CShadowMapRP.h"
+#include "CRenderStateCache.h"
 #include "RenderMesh/CMesh.h"
 #include "Material/CMaterial.h"
 #include "Material/Shader/ShaderCallback/CShaderMaterial.h"
@@ -227,14 +228,13 @@ namespace Skylicht
 			if (material)
 				shader = material->getShader();
 
-			CShaderMaterial::setMaterial(material);
+			CRenderStateCache::getInstance()->setShaderMaterial(material);
 		}
 
 		if (shader && !shader->isDrawDepthShadow())
 			return;
 
 		IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-		IVideoDriver* driver = getVideoDriver();
 
 		CShaderManager* shaderMgr = CShaderManager::getInstance();
 
@@ -248,7 +248,7 @@ namespace Skylicht
 			else
 				m.MaterialType = m_texColorShader;
 
-			driver->setMaterial(m);
+			CRenderStateCache::getInstance()->setMaterial(m);
 			shaderMgr->setCurrentMaterial(m);
 		}
 		else
@@ -287,12 +287,12 @@ namespace Skylicht
 				}
 			}
 
-			driver->setMaterial(m_writeDepthMaterial);
+			CRenderStateCache::getInstance()->setMaterial(m_writeDepthMaterial);
 			shaderMgr->setCurrentMaterial(m_writeDepthMaterial);
 		}
 
 		// draw mesh buffer
-		driver->drawMeshBuffer(mb);
+		CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 	}
 
 	void CShadowMapRP::updateShaderResource(CShader* shader, CEntityManager* entity, int entityID, video::SMaterial& irrMaterial)
@@ -338,7 +338,6 @@ namespace Skylicht
 			return;
 
 		IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
-		IVideoDriver* driver = getVideoDriver();
 
 		u32 vertexSize = mb->getVertexBuffer()->getVertexSize();
 
@@ -427,8 +426,8 @@ namespace Skylicht
 		{
 			CShaderManager::getInstance()->setCurrentMaterial(m_writeDepthMaterial);
 
-			driver->setMaterial(m_writeDepthMaterial);
-			driver->drawMeshBuffer(mb);
+			CRenderStateCache::getInstance()->setMaterial(m_writeDepthMaterial);
+			CRenderStateCache::getInstance()->drawMeshBuffer(mb);
 		}
 	}
 
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CSceneExporter.h"
+#include "Serializable/CSerializableBinary.h"
 
 namespace Skylicht
 {
@@ -74,7 +75,7 @@ namespace Skylicht
 		delete data;
 	}
 
-	void CSceneExporter::exportScene(CScene* scene, const char* path)
+	CObjectSerializable* CSceneExporter::exportScene(CScene* scene)
 	{
 		CObjectSerializable* data = scene->createSerializable();
 
@@ -99,7 +100,20 @@ namespace Skylicht
 			++i;
 		}
 
+		return data;
+	}
+
+	void CSceneExporter::exportScene(CScene* scene, const char* path)
+	{
+		CObjectSerializable* data = exportScene(scene);
 		data->save(path);
 		delete data;
 	}
+
+	void CSceneExporter::exportSceneBinary(CScene* scene, const char* path)
+	{
+		CObjectSerializable* data = exportScene(scene);
+		CSerializableBinary::save(path, data);
+		delete data;
+	}
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CSceneImporter.h"
+#include "Serializable/CSerializableBinary.h"
 #include "Utils/CStringImp.h"
 
 namespace Skylicht
@@ -38,6 +39,29 @@ namespace Skylicht
 	std::list<CGameObject*> g_listGameObject;
 	std::list<CGameObject*>::iterator g_currentGameObject;
 
+	CObjectSerializable* g_sceneData = NULL;
+	std::list<CObjectSerializable*> g_listObjectData;
+	std::list<CObjectSerializable*>::iterator g_currentObjectData;
+
+	void CSceneImporter::addComponent(CGameObject* object, const char* componentName)
+	{
+		CComponentSystem* comSystem = object->getComponentByTypeName(componentName);
+		if (comSystem == NULL)
+		{
+			// try add component
+			if (object->addComponentByTypeName(componentName) == NULL)
+			{
+				char log[512];
+				sprintf(log, "[CSceneImporter] Found unsupport component '%s'", componentName);
+				os::Printer::log(log);
+
+				// unsupport component
+				CNullComponent* nullComponent = object->addComponent<CNullComponent>();
+				nullComponent->setName(componentName);
+			}
+		}
+	}
+
 	void CSceneImporter::buildComponent(CGameObject* object, io::IXMLReader* reader)
 	{
 		std::wstring nodeName = L"node";
@@ -60,22 +84,7 @@ namespace Skylicht
 					{
 						attributeName = reader->getAttributeValue(L"type");
 						std::string componentName = CStringImp::convertUnicodeToUTF8(attributeName.c_str());
-
-						CComponentSystem* comSystem = object->getComponentByTypeName(componentName.c_str());
-						if (comSystem == NULL)
-						{
-							// try add component
-							if (object->addComponentByTypeName(componentName.c_str()) == NULL)
-							{
-								char log[512];
-								sprintf(log, "[CSceneImporter] Found unsupport component '%s'", componentName.c_str());
-								os::Printer::log(log);
-
-								// unsupport component
-								CNullComponent* nullComponent = object->addComponent<CNullComponent>();
-								nullComponent->setName(componentName);
-							}
-						}
+						addComponent(object, componentName.c_str());
 					}
 				}
 				break;
@@ -175,6 +184,60 @@ namespace Skylicht
 		g_currentGameObject = g_listGameObject.begin();
 	}
 
+	void CSceneImporter::buildComponent(CGameObject* object, CObjectSerializable* data)
+	{
+		g_listGameObject.push_back(object);
+		g_listObjectData.push_back(data);
+
+		CObjectSerializable* coms = data->getProperty<CObjectSerializable>("Components");
+		if (coms == NULL)
+			return;
+
+		for (u32 i = 0, n = coms->getNumProperty(); i < n; i++)
+		{
+			CValueProperty* p = coms->getPropertyID(i);
+			if (p->getType() == EPropertyDataType::Object)
+				addComponent(object, p->Name.c_str());
+		}
+	}
+
+	void CSceneImporter::buildContainer(CContainerObject* container, CObjectSerializable* data)
+	{
+		buildComponent(container, data);
+
+		CObjectSerializable* childs = data->getProperty<CObjectSerializable>("Childs");
+		if (childs == NULL)
+			return;
+
+		for (u32 i = 0, n = childs->getNumProperty(); i < n; i++)
+		{
+			CObjectSerializable* childData = dynamic_cast<CObjectSerializable*>(childs->getPropertyID(i));
+			if (childData == NULL)
+				continue;
+
+			if (childData->Name == "CContainerObject")
+				buildContainer(container->createContainerObject(), childData);
+			else if (childData->Name == "CGameObject")
+				buildComponent(container->createEmptyObject(), childData);
+		}
+	}
+
+	void CSceneImporter::buildScene(CScene* scene, CObjectSerializable* data)
+	{
+		g_listGameObject.clear();
+		g_listObjectData.clear();
+
+		for (u32 i = 0, n = data->getNumProperty(); i < n; i++)
+		{
+			CObjectSerializable* zoneData = dynamic_cast<CObjectSerializable*>(data->getPropertyID(i));
+			if (zoneData != NULL && zoneData->Name == "CZone")
+				buildContainer(scene->createZone(), zoneData);
+		}
+
+		g_currentGameObject = g_listGameObject.begin();
+		g_currentObjectData = g_listObjectData.begin();
+	}
+
 	void CSceneImporter::exportGameObject(CObjectSerializable* data, CContainerObject* target)
 	{
 
@@ -182,6 +245,9 @@ namespace Skylicht
 
 	bool CSceneImporter::beginImportScene(CScene* scene, const char* file)
 	{
+		if (CSerializableBinary::isBinaryFile(file))
+			return beginImportBinaryScene(scene, file);
+
 		// step 1
 		// build scene object
 		g_sceneReader = getIrrlichtDevice()->getFileSystem()->createXMLReader(file);
@@ -202,6 +268,28 @@ namespace Skylicht
 		return true;
 	}
 
+	bool CSceneImporter::beginImportBinaryScene(CScene* scene, const char* file)
+	{
+		// step 1
+		// read all the scene data, then build scene object
+		CObjectSerializable* data = new CObjectSerializable(scene->getTypeName().c_str());
+		if (!CSerializableBinary::load(file, data))
+		{
+			delete data;
+			return false;
+		}
+
+		scene->loadSerializable(data);
+		buildScene(scene, data);
+
+		g_sceneData = data;
+		g_sceneReaderPath = file;
+		g_scene = scene;
+		g_loadingScene = 0;
+
+		return true;
+	}
+
 	bool CSceneImporter::loadStep(CScene* scene, io::IXMLReader* reader)
 	{
 		std::wstring nodeName = L"node";
@@ -256,6 +344,26 @@ namespace Skylicht
 		return g_currentGameObject == g_listGameObject.end();
 	}
 
+	bool CSceneImporter::loadStep(CScene* scene, CObjectSerializable* data)
+	{
+		int step = 0;
+
+		while (step < g_loadSceneStep && g_currentGameObject != g_listGameObject.end())
+		{
+			CGameObject* gameobject = *g_currentGameObject;
+			CObjectSerializable* objectData = *g_currentObjectData;
+			++g_currentGameObject;
+			++g_currentObjectData;
+			++g_loadingScene;
+			++step;
+
+			gameobject->loadSerializable(objectData);
+			gameobject->startComponent();
+		}
+
+		return g_currentGameObject == g_listGameObject.end();
+	}
+
 	float CSceneImporter::getLoadingPercent()
 	{
 		int size = (int)g_listGameObject.size();
@@ -266,7 +374,13 @@ namespace Skylicht
 	{
 		// step 2
 		// load object attribute
-		if (CSceneImporter::loadStep(g_scene, g_sceneReader))
+		bool finish = false;
+		if (g_sceneData)
+			finish = CSceneImporter::loadStep(g_scene, g_sceneData);
+		else
+			finish = CSceneImporter::loadStep(g_scene, g_sceneReader);
+
+		if (finish)
 		{
 			// drop
 			if (g_sceneReader)
@@ -275,6 +389,13 @@ namespace Skylicht
 				g_sceneReader = NULL;
 			}
 
+			if (g_sceneData)
+			{
+				delete g_sceneData;
+				g_sceneData = NULL;
+				g_listObjectData.clear();
+			}
+
 			// final index search object
 			g_scene->updateIndexSearchObject();
 			g_scene = NULL;
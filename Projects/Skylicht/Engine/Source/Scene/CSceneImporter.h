@@ -39,7 +39,19 @@ namespace Skylicht
 
 		static bool loadStep(CScene* scene, io::IXMLReader* reader);
 
+		static void buildComponent(CGameObject* object, CObjectSerializable* data);
+
+		static void buildContainer(CContainerObject* container, CObjectSerializable* data);
+
+		static void buildScene(CScene* scene, CObjectSerializable* data);
+
+		static bool loadStep(CScene* scene, CObjectSerializable* data);
+
+		static bool beginImportBinaryScene(CScene* scene, const char* path);
+
 	public:
+		static void addComponent(CGameObject* object, const char* componentName);
+
 		static void exportGameObject(CObjectSerializable* data, CContainerObject* target);
 
 		static bool beginImportScene(CScene* scene, const char* path);
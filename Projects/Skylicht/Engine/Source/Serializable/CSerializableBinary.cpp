@@ -0,0 +1,610 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSerializableBinary.h"
+#include "CValuePropertyTemplate.h"
+
+#include "Exporter/ExportResources.h"
+
+#define SERIALIZABLE_BINARY_VERSION 1
+
+namespace Skylicht
+{
+	static inline bool canRead(CMemoryStream* stream, u32 size)
+	{
+		return size <= stream->getSize() - stream->getPos();
+	}
+
+	static u32 getValueSize(io::E_ATTRIBUTE_TYPE type)
+	{
+		switch (type)
+		{
+		case io::EAT_INT:
+		case io::EAT_UINT:
+		case io::EAT_FLOAT:
+		case io::EAT_STRING:
+		case io::EAT_COLOR:
+			return sizeof(u32);
+		case io::EAT_BOOL:
+			return sizeof(char);
+		case io::EAT_VECTOR3D:
+			return sizeof(f32) * 3;
+		case io::EAT_QUATERNION:
+			return sizeof(f32) * 4;
+		case io::EAT_MATRIX:
+			return sizeof(f32) * 16;
+		default:
+			return 0;
+		}
+	}
+
+	u32 CSerializableBinary::SStringTable::getString(const char* s)
+	{
+		std::map<std::string, u32>::iterator i = Index.find(s);
+		if (i != Index.end())
+			return i->second;
+
+		u32 id = Count++;
+		Index[s] = id;
+		Block.writeData(s, (u32)strlen(s) + 1);
+		return id;
+	}
+
+	bool CSerializableBinary::isBinaryFile(const char* file)
+	{
+		io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(file);
+		if (readFile == NULL)
+			return false;
+
+		SAssetHeader header;
+		bool ret = false;
+
+		if (readFile->read(&header, sizeof(SAssetHeader)) == sizeof(SAssetHeader))
+			ret = strcmp(header.Sign, "SLT") == 0 && header.AssetType == (u32)AssetScene;
+
+		readFile->drop();
+		return ret;
+	}
+
+	bool CSerializableBinary::save(const char* file, CObjectSerializable* object)
+	{
+		CMemoryStream stream(4096);
+		if (!save(&stream, object))
+			return false;
+
+		io::IWriteFile* writeFile = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(file);
+		if (writeFile == NULL)
+			return false;
+
+		writeFile->write(stream.getData(), stream.getSize());
+		writeFile->drop();
+
+		object->setSavePath(file);
+		return true;
+	}
+
+	bool CSerializableBinary::save(CMemoryStream* stream, CObjectSerializable* object)
+	{
+		io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+
+		// all the names are written to the string table, the node only keep the id
+		SStringTable table;
+		CMemoryStream nodes(4096);
+		writeObject(&nodes, object, attr, table);
+
+		attr->drop();
+
+		SAssetHeader header;
+		strcpy(header.Sign, "SLT");
+		header.AssetType = (u32)AssetScene;
+		header.AssetVersion = SERIALIZABLE_BINARY_VERSION;
+		stream->writeData(&header, sizeof(SAssetHeader));
+
+		stream->writeUInt(table.Count);
+		stream->writeUInt(table.Block.getSize());
+		stream->writeStream(&table.Block);
+
+		stream->writeStream(&nodes);
+		return true;
+	}
+
+	void CSerializableBinary::writeObject(CMemoryStream* stream, CObjectSerializable* object, io::IAttributes* attr, SStringTable& table)
+	{
+		stream->writeUInt(table.getString(object->Name.c_str()));
+		stream->writeChar(object->isArray() ? 1 : 0);
+
+		// property block
+		attr->clear();
+		object->serialize(attr);
+		writeAttributes(stream, attr, table);
+
+		// child object
+		u32 numChild = 0;
+		for (u32 i = 0, n = object->getNumProperty(); i < n; i++)
+		{
+			if (object->getPropertyID(i)->getType() == EPropertyDataType::Object)
+				numChild++;
+		}
+
+		stream->writeUInt(numChild);
+
+		for (u32 i = 0, n = object->getNumProperty(); i < n; i++)
+		{
+			CValueProperty* p = object->getPropertyID(i);
+			if (p->getType() == EPropertyDataType::Object)
+				writeObject(stream, (CObjectSerializable*)p, attr, table);
+		}
+	}
+
+	void CSerializableBinary::writeAttributes(CMemoryStream* stream, io::IAttributes* attr, SStringTable& table)
+	{
+		// count the supported attributes first
+		u32 count = 0;
+		u32 numAttribute = attr->getAttributeCount();
+		for (u32 i = 0; i < numAttribute; i++)
+		{
+			switch (attr->getAttributeType(i))
+			{
+			case io::EAT_INT:
+			case io::EAT_UINT:
+			case io::EAT_FLOAT:
+			case io::EAT_BOOL:
+			case io::EAT_STRING:
+			case io::EAT_COLOR:
+			case io::EAT_VECTOR3D:
+			case io::EAT_QUATERNION:
+			case io::EAT_MATRIX:
+				count++;
+				break;
+			default:
+				break;
+			}
+		}
+
+		stream->writeUInt(count);
+
+		for (u32 i = 0; i < numAttribute; i++)
+		{
+			io::E_ATTRIBUTE_TYPE type = attr->getAttributeType(i);
+			u32 name = table.getString(attr->getAttributeName(i));
+
+			switch (type)
+			{
+			case io::EAT_INT:
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeInt(attr->getAttributeAsInt(i));
+				break;
+			case io::EAT_UINT:
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeUInt(attr->getAttributeAsUInt(i));
+				break;
+			case io::EAT_FLOAT:
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeFloat(attr->getAttributeAsFloat(i));
+				break;
+			case io::EAT_BOOL:
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeChar(attr->getAttributeAsBool(i) ? 1 : 0);
+				break;
+			case io::EAT_STRING:
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeUInt(table.getString(attr->getAttributeAsString(i).c_str()));
+				break;
+			case io::EAT_COLOR:
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeUInt(attr->getAttributeAsColor(i).color);
+				break;
+			case io::EAT_VECTOR3D:
+			{
+				core::vector3df v = attr->getAttributeAsVector3d(i);
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeData(&v.X, sizeof(f32) * 3);
+			}
+			break;
+			case io::EAT_QUATERNION:
+			{
+				core::quaternion q = attr->getAttributeAsQuaternion(i);
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeData(&q.X, sizeof(f32) * 4);
+			}
+			break;
+			case io::EAT_MATRIX:
+			{
+				core::matrix4 m = attr->getAttributeAsMatrix(i);
+				stream->writeUInt(name);
+				stream->writeChar((char)type);
+				stream->writeData(m.pointer(), sizeof(f32) * 16);
+			}
+			break;
+			default:
+				break;
+			}
+		}
+	}
+
+	bool CSerializableBinary::load(const char* file, CObjectSerializable* object)
+	{
+		io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(file);
+		if (readFile == NULL)
+			return false;
+
+		u32 size = (u32)readFile->getSize();
+
+		unsigned char* data = new unsigned char[size];
+		readFile->read(data, size);
+		readFile->drop();
+
+		CMemoryStream stream(data, size);
+		bool ret = load(&stream, object);
+
+		delete[] data;
+
+		if (ret)
+			object->setSavePath(file);
+
+		return ret;
+	}
+
+	bool CSerializableBinary::load(CMemoryStream* stream, CObjectSerializable* object)
+	{
+		if (stream->getSize() < sizeof(SAssetHeader))
+			return false;
+
+		SAssetHeader header;
+		stream->readData(&header, sizeof(SAssetHeader));
+
+		if (strcmp(header.Sign, "SLT") != 0 ||
+			header.AssetType != (u32)AssetScene ||
+			header.AssetVersion != SERIALIZABLE_BINARY_VERSION)
+		{
+			os::Printer::log("[CSerializableBinary::load] Wrong file format");
+			return false;
+		}
+
+		if (!canRead(stream, sizeof(u32) * 2))
+		{
+			os::Printer::log("[CSerializableBinary::load] Invalid string table");
+			return false;
+		}
+
+		// the string table point directly to the stream memory
+		u32 numString = stream->readUInt();
+		u32 blockSize = stream->readUInt();
+
+		const char* block = (const char*)stream->getData() + stream->getPos();
+		if (!canRead(stream, blockSize) ||
+			(blockSize > 0 && block[blockSize - 1] != 0))
+		{
+			os::Printer::log("[CSerializableBinary::load] Invalid string table");
+			return false;
+		}
+
+		std::vector<const char*> table;
+		table.reserve(core::min_(numString, blockSize));
+
+		for (u32 i = 0, pos = 0; i < numString && pos < blockSize; i++)
+		{
+			table.push_back(block + pos);
+			pos += (u32)strlen(block + pos) + 1;
+		}
+		stream->setPos(stream->getPos() + blockSize);
+
+		if (table.size() != numString)
+		{
+			os::Printer::log("[CSerializableBinary::load] Invalid string table");
+			return false;
+		}
+
+		const char* type = NULL;
+		if (!readString(stream, table, type) || !canRead(stream, sizeof(char)))
+		{
+			os::Printer::log("[CSerializableBinary::load] Invalid node data");
+			return false;
+		}
+		stream->readChar();
+
+		if (object->Name != type)
+		{
+			char log[512];
+			sprintf(log, "[CSerializableBinary::load] Skip wrong data: type: %s", object->Name.c_str());
+			os::Printer::log(log);
+			return false;
+		}
+
+		io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+		bool ret = readObject(stream, object, attr, table);
+		attr->drop();
+
+		if (!ret)
+		{
+			char log[512];
+			sprintf(log, "[CSerializableBinary::load] Invalid node data at: %u", stream->getPos());
+			os::Printer::log(log);
+		}
+
+		return ret;
+	}
+
+	bool CSerializableBinary::readString(CMemoryStream* stream, std::vector<const char*>& table, const char*& s)
+	{
+		if (!canRead(stream, sizeof(u32)))
+			return false;
+
+		u32 id = stream->readUInt();
+		if (id >= table.size())
+			return false;
+
+		s = table[id];
+		return true;
+	}
+
+	bool CSerializableBinary::readValueHeader(CMemoryStream* stream, std::vector<const char*>& table, const char*& name, io::E_ATTRIBUTE_TYPE& type)
+	{
+		if (!readString(stream, table, name) || !canRead(stream, sizeof(char)))
+			return false;
+
+		type = (io::E_ATTRIBUTE_TYPE)stream->readChar();
+
+		// the writer only write the types that have the size
+		u32 size = getValueSize(type);
+		return size > 0 && canRead(stream, size);
+	}
+
+	bool CSerializableBinary::readObject(CMemoryStream* stream, CObjectSerializable* object, io::IAttributes* attr, std::vector<const char*>& table)
+	{
+		CArraySerializable* arrayObject = NULL;
+		if (object->isArray())
+			arrayObject = dynamic_cast<CArraySerializable*>(object);
+
+		if (object->getNumProperty() > 0)
+		{
+			// for SerializableActivator
+			if (!readAttributes(stream, attr, table))
+				return false;
+			object->deserialize(attr);
+		}
+		else if (arrayObject != NULL && arrayObject->haveCreateElementFunction())
+		{
+			// create element and deserialize
+			if (!readAttributes(stream, attr, table))
+				return false;
+			arrayObject->resize(attr->getAttributeCount());
+			arrayObject->deserialize(attr);
+		}
+		else
+		{
+			// fast path: create the value property from the block
+			if (!initProperty(stream, object, table))
+				return false;
+		}
+
+		// only the declared properties can be reused, the child list (Childs) has many object with same name
+		u32 numDeclared = object->getNumProperty();
+
+		if (!canRead(stream, sizeof(u32)))
+			return false;
+
+		u32 numChild = stream->readUInt();
+		for (u32 i = 0; i < numChild; i++)
+		{
+			const char* name = NULL;
+			if (!readString(stream, table, name) || !canRead(stream, sizeof(char)))
+				return false;
+
+			bool isArray = stream->readChar() == 1;
+
+			bool newObject = true;
+			CObjectSerializable* data;
+
+			// activator
+			data = CSerializableActivator::getInstance()->createInstance(name);
+			if (data == NULL)
+			{
+				// try find the current object with the name
+				for (u32 j = 0; j < numDeclared && data == NULL; j++)
+				{
+					CValueProperty* p = object->getPropertyID(j);
+					if (p->Name == name)
+						data = dynamic_cast<CObjectSerializable*>(p);
+				}
+
+				if (data != NULL)
+				{
+					// use exist property
+					newObject = false;
+				}
+				else
+				{
+					if (isArray)
+						data = new CArraySerializable(name);
+					else
+						data = new CObjectSerializable(name);
+				}
+			}
+
+			bool ret = readObject(stream, data, attr, table);
+
+			if (newObject)
+			{
+				object->addProperty(data);
+				object->autoRelease(data);
+			}
+
+			if (!ret)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool CSerializableBinary::readAttributes(CMemoryStream* stream, io::IAttributes* attr, std::vector<const char*>& table)
+	{
+		attr->clear();
+
+		if (!canRead(stream, sizeof(u32)))
+			return false;
+
+		u32 count = stream->readUInt();
+		for (u32 i = 0; i < count; i++)
+		{
+			const char* name = NULL;
+			io::E_ATTRIBUTE_TYPE type;
+			if (!readValueHeader(stream, table, name, type))
+				return false;
+
+			switch (type)
+			{
+			case io::EAT_INT:
+				attr->addInt(name, stream->readInt());
+				break;
+			case io::EAT_UINT:
+				attr->addUInt(name, stream->readUInt());
+				break;
+			case io::EAT_FLOAT:
+				attr->addFloat(name, stream->readFloat());
+				break;
+			case io::EAT_BOOL:
+				attr->addBool(name, stream->readChar() == 1);
+				break;
+			case io::EAT_STRING:
+			{
+				const char* value = NULL;
+				if (!readString(stream, table, value))
+					return false;
+				attr->addString(name, value);
+			}
+			break;
+			case io::EAT_COLOR:
+				attr->addColor(name, video::SColor(stream->readUInt()));
+				break;
+			case io::EAT_VECTOR3D:
+			{
+				core::vector3df v;
+				stream->readData(&v.X, sizeof(f32) * 3);
+				attr->addVector3d(name, v);
+			}
+			break;
+			case io::EAT_QUATERNION:
+			{
+				core::quaternion q;
+				stream->readData(&q.X, sizeof(f32) * 4);
+				attr->addQuaternion(name, q);
+			}
+			break;
+			case io::EAT_MATRIX:
+			{
+				core::matrix4 m;
+				stream->readData(m.pointer(), sizeof(f32) * 16);
+				attr->addMatrix(name, m);
+			}
+			break;
+			default:
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	bool CSerializableBinary::initProperty(CMemoryStream* stream, CObjectSerializable* object, std::vector<const char*>& table)
+	{
+		if (!canRead(stream, sizeof(u32)))
+			return false;
+
+		u32 count = stream->readUInt();
+		for (u32 i = 0; i < count; i++)
+		{
+			const char* name = NULL;
+			io::E_ATTRIBUTE_TYPE type;
+			if (!readValueHeader(stream, table, name, type))
+				return false;
+
+			CValueProperty* valueProperty = NULL;
+
+			switch (type)
+			{
+			case io::EAT_INT:
+				valueProperty = new CIntProperty(object, name, stream->readInt());
+				break;
+			case io::EAT_UINT:
+				valueProperty = new CUIntProperty(object, name, stream->readUInt());
+				break;
+			case io::EAT_FLOAT:
+				valueProperty = new CFloatProperty(object, name, stream->readFloat());
+				break;
+			case io::EAT_BOOL:
+				valueProperty = new CBoolProperty(object, name, stream->readChar() == 1);
+				break;
+			case io::EAT_STRING:
+			{
+				const char* value = NULL;
+				if (!readString(stream, table, value))
+					return false;
+				valueProperty = new CStringProperty(object, name, value);
+			}
+			break;
+			case io::EAT_COLOR:
+				valueProperty = new CColorProperty(object, name, video::SColor(stream->readUInt()));
+				break;
+			case io::EAT_VECTOR3D:
+			{
+				core::vector3df v;
+				stream->readData(&v.X, sizeof(f32) * 3);
+				valueProperty = new CVector3Property(object, name, v);
+			}
+			break;
+			case io::EAT_QUATERNION:
+			{
+				core::quaternion q;
+				stream->readData(&q.X, sizeof(f32) * 4);
+				valueProperty = new CQuaternionProperty(object, name, q);
+			}
+			break;
+			case io::EAT_MATRIX:
+			{
+				core::matrix4 m;
+				stream->readData(m.pointer(), sizeof(f32) * 16);
+				valueProperty = new CMatrixProperty(object, name, m);
+			}
+			break;
+			default:
+				break;
+			}
+
+			if (valueProperty)
+				object->autoRelease(valueProperty);
+		}
+
+		return true;
+	}
+}
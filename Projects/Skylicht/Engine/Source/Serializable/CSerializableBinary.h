@@ -0,0 +1,83 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CObjectSerializable.h"
+#include "CArraySerializable.h"
+#include "Utils/CMemoryStream.h"
+
+namespace Skylicht
+{
+	/*
+	Binary layout of the serializable tree (.sbin)
+	- SAssetHeader: "SLT", AssetScene, version
+	- String table: u32 count, u32 size, block of null-terminated strings
+	- Node: u32 type, u8 array, property block, u32 child count, child nodes
+	- Property block: u32 count, then [u32 name, u8 E_ATTRIBUTE_TYPE, value]
+	*/
+	class SKYLICHT_API CSerializableBinary
+	{
+	protected:
+		struct SStringTable
+		{
+			std::map<std::string, u32> Index;
+			CMemoryStream Block;
+			u32 Count;
+
+			SStringTable() :
+				Count(0)
+			{
+			}
+
+			u32 getString(const char* s);
+		};
+
+		static void writeObject(CMemoryStream* stream, CObjectSerializable* object, io::IAttributes* attr, SStringTable& table);
+
+		static void writeAttributes(CMemoryStream* stream, io::IAttributes* attr, SStringTable& table);
+
+		// the read functions return false when the stream is truncated or a string id is out of the table
+		static bool readString(CMemoryStream* stream, std::vector<const char*>& table, const char*& s);
+
+		static bool readValueHeader(CMemoryStream* stream, std::vector<const char*>& table, const char*& name, io::E_ATTRIBUTE_TYPE& type);
+
+		static bool readObject(CMemoryStream* stream, CObjectSerializable* object, io::IAttributes* attr, std::vector<const char*>& table);
+
+		static bool readAttributes(CMemoryStream* stream, io::IAttributes* attr, std::vector<const char*>& table);
+
+		static bool initProperty(CMemoryStream* stream, CObjectSerializable* object, std::vector<const char*>& table);
+
+	public:
+		static bool isBinaryFile(const char* file);
+
+		static bool save(const char* file, CObjectSerializable* object);
+
+		static bool save(CMemoryStream* stream, CObjectSerializable* object);
+
+		static bool load(const char* file, CObjectSerializable* object);
+
+		static bool load(CMemoryStream* stream, CObjectSerializable* object);
+	};
+}
@@ -38,6 +38,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Material/Shader/CShaderManager.h"
 #include "Graphics2D/CGraphics2D.h"
 #include "Shadow/CShadowRTTManager.h"
+#include "RenderPipeline/CRenderStateCache.h"
 
 // Mesh & Texture
 #include "MeshManager/CMeshManager.h"
@@ -46,6 +47,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Graphics2D/SpriteFrame/CSpriteManager.h"
 #include "Graphics2D/SpriteFrame/CFontManager.h"
 #include "Debug/CSceneDebug.h"
+#include "Streaming/CStreamingLoader.h"
 
 // Tween
 #include "Tween/CTweenManager.h"
@@ -58,6 +60,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Graphics2D/Glyph/CGlyphFreetype.h"
 
+#include "Job/CJobSystem.h"
+
 
 namespace Skylicht
 {
@@ -73,6 +77,8 @@ namespace Skylicht
 		g_video = device->getVideoDriver();
 
 		os::Printer::log("Init Skylicht Engine");
+		SkylichtSystem::CJobSystem::createInstance();
+
 		CEventManager::createGetInstance();
 
 		CTouchManager::createGetInstance();
@@ -91,6 +97,8 @@ namespace Skylicht
 		CFontManager::createGetInstance();
 
 		CShadowRTTManager::createGetInstance();
+		CRenderStateCache::createGetInstance();
+		CStreamingLoader::createGetInstance();
 
 		CTweenManager::createGetInstance();
 		CActivator::createGetInstance();
@@ -111,6 +119,9 @@ namespace Skylicht
 	{
 		os::Printer::log("Close skylicht core");
 
+		// stop streaming thread before release the managers
+		CStreamingLoader::releaseInstance();
+
 		CSceneDebug::releaseInstance();
 
 		CComponentCategory::releaseInstance();
@@ -119,6 +130,7 @@ namespace Skylicht
 		CSerializableActivator::releaseInstance();
 		CTweenManager::releaseInstance();
 
+		CRenderStateCache::releaseInstance();
 		CShadowRTTManager::releaseInstance();
 
 		CFontManager::releaseInstance();
@@ -137,6 +149,8 @@ namespace Skylicht
 		CJoystick::releaseInstance();
 
 		CEventManager::releaseInstance();
+
+		SkylichtSystem::CJobSystem::releaseInstance();
 	}
 
 	void updateSkylicht()
@@ -145,6 +159,15 @@ namespace Skylicht
 		CAccelerometer::getInstance()->update();
 		CJoystick::getInstance()->update();
 		CTweenManager::getInstance()->update();
+
+		// create the textures that are requested from other threads
+		CTextureManager::getInstance()->updateTextureRequest();
+
+		// finalize the streaming resources
+		CStreamingLoader::getInstance()->update();
+
+		// new frame render stats
+		CRenderStateCache::getInstance()->beginFrame();
 	}
 
 	IrrlichtDevice* getIrrlichtDevice()
@@ -0,0 +1,204 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CModelStreamingTask.h"
+#include "CStreamingLoader.h"
+
+#include "MeshManager/CMeshManager.h"
+#include "TextureManager/CTextureManager.h"
+#include "Importer/Skylicht/CSkylichtMeshLoader.h"
+#include "Utils/CPath.h"
+
+namespace Skylicht
+{
+	CModelStreamingTask::CModelStreamingTask(const char* resource,
+		const char* texturePath,
+		bool loadNormalMap,
+		bool flipNormalMap,
+		bool loadTexcoord2,
+		std::function<void(CEntityPrefab*)> callback) :
+		m_resource(resource),
+		m_texturePath(texturePath == NULL ? "" : texturePath),
+		m_loadNormalMap(loadNormalMap),
+		m_flipNormalMap(flipNormalMap),
+		m_loadTexcoord2(loadTexcoord2),
+		m_prefab(NULL),
+		m_addedPrefab(false),
+		m_finalizeImage(0),
+		m_callback(callback)
+	{
+
+	}
+
+	CModelStreamingTask::~CModelStreamingTask()
+	{
+		for (SImage& img : m_images)
+		{
+			if (img.Image)
+				img.Image->drop();
+		}
+
+		if (m_prefab && !m_addedPrefab)
+			delete m_prefab;
+	}
+
+	void CModelStreamingTask::load()
+	{
+		// only the skylicht mesh format is safe to read on the streaming thread
+		// other formats are loaded by CMeshManager on finalize
+		if (CPath::getFileNameExt(m_resource) != "smesh")
+			return;
+
+		CSkylichtMeshLoader importer;
+
+		if (!m_texturePath.empty())
+			importer.addTextureFolder(m_texturePath.c_str());
+
+		std::string baseFolderPath = CPath::getFolderPath(m_resource);
+		importer.addTextureFolder(baseFolderPath.c_str());
+
+		CRenderMeshData::setImportTextureFolder(importer.getTextureFolder());
+		CRenderMeshData::setDeferTexture(&m_textures);
+
+		m_prefab = new CEntityPrefab();
+		if (!importer.loadModel(m_resource.c_str(), m_prefab, m_loadNormalMap, m_flipNormalMap, m_loadTexcoord2, false))
+		{
+			delete m_prefab;
+			m_prefab = NULL;
+		}
+
+		CRenderMeshData::setDeferTexture(NULL);
+
+		if (m_prefab == NULL)
+		{
+			m_textures.clear();
+			return;
+		}
+
+		// decode the images, each path only once
+		std::vector<std::string>& folders = importer.getTextureFolder();
+		CTextureManager* textureMgr = CTextureManager::getInstance();
+
+		for (CRenderMeshData::SDeferTexture& t : m_textures)
+		{
+			bool found = false;
+			for (SImage& img : m_images)
+			{
+				if (img.Path == t.Path)
+				{
+					found = true;
+					break;
+				}
+			}
+
+			if (found)
+				continue;
+
+			SImage img;
+			img.Path = t.Path;
+			img.Image = textureMgr->loadImage(t.Path.c_str(), folders, img.TextureName);
+			img.Texture = NULL;
+			m_images.push_back(img);
+		}
+	}
+
+	bool CModelStreamingTask::finalize(CStreamingLoader* loader)
+	{
+		if (CPath::getFileNameExt(m_resource) != "smesh")
+		{
+			m_prefab = CMeshManager::getInstance()->loadModel(
+				m_resource.c_str(),
+				m_texturePath.c_str(),
+				m_loadNormalMap,
+				m_flipNormalMap,
+				m_loadTexcoord2,
+				false);
+			m_addedPrefab = true;
+
+			if (m_callback)
+				m_callback(m_prefab);
+
+			return true;
+		}
+
+		// create one texture on each step
+		CTextureManager* textureMgr = CTextureManager::getInstance();
+		u32 numImage = (u32)m_images.size();
+
+		while (m_finalizeImage < numImage)
+		{
+			SImage& img = m_images[m_finalizeImage++];
+			if (img.Image)
+			{
+				img.Texture = textureMgr->uploadTexture(img.TextureName.c_str(), img.Image);
+				img.Image->drop();
+				img.Image = NULL;
+			}
+
+			if (m_finalizeImage < numImage && loader->isTimeout())
+				return false;
+		}
+
+		finishModel();
+		return true;
+	}
+
+	void CModelStreamingTask::finishModel()
+	{
+		for (CRenderMeshData::SDeferTexture& t : m_textures)
+		{
+			for (SImage& img : m_images)
+			{
+				if (img.Path == t.Path)
+				{
+					CRenderMeshData::applyTexture(t.MeshBuffer, t.Slot, img.Texture, t.SkinnedMesh);
+					break;
+				}
+			}
+		}
+		m_textures.clear();
+
+		if (m_prefab)
+		{
+			// the model maybe loaded on main thread, while it is streaming
+			CEntityPrefab* prefab = CMeshManager::getInstance()->addPrefab(m_resource.c_str(), m_prefab);
+			if (prefab != m_prefab)
+			{
+				delete m_prefab;
+				m_prefab = prefab;
+			}
+			m_addedPrefab = true;
+		}
+		else
+		{
+			char log[512];
+			sprintf(log, "[CModelStreamingTask] Can not load model: %s", m_resource.c_str());
+			os::Printer::log(log);
+		}
+
+		if (m_callback)
+			m_callback(m_prefab);
+	}
+}
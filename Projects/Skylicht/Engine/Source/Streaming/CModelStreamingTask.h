@@ -0,0 +1,95 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CStreamingTask.h"
+#include "Entity/CEntityPrefab.h"
+#include "RenderMesh/CRenderMeshData.h"
+
+#include <functional>
+
+namespace Skylicht
+{
+	class SKYLICHT_API CModelStreamingTask : public CStreamingTask
+	{
+	protected:
+		struct SImage
+		{
+			std::string Path;
+			std::string TextureName;
+			IImage* Image;
+			ITexture* Texture;
+		};
+
+		std::string m_resource;
+		std::string m_texturePath;
+
+		bool m_loadNormalMap;
+		bool m_flipNormalMap;
+		bool m_loadTexcoord2;
+
+		CEntityPrefab* m_prefab;
+
+		// the prefab is owned by CMeshManager
+		bool m_addedPrefab;
+
+		// the mesh buffer textures, that wait main thread create the texture
+		std::vector<CRenderMeshData::SDeferTexture> m_textures;
+
+		std::vector<SImage> m_images;
+
+		u32 m_finalizeImage;
+
+		std::function<void(CEntityPrefab*)> m_callback;
+
+	public:
+		CModelStreamingTask(const char* resource,
+			const char* texturePath,
+			bool loadNormalMap,
+			bool flipNormalMap,
+			bool loadTexcoord2,
+			std::function<void(CEntityPrefab*)> callback);
+
+		virtual ~CModelStreamingTask();
+
+		virtual void load();
+
+		virtual bool finalize(CStreamingLoader* loader);
+
+		inline const std::string& getResource()
+		{
+			return m_resource;
+		}
+
+		inline CEntityPrefab* getPrefab()
+		{
+			return m_prefab;
+		}
+
+	protected:
+
+		void finishModel();
+	};
+}
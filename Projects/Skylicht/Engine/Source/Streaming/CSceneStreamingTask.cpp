@@ -0,0 +1,228 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSceneStreamingTask.h"
+#include "CStreamingLoader.h"
+
+#include "Scene/CSceneImporter.h"
+#include "Serializable/CSerializableBinary.h"
+
+namespace Skylicht
+{
+	CSceneStreamingTask::CSceneStreamingTask(CScene* scene, const char* path, std::function<void(std::vector<CZone*>&)> callback) :
+		m_scene(scene),
+		m_path(path),
+		m_data(NULL),
+		m_build(false),
+		m_finalizeModel(0),
+		m_finalizeObject(0),
+		m_callback(callback)
+	{
+
+	}
+
+	CSceneStreamingTask::~CSceneStreamingTask()
+	{
+		for (CModelStreamingTask* task : m_models)
+			delete task;
+
+		if (m_data)
+			delete m_data;
+	}
+
+	void CSceneStreamingTask::load()
+	{
+		if (!CSerializableBinary::isBinaryFile(m_path.c_str()))
+		{
+			char log[512];
+			sprintf(log, "[CSceneStreamingTask] Only support stream binary scene: %s", m_path.c_str());
+			os::Printer::log(log);
+			return;
+		}
+
+		m_data = new CObjectSerializable("CScene");
+		if (!CSerializableBinary::load(m_path.c_str(), m_data))
+		{
+			delete m_data;
+			m_data = NULL;
+			return;
+		}
+
+		// read the models of scene on this thread
+		loadModels(m_data);
+
+		for (CModelStreamingTask* task : m_models)
+		{
+			task->setState(CStreamingTask::Loading);
+			task->load();
+			task->setState(CStreamingTask::Loaded);
+		}
+	}
+
+	void CSceneStreamingTask::loadModels(CObjectSerializable* data)
+	{
+		if (data->Name == "CRenderMesh")
+		{
+			std::string meshFile = data->get<std::string>("mesh", "");
+			if (meshFile.empty())
+				return;
+
+			for (CModelStreamingTask* task : m_models)
+			{
+				if (task->getResource() == meshFile)
+					return;
+			}
+
+			CModelStreamingTask* task = new CModelStreamingTask(
+				meshFile.c_str(),
+				"",
+				data->get<bool>("load normal", true),
+				data->get<bool>("inserse normal", true),
+				data->get<bool>("load texcoord2", false),
+				nullptr);
+			m_models.push_back(task);
+			return;
+		}
+
+		for (u32 i = 0, n = data->getNumProperty(); i < n; i++)
+		{
+			CValueProperty* p = data->getPropertyID(i);
+			if (p->getType() == EPropertyDataType::Object)
+			{
+				CObjectSerializable* child = dynamic_cast<CObjectSerializable*>(p);
+				if (child != NULL)
+					loadModels(child);
+			}
+		}
+	}
+
+	bool CSceneStreamingTask::finalize(CStreamingLoader* loader)
+	{
+		if (m_data == NULL)
+		{
+			if (m_callback)
+				m_callback(m_zones);
+			return true;
+		}
+
+		// step 1: the models, that CRenderMesh will get from CMeshManager
+		u32 numModel = (u32)m_models.size();
+		while (m_finalizeModel < numModel)
+		{
+			if (!m_models[m_finalizeModel]->finalize(loader))
+				return false;
+
+			++m_finalizeModel;
+			if (loader->isTimeout())
+				return false;
+		}
+
+		// step 2: create the objects and components
+		if (!m_build)
+		{
+			buildScene();
+			m_build = true;
+
+			if (loader->isTimeout())
+				return false;
+		}
+
+		// step 3: load the object attributes
+		u32 numObject = (u32)m_objects.size();
+		while (m_finalizeObject < numObject)
+		{
+			SObjectData& o = m_objects[m_finalizeObject++];
+			o.Object->loadSerializable(o.Data);
+			o.Object->startComponent();
+
+			if (m_finalizeObject < numObject && loader->isTimeout())
+				return false;
+		}
+
+		m_scene->updateAddRemoveObject();
+		m_scene->updateIndexSearchObject();
+
+		if (m_callback)
+			m_callback(m_zones);
+
+		return true;
+	}
+
+	void CSceneStreamingTask::buildScene()
+	{
+		m_scene->loadSerializable(m_data);
+
+		for (u32 i = 0, n = m_data->getNumProperty(); i < n; i++)
+		{
+			CObjectSerializable* zoneData = dynamic_cast<CObjectSerializable*>(m_data->getPropertyID(i));
+			if (zoneData != NULL && zoneData->Name == "CZone")
+			{
+				CZone* zone = m_scene->createZone();
+				m_zones.push_back(zone);
+				buildContainer(zone, zoneData);
+			}
+		}
+	}
+
+	void CSceneStreamingTask::buildContainer(CContainerObject* container, CObjectSerializable* data)
+	{
+		buildComponent(container, data);
+
+		CObjectSerializable* childs = data->getProperty<CObjectSerializable>("Childs");
+		if (childs == NULL)
+			return;
+
+		for (u32 i = 0, n = childs->getNumProperty(); i < n; i++)
+		{
+			CObjectSerializable* childData = dynamic_cast<CObjectSerializable*>(childs->getPropertyID(i));
+			if (childData == NULL)
+				continue;
+
+			if (childData->Name == "CContainerObject")
+				buildContainer(container->createContainerObject(), childData);
+			else if (childData->Name == "CGameObject")
+				buildComponent(container->createEmptyObject(), childData);
+		}
+	}
+
+	void CSceneStreamingTask::buildComponent(CGameObject* object, CObjectSerializable* data)
+	{
+		SObjectData o;
+		o.Object = object;
+		o.Data = data;
+		m_objects.push_back(o);
+
+		CObjectSerializable* coms = data->getProperty<CObjectSerializable>("Components");
+		if (coms == NULL)
+			return;
+
+		for (u32 i = 0, n = coms->getNumProperty(); i < n; i++)
+		{
+			CValueProperty* p = coms->getPropertyID(i);
+			if (p->getType() == EPropertyDataType::Object)
+				CSceneImporter::addComponent(object, p->Name.c_str());
+		}
+	}
+}
@@ -0,0 +1,91 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CStreamingTask.h"
+#include "CModelStreamingTask.h"
+#include "Scene/CScene.h"
+#include "Serializable/CObjectSerializable.h"
+
+#include <functional>
+
+namespace Skylicht
+{
+	/// @brief Stream the binary scene (.sbin) to the scene.
+	/// The file and the .smesh models are read on the streaming thread, the objects are created on main thread in many frames.
+	class SKYLICHT_API CSceneStreamingTask : public CStreamingTask
+	{
+	protected:
+		struct SObjectData
+		{
+			CGameObject* Object;
+			CObjectSerializable* Data;
+		};
+
+		CScene* m_scene;
+
+		std::string m_path;
+
+		CObjectSerializable* m_data;
+
+		std::vector<CModelStreamingTask*> m_models;
+
+		std::vector<SObjectData> m_objects;
+
+		std::vector<CZone*> m_zones;
+
+		bool m_build;
+
+		u32 m_finalizeModel;
+
+		u32 m_finalizeObject;
+
+		std::function<void(std::vector<CZone*>&)> m_callback;
+
+	public:
+		CSceneStreamingTask(CScene* scene, const char* path, std::function<void(std::vector<CZone*>&)> callback);
+
+		virtual ~CSceneStreamingTask();
+
+		virtual void load();
+
+		virtual bool finalize(CStreamingLoader* loader);
+
+		inline std::vector<CZone*>& getZones()
+		{
+			return m_zones;
+		}
+
+	protected:
+
+		void loadModels(CObjectSerializable* data);
+
+		void buildScene();
+
+		void buildContainer(CContainerObject* container, CObjectSerializable* data);
+
+		void buildComponent(CGameObject* object, CObjectSerializable* data);
+	};
+}
@@ -0,0 +1,211 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CStreamingLoader.h"
+
+namespace Skylicht
+{
+	IMPLEMENT_SINGLETON(CStreamingLoader);
+
+	CStreamingLoader::CStreamingLoader() :
+		m_thread(NULL),
+		m_threadRunning(false),
+		m_createThread(false),
+		m_frameBudget(4.0f)
+	{
+		m_mutex = SkylichtSystem::IMutex::createMutex();
+	}
+
+	CStreamingLoader::~CStreamingLoader()
+	{
+		if (m_thread)
+		{
+			// IThread::stop only join the thread that is started
+			while (!m_threadRunning)
+				SkylichtSystem::IThread::sleep(1);
+
+			m_thread->stop();
+			delete m_thread;
+		}
+
+		for (CStreamingTask* task : m_tasks)
+			delete task;
+		m_tasks.clear();
+		m_queue.clear();
+
+		delete m_mutex;
+	}
+
+	void CStreamingLoader::loadTexture(const char* path, std::function<void(ITexture*)> callback)
+	{
+		addTask(new CTextureStreamingTask(path, callback));
+	}
+
+	void CStreamingLoader::loadModel(const char* resource,
+		const char* texturePath,
+		bool loadNormalMap,
+		bool flipNormalMap,
+		bool loadTexcoord2,
+		std::function<void(CEntityPrefab*)> callback)
+	{
+		addTask(new CModelStreamingTask(resource, texturePath, loadNormalMap, flipNormalMap, loadTexcoord2, callback));
+	}
+
+	void CStreamingLoader::loadScene(CScene* scene, const char* path, std::function<void(std::vector<CZone*>&)> callback)
+	{
+		addTask(new CSceneStreamingTask(scene, path, callback));
+	}
+
+	void CStreamingLoader::addTask(CStreamingTask* task)
+	{
+		task->setState(CStreamingTask::Queued);
+		m_tasks.push_back(task);
+
+		{
+			SkylichtSystem::SScopeMutex lock(m_mutex);
+			m_queue.push_back(task);
+		}
+
+		// the thread is created at the first task, it is NULL if the platform has no thread
+		if (!m_createThread)
+		{
+			m_thread = SkylichtSystem::IThread::createThread(this);
+			m_createThread = true;
+		}
+	}
+
+	CStreamingTask* CStreamingLoader::popTask()
+	{
+		SkylichtSystem::SScopeMutex lock(m_mutex);
+		if (m_queue.size() == 0)
+			return NULL;
+
+		CStreamingTask* task = m_queue.front();
+		m_queue.pop_front();
+		return task;
+	}
+
+	void CStreamingLoader::loadTask(CStreamingTask* task)
+	{
+		task->setState(CStreamingTask::Loading);
+		task->load();
+		task->setState(CStreamingTask::Loaded);
+	}
+
+	void CStreamingLoader::runThread()
+	{
+		m_threadRunning = true;
+	}
+
+	void CStreamingLoader::updateThread()
+	{
+		CStreamingTask* task = popTask();
+		if (task == NULL)
+		{
+			SkylichtSystem::IThread::sleep(1);
+			return;
+		}
+
+		loadTask(task);
+	}
+
+	bool CStreamingLoader::isTimeout()
+	{
+		return std::chrono::steady_clock::now() >= m_deadline;
+	}
+
+	bool CStreamingLoader::finalizeTasks()
+	{
+		bool finalized = false;
+
+		u32 i = 0;
+		while (i < m_tasks.size())
+		{
+			CStreamingTask* task = m_tasks[i];
+			if (task->getState() != CStreamingTask::Loaded)
+			{
+				++i;
+				continue;
+			}
+
+			finalized = true;
+
+			if (task->finalize(this))
+			{
+				task->setState(CStreamingTask::Finished);
+				m_tasks.erase(m_tasks.begin() + i);
+				delete task;
+			}
+			else
+			{
+				// out of budget
+				return true;
+			}
+
+			if (isTimeout())
+				break;
+		}
+
+		return finalized;
+	}
+
+	void CStreamingLoader::update()
+	{
+		if (m_tasks.size() == 0)
+			return;
+
+		// no thread support, load one task each frame
+		if (m_thread == NULL)
+		{
+			CStreamingTask* task = popTask();
+			if (task)
+				loadTask(task);
+		}
+
+		m_deadline = std::chrono::steady_clock::now() +
+			std::chrono::microseconds((long long)(m_frameBudget * 1000.0f));
+
+		finalizeTasks();
+	}
+
+	void CStreamingLoader::finishAll()
+	{
+		while (m_tasks.size() > 0)
+		{
+			if (m_thread == NULL)
+			{
+				CStreamingTask* task = popTask();
+				if (task)
+					loadTask(task);
+			}
+
+			// no limit
+			m_deadline = std::chrono::steady_clock::time_point::max();
+
+			if (!finalizeTasks())
+				SkylichtSystem::IThread::sleep(1);
+		}
+	}
+}
@@ -0,0 +1,120 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Utils/CSingleton.h"
+#include "Thread/IThread.h"
+#include "Thread/IMutex.h"
+
+#include "CStreamingTask.h"
+#include "CTextureStreamingTask.h"
+#include "CModelStreamingTask.h"
+#include "CSceneStreamingTask.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace Skylicht
+{
+	/// @brief Load the resources on a streaming thread, and finalize them (create texture, scene objects) on main thread.
+	/// The finalize work is limited by the frame budget, so the frame does not stall while a scene is streaming.
+	/// The task is deleted after its callback is called.
+	class SKYLICHT_API CStreamingLoader : public SkylichtSystem::IThreadCallback
+	{
+	public:
+		DECLARE_SINGLETON(CStreamingLoader)
+
+	protected:
+		SkylichtSystem::IThread* m_thread;
+		SkylichtSystem::IMutex* m_mutex;
+
+		std::atomic<bool> m_threadRunning;
+
+		bool m_createThread;
+
+		// the tasks wait the streaming thread
+		std::list<CStreamingTask*> m_queue;
+
+		// all the tasks, main thread only
+		std::vector<CStreamingTask*> m_tasks;
+
+		float m_frameBudget;
+
+		std::chrono::steady_clock::time_point m_deadline;
+
+	public:
+		CStreamingLoader();
+
+		virtual ~CStreamingLoader();
+
+		void loadTexture(const char* path, std::function<void(ITexture*)> callback);
+
+		void loadModel(const char* resource,
+			const char* texturePath,
+			bool loadNormalMap,
+			bool flipNormalMap,
+			bool loadTexcoord2,
+			std::function<void(CEntityPrefab*)> callback);
+
+		void loadScene(CScene* scene, const char* path, std::function<void(std::vector<CZone*>&)> callback);
+
+		void addTask(CStreamingTask* task);
+
+		// call on main thread each frame
+		void update();
+
+		// block until all the tasks are finished
+		void finishAll();
+
+		bool isTimeout();
+
+		inline void setFrameBudget(float ms)
+		{
+			m_frameBudget = ms;
+		}
+
+		inline float getFrameBudget()
+		{
+			return m_frameBudget;
+		}
+
+		inline u32 getNumTask()
+		{
+			return (u32)m_tasks.size();
+		}
+
+		virtual void runThread();
+
+		virtual void updateThread();
+
+	protected:
+
+		CStreamingTask* popTask();
+
+		void loadTask(CStreamingTask* task);
+
+		bool finalizeTasks();
+	};
+}
@@ -0,0 +1,70 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include <atomic>
+
+namespace Skylicht
+{
+	class CStreamingLoader;
+
+	/// @brief A resource that is read on the streaming thread, then finalized on main thread.
+	/// load() must not touch the video driver or the scene, finalize() can be called many frames until it return true.
+	class SKYLICHT_API CStreamingTask
+	{
+	public:
+		enum EState
+		{
+			Queued = 0,
+			Loading,
+			Loaded,
+			Finished
+		};
+
+	protected:
+		std::atomic<int> m_state;
+
+	public:
+		CStreamingTask();
+
+		virtual ~CStreamingTask();
+
+		inline EState getState()
+		{
+			return (EState)m_state.load();
+		}
+
+		inline void setState(EState state)
+		{
+			m_state.store((int)state);
+		}
+
+		// run on streaming thread
+		virtual void load() = 0;
+
+		// run on main thread, return false if it is out of frame budget and need continue next frame
+		virtual bool finalize(CStreamingLoader* loader) = 0;
+	};
+}
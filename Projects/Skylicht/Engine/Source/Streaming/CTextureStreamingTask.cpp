@@ -0,0 +1,71 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CTextureStreamingTask.h"
+#include "TextureManager/CTextureManager.h"
+
+namespace Skylicht
+{
+	CTextureStreamingTask::CTextureStreamingTask(const char* path, std::function<void(ITexture*)> callback) :
+		m_path(path),
+		m_image(NULL),
+		m_texture(NULL),
+		m_callback(callback)
+	{
+
+	}
+
+	CTextureStreamingTask::~CTextureStreamingTask()
+	{
+		if (m_image)
+			m_image->drop();
+	}
+
+	void CTextureStreamingTask::load()
+	{
+		m_image = CTextureManager::getInstance()->loadImage(m_path.c_str(), m_textureName);
+	}
+
+	bool CTextureStreamingTask::finalize(CStreamingLoader* loader)
+	{
+		if (m_image)
+		{
+			m_texture = CTextureManager::getInstance()->uploadTexture(m_textureName.c_str(), m_image);
+			m_image->drop();
+			m_image = NULL;
+		}
+		else
+		{
+			char log[512];
+			sprintf(log, "[CTextureStreamingTask] Can not load texture: %s", m_path.c_str());
+			os::Printer::log(log);
+		}
+
+		if (m_callback)
+			m_callback(m_texture);
+
+		return true;
+	}
+}
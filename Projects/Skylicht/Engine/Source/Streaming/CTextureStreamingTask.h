@@ -0,0 +1,60 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CStreamingTask.h"
+
+#include <functional>
+
+namespace Skylicht
+{
+	class SKYLICHT_API CTextureStreamingTask : public CStreamingTask
+	{
+	protected:
+		std::string m_path;
+
+		std::string m_textureName;
+
+		IImage* m_image;
+
+		ITexture* m_texture;
+
+		std::function<void(ITexture*)> m_callback;
+
+	public:
+		CTextureStreamingTask(const char* path, std::function<void(ITexture*)> callback);
+
+		virtual ~CTextureStreamingTask();
+
+		virtual void load();
+
+		virtual bool finalize(CStreamingLoader* loader);
+
+		inline ITexture* getTexture()
+		{
+			return m_texture;
+		}
+	};
+}
@@ -19,6 +19,7 @@ namespace Skylicht
 	{
 		m_currentPackage = GlobalPackage;
 		m_loadCommonPos = 0;
+		m_mainThread = std::this_thread::get_id();
 	}
 
 	CTextureManager::~CTextureManager()
@@ -64,6 +65,8 @@ namespace Skylicht
 	{
 		IVideoDriver* driver = getVideoDriver();
 
+		clearRequestTextures();
+
 		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
 		while (i != end)
 		{
@@ -82,6 +85,8 @@ namespace Skylicht
 	{
 		IVideoDriver* driver = getVideoDriver();
 
+		clearRequestTextures();
+
 		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
 		while (i != end)
 		{
@@ -100,6 +105,8 @@ namespace Skylicht
 	void CTextureManager::removeTexture(const char* namePackage)
 	{
 		IVideoDriver* driver = getVideoDriver();
+
+		clearRequestTextures();
 		bool needContinue = false;
 		do
 		{
@@ -150,7 +157,11 @@ namespace Skylicht
 	bool CTextureManager::existTexture(const char* path)
 	{
 		char ansiPath[512];
+		return getTexturePath(path, ansiPath);
+	}
 
+	bool CTextureManager::getTexturePath(const char* path, char* ansiPath)
+	{
 		IVideoDriver* driver = getVideoDriver();
 		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
 
@@ -228,28 +239,26 @@ namespace Skylicht
 
 		CStringImp::getFileName(realFileName, filename);
 
-		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
-
 		for (u32 i = 0, n = (u32)textureFolder.size(); i < n; i++)
 		{
 			std::string s = textureFolder[i];
 			s += "/";
 			s += realFileName;
 
-			ITexture* texture = CTextureManager::getInstance()->getTexture(s.c_str());
+			ITexture* texture = getTexture(s.c_str());
 			if (texture != NULL)
 			{
 				return texture;
 			}
 
-			if (realFileName != filename)
+			if (strcmp(realFileName, filename) != 0)
 			{
 				// test file name
 				s = textureFolder[i];
 				s += "/";
 				s += filename;
 
-				texture = CTextureManager::getInstance()->getTexture(s.c_str());
+				texture = getTexture(s.c_str());
 				if (texture != NULL)
 				{
 					return texture;
@@ -265,73 +274,20 @@ namespace Skylicht
 
 	ITexture* CTextureManager::getTexture(const char* path)
 	{
-		char ansiPath[512];
+		// the import thread can not create texture
+		if (!isMainThread())
+			return requestTexture(path);
 
-		std::string fixPath = CPath::normalizePath(path);
-		strcpy(ansiPath, fixPath.c_str());
+		char ansiPath[512];
 
 		IVideoDriver* driver = getVideoDriver();
-		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
 
-		// try to load compress texture
-		if (driver->getDriverType() == video::EDT_OPENGLES)
-		{
-#if defined(ANDROID)
-			// etc compress
-			CStringImp::replacePathExt(ansiPath, ".etc2");
-#elif defined(IOS)
-#if defined(USE_ETC_TEXTURE)
-			CStringImp::replacePathExt(ansiPath, ".etc2");
-#else
-			CStringImp::replacePathExt(ansiPath, ".pvr");
-#endif
-#elif defined(MACOS)
-			// dxt compress
-			CStringImp::replacePathExt(ansiPath, ".dds");
-#elif defined(__EMSCRIPTEN__)
-			if (driver->queryFeature(EVDF_TEXTURE_COMPRESSED_DXT) == true)
-				CStringImp::replacePathExt(ansiPath, ".dds");
-			else
-				CStringImp::replacePathExt(ansiPath, ".etc2");
-#else
-			CStringImp::replacePathExt(ansiPath, ".tga");
-#endif
-		}
-		else if (driver->getDriverType() == video::EDT_DIRECT3D11 || driver->getDriverType() == video::EDT_OPENGL)
+		if (getTexturePath(path, ansiPath) == false)
 		{
-			CStringImp::replacePathExt(ansiPath, ".dds");
-		}
-
-		if (fs->existFile(ansiPath) == false)
-		{
-			CStringImp::replacePathExt(ansiPath, ".tga");
-
-			if (fs->existFile(ansiPath) == false)
-			{
-				CStringImp::replacePathExt(ansiPath, ".bmp");
-
-				if (fs->existFile(ansiPath) == false)
-				{
-					CStringImp::replacePathExt(ansiPath, ".png");
-
-					if (fs->existFile(ansiPath) == false)
-					{
-						CStringImp::replacePathExt(ansiPath, ".jpeg");
-
-						if (fs->existFile(ansiPath) == false)
-						{
-							CStringImp::replacePathExt(ansiPath, ".jpg");
-							if (fs->existFile(ansiPath) == false)
-							{
-								char errorLog[512];
-								sprintf(errorLog, "Can not load texture (file not found): %s", path);
-								os::Printer::log(errorLog);
-								return NULL;
-							}
-						}
-					}
-				}
-			}
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture (file not found): %s", path);
+			os::Printer::log(errorLog);
+			return NULL;
 		}
 
 		ITexture* texture = NULL;
@@ -357,6 +313,161 @@ namespace Skylicht
 		return texture;
 	}
 
+	IImage* CTextureManager::loadImage(const char* path, std::string& textureName)
+	{
+		char ansiPath[512];
+
+		if (getTexturePath(path, ansiPath) == false)
+			return NULL;
+
+		io::IReadFile* file = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(ansiPath);
+		if (file == NULL)
+			return NULL;
+
+		// same name with IVideoDriver::getTexture, so the texture is cached
+		textureName = file->getFileName().c_str();
+
+		IImage* image = getVideoDriver()->createImageFromFile(file);
+		file->drop();
+
+		return image;
+	}
+
+	IImage* CTextureManager::loadImage(const char* filename, const std::vector<std::string>& textureFolder, std::string& textureName)
+	{
+		IImage* image = loadImage(filename, textureName);
+		if (image != NULL)
+			return image;
+
+		char realFileName[512];
+		CStringImp::getFileName(realFileName, filename);
+
+		for (u32 i = 0, n = (u32)textureFolder.size(); i < n; i++)
+		{
+			std::string s = textureFolder[i];
+			s += "/";
+			s += realFileName;
+
+			image = loadImage(s.c_str(), textureName);
+			if (image != NULL)
+				return image;
+
+			if (strcmp(realFileName, filename) != 0)
+			{
+				// test file name
+				s = textureFolder[i];
+				s += "/";
+				s += filename;
+
+				image = loadImage(s.c_str(), textureName);
+				if (image != NULL)
+					return image;
+			}
+		}
+
+		return NULL;
+	}
+
+	ITexture* CTextureManager::uploadTexture(const char* textureName, IImage* image)
+	{
+		IVideoDriver* driver = getVideoDriver();
+
+		ITexture* texture = driver->findTexture(textureName);
+		if (texture != NULL)
+		{
+			// already loaded by getTexture
+			texture->updateSource(ETS_FROM_CACHE);
+			return texture;
+		}
+
+		texture = driver->addTexture(textureName, image);
+		if (texture != NULL)
+		{
+			texture->updateSource(ETS_FROM_FILE);
+			registerTexture(texture);
+		}
+		else
+		{
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture: %s", textureName);
+			os::Printer::log(errorLog);
+		}
+
+		return texture;
+	}
+
+	ITexture* CTextureManager::requestTexture(const char* path)
+	{
+		char ansiPath[512];
+
+		if (getTexturePath(path, ansiPath) == false)
+			return NULL;
+
+		io::IReadFile* file = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(ansiPath);
+		if (file == NULL)
+			return NULL;
+
+		std::string textureName = file->getFileName().c_str();
+
+		{
+			// the texture is created by other request
+			std::unique_lock<std::mutex> lock(m_requestMutex);
+			std::map<std::string, ITexture*>::iterator i = m_requestTextures.find(textureName);
+			if (i != m_requestTextures.end())
+			{
+				file->drop();
+				return i->second;
+			}
+		}
+
+		// decode on this thread
+		IImage* image = getVideoDriver()->createImageFromFile(file);
+		file->drop();
+
+		if (image == NULL)
+			return NULL;
+
+		STextureRequest request;
+		request.Name = textureName;
+		request.Image = image;
+		request.Texture = NULL;
+		request.Done = false;
+
+		// wait main thread create texture, see updateTextureRequest
+		{
+			std::unique_lock<std::mutex> lock(m_requestMutex);
+			m_requests.push_back(&request);
+			m_requestCondition.wait(lock, [&request] { return request.Done; });
+		}
+
+		image->drop();
+		return request.Texture;
+	}
+
+	void CTextureManager::updateTextureRequest()
+	{
+		std::unique_lock<std::mutex> lock(m_requestMutex);
+		if (m_requests.size() == 0)
+			return;
+
+		for (STextureRequest* request : m_requests)
+		{
+			request->Texture = uploadTexture(request->Name.c_str(), request->Image);
+			if (request->Texture)
+				m_requestTextures[request->Name] = request->Texture;
+			request->Done = true;
+		}
+		m_requests.clear();
+
+		m_requestCondition.notify_all();
+	}
+
+	void CTextureManager::clearRequestTextures()
+	{
+		std::unique_lock<std::mutex> lock(m_requestMutex);
+		m_requestTextures.clear();
+	}
+
 	ITexture* CTextureManager::getTextureArray(std::vector<std::string>& listTexture)
 	{
 		IVideoDriver* driver = getVideoDriver();
@@ -29,6 +29,10 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Utils/CSingleton.h"
 #include "Utils/CStringImp.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 namespace Skylicht
 {
 	class SKYLICHT_API CTextureManager
@@ -54,6 +58,21 @@ namespace Skylicht
 		ITexture* m_nullNormalMap;
 		ITexture* m_nullTexture;
 
+		// the texture that is requested by the import thread, it is created on main thread
+		struct STextureRequest
+		{
+			std::string Name;
+			IImage* Image;
+			ITexture* Texture;
+			bool Done;
+		};
+
+		std::thread::id m_mainThread;
+		std::mutex m_requestMutex;
+		std::condition_variable m_requestCondition;
+		std::vector<STextureRequest*> m_requests;
+		std::map<std::string, ITexture*> m_requestTextures;
+
 	public:
 		CTextureManager();
 		virtual ~CTextureManager();
@@ -78,12 +97,30 @@ namespace Skylicht
 
 		bool existTexture(const char* path);
 
+		bool getTexturePath(const char* path, char* realPath);
+
 		ITexture* getTexture(const char* path);
 
 		ITexture* getTexture(const char* filename, const std::vector<std::string>& folders);
 
 		ITexture* getTextureFromRealPath(const char* path);
 
+		// find and decode the image, it does not touch the GPU so it can run on the loading thread
+		IImage* loadImage(const char* path, std::string& textureName);
+
+		IImage* loadImage(const char* filename, const std::vector<std::string>& folders, std::string& textureName);
+
+		// create the texture from the decoded image on main thread
+		ITexture* uploadTexture(const char* textureName, IImage* image);
+
+		inline bool isMainThread()
+		{
+			return std::this_thread::get_id() == m_mainThread;
+		}
+
+		// create the textures that the import threads are waiting, call on main thread
+		void updateTextureRequest();
+
 		ITexture* getCubeTexture(
 			const char* pathX1,
 			const char* pathX2,
@@ -107,6 +144,12 @@ namespace Skylicht
 		ITexture* createTransformTexture2D(const char* name, core::matrix4* transforms, int w, int h);
 
 		ITexture* createVectorTexture2D(const char* name, core::vector3df* vectors, int w, int h);
+
+	protected:
+
+		ITexture* requestTexture(const char* path);
+
+		void clearRequestTextures();
 	};
 
 }
\ No newline at end of file
@@ -54,6 +54,9 @@ namespace Skylicht
 		m_roots.reset();
 		m_childs.reset();
 		m_lateUpdate.reset();
+		m_childLevels.reset();
+
+		int lastDepth = -1;
 
 		for (int i = 0; i < numEntity; i++)
 		{
@@ -95,7 +98,18 @@ namespace Skylicht
 				if (transform->Depth == 0 || transform->IsWorldTransform)
 					m_roots.push(transform);
 				else
+				{
+					// same depth as CEntityManager::sortAliveEntities
+					int depth = entityManager->getEntityDepth(entity->getIndex());
+
+					if (depth != lastDepth)
+					{
+						m_childLevels.push(m_childs.count());
+						lastDepth = depth;
+					}
+
 					m_childs.push(transform);
+				}
 
 				transform->HasChanged = false;
 			}
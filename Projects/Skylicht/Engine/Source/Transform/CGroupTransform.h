@@ -34,6 +34,10 @@ namespace Skylicht
 		CFastArray<CWorldTransformData*> m_roots;
 		CFastArray<CWorldTransformData*> m_childs;
 		CFastArray<CWorldTransformData*> m_lateUpdate;
+
+		// the begin index of each depth level in m_childs
+		CFastArray<int> m_childLevels;
+
 	public:
 		CGroupTransform(CEntityGroup* parent);
 
@@ -59,6 +63,20 @@ namespace Skylicht
 			return m_childs.pointer();
 		}
 
+		// the childs are sorted by depth (see CEntityManager::sortAliveEntities)
+		// the transforms in a level do not depend together, so they can be updated in parallel
+		inline int getNumChildLevel()
+		{
+			return m_childLevels.count();
+		}
+
+		inline void getChildLevel(int level, int& begin, int& end)
+		{
+			int* levels = m_childLevels.pointer();
+			begin = levels[level];
+			end = level + 1 < (int)m_childLevels.count() ? levels[level + 1] : m_childs.count();
+		}
+
 		inline CWorldTransformData** getLateUpdate()
 		{
 			return m_lateUpdate.pointer();
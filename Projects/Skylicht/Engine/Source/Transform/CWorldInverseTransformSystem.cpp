@@ -33,6 +33,8 @@ namespace Skylicht
 	CWorldInverseTransformSystem::CWorldInverseTransformSystem() :
 		m_group(NULL)
 	{
+		readDataType(DATA_TYPE_INDEX(CWorldTransformData));
+		writeDataType(DATA_TYPE_INDEX(CWorldInverseTransformData));
 	}
 
 	CWorldInverseTransformSystem::~CWorldInverseTransformSystem()
@@ -63,18 +65,21 @@ namespace Skylicht
 		CEntity** entities = m_group->getEntities();
 		int numEntity = m_group->getEntityCount();
 
-		for (int i = 0; i < numEntity; i++)
-		{
-			CEntity* entity = entities[i];
-
-			CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
-			CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
-
-			if (world->NeedValidate)
+		SkylichtSystem::CJobSystem::getInstance()->parallelFor(numEntity, 0, [entities](int begin, int end)
 			{
-				// Get inverse matrix of world
-				world->World.getInverse(worldInv->WorldInverse);
-			}
-		}
+				for (int i = begin; i < end; i++)
+				{
+					CEntity* entity = entities[i];
+
+					CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+					CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
+
+					if (world->NeedValidate)
+					{
+						// Get inverse matrix of world
+						world->World.getInverse(worldInv->WorldInverse);
+					}
+				}
+			});
 	}
 }
\ No newline at end of file
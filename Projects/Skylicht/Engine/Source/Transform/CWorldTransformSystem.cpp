@@ -28,11 +28,16 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityManager.h"
 #include "Transform/CTransform.h"
 #include "Culling/CVisibleData.h"
+#include "Utils/CSIMD.h"
+#include "Job/CJobSystem.h"
+
+#define MIN_TRANSFORM_BATCH 128
 
 namespace Skylicht
 {
 	CWorldTransformSystem::CWorldTransformSystem() :
-		m_groupTransform(NULL)
+		m_groupTransform(NULL),
+		m_parallelUpdate(true)
 	{
 	}
 
@@ -91,21 +96,47 @@ namespace Skylicht
 		}
 
 		transforms = m_groupTransform->getChilds();
-		numEntity = m_groupTransform->getNumChilds();
 
-		for (int i = 0; i < numEntity; i++)
+		SkylichtSystem::CJobSystem* jobSystem = SkylichtSystem::CJobSystem::getInstance();
+		int numThread = jobSystem->getWorkerCount() + 1;
+
+		int begin, end;
+		for (int level = 0, numLevel = m_groupTransform->getNumChildLevel(); level < numLevel; level++)
 		{
-			CWorldTransformData* t = transforms[i];
+			m_groupTransform->getChildLevel(level, begin, end);
+
+			CWorldTransformData** levelTransforms = transforms + begin;
+			numEntity = end - begin;
 
 			// calc world = parent * relative
 			// - relative is copied from CTransformComponentSystem
 			// - relative is also defined in CEntityPrefab
-			t->World.setbyproduct_nocheck(t->Parent->World, t->Relative);
+			if (!m_parallelUpdate || numThread == 1 || numEntity < MIN_TRANSFORM_BATCH * 2)
+			{
+				updateTransforms(levelTransforms, 0, numEntity);
+			}
+			else
+			{
+				int batch = core::max_(MIN_TRANSFORM_BATCH, numEntity / (numThread * 4));
+				jobSystem->parallelFor(numEntity, batch, [this, levelTransforms](int from, int to)
+					{
+						updateTransforms(levelTransforms, from, to);
+					});
+			}
 		}
 
 		lateUpdate(entityManager);
 	}
 
+	void CWorldTransformSystem::updateTransforms(CWorldTransformData** transforms, int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			CWorldTransformData* t = transforms[i];
+			CSIMD::mulMatrix(t->World, t->Parent->World, t->Relative);
+		}
+	}
+
 	void CWorldTransformSystem::lateUpdate(CEntityManager* entityManager)
 	{
 		// call late update
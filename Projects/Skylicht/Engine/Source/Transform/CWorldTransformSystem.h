@@ -38,6 +38,8 @@ namespace Skylicht
 
 		std::vector<ILateUpdate*> m_lateUpdates;
 
+		bool m_parallelUpdate;
+
 	public:
 		CWorldTransformSystem();
 
@@ -47,6 +49,17 @@ namespace Skylicht
 
 		void unRegisterLateUpdate(ILateUpdate* lateUpdate);
 
+		// update each depth level of the hierarchy in parallel on job system
+		inline void setParallelUpdate(bool b)
+		{
+			m_parallelUpdate = b;
+		}
+
+		inline bool isParallelUpdate()
+		{
+			return m_parallelUpdate;
+		}
+
 		virtual void beginQuery(CEntityManager* entityManager);
 
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
@@ -56,5 +69,9 @@ namespace Skylicht
 		virtual void update(CEntityManager* entityManager);
 
 		virtual void lateUpdate(CEntityManager* entityManager);
+
+	protected:
+
+		void updateTransforms(CWorldTransformData** transforms, int begin, int end);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CMappedFile.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define MAPPED_FILE_MIN_SIZE (64 * 1024)
+
+namespace Skylicht
+{
+	CMappedFile::CMappedFile() :
+		m_data(NULL),
+		m_size(0),
+		m_mapped(false)
+#if defined(_WIN32)
+		, m_file(NULL),
+		m_mapping(NULL)
+#endif
+	{
+
+	}
+
+	CMappedFile::~CMappedFile()
+	{
+		close();
+	}
+
+	bool CMappedFile::open(const char* path)
+	{
+		close();
+
+		// resolve the path like the other loaders, so a file in the mounted archive is not shadowed by a loose file
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+		io::IReadFile* file = fs->createAndOpenFile(path);
+		if (file == NULL)
+			return false;
+
+		bool ok = false;
+		if (!isInArchive(path))
+			ok = mapFile(file->getFileName().c_str());
+
+		if (!ok)
+			ok = readFile(file);
+
+		file->drop();
+		return ok;
+	}
+
+	bool CMappedFile::isInArchive(const char* path)
+	{
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+
+		// same order as IFileSystem::createAndOpenFile: the first archive that has the file opens it
+		for (u32 i = 0, n = fs->getFileArchiveCount(); i < n; i++)
+		{
+			io::IFileArchive* archive = fs->getFileArchive(i);
+			if (archive->getFileList()->findFile(path, false) >= 0)
+				return archive->getType() != io::EFAT_FOLDER;
+		}
+
+		return false;
+	}
+
+	void CMappedFile::close()
+	{
+		if (m_data == NULL)
+			return;
+
+		if (m_mapped)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(m_data);
+			CloseHandle((HANDLE)m_mapping);
+			CloseHandle((HANDLE)m_file);
+			m_mapping = NULL;
+			m_file = NULL;
+#elif !defined(__EMSCRIPTEN__)
+			munmap(m_data, m_size);
+#endif
+		}
+		else
+		{
+			delete[] m_data;
+		}
+
+		m_data = NULL;
+		m_size = 0;
+		m_mapped = false;
+	}
+
+	bool CMappedFile::mapFile(const char* realPath)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(realPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || size.HighPart != 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		if (size.LowPart < MAPPED_FILE_MIN_SIZE)
+		{
+			// the small file: read is faster than map & unmap
+			m_size = (unsigned int)size.LowPart;
+			m_data = new unsigned char[m_size];
+			m_mapped = false;
+
+			DWORD readSize = 0;
+			bool ok = ReadFile(file, m_data, m_size, &readSize, NULL) && readSize == m_size;
+			CloseHandle(file);
+
+			if (!ok)
+				close();
+			return ok;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == NULL)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_data = (unsigned char*)data;
+		m_size = (unsigned int)size.LowPart;
+		m_mapped = true;
+		return true;
+#elif !defined(__EMSCRIPTEN__)
+		int fd = ::open(realPath, O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+
+		if (st.st_size < MAPPED_FILE_MIN_SIZE)
+		{
+			// the small file: read is faster than map & unmap
+			m_size = (unsigned int)st.st_size;
+			m_data = new unsigned char[m_size];
+			m_mapped = false;
+
+			bool ok = ::read(fd, m_data, m_size) == (ssize_t)m_size;
+			::close(fd);
+
+			if (!ok)
+				close();
+			return ok;
+		}
+
+		void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// the mapping is still valid after close the file
+		::close(fd);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		m_data = (unsigned char*)data;
+		m_size = (unsigned int)st.st_size;
+		m_mapped = true;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool CMappedFile::readFile(io::IReadFile* file)
+	{
+		m_size = (unsigned int)file->getSize();
+		m_data = new unsigned char[m_size];
+		m_mapped = false;
+
+		file->seek(0);
+		if (file->read(m_data, m_size) != (s32)m_size)
+		{
+			close();
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,75 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	/// @brief Read only view of the whole file.
+	/// The native file is mapped to memory (no copy), the small file and the file in archive (zip, apk) are read to a buffer.
+	class SKYLICHT_API CMappedFile
+	{
+	protected:
+		unsigned char* m_data;
+		unsigned int m_size;
+		bool m_mapped;
+
+#if defined(_WIN32)
+		void* m_file;
+		void* m_mapping;
+#endif
+
+	public:
+		CMappedFile();
+
+		virtual ~CMappedFile();
+
+		bool open(const char* path);
+
+		void close();
+
+		inline unsigned char* getData()
+		{
+			return m_data;
+		}
+
+		inline unsigned int getSize()
+		{
+			return m_size;
+		}
+
+		inline bool isMapped()
+		{
+			return m_mapped;
+		}
+
+	protected:
+
+		bool isInArchive(const char* path);
+
+		bool mapFile(const char* realPath);
+
+		bool readFile(io::IReadFile* file);
+	};
+}
@@ -194,6 +194,21 @@ namespace Skylicht
 		}
 	}
 
+	void CMemoryStream::writeAlign(unsigned int alignment, unsigned int offset)
+	{
+		unsigned int pad = (alignment - ((offset + m_size) % alignment)) % alignment;
+		for (unsigned int i = 0; i < pad; i++)
+			writeChar(0);
+	}
+
+	void CMemoryStream::readAlign(unsigned int alignment)
+	{
+		unsigned int pad = (alignment - (m_pos % alignment)) % alignment;
+		m_pos += pad;
+		if (m_pos > m_size)
+			m_pos = m_size;
+	}
+
 	unsigned int CMemoryStream::readData(void* data, unsigned int size)
 	{
 		unsigned int maxSize = m_size - m_pos;
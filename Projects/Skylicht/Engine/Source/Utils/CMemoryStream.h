@@ -59,6 +59,9 @@ namespace Skylicht
 		void writeString(const std::wstring& s);
 		void writeFloatArray(const float* f, int count);
 
+		// pad zero bytes, offset is the position of this stream in the file
+		void writeAlign(unsigned int alignment, unsigned int offset = 0);
+
 		unsigned int readData(void* data, unsigned int size);
 
 		char readChar();
@@ -71,6 +74,7 @@ namespace Skylicht
 		std::string readString();
 		std::wstring readWString();
 		void readFloatArray(float* f, int count);
+		void readAlign(unsigned int alignment);
 
 		unsigned char* getData()
 		{
@@ -0,0 +1,180 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SKYLICHT_SSE
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKYLICHT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Skylicht
+{
+	// 4 lanes float vector for the SoA kernels
+#if defined(SKYLICHT_SSE)
+	typedef __m128 f32x4;
+#elif defined(SKYLICHT_NEON)
+	typedef float32x4_t f32x4;
+#else
+	struct f32x4
+	{
+		f32 v[4];
+	};
+#endif
+
+	class CSIMD
+	{
+	public:
+		// out = a * b (irrlicht matrix4 layout, same as matrix4::setbyproduct_nocheck)
+		// out must not be a or b
+		static inline void mulMatrix(f32* out, const f32* a, const f32* b)
+		{
+#if defined(SKYLICHT_SSE)
+			__m128 a0 = _mm_loadu_ps(a);
+			__m128 a1 = _mm_loadu_ps(a + 4);
+			__m128 a2 = _mm_loadu_ps(a + 8);
+			__m128 a3 = _mm_loadu_ps(a + 12);
+
+			for (int i = 0; i < 16; i += 4)
+			{
+				__m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[i]));
+				r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[i + 1])));
+				r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[i + 2])));
+				r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[i + 3])));
+				_mm_storeu_ps(out + i, r);
+			}
+#elif defined(SKYLICHT_NEON)
+			float32x4_t a0 = vld1q_f32(a);
+			float32x4_t a1 = vld1q_f32(a + 4);
+			float32x4_t a2 = vld1q_f32(a + 8);
+			float32x4_t a3 = vld1q_f32(a + 12);
+
+			for (int i = 0; i < 16; i += 4)
+			{
+				float32x4_t r = vmulq_n_f32(a0, b[i]);
+				r = vmlaq_n_f32(r, a1, b[i + 1]);
+				r = vmlaq_n_f32(r, a2, b[i + 2]);
+				r = vmlaq_n_f32(r, a3, b[i + 3]);
+				vst1q_f32(out + i, r);
+			}
+#else
+			for (int i = 0; i < 16; i += 4)
+			{
+				out[i] = a[0] * b[i] + a[4] * b[i + 1] + a[8] * b[i + 2] + a[12] * b[i + 3];
+				out[i + 1] = a[1] * b[i] + a[5] * b[i + 1] + a[9] * b[i + 2] + a[13] * b[i + 3];
+				out[i + 2] = a[2] * b[i] + a[6] * b[i + 1] + a[10] * b[i + 2] + a[14] * b[i + 3];
+				out[i + 3] = a[3] * b[i] + a[7] * b[i + 1] + a[11] * b[i + 2] + a[15] * b[i + 3];
+			}
+#endif
+		}
+
+		static inline void mulMatrix(core::matrix4& out, const core::matrix4& a, const core::matrix4& b)
+		{
+			mulMatrix(out.pointer(), a.pointer(), b.pointer());
+		}
+
+#if defined(SKYLICHT_SSE)
+		static inline f32x4 load4(const f32* p) { return _mm_loadu_ps(p); }
+		static inline void store4(f32* p, f32x4 a) { _mm_storeu_ps(p, a); }
+		static inline f32x4 splat4(f32 f) { return _mm_set1_ps(f); }
+		static inline f32x4 add4(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+		static inline f32x4 sub4(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+		static inline f32x4 mul4(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+		static inline f32x4 div4(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+		static inline f32x4 madd4(f32x4 a, f32x4 b, f32x4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		static inline f32x4 min4(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+		static inline f32x4 max4(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+		static inline f32x4 sqrt4(f32x4 a) { return _mm_sqrt_ps(a); }
+		// round toward zero (|a| < 2^31)
+		static inline f32x4 trunc4(f32x4 a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+		// mask lane = a < b
+		static inline f32x4 less4(f32x4 a, f32x4 b) { return _mm_cmplt_ps(a, b); }
+		// mask lane = a <= b
+		static inline f32x4 lessEqual4(f32x4 a, f32x4 b) { return _mm_cmple_ps(a, b); }
+		static inline f32x4 and4(f32x4 a, f32x4 b) { return _mm_and_ps(a, b); }
+		// mask ? a : b
+		static inline f32x4 select4(f32x4 mask, f32x4 a, f32x4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+		// bit i = mask lane i
+		static inline int mask4(f32x4 mask) { return _mm_movemask_ps(mask); }
+#elif defined(SKYLICHT_NEON)
+		static inline f32x4 load4(const f32* p) { return vld1q_f32(p); }
+		static inline void store4(f32* p, f32x4 a) { vst1q_f32(p, a); }
+		static inline f32x4 splat4(f32 f) { return vdupq_n_f32(f); }
+		static inline f32x4 add4(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+		static inline f32x4 sub4(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+		static inline f32x4 mul4(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+		static inline f32x4 div4(f32x4 a, f32x4 b)
+		{
+			// 2 newton steps reciprocal
+			float32x4_t r = vrecpeq_f32(b);
+			r = vmulq_f32(vrecpsq_f32(b, r), r);
+			r = vmulq_f32(vrecpsq_f32(b, r), r);
+			return vmulq_f32(a, r);
+		}
+		static inline f32x4 madd4(f32x4 a, f32x4 b, f32x4 c) { return vmlaq_f32(c, a, b); }
+		static inline f32x4 min4(f32x4 a, f32x4 b) { return vminq_f32(a, b); }
+		static inline f32x4 max4(f32x4 a, f32x4 b) { return vmaxq_f32(a, b); }
+		static inline f32x4 sqrt4(f32x4 a)
+		{
+			// sqrt(a) = a * rsqrt(a), a = 0 return 0
+			float32x4_t r = vrsqrteq_f32(vmaxq_f32(a, vdupq_n_f32(1e-30f)));
+			r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+			r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+			return vmulq_f32(a, r);
+		}
+		static inline f32x4 trunc4(f32x4 a) { return vcvtq_f32_s32(vcvtq_s32_f32(a)); }
+		static inline f32x4 less4(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+		static inline f32x4 lessEqual4(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+		static inline f32x4 and4(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+		static inline f32x4 select4(f32x4 mask, f32x4 a, f32x4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+		static inline int mask4(f32x4 mask)
+		{
+			uint32x4_t m = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+			return (int)(vgetq_lane_u32(m, 0) | (vgetq_lane_u32(m, 1) << 1) | (vgetq_lane_u32(m, 2) << 2) | (vgetq_lane_u32(m, 3) << 3));
+		}
+#else
+		static inline f32x4 load4(const f32* p) { f32x4 r; for (int i = 0; i < 4; i++) r.v[i] = p[i]; return r; }
+		static inline void store4(f32* p, f32x4 a) { for (int i = 0; i < 4; i++) p[i] = a.v[i]; }
+		static inline f32x4 splat4(f32 f) { f32x4 r; for (int i = 0; i < 4; i++) r.v[i] = f; return r; }
+		static inline f32x4 add4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+		static inline f32x4 sub4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+		static inline f32x4 mul4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+		static inline f32x4 div4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] /= b.v[i]; return a; }
+		static inline f32x4 madd4(f32x4 a, f32x4 b, f32x4 c) { for (int i = 0; i < 4; i++) c.v[i] += a.v[i] * b.v[i]; return c; }
+		static inline f32x4 min4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = core::min_(a.v[i], b.v[i]); return a; }
+		static inline f32x4 max4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = core::max_(a.v[i], b.v[i]); return a; }
+		static inline f32x4 sqrt4(f32x4 a) { for (int i = 0; i < 4; i++) a.v[i] = sqrtf(a.v[i]); return a; }
+		static inline f32x4 trunc4(f32x4 a) { for (int i = 0; i < 4; i++) a.v[i] = (f32)(s32)a.v[i]; return a; }
+		static inline f32x4 less4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = a.v[i] < b.v[i] ? 1.0f : 0.0f; return a; }
+		static inline f32x4 lessEqual4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = a.v[i] <= b.v[i] ? 1.0f : 0.0f; return a; }
+		static inline f32x4 and4(f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = (a.v[i] != 0.0f && b.v[i] != 0.0f) ? 1.0f : 0.0f; return a; }
+		static inline f32x4 select4(f32x4 mask, f32x4 a, f32x4 b) { for (int i = 0; i < 4; i++) a.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i]; return a; }
+		static inline int mask4(f32x4 mask) { int r = 0; for (int i = 0; i < 4; i++) r |= (mask.v[i] != 0.0f ? 1 : 0) << i; return r; }
+#endif
+	};
+}
\ No newline at end of file
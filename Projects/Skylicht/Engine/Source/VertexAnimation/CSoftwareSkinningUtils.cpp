@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CSoftwareSkinningUtils.h"
+#include "Utils/CSIMD.h"
 
 namespace Skylicht
 {
@@ -161,48 +162,10 @@ namespace Skylicht
 			video::S3DVertex* resultVertex = (video::S3DVertex*)vertexbuffer->getVertices();
 
 			// skinning
-			for (int i = 0; i < numVertex; i++)
-			{
-				resultVertex->Pos.X = 0.0f;
-				resultVertex->Pos.Y = 0.0f;
-				resultVertex->Pos.Z = 0.0f;
-
-				resultVertex->Normal.X = 0.0f;
-				resultVertex->Normal.Y = 0.0f;
-				resultVertex->Normal.Z = 0.0f;
-
-				// bone 0
-				if (vertex->BoneWeight.X > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 0);
-
-				// bone 1
-				if (vertex->BoneWeight.Y > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 1);
-
-				// bone 2
-				if (vertex->BoneWeight.Z > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 2);
-
-				// bone 3
-				if (vertex->BoneWeight.W > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 3);
-
-				// apply skin normal
-				float length = resultVertex->Normal.X * resultVertex->Normal.X +
-					resultVertex->Normal.Y * resultVertex->Normal.Y +
-					resultVertex->Normal.Z * resultVertex->Normal.Z;
-
-				float invLength = 1.0f / sqrtf(length);
-				resultVertex->Normal.X = resultVertex->Normal.X * invLength;
-				resultVertex->Normal.Y = resultVertex->Normal.Y * invLength;
-				resultVertex->Normal.Z = resultVertex->Normal.Z * invLength;
-
-				++resultVertex;
-				++vertex;
-			}
-
-			skinnedMesh->setDirty(EBT_VERTEX);
+			skinVertices(arrayJoint, vertex, resultVertex, 0, numVertex);
 		}
+
+		skinnedMesh->setDirty(EBT_VERTEX);
 	}
 
 	void CSoftwareSkinningUtils::softwareSkinningTangent(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh)
@@ -224,48 +187,130 @@ namespace Skylicht
 			video::S3DVertex* resultVertex = (video::S3DVertex*)vertexbuffer->getVertices();
 
 			// skinning
-			for (int i = 0; i < numVertex; i++)
+			skinVertices(arrayJoint, vertex, resultVertex, 0, numVertex);
+		}
+
+		skinnedMesh->setDirty(EBT_VERTEX);
+	}
+
+	template<class T>
+	void skinVertexRange(CSkinnedMesh::SJoint* arrayJoint, T* vertex, video::S3DVertex* result, int begin, int end)
+	{
+		vertex += begin;
+		result += begin;
+
+		for (int i = begin; i < end; i++)
+		{
+			const f32* boneID = &vertex->BoneIndex.X;
+			const f32* boneWeight = &vertex->BoneWeight.X;
+
+#if defined(SKYLICHT_SSE) || defined(SKYLICHT_NEON)
+			f32 n[4];
+#if defined(SKYLICHT_SSE)
+			// blend the skinning matrix columns by weight, then transform once
+			__m128 c0 = _mm_setzero_ps();
+			__m128 c1 = _mm_setzero_ps();
+			__m128 c2 = _mm_setzero_ps();
+			__m128 c3 = _mm_setzero_ps();
+
+			for (int j = 0; j < 4; j++)
+			{
+				if (boneWeight[j] > 0.0f)
+				{
+					const f32* m = arrayJoint[(int)boneID[j]].SkinningMatrix;
+					__m128 w = _mm_set1_ps(boneWeight[j]);
+					c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(m), w));
+					c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(m + 4), w));
+					c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(m + 8), w));
+					c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(m + 12), w));
+				}
+			}
+
+			__m128 p = _mm_mul_ps(c0, _mm_set1_ps(vertex->Pos.X));
+			p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(vertex->Pos.Y)));
+			p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(vertex->Pos.Z)));
+			p = _mm_add_ps(p, c3);
+
+			__m128 nor = _mm_mul_ps(c0, _mm_set1_ps(vertex->Normal.X));
+			nor = _mm_add_ps(nor, _mm_mul_ps(c1, _mm_set1_ps(vertex->Normal.Y)));
+			nor = _mm_add_ps(nor, _mm_mul_ps(c2, _mm_set1_ps(vertex->Normal.Z)));
+
+			// store xyz only, Normal & Color follow Pos in the vertex
+			_mm_storel_pi((__m64*) & result->Pos.X, p);
+			_mm_store_ss(&result->Pos.Z, _mm_movehl_ps(p, p));
+			_mm_storeu_ps(n, nor);
+#else
+			float32x4_t c0 = vdupq_n_f32(0.0f);
+			float32x4_t c1 = c0;
+			float32x4_t c2 = c0;
+			float32x4_t c3 = c0;
+
+			for (int j = 0; j < 4; j++)
+			{
+				if (boneWeight[j] > 0.0f)
+				{
+					const f32* m = arrayJoint[(int)boneID[j]].SkinningMatrix;
+					c0 = vmlaq_n_f32(c0, vld1q_f32(m), boneWeight[j]);
+					c1 = vmlaq_n_f32(c1, vld1q_f32(m + 4), boneWeight[j]);
+					c2 = vmlaq_n_f32(c2, vld1q_f32(m + 8), boneWeight[j]);
+					c3 = vmlaq_n_f32(c3, vld1q_f32(m + 12), boneWeight[j]);
+				}
+			}
+
+			float32x4_t p = vmlaq_n_f32(c3, c0, vertex->Pos.X);
+			p = vmlaq_n_f32(p, c1, vertex->Pos.Y);
+			p = vmlaq_n_f32(p, c2, vertex->Pos.Z);
+
+			float32x4_t nor = vmulq_n_f32(c0, vertex->Normal.X);
+			nor = vmlaq_n_f32(nor, c1, vertex->Normal.Y);
+			nor = vmlaq_n_f32(nor, c2, vertex->Normal.Z);
+
+			vst1_f32(&result->Pos.X, vget_low_f32(p));
+			result->Pos.Z = vgetq_lane_f32(p, 2);
+			vst1q_f32(n, nor);
+#endif
+			f32 invLength = 1.0f / sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			result->Normal.X = n[0] * invLength;
+			result->Normal.Y = n[1] * invLength;
+			result->Normal.Z = n[2] * invLength;
+#else
+			result->Pos.X = 0.0f;
+			result->Pos.Y = 0.0f;
+			result->Pos.Z = 0.0f;
+
+			result->Normal.X = 0.0f;
+			result->Normal.Y = 0.0f;
+			result->Normal.Z = 0.0f;
+
+			for (int j = 0; j < 4; j++)
 			{
-				resultVertex->Pos.X = 0.0f;
-				resultVertex->Pos.Y = 0.0f;
-				resultVertex->Pos.Z = 0.0f;
-
-				resultVertex->Normal.X = 0.0f;
-				resultVertex->Normal.Y = 0.0f;
-				resultVertex->Normal.Z = 0.0f;
-
-				// bone 0
-				if (vertex->BoneWeight.X > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 0);
-
-				// bone 1
-				if (vertex->BoneWeight.Y > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 1);
-
-				// bone 2
-				if (vertex->BoneWeight.Z > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 2);
-
-				// bone 3
-				if (vertex->BoneWeight.W > 0.0f)
-					skinVertex(arrayJoint, resultVertex->Pos, resultVertex->Normal, vertex, 3);
-
-				// apply skin normal
-				float length = resultVertex->Normal.X * resultVertex->Normal.X +
-					resultVertex->Normal.Y * resultVertex->Normal.Y +
-					resultVertex->Normal.Z * resultVertex->Normal.Z;
-
-				float invLength = 1.0f / sqrtf(length);
-				resultVertex->Normal.X = resultVertex->Normal.X * invLength;
-				resultVertex->Normal.Y = resultVertex->Normal.Y * invLength;
-				resultVertex->Normal.Z = resultVertex->Normal.Z * invLength;
-
-				++resultVertex;
-				++vertex;
+				if (boneWeight[j] > 0.0f)
+					CSoftwareSkinningUtils::skinVertex(arrayJoint, result->Pos, result->Normal, vertex, j);
 			}
+
+			// apply skin normal
+			float length = result->Normal.X * result->Normal.X +
+				result->Normal.Y * result->Normal.Y +
+				result->Normal.Z * result->Normal.Z;
+
+			float invLength = 1.0f / sqrtf(length);
+			result->Normal.X = result->Normal.X * invLength;
+			result->Normal.Y = result->Normal.Y * invLength;
+			result->Normal.Z = result->Normal.Z * invLength;
+#endif
+			++result;
+			++vertex;
 		}
+	}
 
-		skinnedMesh->setDirty(EBT_VERTEX);
+	void CSoftwareSkinningUtils::skinVertices(CSkinnedMesh::SJoint* arrayJoint, video::S3DVertexSkin* vertex, video::S3DVertex* result, int begin, int end)
+	{
+		skinVertexRange(arrayJoint, vertex, result, begin, end);
+	}
+
+	void CSoftwareSkinningUtils::skinVertices(CSkinnedMesh::SJoint* arrayJoint, video::S3DVertexSkinTangents* vertex, video::S3DVertex* result, int begin, int end)
+	{
+		skinVertexRange(arrayJoint, vertex, result, begin, end);
 	}
 
 	void CSoftwareSkinningUtils::skinVertex(CSkinnedMesh::SJoint* arrayJoint, core::vector3df& vertex, core::vector3df& normal, video::S3DVertexSkinTangents* src, int boneIndex)
@@ -275,7 +320,7 @@ namespace Skylicht
 
 		CSkinnedMesh::SJoint* pJoint = &arrayJoint[(int)boneID[boneIndex]];
 
-		static core::vector3df thisVertexMove, thisNormalMove;
+		core::vector3df thisVertexMove, thisNormalMove;
 
 		// static core::matrix4 skinningMat;
 		// skinningMat.setM(pJoint->SkinningMatrix);
@@ -317,7 +362,7 @@ namespace Skylicht
 
 		CSkinnedMesh::SJoint* pJoint = &arrayJoint[(int)boneID[boneIndex]];
 
-		static core::vector3df thisVertexMove, thisNormalMove;
+		core::vector3df thisVertexMove, thisNormalMove;
 
 		// static core::matrix4 skinningMat;
 		// skinningMat.setM(pJoint->SkinningMatrix);
@@ -370,21 +415,34 @@ namespace Skylicht
 			video::S3DVertexSkinTangents* resultVertex = (video::S3DVertexSkinTangents*)vertexbuffer->getVertices();
 
 			// morphing
-			for (int i = 0; i < numVertex; i++)
-			{
-				*resultVertex = *vertex;
+			blendShapeVertices(blendShapeData, numBlendShape, vertex, resultVertex, 0, numVertex);
+		}
 
-				int vertexID = (int)vertex->VertexData.Y;
-				for (u32 j = 0; j < numBlendShape; j++)
-				{
-					resultVertex->Pos += blendShapeData[j]->Weight * blendShapeData[j]->Offset[vertexID];
-				}
+		blendShape->setDirty(EBT_VERTEX);
+	}
 
-				++resultVertex;
-				++vertex;
+	void CSoftwareSkinningUtils::blendShapeVertices(CBlendShape** blendShapeData, u32 numBlendShape, video::S3DVertexSkinTangents* vertex, video::S3DVertexSkinTangents* result, int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+			result[i] = vertex[i];
+
+		// apply shape by shape, skip the shape that has no weight
+		for (u32 j = 0; j < numBlendShape; j++)
+		{
+			f32 weight = blendShapeData[j]->Weight;
+			if (weight == 0.0f)
+				continue;
+
+			const core::vector3df* offset = blendShapeData[j]->Offset.const_pointer();
+
+			for (int i = begin; i < end; i++)
+			{
+				const core::vector3df& o = offset[(int)vertex[i].VertexData.Y];
+				core::vector3df& pos = result[i].Pos;
+				pos.X += weight * o.X;
+				pos.Y += weight * o.Y;
+				pos.Z += weight * o.Z;
 			}
 		}
-
-		blendShape->setDirty(EBT_VERTEX);
 	}
 }
\ No newline at end of file
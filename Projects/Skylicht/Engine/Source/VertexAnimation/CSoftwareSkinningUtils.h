@@ -45,5 +45,13 @@ namespace Skylicht
 		static void skinVertex(CSkinnedMesh::SJoint* arrayJoint, core::vector3df& vertex, core::vector3df& normal, video::S3DVertexSkin* src, int boneIndex);
 
 		static void softwareBlendShape(CMesh* blendShape, CMesh* originalMesh);
+
+		// skin vertex range [begin, end), thread safe (result must not be shared between ranges)
+		static void skinVertices(CSkinnedMesh::SJoint* arrayJoint, video::S3DVertexSkin* vertex, video::S3DVertex* result, int begin, int end);
+
+		static void skinVertices(CSkinnedMesh::SJoint* arrayJoint, video::S3DVertexSkinTangents* vertex, video::S3DVertex* result, int begin, int end);
+
+		// morph vertex range [begin, end), thread safe
+		static void blendShapeVertices(CBlendShape** blendShapeData, u32 numBlendShape, video::S3DVertexSkinTangents* vertex, video::S3DVertexSkinTangents* result, int begin, int end);
 	};
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CDirectionalLightBakeRP.h"
+#include "RenderPipeline/CRenderStateCache.h"
 
 #include "Lighting/CDirectionalLight.h"
 #include "Lighting/CPointLight.h"
@@ -122,7 +123,7 @@ namespace Skylicht
 		if (mb != m_renderMesh)
 			return;
 
-		IVideoDriver* driver = getVideoDriver();
+		CRenderStateCache* cache = CRenderStateCache::getInstance();
 
 		// render mesh with light bake shader
 		video::SMaterial irrMaterial;
@@ -146,10 +147,10 @@ namespace Skylicht
 		}
 
 		// set irrlicht material
-		driver->setMaterial(irrMaterial);
+		cache->setMaterial(irrMaterial);
 
 		// draw mesh buffer
-		driver->drawMeshBuffer(m_renderSubmesh[m_currentTarget]);
+		cache->drawMeshBuffer(m_renderSubmesh[m_currentTarget]);
 	}
 
 	void CDirectionalLightBakeRP::drawInstancingMeshBuffer(CMesh* mesh, int bufferID, int materialRenderID, CEntityManager* entityMgr, int entityID, bool skinnedMesh)
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CPointLightBakeRP.h"
+#include "RenderPipeline/CRenderStateCache.h"
 
 #include "Lighting/CDirectionalLight.h"
 #include "Lighting/CPointLight.h"
@@ -124,7 +125,7 @@ namespace Skylicht
 		if (mb != m_renderMesh)
 			return;
 
-		IVideoDriver* driver = getVideoDriver();
+		CRenderStateCache* cache = CRenderStateCache::getInstance();
 
 		// render mesh with light bake shader
 		video::SMaterial irrMaterial;
@@ -148,10 +149,10 @@ namespace Skylicht
 		}
 
 		// set irrlicht material
-		driver->setMaterial(irrMaterial);
+		cache->setMaterial(irrMaterial);
 
 		// draw mesh buffer
-		driver->drawMeshBuffer(m_renderSubmesh[m_currentTarget]);
+		cache->drawMeshBuffer(m_renderSubmesh[m_currentTarget]);
 	}
 
 	void CPointLightBakeRP::drawInstancingMeshBuffer(CMesh* mesh, int bufferID, int materialRenderID, CEntityManager* entityMgr, int entityID, bool skinnedMesh)
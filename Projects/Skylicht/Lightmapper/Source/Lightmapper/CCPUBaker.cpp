@@ -0,0 +1,348 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCPUBaker.h"
+#include "CBakeUtils.h"
+
+#include "Collision/CCollisionBuilder.h"
+#include "Lighting/CDirectionalLight.h"
+#include "Lighting/CPointLight.h"
+#include "Job/CJobSystem.h"
+
+namespace Skylicht
+{
+	namespace Lightmapper
+	{
+		static u32 hashSeed(u32 x)
+		{
+			x = (x ^ 61) ^ (x >> 16);
+			x = x + (x << 3);
+			x = x ^ (x >> 4);
+			x = x * 0x27d4eb2d;
+			x = x ^ (x >> 15);
+			return x;
+		}
+
+		static u32 hashPosition(const core::vector3df& position, const core::vector3df& normal)
+		{
+			// the seed depends only on the sample, not on its index in the batch
+			const f32 v[6] = { position.X, position.Y, position.Z, normal.X, normal.Y, normal.Z };
+
+			u32 h = 0x9e3779b9;
+			for (int i = 0; i < 6; i++)
+			{
+				u32 bits;
+				memcpy(&bits, &v[i], sizeof(u32));
+				h = hashSeed(h ^ bits);
+			}
+
+			// xorshift need a non zero seed
+			return h == 0 ? 1 : h;
+		}
+
+		static float randomFloat(u32& seed)
+		{
+			// xorshift32
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			return (seed >> 8) * (1.0f / 16777216.0f);
+		}
+
+		static core::vector3df randomCosineDirection(const core::vector3df& normal, u32& seed)
+		{
+			float r1 = randomFloat(seed);
+			float r2 = randomFloat(seed);
+
+			float phi = 2.0f * core::PI * r1;
+			float r = sqrtf(r2);
+
+			// the basis on normal
+			core::vector3df up = fabsf(normal.Y) < 0.99f ? core::vector3df(0.0f, 1.0f, 0.0f) : core::vector3df(1.0f, 0.0f, 0.0f);
+			core::vector3df tangent = up.crossProduct(normal);
+			tangent.normalize();
+			core::vector3df binormal = normal.crossProduct(tangent);
+
+			core::vector3df dir = tangent * (r * cosf(phi)) + binormal * (r * sinf(phi)) + normal * sqrtf(1.0f - r2);
+			dir.normalize();
+			return dir;
+		}
+
+		CCPUBaker::CCPUBaker(CCollisionBuilder* collision, u32 sampleSize) :
+			m_collision(collision),
+			m_defaultAlbedo(0.5f, 0.5f, 0.5f),
+			m_skyColor(0.0f, 0.0f, 0.0f),
+			m_sampleSize(0),
+			m_numBounce(1),
+			m_rayDistance(1000.0f),
+			m_bias(0.01f),
+			m_weightSum(0.0f)
+		{
+			setSampleSize(sampleSize);
+		}
+
+		CCPUBaker::~CCPUBaker()
+		{
+
+		}
+
+		void CCPUBaker::setSampleSize(u32 size)
+		{
+			m_sampleSize = core::max_(size, 2u);
+
+			m_sampleRays.set_used(0);
+			m_sampleWeights.set_used(0);
+			m_weightSum = 0.0f;
+
+			for (u32 y = 0; y < m_sampleSize; y++)
+			{
+				for (u32 x = 0; x < m_sampleSize; x++)
+				{
+					// the texel center in [-1, 1] texture space
+					float u = (((x + 0.5f) / float(m_sampleSize)) * 2.0f - 1.0f);
+					float v = -(((y + 0.5f) / float(m_sampleSize)) * 2.0f - 1.0f);
+
+					float temp = 1.0f + u * u + v * v;
+					float weight = 4.0f / (sqrt(temp) * temp);
+
+					m_sampleRays.push_back(core::vector3df(u, v, 1.0f));
+					m_sampleWeights.push_back(weight);
+					m_weightSum = m_weightSum + weight;
+				}
+			}
+		}
+
+		void CCPUBaker::setAlbedo(CCollisionNode* node, const SColorf& c)
+		{
+			m_albedo[node] = core::vector3df(c.r, c.g, c.b);
+		}
+
+		const core::vector3df& CCPUBaker::getAlbedo(CCollisionNode* node)
+		{
+			std::map<CCollisionNode*, core::vector3df>::iterator i = m_albedo.find(node);
+			if (i != m_albedo.end())
+				return i->second;
+			return m_defaultAlbedo;
+		}
+
+		void CCPUBaker::clearLights()
+		{
+			m_lights.clear();
+		}
+
+		bool CCPUBaker::addLight(CLight* light)
+		{
+			CDirectionalLight* directionalLight = dynamic_cast<CDirectionalLight*>(light);
+			if (directionalLight != NULL)
+			{
+				addDirectionalLight(directionalLight->getDirection(), directionalLight->getColor(), directionalLight->getIntensity());
+				return true;
+			}
+
+			CPointLight* pointLight = dynamic_cast<CPointLight*>(light);
+			if (pointLight != NULL)
+			{
+				addPointLight(pointLight->getPosition(), pointLight->getColor(), pointLight->getIntensity(), pointLight->getRadius());
+				return true;
+			}
+
+			return false;
+		}
+
+		void CCPUBaker::addDirectionalLight(const core::vector3df& direction, const SColorf& color, float intensity)
+		{
+			SBakeLight light;
+			light.Directional = true;
+			light.Direction = -direction;
+			light.Direction.normalize();
+			light.Color.set(color.r * intensity, color.g * intensity, color.b * intensity);
+			light.Attenuation = 0.0f;
+			m_lights.push_back(light);
+		}
+
+		void CCPUBaker::addPointLight(const core::vector3df& position, const SColorf& color, float intensity, float radius)
+		{
+			SBakeLight light;
+			light.Directional = false;
+			light.Position = position;
+			light.Color.set(color.r * intensity, color.g * intensity, color.b * intensity);
+			light.Attenuation = 1.0f / core::max_(radius, 0.01f);
+			m_lights.push_back(light);
+		}
+
+		void CCPUBaker::bake(const core::vector3df* position,
+			const core::vector3df* normal,
+			const core::vector3df* tangent,
+			const core::vector3df* binormal,
+			CSH9* out,
+			int count,
+			int numFace,
+			bool parallel)
+		{
+			if (m_collision == NULL)
+			{
+				os::Printer::log("[CCPUBaker::bake] Need set the collision first");
+				for (int i = 0; i < count; i++)
+					out[i].zero();
+				return;
+			}
+
+			// the seed of a position does not depend on the threads or the batch, so the result is the same
+			auto bakeJob = [&](int from, int to)
+				{
+					for (int i = from; i < to; i++)
+						bakePosition(position[i], normal[i], tangent[i], binormal[i], numFace, hashPosition(position[i], normal[i]), out[i]);
+				};
+
+			int numThread = 1;
+			if (parallel)
+				numThread = SkylichtSystem::CJobSystem::getInstance()->getWorkerCount() + 1;
+
+			if (numThread == 1 || count < 2)
+				bakeJob(0, count);
+			else
+				SkylichtSystem::CJobSystem::getInstance()->parallelFor(count, 1, bakeJob);
+		}
+
+		void CCPUBaker::bakePosition(const core::vector3df& position,
+			const core::vector3df& normal,
+			const core::vector3df& tangent,
+			const core::vector3df& binormal,
+			int numFace,
+			u32 seed,
+			CSH9& out)
+		{
+			core::matrix4 toTangentSpace;
+			core::vector3df dir;
+			core::vector3df color;
+
+			out.zero();
+
+			u32 numSample = m_sampleRays.size();
+
+			for (int face = 0; face < numFace; face++)
+			{
+				getWorldView(normal, tangent, binormal, position, face, toTangentSpace);
+
+				// remove position
+				setRow(toTangentSpace, 3, core::vector3df(0.0f, 0.0f, 0.0f), 1.0f);
+
+				for (u32 i = 0; i < numSample; i++)
+				{
+					dir = m_sampleRays[i];
+					toTangentSpace.rotateVect(dir);
+					dir.normalize();
+
+					color = traceRadiance(position, dir, m_numBounce, seed);
+
+					// the radiance texture of the hemicube is A8R8G8B8
+					float weight = m_sampleWeights[i];
+					color.X = core::clamp(color.X, 0.0f, 1.0f) * weight;
+					color.Y = core::clamp(color.Y, 0.0f, 1.0f) * weight;
+					color.Z = core::clamp(color.Z, 0.0f, 1.0f) * weight;
+
+					out.projectAddOntoSH(dir, color);
+				}
+			}
+
+			// finalWeight is weight for 1 pixel on Sphere
+			// S = 4 * PI * R^2
+			float finalWeight = (4.0f * 3.14159f) / (m_weightSum * numFace);
+			out *= finalWeight;
+		}
+
+		core::vector3df CCPUBaker::traceRadiance(const core::vector3df& start, const core::vector3df& direction, u32 bounce, u32& seed)
+		{
+			core::line3df ray(start, start + direction * m_rayDistance);
+
+			f32 distance = ray.getLengthSQ();
+			core::vector3df hit;
+			core::triangle3df triangle;
+			CCollisionNode* node = NULL;
+
+			if (!m_collision->getCollisionPoint(ray, distance, hit, triangle, node))
+				return m_skyColor;
+
+			// the surface is 2 sided
+			core::vector3df normal = triangle.getNormal();
+			normal.normalize();
+			if (normal.dotProduct(direction) > 0.0f)
+				normal = -normal;
+
+			core::vector3df position = hit + normal * m_bias;
+			core::vector3df irradiance = getDirectLighting(position, normal);
+
+			// the next bounce: a ray on the cosine distribution, the pdf cancels the cosine & PI
+			if (bounce > 1)
+				irradiance += traceRadiance(position, randomCosineDirection(normal, seed), bounce - 1, seed);
+
+			return irradiance * getAlbedo(node);
+		}
+
+		core::vector3df CCPUBaker::getDirectLighting(const core::vector3df& position, const core::vector3df& normal)
+		{
+			core::vector3df result;
+
+			for (const SBakeLight& light : m_lights)
+			{
+				if (light.Directional)
+				{
+					float NdotL = normal.dotProduct(light.Direction);
+					if (NdotL <= 0.0f)
+						continue;
+
+					core::line3df ray(position, position + light.Direction * m_rayDistance);
+					if (m_collision->hasCollision(ray))
+						continue;
+
+					result += light.Color * NdotL;
+				}
+				else
+				{
+					// see BakePointLightFS.glsl
+					core::vector3df lightDir = light.Position - position;
+					float distance = lightDir.getLength();
+					float attenuation = core::max_(0.0f, 1.0f - distance * light.Attenuation);
+					if (attenuation <= 0.0f)
+						continue;
+
+					lightDir /= distance;
+
+					float NdotL = normal.dotProduct(lightDir);
+					if (NdotL <= 0.0f)
+						continue;
+
+					core::line3df ray(position, light.Position);
+					if (m_collision->hasCollision(ray))
+						continue;
+
+					result += light.Color * (NdotL * attenuation);
+				}
+			}
+
+			return result;
+		}
+	}
+}
@@ -0,0 +1,183 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CSH9.h"
+#include "CBaker.h"
+#include "Lighting/CLight.h"
+
+namespace Skylicht
+{
+	class CCollisionBuilder;
+	class CCollisionNode;
+
+	namespace Lightmapper
+	{
+		struct SBakeLight
+		{
+			bool Directional;
+
+			// the point light position
+			core::vector3df Position;
+
+			// the direction from the surface to the directional light
+			core::vector3df Direction;
+
+			// color * intensity
+			core::vector3df Color;
+
+			float Attenuation;
+		};
+
+		// Bake the SH on CPU without the video driver.
+		// The rays are the texels of the hemicube faces (see CMTBaker), they are traced on the collision
+		// instead of render, so the SH have the same weights and the same result range.
+		class CCPUBaker
+		{
+		protected:
+			CCollisionBuilder* m_collision;
+
+			std::vector<SBakeLight> m_lights;
+
+			std::map<CCollisionNode*, core::vector3df> m_albedo;
+
+			core::vector3df m_defaultAlbedo;
+
+			core::vector3df m_skyColor;
+
+			u32 m_sampleSize;
+
+			u32 m_numBounce;
+
+			float m_rayDistance;
+
+			float m_bias;
+
+			// the ray (u, v, 1) and weight of the texels on a face
+			core::array<core::vector3df> m_sampleRays;
+
+			core::array<float> m_sampleWeights;
+
+			float m_weightSum;
+
+		public:
+			CCPUBaker(CCollisionBuilder* collision, u32 sampleSize = 16);
+
+			virtual ~CCPUBaker();
+
+			// the collision must be built before bake
+			inline void setCollision(CCollisionBuilder* collision)
+			{
+				m_collision = collision;
+			}
+
+			inline CCollisionBuilder* getCollision()
+			{
+				return m_collision;
+			}
+
+			// number of rays on a face is size * size
+			void setSampleSize(u32 size);
+
+			inline u32 getSampleSize()
+			{
+				return m_sampleSize;
+			}
+
+			// 1: direct light on the surfaces, > 1: the light reflects more times
+			inline void setNumBounce(u32 bounce)
+			{
+				m_numBounce = core::max_(bounce, 1u);
+			}
+
+			inline u32 getNumBounce()
+			{
+				return m_numBounce;
+			}
+
+			// the radiance of the rays that do not hit
+			inline void setSkyColor(const SColorf& c)
+			{
+				m_skyColor.set(c.r, c.g, c.b);
+			}
+
+			inline void setDefaultAlbedo(const SColorf& c)
+			{
+				m_defaultAlbedo.set(c.r, c.g, c.b);
+			}
+
+			void setAlbedo(CCollisionNode* node, const SColorf& c);
+
+			inline void setRayDistance(float d)
+			{
+				m_rayDistance = d;
+			}
+
+			inline void setBias(float b)
+			{
+				m_bias = b;
+			}
+
+			void clearLights();
+
+			// support CDirectionalLight & CPointLight
+			bool addLight(CLight* light);
+
+			void addDirectionalLight(const core::vector3df& direction, const SColorf& color, float intensity = 1.0f);
+
+			void addPointLight(const core::vector3df& position, const SColorf& color, float intensity = 1.0f, float radius = 3.0f);
+
+			inline u32 getNumLight()
+			{
+				return (u32)m_lights.size();
+			}
+
+			void bake(const core::vector3df* position,
+				const core::vector3df* normal,
+				const core::vector3df* tangent,
+				const core::vector3df* binormal,
+				CSH9* out,
+				int count,
+				int numFace = NUM_FACES,
+				bool parallel = true);
+
+		protected:
+
+			void bakePosition(const core::vector3df& position,
+				const core::vector3df& normal,
+				const core::vector3df& tangent,
+				const core::vector3df& binormal,
+				int numFace,
+				u32 seed,
+				CSH9& out);
+
+			core::vector3df traceRadiance(const core::vector3df& start, const core::vector3df& direction, u32 bounce, u32& seed);
+
+			core::vector3df getDirectLighting(const core::vector3df& position, const core::vector3df& normal);
+
+			const core::vector3df& getAlbedo(CCollisionNode* node);
+		};
+	}
+}
@@ -38,7 +38,8 @@ namespace Skylicht
 		CLightmapper::CLightmapper() :
 			m_singleBaker(NULL),
 			m_multiBaker(NULL),
-			m_gpuBaker(NULL)
+			m_gpuBaker(NULL),
+			m_cpuBaker(NULL)
 		{
 
 		}
@@ -67,6 +68,12 @@ namespace Skylicht
 				delete m_gpuBaker;
 				m_gpuBaker = NULL;
 			}
+
+			if (m_cpuBaker != NULL)
+			{
+				delete m_cpuBaker;
+				m_cpuBaker = NULL;
+			}
 		}
 
 		void CLightmapper::initBaker(u32 hemisphereBakeSize)
@@ -94,6 +101,14 @@ namespace Skylicht
 			m_gpuBaker = new CGPUBaker();
 		}
 
+		void CLightmapper::initCPUBaker(CCollisionBuilder* collision, u32 sampleSize)
+		{
+			if (m_cpuBaker != NULL)
+				delete m_cpuBaker;
+
+			m_cpuBaker = new CCPUBaker(collision, sampleSize);
+		}
+
 		const CSH9& CLightmapper::bakeAtPosition(
 			CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr,
 			const core::vector3df& position,
@@ -102,6 +117,12 @@ namespace Skylicht
 			const core::vector3df& binormal,
 			int numFace)
 		{
+			if (m_cpuBaker != NULL)
+			{
+				m_cpuBaker->bake(&position, &normal, &tangent, &binormal, &m_cpuResult, 1, numFace);
+				return m_cpuResult;
+			}
+
 			if (m_singleBaker == NULL)
 			{
 				os::Printer::log("[CLightmapper::bakeAtPosition] Need call initBaker first");
@@ -123,6 +144,14 @@ namespace Skylicht
 		{
 			out.clear();
 
+			if (m_cpuBaker != NULL)
+			{
+				// all positions at once, the baker splits them to the worker threads
+				out.resize(count);
+				m_cpuBaker->bake(position, normal, tangent, binormal, out.data(), count, numFace);
+				return;
+			}
+
 			if (m_multiBaker == NULL)
 			{
 				os::Printer::log("[CLightmapper::bakeAtPosition] Need call initBaker first");
@@ -361,6 +390,151 @@ namespace Skylicht
 			return count;
 		}
 
+		int CLightmapper::rasteriseLightmapMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CRasterisation** rasters, int numRaster, CRasterisation::ERasterPass pass)
+		{
+			if (mb->getVertexBufferCount() == 0 || mb->getVertexType() != EVT_2TCOORDS_TANGENTS)
+			{
+				char log[512];
+				sprintf(log, "[CLightmapper] rasteriseLightmapMeshBuffer skip non lightmap MeshBuffer");
+				os::Printer::log(log);
+				return 0;
+			}
+
+			IIndexBuffer* idx = mb->getIndexBuffer();
+			IVertexBuffer* vb = mb->getVertexBuffer(0);
+			video::S3DVertex2TCoordsTangents* vtx = (video::S3DVertex2TCoordsTangents*)vb->getVertices();
+
+			u32 numTris = idx->getIndexCount() / 3;
+
+			// the triangles of each lightmap, the lightmap index is on the first vertex
+			std::vector<core::array<SRasterTriangle>> triangles(numRaster);
+
+			for (u32 t = 0; t < numTris; t++)
+			{
+				u32 v[3];
+				for (int i = 0; i < 3; i++)
+				{
+					if (idx->getIndexSize() == 2)
+						v[i] = (u32)((u16*)idx->getIndices())[t * 3 + i];
+					else
+						v[i] = ((u32*)idx->getIndices())[t * 3 + i];
+				}
+
+				int lmIndex = (int)vtx[v[0]].Lightmap.Z;
+				if (lmIndex < 0 || lmIndex >= numRaster || rasters[lmIndex] == NULL)
+					continue;
+
+				SRasterTriangle tri;
+				for (int i = 0; i < 3; i++)
+				{
+					const video::S3DVertex2TCoordsTangents& vertex = vtx[v[i]];
+
+					tri.Position[i] = vertex.Pos;
+					tri.UV[i].set(vertex.Lightmap.X, vertex.Lightmap.Y);
+					tri.Normal[i] = vertex.Normal;
+					tri.Tangent[i] = vertex.Tangent;
+
+					transform.transformVect(tri.Position[i]);
+					transform.rotateVect(tri.Normal[i]);
+					transform.rotateVect(tri.Tangent[i]);
+
+					tri.Normal[i].normalize();
+					tri.Tangent[i].normalize();
+				}
+
+				triangles[lmIndex].push_back(tri);
+			}
+
+			int numQueued = 0;
+
+			for (int lm = 0; lm < numRaster; lm++)
+			{
+				if (triangles[lm].size() == 0)
+					continue;
+
+				CRasterisation* raster = rasters[lm];
+
+				u32 lastQueue = raster->getBakePixelQueue().size();
+				raster->rasterise(triangles[lm].const_pointer(), (int)triangles[lm].size(), pass);
+
+				numQueued += (int)(raster->getBakePixelQueue().size() - lastQueue);
+			}
+
+			return numQueued;
+		}
+
+		int CLightmapper::bakeLightmapPixels(CRasterisation* raster, int maxPixel, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr)
+		{
+			core::array<SBakePixel>& pixels = raster->getBakePixelQueue();
+			if (pixels.size() == 0 || maxPixel <= 0)
+				return 0;
+
+			// bake the last pixels, so the queue is not moved
+			u32 n = core::min_((u32)maxPixel, pixels.size());
+			u32 begin = pixels.size() - n;
+
+			core::array<core::vector3df> positions;
+			core::array<core::vector3df> normals;
+			core::array<core::vector3df> tangents;
+			core::array<core::vector3df> binormals;
+			std::vector<CSH9> resultSH;
+
+			positions.set_used(n);
+			normals.set_used(n);
+			tangents.set_used(n);
+			binormals.set_used(n);
+
+			for (u32 i = 0; i < n; i++)
+			{
+				const SBakePixel& p = pixels[begin + i];
+				positions[i] = p.Position;
+				normals[i] = p.Normal;
+				tangents[i] = p.Tangent;
+				binormals[i] = p.Binormal;
+			}
+
+			bakeAtPosition(
+				camera,
+				rp,
+				entityMgr,
+				positions.pointer(),
+				normals.pointer(),
+				tangents.pointer(),
+				binormals.pointer(),
+				resultSH,
+				(int)n,
+				5);
+
+			if (resultSH.size() != n)
+			{
+				// the baker is not init
+				pixels.set_used(begin);
+				return 0;
+			}
+
+			// write result to image
+			raster->flushPixel(resultSH, n);
+			return (int)n;
+		}
+
+		int CLightmapper::bakeLightmapMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CRasterisation** rasters, int numRaster, CRasterisation::ERasterPass pass, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr)
+		{
+			rasteriseLightmapMeshBuffer(mb, transform, rasters, numRaster, pass);
+
+			int numBaked = 0;
+
+			for (int lm = 0; lm < numRaster; lm++)
+			{
+				if (rasters[lm] == NULL)
+					continue;
+
+				int n = (int)rasters[lm]->getBakePixelQueue().size();
+				numBaked += bakeLightmapPixels(rasters[lm], n, camera, rp, entityMgr);
+			}
+
+			return numBaked;
+		}
+
 		void CLightmapper::setNumThread(u32 num)
 		{
 			g_numThread = num;
@@ -28,7 +28,9 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CBaker.h"
 #include "CMTBaker.h"
 #include "CGPUBaker.h"
+#include "CCPUBaker.h"
 #include "LightProbes/CLightProbe.h"
+#include "Rasterisation/CRasterisation.h"
 
 namespace Skylicht
 {
@@ -43,8 +45,10 @@ namespace Skylicht
 			CBaker* m_singleBaker;
 			CMTBaker* m_multiBaker;
 			CGPUBaker* m_gpuBaker;
+			CCPUBaker* m_cpuBaker;
 
 			CSH9 m_temp;
+			CSH9 m_cpuResult;
 
 		public:
 			CLightmapper();
@@ -53,6 +57,15 @@ namespace Skylicht
 
 			void initBaker(u32 hemisphereBakeSize = 128);
 
+			// bake by tracing the rays on the collision (it must be built), it does not need the video driver
+			// so camera, rp, entityMgr can be NULL on the bake functions
+			void initCPUBaker(CCollisionBuilder* collision, u32 sampleSize = 16);
+
+			inline CCPUBaker* getCPUBaker()
+			{
+				return m_cpuBaker;
+			}
+
 			void release();
 
 			const CSH9& bakeAtPosition(
@@ -79,6 +92,17 @@ namespace Skylicht
 
 			int bakeMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr, int begin, int count, core::array<SColor>& outColor, core::array<CSH9>& outSH);
 
+			// rasterise the triangles of the mesh buffer (EVT_2TCOORDS_TANGENTS, Lightmap.Z is the lightmap index) on the tiles, see CRasterisation::rasterise
+			// the pixels of the pass are queued on the rasters, return the number of queued pixels
+			int rasteriseLightmapMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CRasterisation** rasters, int numRaster, CRasterisation::ERasterPass pass);
+
+			// bake maximum maxPixel queued pixels of the raster to the lightmap, so the bake can be split on many frames
+			// return the number of baked pixels
+			int bakeLightmapPixels(CRasterisation* raster, int maxPixel, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr);
+
+			// rasterise the mesh buffer and bake all the pixels of the pass, return the number of baked pixels
+			int bakeLightmapMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CRasterisation** rasters, int numRaster, CRasterisation::ERasterPass pass, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr);
+
 			static void setNumThread(u32 num);
 
 			static void setHemisphereBakeSize(u32 size);
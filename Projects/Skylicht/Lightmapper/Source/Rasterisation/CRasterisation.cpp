@@ -25,6 +25,9 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CRasterisation.h"
 #include "SutherlandHodgman.h"
+#include "Utils/CSIMD.h"
+
+#include <new>
 
 namespace Skylicht
 {
@@ -268,11 +271,6 @@ namespace Skylicht
 			const core::vector3df* tangent,
 			ERasterPass pass)
 		{
-			core::vector2df minUV, maxUV;
-
-			minUV = uv[0];
-			maxUV = uv[0];
-
 			m_currentPass = pass;
 
 			for (int i = 0; i < 3; i++)
@@ -282,60 +280,98 @@ namespace Skylicht
 				m_uv[i] = uv[i];
 				m_normal[i] = normal[i];
 				m_tangent[i] = tangent[i];
+			}
+
+			initTriangleSetup(uv, m_setup);
+
+			for (int i = 0; i < 3; i++)
+				m_uvf[i] = m_setup.UVf[i];
+
+			m_uvMin = m_setup.UVMin;
+			m_uvMax = m_setup.UVMax;
+
+			// return first lm pixel of triangle
+			core::vector2di pixel = m_uvMin;
+
+			pixel.X += getPassOffsetX(m_currentPass);
+			pixel.Y += getPassOffsetY(m_currentPass);
+
+			return pixel;
+		}
+
+		void CRasterisation::initTriangleSetup(const core::vector2df* uv, STriangleSetup& setup)
+		{
+			core::vector2df minUV, maxUV;
+
+			minUV = uv[0];
+			maxUV = uv[0];
 
-				float x = m_uv[i].X;
-				float y = m_uv[i].Y;
+			for (int i = 0; i < 3; i++)
+			{
+				float x = uv[i].X;
+				float y = uv[i].Y;
 
 				minUV.X = core::min_(minUV.X, x);
 				minUV.Y = core::min_(minUV.Y, y);
 				maxUV.X = core::max_(maxUV.X, x);
 				maxUV.Y = core::max_(maxUV.Y, y);
 
-				m_uvf[i].X = fmodf(x, 1.0f) * (float)m_width;
-				m_uvf[i].Y = fmodf(y, 1.0f) * (float)m_height;
+				setup.UVf[i].X = fmodf(x, 1.0f) * (float)m_width;
+				setup.UVf[i].Y = fmodf(y, 1.0f) * (float)m_height;
 			}
 
-			// calc bound triangle in uv coord			
-			m_uvMin.X = (int)(fmodf(minUV.X, 1.0f) * (float)m_width);
-			m_uvMin.Y = (int)(fmodf(minUV.Y, 1.0f) * (float)m_height);
-			m_uvMax.X = (int)(fmodf(maxUV.X, 1.0f) * (float)m_width);
-			m_uvMax.Y = (int)(fmodf(maxUV.Y, 1.0f) * (float)m_height);
+			// calc bound triangle in uv coord
+			setup.UVMin.X = (int)(fmodf(minUV.X, 1.0f) * (float)m_width);
+			setup.UVMin.Y = (int)(fmodf(minUV.Y, 1.0f) * (float)m_height);
+			setup.UVMax.X = (int)(fmodf(maxUV.X, 1.0f) * (float)m_width);
+			setup.UVMax.Y = (int)(fmodf(maxUV.Y, 1.0f) * (float)m_height);
 
 			// offset 1 pixel
-			m_uvMin.X = core::max_(m_uvMin.X - 1, 0);
-			m_uvMin.Y = core::max_(m_uvMin.Y - 1, 0);
-			m_uvMax.X = core::min_(m_uvMax.X + 1, m_width - 1);
-			m_uvMax.Y = core::min_(m_uvMax.Y + 1, m_height - 1);
-
-			// return first lm pixel of triangle
-			core::vector2di pixel = m_uvMin;
-
-			pixel.X += getPassOffsetX(m_currentPass);
-			pixel.Y += getPassOffsetY(m_currentPass);
+			setup.UVMin.X = core::max_(setup.UVMin.X - 1, 0);
+			setup.UVMin.Y = core::max_(setup.UVMin.Y - 1, 0);
+			setup.UVMax.X = core::min_(setup.UVMax.X + 1, m_width - 1);
+			setup.UVMax.Y = core::min_(setup.UVMax.Y + 1, m_height - 1);
 
-			return pixel;
+			initTriangleConstants(setup);
 		}
 
-		static core::vector2df toBarycentric(const core::vector2df& p1, const core::vector2df& p2, const core::vector2df& p3, const core::vector2df& p)
+		void CRasterisation::initTriangleConstants(STriangleSetup& setup)
 		{
+			const core::vector2df* p = setup.UVf;
+
+			// edge function: >= 0 inside the triangle
+			for (int i = 0; i < 3; i++)
+			{
+				const core::vector2df& a = p[i];
+				const core::vector2df& b = p[(i + 1) % 3];
+
+				setup.EdgeA[i] = a.Y - b.Y;
+				setup.EdgeB[i] = b.X - a.X;
+				setup.EdgeC[i] = a.X * b.Y - a.Y * b.X;
+			}
+
+			float area = setup.EdgeA[0] * p[2].X + setup.EdgeB[0] * p[2].Y + setup.EdgeC[0];
+			if (area < 0.0f)
+			{
+				for (int i = 0; i < 3; i++)
+				{
+					setup.EdgeA[i] = -setup.EdgeA[i];
+					setup.EdgeB[i] = -setup.EdgeB[i];
+					setup.EdgeC[i] = -setup.EdgeC[i];
+				}
+			}
+
+			// degenerate triangle: always clip
+			setup.UseEdge = fabsf(area) > 0.0001f;
+
+			// barycentric
 			// http://www.blackpawn.com/texts/pointinpoly/
-			// Compute vectors
-			core::vector2df v0 = p3 - p1;
-			core::vector2df v1 = p2 - p1;
-			core::vector2df v2 = p - p1;
-
-			// Compute dot products
-			float dot00 = v0.dotProduct(v0);
-			float dot01 = v0.dotProduct(v1);
-			float dot02 = v0.dotProduct(v2);
-			float dot11 = v1.dotProduct(v1);
-			float dot12 = v1.dotProduct(v2);
-
-			// Compute barycentric coordinates
-			float invDenom = 1.0f / (dot00 * dot11 - dot01 * dot01);
-			float u = (dot11 * dot02 - dot01 * dot12) * invDenom;
-			float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
-			return core::vector2df(u, v);
+			setup.V0 = p[2] - p[0];
+			setup.V1 = p[1] - p[0];
+			setup.Dot00 = setup.V0.dotProduct(setup.V0);
+			setup.Dot01 = setup.V0.dotProduct(setup.V1);
+			setup.Dot11 = setup.V1.dotProduct(setup.V1);
+			setup.InvDenom = 1.0f / (setup.Dot00 * setup.Dot11 - setup.Dot01 * setup.Dot01);
 		}
 
 		core::vector3df CRasterisation::sampleVector3(const core::vector3df* p, const core::vector2df& uv)
@@ -356,75 +392,146 @@ namespace Skylicht
 			core::vector3df& outTangent,
 			core::vector3df& outBinormal,
 			core::vector2di& lmPixel)
+		{
+			// finish
+			if (isFinished(lmPixel) == true)
+				return false;
+
+			bool needBake = false;
+			core::vector2df uv;
+
+			if (!rasterPixel(m_setup, lmPixel.X, lmPixel.Y, m_currentPass, m_bakedData, needBake, uv))
+				return false;
+
+			if (needBake)
+			{
+				m_bakePixels.push_back(SBakePixel());
+				initBakePixel(m_bakePixels.getLast(), lmPixel.X, lmPixel.Y, m_position, m_normal, m_tangent, uv);
+			}
+
+			// bake pixel
+			return true;
+		}
+
+		bool CRasterisation::samplePixel(const STriangleSetup& setup, int x, int y, core::vector2df& outUV)
 		{
 			// Reference:
 			// function: lm_trySamplingConservativeTriangleRasterizerPosition
 			// https://github.com/ands/lightmapper/blob/master/lightmapper.h
 
-			int x = lmPixel.X;
-			int y = lmPixel.Y;
-
 			float fx = (float)x;
 			float fy = (float)y;
 
-			// this pixel is baked
-			int dataOffset = y * m_width + x;
+			core::vector2df centroid;
+			bool insideTriangle = false;
 
-			// finish
-			if (isFinished(lmPixel) == true)
-				return false;
+			if (setup.UseEdge)
+			{
+				// the edge functions at 4 corners of the pixel
+				const f32 cornerX[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+				const f32 cornerY[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
 
-			if (m_bakedData[dataOffset] == true)
-				return false;
+				f32x4 px = CSIMD::add4(CSIMD::splat4(fx), CSIMD::load4(cornerX));
+				f32x4 py = CSIMD::add4(CSIMD::splat4(fy), CSIMD::load4(cornerY));
+				f32x4 zero = CSIMD::splat4(0.0f);
 
-			// check pixel inside triangle
-			core::vector2df poly[4];
-			poly[0] = core::vector2df(fx, fy);
-			poly[1] = core::vector2df(fx + 1.0f, fy);
-			poly[2] = core::vector2df(fx + 1.0f, fy + 1.0f);
-			poly[3] = core::vector2df(fx, fy + 1.0f);
+				int outside = 0;
+				for (int i = 0; i < 3; i++)
+				{
+					f32x4 e = CSIMD::madd4(CSIMD::splat4(setup.EdgeA[i]), px,
+						CSIMD::madd4(CSIMD::splat4(setup.EdgeB[i]), py, CSIMD::splat4(setup.EdgeC[i])));
 
-			core::vector2df res[16];
-			int nRes = 0;
+					int mask = CSIMD::mask4(CSIMD::less4(e, zero));
 
-			// clip rect poly with triangle
-			SutherlandHodgman(m_uvf, 3, poly, 4, res, nRes);
-			if (nRes == 0)
-			{
-				return false;
+					// the pixel is outside of an edge
+					if (mask == 0xF)
+						return false;
+
+					outside |= mask;
+				}
+
+				// the pixel is inside: no need to clip
+				if (outside == 0)
+				{
+					centroid.set(fx + 0.5f, fy + 0.5f);
+					insideTriangle = true;
+				}
 			}
 
-			// calculate centroid position and area
-			core::vector2df centroid = res[0];
-			float area = res[nRes - 1].X * res[0].Y - res[nRes - 1].Y * res[0].X;
-			for (int i = 1; i < nRes; i++)
+			if (!insideTriangle)
 			{
-				centroid = centroid + res[i];
-				area += res[i - 1].X * res[i].Y - res[i - 1].Y * res[i].X;
+				// check pixel inside triangle
+				core::vector2df poly[4];
+				poly[0] = core::vector2df(fx, fy);
+				poly[1] = core::vector2df(fx + 1.0f, fy);
+				poly[2] = core::vector2df(fx + 1.0f, fy + 1.0f);
+				poly[3] = core::vector2df(fx, fy + 1.0f);
+
+				core::vector2df res[16];
+				int nRes = 0;
+
+				// clip rect poly with triangle
+				core::vector2df uvf[3] = { setup.UVf[0], setup.UVf[1], setup.UVf[2] };
+				SutherlandHodgman(uvf, 3, poly, 4, res, nRes);
+				if (nRes == 0)
+				{
+					return false;
+				}
+
+				// calculate centroid position and area
+				centroid = res[0];
+				float area = res[nRes - 1].X * res[0].Y - res[nRes - 1].Y * res[0].X;
+				for (int i = 1; i < nRes; i++)
+				{
+					centroid = centroid + res[i];
+					area += res[i - 1].X * res[i].Y - res[i - 1].Y * res[i].X;
+				}
+				centroid = centroid / (float)nRes;
+				area = fabsf(area / 2.0f);
+
+				if (area <= 0.0f)
+					return false; // no area left
 			}
-			centroid = centroid / (float)nRes;
-			area = fabsf(area / 2.0f);
 
-			if (area <= 0.0f)
-				return false; // no area left
+			// barycentric with the constants of triangle
+			core::vector2df v2 = centroid - setup.UVf[0];
+			float dot02 = setup.V0.dotProduct(v2);
+			float dot12 = setup.V1.dotProduct(v2);
 
-			core::vector2df uv = toBarycentric(
-				m_uvf[0],
-				m_uvf[1],
-				m_uvf[2],
-				centroid);
+			outUV.X = (setup.Dot11 * dot02 - setup.Dot01 * dot12) * setup.InvDenom;
+			outUV.Y = (setup.Dot00 * dot12 - setup.Dot01 * dot02) * setup.InvDenom;
 
-			if (!isfinite(uv.X) || !isfinite(uv.Y))
+			if (!isfinite(outUV.X) || !isfinite(outUV.Y))
 				return false; // degenerate
 
+			return true;
+		}
+
+		bool CRasterisation::rasterPixel(
+			const STriangleSetup& setup,
+			int x, int y,
+			ERasterPass pass,
+			const bool* neighborBakedData,
+			bool& outNeedBake,
+			core::vector2df& outUV)
+		{
+			// this pixel is baked
+			int dataOffset = y * m_width + x;
+
+			if (m_bakedData[dataOffset] == true)
+				return false;
+
+			if (!samplePixel(setup, x, y, outUV))
+				return false;
+
 			// set baked
 			m_bakedData[dataOffset] = true;
 
 			bool useInterpolate = false;
 
-			if (m_currentPass >= Space2BX)
+			if (pass >= Space2BX)
 			{
-				useInterpolate = tryInterpolate(x, y);
+				useInterpolate = tryInterpolate(x, y, pass, setup.UVMin, setup.UVMax, neighborBakedData);
 				if (useInterpolate == true)
 				{
 					// fill test color
@@ -436,35 +543,163 @@ namespace Skylicht
 
 			if (useInterpolate == false)
 			{
-				m_bakePixels.push_back(SBakePixel());
-				SBakePixel& p = m_bakePixels.getLast();
-				p.Pixel = lmPixel;
-
-				// calc position 			
-				p.Position = sampleVector3(m_position, uv);
-
-				// calc normal
-				p.Normal = sampleVector3(m_normal, uv);
-				p.Normal.normalize();
-
-				// calc tangent
-				p.Tangent = sampleVector3(m_tangent, uv);
-				p.Tangent.normalize();
-
-				// calc binormal
-				p.Binormal = p.Normal.crossProduct(p.Tangent);
-				p.Binormal.normalize();
-
 				// fill test color
 				m_testBakedData[dataOffset * 3] = 255;
 				m_testBakedData[dataOffset * 3 + 1] = 0;
 				m_testBakedData[dataOffset * 3 + 2] = 0;
 			}
 
-			// bake pixel
+			outNeedBake = !useInterpolate;
 			return true;
 		}
 
+		void CRasterisation::initBakePixel(
+			SBakePixel& p,
+			int x, int y,
+			const core::vector3df* position,
+			const core::vector3df* normal,
+			const core::vector3df* tangent,
+			const core::vector2df& uv)
+		{
+			p.Pixel.set(x, y);
+
+			// calc position
+			p.Position = sampleVector3(position, uv);
+
+			// calc normal
+			p.Normal = sampleVector3(normal, uv);
+			p.Normal.normalize();
+
+			// calc tangent
+			p.Tangent = sampleVector3(tangent, uv);
+			p.Tangent.normalize();
+
+			// calc binormal
+			p.Binormal = p.Normal.crossProduct(p.Tangent);
+			p.Binormal.normalize();
+		}
+
+		struct SRasterSample
+		{
+			int X;
+			int Y;
+			int Triangle;
+			core::vector2df UV;
+		};
+
+		void CRasterisation::rasterise(const SRasterTriangle* triangles, int count, ERasterPass pass)
+		{
+			m_currentPass = pass;
+
+			int size = m_width * m_height;
+			int step = getPixelStep(pass);
+			int offsetX = getPassOffsetX(pass);
+			int offsetY = getPassOffsetY(pass);
+
+			// the interpolation reads the pixels of the previous passes
+			bool* passBakedData = new bool[size];
+			memcpy(passBakedData, m_bakedData, sizeof(bool) * size);
+
+			std::vector<STriangleSetup> setups(count);
+
+#pragma omp parallel for
+			for (int i = 0; i < count; i++)
+				initTriangleSetup(triangles[i].UV, setups[i]);
+
+			// the triangles of a tile keep the order, so the first triangle bakes the shared pixel as setTriangle
+			int tilesX = (m_width + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+			int tilesY = (m_height + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+			int numTiles = tilesX * tilesY;
+
+			std::vector<std::vector<int>> tileTriangles(numTiles);
+
+			for (int i = 0; i < count; i++)
+			{
+				const STriangleSetup& setup = setups[i];
+
+				// see moveNextPixel: the first pixel of a row is always sampled
+				int x0 = setup.UVMin.X + offsetX;
+				int y0 = setup.UVMin.Y + offsetY;
+				int x1 = core::min_(core::max_(setup.UVMax.X, x0 + 1), m_width) - 1;
+				int y1 = core::min_(setup.UVMax.Y, m_height) - 1;
+
+				if (x0 > x1 || y0 > y1)
+					continue;
+
+				for (int ty = y0 / RASTER_TILE_SIZE, ty1 = y1 / RASTER_TILE_SIZE; ty <= ty1; ty++)
+				{
+					for (int tx = x0 / RASTER_TILE_SIZE, tx1 = x1 / RASTER_TILE_SIZE; tx <= tx1; tx++)
+						tileTriangles[ty * tilesX + tx].push_back(i);
+				}
+			}
+
+			std::vector<std::vector<SRasterSample>> tileSamples(numTiles);
+
+#pragma omp parallel for schedule(dynamic)
+			for (int tile = 0; tile < numTiles; tile++)
+			{
+				int tileMinX = (tile % tilesX) * RASTER_TILE_SIZE;
+				int tileMinY = (tile / tilesX) * RASTER_TILE_SIZE;
+				int tileMaxX = core::min_(tileMinX + RASTER_TILE_SIZE, m_width);
+				int tileMaxY = core::min_(tileMinY + RASTER_TILE_SIZE, m_height);
+
+				for (int i : tileTriangles[tile])
+				{
+					const STriangleSetup& setup = setups[i];
+
+					int x0 = setup.UVMin.X + offsetX;
+					int y0 = setup.UVMin.Y + offsetY;
+					int x1 = core::min_(core::max_(setup.UVMax.X, x0 + 1), tileMaxX);
+					int y1 = core::min_(setup.UVMax.Y, tileMaxY);
+
+					// the first pixel of the pass inside the tile
+					if (x0 < tileMinX)
+						x0 += ((tileMinX - x0 + step - 1) / step) * step;
+					if (y0 < tileMinY)
+						y0 += ((tileMinY - y0 + step - 1) / step) * step;
+
+					for (int y = y0; y < y1; y += step)
+					{
+						for (int x = x0; x < x1; x += step)
+						{
+							bool needBake = false;
+							core::vector2df uv;
+
+							if (rasterPixel(setup, x, y, pass, passBakedData, needBake, uv) && needBake)
+								tileSamples[tile].push_back({ x, y, i, uv });
+						}
+					}
+				}
+			}
+
+			// the bake pixels of the tiles are in the tile order
+			std::vector<u32> tileOffset(numTiles);
+
+			u32 numPixel = m_bakePixels.size();
+			for (int tile = 0; tile < numTiles; tile++)
+			{
+				tileOffset[tile] = numPixel;
+				numPixel += (u32)tileSamples[tile].size();
+			}
+
+			// set_used does not construct the new pixels, they are constructed by the tiles
+			m_bakePixels.set_used(numPixel);
+
+#pragma omp parallel for schedule(dynamic)
+			for (int tile = 0; tile < numTiles; tile++)
+			{
+				u32 offset = tileOffset[tile];
+				for (const SRasterSample& sample : tileSamples[tile])
+				{
+					const SRasterTriangle& triangle = triangles[sample.Triangle];
+					SBakePixel* p = new (&m_bakePixels[offset++]) SBakePixel();
+					initBakePixel(*p, sample.X, sample.Y, triangle.Position, triangle.Normal, triangle.Tangent, sample.UV);
+				}
+			}
+
+			delete[] passBakedData;
+		}
+
 		bool CRasterisation::moveNextPixel(core::vector2di& lmPixel)
 		{
 			int step = getPixelStep(m_currentPass);
@@ -511,10 +746,15 @@ namespace Skylicht
 
 		bool CRasterisation::tryInterpolate(int x, int y)
 		{
-			bool interpolateX = isInterpolateX(m_currentPass);
-			bool interpolateY = isInterpolateY(m_currentPass);
+			return tryInterpolate(x, y, m_currentPass, m_uvMin, m_uvMax, m_bakedData);
+		}
+
+		bool CRasterisation::tryInterpolate(int x, int y, ERasterPass pass, const core::vector2di& uvMin, const core::vector2di& uvMax, const bool* bakedData)
+		{
+			bool interpolateX = isInterpolateX(pass);
+			bool interpolateY = isInterpolateY(pass);
 
-			int d = getPixelStep(m_currentPass) / 2;
+			int d = getPixelStep(pass) / 2;
 
 			float neighbors[4][3];
 
@@ -524,11 +764,11 @@ namespace Skylicht
 			if (interpolateX == true)
 			{
 				neighborsExpected += 2;
-				if (x - d >= m_uvMin.X && x + d <= m_uvMax.X)
+				if (x - d >= uvMin.X && x + d <= uvMax.X)
 				{
 					float c[3];
 
-					if (isBaked(x - d, y) == true)
+					if (bakedData[y * m_width + x - d] == true)
 					{
 						getLightmapPixel(x - d, y, c);
 						neighbors[neighborCount][0] = c[0];
@@ -537,7 +777,7 @@ namespace Skylicht
 						neighborCount++;
 					}
 
-					if (isBaked(x + d, y) == true)
+					if (bakedData[y * m_width + x + d] == true)
 					{
 						getLightmapPixel(x + d, y, c);
 						neighbors[neighborCount][0] = c[0];
@@ -551,11 +791,11 @@ namespace Skylicht
 			if (interpolateY == true)
 			{
 				neighborsExpected += 2;
-				if (y - d >= m_uvMin.Y && y + d <= m_uvMax.Y)
+				if (y - d >= uvMin.Y && y + d <= uvMax.Y)
 				{
 					float c[3];
 
-					if (isBaked(x, y - d) == true)
+					if (bakedData[(y - d) * m_width + x] == true)
 					{
 						getLightmapPixel(x, y - d, c);
 						neighbors[neighborCount][0] = c[0];
@@ -564,7 +804,7 @@ namespace Skylicht
 						neighborCount++;
 					}
 
-					if (isBaked(x, y + d) == true)
+					if (bakedData[(y + d) * m_width + x] == true)
 					{
 						getLightmapPixel(x, y + d, c);
 						neighbors[neighborCount][0] = c[0];
@@ -630,7 +870,13 @@ namespace Skylicht
 
 		void CRasterisation::flushPixel(std::vector<CSH9>& bakeResults)
 		{
-			int n = (int)m_bakePixels.size();
+			flushPixel(bakeResults, m_bakePixels.size());
+		}
+
+		void CRasterisation::flushPixel(std::vector<CSH9>& bakeResults, u32 count)
+		{
+			int n = (int)core::min_(count, m_bakePixels.size());
+			u32 begin = m_bakePixels.size() - (u32)n;
 
 			core::vector3df result;
 			float r, g, b;
@@ -640,7 +886,7 @@ namespace Skylicht
 #pragma omp parallel for private(result, r, g, b, colorR, colorG, colorB, dataOffset)
 			for (int i = 0; i < n; i++)
 			{
-				SBakePixel& p = m_bakePixels[i];
+				SBakePixel& p = m_bakePixels[begin + i];
 
 				bakeResults[i].getSHIrradiance(p.Normal, result);
 
@@ -670,7 +916,7 @@ namespace Skylicht
 				m_lightmapData[dataOffset * 3 + 2] = colorB;
 			}
 
-			m_bakePixels.set_used(0);
+			m_bakePixels.set_used(begin);
 		}
 
 		void CRasterisation::imageDilate()
@@ -680,6 +926,8 @@ namespace Skylicht
 			u32 sizeLightmapImage = m_width * m_height * 3;
 			unsigned char* tempData = new unsigned char[sizeLightmapImage];
 
+			// the rows only read m_lightmapData, write tempData
+#pragma omp parallel for
 			for (int y = 0; y < m_height; y++)
 			{
 				for (int x = 0; x < m_width; x++)
@@ -861,6 +1109,14 @@ namespace Skylicht
 
 			m_lightmapData = new unsigned char[size * 3];
 			stream->readData(m_lightmapData, size * 3);
+
+			// the current triangle
+			for (int i = 0; i < 3; i++)
+				m_setup.UVf[i] = m_uvf[i];
+
+			m_setup.UVMin = m_uvMin;
+			m_setup.UVMax = m_uvMax;
+			initTriangleConstants(m_setup);
 		}
 	}
 }
\ No newline at end of file
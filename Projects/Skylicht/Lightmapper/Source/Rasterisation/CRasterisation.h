@@ -28,6 +28,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Utils/CMemoryStream.h"
 
+#define RASTER_TILE_SIZE 64
+
 namespace Skylicht
 {
 	namespace Lightmapper
@@ -43,6 +45,14 @@ namespace Skylicht
 			CSH9 SH;
 		};
 
+		struct SRasterTriangle
+		{
+			core::vector3df Position[3];
+			core::vector2df UV[3];
+			core::vector3df Normal[3];
+			core::vector3df Tangent[3];
+		};
+
 		class CRasterisation
 		{
 		public:
@@ -96,6 +106,26 @@ namespace Skylicht
 			};
 
 		protected:
+			// the lightmap pixel bound, edge functions & barycentric constants of a triangle
+			struct STriangleSetup
+			{
+				core::vector2df UVf[3];
+				core::vector2di UVMin;
+				core::vector2di UVMax;
+
+				float EdgeA[3];
+				float EdgeB[3];
+				float EdgeC[3];
+				bool UseEdge;
+
+				core::vector2df V0;
+				core::vector2df V1;
+				float Dot00;
+				float Dot01;
+				float Dot11;
+				float InvDenom;
+			};
+
 			bool *m_bakedData;
 
 			int m_width;
@@ -120,9 +150,36 @@ namespace Skylicht
 
 			float m_interpolationThreshold;
 
+			STriangleSetup m_setup;
+
 		private:
 			core::vector3df sampleVector3(const core::vector3df* p, const core::vector2df& uv);
 
+		protected:
+			void initTriangleSetup(const core::vector2df* uv, STriangleSetup& setup);
+
+			void initTriangleConstants(STriangleSetup& setup);
+
+			bool samplePixel(const STriangleSetup& setup, int x, int y, core::vector2df& outUV);
+
+			bool rasterPixel(
+				const STriangleSetup& setup,
+				int x, int y,
+				ERasterPass pass,
+				const bool* neighborBakedData,
+				bool& outNeedBake,
+				core::vector2df& outUV);
+
+			void initBakePixel(
+				SBakePixel& p,
+				int x, int y,
+				const core::vector3df* position,
+				const core::vector3df* normal,
+				const core::vector3df* tangent,
+				const core::vector2df& uv);
+
+			bool tryInterpolate(int x, int y, ERasterPass pass, const core::vector2di& uvMin, const core::vector2di& uvMax, const bool* bakedData);
+
 		public:
 			CRasterisation(int width, int height);
 
@@ -154,6 +211,10 @@ namespace Skylicht
 				core::vector3df& outBinormal,
 				core::vector2di& lmPixel);
 
+			// rasterise all triangles of a pass on the tiles in parallel, it is the same as setTriangle + moveNextPixel
+			// but the interpolation only use the pixels of the previous passes, so the result does not depend on the threads
+			void rasterise(const SRasterTriangle* triangles, int count, ERasterPass pass);
+
 			void imageDilate();
 
 			bool moveNextPixel(core::vector2di& lmPixel);
@@ -198,6 +259,9 @@ namespace Skylicht
 
 			void flushPixel(std::vector<CSH9>& bakeResults);
 
+			// write the bake results of the last count pixels in the queue, and remove them from the queue
+			void flushPixel(std::vector<CSH9>& bakeResults, u32 count);
+
 			void save(CMemoryStream* stream);
 
 			void load(CMemoryStream* stream);
@@ -0,0 +1,320 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CJobSystem.h"
+
+#include <thread>
+#include <chrono>
+
+namespace SkylichtSystem
+{
+	// the queue of the worker thread, 0 is not a worker (see CJobSystem::getQueueIndex)
+	thread_local int t_queueIndex = 0;
+
+	CJobSystem* CJobSystem::s_instance = NULL;
+
+	CJobQueue::CJobQueue()
+	{
+		m_mutex = IMutex::createMutex();
+	}
+
+	CJobQueue::~CJobQueue()
+	{
+		delete m_mutex;
+	}
+
+	void CJobQueue::push(const SJob& job)
+	{
+		SScopeMutex lock(m_mutex);
+		m_jobs.push_back(job);
+	}
+
+	bool CJobQueue::pop(SJob& job)
+	{
+		SScopeMutex lock(m_mutex);
+		if (m_jobs.empty())
+			return false;
+
+		job = m_jobs.back();
+		m_jobs.pop_back();
+		return true;
+	}
+
+	bool CJobQueue::steal(SJob& job)
+	{
+		SScopeMutex lock(m_mutex);
+		if (m_jobs.empty())
+			return false;
+
+		job = m_jobs.front();
+		m_jobs.pop_front();
+		return true;
+	}
+
+	CJobWorker::CJobWorker(CJobSystem* jobSystem, int queueIndex) :
+		m_jobSystem(jobSystem),
+		m_queueIndex(queueIndex)
+	{
+
+	}
+
+	CJobWorker::~CJobWorker()
+	{
+
+	}
+
+	void CJobWorker::runThread()
+	{
+		t_queueIndex = m_queueIndex;
+		m_jobSystem->m_started++;
+	}
+
+	void CJobWorker::updateThread()
+	{
+		if (m_jobSystem->m_shutdown)
+			return;
+
+		if (!m_jobSystem->executeJob(m_queueIndex))
+			m_jobSystem->sleepWorker();
+	}
+
+	CJobSystem::CJobSystem(int numWorkers) :
+		m_pending(0),
+		m_started(0),
+		m_shutdown(false)
+	{
+		if (numWorkers < 0)
+			numWorkers = getHardwareThreadCount() - 1;
+
+		m_mainThread = std::this_thread::get_id();
+
+		// main thread queue, worker queues & external queue
+		// the queues must be created before any worker runs, the workers steal on all queues
+		for (int i = 0; i <= numWorkers + 1; i++)
+			m_queues.push_back(new CJobQueue());
+
+		m_externalQueue = numWorkers + 1;
+
+		for (int i = 0; i < numWorkers; i++)
+		{
+			CJobWorker* worker = new CJobWorker(this, i + 1);
+			IThread* thread = IThread::createThread(worker);
+			if (thread == NULL)
+			{
+				// this platform have no thread support, the jobs run on caller thread
+				delete worker;
+				break;
+			}
+
+			m_workers.push_back(worker);
+			m_threads.push_back(thread);
+		}
+
+		// wait all workers run
+		// the thread can not stop before it is running
+		while (m_started.load() < (int)m_threads.size())
+			std::this_thread::yield();
+	}
+
+	CJobSystem::~CJobSystem()
+	{
+		// finish the remain jobs
+		while (executeJob(0))
+		{
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_shutdown = true;
+		}
+		m_sleepCondition.notify_all();
+
+		for (IThread* thread : m_threads)
+		{
+			thread->stop();
+			delete thread;
+		}
+
+		for (CJobWorker* worker : m_workers)
+			delete worker;
+
+		for (CJobQueue* queue : m_queues)
+			delete queue;
+
+		m_threads.clear();
+		m_workers.clear();
+		m_queues.clear();
+	}
+
+	CJobSystem* CJobSystem::createInstance(int numWorkers)
+	{
+		if (s_instance == NULL)
+			s_instance = new CJobSystem(numWorkers);
+		return s_instance;
+	}
+
+	CJobSystem* CJobSystem::getInstance()
+	{
+		if (s_instance == NULL)
+			s_instance = new CJobSystem();
+		return s_instance;
+	}
+
+	void CJobSystem::releaseInstance()
+	{
+		if (s_instance != NULL)
+		{
+			delete s_instance;
+			s_instance = NULL;
+		}
+	}
+
+	int CJobSystem::getHardwareThreadCount()
+	{
+		int n = (int)std::thread::hardware_concurrency();
+		return n > 0 ? n : 1;
+	}
+
+	void CJobSystem::run(CJobGroup* group, const std::function<void()>& job)
+	{
+		if (m_threads.size() == 0)
+		{
+			// no worker
+			job();
+			return;
+		}
+
+		SJob j;
+		j.Function = job;
+		j.Group = group;
+
+		if (group != NULL)
+			group->m_count++;
+
+		m_queues[getQueueIndex()]->push(j);
+
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_pending++;
+		}
+		m_sleepCondition.notify_one();
+	}
+
+	void CJobSystem::wait(CJobGroup* group)
+	{
+		while (!group->isDone())
+		{
+			// help the workers
+			if (!executeJob(getQueueIndex()))
+				std::this_thread::yield();
+		}
+	}
+
+	void CJobSystem::parallelFor(int count, int batchSize, const std::function<void(int, int)>& func)
+	{
+		if (count <= 0)
+			return;
+
+		int numThread = getWorkerCount() + 1;
+		if (batchSize <= 0)
+		{
+			// split 4 batches per thread for load balancing
+			batchSize = count / (numThread * 4);
+			if (batchSize < 1)
+				batchSize = 1;
+		}
+
+		if (numThread == 1 || count <= batchSize)
+		{
+			func(0, count);
+			return;
+		}
+
+		CJobGroup group;
+		for (int begin = 0; begin < count; begin += batchSize)
+		{
+			int end = begin + batchSize;
+			if (end > count)
+				end = count;
+
+			run(&group, [&func, begin, end]()
+				{
+					func(begin, end);
+				});
+		}
+
+		wait(&group);
+	}
+
+	bool CJobSystem::executeJob()
+	{
+		return executeJob(getQueueIndex());
+	}
+
+	int CJobSystem::getQueueIndex()
+	{
+		if (t_queueIndex > 0)
+			return t_queueIndex;
+
+		// the other threads (ex: the streaming loader) share the external queue
+		// so they do not pop the jobs of the main thread
+		return std::this_thread::get_id() == m_mainThread ? 0 : m_externalQueue;
+	}
+
+	bool CJobSystem::executeJob(int queueIndex)
+	{
+		SJob job;
+
+		bool found = m_queues[queueIndex]->pop(job);
+		if (!found)
+		{
+			// steal from the other queues
+			int numQueue = (int)m_queues.size();
+			for (int i = 1; i < numQueue && !found; i++)
+				found = m_queues[(queueIndex + i) % numQueue]->steal(job);
+		}
+
+		if (!found)
+			return false;
+
+		m_pending--;
+
+		job.Function();
+
+		if (job.Group != NULL)
+			job.Group->m_count--;
+
+		return true;
+	}
+
+	void CJobSystem::sleepWorker()
+	{
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleepCondition.wait_for(lock, std::chrono::milliseconds(10), [this]()
+			{
+				return m_pending.load() > 0 || m_shutdown.load();
+			});
+	}
+}
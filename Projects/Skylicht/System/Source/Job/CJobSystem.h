@@ -0,0 +1,165 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2024 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include "Thread/IThread.h"
+#include "Thread/IMutex.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace SkylichtSystem
+{
+	class CJobSystem;
+
+	// The counter of a list jobs, see CJobSystem::wait
+	class CJobGroup
+	{
+		friend class CJobSystem;
+
+	protected:
+		std::atomic<int> m_count;
+
+	public:
+		CJobGroup() :
+			m_count(0)
+		{
+		}
+
+		inline bool isDone()
+		{
+			return m_count.load() == 0;
+		}
+	};
+
+	struct SJob
+	{
+		std::function<void()> Function;
+		CJobGroup* Group;
+	};
+
+	// The job queue of a worker
+	// The owner pushes and pops at the back, the other workers steal at the front
+	class CJobQueue
+	{
+	protected:
+		std::deque<SJob> m_jobs;
+		IMutex* m_mutex;
+
+	public:
+		CJobQueue();
+
+		virtual ~CJobQueue();
+
+		void push(const SJob& job);
+
+		bool pop(SJob& job);
+
+		bool steal(SJob& job);
+	};
+
+	class CJobWorker : public IThreadCallback
+	{
+	protected:
+		CJobSystem* m_jobSystem;
+		int m_queueIndex;
+
+	public:
+		CJobWorker(CJobSystem* jobSystem, int queueIndex);
+
+		virtual ~CJobWorker();
+
+		virtual void runThread();
+
+		virtual void updateThread();
+	};
+
+	// Work stealing job scheduler
+	// The queue 0 is used by the thread that creates the job system, the last queue is shared by the other threads that are not worker
+	// The waiting thread will run the jobs on queue, so a job can wait the other jobs
+	class CJobSystem
+	{
+		friend class CJobWorker;
+
+	protected:
+		static CJobSystem* s_instance;
+
+		std::vector<CJobQueue*> m_queues;
+		std::vector<CJobWorker*> m_workers;
+		std::vector<IThread*> m_threads;
+
+		std::thread::id m_mainThread;
+		int m_externalQueue;
+
+		std::atomic<int> m_pending;
+		std::atomic<int> m_started;
+		std::atomic<bool> m_shutdown;
+
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+
+	public:
+		// numWorkers = -1: use the number of hardware thread - 1
+		CJobSystem(int numWorkers = -1);
+
+		virtual ~CJobSystem();
+
+		static CJobSystem* createInstance(int numWorkers = -1);
+
+		static CJobSystem* getInstance();
+
+		static void releaseInstance();
+
+		static int getHardwareThreadCount();
+
+		inline int getWorkerCount()
+		{
+			return (int)m_threads.size();
+		}
+
+		void run(CJobGroup* group, const std::function<void()>& job);
+
+		void wait(CJobGroup* group);
+
+		// call func(begin, end) on the range [0, count) that is split by batchSize
+		// batchSize = 0: auto split by the number of workers
+		void parallelFor(int count, int batchSize, const std::function<void(int, int)>& func);
+
+		bool executeJob();
+
+	protected:
+
+		bool executeJob(int queueIndex);
+
+		int getQueueIndex();
+
+		void sleepWorker();
+	};
+}
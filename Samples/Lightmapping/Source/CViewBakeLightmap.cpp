@@ -7,12 +7,10 @@
 CViewBakeLightmap::CViewBakeLightmap() :
 	m_currentPass(0),
 	m_currentMB(0),
-	m_currentTris(0),
-	m_lastTris(99999),
+	m_rasterisedMB(false),
 	m_bakeCameraObject(NULL),
 	m_lightBounce(0),
 	m_numberRasterize(0),
-	m_currentRasterisation(NULL),
 #ifdef LIGHTMAP_SPONZA
 	m_lightmapSize(1024),
 #else
@@ -61,17 +59,6 @@ Lightmapper::CRasterisation* CViewBakeLightmap::createGetLightmapRasterisation(i
 	return m_lmRasterize[index];
 }
 
-int CViewBakeLightmap::getRasterisationIndex(Lightmapper::CRasterisation* raster)
-{
-	for (int i = 0; i < m_numberRasterize; i++)
-	{
-		if (m_lmRasterize[i] == raster)
-			return i;
-	}
-
-	return -1;
-}
-
 void CViewBakeLightmap::onInit()
 {
 	// gotoDemoView();
@@ -181,276 +168,178 @@ void CViewBakeLightmap::onUpdate()
 	if (CDirectionalLight::getCurrentDirectionLight() != NULL)
 		numLightBounce = CDirectionalLight::getCurrentDirectionLight()->getBounce();
 
-	for (int loopCount = 0; loopCount < 64; loopCount++)
+	if (m_currentMB < m_meshBuffers.size())
 	{
-		if (m_currentMB < m_meshBuffers.size())
-		{
-			IMeshBuffer* mb = m_meshBuffers[m_currentMB];
-			const core::matrix4& transform = m_meshTransforms[m_currentMB];
-
-			IIndexBuffer* idx = mb->getIndexBuffer();
-			u32 numTris = idx->getIndexCount() / 3;
+		IMeshBuffer* mb = m_meshBuffers[m_currentMB];
+		const core::matrix4& transform = m_meshTransforms[m_currentMB];
 
-			int secs = deltaTime / 1000;
-			int mins = secs / 60;
-			int hours = mins / 60;
+		int secs = deltaTime / 1000;
+		int mins = secs / 60;
+		int hours = mins / 60;
 
-			mins = mins - hours * 60;
+		mins = mins - hours * 60;
 
-			char status[512];
-			sprintf(status, "LIGHTMAPPING (%d/%d):\n\n- MeshBuffer: %d/%d\n- Bake step: %d/%d\n- Triangle: %d/%d\n- Time: %d seconds - (%02d:%02d) hm",
-				m_lightBounce + 1, numLightBounce,
-				m_currentMB + 1, (int)m_meshBuffers.size(),
-				m_currentPass + 1, 7,
-				m_currentTris, numTris,
-				secs,
-				hours, mins);
-			m_textInfo->setText(status);
+		CLightmapper* lightmapper = CLightmapper::getInstance();
 
-			CRasterisation::ERasterPass pass = (CRasterisation::ERasterPass)m_currentPass;
+		if (m_rasterisedMB == false)
+		{
+			// the lightmaps of this mesh buffer
+			IVertexBuffer* vtx = mb->getVertexBuffer();
+			S3DVertex2TCoordsTangents* vertices = (S3DVertex2TCoordsTangents*)vtx->getVertices();
 
-			if (m_lastTris != m_currentTris)
+			for (u32 i = 0, n = vtx->getVertexCount(); i < n; i++)
 			{
-				u32 v1 = 0;
-				u32 v2 = 0;
-				u32 v3 = 0;
-
-				if (idx->getIndexSize() == 2)
-				{
-					u16* indexbuffer = (u16*)idx->getIndices();
-					v1 = (u32)indexbuffer[m_currentTris * 3];
-					v2 = (u32)indexbuffer[m_currentTris * 3 + 1];
-					v3 = (u32)indexbuffer[m_currentTris * 3 + 2];
-				}
-				else if (idx->getIndexSize() == 4)
-				{
-					u32* indexbuffer = (u32*)idx->getIndices();
-					v1 = (u32)indexbuffer[m_currentTris * 3];
-					v2 = (u32)indexbuffer[m_currentTris * 3 + 1];
-					v3 = (u32)indexbuffer[m_currentTris * 3 + 2];
-				}
-
-				IVertexBuffer* vtx = mb->getVertexBuffer();
-
-				S3DVertex2TCoordsTangents* vertices = (S3DVertex2TCoordsTangents*)vtx->getVertices();
+				int lmIndex = (int)vertices[i].Lightmap.Z;
+				if (lmIndex >= 0 && lmIndex < MAX_LIGHTMAP_ATLAS)
+					createGetLightmapRasterisation(lmIndex);
+			}
 
-				core::vector3df positions[] = {
-					vertices[v1].Pos,
-					vertices[v2].Pos,
-					vertices[v3].Pos
-				};
+			// rasterise all triangles on the tiles, the pixels are queued to bake
+			lightmapper->rasteriseLightmapMeshBuffer(
+				mb,
+				transform,
+				m_lmRasterize,
+				m_numberRasterize,
+				(CRasterisation::ERasterPass)m_currentPass);
 
-				core::vector2df uvs[] = {
-					core::vector2df(vertices[v1].Lightmap.X, vertices[v1].Lightmap.Y),
-					core::vector2df(vertices[v2].Lightmap.X, vertices[v2].Lightmap.Y),
-					core::vector2df(vertices[v3].Lightmap.X, vertices[v3].Lightmap.Y),
-				};
+			m_rasterisedMB = true;
+		}
 
-				core::vector3df normals[] = {
-					vertices[v1].Normal,
-					vertices[v2].Normal,
-					vertices[v3].Normal
-				};
+		CContext* context = CContext::getInstance();
+		CScene* scene = context->getScene();
 
-				core::vector3df tangents[] = {
-					vertices[v1].Tangent,
-					vertices[v2].Tangent,
-					vertices[v3].Tangent
-				};
+		// bake lighting color of the queued pixels in this frame
+		int budget = BAKE_PIXEL_PER_FRAME;
+		u32 numQueue = 0;
 
-				for (int i = 0; i < 3; i++)
-				{
-					transform.transformVect(positions[i]);
-					transform.rotateVect(normals[i]);
-					transform.rotateVect(tangents[i]);
+		for (int i = 0; i < m_numberRasterize; i++)
+		{
+			if (m_lmRasterize[i] == NULL)
+				continue;
 
-					normals[i].normalize();
-					tangents[i].normalize();
-				}
+			budget -= lightmapper->bakeLightmapPixels(
+				m_lmRasterize[i],
+				budget,
+				m_bakeCameraObject->getComponent<CCamera>(),
+				context->getRenderPipeline(),
+				scene->getEntityManager());
 
-				int lmIndex = (int)vertices[v1].Lightmap.Z;
-				if (lmIndex >= 0)
-				{
-					m_currentRasterisation = createGetLightmapRasterisation(lmIndex);
-					m_pixel = m_currentRasterisation->setTriangle(positions, uvs, normals, tangents, pass);
-					m_lastTris = m_currentTris;
-				}
-				else
-				{
-					// skip this triangle
-					m_currentTris++;
-					continue;
-				}
-			}
+			numQueue += m_lmRasterize[i]->getBakePixelQueue().size();
+		}
 
-			core::vector3df outPos;
-			core::vector3df outNormal;
-			core::vector3df outTangent;
-			core::vector3df outBinormal;
+		char status[512];
+		sprintf(status, "LIGHTMAPPING (%d/%d):\n\n- MeshBuffer: %d/%d\n- Bake step: %d/%d\n- Pixel queue: %d\n- Time: %d seconds - (%02d:%02d) hm",
+			m_lightBounce + 1, numLightBounce,
+			m_currentMB + 1, (int)m_meshBuffers.size(),
+			m_currentPass + 1, 7,
+			numQueue,
+			secs,
+			hours, mins);
+		m_textInfo->setText(status);
+
+		// go next buffer
+		if (numQueue == 0)
+		{
+			m_currentMB++;
+			m_rasterisedMB = false;
+		}
+	}
+	else
+	{
+		// next pass
+		m_currentPass++;
 
-			bool forceBake = false;
+		m_currentMB = 0;
 
-			// sampling pixel
-			m_currentRasterisation->samplingTrianglePosition(outPos, outNormal, outTangent, outBinormal, m_pixel);
+		if (m_currentPass >= (int)CRasterisation::PassCount)
+		{
+			m_lightBounce++;
 
-			// next pixel
-			m_currentRasterisation->moveNextPixel(m_pixel);
+			IVideoDriver* driver = getVideoDriver();
+			core::array<IImage*> lightmapImages;
 
-			// finish
-			if (m_currentRasterisation->isFinished(m_pixel))
-				m_currentTris++;
+			core::dimension2du size(m_lightmapSize, m_lightmapSize);
 
-			// go next buffer
-			if (m_currentTris >= numTris)
+			for (int i = 0; i < m_numberRasterize; i++)
 			{
-				m_currentMB++;
+				// todo fix seam
+				m_lmRasterize[i]->imageDilate();
 
-				m_currentTris = 0;
-				m_lastTris = 9999;
+				// lighting data
+				unsigned char* data = m_lmRasterize[i]->getLightmapData();
 
-				forceBake = true;
+				// create lightmap image					
+				IImage* img = driver->createImageFromData(video::ECF_R8G8B8, size, data);
+				lightmapImages.push_back(img);
 			}
 
-			// bake indirect pixels
-			core::array<SBakePixel>& listPixels = m_currentRasterisation->getBakePixelQueue();
-			if (listPixels.size() == CLightmapper::getNumThread() || forceBake == true)
+			// init lightmap texture array
+			ITexture* lightmapTexture = driver->getTextureArray(lightmapImages.pointer(), lightmapImages.size());
+			if (lightmapTexture != NULL)
 			{
-				int n = (int)listPixels.size();
-				m_out.clear();
-
-				for (int i = 0; i < n; i++)
+				// bind lightmap texture as indirect lighting
+				for (CRenderMesh* renderMesh : m_renderMesh)
 				{
-					m_bakePositions[i] = listPixels[i].Position;
-					m_bakeNormals[i] = listPixels[i].Normal;
-					m_bakeTangents[i] = listPixels[i].Tangent;
-					m_bakeBinormals[i] = listPixels[i].Binormal;
-				}
+					if (renderMesh->getGameObject()->isStatic() == true)
+					{
+						CIndirectLighting* indirect = renderMesh->getGameObject()->getComponent<CIndirectLighting>();
+						if (indirect == NULL)
+							indirect = renderMesh->getGameObject()->addComponent<CIndirectLighting>();
 
-				CContext* context = CContext::getInstance();
-				CScene* scene = context->getScene();
-
-				// bake lighting color
-				CLightmapper::getInstance()->bakeAtPosition(
-					m_bakeCameraObject->getComponent<CCamera>(),
-					context->getRenderPipeline(),
-					scene->getEntityManager(),
-					m_bakePositions,
-					m_bakeNormals,
-					m_bakeTangents,
-					m_bakeBinormals,
-					m_out,
-					n,
-					5
-				);
-
-				// write result to image
-				m_currentRasterisation->flushPixel(m_out);
+						indirect->setIndirectLightmap(lightmapTexture);
+						indirect->setIndirectLightingType(CIndirectLighting::LightmapArray);
+					}
+				}
 			}
-		}
-		else
-		{
-			// next pass
-			m_currentPass++;
-
-			m_currentMB = 0;
-			m_currentTris = 0;
-			m_lastTris = 9999;
 
-			if (m_currentPass >= (int)CRasterisation::PassCount)
+			// write output to png
+			bool testWriteFile = true;
+			if (testWriteFile)
 			{
-				m_lightBounce++;
-
-				IVideoDriver* driver = getVideoDriver();
-				core::array<IImage*> lightmapImages;
-
-				core::dimension2du size(m_lightmapSize, m_lightmapSize);
-
 				for (int i = 0; i < m_numberRasterize; i++)
 				{
-					// todo fix seam
-					m_lmRasterize[i]->imageDilate();
-
-					// lighting data
-					unsigned char* data = m_lmRasterize[i]->getLightmapData();
-
-					// create lightmap image					
-					IImage* img = driver->createImageFromData(video::ECF_R8G8B8, size, data);
-					lightmapImages.push_back(img);
-				}
-
-				// init lightmap texture array
-				ITexture* lightmapTexture = driver->getTextureArray(lightmapImages.pointer(), lightmapImages.size());
-				if (lightmapTexture != NULL)
-				{
-					// bind lightmap texture as indirect lighting
-					for (CRenderMesh* renderMesh : m_renderMesh)
-					{
-						if (renderMesh->getGameObject()->isStatic() == true)
-						{
-							CIndirectLighting* indirect = renderMesh->getGameObject()->getComponent<CIndirectLighting>();
-							if (indirect == NULL)
-								indirect = renderMesh->getGameObject()->addComponent<CIndirectLighting>();
-
-							indirect->setIndirectLightmap(lightmapTexture);
-							indirect->setIndirectLightingType(CIndirectLighting::LightmapArray);
-						}
-					}
+					char outFileName[512];
+					sprintf(outFileName, "LightMapRasterize_bounce_%d_%d.png", m_lightBounce, i);
+					driver->writeImageToFile(lightmapImages[i], outFileName);
 				}
+			}
 
-				// write output to png
-				bool testWriteFile = true;
-				if (testWriteFile)
-				{
-					for (int i = 0; i < m_numberRasterize; i++)
-					{
-						char outFileName[512];
-						sprintf(outFileName, "LightMapRasterize_bounce_%d_%d.png", m_lightBounce, i);
-						driver->writeImageToFile(lightmapImages[i], outFileName);
-					}
-				}
+			for (int i = 0; i < m_numberRasterize; i++)
+			{
+				lightmapImages[i]->drop();
+				lightmapImages[i] = NULL;
+			}
 
+			// write debug bake to png
+			if (testWriteFile)
+			{
 				for (int i = 0; i < m_numberRasterize; i++)
 				{
-					lightmapImages[i]->drop();
-					lightmapImages[i] = NULL;
-				}
+					// debug data
+					unsigned char* data = m_lmRasterize[i]->getTestBakeImage();
+					IImage* img = driver->createImageFromData(video::ECF_R8G8B8, size, data);
 
-				// write debug bake to png
-				if (testWriteFile)
-				{
-					for (int i = 0; i < m_numberRasterize; i++)
-					{
-						// debug data
-						unsigned char* data = m_lmRasterize[i]->getTestBakeImage();
-						IImage* img = driver->createImageFromData(video::ECF_R8G8B8, size, data);
-
-						char outFileName[512];
-						sprintf(outFileName, "LightMapRasterize_debug_bounce_%d_%d.png", m_lightBounce, i);
-						driver->writeImageToFile(img, outFileName);
-						img->drop();
-					}
+					char outFileName[512];
+					sprintf(outFileName, "LightMapRasterize_debug_bounce_%d_%d.png", m_lightBounce, i);
+					driver->writeImageToFile(img, outFileName);
+					img->drop();
 				}
+			}
 
-				// clear reset data for next bounce bake
-				for (int i = 0; i < m_numberRasterize; i++)
-					m_lmRasterize[i]->resetBake();
+			// clear reset data for next bounce bake
+			for (int i = 0; i < m_numberRasterize; i++)
+				m_lmRasterize[i]->resetBake();
 
-				if (m_lightBounce >= numLightBounce)
-				{
-					gotoDemoView();
-				}
-				else
-				{
-					// reset next light bounce
-					m_currentPass = 0;
-					m_currentMB = 0;
-					m_currentTris = 0;
-					m_lastTris = 9999;
-					m_currentRasterisation = NULL;
-				}
+			if (m_lightBounce >= numLightBounce)
+			{
+				gotoDemoView();
+			}
+			else
+			{
+				// reset next light bounce
+				m_currentPass = 0;
+				m_currentMB = 0;
 			}
-
-			return;
 		}
 	}
 }
@@ -480,6 +369,9 @@ void CViewBakeLightmap::saveProgress()
 	// init 10mb (auto grow later)
 	CMemoryStream* stream = new CMemoryStream(10 * 1024 * 1024);
 
+	stream->writeUInt(LIGHTMAP_PROGRESS_MAGIC);
+	stream->writeUInt(LIGHTMAP_PROGRESS_VERSION);
+
 	stream->writeUInt((u32)getVideoDriver()->getDriverType());
 
 	stream->writeUInt(m_numRenderers);
@@ -491,19 +383,17 @@ void CViewBakeLightmap::saveProgress()
 	stream->writeInt(m_lightBounce);
 	stream->writeInt(m_currentPass);
 	stream->writeInt(m_currentMB);
-	stream->writeInt(m_currentTris);
-	stream->writeInt(m_lastTris);
+	stream->writeInt(m_rasterisedMB ? 1 : 0);
 	stream->writeUInt(deltaTime);
 
 	stream->writeInt(m_numberRasterize);
 	for (int i = 0; i < m_numberRasterize; i++)
 		m_lmRasterize[i]->save(stream);
 
-	stream->writeInt(getRasterisationIndex(m_currentRasterisation));
-
 	io::IWriteFile* file = getIrrlichtDevice()->getFileSystem()->createAndWriteFile("LightmapProgress.dat");
 	file->write(stream->getData(), stream->getSize());
 	file->drop();
+	delete stream;
 
 	if (m_currentPass != (int)CRasterisation::PassCount)
 	{
@@ -535,6 +425,19 @@ void CViewBakeLightmap::loadProgress()
 
 		CMemoryStream* stream = new CMemoryStream(data, fileSize);
 
+		file->drop();
+
+		// the old layout does not have the header
+		if (fileSize < 8 ||
+			stream->readUInt() != LIGHTMAP_PROGRESS_MAGIC ||
+			stream->readUInt() != LIGHTMAP_PROGRESS_VERSION)
+		{
+			os::Printer::log("[CViewBakeLightmap] Skip LightmapProgress.dat, the version is not supported");
+			delete stream;
+			delete[] data;
+			return;
+		}
+
 		u32 driverType = (u32)getVideoDriver()->getDriverType();
 
 		u32 readDriverType = stream->readUInt();
@@ -544,7 +447,7 @@ void CViewBakeLightmap::loadProgress()
 		u32 lmSize = stream->readUInt();
 		u32 numMeshBuffer = stream->readUInt();
 
-		if (driverType != driverType ||
+		if (readDriverType != driverType ||
 			numRenderers != m_numRenderers ||
 			numIndices != m_numIndices ||
 			numVertices != m_numVertices ||
@@ -552,15 +455,15 @@ void CViewBakeLightmap::loadProgress()
 			lmSize != m_lightmapSize)
 		{
 			// broken progress
-			file->drop();
+			delete stream;
+			delete[] data;
 			return;
 		}
 
 		m_lightBounce = stream->readInt();
 		m_currentPass = stream->readInt();
 		m_currentMB = stream->readInt();
-		m_currentTris = stream->readInt();
-		m_lastTris = stream->readInt();
+		m_rasterisedMB = stream->readInt() != 0;
 		m_timeSpentFromLastSave = stream->readUInt();
 
 		int m_numberRasterize = stream->readInt();
@@ -570,15 +473,8 @@ void CViewBakeLightmap::loadProgress()
 			raster->load(stream);
 		}
 
-		int rasterIndex = stream->readInt();
-		if (rasterIndex == -1)
-			m_currentRasterisation = NULL;
-		m_currentRasterisation = m_lmRasterize[rasterIndex];
-
 		delete stream;
-		delete data;
-
-		file->drop();
+		delete[] data;
 
 		// need load current lightmap
 		if (m_lightBounce >= 1)
@@ -9,6 +9,13 @@
 
 #define MAX_LIGHTMAP_ATLAS 10
 
+// the pixels are baked in many frames, so the UI is not frozen
+#define BAKE_PIXEL_PER_FRAME 64
+
+// LightmapProgress.dat header, increase the version when the layout is changed
+#define LIGHTMAP_PROGRESS_MAGIC 0x474D4C53
+#define LIGHTMAP_PROGRESS_VERSION 2
+
 // #define LIGHTMAP_SPONZA
 
 class CViewBakeLightmap : public CView
@@ -38,25 +45,13 @@ protected:
 	u32 m_currentPass;
 	u32 m_currentMB;
 
-	u32 m_currentTris;
-	u32 m_lastTris;
+	bool m_rasterisedMB;
 
 	u32 m_lightmapSize;
 
-	core::vector2di m_pixel;
-
 	Lightmapper::CRasterisation *m_lmRasterize[MAX_LIGHTMAP_ATLAS];
 	int m_numberRasterize;
 
-	Lightmapper::CRasterisation *m_currentRasterisation;
-
-	std::vector<Lightmapper::CSH9> m_out;
-
-	core::vector3df m_bakePositions[MAX_NUM_THREAD];
-	core::vector3df m_bakeNormals[MAX_NUM_THREAD];
-	core::vector3df m_bakeTangents[MAX_NUM_THREAD];
-	core::vector3df m_bakeBinormals[MAX_NUM_THREAD];
-
 public:
 
 	CViewBakeLightmap();
@@ -76,7 +71,6 @@ public:
 protected:
 
 	Lightmapper::CRasterisation* createGetLightmapRasterisation(int index);
-	int getRasterisationIndex(Lightmapper::CRasterisation *raster);
 
 public:
 	void saveProgress();
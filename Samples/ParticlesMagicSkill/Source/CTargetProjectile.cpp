@@ -24,7 +24,7 @@ void CTargetProjectile::setTargetCollide(u32 index, const core::vector3df& pos,
 	}
 }
 
-void CTargetProjectile::OnParticleUpdate(Particle::CParticle *particles, int num, Particle::CGroup *group, float dt)
+void CTargetProjectile::OnParticleUpdate(Particle::CParticleArray *particles, int num, Particle::CGroup *group, float dt)
 {
 	if (m_impactGroup == NULL)
 		return;
@@ -39,14 +39,13 @@ void CTargetProjectile::OnParticleUpdate(Particle::CParticle *particles, int num
 		if (c.HaveData == false)
 			continue;
 
-		Particle::CParticle &p = particles[i];
-		if (p.Position.getDistanceFromSQ(c.Position) < minLengthSQ)
+		if (particles->getPosition(i).getDistanceFromSQ(c.Position) < minLengthSQ)
 		{
 			// add impact particle
 			m_impactGroup->addParticle(0, c.Position, c.Normal);
 
 			// kill this particle
-			p.Life = -1.0f;
+			particles->setLife(i, -1.0f);
 		}
 	}
 }
@@ -64,10 +63,10 @@ void CTargetProjectile::OnParticleDead(Particle::CParticle &p)
 	m_particleCollide.set_used(m_particleCollide.size() - 1);
 }
 
-void CTargetProjectile::OnSwapParticleData(Particle::CParticle &p1, Particle::CParticle &p2)
+void CTargetProjectile::OnSwapParticleData(u32 index1, u32 index2)
 {
-	SCollide t = m_particleCollide[p1.Index];
+	SCollide t = m_particleCollide[index1];
 
-	m_particleCollide[p1.Index] = m_particleCollide[p2.Index];
-	m_particleCollide[p2.Index] = t;
+	m_particleCollide[index1] = m_particleCollide[index2];
+	m_particleCollide[index2] = t;
 }
\ No newline at end of file
@@ -31,11 +31,11 @@ public:
 		m_impactGroup = g;
 	}
 
-	virtual void OnParticleUpdate(Particle::CParticle *particles, int num, Particle::CGroup *group, float dt);
+	virtual void OnParticleUpdate(Particle::CParticleArray *particles, int num, Particle::CGroup *group, float dt);
 
 	virtual void OnParticleBorn(Particle::CParticle &p);
 
 	virtual void OnParticleDead(Particle::CParticle &p);
 
-	virtual void OnSwapParticleData(Particle::CParticle &p1, Particle::CParticle &p2);
+	virtual void OnSwapParticleData(u32 index1, u32 index2);
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+#include "BenchmarkEntity.h"
+#include "BenchmarkCulling.h"
+#include "BenchmarkParticle.h"
+#include "BenchmarkRenderQueue.h"
+#include "BenchmarkScene.h"
+#include "BenchmarkAsset.h"
+#include "BenchmarkAudio.h"
+#include "BenchmarkCollision.h"
+#include "BenchmarkLightmapper.h"
+
+using namespace irr;
+
+struct SBenchmark
+{
+	const char* Name;
+	void (*Run)();
+};
+
+SBenchmark g_benchmarks[] = {
+	{ "entity", benchmarkEntity },
+	{ "culling", benchmarkCulling },
+	{ "particle", benchmarkParticle },
+	{ "renderqueue", benchmarkRenderQueue },
+	{ "scene", benchmarkScene },
+	{ "asset", benchmarkAsset },
+	{ "audio", benchmarkAudio },
+	{ "collision", benchmarkCollision },
+	{ "lightmapper", benchmarkLightmapper },
+};
+
+int main(int argc, char** argv)
+{
+	// create irrlicht device console and null driver
+	SIrrlichtCreationParameters p;
+	p.DeviceType = EIDT_CONSOLE;
+	p.DriverType = video::EDT_NULL;
+
+	IrrlichtDevice* device = createDeviceEx(p);
+	if (!device)
+		return 1;
+
+	Skylicht::initSkylicht(device, true);
+
+	// $ Benchmark [name] to run a single benchmark
+	const char* filter = argc > 1 ? argv[1] : NULL;
+
+	int numBenchmark = sizeof(g_benchmarks) / sizeof(SBenchmark);
+	for (int i = 0; i < numBenchmark; i++)
+	{
+		if (filter != NULL && strcmp(filter, g_benchmarks[i].Name) != 0)
+			continue;
+
+		printf("[Benchmark] %s\n", g_benchmarks[i].Name);
+		g_benchmarks[i].Run();
+	}
+
+	Skylicht::releaseSkylicht();
+
+	device->drop();
+	return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <stdio.h>
+
+#define BENCHMARK_CASE( name ) std::cout << (std::string(" - ") + std::string(name)) << std::endl;
+
+class CBenchmarkTimer
+{
+protected:
+	std::chrono::high_resolution_clock::time_point m_begin;
+
+public:
+	CBenchmarkTimer()
+	{
+		begin();
+	}
+
+	void begin()
+	{
+		m_begin = std::chrono::high_resolution_clock::now();
+	}
+
+	// return milliseconds
+	double end()
+	{
+		std::chrono::duration<double, std::milli> d = std::chrono::high_resolution_clock::now() - m_begin;
+		return d.count();
+	}
+};
+
+inline void printBenchmarkResult(const char* name, double ms)
+{
+	printf("   %-48s %10.3f ms\n", name, ms);
+}
+
+#endif
@@ -0,0 +1,219 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkAsset.h"
+
+#include "Entity/CEntityPrefab.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "Animation/CAnimationClip.h"
+#include "Exporter/ExportResources.h"
+#include "Exporter/Skylicht/CSkylichtMeshExporter.h"
+#include "Exporter/Skylicht/CSkylichtAnimExporter.h"
+#include "Importer/Skylicht/CSkylichtMeshLoader.h"
+#include "Importer/Skylicht/CSkylichtAnimLoader.h"
+#include "Utils/CMemoryStream.h"
+
+using namespace Skylicht;
+
+// the loader before the mapped file: read the whole file to a heap buffer, then parse
+class CBufferMeshLoader : public CSkylichtMeshLoader
+{
+public:
+	bool loadBuffer(const char* resource, CEntityPrefab* output)
+	{
+		io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(resource);
+		if (readFile == NULL)
+			return false;
+
+		u32 size = readFile->getSize();
+		unsigned char* data = new unsigned char[size];
+		readFile->read(data, size);
+		readFile->drop();
+
+		CMemoryStream stream(data, size);
+
+		SAssetHeader assetHeader;
+		stream.readData(&assetHeader, sizeof(SAssetHeader));
+		loadVersion(&stream, output, assetHeader.AssetVersion, false, false, false);
+
+		delete[] data;
+		return true;
+	}
+};
+
+class CBufferAnimLoader : public CSkylichtAnimLoader
+{
+public:
+	bool loadBuffer(const char* resource, CAnimationClip* output)
+	{
+		io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(resource);
+		if (readFile == NULL)
+			return false;
+
+		u32 size = readFile->getSize();
+		unsigned char* data = new unsigned char[size];
+		readFile->read(data, size);
+		readFile->drop();
+
+		CMemoryStream stream(data, size);
+
+		SAssetHeader assetHeader;
+		stream.readData(&assetHeader, sizeof(SAssetHeader));
+		loadVersion(&stream, output, assetHeader.AssetVersion);
+
+		delete[] data;
+		return true;
+	}
+};
+
+CMesh* createGridMesh(int gridSize)
+{
+	CMeshBuffer<S3DVertex>* mb = new CMeshBuffer<S3DVertex>(getVideoDriver()->getVertexDescriptor(EVT_STANDARD), video::EIT_32BIT);
+
+	IVertexBuffer* vtxBuffer = mb->getVertexBuffer();
+	IIndexBuffer* idxBuffer = mb->getIndexBuffer();
+
+	for (int z = 0; z <= gridSize; z++)
+	{
+		for (int x = 0; x <= gridSize; x++)
+		{
+			S3DVertex v((f32)x, 0.0f, (f32)z, 0.0f, 1.0f, 0.0f, SColor(255, 255, 255, 255), x / (f32)gridSize, z / (f32)gridSize);
+			vtxBuffer->addVertex(&v);
+		}
+	}
+
+	for (int z = 0; z < gridSize; z++)
+	{
+		for (int x = 0; x < gridSize; x++)
+		{
+			u32 i = z * (gridSize + 1) + x;
+			idxBuffer->addIndex(i);
+			idxBuffer->addIndex(i + gridSize + 1);
+			idxBuffer->addIndex(i + 1);
+			idxBuffer->addIndex(i + 1);
+			idxBuffer->addIndex(i + gridSize + 1);
+			idxBuffer->addIndex(i + gridSize + 2);
+		}
+	}
+
+	mb->recalculateBoundingBox();
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(mb);
+	mb->drop();
+
+	return mesh;
+}
+
+void benchmarkMeshAsset(int numFile, int gridSize)
+{
+	char name[512];
+	sprintf(name, "%d meshes, %d vertices", numFile, (gridSize + 1) * (gridSize + 1));
+	BENCHMARK_CASE(name);
+
+	CMesh* mesh = createGridMesh(gridSize);
+
+	CEntityPrefab* prefab = new CEntityPrefab();
+	CEntity* entity = prefab->createEntity();
+	entity->addData<CWorldTransformData>();
+	entity->addData<CRenderMeshData>()->setMesh(mesh);
+	mesh->drop();
+
+	std::vector<std::string> files;
+	CSkylichtMeshExporter exporter;
+	for (int i = 0; i < numFile; i++)
+	{
+		sprintf(name, "BenchmarkAsset_%d.smesh", i);
+		files.push_back(name);
+		exporter.exportModel(prefab->getEntities(), prefab->getNumEntities(), name);
+	}
+	delete prefab;
+
+	CBufferMeshLoader loader;
+
+	CBenchmarkTimer timer;
+	for (int i = 0; i < numFile; i++)
+	{
+		CEntityPrefab* output = new CEntityPrefab();
+		loader.loadBuffer(files[i].c_str(), output);
+		delete output;
+	}
+	printBenchmarkResult("load read buffer", timer.end());
+
+	timer.begin();
+	for (int i = 0; i < numFile; i++)
+	{
+		CEntityPrefab* output = new CEntityPrefab();
+		loader.loadModel(files[i].c_str(), output, false, false, false, false);
+		delete output;
+	}
+	printBenchmarkResult("load mapped file", timer.end());
+
+	for (int i = 0; i < numFile; i++)
+		remove(files[i].c_str());
+}
+
+void benchmarkAnimAsset(int numFile, int numBone, int numKey)
+{
+	char name[512];
+	sprintf(name, "%d anims, %d bones, %d keys", numFile, numBone, numKey);
+	BENCHMARK_CASE(name);
+
+	CAnimationClip* clip = new CAnimationClip();
+	clip->AnimName = "Benchmark";
+	clip->Duration = numKey / 30.0f;
+
+	for (int i = 0; i < numBone; i++)
+	{
+		SEntityAnim* anim = new SEntityAnim();
+		anim->Name = std::string("Bone") + std::to_string(i);
+
+		for (int j = 0; j < numKey; j++)
+		{
+			f32 t = j / 30.0f;
+			anim->Data.Positions.Data.push_back(CPositionKey{ t, core::vector3df(t, (f32)i, 0.0f) });
+			anim->Data.Rotations.Data.push_back(CRotationKey{ t, core::quaternion(core::vector3df(0.0f, t, 0.0f)) });
+			anim->Data.Scales.Data.push_back(CScaleKey{ t, core::vector3df(1.0f) });
+		}
+		clip->addAnim(anim);
+	}
+
+	std::vector<std::string> files;
+	CSkylichtAnimExporter exporter;
+	for (int i = 0; i < numFile; i++)
+	{
+		sprintf(name, "BenchmarkAsset_%d.sanim", i);
+		files.push_back(name);
+		exporter.exportAnim(clip, name);
+	}
+	delete clip;
+
+	CBufferAnimLoader loader;
+
+	CBenchmarkTimer timer;
+	for (int i = 0; i < numFile; i++)
+	{
+		CAnimationClip* output = new CAnimationClip();
+		loader.loadBuffer(files[i].c_str(), output);
+		delete output;
+	}
+	printBenchmarkResult("load read buffer", timer.end());
+
+	timer.begin();
+	for (int i = 0; i < numFile; i++)
+	{
+		CAnimationClip* output = new CAnimationClip();
+		loader.loadAnimation(files[i].c_str(), output);
+		delete output;
+	}
+	printBenchmarkResult("load mapped file", timer.end());
+
+	for (int i = 0; i < numFile; i++)
+		remove(files[i].c_str());
+}
+
+void benchmarkAsset()
+{
+	benchmarkMeshAsset(1000, 16);
+	benchmarkMeshAsset(20, 512);
+	benchmarkAnimAsset(100, 60, 300);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void benchmarkAsset();
\ No newline at end of file
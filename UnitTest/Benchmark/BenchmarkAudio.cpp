@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkAudio.h"
+
+#include "Driver/CDriverNull.h"
+
+using namespace SkylichtAudio;
+
+// the mixer before the float mix bus: scalar lerp to an int buffer, then clamp each sample
+void mixFixedVoice(int* buffer, const short* sourceBuffer, int numChannels, int nbSample, float pitch, float leftGain, float rightGain)
+{
+	float currentSample = 0;
+	int sample = 0;
+	int sampleValue = 0;
+	float fract = 0.0f;
+
+	if (numChannels == 2)
+	{
+		for (int i = 0; i < nbSample; ++i)
+		{
+			sample = (int)currentSample;
+			fract = currentSample - sample;
+
+			sampleValue = (int)(sourceBuffer[sample * 2] * (1.0f - fract) + sourceBuffer[sample * 2 + 2] * fract);
+			*buffer += (int)(sampleValue * leftGain);
+			++buffer;
+
+			sampleValue = (int)(sourceBuffer[sample * 2 + 1] * (1.0f - fract) + sourceBuffer[sample * 2 + 3] * fract);
+			*buffer += (int)(sampleValue * rightGain);
+			++buffer;
+
+			currentSample = i * pitch;
+		}
+	}
+	else
+	{
+		for (int i = 0; i < nbSample; i++)
+		{
+			sample = (int)currentSample;
+			fract = currentSample - sample;
+
+			sampleValue = (int)(sourceBuffer[sample] * (1.0f - fract) + sourceBuffer[sample + 1] * fract);
+
+			*buffer += (int)(sampleValue * leftGain);
+			++buffer;
+
+			*buffer += (int)(sampleValue * rightGain);
+			++buffer;
+
+			currentSample = i * pitch;
+		}
+	}
+}
+
+void clampFixed(const int* mixBuffer, short* outBuffer, int totalSamples)
+{
+	for (int i = 0; i < totalSamples; i++)
+	{
+		if ((unsigned int)(*mixBuffer + 32768) > 65535)
+			*outBuffer = (short)(*mixBuffer < 0 ? -32768 : 32767);
+		else
+			*outBuffer = (short)(*mixBuffer);
+
+		outBuffer++;
+		mixBuffer++;
+	}
+}
+
+void benchmarkAudioMixer(int numVoice, int numBuffer)
+{
+	char name[512];
+	sprintf(name, "%d voices, %d buffers", numVoice, numBuffer);
+	BENCHMARK_CASE(name);
+
+	CDriverNull driver;
+
+	SSourceParam sourceParam;
+	driver.getSourceParam(&sourceParam);
+
+	int numSample = driver.getBufferSize();
+
+	// half of the voices are 22khz mono, the others are 44khz stereo
+	std::vector<std::vector<short>> pcm(numVoice);
+	std::vector<STrackParams> tracks(numVoice);
+	std::vector<int> pcmSize(numVoice);
+	std::vector<CSoundSource*> sources(numVoice);
+
+	for (int i = 0; i < numVoice; i++)
+	{
+		STrackParams& track = tracks[i];
+		track.BitsPerSample = 16;
+		track.NumChannels = (i % 2) == 0 ? 1 : 2;
+		track.SamplingRate = track.NumChannels == 1 ? sourceParam.SamplingRate / 2 : sourceParam.SamplingRate;
+
+		int numFrames = (int)(driver.getBufferSize() * track.SamplingRate / (float)sourceParam.SamplingRate);
+
+		// +1 frame: the old lerp reads over the buffer
+		std::vector<short>& data = pcm[i];
+		data.resize((numFrames + 1) * track.NumChannels);
+		for (int j = 0, n = (int)data.size(); j < n; j++)
+			data[j] = (short)(sinf(j * 0.01f * (i + 1)) * 8000.0f);
+
+		pcmSize[i] = numFrames * track.NumChannels * sizeof(short);
+
+		CSoundSource* source = (CSoundSource*)driver.createSource();
+		source->init(track, sourceParam);
+		source->setGain(0.1f);
+		source->play();
+		sources[i] = source;
+	}
+
+	std::vector<int> fixedBuffer(numSample * 2);
+	std::vector<short> out(numSample * 2);
+
+	CBenchmarkTimer timer;
+	for (int b = 0; b < numBuffer; b++)
+	{
+		// the emitters upload a buffer each time
+		for (int i = 0; i < numVoice; i++)
+			sources[i]->uploadData(pcm[i].data(), pcmSize[i]);
+
+		memset(fixedBuffer.data(), 0, sizeof(int) * numSample * 2);
+
+		for (int i = 0; i < numVoice; i++)
+		{
+			float pitch = tracks[i].SamplingRate / (float)sourceParam.SamplingRate;
+			mixFixedVoice(fixedBuffer.data(), pcm[i].data(), tracks[i].NumChannels, numSample, pitch, 0.1f, 0.1f);
+		}
+
+		clampFixed(fixedBuffer.data(), out.data(), numSample * 2);
+	}
+	printBenchmarkResult("scalar fixed mixer", timer.end());
+
+	driver.setResampler(ResampleLinear);
+
+	timer.begin();
+	for (int b = 0; b < numBuffer; b++)
+	{
+		for (int i = 0; i < numVoice; i++)
+			sources[i]->uploadData(pcm[i].data(), pcmSize[i]);
+
+		driver.fillBuffer((unsigned short*)out.data(), numSample);
+	}
+	printBenchmarkResult("float bus, linear", timer.end());
+
+	driver.setResampler(ResampleSinc);
+
+	timer.begin();
+	for (int b = 0; b < numBuffer; b++)
+	{
+		for (int i = 0; i < numVoice; i++)
+			sources[i]->uploadData(pcm[i].data(), pcmSize[i]);
+
+		driver.fillBuffer((unsigned short*)out.data(), numSample);
+	}
+	printBenchmarkResult("float bus, polyphase sinc", timer.end());
+
+	driver.destroyAllSource();
+}
+
+void benchmarkAudio()
+{
+	benchmarkAudioMixer(64, 200);
+	benchmarkAudioMixer(128, 100);
+}
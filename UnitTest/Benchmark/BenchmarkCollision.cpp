@@ -0,0 +1,353 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkCollision.h"
+
+#include "Entity/CEntityManager.h"
+#include "Entity/CEntityPrefab.h"
+#include "Transform/CWorldTransformData.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "MeshManager/CMeshManager.h"
+#include "Collision/COctreeBuilder.h"
+#include "Collision/CBVHBuilder.h"
+#include "Job/CJobSystem.h"
+
+using namespace Skylicht;
+
+#define BENCHMARK_COLLISION_RAYS 5000
+
+// the world space triangles of the level
+class CLevelTriangleSelector : public CTriangleSelector
+{
+public:
+	CLevelTriangleSelector(CEntity* entity, const core::array<core::triangle3df>& triangles) :
+		CTriangleSelector(entity)
+	{
+		m_triangles = triangles;
+	}
+
+	virtual void init()
+	{
+	}
+};
+
+CCollisionNode* addLevelCollision(CCollisionBuilder* builder, CEntity* entity, const core::array<core::triangle3df>& triangles)
+{
+	return builder->addCollision(NULL, entity, new CLevelTriangleSelector(entity, triangles));
+}
+
+static f32 randomFloat(f32 min, f32 max)
+{
+	return min + (max - min) * (rand() / (f32)RAND_MAX);
+}
+
+bool loadSponzaTriangles(core::array<core::triangle3df>& triangles)
+{
+	CEntityPrefab* prefab = CMeshManager::getInstance()->loadModel("Sponza/Sponza.smesh", NULL, false);
+	if (prefab == NULL)
+		return false;
+
+	int numEntities = prefab->getNumEntities();
+	core::array<core::matrix4> world;
+	world.set_used(numEntities);
+
+	for (int i = 0; i < numEntities; i++)
+	{
+		CEntity* entity = prefab->getEntity(i);
+		if (entity == NULL)
+			continue;
+
+		// the parent is before the child in the prefab
+		CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+		if (transform->ParentIndex >= 0)
+			world[i].setbyproduct_nocheck(world[transform->ParentIndex], transform->Relative);
+		else
+			world[i] = transform->Relative;
+
+		CRenderMeshData* renderMesh = GET_ENTITY_DATA(entity, CRenderMeshData);
+		if (renderMesh == NULL || renderMesh->getMesh() == NULL)
+			continue;
+
+		CMesh* mesh = renderMesh->getMesh();
+		for (u32 j = 0, n = mesh->getMeshBufferCount(); j < n; j++)
+		{
+			IMeshBuffer* mb = mesh->getMeshBuffer(j);
+			IIndexBuffer* idx = mb->getIndexBuffer();
+			IVertexBuffer* vtx = mb->getVertexBuffer();
+
+			u32 pitch = getVertexPitchFromType(mb->getVertexType());
+			u8* vertices = (u8*)vtx->getVertices();
+
+			for (u32 k = 0, numIndex = idx->getIndexCount(); k + 2 < numIndex; k += 3)
+			{
+				core::triangle3df tri;
+				tri.pointA = ((video::S3DVertex*)(vertices + idx->getIndex(k) * pitch))->Pos;
+				tri.pointB = ((video::S3DVertex*)(vertices + idx->getIndex(k + 1) * pitch))->Pos;
+				tri.pointC = ((video::S3DVertex*)(vertices + idx->getIndex(k + 2) * pitch))->Pos;
+
+				world[i].transformVect(tri.pointA);
+				world[i].transformVect(tri.pointB);
+				world[i].transformVect(tri.pointC);
+				triangles.push_back(tri);
+			}
+		}
+	}
+
+	return triangles.size() > 0;
+}
+
+static void addQuadGrid(core::array<core::triangle3df>& triangles, const core::vector3df& origin, const core::vector3df& u, const core::vector3df& v, int nu, int nv)
+{
+	for (int j = 0; j < nv; j++)
+	{
+		for (int i = 0; i < nu; i++)
+		{
+			core::vector3df a = origin + u * (f32)i + v * (f32)j;
+			core::vector3df b = a + u;
+			core::vector3df c = a + v;
+			core::vector3df d = a + u + v;
+			triangles.push_back(core::triangle3df(a, c, b));
+			triangles.push_back(core::triangle3df(b, c, d));
+		}
+	}
+}
+
+static void addColumn(core::array<core::triangle3df>& triangles, const core::vector3df& base, f32 radius, f32 height, int segments, int rings)
+{
+	for (int r = 0; r < rings; r++)
+	{
+		f32 y0 = base.Y + height * r / rings;
+		f32 y1 = base.Y + height * (r + 1) / rings;
+
+		for (int s = 0; s < segments; s++)
+		{
+			f32 a0 = core::PI * 2.0f * s / segments;
+			f32 a1 = core::PI * 2.0f * (s + 1) / segments;
+
+			core::vector3df p0(base.X + cosf(a0) * radius, y0, base.Z + sinf(a0) * radius);
+			core::vector3df p1(base.X + cosf(a1) * radius, y0, base.Z + sinf(a1) * radius);
+			core::vector3df p2(p0.X, y1, p0.Z);
+			core::vector3df p3(p1.X, y1, p1.Z);
+
+			triangles.push_back(core::triangle3df(p0, p2, p1));
+			triangles.push_back(core::triangle3df(p1, p2, p3));
+		}
+	}
+}
+
+// an atrium with the size & the polygon count of sponza (~150k triangles)
+void createAtriumTriangles(core::array<core::triangle3df>& triangles)
+{
+	const f32 sizeX = 30.0f;
+	const f32 sizeY = 14.0f;
+	const f32 sizeZ = 12.0f;
+
+	// floor, roof & walls
+	addQuadGrid(triangles, core::vector3df(-sizeX, 0.0f, -sizeZ), core::vector3df(0.25f, 0.0f, 0.0f), core::vector3df(0.0f, 0.0f, 0.25f), 240, 96);
+	addQuadGrid(triangles, core::vector3df(-sizeX, sizeY, -sizeZ), core::vector3df(1.0f, 0.0f, 0.0f), core::vector3df(0.0f, 0.0f, 1.0f), 60, 24);
+	addQuadGrid(triangles, core::vector3df(-sizeX, 0.0f, -sizeZ), core::vector3df(0.25f, 0.0f, 0.0f), core::vector3df(0.0f, 0.25f, 0.0f), 240, 56);
+	addQuadGrid(triangles, core::vector3df(-sizeX, 0.0f, sizeZ), core::vector3df(0.25f, 0.0f, 0.0f), core::vector3df(0.0f, 0.25f, 0.0f), 240, 56);
+	addQuadGrid(triangles, core::vector3df(-sizeX, 0.0f, -sizeZ), core::vector3df(0.0f, 0.0f, 0.25f), core::vector3df(0.0f, 0.25f, 0.0f), 96, 56);
+	addQuadGrid(triangles, core::vector3df(sizeX, 0.0f, -sizeZ), core::vector3df(0.0f, 0.0f, 0.25f), core::vector3df(0.0f, 0.25f, 0.0f), 96, 56);
+
+	// 2 floors of column on the 2 sides
+	for (int floor = 0; floor < 2; floor++)
+	{
+		for (int side = 0; side < 2; side++)
+		{
+			for (int i = 0; i < 12; i++)
+			{
+				core::vector3df base(-sizeX + 2.5f + i * 5.0f, floor * 7.0f, side == 0 ? -6.0f : 6.0f);
+				addColumn(triangles, base, 0.6f, 6.0f, 32, 16);
+			}
+		}
+	}
+
+	// the balcony floor
+	addQuadGrid(triangles, core::vector3df(-sizeX, 7.0f, -sizeZ), core::vector3df(0.5f, 0.0f, 0.0f), core::vector3df(0.0f, 0.0f, 0.5f), 120, 11);
+	addQuadGrid(triangles, core::vector3df(-sizeX, 7.0f, 6.5f), core::vector3df(0.5f, 0.0f, 0.0f), core::vector3df(0.0f, 0.0f, 0.5f), 120, 11);
+
+	// small props (plants, curtains, details)
+	for (int i = 0; i < 20000; i++)
+	{
+		core::vector3df p(randomFloat(-sizeX, sizeX), randomFloat(0.0f, sizeY), randomFloat(-sizeZ, sizeZ));
+		core::vector3df b = p + core::vector3df(randomFloat(-0.3f, 0.3f), randomFloat(-0.3f, 0.3f), randomFloat(-0.3f, 0.3f));
+		core::vector3df c = p + core::vector3df(randomFloat(-0.3f, 0.3f), randomFloat(-0.3f, 0.3f), randomFloat(-0.3f, 0.3f));
+		triangles.push_back(core::triangle3df(p, b, c));
+	}
+}
+
+static double raycast(CCollisionBuilder* builder, const core::array<core::line3df>& rays, bool lineOfSight, int& numHit, f32& checksum)
+{
+	CBenchmarkTimer timer;
+
+	numHit = 0;
+	checksum = 0.0f;
+
+	for (u32 i = 0, n = rays.size(); i < n; i++)
+	{
+		if (lineOfSight)
+		{
+			if (builder->hasCollision(rays[i]))
+				numHit++;
+		}
+		else
+		{
+			f32 distance = rays[i].getLengthSQ();
+			core::vector3df hit;
+			core::triangle3df triangle;
+			CCollisionNode* node = NULL;
+
+			if (builder->getCollisionPoint(rays[i], distance, hit, triangle, node))
+			{
+				numHit++;
+				checksum += hit.Y;
+			}
+		}
+	}
+
+	return timer.end();
+}
+
+void benchmarkCollision()
+{
+	srand(1);
+
+	core::array<core::triangle3df> triangles;
+	if (loadSponzaTriangles(triangles))
+	{
+		BENCHMARK_CASE("Sponza.smesh");
+	}
+	else
+	{
+		BENCHMARK_CASE("procedural atrium (Sponza/Sponza.smesh is not found)");
+		createAtriumTriangles(triangles);
+	}
+
+	printf("   %u triangles\n", triangles.size());
+
+	core::aabbox3df bbox(triangles[0].pointA);
+	for (u32 i = 0, n = triangles.size(); i < n; i++)
+	{
+		bbox.addInternalPoint(triangles[i].pointA);
+		bbox.addInternalPoint(triangles[i].pointB);
+		bbox.addInternalPoint(triangles[i].pointC);
+	}
+
+	CEntityManager* mgr = new CEntityManager();
+	CEntity* entity = mgr->createEntity();
+	entity->addData<CWorldTransformData>();
+
+	COctreeBuilder* octree = new COctreeBuilder();
+	CBVHBuilder* bvh = new CBVHBuilder();
+
+	octree->addCollision(NULL, entity, new CLevelTriangleSelector(entity, triangles));
+	bvh->addCollision(NULL, entity, new CLevelTriangleSelector(entity, triangles));
+
+	CBenchmarkTimer timer;
+	octree->build();
+	printBenchmarkResult("build octree", timer.end());
+
+	timer.begin();
+	bvh->build();
+	printBenchmarkResult("build bvh", timer.end());
+
+	// ground snap: vertical rays, line of sight: rays between 2 points in the level
+	core::array<core::line3df> groundRays;
+	core::array<core::line3df> sightRays;
+
+	const core::vector3df& minEdge = bbox.MinEdge;
+	const core::vector3df& maxEdge = bbox.MaxEdge;
+
+	for (int i = 0; i < BENCHMARK_COLLISION_RAYS; i++)
+	{
+		f32 x = randomFloat(minEdge.X, maxEdge.X);
+		f32 z = randomFloat(minEdge.Z, maxEdge.Z);
+		f32 y = randomFloat(minEdge.Y, maxEdge.Y);
+		groundRays.push_back(core::line3df(x, y, z, x, minEdge.Y - 1.0f, z));
+
+		sightRays.push_back(core::line3df(
+			randomFloat(minEdge.X, maxEdge.X), randomFloat(minEdge.Y, maxEdge.Y), randomFloat(minEdge.Z, maxEdge.Z),
+			randomFloat(minEdge.X, maxEdge.X), randomFloat(minEdge.Y, maxEdge.Y), randomFloat(minEdge.Z, maxEdge.Z)));
+	}
+
+	int numHit = 0;
+	f32 checksum = 0.0f;
+	char name[512];
+
+	sprintf(name, "%d ground snap - octree", BENCHMARK_COLLISION_RAYS);
+	printBenchmarkResult(name, raycast(octree, groundRays, false, numHit, checksum));
+	printf("   hit: %d checksum: %f\n", numHit, checksum);
+
+	sprintf(name, "%d ground snap - bvh", BENCHMARK_COLLISION_RAYS);
+	printBenchmarkResult(name, raycast(bvh, groundRays, false, numHit, checksum));
+	printf("   hit: %d checksum: %f\n", numHit, checksum);
+
+	sprintf(name, "%d line of sight - octree", BENCHMARK_COLLISION_RAYS);
+	printBenchmarkResult(name, raycast(octree, sightRays, true, numHit, checksum));
+	printf("   hit: %d\n", numHit);
+
+	sprintf(name, "%d line of sight - bvh", BENCHMARK_COLLISION_RAYS);
+	printBenchmarkResult(name, raycast(bvh, sightRays, true, numHit, checksum));
+	printf("   hit: %d\n", numHit);
+
+	sprintf(name, "%d nearest hit - octree", BENCHMARK_COLLISION_RAYS);
+	printBenchmarkResult(name, raycast(octree, sightRays, false, numHit, checksum));
+	printf("   hit: %d checksum: %f\n", numHit, checksum);
+
+	sprintf(name, "%d nearest hit - bvh", BENCHMARK_COLLISION_RAYS);
+	printBenchmarkResult(name, raycast(bvh, sightRays, false, numHit, checksum));
+	printf("   hit: %d checksum: %f\n", numHit, checksum);
+
+	// the batched query on the workers
+	int numThread = SkylichtSystem::CJobSystem::getInstance()->getWorkerCount() + 1;
+
+	core::array<SCollisionHit> hits;
+	hits.set_used(sightRays.size());
+
+	timer.begin();
+	numHit = (int)bvh->getCollisionPoints(sightRays.const_pointer(), sightRays.size(), hits.pointer());
+	sprintf(name, "%d nearest hit - bvh batch (%d threads)", BENCHMARK_COLLISION_RAYS, numThread);
+	printBenchmarkResult(name, timer.end());
+
+	checksum = 0.0f;
+	for (u32 i = 0, n = hits.size(); i < n; i++)
+	{
+		if (hits[i].Node != NULL)
+			checksum += hits[i].Intersection.Y;
+	}
+	printf("   hit: %d checksum: %f\n", numHit, checksum);
+
+	// dynamic update of a streamed prop (a column) instead of build() the whole level
+	CEntity* propEntity = mgr->createEntity();
+	CWorldTransformData* propTransform = propEntity->addData<CWorldTransformData>();
+
+	core::array<core::triangle3df> column;
+	addColumn(column, core::vector3df(0.0f, 0.0f, 0.0f), 0.6f, 6.0f, 32, 16);
+
+	CCollisionNode* prop = octree->addCollision(NULL, propEntity, new CLevelTriangleSelector(propEntity, column));
+
+	timer.begin();
+	octree->insertCollision(prop);
+	sprintf(name, "insert prop (%u triangles) - octree", column.size());
+	printBenchmarkResult(name, timer.end());
+
+	timer.begin();
+	for (int i = 0; i < 100; i++)
+	{
+		propTransform->World.setTranslation(core::vector3df(randomFloat(minEdge.X, maxEdge.X), 0.0f, randomFloat(minEdge.Z, maxEdge.Z)));
+		octree->updateCollision(prop);
+	}
+	printBenchmarkResult("move prop - octree", timer.end() / 100);
+
+	timer.begin();
+	octree->removeCollision(&prop, 1);
+	printBenchmarkResult("remove prop - octree", timer.end());
+
+	timer.begin();
+	octree->build();
+	printBenchmarkResult("build octree again", timer.end());
+
+	delete octree;
+	delete bvh;
+	delete mgr;
+}
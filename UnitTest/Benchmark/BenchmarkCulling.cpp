@@ -0,0 +1,142 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkCulling.h"
+
+#include "Culling/CCullingBoxes.h"
+#include "Culling/CCullingBVH.h"
+
+#define BENCHMARK_CULLING_FRAME 20
+
+struct SBenchmarkBox
+{
+	core::matrix4 World;
+	int Proxy;
+};
+
+void moveBenchmarkBoxes(core::array<SBenchmarkBox>& boxes, core::array<int>& dynamicBoxes, int frame)
+{
+	for (u32 i = 0, n = dynamicBoxes.size(); i < n; i++)
+	{
+		SBenchmarkBox& b = boxes[dynamicBoxes[i]];
+
+		core::vector3df pos = b.World.getTranslation();
+		pos.Y = sinf((f32)(frame + i) * 0.1f) * 4.0f;
+		b.World.setTranslation(pos);
+	}
+}
+
+void benchmarkCulling(int numBox)
+{
+	char name[512];
+	sprintf(name, "%d boxes - 1%% dynamic", numBox);
+	BENCHMARK_CASE(name);
+
+	core::aabbox3df localBox(core::vector3df(-1.0f), core::vector3df(1.0f));
+
+	// grid of boxes
+	int gridSize = (int)sqrtf((f32)numBox);
+
+	core::array<SBenchmarkBox> boxes;
+	core::array<int> dynamicBoxes;
+	boxes.set_used(numBox);
+	for (int i = 0; i < numBox; i++)
+	{
+		SBenchmarkBox& b = boxes[i];
+		b.World.setRotationDegrees(core::vector3df(0.0f, (f32)(i % 360), 0.0f));
+		b.World.setTranslation(core::vector3df((f32)(i % gridSize) * 4.0f, 0.0f, (f32)(i / gridSize) * 4.0f));
+		b.Proxy = -1;
+
+		if (i % 100 == 0)
+			dynamicBoxes.push_back(i);
+	}
+
+	// camera at the corner of the grid
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 16.0f / 9.0f, 0.1f, 300.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(-10.0f, 20.0f, -10.0f), core::vector3df(100.0f, 0.0f, 100.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	SViewFrustum frustum(proj * view);
+	const core::aabbox3df& frustumBox = frustum.getBoundingBox();
+
+	core::array<u8> result;
+	result.set_used(numBox);
+
+	// 1. brute force: transform and test all boxes
+	CCullingBoxes cullingBoxes;
+	core::aabbox3df worldBox;
+	int numVisible = 0;
+
+	CBenchmarkTimer timer;
+	for (int frame = 0; frame < BENCHMARK_CULLING_FRAME; frame++)
+	{
+		moveBenchmarkBoxes(boxes, dynamicBoxes, frame);
+
+		cullingBoxes.reset();
+		for (int i = 0; i < numBox; i++)
+			cullingBoxes.add(localBox, boxes[i].World, true, worldBox);
+
+		cullingBoxes.cull(frustumBox, &frustum, result.pointer(), 0, numBox);
+	}
+	printBenchmarkResult("brute force (simd)", timer.end() / BENCHMARK_CULLING_FRAME);
+
+	for (int i = 0; i < numBox; i++)
+		numVisible += result[i];
+	printf("   visible: %d\n", numVisible);
+
+	// 2. tree: update the moved boxes, query and exact test the result
+	CCullingBVH tree;
+
+	timer.begin();
+	for (int i = 0; i < numBox; i++)
+	{
+		worldBox = localBox;
+		boxes[i].World.transformBoxEx(worldBox);
+		boxes[i].Proxy = tree.createProxy(worldBox, localBox, &boxes[i], i);
+	}
+	printBenchmarkResult("tree build", timer.end());
+
+	CFastArray<int> treeResult;
+	core::array<u8> treeCullResult;
+	treeCullResult.set_used(numBox);
+
+	int numCandidate = 0;
+
+	timer.begin();
+	for (int frame = 0; frame < BENCHMARK_CULLING_FRAME; frame++)
+	{
+		moveBenchmarkBoxes(boxes, dynamicBoxes, frame);
+
+		for (u32 i = 0, n = dynamicBoxes.size(); i < n; i++)
+		{
+			SBenchmarkBox& b = boxes[dynamicBoxes[i]];
+
+			worldBox = localBox;
+			b.World.transformBoxEx(worldBox);
+			tree.moveProxy(b.Proxy, worldBox, localBox);
+		}
+
+		treeResult.reset();
+		tree.query(frustumBox, &frustum, treeResult);
+
+		numCandidate = treeResult.count();
+		int* ids = treeResult.pointer();
+
+		cullingBoxes.reset();
+		for (int i = 0; i < numCandidate; i++)
+			cullingBoxes.add(localBox, boxes[ids[i]].World, true, worldBox);
+
+		cullingBoxes.cull(frustumBox, &frustum, treeCullResult.pointer(), 0, numCandidate);
+	}
+	printBenchmarkResult("tree update & query", timer.end() / BENCHMARK_CULLING_FRAME);
+
+	numVisible = 0;
+	for (int i = 0; i < numCandidate; i++)
+		numVisible += treeCullResult[i];
+	printf("   visible: %d (candidates: %d, tree height: %d)\n", numVisible, numCandidate, tree.getHeight());
+}
+
+void benchmarkCulling()
+{
+	benchmarkCulling(10000);
+	benchmarkCulling(100000);
+}
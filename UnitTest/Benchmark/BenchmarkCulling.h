@@ -0,0 +1,3 @@
+#pragma once
+
+void benchmarkCulling();
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkEntity.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Culling/CCullingData.h"
+#include "Culling/CCullingBBoxData.h"
+
+#define BENCHMARK_ENTITY_LOOP 10
+
+void transformByEntityData(CEntityGroup* group, const core::matrix4& parent, const core::aabbox3df& box)
+{
+	CEntity** entities = group->getEntities();
+	int numEntity = group->getEntityCount();
+
+	for (int i = 0; i < numEntity; i++)
+	{
+		CEntity* entity = entities[i];
+
+		CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+		CCullingData* culling = GET_ENTITY_DATA(entity, CCullingData);
+
+		transform->World.setbyproduct_nocheck(parent, transform->Relative);
+
+		culling->BBox = box;
+		transform->World.transformBoxEx(culling->BBox);
+	}
+}
+
+void transformByMaskGroup(CEntityManager* mgr, u64 mask, const core::matrix4& parent, const core::aabbox3df& box)
+{
+	core::array<CEntityMaskGroup*>& maskGroups = mgr->getMaskGroups();
+
+	for (u32 i = 0, n = maskGroups.size(); i < n; i++)
+	{
+		CEntityMaskGroup* maskGroup = maskGroups[i];
+		if (!maskGroup->haveDataMask(mask))
+			continue;
+
+		IEntityData** transforms = maskGroup->getDataPointers(DATA_TYPE_INDEX(CWorldTransformData));
+		IEntityData** cullings = maskGroup->getDataPointers(DATA_TYPE_INDEX(CCullingData));
+
+		for (int j = 0, m = maskGroup->getEntityCount(); j < m; j++)
+		{
+			CWorldTransformData* transform = (CWorldTransformData*)transforms[j];
+			CCullingData* culling = (CCullingData*)cullings[j];
+
+			transform->World.setbyproduct_nocheck(parent, transform->Relative);
+
+			culling->BBox = box;
+			transform->World.transformBoxEx(culling->BBox);
+		}
+	}
+}
+
+float getBoxChecksum(CEntityGroup* group)
+{
+	CEntity** entities = group->getEntities();
+	int numEntity = group->getEntityCount();
+
+	float checksum = 0.0f;
+	for (int i = 0; i < numEntity; i++)
+	{
+		CCullingData* culling = GET_ENTITY_DATA(entities[i], CCullingData);
+		checksum += culling->BBox.MinEdge.X + culling->BBox.MaxEdge.Z;
+	}
+	return checksum;
+}
+
+void benchmarkEntity(int numEntity, bool dataPoolMode)
+{
+	char name[512];
+	sprintf(name, "%d entities - %s", numEntity, dataPoolMode ? "data pool" : "legacy");
+	BENCHMARK_CASE(name);
+
+	CBenchmarkTimer timer;
+
+	CEntityManager* mgr = new CEntityManager();
+	mgr->setDataPoolMode(dataPoolMode);
+
+	for (int i = 0; i < numEntity; i++)
+	{
+		CEntity* entity = mgr->createEntity();
+
+		CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)(i % 100), 0.0f, (f32)(i / 100)));
+
+		entity->addData<CCullingData>();
+
+		// 2 mask groups
+		if (i % 2 == 0)
+			entity->addData<CCullingBBoxData>();
+	}
+	printBenchmarkResult("create", timer.end());
+
+	// sort the alive entities and build the mask groups
+	mgr->update();
+
+	const u32 types[] = GET_LIST_ENTITY_DATA2(CWorldTransformData, CCullingData);
+	CEntityGroup* group = mgr->createGroup(types, 2);
+
+	u64 mask = ((u64)1 << DATA_TYPE_INDEX(CWorldTransformData)) | ((u64)1 << DATA_TYPE_INDEX(CCullingData));
+
+	timer.begin();
+	for (int i = 0; i < BENCHMARK_ENTITY_LOOP; i++)
+		group->onQuery(mgr, mgr->getEntities(), mgr->getNumEntities());
+	printBenchmarkResult("group query", timer.end() / BENCHMARK_ENTITY_LOOP);
+
+	core::matrix4 parent;
+	parent.setRotationDegrees(core::vector3df(0.0f, 45.0f, 0.0f));
+
+	core::aabbox3df box(core::vector3df(-0.5f), core::vector3df(0.5f));
+
+	timer.begin();
+	for (int i = 0; i < BENCHMARK_ENTITY_LOOP; i++)
+		transformByEntityData(group, parent, box);
+	printBenchmarkResult("transform & bbox (GET_ENTITY_DATA)", timer.end() / BENCHMARK_ENTITY_LOOP);
+
+	if (dataPoolMode)
+	{
+		timer.begin();
+		for (int i = 0; i < BENCHMARK_ENTITY_LOOP; i++)
+			transformByMaskGroup(mgr, mask, parent, box);
+		printBenchmarkResult("transform & bbox (mask group pointers)", timer.end() / BENCHMARK_ENTITY_LOOP);
+	}
+
+	printf("   checksum: %f\n", getBoxChecksum(group));
+
+	timer.begin();
+	delete mgr;
+	printBenchmarkResult("release", timer.end());
+}
+
+void benchmarkEntity()
+{
+	benchmarkEntity(10000, false);
+	benchmarkEntity(10000, true);
+	benchmarkEntity(100000, false);
+	benchmarkEntity(100000, true);
+}
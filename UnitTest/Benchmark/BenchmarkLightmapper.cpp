@@ -0,0 +1,204 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkLightmapper.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Collision/CBVHBuilder.h"
+#include "Lightmapper/CCPUBaker.h"
+#include "Rasterisation/CRasterisation.h"
+#include "Job/CJobSystem.h"
+
+using namespace Skylicht;
+using namespace Skylicht::Lightmapper;
+
+#define BENCHMARK_LIGHTMAPPER_PROBES 256
+#define BENCHMARK_LIGHTMAP_SIZE 2048
+#define BENCHMARK_LIGHTMAP_CHARTS 64
+
+// see BenchmarkCollision.cpp
+bool loadSponzaTriangles(core::array<core::triangle3df>& triangles);
+void createAtriumTriangles(core::array<core::triangle3df>& triangles);
+CCollisionNode* addLevelCollision(CCollisionBuilder* builder, CEntity* entity, const core::array<core::triangle3df>& triangles);
+
+// the rotated quad charts on a grid
+static void createCharts(core::array<SRasterTriangle>& triangles, int numChart)
+{
+	float size = 1.0f / numChart;
+
+	for (int y = 0; y < numChart; y++)
+	{
+		for (int x = 0; x < numChart; x++)
+		{
+			core::vector2df center((x + 0.5f) * size, (y + 0.5f) * size);
+			float r = size * 0.45f;
+			float angle = (x * 7 + y * 3) * 0.3f;
+
+			core::vector2df uv[4];
+			for (int i = 0; i < 4; i++)
+			{
+				float a = angle + i * core::HALF_PI;
+				uv[i] = center + core::vector2df(cosf(a), sinf(a)) * r;
+			}
+
+			const int index[2][3] = { {0, 1, 2}, {0, 2, 3} };
+			for (int t = 0; t < 2; t++)
+			{
+				SRasterTriangle triangle;
+				for (int i = 0; i < 3; i++)
+				{
+					const core::vector2df& p = uv[index[t][i]];
+					triangle.UV[i] = p;
+					triangle.Position[i].set(p.X * 100.0f, 0.0f, p.Y * 100.0f);
+					triangle.Normal[i].set(0.0f, 1.0f, 0.0f);
+					triangle.Tangent[i].set(1.0f, 0.0f, 0.0f);
+				}
+				triangles.push_back(triangle);
+			}
+		}
+	}
+}
+
+static void benchmarkRasterisation()
+{
+	core::array<SRasterTriangle> triangles;
+	createCharts(triangles, BENCHMARK_LIGHTMAP_CHARTS);
+
+	char name[512];
+	sprintf(name, "%dx%d lightmap, %u triangles", BENCHMARK_LIGHTMAP_SIZE, BENCHMARK_LIGHTMAP_SIZE, triangles.size());
+	BENCHMARK_CASE(name);
+
+	CRasterisation* serial = new CRasterisation(BENCHMARK_LIGHTMAP_SIZE, BENCHMARK_LIGHTMAP_SIZE);
+	CRasterisation* tiled = new CRasterisation(BENCHMARK_LIGHTMAP_SIZE, BENCHMARK_LIGHTMAP_SIZE);
+
+	u32 numSerialPixel = 0;
+	u32 numTiledPixel = 0;
+
+	CBenchmarkTimer timer;
+	for (int pass = 0; pass < (int)CRasterisation::PassCount; pass++)
+	{
+		for (u32 i = 0, n = triangles.size(); i < n; i++)
+		{
+			SRasterTriangle& t = triangles[i];
+
+			core::vector3df outPos, outNormal, outTangent, outBinormal;
+			core::vector2di pixel = serial->setTriangle(t.Position, t.UV, t.Normal, t.Tangent, (CRasterisation::ERasterPass)pass);
+
+			while (!serial->isFinished(pixel))
+			{
+				serial->samplingTrianglePosition(outPos, outNormal, outTangent, outBinormal, pixel);
+				serial->moveNextPixel(pixel);
+			}
+		}
+
+		numSerialPixel += serial->getBakePixelQueue().size();
+		serial->getBakePixelQueue().set_used(0);
+	}
+	printBenchmarkResult("7 passes - setTriangle, moveNextPixel", timer.end());
+	printf("   bake pixels: %u\n", numSerialPixel);
+
+	timer.begin();
+	for (int pass = 0; pass < (int)CRasterisation::PassCount; pass++)
+	{
+		tiled->rasterise(triangles.const_pointer(), (int)triangles.size(), (CRasterisation::ERasterPass)pass);
+
+		numTiledPixel += tiled->getBakePixelQueue().size();
+		tiled->getBakePixelQueue().set_used(0);
+	}
+	printBenchmarkResult("7 passes - rasterise tiles", timer.end());
+	printf("   bake pixels: %u\n", numTiledPixel);
+
+	timer.begin();
+	tiled->imageDilate();
+	printBenchmarkResult("imageDilate", timer.end());
+
+	delete serial;
+	delete tiled;
+}
+
+void benchmarkLightmapper()
+{
+	benchmarkRasterisation();
+
+	srand(1);
+
+	core::array<core::triangle3df> triangles;
+	if (loadSponzaTriangles(triangles))
+	{
+		BENCHMARK_CASE("Sponza.smesh");
+	}
+	else
+	{
+		BENCHMARK_CASE("procedural atrium (Sponza/Sponza.smesh is not found)");
+		createAtriumTriangles(triangles);
+	}
+
+	core::aabbox3df bbox(triangles[0].pointA);
+	for (u32 i = 0, n = triangles.size(); i < n; i++)
+	{
+		bbox.addInternalPoint(triangles[i].pointA);
+		bbox.addInternalPoint(triangles[i].pointB);
+		bbox.addInternalPoint(triangles[i].pointC);
+	}
+
+	CEntityManager* mgr = new CEntityManager();
+	CEntity* entity = mgr->createEntity();
+	entity->addData<CWorldTransformData>();
+
+	CBVHBuilder* bvh = new CBVHBuilder();
+	addLevelCollision(bvh, entity, triangles);
+	bvh->build();
+
+	// the probes on a grid in the level
+	std::vector<core::vector3df> positions;
+	std::vector<core::vector3df> normals;
+	std::vector<core::vector3df> tangents;
+	std::vector<core::vector3df> binormals;
+
+	core::vector3df size = bbox.getExtent();
+	for (int i = 0; i < BENCHMARK_LIGHTMAPPER_PROBES; i++)
+	{
+		f32 x = ((i % 16) + 0.5f) / 16.0f;
+		f32 z = ((i / 16) + 0.5f) / 16.0f;
+		positions.push_back(bbox.MinEdge + core::vector3df(x * size.X, size.Y * 0.3f, z * size.Z));
+		normals.push_back(Transform::Oy);
+		tangents.push_back(Transform::Ox);
+		binormals.push_back(Transform::Oy.crossProduct(Transform::Ox));
+	}
+
+	CCPUBaker* baker = new CCPUBaker(bvh, 16);
+	baker->setNumBounce(2);
+	baker->setSkyColor(SColorf(0.6f, 0.7f, 0.9f));
+	baker->setRayDistance(size.getLength());
+	baker->addDirectionalLight(core::vector3df(-1.0f, -3.0f, -1.0f), SColorf(1.0f, 1.0f, 1.0f));
+	baker->addPointLight(bbox.getCenter(), SColorf(1.0f, 0.9f, 0.7f), 2.0f, size.getLength() * 0.5f);
+
+	std::vector<CSH9> result(BENCHMARK_LIGHTMAPPER_PROBES);
+
+	u32 numRay = BENCHMARK_LIGHTMAPPER_PROBES * baker->getSampleSize() * baker->getSampleSize() * NUM_FACES;
+	int numThread = SkylichtSystem::CJobSystem::getInstance()->getWorkerCount() + 1;
+	char name[512];
+
+	CBenchmarkTimer timer;
+	baker->bake(positions.data(), normals.data(), tangents.data(), binormals.data(), result.data(), BENCHMARK_LIGHTMAPPER_PROBES, NUM_FACES, false);
+	double ms = timer.end();
+	sprintf(name, "%d probes - cpu baker (1 thread)", BENCHMARK_LIGHTMAPPER_PROBES);
+	printBenchmarkResult(name, ms);
+	printf("   %u primary rays, %.2f Mrays/s\n", numRay, numRay / (ms * 1000.0));
+
+	timer.begin();
+	baker->bake(positions.data(), normals.data(), tangents.data(), binormals.data(), result.data(), BENCHMARK_LIGHTMAPPER_PROBES, NUM_FACES, true);
+	ms = timer.end();
+	sprintf(name, "%d probes - cpu baker (%d threads)", BENCHMARK_LIGHTMAPPER_PROBES, numThread);
+	printBenchmarkResult(name, ms);
+	printf("   %u primary rays, %.2f Mrays/s\n", numRay, numRay / (ms * 1000.0));
+
+	core::vector3df checksum;
+	for (int i = 0; i < BENCHMARK_LIGHTMAPPER_PROBES; i++)
+		checksum += result[i].getValue()[0];
+	printf("   checksum: %f %f %f\n", checksum.X, checksum.Y, checksum.Z);
+
+	delete baker;
+	delete bvh;
+	delete mgr;
+}
@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkParticle.h"
+
+#include "ParticleSystem/Particles/CGroup.h"
+#include "ParticleSystem/Particles/CFactory.h"
+
+#define BENCHMARK_PARTICLE_FRAME 20
+
+using namespace Skylicht;
+
+// the AoS update before the SoA particle array, as a reference
+void updateParticleAoS(core::array<Particle::CParticle>& particles, Particle::CGroup* group, float dt)
+{
+	dt = dt * 0.001f;
+
+	float pi2 = 2 * core::PI;
+	core::vector3df gravity = group->Gravity * dt;
+	float friction = group->Friction * dt;
+
+	std::vector<Particle::CModel*>& models = group->getModels();
+
+	for (u32 i = 0, n = particles.size(); i < n; i++)
+	{
+		Particle::CParticle* p = &particles[i];
+		float* params = p->Params;
+
+		p->Age = p->Age + dt;
+		if (!p->Immortal)
+			p->Life -= dt;
+
+		p->LastPosition = p->Position;
+		p->Position += p->Velocity * dt;
+		p->Velocity += gravity;
+
+		if (p->HaveRotate == true)
+		{
+			p->Rotation.Z = fmodf(p->Rotation.Z + params[Particle::RotateSpeedZ] * dt, pi2);
+		}
+
+		if (group->Friction > 0.0f)
+			p->Velocity *= 1.0f - core::min_(1.0f, friction / params[Particle::Mass]);
+
+		float x = core::clamp(p->Age / p->LifeTime, 0.0f, 1.0f);
+
+		for (Particle::CModel* m : models)
+		{
+			Particle::EParticleParams t = m->getType();
+			if (m->getInterpolator() != NULL)
+				params[t] = m->getInterpolator()->interpolate(x);
+			else
+				params[t] = p->StartValue[t] + (p->EndValue[t] - p->StartValue[t]) * x;
+		}
+	}
+}
+
+void benchmarkParticle(int numParticle)
+{
+	char name[512];
+	sprintf(name, "%d particles", numParticle);
+	BENCHMARK_CASE(name);
+
+	Particle::CFactory factory;
+	Particle::CEmitter* emitter = factory.createRandomEmitter();
+	emitter->setForce(1.0f, 5.0f);
+
+	Particle::CInterpolator* interpolator;
+
+	Particle::CGroup group;
+	group.Gravity.set(0.0f, -9.8f, 0.0f);
+	group.Friction = 0.5f;
+	group.LifeMin = 100.0f;
+	group.LifeMax = 200.0f;
+	group.createModel(Particle::ColorA)->setStart(1.0f)->setEnd(0.0f);
+	group.createModel(Particle::RotateSpeedZ)->setStart(-1.0f, 1.0f);
+
+	interpolator = group.createInterpolator();
+	interpolator->addEntry(0.0f, 0.0f);
+	interpolator->addEntry(0.2f, 1.0f);
+	interpolator->addEntry(1.0f, 0.0f);
+	group.createModel(Particle::Scale)->setInterpolator(interpolator);
+
+	float timeStep = getTimeStep();
+	setTimeStep(1000.0f / 60.0f);
+
+	CBenchmarkTimer timer;
+	for (int i = 0; i < numParticle; i++)
+	{
+		core::vector3df pos((f32)(i % 100), 0.0f, (f32)(i / 100 % 100));
+		group.addParticleByEmitter(emitter, pos, core::vector3df(0.0f, 1.0f, 0.0f));
+	}
+	printBenchmarkResult("spawn", timer.end());
+
+	// the AoS copy of the particles
+	core::array<Particle::CParticle> aos;
+	aos.reallocate(numParticle);
+	for (int i = 0; i < numParticle; i++)
+	{
+		aos.push_back(Particle::CParticle(i));
+		group.getParticles()->get(i, aos.getLast());
+	}
+
+	timer.begin();
+	for (int frame = 0; frame < BENCHMARK_PARTICLE_FRAME; frame++)
+		updateParticleAoS(aos, &group, getTimeStep());
+	printBenchmarkResult("update aos (reference)", timer.end() / BENCHMARK_PARTICLE_FRAME);
+
+	timer.begin();
+	for (int frame = 0; frame < BENCHMARK_PARTICLE_FRAME; frame++)
+		group.update(true);
+	printBenchmarkResult("update soa (simd)", timer.end() / BENCHMARK_PARTICLE_FRAME);
+
+	// kill 10% particles per frame
+	Particle::CParticleArray* particles = group.getParticles();
+
+	timer.begin();
+	for (int frame = 0; frame < BENCHMARK_PARTICLE_FRAME; frame++)
+	{
+		for (u32 i = 0, n = particles->getCount(); i < n; i += 10)
+			particles->setLife(i, -1.0f);
+
+		group.update(true);
+	}
+	printBenchmarkResult("update soa & remove 10%", timer.end() / BENCHMARK_PARTICLE_FRAME);
+	printf("   alive: %d\n", particles->getCount());
+
+	setTimeStep(timeStep);
+}
+
+void benchmarkParticle()
+{
+	benchmarkParticle(100000);
+	benchmarkParticle(1000000);
+}
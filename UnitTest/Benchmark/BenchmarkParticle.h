@@ -0,0 +1,3 @@
+#pragma once
+
+void benchmarkParticle();
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkRenderQueue.h"
+
+#include "RenderMesh/CRenderQueue.h"
+
+#define BENCHMARK_RENDERQUEUE_FRAME 20
+
+// emulate the pointer chain of CRenderMeshData -> CMesh -> CMaterial -> ITexture
+struct SBenchmarkTexture
+{
+	int Id;
+};
+
+struct SBenchmarkMaterial
+{
+	SBenchmarkTexture* Texture;
+};
+
+struct SBenchmarkMesh
+{
+	SBenchmarkMaterial* Material;
+	void* MeshBuffer;
+};
+
+struct SBenchmarkDraw
+{
+	SBenchmarkMesh* Mesh;
+	f32 Depth;
+};
+
+int cmpBenchmarkDraw(const void* a, const void* b)
+{
+	SBenchmarkMesh* meshA = (*((SBenchmarkDraw**)a))->Mesh;
+	SBenchmarkMesh* meshB = (*((SBenchmarkDraw**)b))->Mesh;
+
+	SBenchmarkTexture* textureA = meshA->Material->Texture;
+	SBenchmarkTexture* textureB = meshB->Material->Texture;
+
+	if (textureA == textureB)
+	{
+		if (meshA->MeshBuffer == meshB->MeshBuffer)
+			return 0;
+		return meshA->MeshBuffer < meshB->MeshBuffer ? -1 : 1;
+	}
+
+	return textureA < textureB ? -1 : 1;
+}
+
+void benchmarkRenderQueue(int numDraw)
+{
+	char name[512];
+	sprintf(name, "%d draws", numDraw);
+	BENCHMARK_CASE(name);
+
+	int numTexture = 64;
+	int numMaterial = 256;
+	int numMesh = 1024;
+
+	core::array<SBenchmarkTexture*> textures;
+	core::array<SBenchmarkMaterial*> materials;
+	core::array<SBenchmarkMesh*> meshes;
+	core::array<SBenchmarkDraw*> draws;
+
+	for (int i = 0; i < numTexture; i++)
+	{
+		SBenchmarkTexture* t = new SBenchmarkTexture();
+		t->Id = i;
+		textures.push_back(t);
+	}
+
+	for (int i = 0; i < numMaterial; i++)
+	{
+		SBenchmarkMaterial* m = new SBenchmarkMaterial();
+		m->Texture = textures[(i * 7) % numTexture];
+		materials.push_back(m);
+	}
+
+	for (int i = 0; i < numMesh; i++)
+	{
+		SBenchmarkMesh* m = new SBenchmarkMesh();
+		m->Material = materials[(i * 13) % numMaterial];
+		m->MeshBuffer = m;
+		meshes.push_back(m);
+	}
+
+	for (int i = 0; i < numDraw; i++)
+	{
+		SBenchmarkDraw* d = new SBenchmarkDraw();
+		d->Mesh = meshes[(i * 31 + i / 7) % numMesh];
+		d->Depth = (f32)(i % 1000) / 1000.0f;
+		draws.push_back(d);
+	}
+
+	core::array<SBenchmarkDraw*> sortDraws;
+	sortDraws.set_used(numDraw);
+
+	// 1. qsort with the comparator
+	CBenchmarkTimer timer;
+	for (int frame = 0; frame < BENCHMARK_RENDERQUEUE_FRAME; frame++)
+	{
+		for (int i = 0; i < numDraw; i++)
+			sortDraws[i] = draws[i];
+
+		qsort(sortDraws.pointer(), numDraw, sizeof(SBenchmarkDraw*), cmpBenchmarkDraw);
+	}
+	printBenchmarkResult("qsort comparator", timer.end() / BENCHMARK_RENDERQUEUE_FRAME);
+
+	// 2. build key and radix sort
+	CRenderQueue queue;
+
+	timer.begin();
+	for (int frame = 0; frame < BENCHMARK_RENDERQUEUE_FRAME; frame++)
+	{
+		queue.reset();
+
+		for (int i = 0; i < numDraw; i++)
+		{
+			SBenchmarkMesh* mesh = draws[i]->Mesh;
+			u64 key = CRenderQueue::makeKey(
+				CRenderQueue::Opaque,
+				0,
+				CRenderQueue::hashPointer(mesh->Material, 12),
+				CRenderQueue::hashPointer(mesh->Material->Texture, 12),
+				CRenderQueue::hashPointer(mesh->MeshBuffer, 12),
+				draws[i]->Depth);
+
+			queue.push(key, i, 0);
+		}
+
+		queue.sort();
+	}
+	printBenchmarkResult("build key & radix sort", timer.end() / BENCHMARK_RENDERQUEUE_FRAME);
+
+	// count state changes of the sorted list
+	CRenderQueue::SItem* items = queue.getItems();
+	int numMaterialChange = 0;
+	SBenchmarkMaterial* lastMaterial = NULL;
+	for (int i = 0; i < numDraw; i++)
+	{
+		SBenchmarkMaterial* m = draws[items[i].Object]->Mesh->Material;
+		if (m != lastMaterial)
+		{
+			numMaterialChange++;
+			lastMaterial = m;
+		}
+	}
+	printf("   material change: %d\n", numMaterialChange);
+
+	for (int i = 0; i < numDraw; i++)
+		delete draws[i];
+	for (int i = 0; i < numMesh; i++)
+		delete meshes[i];
+	for (int i = 0; i < numMaterial; i++)
+		delete materials[i];
+	for (int i = 0; i < numTexture; i++)
+		delete textures[i];
+}
+
+void benchmarkRenderQueue()
+{
+	benchmarkRenderQueue(20000);
+	benchmarkRenderQueue(100000);
+}
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "BenchmarkScene.h"
+
+#include "Scene/CScene.h"
+#include "Scene/CSceneExporter.h"
+#include "Scene/CSceneImporter.h"
+
+using namespace Skylicht;
+
+double benchmarkImportScene(const char* path, int* numObject)
+{
+	CBenchmarkTimer timer;
+
+	CScene* scene = new CScene();
+	if (CSceneImporter::beginImportScene(scene, path))
+	{
+		while (!CSceneImporter::updateLoadScene())
+		{
+		}
+	}
+
+	double ms = timer.end();
+
+	scene->updateAddRemoveObject();
+
+	*numObject = 0;
+	ArrayZone* zones = scene->getAllZone();
+	for (size_t i = 0, n = zones->size(); i < n; i++)
+		*numObject += (int)zones->at(i)->getArrayChilds(false).size();
+
+	delete scene;
+	return ms;
+}
+
+long benchmarkFileSize(const char* path)
+{
+	io::IReadFile* file = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(path);
+	if (file == NULL)
+		return 0;
+
+	long size = file->getSize();
+	file->drop();
+	return size;
+}
+
+void benchmarkScene(int numContainer, int numObject)
+{
+	char name[512];
+	sprintf(name, "%d objects", numContainer * numObject);
+	BENCHMARK_CASE(name);
+
+	const char* xmlPath = "BenchmarkScene.scene";
+	const char* binaryPath = "BenchmarkScene.sbin";
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	for (int i = 0; i < numContainer; i++)
+	{
+		CContainerObject* container = zone->createContainerObject();
+		container->getTransformEuler()->setPosition(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		for (int j = 0; j < numObject; j++)
+		{
+			CGameObject* object = container->createEmptyObject();
+			object->getTransformEuler()->setPosition(core::vector3df(0.0f, (f32)j, 0.0f));
+			object->getTransformEuler()->setRotation(core::vector3df(0.0f, (f32)(j % 360), 0.0f));
+		}
+	}
+	scene->updateAddRemoveObject();
+
+	CBenchmarkTimer timer;
+	CSceneExporter::exportScene(scene, xmlPath);
+	printBenchmarkResult("export xml", timer.end());
+
+	timer.begin();
+	CSceneExporter::exportSceneBinary(scene, binaryPath);
+	printBenchmarkResult("export binary", timer.end());
+
+	delete scene;
+
+	int xmlObject = 0, binaryObject = 0;
+	printBenchmarkResult("import xml", benchmarkImportScene(xmlPath, &xmlObject));
+	printBenchmarkResult("import binary", benchmarkImportScene(binaryPath, &binaryObject));
+
+	printf("   file size: xml %ld bytes, binary %ld bytes\n", benchmarkFileSize(xmlPath), benchmarkFileSize(binaryPath));
+	printf("   objects: xml %d, binary %d\n", xmlObject, binaryObject);
+
+	remove(xmlPath);
+	remove(binaryPath);
+}
+
+void benchmarkScene()
+{
+	benchmarkScene(10, 100);
+	benchmarkScene(50, 200);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void benchmarkScene();
\ No newline at end of file
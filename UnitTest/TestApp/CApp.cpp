@@ -4,6 +4,28 @@
 #include "TestScene.h"
 #include "TestMemoryStream.h"
 #include "TestSpreadsheet.h"
+#include "TestEntityDataPool.h"
+#include "TestJobSystem.h"
+#include "TestWorldTransform.h"
+#include "TestCulling.h"
+#include "TestSkinning.h"
+#include "TestAnimation.h"
+#include "TestParticle.h"
+#include "TestRenderQueue.h"
+#include "TestRenderState.h"
+#include "TestSerializableBinary.h"
+#include "TestStreaming.h"
+#include "TestSkylichtAsset.h"
+#include "TestMeshManager.h"
+#include "TestMeshRenderer.h"
+#include "TestAudioMixer.h"
+#include "TestAudioVoice.h"
+#include "TestAudioCache.h"
+#include "TestCollisionBVH.h"
+#include "TestCollisionQuery.h"
+#include "TestCollisionDynamic.h"
+#include "TestLightmapper.h"
+#include "TestRasterisation.h"
 
 #include "CApplication.h"
 #include "Material/Shader/CShaderManager.h"
@@ -57,6 +79,50 @@ void CApp::onInitApp()
 	testScene();
 
 	testSpreadsheet();
+
+	testEntityDataPool();
+
+	testJobSystem();
+
+	testWorldTransform();
+
+	testCulling();
+
+	testSkinning();
+
+	testAnimation();
+
+	testParticle();
+
+	testRenderQueue();
+
+	testRenderState();
+
+	testSerializableBinary();
+
+	testStreaming();
+
+	testSkylichtAsset();
+
+	testMeshManager();
+
+	testMeshRenderer();
+
+	testAudioMixer();
+
+	testAudioVoice();
+
+	testAudioCache();
+
+	testCollisionBVH();
+
+	testCollisionQuery();
+
+	testCollisionDynamic();
+
+	testLightmapper();
+
+	testRasterisation();
 }
 
 void CApp::onUpdate()
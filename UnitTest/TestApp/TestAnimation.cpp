@@ -0,0 +1,269 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAnimation.h"
+
+#include "Animation/CAnimationTrack.h"
+#include "Animation/Skeleton/CSkeletonPose.h"
+#include "Utils/CMemoryStream.h"
+#include "Job/CJobSystem.h"
+
+using namespace Skylicht;
+
+void testAnimation()
+{
+	TEST_CASE("Key frame seek");
+	CArrayKeyFrame<core::vector3df> keys;
+	for (int i = 0; i < 100; i++)
+	{
+		CPositionKey key;
+		key.Frame = i * 0.1f;
+		key.Value.set((f32)i, 0.0f, 0.0f);
+		keys.Data.push_back(key);
+	}
+	int hint = 0;
+	TEST_ASSERT_EQUAL(keys.getIndex(0.0f, hint), 0);
+	TEST_ASSERT_EQUAL(keys.getIndex(5.05f, hint), 51);
+	TEST_ASSERT_EQUAL(hint, 51);
+	TEST_ASSERT_EQUAL(keys.getIndex(5.15f, hint), 52);
+	TEST_ASSERT_EQUAL(keys.getIndex(1.05f, hint), 11);
+	TEST_ASSERT_EQUAL(keys.getIndex(100.0f, hint), -1);
+
+	TEST_CASE("Key frame shared by parallel tracks");
+	CAnimationData sharedData;
+	sharedData.Positions.Data = keys.Data;
+	sharedData.Scales.Default.set(1.0f, 1.0f, 1.0f);
+
+	// many characters play the same clip at the different times
+	const int numTrack = 64;
+	CAnimationTrack tracks[numTrack];
+	for (int i = 0; i < numTrack; i++)
+		tracks[i].setAnimationData(&sharedData);
+
+	SkylichtSystem::CJobSystem* jobSystem = new SkylichtSystem::CJobSystem(2);
+	std::atomic<int> numWrong(0);
+
+	for (int step = 0; step < 100; step++)
+	{
+		jobSystem->parallelFor(numTrack, 1, [&](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					// the key i is at frame i * 0.1, the value is i
+					f32 frame = ((step + i * 13) % 99) * 0.1f + 0.05f;
+
+					core::vector3df position, scale;
+					core::quaternion rotation;
+					tracks[i].getFrameData(frame, position, scale, rotation);
+
+					if (fabsf(position.X - frame * 10.0f) > 0.01f)
+						numWrong++;
+				}
+			});
+	}
+	delete jobSystem;
+
+	TEST_ASSERT_EQUAL(numWrong.load(), 0);
+
+	TEST_CASE("Smallest three quaternion");
+	int numError = 0;
+	for (int i = 0; i < 64; i++)
+	{
+		core::quaternion q(core::vector3df(i * 0.3f, i * 0.7f - 5.0f, i * 1.1f));
+		core::quaternion r;
+		u16 packed[3];
+		CCompressedAnimationData::packQuaternion(q, packed);
+		CCompressedAnimationData::unpackQuaternion(packed, r);
+
+		// q and -q are the same rotation
+		if (fabsf(q.dotProduct(r)) < 0.99999f)
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	TEST_CASE("Compressed animation");
+	CAnimationData data;
+	for (int i = 0; i <= 60; i++)
+	{
+		f32 t = i / 30.0f;
+
+		CPositionKey pos;
+		pos.Frame = t;
+		pos.Value.set(t * 2.0f, sinf(t), -1.0f);
+		data.Positions.Data.push_back(pos);
+
+		CRotationKey rot;
+		rot.Frame = t;
+		rot.Value.fromAngleAxis(t, core::vector3df(0.0f, 1.0f, 0.0f));
+		data.Rotations.Data.push_back(rot);
+	}
+	data.Scales.Default.set(1.0f, 1.0f, 1.0f);
+
+	CAnimationData raw = data;
+	data.compress(30.0f, 2.0f);
+
+	TEST_ASSERT_THROW(data.isCompressed());
+	TEST_ASSERT_EQUAL(data.Positions.size(), 0);
+	TEST_ASSERT_FLOAT_EQUAL(data.getLastFrame(), 2.0f);
+	TEST_ASSERT_EQUAL(data.Scales.size(), 0);
+	TEST_ASSERT_EQUAL(data.Compressed.Scales.size(), 3);
+
+	CMemoryStream stream;
+	data.Compressed.write(&stream);
+
+	CMemoryStream readStream(stream.getData(), stream.getSize());
+	CAnimationData loaded;
+	loaded.Compressed.read(&readStream);
+
+	CAnimationTrack rawTrack, track;
+	rawTrack.setAnimationData(&raw);
+	track.setAnimationData(&loaded);
+
+	numError = 0;
+	for (int i = 0; i < 200; i++)
+	{
+		// random seek
+		f32 frame = ((i * 37) % 200) * 0.01f;
+
+		core::vector3df p1, s1, p2, s2;
+		core::quaternion r1, r2;
+		rawTrack.getFrameData(frame, p1, s1, r1);
+		track.getFrameData(frame, p2, s2, r2);
+
+		if (!p1.equals(p2, 0.001f) || !s1.equals(s2, 0.001f) || fabsf(r1.dotProduct(r2)) < 0.9999f)
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	TEST_CASE("Skeleton pose blending");
+	const u32 numJoint = 6;
+
+	CSkeletonPose pose, layer;
+	pose.resize(numJoint);
+	layer.resize(numJoint);
+
+	core::vector3df pos[numJoint], scale[numJoint];
+	core::quaternion rot[numJoint];
+	core::vector3df layerPos[numJoint], layerScale[numJoint];
+	core::quaternion layerRot[numJoint];
+
+	f32 weight[8] = { 0.2f, 0.5f, 1.0f, 0.7f, 0.3f, 0.9f, 0.0f, 0.0f };
+	f32 mask[8] = { 1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f };
+
+	for (u32 i = 0; i < numJoint; i++)
+	{
+		pos[i].set((f32)i, 1.0f, -2.0f);
+		scale[i].set(1.0f, 2.0f, 1.0f);
+		rot[i] = core::quaternion(core::vector3df(0.1f * i, 0.2f, 0.3f));
+
+		layerPos[i].set(2.0f, (f32)i, 0.5f);
+		layerScale[i].set(0.5f, 1.0f, 3.0f);
+		layerRot[i] = core::quaternion(core::vector3df(-0.4f, 0.5f * i, 0.1f));
+
+		// the short way test
+		if (i == 1)
+			layerRot[i] *= -1.0f;
+
+		pose.set(i, pos[i], rot[i], scale[i]);
+		layer.set(i, layerPos[i], layerRot[i], layerScale[i]);
+	}
+
+	pose.blend(layer, weight, mask, false);
+	pose.additive(layer, weight, mask);
+	pose.replace(layer, weight, mask);
+
+	numError = 0;
+	for (u32 i = 0; i < numJoint; i++)
+	{
+		core::vector3df p = pos[i], s = scale[i];
+		core::quaternion r = rot[i];
+
+		if (mask[i] > 0.0f)
+		{
+			f32 w = weight[i];
+
+			// blend
+			core::quaternion q = layerRot[i];
+			if (r.dotProduct(q) < 0.0f)
+				q *= -1.0f;
+			p += layerPos[i] * w;
+			s += layerScale[i] * w;
+			r = core::quaternion(r.X + q.X * w, r.Y + q.Y * w, r.Z + q.Z * w, r.W + q.W * w);
+
+			// additive
+			q = layerRot[i];
+			if (q.W < 0.0f)
+				q *= -1.0f;
+			core::quaternion add(q.X * w, q.Y * w, q.Z * w, (q.W - 1.0f) * w + 1.0f);
+			add.normalize();
+			p += layerPos[i] * w;
+			s.X = s.X * (1.0f - w + layerScale[i].X * w);
+			s.Y = s.Y * (1.0f - w + layerScale[i].Y * w);
+			s.Z = s.Z * (1.0f - w + layerScale[i].Z * w);
+			r = add * r;
+
+			// replace
+			CAnimationTrack::quaternionSlerp(r, r, layerRot[i], w);
+			p = p * (1.0f - w) + layerPos[i] * w;
+			s = s * (1.0f - w) + layerScale[i] * w;
+		}
+
+		core::vector3df resultPos, resultScale;
+		core::quaternion resultRot;
+		pose.get(i, resultPos, resultRot, resultScale);
+
+		if (!p.equals(resultPos, 0.0001f) ||
+			!s.equals(resultScale, 0.0001f) ||
+			!r.equals(resultRot, 0.0001f))
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	TEST_CASE("Skeleton pose lerp");
+	CSkeletonPose from, to;
+	from.resize(numJoint);
+	to.resize(numJoint);
+	for (u32 i = 0; i < numJoint; i++)
+	{
+		from.set(i, pos[i], rot[i], scale[i]);
+		to.set(i, layerPos[i], layerRot[i], layerScale[i]);
+	}
+
+	from.lerp(to, 0.25f);
+
+	numError = 0;
+	for (u32 i = 0; i < numJoint; i++)
+	{
+		core::quaternion q = layerRot[i];
+		if (rot[i].dotProduct(q) < 0.0f)
+			q *= -1.0f;
+
+		core::quaternion r = rot[i] * 0.75f + q * 0.25f;
+		r.normalize();
+
+		core::vector3df resultPos, resultScale;
+		core::quaternion resultRot;
+		from.get(i, resultPos, resultRot, resultScale);
+
+		if (!resultPos.equals(pos[i] * 0.75f + layerPos[i] * 0.25f, 0.0001f) ||
+			!resultScale.equals(scale[i] * 0.75f + layerScale[i] * 0.25f, 0.0001f) ||
+			!resultRot.equals(r, 0.0001f))
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	// reach the target pose
+	from.lerp(to, 1.0f);
+
+	numError = 0;
+	for (u32 i = 0; i < numJoint; i++)
+	{
+		core::vector3df resultPos, resultScale;
+		core::quaternion resultRot;
+		from.get(i, resultPos, resultRot, resultScale);
+
+		if (!resultPos.equals(layerPos[i], 0.0001f) ||
+			fabsf(resultRot.dotProduct(layerRot[i])) < 0.9999f)
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+}
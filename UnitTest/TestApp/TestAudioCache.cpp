@@ -0,0 +1,162 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAudioCache.h"
+
+#include "Driver/CDriverNull.h"
+#include "Engine/CAudioEngine.h"
+#include "Engine/CStreamFactory.h"
+
+using namespace SkylichtAudio;
+
+// see TestAudioVoice.cpp
+IStream* createTestWave(int sampleRate, float duration);
+
+void writeTestWave(const char* fileName, float duration)
+{
+	IStream* stream = createTestWave(22050, duration);
+	IStreamCursor* cursor = stream->createCursor();
+
+	std::vector<unsigned char> data(cursor->size());
+	cursor->read(data.data(), cursor->size());
+
+	FILE* f = fopen(fileName, "wb");
+	fwrite(data.data(), 1, data.size(), f);
+	fclose(f);
+
+	delete cursor;
+	stream->drop();
+}
+
+void testAudioCache()
+{
+	TEST_CASE("Audio decoded pcm cache");
+
+	CStreamFactory factory;
+
+	CAudioEngine* engine = CAudioEngine::getSoundEngine();
+	engine->registerStreamFactory(&factory);
+
+	const char* fileA = "TestAudioCache_a.wav";
+	const char* fileB = "TestAudioCache_b.wav";
+	const char* fileC = "TestAudioCache_c.wav";
+	const char* fileLong = "TestAudioCache_long.wav";
+
+	// 0.5s mono 22khz: 22050 bytes
+	writeTestWave(fileA, 0.5f);
+	writeTestWave(fileB, 0.5f);
+	writeTestWave(fileC, 0.5f);
+	writeTestWave(fileLong, 3.0f);
+
+	CPCMCache* cache = engine->getPCMCache();
+	cache->clear();
+	cache->resetStatistics();
+	cache->setMaxClipSize(64 * 1024);
+	cache->setMemoryBudget(48 * 1024);
+
+	IStream* a1 = cache->getStream(fileA);
+	IStream* a2 = cache->getStream(fileA);
+	TEST_ASSERT_THROW(a1 != NULL);
+	TEST_ASSERT_THROW(a1 == a2);
+	TEST_ASSERT_EQUAL(cache->getNumMisses(), 1);
+	TEST_ASSERT_EQUAL(cache->getNumHits(), 1);
+	TEST_ASSERT_EQUAL(cache->getMemoryUsed(), 22050);
+	TEST_ASSERT_EQUAL(a1->getSampleRate(), 22050);
+	TEST_ASSERT_EQUAL(a1->getChannels(), 1);
+
+	// the decoded pcm is the wave data
+	IStream* wave = createTestWave(22050, 0.5f);
+	IStreamCursor* waveCursor = wave->createCursor();
+	IStreamCursor* pcmCursor = a1->createCursor();
+
+	std::vector<unsigned char> waveData(waveCursor->size());
+	std::vector<unsigned char> pcmData(pcmCursor->size());
+	waveCursor->read(waveData.data(), waveCursor->size());
+	pcmCursor->read(pcmData.data(), pcmCursor->size());
+
+	TEST_ASSERT_EQUAL((int)pcmData.size(), 22050);
+	TEST_ASSERT_THROW(memcmp(waveData.data() + 44, pcmData.data(), pcmData.size()) == 0);
+
+	delete waveCursor;
+	delete pcmCursor;
+	wave->drop();
+
+	// the long clip is not cached, it is not decoded again
+	TEST_ASSERT_THROW(cache->getStream(fileLong) == NULL);
+	TEST_ASSERT_THROW(cache->getStream(fileLong) == NULL);
+	TEST_ASSERT_EQUAL(cache->getNumMisses(), 2);
+
+	// the emitters share the decoded stream
+	CDriverNull driver;
+
+	CAudioEmitter* emitter1 = new CAudioEmitter(fileA, true, &driver);
+	CAudioEmitter* emitter2 = new CAudioEmitter(fileA, true, &driver);
+	CAudioEmitter* emitterLong = new CAudioEmitter(fileLong, true, &driver);
+
+	emitter1->play();
+	emitter2->play();
+	emitterLong->play();
+
+	emitter1->update();
+	emitter2->update();
+	emitterLong->update();
+
+	TEST_ASSERT_THROW(emitter1->getDecoderType() == IAudioDecoder::PCM);
+	TEST_ASSERT_THROW(emitter1->getStream() == a1);
+	TEST_ASSERT_THROW(emitter2->getStream() == a1);
+	TEST_ASSERT_THROW(emitter1->isPlaying());
+	TEST_ASSERT_THROW(emitterLong->getDecoderType() == IAudioDecoder::Wav);
+	TEST_ASSERT_THROW(emitterLong->isPlaying());
+	TEST_ASSERT_EQUAL(cache->getNumHits(), 3);
+
+	// the budget keeps 2 clips, the least recent clip (a) is dropped
+	IStream* b = cache->getStream(fileB);
+	IStream* c = cache->getStream(fileC);
+	TEST_ASSERT_EQUAL(cache->getNumClips(), 2);
+	TEST_ASSERT_THROW(cache->getMemoryUsed() <= cache->getMemoryBudget());
+
+	// but the emitter still play it
+	for (int i = 0; i < 10; i++)
+		emitter1->update();
+	TEST_ASSERT_THROW(emitter1->isPlaying());
+
+	IStream* a3 = cache->getStream(fileA);
+	TEST_ASSERT_THROW(a3 != NULL);
+	TEST_ASSERT_EQUAL(cache->getNumMisses(), 5);
+
+	// the wav know the number of samples, the silent tail is a part of the clip
+	const char* fileSilent = "TestAudioCache_silent.wav";
+	writeTestWave(fileSilent, 0.5f);
+
+	FILE* f = fopen(fileSilent, "r+b");
+	std::vector<unsigned char> silent(4410, 0);
+	fseek(f, 44 + 22050 - (long)silent.size(), SEEK_SET);
+	fwrite(silent.data(), 1, silent.size(), f);
+	fclose(f);
+
+	IStream* s = cache->getStream(fileSilent);
+	TEST_ASSERT_THROW(s != NULL);
+
+	IStreamCursor* silentCursor = s->createCursor();
+	TEST_ASSERT_EQUAL(silentCursor->size(), 22050);
+	delete silentCursor;
+
+	a1->drop();
+	a2->drop();
+	a3->drop();
+	b->drop();
+	c->drop();
+	s->drop();
+
+	delete emitter1;
+	delete emitter2;
+	delete emitterLong;
+
+	engine->unRegisterStreamFactory(&factory);
+	CAudioEngine::shutdownEngine();
+
+	remove(fileA);
+	remove(fileB);
+	remove(fileC);
+	remove(fileLong);
+	remove(fileSilent);
+}
@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAudioMixer.h"
+
+#include "Driver/CDriverNull.h"
+#include "Driver/CAudioMixer.h"
+
+using namespace SkylichtAudio;
+
+void testAudioMixerConvert()
+{
+	TEST_CASE("Audio mixer convert");
+
+	// 11 samples: simd blocks & the scalar tail
+	float bus[11] = { 40000.0f, -40000.0f, 100.5f, -3.0f, 0.0f, 32767.0f, -32768.0f, 1.9f, 70000.0f, -12.0f, 5.0f };
+	short expected[11] = { 32767, -32768, 100, -3, 0, 32767, -32768, 1, 32767, -12, 5 };
+	short out[11];
+
+	CAudioMixer::convertToShort(bus, out, 11);
+
+	for (int i = 0; i < 11; i++)
+		TEST_ASSERT_EQUAL(out[i], expected[i]);
+}
+
+void testAudioMixerSincTable()
+{
+	TEST_CASE("Audio mixer sinc table");
+
+	const float* table = CAudioMixer::getSincTable();
+
+	for (int p = 0; p < CAudioMixer::SincPhases; p++)
+	{
+		float sum = 0.0f;
+		for (int k = 0; k < CAudioMixer::SincTaps; k++)
+			sum += table[p * CAudioMixer::SincTaps + k];
+
+		TEST_ASSERT_FLOAT_EQUAL(sum, 1.0f);
+	}
+
+	// phase 0 is centered at the tap SincTaps / 2 - 1
+	const float* phase0 = table;
+	for (int k = 0; k < CAudioMixer::SincTaps; k++)
+	{
+		if (k != CAudioMixer::SincTaps / 2 - 1)
+			TEST_ASSERT_THROW(phase0[k] < phase0[CAudioMixer::SincTaps / 2 - 1]);
+	}
+}
+
+void testAudioMixerSource(EResampler resampler)
+{
+	CDriverNull driver;
+	driver.setResampler(resampler);
+
+	SSourceParam sourceParam;
+	driver.getSourceParam(&sourceParam);
+
+	STrackParams trackParam;
+	trackParam.NumChannels = 1;
+	trackParam.SamplingRate = sourceParam.SamplingRate;
+	trackParam.BitsPerSample = 16;
+
+	CSoundSource* source1 = (CSoundSource*)driver.createSource();
+	CSoundSource* source2 = (CSoundSource*)driver.createSource();
+	TEST_ASSERT_THROW(source1->getResampler() == resampler);
+
+	source1->init(trackParam, sourceParam);
+	source2->init(trackParam, sourceParam);
+
+	int numSample = driver.getBufferSize();
+	int history = CAudioMixer::HistoryFrames;
+
+	// dc signal
+	std::vector<short> dc(numSample, 1000);
+	source1->uploadData(dc.data(), numSample * sizeof(short));
+	source1->setGain(0.5f);
+	source1->play();
+
+	std::vector<short> out(numSample * 2);
+	driver.fillBuffer((unsigned short*)out.data(), numSample);
+
+	// the resampler is delayed, skip the first frames
+	for (int i = history; i < numSample; i++)
+	{
+		TEST_ASSERT_EQUAL(out[i * 2], 500);
+		TEST_ASSERT_EQUAL(out[i * 2 + 1], 500);
+	}
+
+	// source 1 play at pitch 2 (the emitter upload double frames)
+	std::vector<short> ramp(numSample * 2);
+	for (int i = 0; i < numSample * 2; i++)
+		ramp[i] = (short)(i % 4096);
+
+	source1->setGain(1.0f);
+	source1->uploadData(ramp.data(), numSample * 2 * sizeof(short));
+
+	// source 2 is loud, the sum is saturated
+	std::vector<short> loud(numSample, 32760);
+	source2->uploadData(loud.data(), numSample * sizeof(short));
+	source2->play();
+
+	driver.fillBuffer((unsigned short*)out.data(), numSample);
+
+	int delay = resampler == ResampleSinc ? CAudioMixer::SincTaps / 2 : 1;
+	for (int i = history * 2; i < 64; i++)
+	{
+		TEST_ASSERT_EQUAL(out[i * 2], 32767);
+	}
+
+	source2->stop();
+	source1->uploadData(ramp.data(), numSample * 2 * sizeof(short));
+	driver.fillBuffer((unsigned short*)out.data(), numSample);
+
+	// the ramp is interpolated at (2 * i - delay)
+	for (int i = history; i < 1000; i++)
+	{
+		float expected = (float)(i * 2 - delay);
+		TEST_ASSERT_THROW(fabsf(out[i * 2] - expected) <= 1.0f);
+	}
+
+	driver.destroyAllSource();
+}
+
+void testAudioMixer()
+{
+	testAudioMixerConvert();
+	testAudioMixerSincTable();
+
+	TEST_CASE("Audio mixer linear resampler");
+	testAudioMixerSource(ResampleLinear);
+
+	TEST_CASE("Audio mixer sinc resampler");
+	testAudioMixerSource(ResampleSinc);
+}
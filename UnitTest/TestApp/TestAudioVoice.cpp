@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAudioVoice.h"
+
+#include "Driver/CDriverNull.h"
+#include "Engine/CVoiceManager.h"
+#include "Stream/CMemoryStream.h"
+
+using namespace SkylichtAudio;
+
+IStream* createTestWave(int sampleRate, float duration)
+{
+	int numSamples = (int)(sampleRate * duration);
+	int dataSize = numSamples * sizeof(short);
+	int size = 44 + dataSize;
+
+	unsigned char* wav = new unsigned char[size];
+	unsigned char* p = wav;
+
+	auto writeTag = [&](const char* tag) { memcpy(p, tag, 4); p += 4; };
+	auto writeInt = [&](int v) { memcpy(p, &v, 4); p += 4; };
+	auto writeShort = [&](short v) { memcpy(p, &v, 2); p += 2; };
+
+	writeTag("RIFF");
+	writeInt(size - 8);
+	writeTag("WAVE");
+	writeTag("fmt ");
+	writeInt(16);
+	writeShort(1);				// pcm
+	writeShort(1);				// mono
+	writeInt(sampleRate);
+	writeInt(sampleRate * 2);
+	writeShort(2);
+	writeShort(16);
+	writeTag("data");
+	writeInt(dataSize);
+
+	short* data = (short*)p;
+	for (int i = 0; i < numSamples; i++)
+		data[i] = (short)(sinf(i * 0.05f) * 10000.0f);
+
+	return new CMemoryStream(wav, size, true);
+}
+
+void testAudioVoice()
+{
+	TEST_CASE("Audio voice manager");
+
+	CDriverNull driver;
+	IStream* stream = createTestWave(22050, 1.0f);
+
+	std::vector<CAudioEmitter*> emitters;
+	for (int i = 0; i < 6; i++)
+	{
+		CAudioEmitter* emitter = new CAudioEmitter(stream, IAudioDecoder::Wav, &driver);
+
+		// distance gain: 0.9 -> 0.4, the last one is out of the roll off
+		emitter->setRollOff(10.0f);
+		emitter->setPosition(i < 5 ? (float)(i + 1) : 20.0f, 0.0f, 0.0f);
+		emitter->play();
+
+		// init the decoder
+		emitter->update();
+		TEST_ASSERT_THROW(emitter->isPlaying());
+
+		emitters.push_back(emitter);
+	}
+
+	SListener listener;
+
+	CVoiceManager manager;
+	manager.setMaxVoices(3);
+	manager.update(emitters, listener, 0.0f);
+
+	TEST_ASSERT_EQUAL(manager.getNumRealVoices(), 3);
+	TEST_ASSERT_EQUAL(manager.getNumVirtualVoices(), 3);
+	for (int i = 0; i < 6; i++)
+		TEST_ASSERT_EQUAL(emitters[i]->isVirtual(), i >= 3);
+
+	// the high priority voice take the slot of the quietest real voice
+	emitters[4]->setPriority(10.0f);
+	manager.update(emitters, listener, 0.0f);
+	TEST_ASSERT_THROW(!emitters[4]->isVirtual());
+	TEST_ASSERT_THROW(emitters[2]->isVirtual());
+	TEST_ASSERT_THROW(!emitters[0]->isVirtual());
+	TEST_ASSERT_THROW(!emitters[1]->isVirtual());
+
+	// the real bonus: a little louder voice does not steal the slot
+	emitters[2]->setPosition(1.9f, 0.0f, 0.0f);
+	manager.update(emitters, listener, 0.0f);
+	TEST_ASSERT_THROW(emitters[2]->isVirtual());
+
+	// the virtual voice does not decode but it keeps the play time
+	float time = emitters[3]->getCurrentTime();
+	emitters[3]->update();
+	TEST_ASSERT_FLOAT_EQUAL(emitters[3]->getCurrentTime(), time);
+
+	manager.update(emitters, listener, 100.0f);
+	float expected = time + 100.0f;
+	TEST_ASSERT_FLOAT_EQUAL(emitters[3]->getCurrentTime(), expected);
+	TEST_ASSERT_THROW(emitters[3]->isPlaying());
+
+	// promote the inaudible voice when it comes close
+	emitters[5]->setPosition(0.5f, 0.0f, 0.0f);
+	manager.update(emitters, listener, 100.0f);
+	TEST_ASSERT_THROW(!emitters[5]->isVirtual());
+	TEST_ASSERT_EQUAL(manager.getNumRealVoices(), 3);
+
+	// the virtual voice stops at the end of the track, the loop voice wraps the time
+	emitters[2]->setLoop(true);
+	manager.update(emitters, listener, 2500.0f);
+	TEST_ASSERT_THROW(!emitters[3]->isPlaying());
+	TEST_ASSERT_THROW(!emitters[3]->isVirtual());
+	TEST_ASSERT_THROW(emitters[2]->isPlaying());
+	TEST_ASSERT_THROW(emitters[2]->isVirtual());
+	TEST_ASSERT_THROW(emitters[2]->getCurrentTime() < 1000.0f);
+
+	for (int i = 0; i < 6; i++)
+		delete emitters[i];
+
+	TEST_CASE("Audio voice promote flush");
+
+	CAudioEmitter* emitter = new CAudioEmitter(stream, IAudioDecoder::Wav, &driver);
+	emitter->play();
+	emitter->update();
+
+	int numSample = driver.getBufferSize();
+	std::vector<short> out(numSample * 2);
+
+	// queue the decoded data to the source
+	for (int i = 0; i < 3; i++)
+	{
+		emitter->update();
+		driver.fillBuffer((unsigned short*)out.data(), numSample);
+	}
+	emitter->update();
+
+	// the data decoded before the virtual time is not played after the promotion
+	emitter->setVirtual(true);
+	emitter->skipTime(100.0f);
+	emitter->setVirtual(false);
+
+	driver.fillBuffer((unsigned short*)out.data(), numSample);
+
+	bool silent = true;
+	for (int i = 0, n = (int)out.size(); i < n; i++)
+	{
+		if (out[i] != 0)
+			silent = false;
+	}
+	TEST_ASSERT_THROW(silent);
+
+	// then it plays the data at the virtual time
+	emitter->update();
+	driver.fillBuffer((unsigned short*)out.data(), numSample);
+
+	silent = true;
+	for (int i = 0, n = (int)out.size(); i < n; i++)
+	{
+		if (out[i] != 0)
+			silent = false;
+	}
+	TEST_ASSERT_THROW(!silent);
+
+	delete emitter;
+
+	stream->drop();
+}
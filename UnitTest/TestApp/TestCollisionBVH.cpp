@@ -0,0 +1,195 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCollisionBVH.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Collision/COctreeBuilder.h"
+#include "Collision/CBVHBuilder.h"
+
+using namespace Skylicht;
+
+// the triangles in local space of the entity
+class CTestTriangleSelector : public CTriangleSelector
+{
+public:
+	CTestTriangleSelector(CEntity* entity, const core::array<core::triangle3df>& triangles) :
+		CTriangleSelector(entity)
+	{
+		m_triangles = triangles;
+	}
+
+	virtual void init()
+	{
+	}
+};
+
+static f32 randomFloat(f32 min, f32 max)
+{
+	return min + (max - min) * (rand() / (f32)RAND_MAX);
+}
+
+static void addTestBox(core::array<core::triangle3df>& triangles, const core::aabbox3df& box)
+{
+	core::vector3df e[8];
+	box.getEdges(e);
+
+	const int faces[12][3] = {
+		{0, 1, 3}, {0, 3, 2},
+		{4, 6, 7}, {4, 7, 5},
+		{0, 4, 5}, {0, 5, 1},
+		{2, 3, 7}, {2, 7, 6},
+		{0, 2, 6}, {0, 6, 4},
+		{1, 5, 7}, {1, 7, 3},
+	};
+
+	for (int i = 0; i < 12; i++)
+		triangles.push_back(core::triangle3df(e[faces[i][0]], e[faces[i][1]], e[faces[i][2]]));
+}
+
+void createTestScene(core::array<core::triangle3df>& floor, core::array<core::triangle3df>& props)
+{
+	// 16x16 floor grid
+	for (int z = 0; z < 16; z++)
+	{
+		for (int x = 0; x < 16; x++)
+		{
+			core::vector3df a((f32)x, 0.0f, (f32)z);
+			core::vector3df b((f32)x + 1.0f, 0.0f, (f32)z);
+			core::vector3df c((f32)x, 0.0f, (f32)z + 1.0f);
+			core::vector3df d((f32)x + 1.0f, 0.0f, (f32)z + 1.0f);
+			floor.push_back(core::triangle3df(a, c, b));
+			floor.push_back(core::triangle3df(b, c, d));
+		}
+	}
+
+	// boxes & random triangles
+	for (int i = 0; i < 40; i++)
+	{
+		core::vector3df p(randomFloat(0.0f, 15.0f), randomFloat(0.0f, 4.0f), randomFloat(0.0f, 15.0f));
+		core::vector3df s(randomFloat(0.2f, 2.0f), randomFloat(0.2f, 3.0f), randomFloat(0.2f, 2.0f));
+		addTestBox(props, core::aabbox3df(p, p + s));
+	}
+
+	for (int i = 0; i < 200; i++)
+	{
+		core::vector3df p(randomFloat(0.0f, 16.0f), randomFloat(0.0f, 8.0f), randomFloat(0.0f, 16.0f));
+		core::vector3df b = p + core::vector3df(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+		core::vector3df c = p + core::vector3df(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+		props.push_back(core::triangle3df(p, b, c));
+	}
+}
+
+CCollisionNode* addTestCollision(CCollisionBuilder* builder, CEntity* entity, const core::array<core::triangle3df>& triangles)
+{
+	return builder->addCollision(NULL, entity, new CTestTriangleSelector(entity, triangles));
+}
+
+void testCollisionBVH()
+{
+	TEST_CASE("Collision BVH builder");
+
+	srand(1234);
+
+	CEntityManager* mgr = new CEntityManager();
+
+	CEntity* floorEntity = mgr->createEntity();
+	floorEntity->addData<CWorldTransformData>();
+
+	// the props are moved by the world transform
+	CEntity* propEntity = mgr->createEntity();
+	CWorldTransformData* propTransform = propEntity->addData<CWorldTransformData>();
+	propTransform->World.setTranslation(core::vector3df(0.5f, 0.0f, 0.25f));
+
+	core::array<core::triangle3df> floor;
+	core::array<core::triangle3df> props;
+	createTestScene(floor, props);
+
+	COctreeBuilder* octree = new COctreeBuilder();
+	CBVHBuilder* bvh = new CBVHBuilder();
+
+	// the empty builder has no collision
+	bvh->build();
+	f32 distance = 100.0f;
+	core::vector3df hit;
+	core::triangle3df triangle;
+	CCollisionNode* node = NULL;
+	TEST_ASSERT_THROW(bvh->getCollisionPoint(core::line3df(0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f), distance, hit, triangle, node) == false);
+
+	addTestCollision(octree, floorEntity, floor);
+	addTestCollision(octree, propEntity, props);
+	addTestCollision(bvh, floorEntity, floor);
+	addTestCollision(bvh, propEntity, props);
+
+	octree->build();
+	bvh->build();
+
+	TEST_ASSERT_THROW(bvh->getNodeCount() > 0);
+	TEST_ASSERT_THROW(bvh->getPacketCount() * 4 >= floor.size() + props.size());
+
+	// ground snap at the floor corner (the ray on the box planes)
+	distance = 100.0f;
+	TEST_ASSERT_THROW(bvh->getCollisionPoint(core::line3df(0.0f, -5.0f, 0.0f, 0.0f, -10.0f, 0.0f), distance, hit, triangle, node) == false);
+
+	distance = 100.0f;
+	TEST_ASSERT_THROW(bvh->getCollisionPoint(core::line3df(0.0f, 0.001f, 0.0f, 0.0f, -1.0f, 0.0f), distance, hit, triangle, node));
+	TEST_ASSERT_THROW(hit.equals(core::vector3df(0.0f, 0.0f, 0.0f)));
+	TEST_ASSERT_THROW(node->Entity == floorEntity);
+
+	// the same nearest hit as the octree
+	int numRay = 2000;
+	int numHit = 0;
+	int numSame = 0;
+
+	for (int i = 0; i < numRay; i++)
+	{
+		core::line3df ray(
+			randomFloat(-1.0f, 17.0f), randomFloat(-1.0f, 9.0f), randomFloat(-1.0f, 17.0f),
+			randomFloat(-1.0f, 17.0f), randomFloat(-1.0f, 9.0f), randomFloat(-1.0f, 17.0f));
+
+		f32 octreeDistance = ray.getLengthSQ();
+		core::vector3df octreeHit;
+		core::triangle3df octreeTriangle;
+		CCollisionNode* octreeNode = NULL;
+		bool octreeResult = octree->getCollisionPoint(ray, octreeDistance, octreeHit, octreeTriangle, octreeNode);
+
+		f32 bvhDistance = ray.getLengthSQ();
+		core::vector3df bvhHit;
+		core::triangle3df bvhTriangle;
+		CCollisionNode* bvhNode = NULL;
+		bool bvhResult = bvh->getCollisionPoint(ray, bvhDistance, bvhHit, bvhTriangle, bvhNode);
+
+		if (bvhResult)
+			numHit++;
+
+		if (octreeResult == bvhResult &&
+			(!bvhResult || octreeHit.equals(bvhHit, 0.001f)) &&
+			bvh->hasCollision(ray) == bvhResult)
+			numSame++;
+	}
+
+	TEST_ASSERT_THROW(numHit > numRay / 4);
+	TEST_ASSERT_EQUAL(numSame, numRay);
+
+	// the same triangles in the box
+	for (int i = 0; i < 20; i++)
+	{
+		core::vector3df p(randomFloat(0.0f, 16.0f), randomFloat(0.0f, 8.0f), randomFloat(0.0f, 16.0f));
+		core::aabbox3df box(p, p + core::vector3df(2.0f, 2.0f, 2.0f));
+
+		core::array<core::triangle3df*> octreeTriangles;
+		core::array<CCollisionNode*> octreeNodes;
+		octree->getTriangles(box, octreeTriangles, octreeNodes);
+
+		core::array<core::triangle3df*> bvhTriangles;
+		core::array<CCollisionNode*> bvhNodes;
+		bvh->getTriangles(box, bvhTriangles, bvhNodes);
+
+		TEST_ASSERT_EQUAL(bvhTriangles.size(), octreeTriangles.size());
+		TEST_ASSERT_EQUAL(bvhNodes.size(), bvhTriangles.size());
+	}
+
+	delete octree;
+	delete bvh;
+	delete mgr;
+}
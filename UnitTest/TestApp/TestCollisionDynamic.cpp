@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCollisionDynamic.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Collision/COctreeBuilder.h"
+#include "Collision/CBVHBuilder.h"
+
+using namespace Skylicht;
+
+// see TestCollisionBVH.cpp
+void createTestScene(core::array<core::triangle3df>& floor, core::array<core::triangle3df>& props);
+CCollisionNode* addTestCollision(CCollisionBuilder* builder, CEntity* entity, const core::array<core::triangle3df>& triangles);
+
+// the nearest hits are the same as the collision that is built again
+static bool compareCollision(CCollisionBuilder* builder, CCollisionBuilder* rebuild)
+{
+	rebuild->build();
+
+	srand(100);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		// the rays do not start or end on the floor plane
+		core::line3df ray(
+			rand() % 1800 / 100.0f - 1.0f, rand() % 1000 / 100.0f - 0.995f, rand() % 1800 / 100.0f - 1.0f,
+			rand() % 1800 / 100.0f - 1.0f, rand() % 1000 / 100.0f - 0.995f, rand() % 1800 / 100.0f - 1.0f);
+
+		f32 distance1 = ray.getLengthSQ();
+		f32 distance2 = ray.getLengthSQ();
+		core::vector3df hit1, hit2;
+		core::triangle3df triangle;
+		CCollisionNode* node1 = NULL;
+		CCollisionNode* node2 = NULL;
+
+		bool found1 = builder->getCollisionPoint(ray, distance1, hit1, triangle, node1);
+		bool found2 = rebuild->getCollisionPoint(ray, distance2, hit2, triangle, node2);
+
+		if (found1 != found2)
+			return false;
+
+		if (found1 && (!hit1.equals(hit2, 0.001f) || node1->Entity != node2->Entity))
+			return false;
+	}
+
+	return true;
+}
+
+void testCollisionDynamic()
+{
+	TEST_CASE("Collision dynamic update");
+
+	srand(2024);
+
+	CEntityManager* mgr = new CEntityManager();
+
+	CEntity* floorEntity = mgr->createEntity();
+	floorEntity->addData<CWorldTransformData>();
+
+	CEntity* propEntity = mgr->createEntity();
+	CWorldTransformData* propTransform = propEntity->addData<CWorldTransformData>();
+
+	core::array<core::triangle3df> floor;
+	core::array<core::triangle3df> props;
+	createTestScene(floor, props);
+
+	COctreeBuilder* octree = new COctreeBuilder();
+	addTestCollision(octree, floorEntity, floor);
+	octree->build();
+
+	// insert: the props are streamed after build
+	COctreeBuilder* rebuild = new COctreeBuilder();
+	addTestCollision(rebuild, floorEntity, floor);
+	addTestCollision(rebuild, propEntity, props);
+
+	CCollisionNode* prop = addTestCollision(octree, propEntity, props);
+	octree->insertCollision(prop);
+	TEST_ASSERT_THROW(compareCollision(octree, rebuild));
+
+	// update: the props is moved
+	propTransform->World.setTranslation(core::vector3df(2.0f, 0.5f, -1.0f));
+	octree->updateCollision(prop);
+	TEST_ASSERT_THROW(compareCollision(octree, rebuild));
+
+	propTransform->World.setTranslation(core::vector3df(-30.0f, 0.0f, 0.0f));
+	octree->updateCollision(prop);
+	TEST_ASSERT_THROW(compareCollision(octree, rebuild));
+
+	// the props are out of the root bounds: the root is split again on the new bounds
+	TEST_ASSERT_THROW(octree->getRoot()->OctreeBox.MinEdge.X <= -29.9f);
+	TEST_ASSERT_THROW(octree->getRoot()->Triangles.size() < props.size() / 2);
+
+	// remove: only the floor
+	COctreeBuilder* floorOnly = new COctreeBuilder();
+	addTestCollision(floorOnly, floorEntity, floor);
+
+	propTransform->World.setTranslation(core::vector3df(0.0f, 0.0f, 0.0f));
+	octree->updateCollision(prop);
+	octree->removeCollision(&prop, 1);
+	TEST_ASSERT_THROW(prop == NULL);
+	TEST_ASSERT_THROW(compareCollision(octree, floorOnly));
+
+	// the bbox is shrunk to the floor
+	TEST_ASSERT_THROW(octree->getRoot()->Box.MinEdge.equals(floorOnly->getRoot()->Box.MinEdge));
+	TEST_ASSERT_THROW(octree->getRoot()->Box.MaxEdge.equals(floorOnly->getRoot()->Box.MaxEdge));
+
+	// the bvh removes the triangles of node without build
+	CBVHBuilder* bvh = new CBVHBuilder();
+	addTestCollision(bvh, floorEntity, floor);
+	CCollisionNode* bvhProp = addTestCollision(bvh, propEntity, props);
+	bvh->build();
+	TEST_ASSERT_THROW(compareCollision(bvh, rebuild));
+
+	bvh->removeCollision(&bvhProp, 1);
+	TEST_ASSERT_THROW(compareCollision(bvh, floorOnly));
+
+	delete octree;
+	delete rebuild;
+	delete floorOnly;
+	delete bvh;
+	delete mgr;
+}
@@ -0,0 +1,138 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCollisionQuery.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Collision/COctreeBuilder.h"
+#include "Collision/CBVHBuilder.h"
+#include "Job/CJobSystem.h"
+
+using namespace Skylicht;
+
+// see TestCollisionBVH.cpp
+void createTestScene(core::array<core::triangle3df>& floor, core::array<core::triangle3df>& props);
+CCollisionNode* addTestCollision(CCollisionBuilder* builder, CEntity* entity, const core::array<core::triangle3df>& triangles);
+
+static bool testBatchQuery(CCollisionBuilder* builder, const core::array<core::line3df>& rays, const core::array<core::aabbox3df>& boxes)
+{
+	u32 numRay = rays.size();
+	u32 numBox = boxes.size();
+
+	// the batched results on the workers
+	core::array<SCollisionHit> hits;
+	hits.set_used(numRay);
+	u32 numHit = builder->getCollisionPoints(rays.const_pointer(), numRay, hits.pointer());
+
+	bool* sight = new bool[numRay];
+	u32 numSightHit = builder->hasCollisions(rays.const_pointer(), numRay, sight);
+
+	SCollisionOverlap overlap;
+	builder->getTrianglesInBoxes(boxes.const_pointer(), numBox, overlap);
+
+	bool result = numHit > 0 && numHit == numSightHit;
+
+	// same as the single queries
+	for (u32 i = 0; i < numRay; i++)
+	{
+		f32 distance = rays[i].getLengthSQ();
+		core::vector3df hit;
+		core::triangle3df triangle;
+		CCollisionNode* node = NULL;
+		bool found = builder->getCollisionPoint(rays[i], distance, hit, triangle, node);
+
+		if (found != (hits[i].Node != NULL) || found != sight[i])
+			result = false;
+		else if (found && (hits[i].Node != node || !hits[i].Intersection.equals(hit) || hits[i].DistanceSquared != distance))
+			result = false;
+	}
+
+	if (overlap.Offsets.size() != numBox + 1 || overlap.Triangles.size() != overlap.Nodes.size())
+		result = false;
+
+	for (u32 i = 0; i < numBox && result; i++)
+	{
+		core::array<core::triangle3df*> triangles;
+		core::array<CCollisionNode*> nodes;
+		builder->getTriangles(boxes[i], triangles, nodes);
+
+		u32 begin = overlap.Offsets[i];
+		u32 end = overlap.Offsets[i + 1];
+
+		if (end - begin != triangles.size())
+		{
+			result = false;
+			break;
+		}
+
+		for (u32 j = 0; j < triangles.size(); j++)
+		{
+			if (overlap.Triangles[begin + j] != triangles[j] || overlap.Nodes[begin + j] != nodes[j])
+				result = false;
+		}
+	}
+
+	delete[] sight;
+	return result;
+}
+
+void testCollisionQuery()
+{
+	TEST_CASE("Collision batched query");
+
+	// use workers for test the parallel query on single core device
+	SkylichtSystem::CJobSystem::releaseInstance();
+	SkylichtSystem::CJobSystem::createInstance(2);
+
+	srand(4321);
+
+	CEntityManager* mgr = new CEntityManager();
+	CEntity* entity = mgr->createEntity();
+	entity->addData<CWorldTransformData>();
+
+	core::array<core::triangle3df> floor;
+	core::array<core::triangle3df> props;
+	createTestScene(floor, props);
+
+	COctreeBuilder* octree = new COctreeBuilder();
+	CBVHBuilder* bvh = new CBVHBuilder();
+
+	addTestCollision(octree, entity, floor);
+	addTestCollision(octree, entity, props);
+	addTestCollision(bvh, entity, floor);
+	addTestCollision(bvh, entity, props);
+
+	octree->build();
+	bvh->build();
+
+	core::array<core::line3df> rays;
+	for (int i = 0; i < 1000; i++)
+	{
+		core::vector3df a(rand() % 1700 / 100.0f, rand() % 900 / 100.0f, rand() % 1700 / 100.0f);
+		core::vector3df b(rand() % 1700 / 100.0f, rand() % 900 / 100.0f, rand() % 1700 / 100.0f);
+		rays.push_back(core::line3df(a, b));
+	}
+
+	core::array<core::aabbox3df> boxes;
+	for (int i = 0; i < 200; i++)
+	{
+		core::vector3df p(rand() % 1600 / 100.0f, rand() % 800 / 100.0f, rand() % 1600 / 100.0f);
+		boxes.push_back(core::aabbox3df(p, p + core::vector3df(1.5f, 1.5f, 1.5f)));
+	}
+
+	TEST_ASSERT_THROW(testBatchQuery(octree, rays, boxes));
+	TEST_ASSERT_THROW(testBatchQuery(bvh, rays, boxes));
+
+	// empty batch
+	SCollisionOverlap overlap;
+	bvh->getTrianglesInBoxes(NULL, 0, overlap);
+	TEST_ASSERT_EQUAL(overlap.Offsets.size(), 1);
+	TEST_ASSERT_EQUAL(overlap.Triangles.size(), 0);
+
+	delete octree;
+	delete bvh;
+	delete mgr;
+
+	SkylichtSystem::CJobSystem::releaseInstance();
+	SkylichtSystem::CJobSystem::createInstance();
+}
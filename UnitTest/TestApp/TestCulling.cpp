@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCulling.h"
+
+#include "Culling/CCullingBoxes.h"
+#include "Culling/CCullingBVH.h"
+#include "Culling/CCullingSystem.h"
+#include "Culling/CCullingBBoxData.h"
+#include "Culling/CVisibleData.h"
+#include "Entity/CEntityManager.h"
+
+using namespace Skylicht;
+
+static bool isBoxInFrustum(const SViewFrustum& frustum, const core::aabbox3df& box, const core::matrix4& world)
+{
+	// reference test: transform the frustum to local space, see CCullingSystem
+	core::matrix4 invWorld;
+	world.getInverse(invWorld);
+
+	SViewFrustum frust = frustum;
+	frust.transform(invWorld);
+
+	core::vector3df edges[8];
+	box.getEdges(edges);
+
+	for (s32 i = 0; i < SViewFrustum::VF_PLANE_COUNT; ++i)
+	{
+		bool boxInFrustum = false;
+		for (u32 j = 0; j < 8; ++j)
+		{
+			if (frust.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
+			{
+				boxInFrustum = true;
+				break;
+			}
+		}
+
+		if (!boxInFrustum)
+			return false;
+	}
+	return true;
+}
+
+void testCulling()
+{
+	TEST_CASE("Culling boxes SIMD");
+
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 16.0f / 9.0f, 0.1f, 200.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(0.0f, 5.0f, -20.0f), core::vector3df(0.0f, 0.0f, 0.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	SViewFrustum frustum(proj * view);
+	const core::aabbox3df& frustumBox = frustum.getBoundingBox();
+
+	CCullingBoxes boxes;
+	core::array<core::aabbox3df> worldBoxes;
+	core::array<bool> expected;
+
+	// 1001 boxes: test the simd and the remain scalar boxes
+	const int count = 1001;
+	for (int i = 0; i < count; i++)
+	{
+		core::aabbox3df box(-1.0f, -0.5f, -2.0f, 1.0f, 0.5f, 2.0f);
+
+		core::matrix4 world;
+		world.setRotationDegrees(core::vector3df((f32)(i * 7 % 360), (f32)(i * 13 % 360), 0.0f));
+		world.setTranslation(core::vector3df(
+			(f32)(i % 41) * 4.0f - 80.0f,
+			(f32)(i % 7) * 4.0f - 12.0f,
+			(f32)(i % 23) * 10.0f - 40.0f));
+
+		bool testFrustum = (i % 3) != 0;
+
+		core::aabbox3df worldBox;
+		boxes.add(box, world, testFrustum, worldBox);
+		worldBoxes.push_back(worldBox);
+
+		core::aabbox3df refBox = box;
+		world.transformBoxEx(refBox);
+
+		bool visible = refBox.intersectsWithBox(frustumBox);
+		if (visible && testFrustum)
+			visible = isBoxInFrustum(frustum, box, world);
+		expected.push_back(visible);
+	}
+
+	TEST_ASSERT_EQUAL(boxes.count(), count);
+
+	core::array<u8> result;
+	result.set_used(count);
+	boxes.cull(frustumBox, &frustum, result.pointer(), 0, count);
+
+	int numVisible = 0;
+	int numError = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if ((result[i] != 0) != expected[i])
+			numError++;
+		if (result[i])
+			numVisible++;
+	}
+
+	TEST_ASSERT_EQUAL(numError, 0);
+	TEST_ASSERT_THROW(numVisible > 0 && numVisible < count);
+
+	TEST_CASE("Culling boxes split range");
+	core::array<u8> result2;
+	result2.set_used(count);
+	boxes.cull(frustumBox, &frustum, result2.pointer(), 0, 500);
+	boxes.cull(frustumBox, &frustum, result2.pointer(), 500, count);
+
+	numError = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if (result2[i] != result[i])
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	TEST_CASE("Culling BVH query");
+	CCullingBVH tree;
+	core::array<int> owners;
+	core::array<int> proxies;
+	owners.set_used(count);
+
+	for (int i = 0; i < count; i++)
+		proxies.push_back(tree.createProxy(worldBoxes[i], worldBoxes[i], &owners[i], i));
+
+	TEST_ASSERT_EQUAL(tree.getProxyCount(), count);
+	TEST_ASSERT_THROW(tree.getHeight() < 32);
+
+	// the tree result must contain all visible boxes
+	// note: the tree also tests the frustum planes on the boxes that only need the bbox test
+	CFastArray<int> treeResult;
+	tree.query(frustumBox, &frustum, treeResult);
+
+	core::array<u8> inTree;
+	inTree.set_used(count);
+	memset(inTree.pointer(), 0, count);
+	for (int i = 0; i < treeResult.count(); i++)
+		inTree[treeResult.pointer()[i]] = 1;
+
+	numError = 0;
+	for (int i = 0; i < count; i++)
+	{
+		bool testFrustum = (i % 3) != 0;
+		if (testFrustum && result[i] && !inTree[i])
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+	TEST_ASSERT_THROW(treeResult.count() < count);
+
+	TEST_CASE("Culling BVH move and remove");
+	core::aabbox3df farBox(1000.0f, 1000.0f, 1000.0f, 1001.0f, 1001.0f, 1001.0f);
+	numError = 0;
+	for (int i = 0; i < count; i += 2)
+	{
+		if (!tree.isProxyOf(proxies[i], &owners[i]))
+			numError++;
+		tree.moveProxy(proxies[i], farBox, farBox);
+		tree.setTag(proxies[i], 1);
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	treeResult.reset();
+	tree.query(farBox, NULL, treeResult);
+	TEST_ASSERT_EQUAL(treeResult.count(), (count + 1) / 2);
+
+	TEST_ASSERT_EQUAL(tree.destroyProxies(1), count / 2);
+	TEST_ASSERT_EQUAL(tree.getProxyCount(), (count + 1) / 2);
+	TEST_ASSERT_THROW(!tree.isProxyOf(proxies[1], &owners[1]));
+
+	treeResult.reset();
+	tree.query(frustumBox, &frustum, treeResult);
+	TEST_ASSERT_EQUAL(treeResult.count(), 0);
+
+	TEST_CASE("Culling tree moved between renders");
+	CEntityManager* mgr = new CEntityManager();
+	CCullingSystem* cullingSystem = mgr->addRenderSystem<CCullingSystem>();
+
+	CEntity* entity = mgr->createEntity();
+	entity->addData<CVisibleData>();
+	entity->addData<CCullingData>();
+	CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+	CCullingBBoxData* bboxData = entity->addData<CCullingBBoxData>();
+	bboxData->BBox = core::aabbox3df(-1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f);
+
+	mgr->update();
+	cullingSystem->beginQuery(mgr);
+	cullingSystem->onQuery(mgr, NULL, 0);
+
+	// 2 updates before the next render (ex: fixed step), the 2nd update resets NeedValidate
+	transform->Relative.setTranslation(core::vector3df(100.0f, 0.0f, 0.0f));
+	transform->HasChanged = true;
+	mgr->update();
+	mgr->update();
+	TEST_ASSERT_THROW(transform->NeedValidate == false);
+
+	cullingSystem->beginQuery(mgr);
+	cullingSystem->onQuery(mgr, NULL, 0);
+
+	CCullingData* cullingData = GET_ENTITY_DATA(entity, CCullingData);
+	TEST_ASSERT_THROW(cullingData->BBox.getCenter().equals(core::vector3df(100.0f, 0.0f, 0.0f)));
+
+	delete mgr;
+}
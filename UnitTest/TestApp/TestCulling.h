@@ -0,0 +1,3 @@
+#pragma once
+
+void testCulling();
\ No newline at end of file
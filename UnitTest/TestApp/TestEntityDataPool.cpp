@@ -0,0 +1,101 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestEntityDataPool.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Culling/CCullingData.h"
+
+using namespace Skylicht;
+
+void testEntityDataPool()
+{
+	CEntityManager* mgr = new CEntityManager();
+
+	TEST_CASE("Entity data pool mode");
+	mgr->setDataPoolMode(true);
+	TEST_ASSERT_THROW(mgr->isDataPoolMode());
+
+	core::array<CEntity*> entities;
+	mgr->createEntity(10, entities);
+
+	for (u32 i = 0; i < entities.size(); i++)
+	{
+		CWorldTransformData* transform = entities[i]->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		if (i % 2 == 0)
+			entities[i]->addData<CCullingData>();
+	}
+
+	TEST_CASE("Entity data pool");
+	CEntityDataPool* pool = mgr->getDataPool(DATA_TYPE_INDEX(CWorldTransformData), 0);
+	TEST_ASSERT_THROW(pool != NULL);
+	TEST_ASSERT_EQUAL(pool->getAllocCount(), 10);
+
+	CWorldTransformData* transform = GET_ENTITY_DATA(entities[3], CWorldTransformData);
+	TEST_ASSERT_THROW(transform != NULL);
+	TEST_ASSERT_FLOAT_EQUAL(transform->Relative.getTranslation().X, 3.0f);
+
+	const u32 type[] = GET_LIST_ENTITY_DATA(CCullingData);
+	CEntityGroup* group = mgr->createGroup(type, 1);
+
+	mgr->update();
+
+	TEST_CASE("Entity mask group query");
+	TEST_ASSERT_EQUAL(group->getEntityCount(), 5);
+
+	int numMaskGroup = 0;
+	core::array<CEntityMaskGroup*>& maskGroups = mgr->getMaskGroups();
+	for (u32 i = 0; i < maskGroups.size(); i++)
+	{
+		if (maskGroups[i]->getEntityCount() > 0)
+			numMaskGroup++;
+	}
+	TEST_ASSERT_EQUAL(numMaskGroup, 2);
+
+	TEST_CASE("Entity mask group remove data");
+	TEST_ASSERT_THROW(entities[0]->removeData<CCullingData>());
+	TEST_ASSERT_THROW(GET_ENTITY_DATA(entities[0], CCullingData) == NULL);
+
+	mgr->update();
+	TEST_ASSERT_EQUAL(group->getEntityCount(), 4);
+
+	mgr->removeEntity(entities[1]);
+	TEST_ASSERT_EQUAL(pool->getAllocCount(), 9);
+
+	TEST_CASE("Entity mask group depth order");
+
+	// the children are in the first mask group, the parents at depth 0 are in both mask groups
+	core::array<CEntity*> children;
+	mgr->createEntity(4, children);
+
+	for (u32 i = 0; i < children.size(); i++)
+	{
+		CWorldTransformData* child = children[i]->addData<CWorldTransformData>();
+		child->Depth = 1;
+		child->ParentIndex = entities[2 + i]->getIndex();
+	}
+
+	const u32 transformType[] = GET_LIST_ENTITY_DATA(CWorldTransformData);
+	CEntityGroup* transformGroup = mgr->createGroup(transformType, 1);
+
+	mgr->notifyUpdateSortEntities();
+	mgr->update();
+
+	CEntity** groupEntities = transformGroup->getEntities();
+	int numGroupEntity = transformGroup->getEntityCount();
+	TEST_ASSERT_EQUAL(numGroupEntity, 13);
+
+	bool depthOrder = true;
+	for (int i = 1; i < numGroupEntity; i++)
+	{
+		CWorldTransformData* a = GET_ENTITY_DATA(groupEntities[i - 1], CWorldTransformData);
+		CWorldTransformData* b = GET_ENTITY_DATA(groupEntities[i], CWorldTransformData);
+		if (a->Depth > b->Depth)
+			depthOrder = false;
+	}
+	TEST_ASSERT_THROW(depthOrder);
+
+	delete mgr;
+}
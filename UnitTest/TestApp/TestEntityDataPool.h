@@ -0,0 +1,3 @@
+#pragma once
+
+void testEntityDataPool();
\ No newline at end of file
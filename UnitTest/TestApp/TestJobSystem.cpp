@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestJobSystem.h"
+
+#include "Job/CJobSystem.h"
+
+#include <thread>
+
+using namespace SkylichtSystem;
+
+void testJobSystem()
+{
+	// force 2 workers for test the stealing on single core device
+	CJobSystem* jobSystem = new CJobSystem(2);
+
+	TEST_CASE("Job system run");
+	std::atomic<int> counter(0);
+	CJobGroup group;
+	for (int i = 0; i < 100; i++)
+	{
+		jobSystem->run(&group, [&counter]()
+			{
+				counter++;
+			});
+	}
+	jobSystem->wait(&group);
+	TEST_ASSERT_THROW(group.isDone());
+	TEST_ASSERT_EQUAL(counter.load(), 100);
+
+	TEST_CASE("Job system parallel for");
+	const int count = 10000;
+	std::vector<int> values(count, 0);
+	jobSystem->parallelFor(count, 0, [&values](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+				values[i] = i;
+		});
+
+	long long sum = 0;
+	for (int i = 0; i < count; i++)
+		sum += values[i];
+	TEST_ASSERT_THROW(sum == (long long)count * (count - 1) / 2);
+
+	TEST_CASE("Job system nested wait");
+	std::atomic<int> nested(0);
+	CJobGroup outer;
+	for (int i = 0; i < 4; i++)
+	{
+		jobSystem->run(&outer, [jobSystem, &nested]()
+			{
+				jobSystem->parallelFor(100, 10, [&nested](int begin, int end)
+					{
+						nested += end - begin;
+					});
+			});
+	}
+	jobSystem->wait(&outer);
+	TEST_ASSERT_EQUAL(nested.load(), 400);
+
+	TEST_CASE("Job system external thread");
+	std::atomic<int> external(0);
+	std::thread thread([jobSystem, &external]()
+		{
+			for (int n = 0; n < 10; n++)
+			{
+				CJobGroup externalGroup;
+				for (int i = 0; i < 50; i++)
+				{
+					jobSystem->run(&externalGroup, [&external]()
+						{
+							external++;
+						});
+				}
+				jobSystem->wait(&externalGroup);
+			}
+		});
+
+	std::atomic<int> mainCounter(0);
+	for (int n = 0; n < 10; n++)
+	{
+		jobSystem->parallelFor(500, 10, [&mainCounter](int begin, int end)
+			{
+				mainCounter += end - begin;
+			});
+	}
+
+	thread.join();
+	TEST_ASSERT_EQUAL(external.load(), 500);
+	TEST_ASSERT_EQUAL(mainCounter.load(), 5000);
+
+	delete jobSystem;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testJobSystem();
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestLightmapper.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Collision/CBVHBuilder.h"
+#include "Lightmapper/CLightmapper.h"
+#include "Job/CJobSystem.h"
+
+using namespace Skylicht;
+using namespace Skylicht::Lightmapper;
+
+// see TestCollisionBVH.cpp
+void createTestScene(core::array<core::triangle3df>& floor, core::array<core::triangle3df>& props);
+CCollisionNode* addTestCollision(CCollisionBuilder* builder, CEntity* entity, const core::array<core::triangle3df>& triangles);
+
+static void addTestPlane(core::array<core::triangle3df>& triangles, f32 y, f32 size)
+{
+	core::vector3df a(-size, y, -size);
+	core::vector3df b(size, y, -size);
+	core::vector3df c(-size, y, size);
+	core::vector3df d(size, y, size);
+	triangles.push_back(core::triangle3df(a, c, b));
+	triangles.push_back(core::triangle3df(b, c, d));
+}
+
+static void getIrradiance(CCPUBaker* baker, f32& up, f32& down)
+{
+	core::vector3df position(0.0f, 1.0f, 0.0f);
+	core::vector3df normal = Transform::Oy;
+	core::vector3df tangent = Transform::Ox;
+	core::vector3df binormal = normal.crossProduct(tangent);
+
+	CSH9 sh;
+	baker->bake(&position, &normal, &tangent, &binormal, &sh, 1);
+
+	core::vector3df color;
+	sh.getSHIrradiance(Transform::Oy, color);
+	up = color.Y;
+
+	sh.getSHIrradiance(-Transform::Oy, color);
+	down = color.Y;
+}
+
+void testLightmapper()
+{
+	TEST_CASE("Lightmapper CPU baker");
+
+	CEntityManager* mgr = new CEntityManager();
+
+	CEntity* entity = mgr->createEntity();
+	entity->addData<CWorldTransformData>();
+
+	core::array<core::triangle3df> floor;
+	addTestPlane(floor, 0.0f, 500.0f);
+
+	core::array<core::triangle3df> roof;
+	addTestPlane(roof, 5.0f, 500.0f);
+
+	CBVHBuilder* floorScene = new CBVHBuilder();
+	addTestCollision(floorScene, entity, floor);
+	floorScene->build();
+
+	CBVHBuilder* roofScene = new CBVHBuilder();
+	addTestCollision(roofScene, entity, floor);
+	addTestCollision(roofScene, entity, roof);
+	roofScene->build();
+
+	CCPUBaker* baker = new CCPUBaker(floorScene);
+
+	f32 up, down;
+	f32 e = 0.1f;
+
+	// the sky on the upper hemisphere, the black floor on the lower
+	baker->setSkyColor(SColorf(1.0f, 1.0f, 1.0f));
+	baker->setDefaultAlbedo(SColorf(0.0f, 0.0f, 0.0f));
+	getIrradiance(baker, up, down);
+	TEST_ASSERT_THROW(fabsf(up - core::PI) < e);
+	TEST_ASSERT_THROW(fabsf(down) < e);
+
+	// the floor is lit by sun
+	baker->setSkyColor(SColorf(0.0f, 0.0f, 0.0f));
+	baker->setDefaultAlbedo(SColorf(0.5f, 0.5f, 0.5f));
+	baker->addDirectionalLight(core::vector3df(0.0f, -1.0f, 0.0f), SColorf(1.0f, 1.0f, 1.0f));
+	getIrradiance(baker, up, down);
+	TEST_ASSERT_THROW(fabsf(up) < e);
+	TEST_ASSERT_THROW(fabsf(down - 0.5f * core::PI) < e);
+
+	// the roof cast shadow on the floor
+	baker->setCollision(roofScene);
+	getIrradiance(baker, up, down);
+	TEST_ASSERT_THROW(fabsf(down) < e);
+
+	// the floor reflects the sky on the 2nd bounce
+	baker->setCollision(floorScene);
+	baker->clearLights();
+	baker->setSkyColor(SColorf(1.0f, 1.0f, 1.0f));
+	getIrradiance(baker, up, down);
+	TEST_ASSERT_THROW(fabsf(down) < e);
+
+	baker->setNumBounce(2);
+	getIrradiance(baker, up, down);
+	TEST_ASSERT_THROW(fabsf(up - core::PI) < e);
+	TEST_ASSERT_THROW(fabsf(down - 0.5f * core::PI) < e);
+
+	// the result on multi thread is the same
+	core::array<core::triangle3df> props;
+	floor.set_used(0);
+	createTestScene(floor, props);
+
+	CBVHBuilder* scene = new CBVHBuilder();
+	addTestCollision(scene, entity, floor);
+	addTestCollision(scene, entity, props);
+	scene->build();
+
+	baker->setCollision(scene);
+	baker->setSampleSize(8);
+	baker->addDirectionalLight(core::vector3df(-1.0f, -2.0f, -1.0f), SColorf(1.0f, 1.0f, 1.0f));
+	baker->addPointLight(core::vector3df(8.0f, 2.0f, 8.0f), SColorf(1.0f, 0.5f, 0.2f), 2.0f, 6.0f);
+
+	const int count = 32;
+	std::vector<core::vector3df> positions;
+	std::vector<core::vector3df> normals;
+	std::vector<core::vector3df> tangents;
+	std::vector<core::vector3df> binormals;
+	for (int i = 0; i < count; i++)
+	{
+		positions.push_back(core::vector3df((i % 8) * 2.0f + 0.5f, 0.5f + (i / 8) * 1.5f, (i % 5) * 3.0f + 0.5f));
+		normals.push_back(Transform::Oy);
+		tangents.push_back(Transform::Ox);
+		binormals.push_back(Transform::Oy.crossProduct(Transform::Ox));
+	}
+
+	SkylichtSystem::CJobSystem::releaseInstance();
+	SkylichtSystem::CJobSystem::createInstance(2);
+
+	std::vector<CSH9> serial(count);
+	std::vector<CSH9> parallel(count);
+	baker->bake(positions.data(), normals.data(), tangents.data(), binormals.data(), serial.data(), count, NUM_FACES, false);
+	baker->bake(positions.data(), normals.data(), tangents.data(), binormals.data(), parallel.data(), count, NUM_FACES, true);
+
+	bool same = true;
+	for (int i = 0; i < count; i++)
+	{
+		if (memcmp(serial[i].getValueConst(), parallel[i].getValueConst(), sizeof(core::vector3df) * 9) != 0)
+			same = false;
+	}
+	TEST_ASSERT_THROW(same);
+
+	// the noise of a position does not depend on its index in the batch
+	bool sameSingle = true;
+	for (int i = 0; i < count; i++)
+	{
+		CSH9 single;
+		baker->bake(&positions[i], &normals[i], &tangents[i], &binormals[i], &single, 1, NUM_FACES, false);
+		if (memcmp(serial[i].getValueConst(), single.getValueConst(), sizeof(core::vector3df) * 9) != 0)
+			sameSingle = false;
+	}
+	TEST_ASSERT_THROW(sameSingle);
+
+	// CLightmapper bake on the CPU baker without camera & render pipeline
+	CLightmapper::createGetInstance();
+	CLightmapper* lightmapper = CLightmapper::getInstance();
+	lightmapper->initCPUBaker(scene, 8);
+
+	CCPUBaker* lmBaker = lightmapper->getCPUBaker();
+	lmBaker->setNumBounce(2);
+	lmBaker->setSkyColor(SColorf(1.0f, 1.0f, 1.0f));
+	lmBaker->addDirectionalLight(core::vector3df(-1.0f, -2.0f, -1.0f), SColorf(1.0f, 1.0f, 1.0f));
+	lmBaker->addPointLight(core::vector3df(8.0f, 2.0f, 8.0f), SColorf(1.0f, 0.5f, 0.2f), 2.0f, 6.0f);
+
+	std::vector<CSH9> probes;
+	lightmapper->bakeProbes(positions, probes, NULL, NULL, NULL);
+	TEST_ASSERT_EQUAL((int)probes.size(), count);
+
+	same = true;
+	for (int i = 0; i < count; i++)
+	{
+		if (memcmp(serial[i].getValueConst(), probes[i].getValueConst(), sizeof(core::vector3df) * 9) != 0)
+			same = false;
+	}
+	TEST_ASSERT_THROW(same);
+
+	// bake the lightmap of a mesh buffer with the tiled rasterisation
+	video::IVertexDescriptor* vertexDes = getVideoDriver()->getVertexDescriptor(video::EVT_2TCOORDS_TANGENTS);
+	CMeshBuffer<video::S3DVertex2TCoordsTangents>* mb = new CMeshBuffer<video::S3DVertex2TCoordsTangents>(vertexDes, video::EIT_16BIT);
+
+	for (int i = 0; i < 4; i++)
+	{
+		video::S3DVertex2TCoordsTangents v;
+		f32 x = (f32)(i % 2);
+		f32 z = (f32)(i / 2);
+		v.Pos.set(x * 10.0f, 0.5f, z * 10.0f);
+		v.Normal = Transform::Oy;
+		v.Tangent = Transform::Ox;
+		v.Binormal = Transform::Oz;
+		v.Lightmap.set(0.1f + x * 0.8f, 0.1f + z * 0.8f, 0.0f);
+		mb->getVertexBuffer(0)->addVertex(&v);
+	}
+
+	u32 quad[] = { 0, 2, 1, 1, 2, 3 };
+	for (int i = 0; i < 6; i++)
+		mb->getIndexBuffer()->addIndex(quad[i]);
+
+	CRasterisation* raster = new CRasterisation(64, 64);
+	int numBaked = 0;
+	for (int pass = 0; pass < (int)CRasterisation::PassCount; pass++)
+		numBaked += lightmapper->bakeLightmapMeshBuffer(mb, core::IdentityMatrix, &raster, 1, (CRasterisation::ERasterPass)pass, NULL, NULL, NULL);
+	TEST_ASSERT_THROW(numBaked > 0);
+
+	// bake the queued pixels in many small steps (see CViewBakeLightmap), the lightmap is the same
+	CRasterisation* stepRaster = new CRasterisation(64, 64);
+	int numStepBaked = 0;
+	for (int pass = 0; pass < (int)CRasterisation::PassCount; pass++)
+	{
+		lightmapper->rasteriseLightmapMeshBuffer(mb, core::IdentityMatrix, &stepRaster, 1, (CRasterisation::ERasterPass)pass);
+		while (stepRaster->getBakePixelQueue().size() > 0)
+		{
+			int n = lightmapper->bakeLightmapPixels(stepRaster, 7, NULL, NULL, NULL);
+			TEST_ASSERT_THROW(n > 0 && n <= 7);
+			numStepBaked += n;
+		}
+	}
+	TEST_ASSERT_EQUAL(numStepBaked, numBaked);
+	TEST_ASSERT_THROW(memcmp(stepRaster->getLightmapData(), raster->getLightmapData(), 64 * 64 * 3) == 0);
+
+	delete stepRaster;
+	delete raster;
+	mb->drop();
+
+	CLightmapper::releaseInstance();
+
+	SkylichtSystem::CJobSystem::releaseInstance();
+	SkylichtSystem::CJobSystem::createInstance();
+
+	delete baker;
+	delete floorScene;
+	delete roofScene;
+	delete scene;
+	delete mgr;
+}
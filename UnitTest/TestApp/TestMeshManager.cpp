@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestMeshManager.h"
+
+#include "MeshManager/CMeshManager.h"
+#include "TextureManager/CTextureManager.h"
+#include "RenderMesh/CRenderMeshData.h"
+
+#include <thread>
+#include <atomic>
+
+using namespace Skylicht;
+
+void writeTestFile(const char* path, const char* data)
+{
+	FILE* f = fopen(path, "wt");
+	fputs(data, f);
+	fclose(f);
+}
+
+void writeTestImage(const char* path)
+{
+	IVideoDriver* driver = getVideoDriver();
+	IImage* image = driver->createImage(video::ECF_A8R8G8B8, core::dimension2du(4, 4));
+	image->fill(SColor(255, 255, 0, 0));
+	driver->writeImageToFile(image, path);
+	image->drop();
+}
+
+ITexture* getPrefabTexture(CEntityPrefab* prefab)
+{
+	for (int i = 0; i < prefab->getNumEntities(); i++)
+	{
+		CRenderMeshData* renderMesh = GET_ENTITY_DATA(prefab->getEntity(i), CRenderMeshData);
+		if (renderMesh != NULL)
+			return renderMesh->getMesh()->getMeshBuffer(0)->getMaterial().getTexture(0);
+	}
+	return NULL;
+}
+
+void testMeshManager()
+{
+	TEST_CASE("Mesh manager batch import");
+
+	writeTestImage("TestMeshManager.bmp");
+	writeTestFile("TestMeshManager.mtl", "newmtl Test\nmap_Kd TestMeshManager.bmp\n");
+
+	const char* obj =
+		"mtllib TestMeshManager.mtl\n"
+		"v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+		"vt 0 0\nvt 1 0\nvt 0 1\n"
+		"vn 0 0 1\n"
+		"usemtl Test\n"
+		"f 1/1/1 2/2/1 3/3/1\n";
+
+	writeTestFile("TestMeshManagerA.obj", obj);
+	writeTestFile("TestMeshManagerB.obj", obj);
+	writeTestFile("TestMeshManagerC.obj", obj);
+
+	std::vector<std::string> resources = {
+		"TestMeshManagerA.obj",
+		"TestMeshManagerB.obj",
+		"TestMeshManagerA.obj",
+		"TestMeshManagerC.obj",
+		"TestMeshManagerNotFound.obj"
+	};
+
+	CMeshManager* meshMgr = CMeshManager::getInstance();
+
+	std::vector<CEntityPrefab*> prefabs;
+	meshMgr->loadModels(resources, prefabs, NULL, false, false, false, false);
+
+	TEST_ASSERT_EQUAL((int)prefabs.size(), 5);
+	TEST_ASSERT_THROW(prefabs[0] != NULL);
+	TEST_ASSERT_THROW(prefabs[1] != NULL);
+	TEST_ASSERT_THROW(prefabs[3] != NULL);
+	TEST_ASSERT_THROW(prefabs[4] == NULL);
+
+	// the same resource is loaded once
+	TEST_ASSERT_THROW(prefabs[0] == prefabs[2]);
+	TEST_ASSERT_THROW(prefabs[0] != prefabs[1]);
+
+	// the prefabs are cached
+	TEST_ASSERT_THROW(meshMgr->loadModel("TestMeshManagerA.obj", NULL) == prefabs[0]);
+
+	// the texture is shared
+	ITexture* texture = getPrefabTexture(prefabs[0]);
+	TEST_ASSERT_THROW(texture != NULL);
+	TEST_ASSERT_THROW(getPrefabTexture(prefabs[1]) == texture);
+	TEST_ASSERT_THROW(getPrefabTexture(prefabs[3]) == texture);
+
+	TEST_CASE("Texture request from thread");
+
+	writeTestImage("TestMeshManager2.bmp");
+
+	CTextureManager* textureMgr = CTextureManager::getInstance();
+
+	std::atomic<bool> done(false);
+	ITexture* threadTexture = NULL;
+	std::thread thread([&]()
+		{
+			threadTexture = textureMgr->getTexture("TestMeshManager2.bmp");
+			done = true;
+		});
+
+	while (!done)
+	{
+		textureMgr->updateTextureRequest();
+		std::this_thread::yield();
+	}
+	thread.join();
+
+	TEST_ASSERT_THROW(threadTexture != NULL);
+	TEST_ASSERT_THROW(textureMgr->getTexture("TestMeshManager2.bmp") == threadTexture);
+
+	meshMgr->releasePrefab(prefabs[0]);
+	meshMgr->releasePrefab(prefabs[1]);
+	meshMgr->releasePrefab(prefabs[3]);
+
+	textureMgr->removeTexture(texture);
+	textureMgr->removeTexture(threadTexture);
+
+	remove("TestMeshManager.bmp");
+	remove("TestMeshManager2.bmp");
+	remove("TestMeshManager.mtl");
+	remove("TestMeshManagerA.obj");
+	remove("TestMeshManagerB.obj");
+	remove("TestMeshManagerC.obj");
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testMeshManager();
\ No newline at end of file
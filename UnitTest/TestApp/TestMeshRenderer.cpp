@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestMeshRenderer.h"
+
+#include "Entity/CEntityManager.h"
+#include "RenderMesh/CMeshRenderer.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "MeshManager/CMeshManager.h"
+#include "Culling/CVisibleData.h"
+#include "Material/Shader/CShaderManager.h"
+#include "Material/Shader/Instancing/CStandardSGInstancing.h"
+
+#define TEST_MESH_RENDERER_ENTITY 8
+
+using namespace Skylicht;
+
+#define TEST_INSTANCING_SHADER "TestInstancing.xml"
+
+// the null driver can't build a shader, this shader only have the instancing info
+class CTestInstancingShader : public CShader
+{
+public:
+	CTestInstancingShader()
+	{
+		m_baseShader = video::EMT_SOLID;
+		m_instancingShader = this;
+		setInstancing(new CStandardSGInstancing());
+		setShaderPath(TEST_INSTANCING_SHADER);
+	}
+};
+
+// the null driver do not support the instancing stream, force it for test
+class CTestMeshRenderer : public CMeshRenderer
+{
+public:
+	virtual void init(CEntityManager* entityManager)
+	{
+		m_supportInstancing = true;
+	}
+
+	void updateFrame(CEntityManager* entityManager)
+	{
+		beginQuery(entityManager);
+		entityManager->update();
+		onQuery(entityManager, NULL, 0);
+		update(entityManager);
+	}
+};
+
+CEntity* createTestMeshEntity(CEntityManager* entityManager, CMesh* mesh, int i)
+{
+	CEntity* entity = entityManager->createEntity();
+	entity->addData<CVisibleData>();
+
+	CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+	transform->Relative.setTranslation(core::vector3df((f32)i * 2.0f, 0.0f, 10.0f));
+
+	CRenderMeshData* renderMesh = entity->addData<CRenderMeshData>();
+	renderMesh->setMesh(mesh);
+	return entity;
+}
+
+void testMeshRenderer()
+{
+	TEST_CASE("Mesh renderer auto instancing");
+
+	// the material gets the shader by path from CShaderManager
+	CShaderManager* shaderManager = CShaderManager::getInstance();
+	CTestInstancingShader* shader = new CTestInstancingShader();
+	shaderManager->addShader(shader);
+	shader->drop();
+
+	CMaterial* material = new CMaterial("TestInstancing", TEST_INSTANCING_SHADER);
+	TEST_ASSERT_THROW(material->getShader() == shader);
+
+	ISceneManager* sceneManager = getIrrlichtDevice()->getSceneManager();
+	IMesh* cube = sceneManager->getGeometryCreator()->createCubeMesh(core::vector3df(1.0f));
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(cube->getMeshBuffer(0), "TestInstancing", material);
+	cube->drop();
+
+	CEntityManager* entityManager = new CEntityManager();
+
+	CEntity* entities[TEST_MESH_RENDERER_ENTITY];
+	for (int i = 0; i < TEST_MESH_RENDERER_ENTITY; i++)
+		entities[i] = createTestMeshEntity(entityManager, mesh, i);
+
+	CTestMeshRenderer* renderer = new CTestMeshRenderer();
+	renderer->init(entityManager);
+	renderer->updateFrame(entityManager);
+
+	// 1 instanced draw for the mesh buffer (each entity clones the mesh, so it is cached per entity)
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 1);
+	TEST_ASSERT_EQUAL(renderer->getRenderQueue()->getCount(), 0);
+	TEST_ASSERT_EQUAL(renderer->getNumInstancingMeshCache(), TEST_MESH_RENDERER_ENTITY);
+
+	// the small group is drawn each mesh
+	renderer->setMinInstancing(TEST_MESH_RENDERER_ENTITY + 1);
+	renderer->updateFrame(entityManager);
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 0);
+	TEST_ASSERT_EQUAL(renderer->getRenderQueue()->getCount(), TEST_MESH_RENDERER_ENTITY);
+	renderer->setMinInstancing(4);
+
+	TEST_CASE("Mesh renderer instancing ownership");
+
+	// the instancing data is owned by CMeshRendererInstancing from the first frame
+	CEntity* instancingEntity = createTestMeshEntity(entityManager, mesh, TEST_MESH_RENDERER_ENTITY);
+	CRenderMeshData* instancingMesh = GET_ENTITY_DATA(instancingEntity, CRenderMeshData);
+	instancingMesh->setInstancing(true);
+	TEST_ASSERT_THROW(instancingMesh->getMeshInstancing() != NULL);
+	TEST_ASSERT_THROW(instancingMesh->getMeshInstancing()->InstancingGroup == NULL);
+
+	renderer->updateFrame(entityManager);
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 0);
+	TEST_ASSERT_EQUAL(renderer->getRenderQueue()->getCount(), TEST_MESH_RENDERER_ENTITY);
+
+	TEST_CASE("Mesh renderer instancing turned off");
+
+	// the shared instancing data is batched again
+	instancingMesh->setInstancing(false);
+	TEST_ASSERT_THROW(instancingMesh->getMeshInstancing() == NULL);
+
+	renderer->updateFrame(entityManager);
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 1);
+	TEST_ASSERT_EQUAL(renderer->getRenderQueue()->getCount(), 0);
+
+	instancingMesh->setInstancing(true);
+	renderer->updateFrame(entityManager);
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 0);
+	TEST_ASSERT_EQUAL(renderer->getRenderQueue()->getCount(), TEST_MESH_RENDERER_ENTITY);
+
+	TEST_CASE("Mesh renderer instancing release");
+	entityManager->removeEntity(instancingEntity);
+
+	// the cache is rebuilt with the new instancing data
+	CMeshManager::getInstance()->releaseAllInstancingMesh();
+	renderer->updateFrame(entityManager);
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 1);
+	TEST_ASSERT_EQUAL(renderer->getRenderQueue()->getCount(), 0);
+
+	// the mesh is released from the cache when the entities release it
+	for (int i = 0; i < TEST_MESH_RENDERER_ENTITY; i++)
+		entityManager->removeEntity(entities[i]);
+
+	renderer->updateFrame(entityManager);
+	TEST_ASSERT_EQUAL(renderer->getNumInstancingMeshCache(), 0);
+	TEST_ASSERT_EQUAL(renderer->getInstancingQueue()->getCount(), 0);
+
+	mesh->drop();
+
+	delete renderer;
+	delete entityManager;
+
+	CMeshManager::getInstance()->releaseAllInstancingMesh();
+	material->drop();
+	shaderManager->removeShader(shader);
+}
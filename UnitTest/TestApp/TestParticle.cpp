@@ -0,0 +1,102 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestParticle.h"
+
+#include "ParticleSystem/Particles/CGroup.h"
+#include "ParticleSystem/Particles/CFactory.h"
+
+using namespace Skylicht;
+
+void testParticle()
+{
+	TEST_CASE("Particle array");
+	Particle::CParticleArray particles;
+	TEST_ASSERT_EQUAL(particles.create(6), 0);
+	TEST_ASSERT_EQUAL(particles.getCount(), 6);
+	TEST_ASSERT_EQUAL(particles.getCapacity() % 4, 0);
+
+	for (u32 i = 0; i < 6; i++)
+		particles.setPosition(i, core::vector3df((f32)i, 0.0f, 0.0f));
+
+	// the last particle is moved to the removed index
+	particles.remove(1);
+	TEST_ASSERT_EQUAL(particles.getCount(), 5);
+	TEST_ASSERT_FLOAT_EQUAL(particles.getPosition(1).X, 5.0f);
+
+	Particle::CParticle p(0);
+	p.Velocity.set(1.0f, 2.0f, 3.0f);
+	p.Params[Particle::ColorA] = 0.5f;
+	p.ParentIndex = 3;
+	p.Immortal = true;
+	particles.set(2, p);
+
+	Particle::CParticle q(0);
+	particles.get(2, q);
+	TEST_ASSERT_EQUAL(q.Index, 2);
+	TEST_ASSERT_EQUAL(q.ParentIndex, 3);
+	TEST_ASSERT_THROW(q.Immortal);
+	TEST_ASSERT_THROW(q.Velocity == p.Velocity);
+	TEST_ASSERT_FLOAT_EQUAL(q.Params[Particle::ColorA], 0.5f);
+	TEST_ASSERT_FLOAT_EQUAL(q.Params[Particle::Mass], 1.0f);
+
+	TEST_CASE("Particle interpolator");
+	Particle::CInterpolator interpolator;
+	interpolator.addEntry(0.0f, 0.0f);
+	interpolator.addEntry(0.5f, 1.0f);
+	interpolator.addEntry(1.0f, 0.2f);
+
+	f32 x[8] = { -1.0f, 0.0f, 0.1f, 0.5f, 0.6f, 0.9f, 1.0f, 2.0f };
+	f32 y[8];
+	interpolator.interpolate(x, y, 8);
+
+	int numError = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		if (fabsf(y[i] - interpolator.interpolate(x[i])) > 0.0001f)
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	TEST_CASE("Particle update");
+	Particle::CFactory factory;
+	Particle::CEmitter* emitter = factory.createRandomEmitter();
+
+	Particle::CGroup group;
+	group.Gravity.set(0.0f, -10.0f, 0.0f);
+	group.LifeMin = 2.0f;
+	group.LifeMax = 2.0f;
+	group.createModel(Particle::ColorA)->setStart(1.0f)->setEnd(0.0f);
+	group.createModel(Particle::Scale)->setInterpolator(&interpolator);
+
+	for (int i = 0; i < 10; i++)
+		group.addParticleVelocityByEmitter(emitter, core::vector3df((f32)i, 0.0f, 0.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	float timeStep = getTimeStep();
+	setTimeStep(100.0f);
+
+	group.update(true);
+
+	Particle::CParticleArray* groupParticles = group.getParticles();
+	TEST_ASSERT_EQUAL(groupParticles->getCount(), 10);
+
+	numError = 0;
+	for (u32 i = 0; i < 10; i++)
+	{
+		if (!groupParticles->getPosition(i).equals(core::vector3df((f32)i, 0.1f, 0.0f)) ||
+			!groupParticles->getVelocity(i).equals(core::vector3df(0.0f, 0.0f, 0.0f)) ||
+			fabsf(groupParticles->getLife(i) - 1.9f) > 0.0001f ||
+			fabsf(groupParticles->getParams(Particle::ColorA)[i] - 0.95f) > 0.0001f ||
+			fabsf(groupParticles->getParams(Particle::ScaleY)[i] - 0.1f) > 0.0001f)
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	// kill a particle, the last particle is moved to its index
+	groupParticles->setLife(3, -1.0f);
+	group.update(true);
+
+	TEST_ASSERT_EQUAL(groupParticles->getCount(), 9);
+	TEST_ASSERT_FLOAT_EQUAL(groupParticles->getPosition(3).X, 9.0f);
+
+	setTimeStep(timeStep);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testParticle();
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestRasterisation.h"
+
+#include "Rasterisation/CRasterisation.h"
+#include "Transform/CTransform.h"
+
+using namespace Skylicht;
+using namespace Skylicht::Lightmapper;
+
+// the charts of 2 triangles on a grid, some are rotated
+static void createTestCharts(core::array<SRasterTriangle>& triangles, int numChart)
+{
+	float size = 1.0f / numChart;
+
+	for (int y = 0; y < numChart; y++)
+	{
+		for (int x = 0; x < numChart; x++)
+		{
+			core::vector2df center((x + 0.5f) * size, (y + 0.5f) * size);
+			float r = size * (0.3f + 0.15f * ((x + y) % 3));
+			float angle = (x * 7 + y * 3) * 0.3f;
+
+			core::vector2df uv[4];
+			for (int i = 0; i < 4; i++)
+			{
+				float a = angle + i * core::HALF_PI;
+				uv[i] = center + core::vector2df(cosf(a), sinf(a)) * r;
+			}
+
+			const int index[2][3] = { {0, 1, 2}, {0, 2, 3} };
+			for (int t = 0; t < 2; t++)
+			{
+				SRasterTriangle triangle;
+				for (int i = 0; i < 3; i++)
+				{
+					const core::vector2df& p = uv[index[t][i]];
+					triangle.UV[i] = p;
+					triangle.Position[i].set(p.X * 10.0f, 0.0f, p.Y * 10.0f);
+					triangle.Normal[i] = Transform::Oy;
+					triangle.Tangent[i] = Transform::Ox;
+				}
+				triangles.push_back(triangle);
+			}
+		}
+	}
+}
+
+// bake the color by position
+static void bakeTestPixels(CRasterisation* raster)
+{
+	core::array<SBakePixel>& pixels = raster->getBakePixelQueue();
+
+	std::vector<CSH9> results(pixels.size());
+	for (u32 i = 0, n = pixels.size(); i < n; i++)
+	{
+		const core::vector3df& p = pixels[i].Position;
+		results[i].getValue()[0].set(fmodf(p.X, 1.0f), fmodf(p.Z, 1.0f), 0.5f);
+	}
+
+	raster->flushPixel(results);
+}
+
+static bool sortPixel(const SBakePixel& a, const SBakePixel& b)
+{
+	if (a.Pixel.Y != b.Pixel.Y)
+		return a.Pixel.Y < b.Pixel.Y;
+	return a.Pixel.X < b.Pixel.X;
+}
+
+void testRasterisation()
+{
+	TEST_CASE("Lightmapper rasterisation");
+
+	const int size = 256;
+
+	core::array<SRasterTriangle> triangles;
+	createTestCharts(triangles, 12);
+
+	CRasterisation* serial = new CRasterisation(size, size);
+	CRasterisation* tiled = new CRasterisation(size, size);
+	CRasterisation* tiled2 = new CRasterisation(size, size);
+
+	for (int pass = 0; pass < (int)CRasterisation::PassCount; pass++)
+	{
+		CRasterisation::ERasterPass rasterPass = (CRasterisation::ERasterPass)pass;
+
+		for (u32 i = 0, n = triangles.size(); i < n; i++)
+		{
+			SRasterTriangle& t = triangles[i];
+
+			core::vector3df outPos, outNormal, outTangent, outBinormal;
+			core::vector2di pixel = serial->setTriangle(t.Position, t.UV, t.Normal, t.Tangent, rasterPass);
+
+			while (!serial->isFinished(pixel))
+			{
+				serial->samplingTrianglePosition(outPos, outNormal, outTangent, outBinormal, pixel);
+				serial->moveNextPixel(pixel);
+			}
+		}
+
+		tiled->rasterise(triangles.const_pointer(), (int)triangles.size(), rasterPass);
+		tiled2->rasterise(triangles.const_pointer(), (int)triangles.size(), rasterPass);
+
+		if (rasterPass == CRasterisation::Space4A)
+		{
+			// no interpolation: the same pixels as setTriangle & moveNextPixel
+			std::vector<SBakePixel> a(serial->getBakePixelQueue().const_pointer(), serial->getBakePixelQueue().const_pointer() + serial->getBakePixelQueue().size());
+			std::vector<SBakePixel> b(tiled->getBakePixelQueue().const_pointer(), tiled->getBakePixelQueue().const_pointer() + tiled->getBakePixelQueue().size());
+
+			TEST_ASSERT_THROW(a.size() > 0);
+			TEST_ASSERT_EQUAL((int)a.size(), (int)b.size());
+
+			std::sort(a.begin(), a.end(), sortPixel);
+			std::sort(b.begin(), b.end(), sortPixel);
+
+			bool same = true;
+			for (size_t i = 0; i < a.size() && i < b.size(); i++)
+			{
+				if (a[i].Pixel != b[i].Pixel || a[i].Position != b[i].Position || a[i].Normal != b[i].Normal)
+					same = false;
+			}
+			TEST_ASSERT_THROW(same);
+		}
+
+		// the same order on the tiles
+		TEST_ASSERT_EQUAL(tiled->getBakePixelQueue().size(), tiled2->getBakePixelQueue().size());
+
+		bakeTestPixels(serial);
+		bakeTestPixels(tiled);
+		bakeTestPixels(tiled2);
+	}
+
+	// the same coverage
+	bool sameBaked = true;
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			if (serial->isBaked(x, y) != tiled->isBaked(x, y))
+				sameBaked = false;
+		}
+	}
+	TEST_ASSERT_THROW(sameBaked);
+
+	// deterministic output
+	tiled->imageDilate();
+	tiled2->imageDilate();
+	TEST_ASSERT_THROW(memcmp(tiled->getLightmapData(), tiled2->getLightmapData(), size * size * 3) == 0);
+
+	delete serial;
+	delete tiled;
+	delete tiled2;
+
+	// dilate fills the empty pixel by the neighbors
+	CRasterisation* image = new CRasterisation(8, 8);
+	unsigned char* data = image->getLightmapData();
+
+	int offset = (3 * 8 + 3) * 3;
+	data[offset] = 90;
+	data[offset + 1] = 60;
+	data[offset + 2] = 30;
+
+	image->imageDilate();
+
+	float color[3];
+	image->getLightmapPixel(3, 4, color);
+	TEST_ASSERT_THROW(color[0] == 90.0f && color[1] == 60.0f && color[2] == 30.0f);
+
+	image->getLightmapPixel(4, 4, color);
+	TEST_ASSERT_THROW(color[0] == 0.0f && color[1] == 0.0f && color[2] == 0.0f);
+
+	image->getLightmapPixel(3, 3, color);
+	TEST_ASSERT_THROW(color[0] == 90.0f);
+
+	delete image;
+}
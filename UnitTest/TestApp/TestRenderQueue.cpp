@@ -0,0 +1,63 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestRenderQueue.h"
+
+#include "RenderMesh/CRenderQueue.h"
+
+using namespace Skylicht;
+
+void testRenderQueue()
+{
+	TEST_CASE("Render queue radix sort");
+	CRenderQueue queue;
+
+	u32 seed = 12345;
+	for (u32 i = 0; i < 1000; i++)
+	{
+		seed = seed * 1664525 + 1013904223;
+		u64 key = ((u64)seed << 32) | (seed >> 7);
+		queue.push(key, i, 0);
+	}
+
+	// equal keys keep the push order
+	queue.push(1, 2000, 0);
+	queue.push(1, 2001, 0);
+
+	queue.sort();
+	TEST_ASSERT_EQUAL(queue.getCount(), 1002);
+
+	CRenderQueue::SItem* items = queue.getItems();
+	bool sorted = true;
+	for (u32 i = 1, n = queue.getCount(); i < n; i++)
+	{
+		if (items[i - 1].Key > items[i].Key)
+			sorted = false;
+	}
+	TEST_ASSERT_THROW(sorted);
+	TEST_ASSERT_EQUAL(items[0].Object, 2000);
+	TEST_ASSERT_EQUAL(items[1].Object, 2001);
+
+	TEST_CASE("Render queue key");
+	queue.reset();
+
+	// transparent far -> near, after all opaque
+	queue.push(CRenderQueue::makeKey(CRenderQueue::Transparent, 1, 1, 1, 1, 0.2f), 0, 0);
+	queue.push(CRenderQueue::makeKey(CRenderQueue::Transparent, 1, 1, 1, 1, 0.8f), 1, 0);
+
+	// opaque group by shader, then material, then near -> far
+	queue.push(CRenderQueue::makeKey(CRenderQueue::Opaque, 2, 1, 1, 1, 0.1f), 2, 0);
+	queue.push(CRenderQueue::makeKey(CRenderQueue::Opaque, 1, 2, 1, 1, 0.1f), 3, 0);
+	queue.push(CRenderQueue::makeKey(CRenderQueue::Opaque, 1, 1, 1, 1, 0.9f), 4, 0);
+	queue.push(CRenderQueue::makeKey(CRenderQueue::Opaque, 1, 1, 1, 1, 0.3f), 5, 0);
+
+	queue.sort();
+	items = queue.getItems();
+
+	TEST_ASSERT_EQUAL(queue.getNumOpaque(), 4);
+	TEST_ASSERT_EQUAL(items[0].Object, 5);
+	TEST_ASSERT_EQUAL(items[1].Object, 4);
+	TEST_ASSERT_EQUAL(items[2].Object, 3);
+	TEST_ASSERT_EQUAL(items[3].Object, 2);
+	TEST_ASSERT_EQUAL(items[4].Object, 1);
+	TEST_ASSERT_EQUAL(items[5].Object, 0);
+}
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestRenderState.h"
+
+#include "Scene/CScene.h"
+#include "RenderPipeline/CForwardRP.h"
+#include "RenderPipeline/CRenderStateCache.h"
+#include "RenderMesh/CRenderMeshData.h"
+
+#define TEST_RENDER_STATE_ENTITY 8
+
+using namespace Skylicht;
+
+void testRenderState()
+{
+	TEST_CASE("Render state cache");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CGameObject* cameraObj = zone->createEmptyObject();
+	CCamera* camera = cameraObj->addComponent<CCamera>();
+
+	// entities share the same mesh buffer & material
+	ISceneManager* sceneManager = getIrrlichtDevice()->getSceneManager();
+	IMesh* cube = sceneManager->getGeometryCreator()->createCubeMesh(core::vector3df(1.0f));
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(cube->getMeshBuffer(0));
+	cube->drop();
+
+	CEntityManager* entityManager = zone->getEntityManager();
+	for (int i = 0; i < TEST_RENDER_STATE_ENTITY; i++)
+	{
+		CEntity* entity = entityManager->createEntity();
+
+		CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)i * 2.0f, 0.0f, 10.0f));
+
+		CRenderMeshData* renderMesh = entity->addData<CRenderMeshData>();
+		renderMesh->setMesh(mesh);
+	}
+	u32 vertexCount = mesh->getMeshBuffer(0)->getVertexBuffer(0)->getVertexCount();
+	mesh->drop();
+
+	scene->updateAddRemoveObject();
+	scene->update();
+
+	CForwardRP* rp = new CForwardRP();
+	rp->initRender(512, 512);
+
+	CRenderStateCache* cache = CRenderStateCache::getInstance();
+
+	// the redundant material & shader are skipped
+	cache->beginFrame();
+	rp->render(NULL, camera, entityManager, core::recti());
+
+	const SRenderStats& stats = cache->getStats();
+	TEST_ASSERT_EQUAL(stats.DrawCall, TEST_RENDER_STATE_ENTITY);
+	TEST_ASSERT_EQUAL(stats.Vertex, TEST_RENDER_STATE_ENTITY * vertexCount);
+	TEST_ASSERT_EQUAL(stats.MaterialChange, 1);
+	TEST_ASSERT_EQUAL(stats.TransformChange, TEST_RENDER_STATE_ENTITY);
+	TEST_ASSERT_EQUAL(stats.SkipState, TEST_RENDER_STATE_ENTITY - 1);
+
+	// cache off: bind all state
+	cache->setEnable(false);
+	cache->beginFrame();
+	rp->render(NULL, camera, entityManager, core::recti());
+
+	TEST_ASSERT_EQUAL(cache->getLastFrameStats().DrawCall, TEST_RENDER_STATE_ENTITY);
+	TEST_ASSERT_EQUAL(cache->getStats().DrawCall, TEST_RENDER_STATE_ENTITY);
+	TEST_ASSERT_EQUAL(cache->getStats().MaterialChange, TEST_RENDER_STATE_ENTITY);
+	TEST_ASSERT_EQUAL(cache->getStats().SkipState, 0);
+
+	cache->setEnable(true);
+	cache->beginFrame();
+
+	delete rp;
+	delete scene;
+}
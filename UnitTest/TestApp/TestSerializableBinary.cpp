@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSerializableBinary.h"
+
+#include "Scene/CScene.h"
+#include "Scene/CSceneExporter.h"
+#include "Scene/CSceneImporter.h"
+#include "Serializable/CSerializableBinary.h"
+#include "Exporter/ExportResources.h"
+
+using namespace Skylicht;
+
+void testSerializableBinary()
+{
+	TEST_CASE("Serializable binary");
+
+	CObjectSerializable* data = new CObjectSerializable("CGameObject");
+	data->autoRelease(new CStringProperty(data, "name", "ObjectA"));
+	data->autoRelease(new CBoolProperty(data, "visible", false));
+	data->autoRelease(new CIntProperty(data, "layer", -3));
+	data->autoRelease(new CFloatProperty(data, "speed", 2.5f));
+	data->autoRelease(new CVector3Property(data, "position", core::vector3df(1.0f, 2.0f, 3.0f)));
+	data->autoRelease(new CColorProperty(data, "color", video::SColor(255, 10, 20, 30)));
+
+	CObjectSerializable* coms = new CObjectSerializable("Components", data);
+	data->autoRelease(coms);
+
+	CObjectSerializable* com = new CObjectSerializable("CTransformEuler", coms);
+	coms->autoRelease(com);
+	com->autoRelease(new CStringProperty(com, "parent", "ObjectA"));
+
+	CMemoryStream stream;
+	TEST_ASSERT_THROW(CSerializableBinary::save(&stream, data));
+
+	CMemoryStream readStream(stream.getData(), stream.getSize());
+	CObjectSerializable* load = new CObjectSerializable("CGameObject");
+	TEST_ASSERT_THROW(CSerializableBinary::load(&readStream, load));
+
+	TEST_ASSERT_STRING_EQUAL(load->get("name", std::string("")).c_str(), "ObjectA");
+	TEST_ASSERT_THROW(load->get("visible", true) == false);
+	TEST_ASSERT_EQUAL(load->get("layer", 0), -3);
+	TEST_ASSERT_FLOAT_EQUAL(load->get("speed", 0.0f), 2.5f);
+	TEST_ASSERT_THROW(load->get("position", core::vector3df()) == core::vector3df(1.0f, 2.0f, 3.0f));
+	TEST_ASSERT_THROW(load->get("color", video::SColor()) == video::SColor(255, 10, 20, 30));
+
+	CObjectSerializable* loadComs = load->getProperty<CObjectSerializable>("Components");
+	TEST_ASSERT_THROW(loadComs != NULL);
+	TEST_ASSERT_EQUAL(loadComs->getNumProperty(), 1);
+
+	CObjectSerializable* loadCom = loadComs->getProperty<CObjectSerializable>("CTransformEuler");
+	TEST_ASSERT_THROW(loadCom != NULL);
+	TEST_ASSERT_STRING_EQUAL(loadCom->get("parent", std::string("")).c_str(), "ObjectA");
+
+	// wrong root type
+	CMemoryStream wrongStream(stream.getData(), stream.getSize());
+	CObjectSerializable* wrong = new CObjectSerializable("CZone");
+	TEST_ASSERT_THROW(CSerializableBinary::load(&wrongStream, wrong) == false);
+
+	// truncated buffer
+	u32 fullSize = stream.getSize();
+	bool truncatedFail = true;
+	for (u32 size = 0; size < fullSize; size++)
+	{
+		unsigned char* truncated = new unsigned char[size + 1];
+		memcpy(truncated, stream.getData(), size);
+
+		CMemoryStream truncatedStream(truncated, size);
+		CObjectSerializable* truncatedData = new CObjectSerializable("CGameObject");
+		if (CSerializableBinary::load(&truncatedStream, truncatedData))
+			truncatedFail = false;
+
+		delete truncatedData;
+		delete[] truncated;
+	}
+	TEST_ASSERT_THROW(truncatedFail);
+
+	// string id out of the table: the first attribute name of the root node
+	unsigned char* corrupt = new unsigned char[fullSize];
+	memcpy(corrupt, stream.getData(), fullSize);
+
+	u32 blockSize = 0;
+	memcpy(&blockSize, corrupt + sizeof(SAssetHeader) + sizeof(u32), sizeof(u32));
+
+	u32 badId = 0xffffffff;
+	u32 attributeName = sizeof(SAssetHeader) + sizeof(u32) * 2 + blockSize + sizeof(u32) + sizeof(char) + sizeof(u32);
+	memcpy(corrupt + attributeName, &badId, sizeof(u32));
+
+	CMemoryStream corruptStream(corrupt, fullSize);
+	CObjectSerializable* corruptData = new CObjectSerializable("CGameObject");
+	TEST_ASSERT_THROW(CSerializableBinary::load(&corruptStream, corruptData) == false);
+
+	delete corruptData;
+	delete[] corrupt;
+
+	delete wrong;
+	delete load;
+	delete data;
+
+	TEST_CASE("Scene binary export/import");
+
+	const char* path = "TestSerializableBinary.sbin";
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CGameObject* object = zone->createEmptyObject();
+	object->setName("ObjectA");
+	object->getTransformEuler()->setPosition(core::vector3df(1.0f, 2.0f, 3.0f));
+
+	object = zone->createEmptyObject();
+	object->setName("ObjectB");
+
+	CContainerObject* container = zone->createContainerObject();
+	container->setName("ContainerC");
+
+	object = container->createEmptyObject();
+	object->setName("ObjectC");
+	object->setVisible(false);
+
+	scene->updateAddRemoveObject();
+	CSceneExporter::exportSceneBinary(scene, path);
+	delete scene;
+
+	scene = new CScene();
+	TEST_ASSERT_THROW(CSceneImporter::beginImportScene(scene, path));
+	while (!CSceneImporter::updateLoadScene())
+	{
+	}
+	scene->updateAddRemoveObject();
+
+	TEST_ASSERT_EQUAL(scene->getZoneCount(), 1);
+
+	object = scene->searchObjectInChild(L"ObjectA");
+	TEST_ASSERT_THROW(object != NULL);
+	TEST_ASSERT_THROW(object->getTransformEuler()->getPosition() == core::vector3df(1.0f, 2.0f, 3.0f));
+
+	object = scene->searchObjectInChild(L"ObjectB");
+	TEST_ASSERT_THROW(object != NULL);
+
+	object = scene->searchObjectInChild(L"ObjectC");
+	TEST_ASSERT_THROW(object != NULL);
+	TEST_ASSERT_THROW(object->isVisible() == false);
+	TEST_ASSERT_THROW(object->getParent() == scene->searchObjectInChild(L"ContainerC"));
+
+	delete scene;
+
+	remove(path);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testSerializableBinary();
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSkinning.h"
+
+#include "VertexAnimation/CSoftwareSkinningUtils.h"
+
+using namespace Skylicht;
+
+void testSkinning()
+{
+	TEST_CASE("Software skinning SIMD");
+
+	const int numJoint = 4;
+	const int numVertex = 257;
+
+	core::matrix4 matrix[numJoint];
+	CSkinnedMesh::SJoint joints[numJoint];
+	for (int i = 0; i < numJoint; i++)
+	{
+		matrix[i].setRotationDegrees(core::vector3df(10.0f * i, 20.0f * i, 5.0f * i));
+		matrix[i].setTranslation(core::vector3df((f32)i, 2.0f, -(f32)i));
+		joints[i].SkinningMatrix = matrix[i].pointer();
+	}
+
+	core::array<video::S3DVertexSkin> vertices;
+	core::array<video::S3DVertex> result;
+	vertices.set_used(numVertex);
+	result.set_used(numVertex);
+
+	for (int i = 0; i < numVertex; i++)
+	{
+		video::S3DVertexSkin& v = vertices[i];
+		v.Pos.set((f32)(i % 7), (f32)(i % 5) * 0.5f, (f32)(i % 3) - 1.0f);
+		v.Normal.set(0.0f, 1.0f, (f32)(i % 2));
+		v.Normal.normalize();
+
+		// 1 - 4 bones, unused bones have an invalid index
+		int numBone = i % 4 + 1;
+		f32* boneID = &v.BoneIndex.X;
+		f32* boneWeight = &v.BoneWeight.X;
+		for (int j = 0; j < 4; j++)
+		{
+			boneID[j] = j < numBone ? (f32)((i + j) % numJoint) : 1000.0f;
+			boneWeight[j] = j < numBone ? 1.0f / numBone : 0.0f;
+		}
+	}
+
+	// skin by 2 ranges
+	CSoftwareSkinningUtils::skinVertices(joints, vertices.pointer(), result.pointer(), 0, 100);
+	CSoftwareSkinningUtils::skinVertices(joints, vertices.pointer(), result.pointer(), 100, numVertex);
+
+	int numError = 0;
+	for (int i = 0; i < numVertex; i++)
+	{
+		core::vector3df pos, normal;
+		for (int j = 0; j < 4; j++)
+		{
+			if ((&vertices[i].BoneWeight.X)[j] > 0.0f)
+				CSoftwareSkinningUtils::skinVertex(joints, pos, normal, &vertices[i], j);
+		}
+		normal.normalize();
+
+		if (!pos.equals(result[i].Pos, 0.0001f) || !normal.equals(result[i].Normal, 0.0001f))
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+
+	TEST_CASE("Software blend shape");
+
+	core::array<video::S3DVertexSkinTangents> morphVertices;
+	core::array<video::S3DVertexSkinTangents> morphResult;
+	morphVertices.set_used(numVertex);
+	morphResult.set_used(numVertex);
+
+	CBlendShape shape[2];
+	shape[0].Weight = 0.5f;
+	shape[1].Weight = 0.0f;
+
+	for (int i = 0; i < numVertex; i++)
+	{
+		morphVertices[i].Pos.set((f32)i, 0.0f, 0.0f);
+		morphVertices[i].VertexData.Y = (f32)(numVertex - 1 - i);
+		shape[0].Offset.push_back(core::vector3df(0.0f, (f32)i, 2.0f));
+		shape[1].Offset.push_back(core::vector3df(100.0f, 100.0f, 100.0f));
+	}
+
+	CBlendShape* shapes[2] = { &shape[0], &shape[1] };
+	CSoftwareSkinningUtils::blendShapeVertices(shapes, 2, morphVertices.pointer(), morphResult.pointer(), 0, 10);
+	CSoftwareSkinningUtils::blendShapeVertices(shapes, 2, morphVertices.pointer(), morphResult.pointer(), 10, numVertex);
+
+	numError = 0;
+	for (int i = 0; i < numVertex; i++)
+	{
+		core::vector3df pos((f32)i, 0.5f * (numVertex - 1 - i), 1.0f);
+		if (!pos.equals(morphResult[i].Pos))
+			numError++;
+	}
+	TEST_ASSERT_EQUAL(numError, 0);
+}
@@ -0,0 +1,192 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSkylichtAsset.h"
+
+#include "Entity/CEntityPrefab.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "Animation/CAnimationClip.h"
+#include "Exporter/Skylicht/CSkylichtMeshExporter.h"
+#include "Exporter/Skylicht/CSkylichtAnimExporter.h"
+#include "Importer/Skylicht/CSkylichtMeshLoader.h"
+#include "Importer/Skylicht/CSkylichtAnimLoader.h"
+#include "Utils/CMappedFile.h"
+
+using namespace Skylicht;
+
+// TestStreaming.cpp
+void writeZipStoredEntry(FILE* f, const char* name, const void* data, u32 size);
+
+void testSkylichtMesh()
+{
+	TEST_CASE("Skylicht mesh mapped file");
+
+	const char* path = "TestSkylichtAsset.smesh";
+
+	ISceneManager* sceneManager = getIrrlichtDevice()->getSceneManager();
+	IMesh* cube = sceneManager->getGeometryCreator()->createCubeMesh(core::vector3df(1.0f));
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(cube->getMeshBuffer(0));
+	cube->drop();
+
+	CEntityPrefab* prefab = new CEntityPrefab();
+	for (int i = 0; i < 3; i++)
+	{
+		CEntity* entity = prefab->createEntity();
+
+		CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+		transform->Relative.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		CRenderMeshData* renderMesh = entity->addData<CRenderMeshData>();
+		renderMesh->setMesh(mesh);
+	}
+
+	CSkylichtMeshExporter exporter;
+	exporter.exportModel(prefab->getEntities(), prefab->getNumEntities(), path);
+
+	CMappedFile file;
+	TEST_ASSERT_THROW(file.open(path));
+	TEST_ASSERT_THROW(file.getData() != NULL);
+
+	io::IReadFile* readFile = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(path);
+	TEST_ASSERT_EQUAL((long)file.getSize(), readFile->getSize());
+	readFile->drop();
+	file.close();
+
+	CEntityPrefab* load = new CEntityPrefab();
+	CSkylichtMeshLoader loader;
+	TEST_ASSERT_THROW(loader.loadModel(path, load, false, false, false, false));
+	TEST_ASSERT_EQUAL(load->getNumEntities(), 3);
+
+	IMeshBuffer* srcMB = mesh->getMeshBuffer(0);
+
+	for (int i = 0; i < load->getNumEntities(); i++)
+	{
+		CRenderMeshData* renderMesh = GET_ENTITY_DATA(load->getEntity(i), CRenderMeshData);
+		TEST_ASSERT_THROW(renderMesh != NULL);
+
+		IMeshBuffer* mb = renderMesh->getMesh()->getMeshBuffer(0);
+		u32 vtxCount = srcMB->getVertexBuffer()->getVertexCount();
+		u32 idxCount = srcMB->getIndexBuffer()->getIndexCount();
+
+		TEST_ASSERT_EQUAL(mb->getVertexBuffer()->getVertexCount(), vtxCount);
+		TEST_ASSERT_EQUAL(mb->getIndexBuffer()->getIndexCount(), idxCount);
+		TEST_ASSERT_THROW(memcmp(mb->getVertexBuffer()->getVertices(), srcMB->getVertexBuffer()->getVertices(), vtxCount * srcMB->getVertexBuffer()->getVertexSize()) == 0);
+		TEST_ASSERT_THROW(memcmp(mb->getIndexBuffer()->getIndices(), srcMB->getIndexBuffer()->getIndices(), idxCount * srcMB->getIndexBuffer()->getIndexSize()) == 0);
+	}
+
+	mesh->drop();
+	delete load;
+	delete prefab;
+
+	remove(path);
+}
+
+void testSkylichtAnim()
+{
+	TEST_CASE("Skylicht anim mapped file");
+
+	const char* path = "TestSkylichtAsset.sanim";
+
+	CAnimationClip* clip = new CAnimationClip();
+	clip->AnimName = "Test";
+	clip->Duration = 1.0f;
+	clip->Loop = true;
+
+	for (int i = 0; i < 3; i++)
+	{
+		SEntityAnim* anim = new SEntityAnim();
+		anim->Name = std::string("Bone") + std::to_string(i);
+
+		CAnimationData& data = anim->Data;
+		for (int j = 0; j < 5 + i; j++)
+		{
+			f32 t = j * 0.1f;
+			data.Positions.Data.push_back(CPositionKey{ t, core::vector3df(t, (f32)i, 1.0f) });
+			data.Rotations.Data.push_back(CRotationKey{ t, core::quaternion(core::vector3df(0.0f, t, 0.0f)) });
+			data.Scales.Data.push_back(CScaleKey{ t, core::vector3df(1.0f + t) });
+		}
+		clip->addAnim(anim);
+	}
+
+	CSkylichtAnimExporter exporter;
+	exporter.exportAnim(clip, path);
+
+	CAnimationClip* load = new CAnimationClip();
+	CSkylichtAnimLoader loader;
+	TEST_ASSERT_THROW(loader.loadAnimation(path, load));
+	TEST_ASSERT_STRING_EQUAL(load->AnimName.c_str(), "Test");
+	TEST_ASSERT_EQUAL((int)load->AnimInfo.size(), 3);
+
+	for (int i = 0; i < 3; i++)
+	{
+		CAnimationData& src = clip->AnimInfo[i]->Data;
+		CAnimationData& dst = load->AnimInfo[i]->Data;
+
+		TEST_ASSERT_STRING_EQUAL(load->AnimInfo[i]->Name.c_str(), clip->AnimInfo[i]->Name.c_str());
+		TEST_ASSERT_EQUAL(dst.Positions.Data.size(), src.Positions.Data.size());
+		TEST_ASSERT_EQUAL(dst.Rotations.Data.size(), src.Rotations.Data.size());
+		TEST_ASSERT_EQUAL(dst.Scales.Data.size(), src.Scales.Data.size());
+
+		for (u32 j = 0; j < src.Positions.Data.size(); j++)
+		{
+			TEST_ASSERT_FLOAT_EQUAL(dst.Positions.Data[j].Frame, src.Positions.Data[j].Frame);
+			TEST_ASSERT_THROW(dst.Positions.Data[j].Value == src.Positions.Data[j].Value);
+			TEST_ASSERT_THROW(dst.Rotations.Data[j].Value == src.Rotations.Data[j].Value);
+			TEST_ASSERT_THROW(dst.Scales.Data[j].Value == src.Scales.Data[j].Value);
+		}
+	}
+
+	delete load;
+	delete clip;
+
+	remove(path);
+}
+
+void testMappedFileArchive()
+{
+	TEST_CASE("Mapped file in archive");
+
+	const char* zipPath = "TestMappedFile.zip";
+	const char* path = "TestMappedFile.bin";
+
+	// the loose file has the same name as the file in archive
+	const char looseData[] = "loose";
+	const char zipData[] = "archive";
+
+	FILE* f = fopen(path, "wb");
+	fwrite(looseData, sizeof(looseData), 1, f);
+	fclose(f);
+
+	f = fopen(zipPath, "wb");
+	writeZipStoredEntry(f, path, zipData, sizeof(zipData));
+	fclose(f);
+
+	io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+	TEST_ASSERT_THROW(fs->addFileArchive(zipPath, false, false, io::EFAT_ZIP));
+
+	// the mounted archive wins, like IFileSystem::createAndOpenFile
+	CMappedFile file;
+	TEST_ASSERT_THROW(file.open(path));
+	TEST_ASSERT_THROW(!file.isMapped());
+	TEST_ASSERT_EQUAL(file.getSize(), (unsigned int)sizeof(zipData));
+	TEST_ASSERT_THROW(memcmp(file.getData(), zipData, sizeof(zipData)) == 0);
+	file.close();
+
+	TEST_ASSERT_THROW(fs->removeFileArchive(zipPath));
+
+	TEST_ASSERT_THROW(file.open(path));
+	TEST_ASSERT_EQUAL(file.getSize(), (unsigned int)sizeof(looseData));
+	TEST_ASSERT_THROW(memcmp(file.getData(), looseData, sizeof(looseData)) == 0);
+	file.close();
+
+	remove(zipPath);
+	remove(path);
+}
+
+void testSkylichtAsset()
+{
+	testSkylichtMesh();
+	testSkylichtAnim();
+	testMappedFileArchive();
+}
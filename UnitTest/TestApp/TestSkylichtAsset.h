@@ -0,0 +1,3 @@
+#pragma once
+
+void testSkylichtAsset();
\ No newline at end of file
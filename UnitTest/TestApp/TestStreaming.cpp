@@ -0,0 +1,250 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestStreaming.h"
+
+#include "Scene/CScene.h"
+#include "Scene/CSceneExporter.h"
+#include "Streaming/CStreamingLoader.h"
+
+#include <thread>
+
+using namespace Skylicht;
+
+#define TEST_ZIP_DATA_SIZE (512 * 1024)
+
+void writeZipU16(FILE* f, u16 v)
+{
+	fwrite(&v, 2, 1, f);
+}
+
+void writeZipU32(FILE* f, u32 v)
+{
+	fwrite(&v, 4, 1, f);
+}
+
+// write a zip local file header with the stored (no compression) data
+void writeZipStoredEntry(FILE* f, const char* name, const void* data, u32 size)
+{
+	writeZipU32(f, 0x04034b50);
+	writeZipU16(f, 10);		// version to extract
+	writeZipU16(f, 0);		// general bit flag
+	writeZipU16(f, 0);		// stored
+	writeZipU16(f, 0);		// time
+	writeZipU16(f, 0);		// date
+	writeZipU32(f, 0);		// crc32 (not checked by the reader)
+	writeZipU32(f, size);
+	writeZipU32(f, size);
+	writeZipU16(f, (u16)strlen(name));
+	writeZipU16(f, 0);
+	fwrite(name, strlen(name), 1, f);
+	fwrite(data, size, 1, f);
+}
+
+void testStreamingZip(const char* scenePath)
+{
+	TEST_CASE("Streaming from zip");
+
+	const char* zipPath = "TestStreaming.zip";
+
+	// pack the scene and a data file in a zip
+	std::vector<u8> sceneData;
+	FILE* f = fopen(scenePath, "rb");
+	TEST_ASSERT_THROW(f != NULL);
+	fseek(f, 0, SEEK_END);
+	sceneData.resize(ftell(f));
+	fseek(f, 0, SEEK_SET);
+	fread(sceneData.data(), sceneData.size(), 1, f);
+	fclose(f);
+
+	std::vector<u8> data(TEST_ZIP_DATA_SIZE);
+	for (u32 i = 0; i < TEST_ZIP_DATA_SIZE; i++)
+		data[i] = (u8)(i * 7 + (i >> 8));
+
+	f = fopen(zipPath, "wb");
+	writeZipStoredEntry(f, "TestStreamingZip.sbin", sceneData.data(), (u32)sceneData.size());
+	writeZipStoredEntry(f, "TestStreamingZip.bin", data.data(), TEST_ZIP_DATA_SIZE);
+	fclose(f);
+
+	// hold the archive file to check its reference count
+	io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+	io::IReadFile* zipFile = fs->createAndOpenFile(zipPath);
+	TEST_ASSERT_THROW(zipFile != NULL);
+	TEST_ASSERT_THROW(fs->addFileArchive(zipFile, false, false, io::EFAT_ZIP));
+	s32 zipFileRef = zipFile->getReferenceCount();
+
+	CStreamingLoader* loader = CStreamingLoader::getInstance();
+	CScene* scene = new CScene();
+
+	int numCallback = 0;
+	loader->loadScene(scene, "TestStreamingZip.sbin", [&](std::vector<CZone*>& zones)
+		{
+			numCallback++;
+		});
+
+	// the main thread reads the same archive while the loader thread streams the scene
+	std::vector<u8> readData(TEST_ZIP_DATA_SIZE);
+	int numRead = 0;
+	bool readOK = true;
+
+	while (loader->getNumTask() > 0 || numRead < 10)
+	{
+		io::IReadFile* file = fs->createAndOpenFile("TestStreamingZip.bin");
+		TEST_ASSERT_THROW(file != NULL);
+
+		// small reads, so the seek & read on the archive interleave with the loader
+		memset(readData.data(), 0, TEST_ZIP_DATA_SIZE);
+		for (u32 pos = 0; pos < TEST_ZIP_DATA_SIZE; pos += 1024)
+			file->read(readData.data() + pos, 1024);
+		file->drop();
+
+		if (memcmp(readData.data(), data.data(), TEST_ZIP_DATA_SIZE) != 0)
+			readOK = false;
+
+		loader->update();
+		numRead++;
+	}
+
+	TEST_ASSERT_THROW(readOK);
+	TEST_ASSERT_EQUAL(numCallback, 1);
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"ObjectA") != NULL);
+
+	CContainerObject* container = dynamic_cast<CContainerObject*>(scene->searchObjectInChild(L"ContainerB"));
+	TEST_ASSERT_THROW(container != NULL);
+	TEST_ASSERT_EQUAL((int)container->getChilds()->size(), 100);
+
+	delete scene;
+
+	// the entries are opened and closed on 2 threads, they grab & drop the same archive file
+	std::atomic<int> numOpenFail(0);
+	auto openEntries = [&]()
+		{
+			for (int i = 0; i < 2000; i++)
+			{
+				io::IReadFile* file = fs->createAndOpenFile("TestStreamingZip.bin");
+				if (file == NULL)
+				{
+					numOpenFail++;
+					continue;
+				}
+				file->drop();
+			}
+		};
+
+	std::thread openThread(openEntries);
+	openEntries();
+	openThread.join();
+
+	TEST_ASSERT_EQUAL(numOpenFail.load(), 0);
+	TEST_ASSERT_EQUAL(zipFile->getReferenceCount(), zipFileRef);
+
+	fs->removeFileArchive(zipFile->getFileName());
+	TEST_ASSERT_EQUAL(zipFile->getReferenceCount(), 1);
+	zipFile->drop();
+
+	remove(zipPath);
+}
+
+void testStreaming()
+{
+	TEST_CASE("Streaming scene");
+
+	const char* path = "TestStreaming.sbin";
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CGameObject* object = zone->createEmptyObject();
+	object->setName("ObjectA");
+	object->getTransformEuler()->setPosition(core::vector3df(1.0f, 2.0f, 3.0f));
+
+	CContainerObject* container = zone->createContainerObject();
+	container->setName("ContainerB");
+
+	for (int i = 0; i < 100; i++)
+	{
+		object = container->createEmptyObject();
+		object->setName(L"ObjectC");
+	}
+
+	scene->updateAddRemoveObject();
+	CSceneExporter::exportSceneBinary(scene, path);
+	delete scene;
+
+	CStreamingLoader* loader = CStreamingLoader::getInstance();
+	float budget = loader->getFrameBudget();
+
+	// finalize one object each frame
+	loader->setFrameBudget(0.0f);
+
+	scene = new CScene();
+
+	int numCallback = 0;
+	int numZone = 0;
+	loader->loadScene(scene, path, [&](std::vector<CZone*>& zones)
+		{
+			numCallback++;
+			numZone = (int)zones.size();
+		});
+
+	TEST_ASSERT_EQUAL(loader->getNumTask(), 1);
+
+	int frame = 0;
+	while (loader->getNumTask() > 0 && frame < 100000)
+	{
+		loader->update();
+		SkylichtSystem::IThread::sleep(0);
+		frame++;
+	}
+
+	TEST_ASSERT_EQUAL(loader->getNumTask(), 0);
+	TEST_ASSERT_EQUAL(numCallback, 1);
+	TEST_ASSERT_EQUAL(numZone, 1);
+
+	// the objects are created in many frames
+	TEST_ASSERT_THROW(frame > 100);
+
+	TEST_ASSERT_EQUAL(scene->getZoneCount(), 1);
+
+	object = scene->searchObjectInChild(L"ObjectA");
+	TEST_ASSERT_THROW(object != NULL);
+	TEST_ASSERT_THROW(object->getTransformEuler()->getPosition() == core::vector3df(1.0f, 2.0f, 3.0f));
+
+	container = dynamic_cast<CContainerObject*>(scene->searchObjectInChild(L"ContainerB"));
+	TEST_ASSERT_THROW(container != NULL);
+	TEST_ASSERT_EQUAL((int)container->getChilds()->size(), 100);
+
+	delete scene;
+
+	TEST_CASE("Streaming finish all");
+
+	scene = new CScene();
+
+	numCallback = 0;
+	loader->loadScene(scene, path, [&](std::vector<CZone*>& zones)
+		{
+			numCallback++;
+		});
+
+	// the model is not found
+	CEntityPrefab* prefab = (CEntityPrefab*)1;
+	loader->loadModel("TestStreamingNotFound.smesh", NULL, true, true, false, [&](CEntityPrefab* p)
+		{
+			numCallback++;
+			prefab = p;
+		});
+
+	loader->finishAll();
+
+	TEST_ASSERT_EQUAL(loader->getNumTask(), 0);
+	TEST_ASSERT_EQUAL(numCallback, 2);
+	TEST_ASSERT_THROW(prefab == NULL);
+	TEST_ASSERT_THROW(scene->searchObjectInChild(L"ObjectA") != NULL);
+
+	delete scene;
+
+	loader->setFrameBudget(budget);
+
+	testStreamingZip(path);
+
+	remove(path);
+}
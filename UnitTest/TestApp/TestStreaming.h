@@ -0,0 +1,3 @@
+#pragma once
+
+void testStreaming();
\ No newline at end of file
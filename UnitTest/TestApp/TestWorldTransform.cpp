@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestWorldTransform.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+#include "Culling/CVisibleData.h"
+#include "Utils/CSIMD.h"
+#include "Job/CJobSystem.h"
+
+using namespace Skylicht;
+
+void testWorldTransform()
+{
+	TEST_CASE("SIMD matrix multiply");
+	core::matrix4 a, b, r1, r2;
+	a.setRotationDegrees(core::vector3df(30.0f, 45.0f, 60.0f));
+	a.setTranslation(core::vector3df(1.0f, 2.0f, 3.0f));
+	b.setRotationDegrees(core::vector3df(10.0f, 20.0f, 30.0f));
+	b.setTranslation(core::vector3df(-4.0f, 5.0f, 6.0f));
+	r1.setbyproduct_nocheck(a, b);
+	CSIMD::mulMatrix(r2, a, b);
+	TEST_ASSERT_THROW(r1.equals(r2, 0.0001f));
+
+	// use workers for test the parallel level update on single core device
+	SkylichtSystem::CJobSystem::releaseInstance();
+	SkylichtSystem::CJobSystem::createInstance(2);
+
+	TEST_CASE("World transform depth level update");
+	CEntityManager* mgr = new CEntityManager();
+
+	const int numRoot = 300;
+	core::array<CEntity*> entities;
+	mgr->createEntity(numRoot * 3, entities);
+
+	for (int i = 0; i < numRoot; i++)
+	{
+		for (int depth = 0; depth < 3; depth++)
+		{
+			CEntity* entity = entities[i * 3 + depth];
+			entity->addData<CVisibleData>();
+
+			CWorldTransformData* transform = entity->addData<CWorldTransformData>();
+			transform->Depth = depth;
+
+			if (depth == 0)
+			{
+				transform->Relative.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+			}
+			else
+			{
+				transform->ParentIndex = entities[i * 3 + depth - 1]->getIndex();
+				transform->Relative.setTranslation(depth == 1 ? core::vector3df(0.0f, 1.0f, 0.0f) : core::vector3df(0.0f, 0.0f, 1.0f));
+			}
+		}
+	}
+
+	mgr->notifyUpdateSortEntities();
+	mgr->update();
+
+	bool pass = true;
+	for (int i = 0; i < numRoot; i++)
+	{
+		CWorldTransformData* transform = GET_ENTITY_DATA(entities[i * 3 + 2], CWorldTransformData);
+		if (!transform->World.getTranslation().equals(core::vector3df((f32)i, 1.0f, 1.0f)))
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	TEST_CASE("World transform skip unchanged");
+	CWorldTransformData* root = GET_ENTITY_DATA(entities[0], CWorldTransformData);
+	root->Relative.setTranslation(core::vector3df(0.0f, 10.0f, 0.0f));
+	root->HasChanged = true;
+
+	mgr->update();
+
+	CWorldTransformData* leaf = GET_ENTITY_DATA(entities[2], CWorldTransformData);
+	TEST_ASSERT_THROW(leaf->NeedValidate);
+	TEST_ASSERT_THROW(leaf->World.getTranslation().equals(core::vector3df(0.0f, 11.0f, 1.0f)));
+
+	leaf = GET_ENTITY_DATA(entities[5], CWorldTransformData);
+	TEST_ASSERT_THROW(!leaf->NeedValidate);
+
+	delete mgr;
+
+	TEST_CASE("World transform attach chain");
+	mgr = new CEntityManager();
+
+	// root <- a, b is attached to a, c is attached to b
+	// all of them are the childs of root, so they have the same Depth
+	// c is created before b, so it comes first in its depth
+	mgr->createEntity(numRoot * 4, entities);
+
+	for (int i = 0; i < numRoot; i++)
+	{
+		CEntity* chain[4];
+		chain[0] = entities[i * 4];
+		chain[1] = entities[i * 4 + 1];
+		chain[2] = entities[i * 4 + 3];
+		chain[3] = entities[i * 4 + 2];
+
+		for (int j = 0; j < 4; j++)
+		{
+			chain[j]->addData<CVisibleData>();
+
+			CWorldTransformData* transform = chain[j]->addData<CWorldTransformData>();
+			if (j == 0)
+			{
+				transform->Relative.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+			}
+			else
+			{
+				transform->Depth = 1;
+				transform->ParentIndex = chain[0]->getIndex();
+				if (j > 1)
+					transform->AttachParentIndex = chain[j - 1]->getIndex();
+				transform->Relative.setTranslation(core::vector3df(0.0f, 1.0f, 0.0f));
+			}
+		}
+	}
+
+	mgr->notifyUpdateSortEntities();
+	mgr->update();
+
+	pass = true;
+	for (int i = 0; i < numRoot; i++)
+	{
+		CWorldTransformData* transform = GET_ENTITY_DATA(entities[i * 4 + 2], CWorldTransformData);
+		if (!transform->World.getTranslation().equals(core::vector3df((f32)i, 3.0f, 0.0f)))
+			pass = false;
+
+		if (mgr->getEntityDepth(entities[i * 4 + 2]->getIndex()) != 3)
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	delete mgr;
+
+	SkylichtSystem::CJobSystem::releaseInstance();
+	SkylichtSystem::CJobSystem::createInstance();
+}
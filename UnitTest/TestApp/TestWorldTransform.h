@@ -0,0 +1,3 @@
+#pragma once
+
+void testWorldTransform();
\ No newline at end of file